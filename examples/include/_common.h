@@ -195,6 +195,13 @@ typedef enum {
  *
  * These can be used to find out whether the codec is initialised, currently
  * in the process of intialising, or it is not yet initialised.
+ *
+ * @note The examples never wait on one another's threads: the "initCodec"
+ *       functions build the new configuration and then hand it over to the
+ *       processing loop (see saf_rcu_publish()). All of the examples keep
+ *       processing audio with the previous configuration while initialising,
+ *       until saf_rcu_publish() hands over the new one; they only output
+ *       silence before their first initialisation is complete.
  */
 typedef enum {
     CODEC_STATUS_INITIALISED = 0, /**< Codec is initialised and ready to process
@@ -209,10 +216,10 @@ typedef enum {
 /**
  * Current status of the processing loop
  *
- * These are used to keep things thread-safe. i.e., the codec will not be
- * initialised if the currently configured codec is being used to process a
- * block of audio. Likewise, if the codec is being initialised, then the
- * "process" functions are bypassed.
+ * @deprecated The examples no longer employ these flags (which were not
+ *             thread-safe), and instead hand over their configuration to the
+ *             processing loop with the saf_rcu utility; see #CODEC_STATUS.
+ *             This enum is only retained for backwards compatibility.
  */
 typedef enum {
     PROC_STATUS_ONGOING = 0, /**< Codec is processing input audio, and should
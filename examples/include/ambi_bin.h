@@ -249,6 +249,20 @@ void ambi_bin_setUseDefaultHRIRsflag(void* const hAmbi, int newState);
  */
 void ambi_bin_setSofaFilePath(void* const hAmbi, const char* path);
 
+/**
+ * Sets a directory in which the HRTFs pre-processed for a SOFA file are
+ * cached, so that they are loaded directly (rather than being recomputed) the
+ * next time that the same file is used, with the same sampling rate and
+ * pre-processing option.
+ *
+ * @note The directory must already exist. Caching is disabled by default, or
+ *       if path is NULL.
+ *
+ * @param[in] hAmbi ambi_bin handle
+ * @param[in] path  Cache directory; or NULL
+ */
+void ambi_bin_setHRTFcacheDirectory(void* const hAmbi, const char* path);
+
 /**
  * Sets the decoding order (see #SH_ORDERS enum)
  *
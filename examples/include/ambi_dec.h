@@ -271,6 +271,20 @@ void ambi_dec_setUseDefaultHRIRsflag(void* const hAmbi, int newState);
  */
 void ambi_dec_setSofaFilePath(void* const hAmbi, const char* path);
 
+/**
+ * Sets a directory in which the HRTFs and interpolation tables computed for a
+ * SOFA file are cached, so that they are loaded directly (rather than being
+ * recomputed) the next time that the same file is used, with the same sampling
+ * rate and pre-processing setting.
+ *
+ * @note The directory must already exist. Caching is disabled by default, or
+ *       if path is NULL.
+ *
+ * @param[in] hAmbi ambi_dec handle
+ * @param[in] path  Cache directory; or NULL
+ */
+void ambi_dec_setHRTFcacheDirectory(void* const hAmbi, const char* path);
+
 /** Enable (1) or disable (0) the pre-processing applied to the HRTFs. */
 void ambi_dec_setEnableHRIRsPreProc(void* const hAmbi, int newState);
 
@@ -171,6 +171,20 @@ void binauraliser_setUseDefaultHRIRsflag(void* const hBin, int newState);
  */
 void binauraliser_setSofaFilePath(void* const hBin, const char* path);
 
+/**
+ * Sets a directory in which the HRTFs and interpolation tables computed for a
+ * SOFA file are cached, so that they are loaded directly (rather than being
+ * recomputed) the next time that the same file is used, with the same sampling
+ * rate and diffuse-field EQ setting.
+ *
+ * @note The directory must already exist. Caching is disabled by default, or
+ *       if path is NULL.
+ *
+ * @param[in] hBin binauraliser handle
+ * @param[in] path Cache directory; or NULL
+ */
+void binauraliser_setHRTFcacheDirectory(void* const hBin, const char* path);
+
 /** Enable (1) or disable (0) the diffuse-field EQ applied to the HRTFs */
 void binauraliser_setEnableHRIRsDiffuseEQ(void* const hBin, int newState);
 
@@ -127,7 +127,13 @@ void matrixconv_setFilters(void* const hMCnv,
                            int numSamples,
                            int sampleRate);
 
-/** Enable (1), disable (0), partitioned convolution */
+/**
+ * Enable uniformly (1) or non-uniformly (2) partitioned convolution, or disable
+ * (0) partitioned convolution
+ *
+ * @note Non-uniformly partitioned convolution is recommended for long filters
+ *       and small host block sizes
+ */
 void matrixconv_setEnablePart(void* const hMCnv, int newState);
     
 /**
@@ -152,8 +158,8 @@ void matrixconv_setNumInputChannels(void* const hMCnv, int newValue);
 int matrixconv_getFrameSize(void);
 
 /**
- * Returns a flag indicating whether partitioned convolution is enabled (1) or
- * disabled (0)
+ * Returns a flag indicating whether uniformly (1) or non-uniformly (2)
+ * partitioned convolution is enabled, or disabled (0)
  */
 int matrixconv_getEnablePart(void* const hMCnv);
     
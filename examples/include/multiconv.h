@@ -120,7 +120,13 @@ void multiconv_setFilters(void* const hMCnv,
                           int numSamples,
                           int sampleRate);
     
-/** Enable (1), disable (0), partitioned convolution */
+/**
+ * Enable uniformly (1) or non-uniformly (2) partitioned convolution, or disable
+ * (0) partitioned convolution
+ *
+ * @note Non-uniformly partitioned convolution is recommended for long filters
+ *       and small host block sizes
+ */
 void multiconv_setEnablePart(void* const hMCnv, int newState);
     
 /** Sets the number of input/output channels */
@@ -138,8 +144,8 @@ void multiconv_setNumChannels(void* const hMCnv, int newValue);
 int multiconv_getFrameSize(void);
 
 /**
- * Returns a flag indicating whether partitioned convolution is enabled (1) or
- * disabled (0)
+ * Returns a flag indicating whether uniformly (1) or non-uniformly (2)
+ * partitioned convolution is enabled, or disabled (0)
  */
 int multiconv_getEnablePart(void* const hMCnv);
 
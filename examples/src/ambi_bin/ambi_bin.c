@@ -92,15 +92,18 @@ void ambi_bin_create
     pData->pars = (ambi_bin_codecPars*)malloc1d(sizeof(ambi_bin_codecPars));
     ambi_bin_codecPars* pars = pData->pars;
     pars->sofa_filepath = NULL;
+    pars->hrtfCacheDirectory = NULL;
     pars->hrirs = NULL;
     pars->hrir_dirs_deg = NULL;
     pars->itds_s = NULL;
     pars->hrtf_fb = NULL;
     pars->weights = NULL;
+    saf_rcu_create(&(pData->hDecoder), ambi_bin_destroyDecoderState);
+    pData->decoderID = pData->M_dec_rotID = 0;
     
     /* flags */
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
+    pData->initialisingFLAG = 0;
     pData->recalc_M_rotFLAG = 1;
     pData->reinit_hrtfsFLAG = 1;
 }
@@ -114,11 +117,10 @@ void ambi_bin_destroy
     ambi_bin_codecPars *pars;
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
         
         /* free afSTFT and buffers */
         afSTFT_destroy(&(pData->hSTFT));
@@ -128,12 +130,14 @@ void ambi_bin_destroy
         free(pData->binframeTF);
 
         pars = pData->pars;
+        free(pars->hrtfCacheDirectory);
         free(pars->weights);
         free(pars->hrtf_fb);
         free(pars->itds_s);
         free(pars->hrirs);
         free(pars->hrir_dirs_deg);
         free(pars);
+        saf_rcu_destroy(&(pData->hDecoder));
         free(pData->progressBarText);
         
         free(pData);
@@ -169,35 +173,48 @@ void ambi_bin_initCodec
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
     ambi_bin_codecPars* pars = pData->pars;
+    ambi_bin_decoderState* decoder;
     int i, j, nSH, order, band;
 #ifdef SAF_ENABLE_SOFA_READER_MODULE
     SAF_SOFA_ERROR_CODES error;
     saf_sofa_container sofa;
+    saf_fileCache_key cacheKey;
+    char* cachePath;
 #endif
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the processing loop is not paused; it carries on with the
+     * previous decoder until the new one is ready */
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Preparing HRIRs");
     pData->progressBar0_1 = 0.0f;
     
-    /* (Re)Initialise afSTFT */
+    /* Initialise afSTFT (for the maximum number of input channels; only the
+     * channels of the current decoder are then transformed, so order changes
+     * do not require any re-allocation) */
     order = pData->new_order;
     nSH = (order+1)*(order+1);
     if(pData->hSTFT==NULL)
-        afSTFT_create(&(pData->hSTFT), nSH, NUM_EARS, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
-    else if(pData->nSH != nSH) {/* Or change the number of channels */
-        afSTFT_channelChange(pData->hSTFT, nSH, NUM_EARS);
-        afSTFT_clearBuffers(pData->hSTFT);
-    }
+        afSTFT_create(&(pData->hSTFT), MAX_NUM_SH_SIGNALS, NUM_EARS, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
     pData->nSH = nSH;
+
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+    /* The HRTFs may have already been pre-processed for this sofa file (with the same settings) */
+    cachePath = NULL;
+    if(pData->reinit_hrtfsFLAG && !pData->useDefaultHRIRsFLAG && pars->sofa_filepath!=NULL && pars->hrtfCacheDirectory!=NULL){
+        cachePath = saf_fileCache_createFilePath(pars->hrtfCacheDirectory, pars->sofa_filepath, "ambi_bin", pData->fs, HOP_SIZE, (int)pData->preProc, &cacheKey);
+        if(cachePath!=NULL && ambi_bin_loadHRTFsFromCache(hAmbi, cachePath, &cacheKey))
+            pData->reinit_hrtfsFLAG = 0;
+    }
+#endif
     
     if(pData->reinit_hrtfsFLAG){
         /* load sofa file or default hrir data */
@@ -268,8 +285,16 @@ void ambi_bin_initCodec
                                   pData->preProc == HRIR_PREPROC_EQ    || pData->preProc == HRIR_PREPROC_ALL ? 1 : 0, /* Apply Diffuse-field EQ? */
                                   pData->preProc == HRIR_PREPROC_PHASE || pData->preProc == HRIR_PREPROC_ALL ? 1 : 0, /* Apply phase simplification EQ? */
                                   pars->hrtf_fb);
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+        /* Cache the pre-processed HRTFs for this sofa file */
+        if(cachePath!=NULL && !pData->useDefaultHRIRsFLAG)
+            ambi_bin_saveHRTFsToCache(hAmbi, cachePath, &cacheKey);
+#endif
         pData->reinit_hrtfsFLAG = 0;
     }
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+    free(cachePath);
+#endif
     
     /* get new decoder */
     strcpy(pData->progressBarText,"Computing Decoder");
@@ -349,7 +374,7 @@ void ambi_bin_initCodec
 
         /* apply to decoding matrix */
         for (int idxBand=0; idxBand<numBands; idxBand++){
-            for (int idxSH=0; idxSH<pData->nSH; idxSH++){
+            for (int idxSH=0; idxSH<nSH; idxSH++){
                 decMtx[idxBand*NUM_EARS*nSH+0*nSH+idxSH] = crmulf(decMtx[idxBand*NUM_EARS*nSH+0*nSH+idxSH], eqGain[idxBand]); /* left ear */
                 decMtx[idxBand*NUM_EARS*nSH+1*nSH+idxSH] = crmulf(decMtx[idxBand*NUM_EARS*nSH+1*nSH+idxSH], eqGain[idxBand]); /* right ear */
             }
@@ -362,19 +387,24 @@ void ambi_bin_initCodec
     }
     
     /* replace current decoder */
-    memset(pars->M_dec, 0, HYBRID_BANDS*NUM_EARS*MAX_NUM_SH_SIGNALS*sizeof(float_complex));
+    decoder = (ambi_bin_decoderState*)calloc1d(1, sizeof(ambi_bin_decoderState));
+    decoder->id = ++(pData->decoderID);
+    decoder->order = order;
+    decoder->nSH = nSH;
     for(band=0; band<HYBRID_BANDS; band++)
         for(i=0; i<NUM_EARS; i++)
             for(j=0; j<nSH; j++)
-                pars->M_dec[band][i][j] = decMtx[band*NUM_EARS*nSH + i*nSH + j];
+                decoder->M_dec[band][i][j] = decMtx[band*NUM_EARS*nSH + i*nSH + j];
     free(decMtx);
+    saf_rcu_publish(pData->hDecoder, (void*)decoder);
     
     pData->order = order;
 
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
 }
 
 void ambi_bin_process
@@ -388,11 +418,10 @@ void ambi_bin_process
 )
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    ambi_bin_codecPars* pars = pData->pars;
-    int ch, i, j, band;
+    ambi_bin_decoderState* decoder;
+    int ch, i, l, nl, bandIdx, offset, ear, band, ticket;
     const float_complex calpha = cmplxf(1.0f,0.0f), cbeta = cmplxf(0.0f, 0.0f);
     float Rxyz[3][3];
-    float M_rot_tmp[MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS];
     
     /* local copies of user parameters */
     int order, nSH, enableRot;
@@ -400,13 +429,21 @@ void ambi_bin_process
     CH_ORDER chOrdering;
     norm = pData->norm;
     chOrdering = pData->chOrdering;
-    order = pData->order;
-    nSH = (order+1)*(order+1);
     enableRot = pData->enableRotation;
 
+    /* Current decoder (NULL until the first initialisation is complete) */
+    decoder = (ambi_bin_decoderState*)saf_rcu_acquire(pData->hDecoder, &ticket);
+
     /* Process frame */
-    if (nSamples == AMBI_BIN_FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
+    if (nSamples == AMBI_BIN_FRAME_SIZE && decoder!=NULL) {
+        order = decoder->order;
+        nSH = decoder->nSH;
+
+        /* The rotation should be baked into the new decoder */
+        if(decoder->id!=pData->M_dec_rotID){
+            pData->recalc_M_rotFLAG = 1;
+            pData->M_dec_rotID = decoder->id;
+        }
 
         /* Load time-domain data */
         for(i=0; i < SAF_MIN(nSH, nInputs); i++)
@@ -428,26 +465,32 @@ void ambi_bin_process
         }
 
         /* Apply time-frequency transform (TFT) */
-        afSTFT_forward_knownDimensions(pData->hSTFT, pData->SHFrameTD, AMBI_BIN_FRAME_SIZE, MAX_NUM_SH_SIGNALS, TIME_SLOTS, pData->SHframeTF);
+        afSTFT_forward_knownDimensions_nCH(pData->hSTFT, pData->SHFrameTD, AMBI_BIN_FRAME_SIZE, MAX_NUM_SH_SIGNALS, TIME_SLOTS, nSH, pData->SHframeTF);
 
         /* Main processing: */
         if(order > 0 && enableRot) {
             /* Apply rotation */
             if(pData->recalc_M_rotFLAG){
                 /* Compute the new SH rotation matrix */
-                memset(pData->M_rot, 0, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float_complex));
                 yawPitchRoll2Rzyx(pData->yaw, pData->pitch, pData->roll, pData->useRollPitchYawFlag, Rxyz);
-                getSHrotMtxReal(Rxyz, (float*)M_rot_tmp, order);
-                for (i = 0; i < nSH; i++)
-                    for (j = 0; j < nSH; j++)
-                        pData->M_rot[i][j] = cmplxf(M_rot_tmp[i*nSH + j], 0.0f);
+                getSHrotMtxRealPacked(Rxyz, pData->M_rot, order);
 
-                /* Bake the rotation into the decoding matrix */
+                /* Bake the rotation into the decoding matrix. Since the rotation matrix is real and block-diagonal, each
+                 * block of decoding coefficients of order l (i.e. their real and imaginary parts, which are interleaved) is
+                 * rotated as: M_dec_rot(:,block) = (R_l^T * M_dec(:,block)^T)^T */
                 for(band = 0; band < HYBRID_BANDS; band++) {
-                    cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, nSH, nSH, &calpha,
-                                pars->M_dec[band], MAX_NUM_SH_SIGNALS,
-                                pData->M_rot, MAX_NUM_SH_SIGNALS, &cbeta,
-                                pars->M_dec_rot[band], MAX_NUM_SH_SIGNALS);
+                    for(ear = 0; ear < NUM_EARS; ear++) {
+                        bandIdx = offset = 0;
+                        for(l = 0; l <= order; l++) {
+                            nl = 2*l+1;
+                            cblas_sgemm(CblasRowMajor, CblasTrans, CblasNoTrans, nl, 2, nl, 1.0f,
+                                        pData->M_rot + offset, nl,
+                                        (float*)&(decoder->M_dec[band][ear][bandIdx]), 2, 0.0f,
+                                        (float*)&(pData->M_dec_rot[band][ear][bandIdx]), 2);
+                            bandIdx += nl;
+                            offset += nl*nl;
+                        }
+                    }
                 }
                 pData->recalc_M_rotFLAG = 0;
             }
@@ -456,7 +499,7 @@ void ambi_bin_process
         /* Apply the decoder to go from SH input to binaural output */
         for(band = 0; band < HYBRID_BANDS; band++) {
             cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, TIME_SLOTS, nSH, &calpha,
-                        enableRot ? pars->M_dec_rot[band] : pars->M_dec[band], MAX_NUM_SH_SIGNALS,
+                        enableRot ? pData->M_dec_rot[band] : decoder->M_dec[band], MAX_NUM_SH_SIGNALS,
                         FLATTEN2D(pData->SHframeTF[band]), TIME_SLOTS, &cbeta,
                         FLATTEN2D(pData->binframeTF[band]), TIME_SLOTS);
         }
@@ -474,7 +517,7 @@ void ambi_bin_process
         for (ch=0; ch < nOutputs; ch++)
             memset(outputs[ch],0, AMBI_BIN_FRAME_SIZE*sizeof(float));
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hDecoder, ticket);
 }
 
 
@@ -509,6 +552,19 @@ void ambi_bin_setSofaFilePath(void* const hAmbi, const char* path)
 
 }
 
+void ambi_bin_setHRTFcacheDirectory(void* const hAmbi, const char* path)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+    ambi_bin_codecPars* pars = pData->pars;
+
+    free(pars->hrtfCacheDirectory);
+    pars->hrtfCacheDirectory = NULL;
+    if(path!=NULL){
+        pars->hrtfCacheDirectory = malloc1d(strlen(path) + 1);
+        strcpy(pars->hrtfCacheDirectory, path);
+    }
+}
+
 void ambi_bin_setInputOrderPreset(void* const hAmbi, SH_ORDERS newOrder)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
@@ -651,7 +707,7 @@ int ambi_bin_getFrameSize(void)
 CODEC_STATUS ambi_bin_getCodecStatus(void* const hAmbi)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float ambi_bin_getProgressBar0_1(void* const hAmbi)
@@ -51,10 +51,106 @@
 void ambi_bin_setCodecStatus(void* const hAmbi, CODEC_STATUS newStatus)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* (If an initialisation is currently ongoing, then it will not mark the
+     * codec as initialised once it is done, and ambi_bin_initCodec() will
+     * simply be called again) */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void ambi_bin_destroyDecoderState(void** const phState)
+{
+    ambi_bin_decoderState *state = (ambi_bin_decoderState*)(*phState);
+
+    if(state!=NULL){
+        free(state);
+        state = NULL;
+        *phState = NULL;
+    }
+}
+
+/** Number of integers in the "dims" array of the HRTF cache */
+#define AMBI_BIN_CACHE_NUM_DIMS ( 4 )
+/** Number of arrays in the HRTF cache (excluding "dims") */
+#define AMBI_BIN_CACHE_NUM_ARRAYS ( 5 )
+
+/**
+ * Describes the arrays of the HRTF cache, for the given "dims" (the weights are
+ * the last array, as they are only cached when they were computed) */
+static void ambi_bin_getHRTFCacheArrays
+(
+    ambi_bin_codecPars* pars,
+    const int dims[AMBI_BIN_CACHE_NUM_DIMS],
+    saf_fileCache_array arrays[AMBI_BIN_CACHE_NUM_ARRAYS]
+)
+{
+    const long len = dims[1];
+    const long nDirs = dims[2];
+    const saf_fileCache_array cacheArrays[AMBI_BIN_CACHE_NUM_ARRAYS] = {
+        { "hrirs",         (void**)&(pars->hrirs),         nDirs*NUM_EARS*len*sizeof(float),                  0 },
+        { "hrir_dirs_deg", (void**)&(pars->hrir_dirs_deg), nDirs*2*sizeof(float),                             0 },
+        { "itds_s",        (void**)&(pars->itds_s),        nDirs*sizeof(float),                               0 },
+        { "hrtf_fb",       (void**)&(pars->hrtf_fb),       HYBRID_BANDS*NUM_EARS*nDirs*sizeof(float_complex), 0 },
+        { "weights",       (void**)&(pars->weights),       nDirs*sizeof(float),                               !dims[3] }
+    };
+
+    memcpy(arrays, cacheArrays, sizeof(cacheArrays));
+}
+
+int ambi_bin_loadHRTFsFromCache
+(
+    void* const hAmbi,
+    const char* cachePath,
+    const saf_fileCache_key* key
+)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+    ambi_bin_codecPars* pars = pData->pars;
+    void* hCache;
+    int loaded;
+    int dims[AMBI_BIN_CACHE_NUM_DIMS];
+    saf_fileCache_array arrays[AMBI_BIN_CACHE_NUM_ARRAYS];
+
+    if(saf_fileCache_open(&hCache, cachePath, key)!=SAF_FILECACHE_OK)
+        return 0;
+    loaded = saf_fileCache_getDims(hCache, AMBI_BIN_CACHE_NUM_DIMS, dims)==SAF_FILECACHE_OK && dims[1]>0 && dims[2]>0;
+    if(loaded){
+        ambi_bin_getHRTFCacheArrays(pars, dims, arrays);
+        loaded = saf_fileCache_loadArrays(hCache, AMBI_BIN_CACHE_NUM_ARRAYS, arrays)==SAF_FILECACHE_OK;
+    }
+    saf_fileCache_close(&hCache);
+    if(!loaded)
+        return 0;
+
+    pars->hrir_fs = dims[0];
+    pars->hrir_len = dims[1];
+    pars->N_hrir_dirs = dims[2];
+    if(!dims[3]){
+        free(pars->weights);
+        pars->weights = NULL;
+    }
+    return 1;
+}
+
+void ambi_bin_saveHRTFsToCache
+(
+    void* const hAmbi,
+    const char* cachePath,
+    const saf_fileCache_key* key
+)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+    ambi_bin_codecPars* pars = pData->pars;
+    int dims[AMBI_BIN_CACHE_NUM_DIMS];
+    saf_fileCache_array arrays[AMBI_BIN_CACHE_NUM_ARRAYS];
+
+    dims[0] = pars->hrir_fs;
+    dims[1] = pars->hrir_len;
+    dims[2] = pars->N_hrir_dirs;
+    dims[3] = pars->weights!=NULL ? 1 : 0;
+    ambi_bin_getHRTFCacheArrays(pars, dims, arrays);
+
+    /* (the weights are not computed for dense measurement grids) */
+    if(saf_fileCache_saveArrays(cachePath, key, AMBI_BIN_CACHE_NUM_DIMS, dims, dims[3] ? AMBI_BIN_CACHE_NUM_ARRAYS : AMBI_BIN_CACHE_NUM_ARRAYS-1, arrays)!=SAF_FILECACHE_OK){
+        saf_print_warning("Unable to write the HRTF cache file.");
     }
-    pData->codecStatus = newStatus;
 }
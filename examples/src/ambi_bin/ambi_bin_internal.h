@@ -82,15 +82,25 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
 
-/** Contains variables for sofa file loading, HRIRs, and the binaural decoder */
+/**
+ * The binaural decoder, as handed over to the processing thread by
+ * ambi_bin_initCodec() (see saf_rcu_publish())
+ */
+typedef struct _ambi_bin_decoderState
+{
+    int id;                 /**< Unique ID of this decoder (incremented with each re-init) */
+    int order;              /**< Decoding order */
+    int nSH;                /**< Number of spherical harmonic signals */
+    float_complex M_dec[HYBRID_BANDS][NUM_EARS][MAX_NUM_SH_SIGNALS]; /**< Decoding matrix per band*/
+
+}ambi_bin_decoderState;
+
+/** Contains variables for sofa file loading and HRIRs */
 typedef struct _ambi_bin_codecPars
 {
-    /* Decoder */
-    float_complex M_dec[HYBRID_BANDS][NUM_EARS][MAX_NUM_SH_SIGNALS];     /**< Decoding matrix per band*/
-    float_complex M_dec_rot[HYBRID_BANDS][NUM_EARS][MAX_NUM_SH_SIGNALS]; /**< Decording matrix per band, with sound-field rotation baked-in */
-    
     /* sofa file info */
     char* sofa_filepath;    /**< absolute/relevative file path for a sofa file */
+    char* hrtfCacheDirectory; /**< directory in which the HRTFs computed for a sofa file are cached; NULL: no caching */
     float* hrirs;           /**< time domain HRIRs; FLAT: N_hrir_dirs x 2 x hrir_len */
     float* hrir_dirs_deg;   /**< directions of the HRIRs in degrees [azi elev]; FLAT: N_hrir_dirs x 2 */
     int N_hrir_dirs;        /**< number of HRIR directions in the current sofa file */
@@ -123,14 +133,20 @@ typedef struct _ambi_bin
     float freqVector[HYBRID_BANDS]; /**< frequency vector for time-frequency transform, in Hz */
      
     /* our codec configuration */
-    CODEC_STATUS codecStatus;       /**< see #CODEC_STATUS */
+    volatile int codecStatus;       /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;  /**< 1: ambi_bin_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;           /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;          /**< Current (re)initialisation step, string */
     ambi_bin_codecPars* pars;       /**< Decoding specific data */
+    void* hDecoder;                 /**< Hand-off of the current #ambi_bin_decoderState to the processing thread (saf_rcu handle) */
+    int decoderID;                  /**< ID of the last #ambi_bin_decoderState to be computed */
+    
+    /* internal variables (owned by the processing thread) */
+    int M_dec_rotID;                /**< ID of the #ambi_bin_decoderState used to compute M_dec_rot */
+    float M_rot[ORDER2NSHROT(MAX_SH_ORDER)]; /**< Current SH rotation matrix; packed block-diagonal format (see getSHrotMtxRealPacked()) */
+    float_complex M_dec_rot[HYBRID_BANDS][NUM_EARS][MAX_NUM_SH_SIGNALS]; /**< Decoding matrix per band, with sound-field rotation baked-in */
     
     /* internal variables */
-    PROC_STATUS procStatus;         /**< see #PROC_STATUS */
-    float_complex M_rot[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS]; /**< Current SH rotation matrix */
     int new_order;                  /**< new decoding order (current value will be replaced by this after next re-init) */
     int nSH;                        /**< number of spherical harmonic signals */
     
@@ -169,6 +185,34 @@ typedef struct _ambi_bin
 void ambi_bin_setCodecStatus(void* const hAmbi,
                              CODEC_STATUS newStatus);
 
+/** Destroys an #ambi_bin_decoderState (see saf_rcu_destroyFn) */
+void ambi_bin_destroyDecoderState(void** const phState);
+
+/**
+ * Loads the HRIRs, ITDs, (pre-processed) HRTF filterbank coefficients and
+ * integration weights from a cache file written by ambi_bin_saveHRTFsToCache()
+ *
+ * @param[in] hAmbi     ambi_bin handle
+ * @param[in] cachePath Path of the cache file
+ * @param[in] key       Key of the cache file
+ * @returns 1: loaded, 0: not cached (in which case nothing is changed)
+ */
+int ambi_bin_loadHRTFsFromCache(void* const hAmbi,
+                                const char* cachePath,
+                                const saf_fileCache_key* key);
+
+/**
+ * Writes the HRIRs, ITDs, (pre-processed) HRTF filterbank coefficients and
+ * integration weights to a cache file
+ *
+ * @param[in] hAmbi     ambi_bin handle
+ * @param[in] cachePath Path of the cache file
+ * @param[in] key       Key of the cache file
+ */
+void ambi_bin_saveHRTFsToCache(void* const hAmbi,
+                               const char* cachePath,
+                               const saf_fileCache_key* key);
+
 
 #ifdef __cplusplus
 } /* extern "C" { */
@@ -90,12 +90,11 @@ void ambi_dec_create
     for (i=0; i<NUM_DECODERS; i++){
         for(j=0; j<MAX_SH_ORDER; j++){
             pars->M_dec[i][j] = NULL;
-            pars->M_dec_cmplx[i][j] = NULL;
             pars->M_dec_maxrE[i][j] = NULL;
-            pars->M_dec_cmplx_maxrE[i][j] = NULL;
         }
     }
     pars->sofa_filepath = NULL;
+    pars->hrtfCacheDirectory = NULL;
     pars->hrirs = NULL;
     pars->hrir_dirs_deg = NULL;
     pars->hrtf_vbap_gtableIdx = NULL;
@@ -104,12 +103,15 @@ void ambi_dec_create
     pars->hrtf_fb = NULL;
     pars->hrtf_fb_mag = NULL;
     pars->weights = NULL;
+    saf_rcu_create(&(pData->hCodecState), ambi_dec_destroyCodecState);
+    pData->codecStateID = pData->hrtf_interpStateID = 0;
+    memset(pData->hrtf_interp, 0, MAX_NUM_LOUDSPEAKERS*HYBRID_BANDS*NUM_EARS*sizeof(float_complex));
     
     /* internal parameters */ 
     pData->binauraliseLS = pData->new_binauraliseLS = 0;
     
     /* flags */
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    pData->initialisingFLAG = 0;
     pData->reinit_hrtfsFLAG = 1;
     for(ch=0; ch<MAX_NUM_LOUDSPEAKERS; ch++)
         pData->recalc_hrtf_interpFLAG[ch] = 1;
@@ -125,11 +127,10 @@ void ambi_dec_destroy
     int i, j;
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
         
         /* free afSTFT and buffers */
         if(pData->hSTFT!=NULL)
@@ -141,7 +142,9 @@ void ambi_dec_destroy
         free(pData->binframeTF);
 
         /* free codec data */
+        saf_rcu_destroy(&(pData->hCodecState));
         pars = pData->pars;
+        free(pars->hrtfCacheDirectory);
         free(pars->hrtf_vbap_gtableComp);
         free(pars->hrtf_vbap_gtableIdx);
         free(pars->hrtf_fb);
@@ -153,9 +156,7 @@ void ambi_dec_destroy
         for (i=0; i<NUM_DECODERS; i++){
             for(j=0; j<MAX_SH_ORDER; j++){
                 free(pars->M_dec[i][j]);
-                free(pars->M_dec_cmplx[i][j]);
                 free(pars->M_dec_maxrE[i][j]);
-                free(pars->M_dec_cmplx_maxrE[i][j]);
             }
         }
         free(pData->progressBarText);
@@ -184,45 +185,40 @@ void ambi_dec_initCodec
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
     ambi_dec_codecPars* pars = pData->pars;
+    ambi_dec_codecState* state;
     int i, ch, d, j, n, ng, nGrid_dirs, masterOrder, nSH_order, max_nSH, nLoudspeakers;
     float* grid_dirs_deg, *Y, *M_dec_tmp, *g, *a, *e, *a_n, *hrtf_vbap_gtable;;
     float a_avg[MAX_SH_ORDER], e_avg[MAX_SH_ORDER], azi_incl[2], sum_elev;
 #ifdef SAF_ENABLE_SOFA_READER_MODULE
     SAF_SOFA_ERROR_CODES error;
     saf_sofa_container sofa;
+    saf_fileCache_key cacheKey;
+    char* cachePath;
 #endif
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the processing loop is not paused; it carries on with the
+     * previous decoders until the new ones are ready */
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    /* reinit afSTFT */
+    /* (the afSTFT is created for the maximum number of channels, and only the
+     * channels of the current decoders are then transformed by ambi_dec_process();
+     * therefore, order and loudspeaker changes do not require any re-allocation) */
     masterOrder = pData->new_masterOrder;
     max_nSH = (masterOrder+1)*(masterOrder+1);
     nLoudspeakers = pData->new_nLoudpkrs;
-    if(pData->hSTFT==NULL){
-        if(pData->new_binauraliseLS)
-            afSTFT_create(&(pData->hSTFT), max_nSH, NUM_EARS, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
-        else
-            afSTFT_create(&(pData->hSTFT), max_nSH, nLoudspeakers, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
-        afSTFT_clearBuffers(pData->hSTFT);
-    }
-    else{
-        if(pData->new_binauraliseLS)
-            afSTFT_channelChange(pData->hSTFT, max_nSH, NUM_EARS);
-        else
-            afSTFT_channelChange(pData->hSTFT, max_nSH, nLoudspeakers);
-        afSTFT_clearBuffers(pData->hSTFT);
-    }
+    if(pData->hSTFT==NULL)
+        afSTFT_create(&(pData->hSTFT), MAX_NUM_SH_SIGNALS, SAF_MAX(MAX_NUM_LOUDSPEAKERS, NUM_EARS), HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
     pData->binauraliseLS = pData->new_binauraliseLS;
     pData->nLoudpkrs = nLoudspeakers;
     
@@ -277,28 +273,19 @@ void ambi_dec_initCodec
             nSH_order = (n+1)*(n+1);
             free(pars->M_dec[d][n-1]);
             pars->M_dec[d][n-1] = malloc1d(nLoudspeakers* nSH_order * sizeof(float));
-            free(pars->M_dec_cmplx[d][n-1]);
-            pars->M_dec_cmplx[d][n-1] = malloc1d(nLoudspeakers * nSH_order * sizeof(float_complex));
-            for(i=0; i<nLoudspeakers; i++){
-                for(j=0; j<nSH_order; j++){
-                    pars->M_dec[d][n-1][i*nSH_order+j] = M_dec_tmp[i*max_nSH +j]; /* for applying in the time domain, and... */
-                    pars->M_dec_cmplx[d][n-1][i*nSH_order+j] = cmplxf(pars->M_dec[d][n-1][i*nSH_order+j], 0.0f); /* for the time-frequency domain */
-                }
-            }
+            for(i=0; i<nLoudspeakers; i++)
+                for(j=0; j<nSH_order; j++)
+                    pars->M_dec[d][n-1][i*nSH_order+j] = M_dec_tmp[i*max_nSH +j];
             
             /* create dedicated maxrE weighted versions */
             a_n = malloc1d(nSH_order*nSH_order*sizeof(float));
             getMaxREweights(n, 1, a_n); /* weights returned as diagonal matrix */
             free(pars->M_dec_maxrE[d][n-1]);
             pars->M_dec_maxrE[d][n-1] = malloc1d(nLoudspeakers * nSH_order * sizeof(float));
-            free(pars->M_dec_cmplx_maxrE[d][n-1]);
-            pars->M_dec_cmplx_maxrE[d][n-1] = malloc1d(nLoudspeakers * nSH_order * sizeof(float_complex));
             cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLoudspeakers, nSH_order, nSH_order, 1.0f,
                         pars->M_dec[d][n-1], nSH_order,
                         a_n, nSH_order, 0.0f,
-                        pars->M_dec_maxrE[d][n-1], nSH_order); /* for applying in the time domain */
-            for(i=0; i<nLoudspeakers * nSH_order; i++)
-                pars->M_dec_cmplx_maxrE[d][n-1][i] = cmplxf(pars->M_dec_maxrE[d][n-1][i], 0.0f); /* for the time-frequency domain */
+                        pars->M_dec_maxrE[d][n-1], nSH_order);
             
             /* fire a plane-wave from each grid direction to find the total energy/amplitude (using non-maxrE weighted versions) */
             Y = malloc1d(nSH_order*sizeof(float));
@@ -334,9 +321,7 @@ void ambi_dec_initCodec
             /* remove virtual loudspeakers from the decoder (if needed) */
             if (pData->loudpkrs_nDims == 2 && (pData->dec_method[0]==DECODING_METHOD_ALLRAD || pData->dec_method[1]==DECODING_METHOD_ALLRAD)){
                 pars->M_dec[d][n-1] = realloc1d(pars->M_dec[d][n-1], pData->nLoudpkrs * nSH_order * sizeof(float));
-                pars->M_dec_cmplx[d][n-1] = realloc1d(pars->M_dec_cmplx[d][n-1], pData->nLoudpkrs * nSH_order * sizeof(float_complex));
                 pars->M_dec_maxrE[d][n-1] = realloc1d(pars->M_dec_maxrE[d][n-1], pData->nLoudpkrs * nSH_order * sizeof(float));
-                pars->M_dec_cmplx_maxrE[d][n-1] = realloc1d(pars->M_dec_cmplx_maxrE[d][n-1], pData->nLoudpkrs * nSH_order * sizeof(float_complex));
             }
         }
         free(M_dec_tmp);
@@ -345,6 +330,16 @@ void ambi_dec_initCodec
     /* update order */
     pData->masterOrder = pData->new_masterOrder;
     
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+    /* The HRTFs and tables may have already been computed for this sofa file (with the same settings) */
+    cachePath = NULL;
+    if(pData->reinit_hrtfsFLAG && !pData->useDefaultHRIRsFLAG && pars->sofa_filepath!=NULL && pars->hrtfCacheDirectory!=NULL){
+        cachePath = saf_fileCache_createFilePath(pars->hrtfCacheDirectory, pars->sofa_filepath, "ambi_dec", pData->fs, HOP_SIZE, pData->enableHRIRsPreProc, &cacheKey);
+        if(cachePath!=NULL && ambi_dec_loadHRTFsFromCache(hAmbi, cachePath, &cacheKey))
+            pData->reinit_hrtfsFLAG = 0;
+    }
+#endif
+
     /* Binaural-related initialisations */
     if(pData->reinit_hrtfsFLAG){
         strcpy(pData->progressBarText,"Computing VBAP gain table");
@@ -438,15 +433,60 @@ void ambi_dec_initCodec
         for(i=0; i<HYBRID_BANDS*NUM_EARS* (pars->N_hrir_dirs); i++)
             pars->hrtf_fb_mag[i] = cabsf(pars->hrtf_fb[i]);
         
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+        /* Cache the HRTFs and tables computed for this sofa file */
+        if(cachePath!=NULL && !pData->useDefaultHRIRsFLAG)
+            ambi_dec_saveHRTFsToCache(hAmbi, cachePath, &cacheKey);
+#endif
+
         /* clean-up */
         free(hrtf_vbap_gtable);
         pData->reinit_hrtfsFLAG = 0;
     }
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+    free(cachePath);
+#endif
+
+    /* hand the new decoders (complex-valued, for the time-frequency domain) and HRTF interpolation tables over to the
+     * processing thread */
+    state = (ambi_dec_codecState*)calloc1d(1, sizeof(ambi_dec_codecState));
+    state->id = ++(pData->codecStateID);
+    state->masterOrder = pData->masterOrder;
+    state->nLoudpkrs = pData->nLoudpkrs;
+    state->binauraliseLS = pData->binauraliseLS;
+    for(d=0; d<NUM_DECODERS; d++){
+        for(n=1; n<=state->masterOrder; n++){
+            nSH_order = (n+1)*(n+1);
+            state->M_dec_cmplx[d][n-1] = malloc1d(state->nLoudpkrs * nSH_order * sizeof(float_complex));
+            state->M_dec_cmplx_maxrE[d][n-1] = malloc1d(state->nLoudpkrs * nSH_order * sizeof(float_complex));
+            for(i=0; i<state->nLoudpkrs * nSH_order; i++){
+                state->M_dec_cmplx[d][n-1][i] = cmplxf(pars->M_dec[d][n-1][i], 0.0f);
+                state->M_dec_cmplx_maxrE[d][n-1][i] = cmplxf(pars->M_dec_maxrE[d][n-1][i], 0.0f);
+            }
+        }
+    }
+    memcpy(state->M_norm, pars->M_norm, NUM_DECODERS*MAX_SH_ORDER*2*sizeof(float));
+    if(state->binauraliseLS){
+        state->N_hrir_dirs = pars->N_hrir_dirs;
+        state->hrtf_vbapTableRes[0] = pars->hrtf_vbapTableRes[0];
+        state->hrtf_vbapTableRes[1] = pars->hrtf_vbapTableRes[1];
+        state->N_hrtf_vbap_gtable = pars->N_hrtf_vbap_gtable;
+        state->hrtf_vbap_gtableIdx = malloc1d(state->N_hrtf_vbap_gtable * 3 * sizeof(int));
+        memcpy(state->hrtf_vbap_gtableIdx, pars->hrtf_vbap_gtableIdx, state->N_hrtf_vbap_gtable * 3 * sizeof(int));
+        state->hrtf_vbap_gtableComp = malloc1d(state->N_hrtf_vbap_gtable * 3 * sizeof(float));
+        memcpy(state->hrtf_vbap_gtableComp, pars->hrtf_vbap_gtableComp, state->N_hrtf_vbap_gtable * 3 * sizeof(float));
+        state->itds_s = malloc1d(state->N_hrir_dirs*sizeof(float));
+        memcpy(state->itds_s, pars->itds_s, state->N_hrir_dirs*sizeof(float));
+        state->hrtf_fb_mag = malloc1d(HYBRID_BANDS*NUM_EARS*(state->N_hrir_dirs)*sizeof(float));
+        memcpy(state->hrtf_fb_mag, pars->hrtf_fb_mag, HYBRID_BANDS*NUM_EARS*(state->N_hrir_dirs)*sizeof(float));
+    }
+    saf_rcu_publish(pData->hCodecState, (void*)state);
     
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
     
     free(g);
     free(a);
@@ -464,8 +504,8 @@ void ambi_dec_process
 )
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    ambi_dec_codecPars* pars = pData->pars;
-    int ch, ear, i, band, orderBand, nSH_band, decIdx, nSH;
+    ambi_dec_codecState* state;
+    int ch, ear, i, band, orderBand, nSH_band, decIdx, nSH, nSH_active, ticket;
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
 
     /* local copies of user parameters */
@@ -475,20 +515,22 @@ void ambi_dec_process
     AMBI_DEC_DIFFUSE_FIELD_EQ_APPROACH diffEQmode[NUM_DECODERS];
     NORM_TYPES norm;
     CH_ORDER chOrdering;
-    masterOrder = pData->masterOrder;
-    nSH = ORDER2NSH(masterOrder);
-    nLoudspeakers = pData->nLoudpkrs;
     memcpy(orderPerBand, pData->orderPerBand, HYBRID_BANDS*sizeof(int));
     transitionFreq = pData->transitionFreq;
     memcpy(diffEQmode, pData->diffEQmode, NUM_DECODERS*sizeof(int));
-    binauraliseLS = pData->binauraliseLS;
     norm = pData->norm;
     chOrdering = pData->chOrdering;
     memcpy(rE_WEIGHT, pData->rE_WEIGHT, NUM_DECODERS*sizeof(int));
+
+    /* Current decoders (NULL until the first initialisation is complete) */
+    state = (ambi_dec_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
     
     /* Process frame */
-    if (nSamples == AMBI_DEC_FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
+    if (nSamples == AMBI_DEC_FRAME_SIZE && (state!=NULL)) {
+        masterOrder = state->masterOrder;
+        nSH = ORDER2NSH(masterOrder);
+        nLoudspeakers = state->nLoudpkrs;
+        binauraliseLS = state->binauraliseLS;
 
         /* Load time-domain data */
         for(i=0; i < SAF_MIN(nSH, nInputs); i++)
@@ -509,8 +551,11 @@ void ambi_dec_process
             case NORM_FUMA: convertHOANormConvention(FLATTEN2D(pData->SHFrameTD), masterOrder, AMBI_DEC_FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D); break;
         }
 
-        /* Apply time-frequency transform (TFT) */
-        afSTFT_forward_knownDimensions(pData->hSTFT, pData->SHFrameTD, AMBI_DEC_FRAME_SIZE, MAX_NUM_SH_SIGNALS, TIME_SLOTS, pData->SHframeTF);
+        /* Apply time-frequency transform (TFT); only to the channels required by the highest decoding order over frequency */
+        nSH_active = 0;
+        for(band=0; band<HYBRID_BANDS; band++)
+            nSH_active = SAF_MAX(nSH_active, ORDER2NSH(SAF_MAX(SAF_MIN(orderPerBand[band], masterOrder),1)));
+        afSTFT_forward_knownDimensions_nCH(pData->hSTFT, pData->SHFrameTD, AMBI_DEC_FRAME_SIZE, MAX_NUM_SH_SIGNALS, TIME_SLOTS, nSH_active, pData->SHframeTF);
 
         /* Decode to loudspeaker set-up */
         memset(FLATTEN3D(pData->outputframeTF), 0, HYBRID_BANDS*MAX_NUM_LOUDSPEAKERS*TIME_SLOTS*sizeof(float_complex));
@@ -522,24 +567,31 @@ void ambi_dec_process
             decIdx = pData->freqVector[band] < transitionFreq ? 0 : 1;
             if(rE_WEIGHT[decIdx]){
                 cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLoudspeakers, TIME_SLOTS, nSH_band, &calpha,
-                            pars->M_dec_cmplx_maxrE[decIdx][orderBand-1], nSH_band,
+                            state->M_dec_cmplx_maxrE[decIdx][orderBand-1], nSH_band,
                             FLATTEN2D(pData->SHframeTF[band]), TIME_SLOTS, &cbeta,
                             FLATTEN2D(pData->outputframeTF[band]), TIME_SLOTS);
             }
             else{
                 cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLoudspeakers, TIME_SLOTS, nSH_band, &calpha,
-                            pars->M_dec_cmplx[decIdx][orderBand-1], nSH_band,
+                            state->M_dec_cmplx[decIdx][orderBand-1], nSH_band,
                             FLATTEN2D(pData->SHframeTF[band]), TIME_SLOTS, &cbeta,
                             FLATTEN2D(pData->outputframeTF[band]), TIME_SLOTS);
             }
 
             /* Apply scaling to preserve either the amplitude or energy when the decododing orders are different over frequency */
-            cblas_sscal(/*re+im*/2*nLoudspeakers*TIME_SLOTS, pars->M_norm[decIdx][orderBand-1][diffEQmode[decIdx]==AMPLITUDE_PRESERVING ? 0 : 1],
+            cblas_sscal(/*re+im*/2*nLoudspeakers*TIME_SLOTS, state->M_norm[decIdx][orderBand-1][diffEQmode[decIdx]==AMPLITUDE_PRESERVING ? 0 : 1],
                         (float*)FLATTEN2D(pData->outputframeTF[band]), 1);
         }
 
         /* Binauralise the loudspeaker signals */
         if(binauraliseLS){
+            /* The HRTFs should be re-interpolated, if the tables have changed */
+            if(state->id!=pData->hrtf_interpStateID){
+                for(ch=0; ch<MAX_NUM_LOUDSPEAKERS; ch++)
+                    pData->recalc_hrtf_interpFLAG[ch] = 1;
+                pData->hrtf_interpStateID = state->id;
+            }
+
             /* Initialise the binaural buffer with zeros */
             memset(FLATTEN3D(pData->binframeTF), 0, HYBRID_BANDS*NUM_EARS*TIME_SLOTS * sizeof(float_complex));
 
@@ -547,14 +599,14 @@ void ambi_dec_process
             for (ch = 0; ch < nLoudspeakers; ch++) {
                 if(pData->recalc_hrtf_interpFLAG[ch]){
                     /* Re-compute the interpolated HRTF (only if loudspeaker direction changed) */
-                    ambi_dec_interpHRTFs(hAmbi, pData->loudpkrs_dirs_deg[ch][0], pData->loudpkrs_dirs_deg[ch][1], pars->hrtf_interp[ch]);
+                    ambi_dec_interpHRTFs(hAmbi, state, pData->loudpkrs_dirs_deg[ch][0], pData->loudpkrs_dirs_deg[ch][1], pData->hrtf_interp[ch]);
                     pData->recalc_hrtf_interpFLAG[ch] = 0;
                 }
 
                 /* Convolve this loudspeaker channel with the interpolated HRTF, and add it to the binaural buffer */
                 for (band = 0; band < HYBRID_BANDS; band++)
                     for (ear = 0; ear < NUM_EARS; ear++)
-                        cblas_caxpy(TIME_SLOTS, &pars->hrtf_interp[ch][band][ear], pData->outputframeTF[band][ch], 1, pData->binframeTF[band][ear], 1);
+                        cblas_caxpy(TIME_SLOTS, &pData->hrtf_interp[ch][band][ear], pData->outputframeTF[band][ch], 1, pData->binframeTF[band][ear], 1);
             }
 
             /* Scale by sqrt(number of loudspeakers) */
@@ -562,8 +614,9 @@ void ambi_dec_process
         }
 
         /* inverse-TFT */
-        afSTFT_backward_knownDimensions(pData->hSTFT,        binauraliseLS ? pData->binframeTF : pData->outputframeTF,
-                                        AMBI_DEC_FRAME_SIZE, binauraliseLS ? NUM_EARS : MAX_NUM_LOUDSPEAKERS, TIME_SLOTS, pData->outputFrameTD);
+        afSTFT_backward_knownDimensions_nCH(pData->hSTFT,        binauraliseLS ? pData->binframeTF : pData->outputframeTF,
+                                            AMBI_DEC_FRAME_SIZE, binauraliseLS ? NUM_EARS : MAX_NUM_LOUDSPEAKERS, TIME_SLOTS,
+                                            binauraliseLS ? NUM_EARS : nLoudspeakers, pData->outputFrameTD);
 
         /* Copy to output buffer */
         for(ch = 0; ch < SAF_MIN(binauraliseLS==1 ? NUM_EARS : nLoudspeakers, nOutputs); ch++)
@@ -575,7 +628,7 @@ void ambi_dec_process
         for (ch=0; ch < nOutputs; ch++)
             memset(outputs[ch], 0, AMBI_DEC_FRAME_SIZE*sizeof(float));
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 
@@ -687,6 +740,19 @@ void ambi_dec_setSofaFilePath(void* const hAmbi, const char* path)
     ambi_dec_refreshSettings(hAmbi);  // re-init and re-calc
 }
 
+void ambi_dec_setHRTFcacheDirectory(void* const hAmbi, const char* path)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    ambi_dec_codecPars* pars = pData->pars;
+
+    free(pars->hrtfCacheDirectory);
+    pars->hrtfCacheDirectory = NULL;
+    if(path!=NULL){
+        pars->hrtfCacheDirectory = malloc1d(strlen(path) + 1);
+        strcpy(pars->hrtfCacheDirectory, path);
+    }
+}
+
 void ambi_dec_setEnableHRIRsPreProc(void* const hAmbi, int newState)
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
@@ -823,7 +889,7 @@ int ambi_dec_getFrameSize(void)
 CODEC_STATUS ambi_dec_getCodecStatus(void* const hAmbi)
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float ambi_dec_getProgressBar0_1(void* const hAmbi)
@@ -48,24 +48,44 @@
 void ambi_dec_setCodecStatus(void* const hAmbi, CODEC_STATUS newStatus)
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * ambi_dec_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void ambi_dec_destroyCodecState(void** const phState)
+{
+    ambi_dec_codecState *state = (ambi_dec_codecState*)(*phState);
+    int i, j;
+
+    if(state!=NULL){
+        for (i=0; i<NUM_DECODERS; i++){
+            for(j=0; j<MAX_SH_ORDER; j++){
+                free(state->M_dec_cmplx[i][j]);
+                free(state->M_dec_cmplx_maxrE[i][j]);
+            }
+        }
+        free(state->hrtf_vbap_gtableComp);
+        free(state->hrtf_vbap_gtableIdx);
+        free(state->itds_s);
+        free(state->hrtf_fb_mag);
+        free(state);
+        state = NULL;
+        *phState = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
 void ambi_dec_interpHRTFs
 (
     void* const hAmbi,
+    ambi_dec_codecState* state,
     float azimuth_deg,
     float elevation_deg,
     float_complex h_intrp[HYBRID_BANDS][NUM_EARS]
 )
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    ambi_dec_codecPars* pars = pData->pars;
     int i, band;
     int aziIndex, elevIndex, N_azi, idx3d;
     float_complex ipd;
@@ -73,21 +93,21 @@ void ambi_dec_interpHRTFs
     float magnitudes3[HYBRID_BANDS][3][NUM_EARS], magInterp[HYBRID_BANDS][NUM_EARS];
 
     /* find closest pre-computed VBAP direction */
-    aziRes = (float)pars->hrtf_vbapTableRes[0];
-    elevRes = (float)pars->hrtf_vbapTableRes[1];
+    aziRes = (float)state->hrtf_vbapTableRes[0];
+    elevRes = (float)state->hrtf_vbapTableRes[1];
     N_azi = (int)(360.0f / aziRes + 0.5f) + 1;
     aziIndex = (int)(matlab_fmodf(azimuth_deg + 180.0f, 360.0f) / aziRes + 0.5f);
     elevIndex = (int)((elevation_deg + 90.0f) / elevRes + 0.5f);
     idx3d = elevIndex * N_azi + aziIndex;
     for (i = 0; i < 3; i++)
-        weights[0][i] = pars->hrtf_vbap_gtableComp[idx3d*3 + i];
+        weights[0][i] = state->hrtf_vbap_gtableComp[idx3d*3 + i];
     
     /* retrieve the 3 itds and hrtf magnitudes */
     for (i = 0; i < 3; i++) {
-        itds3[i] = pars->itds_s[pars->hrtf_vbap_gtableIdx[idx3d*3+i]];
+        itds3[i] = state->itds_s[state->hrtf_vbap_gtableIdx[idx3d*3+i]];
         for (band = 0; band < HYBRID_BANDS; band++) {
-            magnitudes3[band][i][0] = pars->hrtf_fb_mag[band*NUM_EARS*(pars->N_hrir_dirs) + 0*(pars->N_hrir_dirs) + pars->hrtf_vbap_gtableIdx[idx3d*3+i]];
-            magnitudes3[band][i][1] = pars->hrtf_fb_mag[band*NUM_EARS*(pars->N_hrir_dirs) + 1*(pars->N_hrir_dirs) + pars->hrtf_vbap_gtableIdx[idx3d*3+i]];
+            magnitudes3[band][i][0] = state->hrtf_fb_mag[band*NUM_EARS*(state->N_hrir_dirs) + 0*(state->N_hrir_dirs) + state->hrtf_vbap_gtableIdx[idx3d*3+i]];
+            magnitudes3[band][i][1] = state->hrtf_fb_mag[band*NUM_EARS*(state->N_hrir_dirs) + 1*(state->N_hrir_dirs) + state->hrtf_vbap_gtableIdx[idx3d*3+i]];
         }
     }
     
@@ -114,6 +134,105 @@ void ambi_dec_interpHRTFs
     }
 }
 
+/** Number of integers in the "dims" array of the HRTF cache */
+#define AMBI_DEC_CACHE_NUM_DIMS ( 7 )
+/** Number of arrays in the HRTF cache (excluding "dims") */
+#define AMBI_DEC_CACHE_NUM_ARRAYS ( 7 )
+
+/**
+ * Describes the arrays of the HRTF cache, for the given "dims" (the weights are
+ * the last array, as they are only cached when they were computed) */
+static void ambi_dec_getHRTFCacheArrays
+(
+    ambi_dec_data* pData,
+    const int dims[AMBI_DEC_CACHE_NUM_DIMS],
+    saf_fileCache_array arrays[AMBI_DEC_CACHE_NUM_ARRAYS]
+)
+{
+    ambi_dec_codecPars* pars = pData->pars;
+    const long len = dims[1];
+    const long nDirs = dims[2];
+    const long nTable = dims[6];
+    const saf_fileCache_array cacheArrays[AMBI_DEC_CACHE_NUM_ARRAYS] = {
+        { "hrirs",           (void**)&(pars->hrirs),                nDirs*NUM_EARS*len*sizeof(float),                  0 },
+        { "hrir_dirs_deg",   (void**)&(pars->hrir_dirs_deg),        nDirs*2*sizeof(float),                             0 },
+        { "itds_s",          (void**)&(pars->itds_s),               nDirs*sizeof(float),                               0 },
+        { "vbap_gtableComp", (void**)&(pars->hrtf_vbap_gtableComp), nTable*3*sizeof(float),                            0 },
+        { "vbap_gtableIdx",  (void**)&(pars->hrtf_vbap_gtableIdx),  nTable*3*sizeof(int),                              0 },
+        { "hrtf_fb",         (void**)&(pars->hrtf_fb),              HYBRID_BANDS*NUM_EARS*nDirs*sizeof(float_complex), 0 },
+        { "weights",         (void**)&(pars->weights),              nDirs*sizeof(float),                               !pData->enableHRIRsPreProc }
+    };
+
+    memcpy(arrays, cacheArrays, sizeof(cacheArrays));
+}
+
+int ambi_dec_loadHRTFsFromCache
+(
+    void* const hAmbi,
+    const char* cachePath,
+    const saf_fileCache_key* key
+)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    ambi_dec_codecPars* pars = pData->pars;
+    void* hCache;
+    int i, loaded;
+    int dims[AMBI_DEC_CACHE_NUM_DIMS];
+    saf_fileCache_array arrays[AMBI_DEC_CACHE_NUM_ARRAYS];
+
+    if(saf_fileCache_open(&hCache, cachePath, key)!=SAF_FILECACHE_OK)
+        return 0;
+    loaded = saf_fileCache_getDims(hCache, AMBI_DEC_CACHE_NUM_DIMS, dims)==SAF_FILECACHE_OK && dims[1]>0 && dims[2]>0 && dims[6]>0;
+    if(loaded){
+        ambi_dec_getHRTFCacheArrays(pData, dims, arrays);
+        loaded = saf_fileCache_loadArrays(hCache, AMBI_DEC_CACHE_NUM_ARRAYS, arrays)==SAF_FILECACHE_OK;
+    }
+    saf_fileCache_close(&hCache);
+    if(!loaded)
+        return 0;
+
+    pars->hrir_fs = dims[0];
+    pars->hrir_len = dims[1];
+    pars->N_hrir_dirs = dims[2];
+    pars->hrtf_nTriangles = dims[3];
+    pars->hrtf_vbapTableRes[0] = dims[4];
+    pars->hrtf_vbapTableRes[1] = dims[5];
+    pars->N_hrtf_vbap_gtable = dims[6];
+
+    /* calculate magnitude responses */
+    pars->hrtf_fb_mag = realloc1d(pars->hrtf_fb_mag, HYBRID_BANDS*NUM_EARS*(pars->N_hrir_dirs)*sizeof(float));
+    for(i=0; i<HYBRID_BANDS*NUM_EARS*(pars->N_hrir_dirs); i++)
+        pars->hrtf_fb_mag[i] = cabsf(pars->hrtf_fb[i]);
+    return 1;
+}
+
+void ambi_dec_saveHRTFsToCache
+(
+    void* const hAmbi,
+    const char* cachePath,
+    const saf_fileCache_key* key
+)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    ambi_dec_codecPars* pars = pData->pars;
+    int dims[AMBI_DEC_CACHE_NUM_DIMS];
+    saf_fileCache_array arrays[AMBI_DEC_CACHE_NUM_ARRAYS];
+
+    dims[0] = pars->hrir_fs;
+    dims[1] = pars->hrir_len;
+    dims[2] = pars->N_hrir_dirs;
+    dims[3] = pars->hrtf_nTriangles;
+    dims[4] = pars->hrtf_vbapTableRes[0];
+    dims[5] = pars->hrtf_vbapTableRes[1];
+    dims[6] = pars->N_hrtf_vbap_gtable;
+    ambi_dec_getHRTFCacheArrays(pData, dims, arrays);
+
+    /* (the weights are only computed when pre-processing the HRIRs) */
+    if(saf_fileCache_saveArrays(cachePath, key, AMBI_DEC_CACHE_NUM_DIMS, dims, pData->enableHRIRsPreProc ? AMBI_DEC_CACHE_NUM_ARRAYS : AMBI_DEC_CACHE_NUM_ARRAYS-1, arrays)!=SAF_FILECACHE_OK){
+        saf_print_warning("Unable to write the HRTF cache file.");
+    }
+}
+
 void loadLoudspeakerArrayPreset
 (
     LOUDSPEAKER_ARRAY_PRESETS preset,
@@ -81,6 +81,35 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
 
+/**
+ * The loudspeaker decoders and HRTF interpolation tables, as used by
+ * ambi_dec_process(). These are computed by ambi_dec_initCodec() and then
+ * handed over to the processing thread (see saf_utility_rcu.h); so processing
+ * carries on with the previous decoders while new ones are being computed.
+ */
+typedef struct _ambi_dec_codecState
+{
+    int id;                                     /**< Unique ID of this state (incremented upon each (re)initialisation) */
+    int masterOrder;                            /**< Maximum/master decoding order */
+    int nLoudpkrs;                              /**< Number of loudspeakers/virtual loudspeakers */
+    int binauraliseLS;                          /**< 1: convolve loudspeaker signals with HRTFs, 0: output loudspeaker signals */
+
+    /* decoders */
+    float_complex* M_dec_cmplx[NUM_DECODERS][MAX_SH_ORDER]; /**< complex ambisonic decoding matrices ([0] for low-freq, [1] for high-freq); FLAT: nLoudpkrs x nSH */
+    float_complex* M_dec_cmplx_maxrE[NUM_DECODERS][MAX_SH_ORDER]; /**< complex ambisonic decoding matrices with maxrE weighting ([0] for low-freq, [1] for high-freq); FLAT: nLoudpkrs x nSH */
+    float M_norm[NUM_DECODERS][MAX_SH_ORDER][2]; /**< norm coefficients to preserve omni energy/amplitude between different orders and decoders */
+
+    /* hrtf interpolation tables (only if binauraliseLS) */
+    int N_hrir_dirs;                            /**< number of HRIR directions */
+    int hrtf_vbapTableRes[2];                   /**< [azi elev] step sizes in degrees */
+    int N_hrtf_vbap_gtable;                     /**< number of interpolation directions */
+    int* hrtf_vbap_gtableIdx;                   /**< N_hrtf_vbap_gtable x 3 */
+    float* hrtf_vbap_gtableComp;                /**< N_hrtf_vbap_gtable x 3 */
+    float* itds_s;                              /**< interaural-time differences for each HRIR (in seconds); N_hrirs x 1 */
+    float* hrtf_fb_mag;                         /**< magnitudes of the HRTF filterbank coefficients; nBands x nCH x N_hrirs */
+
+}ambi_dec_codecState;
+
 /**
  * Contains variables for sofa file loading, HRTF interpolation, and the
  * loudspeaker decoders.
@@ -89,13 +118,12 @@ typedef struct _ambi_dec_codecPars
 {
     /* decoders */
     float* M_dec[NUM_DECODERS][MAX_SH_ORDER];   /**< ambisonic decoding matrices ([0] for low-freq, [1] for high-freq); FLAT: nLoudspeakers x nSH */
-    float_complex* M_dec_cmplx[NUM_DECODERS][MAX_SH_ORDER]; /**< complex ambisonic decoding matrices ([0] for low-freq, [1] for high-freq); FLAT: nLoudspeakers x nSH */
     float* M_dec_maxrE[NUM_DECODERS][MAX_SH_ORDER]; /**< ambisonic decoding matrices with maxrE weighting ([0] for low-freq, [1] for high-freq); FLAT: nLoudspeakers x nSH */
-    float_complex* M_dec_cmplx_maxrE[NUM_DECODERS][MAX_SH_ORDER]; /**< complex ambisonic decoding matrices with maxrE weighting ([0] for low-freq, [1] for high-freq); FLAT: nLoudspeakers x nSH */
     float M_norm[NUM_DECODERS][MAX_SH_ORDER][2]; /**< norm coefficients to preserve omni energy/amplitude between different orders and decoders */
     
     /* sofa file info */
     char* sofa_filepath;                        /**< absolute/relevative file path for a sofa file */
+    char* hrtfCacheDirectory;                   /**< directory in which the HRTFs and tables computed for a sofa file are cached; NULL: no caching */
     float* hrirs;                               /**< time domain HRIRs; N_hrir_dirs x 2 x hrir_len */
     float* hrir_dirs_deg;                       /**< directions of the HRIRs in degrees [azi elev]; N_hrir_dirs x 2 */
     int N_hrir_dirs;                            /**< number of HRIR directions in the current sofa file */
@@ -113,7 +141,6 @@ typedef struct _ambi_dec_codecPars
     float* itds_s;                              /**< interaural-time differences for each HRIR (in seconds); N_hrirs x 1 */
     float_complex* hrtf_fb;                     /**< HRTF filterbank coefficients; nBands x nCH x N_hrirs */
     float* hrtf_fb_mag;                         /**< magnitudes of the HRTF filterbank coefficients; nBands x nCH x N_hrirs */
-    float_complex hrtf_interp[MAX_NUM_LOUDSPEAKERS][HYBRID_BANDS][NUM_EARS]; /**< interpolated HRTFs */
     
     /* integration weights */
     float* weights;                             /**< grid integration weights of hrirs; N_hrirs x 1 */
@@ -138,10 +165,17 @@ typedef struct _ambi_dec
     float freqVector[HYBRID_BANDS];      /**< frequency vector for time-frequency transform, in Hz */
     
     /* our codec configuration */
-    CODEC_STATUS codecStatus;            /**< see #CODEC_STATUS */
+    volatile int codecStatus;            /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;       /**< 1: ambi_dec_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;                /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;               /**< Current (re)initialisation step, string */
     ambi_dec_codecPars* pars;            /**< codec parameters */
+    void* hCodecState;                   /**< Hand-off of the current #ambi_dec_codecState to the processing thread (saf_rcu handle) */
+    int codecStateID;                    /**< ID of the last #ambi_dec_codecState to be computed */
+    
+    /* internal variables (owned by the processing thread) */
+    int hrtf_interpStateID;              /**< ID of the #ambi_dec_codecState used to compute hrtf_interp */
+    float_complex hrtf_interp[MAX_NUM_LOUDSPEAKERS][HYBRID_BANDS][NUM_EARS]; /**< interpolated HRTFs */
     
     /* internal variables */
     int loudpkrs_nDims;                  /**< dimensionality of the current loudspeaker set-up */
@@ -150,7 +184,6 @@ typedef struct _ambi_dec
     int new_masterOrder;                 /**< if new_masterOrder != masterOrder, ambi_dec is reinitialised (current value will be replaced by this after next re-init) */
     
     /* flags */
-    PROC_STATUS procStatus;              /**< see #PROC_STATUS */
     int reinit_hrtfsFLAG;                /**< 0: no init required, 1: init required */
     int recalc_hrtf_interpFLAG[MAX_NUM_LOUDSPEAKERS]; /**< 0: no init required, 1: init required */
     
@@ -181,21 +214,52 @@ typedef struct _ambi_dec
  */
 void ambi_dec_setCodecStatus(void* const hCmp, CODEC_STATUS newStatus);
 
+/** Destroys a #ambi_dec_codecState (once retired by the saf_rcu handle) */
+void ambi_dec_destroyCodecState(void** const phState);
+
 /**
  * Interpolates between the 3 nearest HRTFs using amplitude-preserving VBAP
  * gains. The HRTF magnitude responses and HRIR ITDs are interpolated seperately
  * before being re-combined.
  *
  * @param[in]  hAmbi         ambi_dec handle
+ * @param[in]  state         HRTF interpolation tables to use
  * @param[in]  azimuth_deg   Interpolation direction azimuth in DEGREES
  * @param[in]  elevation_deg Interpolation direction elevation in DEGREES
  * @param[out] h_intrp       Interpolated HRTF
  */
 void ambi_dec_interpHRTFs(void* const hAmbi,
+                          ambi_dec_codecState* state,
                           float azimuth_deg,
                           float elevation_deg,
                           float_complex h_intrp[HYBRID_BANDS][NUM_EARS]);
 
+/**
+ * Loads the HRIRs, ITDs, VBAP gain table, (pre-processed) HRTF filterbank
+ * coefficients and integration weights from a cache file written by
+ * ambi_dec_saveHRTFsToCache()
+ *
+ * @param[in] hAmbi     ambi_dec handle
+ * @param[in] cachePath Path of the cache file
+ * @param[in] key       Key of the cache file
+ * @returns 1: loaded, 0: not cached (in which case nothing is changed)
+ */
+int ambi_dec_loadHRTFsFromCache(void* const hAmbi,
+                                const char* cachePath,
+                                const saf_fileCache_key* key);
+
+/**
+ * Writes the HRIRs, ITDs, VBAP gain table, (pre-processed) HRTF filterbank
+ * coefficients and integration weights to a cache file
+ *
+ * @param[in] hAmbi     ambi_dec handle
+ * @param[in] cachePath Path of the cache file
+ * @param[in] key       Key of the cache file
+ */
+void ambi_dec_saveHRTFsToCache(void* const hAmbi,
+                               const char* cachePath,
+                               const saf_fileCache_key* key);
+
 /**
  * Returns the loudspeaker directions for a specified loudspeaker array preset.
  *
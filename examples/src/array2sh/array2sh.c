@@ -204,8 +204,6 @@ void array2sh_process
 
     /* processing loop */
     if ((nSamples == ARRAY2SH_FRAME_SIZE) && (pData->reinitSHTmatrixFLAG==0) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
-
         /* Load time-domain data */
         for(i=0; i < nInputs; i++)
             utility_svvcopy(inputs[i], ARRAY2SH_FRAME_SIZE, pData->inputFrameTD[i]);
@@ -252,8 +250,6 @@ void array2sh_process
         for (ch=0; ch < nOutputs; ch++)
             memset(outputs[ch],0, ARRAY2SH_FRAME_SIZE*sizeof(float));
     }
-
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
 }
 
 /* Set Functions */
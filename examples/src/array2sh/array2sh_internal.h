@@ -137,7 +137,6 @@ typedef struct _array2sh
     int new_order;                  /**< new encoding order (current value will be replaced by this after next re-init) */
     
     /* flags */
-    PROC_STATUS procStatus;         /**< see #PROC_STATUS */
     int reinitSHTmatrixFLAG;        /**< 0: do not reinit; 1: reinit; */
     int evalRequestedFLAG;          /**< 0: do not reinit; 1: reinit; */
     
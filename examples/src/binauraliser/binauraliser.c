@@ -39,7 +39,7 @@ void binauraliser_create
 {
     binauraliser_data* pData = (binauraliser_data*)malloc1d(sizeof(binauraliser_data));
     *phBin = (void*)pData;
-    int ch, dummy;
+    int ch, set, way, dummy;
 
     /* user parameters */
     binauraliser_loadPreset(SOURCE_CONFIG_PRESET_DEFAULT, pData->src_dirs_deg, &(pData->new_nSources), &(dummy)); /*check setStateInformation if you change default preset*/
@@ -67,26 +67,34 @@ void binauraliser_create
     pData->hrirs = NULL;
     pData->hrir_dirs_deg = NULL;
     pData->sofa_filepath = NULL;
+    pData->hrtfCacheDirectory = NULL;
     pData->weights = NULL;
     pData->N_hrir_dirs = pData->hrir_loaded_len = pData->hrir_runtime_len = 0;
     pData->hrir_loaded_fs = pData->hrir_runtime_fs = -1; /* unknown */
     
-    /* vbap (amplitude normalised) */
-    pData->hrtf_vbap_gtableIdx = NULL;
-    pData->hrtf_vbap_gtableComp = NULL;
-    pData->nTriangles = pData->N_hrtf_vbap_gtable = 0;
-    
-    /* HRTF filterbank coefficients */
-    pData->itds_s = NULL;
-    pData->hrtf_fb = NULL;
-    pData->hrtf_fb_mag = NULL;
+    /* HRTFs and (vbap) interpolation tables */
+    saf_rcu_create(&(pData->hCodecState), binauraliser_destroyCodecState);
+    pData->codecStateID = pData->hrtf_interpStateID = 0;
+    pData->nTriangles = 0;
+    memset(pData->hrtf_interp, 0, MAX_NUM_INPUTS*HYBRID_BANDS*NUM_EARS*sizeof(float_complex));
+    memset(pData->hrtf_interp_prev, 0, MAX_NUM_INPUTS*HYBRID_BANDS*NUM_EARS*sizeof(float_complex));
+    memset(pData->hrtf_hop, 0, HYBRID_BANDS*NUM_EARS*MAX_NUM_INPUTS*sizeof(float_complex));
+    for(ch=0; ch<MAX_NUM_INPUTS; ch++)
+        pData->hrtf_fadePos[ch] = HRTF_FADE_NUM_HOPS;
+    pData->hrtfCache = (binauraliser_hrtfCache*)malloc1d(sizeof(binauraliser_hrtfCache));
+    pData->hrtfCache->stateID = 0; /* (i.e. empty) */
+    pData->hrtfCache->mode = pData->interpMode;
+    pData->hrtfCache->counter = 0;
+    for(set=0; set<HRTF_CACHE_NUM_SETS; set++)
+        for(way=0; way<HRTF_CACHE_NUM_WAYS; way++)
+            pData->hrtfCache->tableIdx[set][way] = -1;
 
     /* flags/status */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    pData->initialisingFLAG = 0;
     pData->reInitHRTFsAndGainTables = 1;
     for(ch=0; ch<MAX_NUM_INPUTS; ch++) {
         pData->recalc_hrtf_interpFLAG[ch] = 1;
@@ -103,11 +111,10 @@ void binauraliser_destroy
     binauraliser_data *pData = (binauraliser_data*)(*phBin);
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
         
         /* free afSTFT and buffers */
         if(pData->hSTFT !=NULL)
@@ -116,14 +123,12 @@ void binauraliser_destroy
         free(pData->outframeTD);
         free(pData->inputframeTF);
         free(pData->outputframeTF);
-        free(pData->hrtf_vbap_gtableComp);
-        free(pData->hrtf_vbap_gtableIdx);
-        free(pData->hrtf_fb);
-        free(pData->hrtf_fb_mag);
-        free(pData->itds_s);
+        saf_rcu_destroy(&(pData->hCodecState));
+        free(pData->hrtfCache);
         free(pData->hrirs);
         free(pData->hrir_dirs_deg);
         free(pData->weights);
+        free(pData->hrtfCacheDirectory);
         free(pData->progressBarText);
          
         free(pData);
@@ -157,34 +162,40 @@ void binauraliser_initCodec
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
+    binauraliser_codecState* state;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the processing loop is not paused; it carries on with the
+     * previous HRTFs and interpolation tables until the new ones are ready */
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
     /* check if TFT needs to be reinitialised */
     binauraliser_initTFT(hBin);
     
-    /* reinit HRTFs and interpolation tables */
+    /* reinit HRTFs and interpolation tables, and hand them over to the processing thread */
     if(pData->reInitHRTFsAndGainTables){
-        binauraliser_initHRTFsAndGainTables(hBin);
         pData->reInitHRTFsAndGainTables = 0;
+        state = (binauraliser_codecState*)calloc1d(1, sizeof(binauraliser_codecState));
+        state->id = ++(pData->codecStateID);
+        binauraliser_initHRTFsAndGainTables(hBin, state);
+        saf_rcu_publish(pData->hCodecState, (void*)state);
     }
     
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
-    
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
 }
 
 void binauraliser_process
@@ -198,18 +209,30 @@ void binauraliser_process
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    int ch, ear, i, band, nSources;
-    float src_dirs[MAX_NUM_INPUTS][2], Rxyz[3][3], hypotxy;
+    binauraliser_codecState* state;
+    int ch, ear, i, t, band, nSources, ticket;
+    float src_dirs[MAX_NUM_INPUTS][2], Rxyz[3][3], hypotxy, fadeIn;
+    float *h_hop;
+    const float *h_prev, *h_new;
+    float_complex calpha, cbeta;
     int enableRotation;
 
     /* copy user parameters to local variables */
-    nSources = pData->nSources;
+    nSources = saf_atomic_load(&(pData->nSources));
     enableRotation = pData->enableRotation;
     memcpy(src_dirs, pData->src_dirs_deg, MAX_NUM_INPUTS*2*sizeof(float));
 
+    /* Current HRTFs and interpolation tables (NULL until the first initialisation is complete) */
+    state = (binauraliser_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+
     /* apply binaural panner */
-    if ((nSamples == BINAURALISER_FRAME_SIZE) && (pData->hrtf_fb!=NULL) && (pData->codecStatus==CODEC_STATUS_INITIALISED) ){
-        pData->procStatus = PROC_STATUS_ONGOING;
+    if ((nSamples == BINAURALISER_FRAME_SIZE) && (state!=NULL)){
+        /* The HRTFs should be re-interpolated, if the tables have changed */
+        if(state->id!=pData->hrtf_interpStateID){
+            for(ch=0; ch<MAX_NUM_INPUTS; ch++)
+                pData->recalc_hrtf_interpFLAG[ch] = 1;
+            pData->hrtf_interpStateID = state->id;
+        }
 
         /* Load time-domain data */
         for(i=0; i < SAF_MIN(nSources,nInputs); i++)
@@ -223,8 +246,8 @@ void binauraliser_process
                 utility_svsmul(pData->inputFrameTD[ch], &(pData->src_gains[ch]), BINAURALISER_FRAME_SIZE, NULL);
         }
 
-        /* Apply time-frequency transform (TFT) */
-        afSTFT_forward_knownDimensions(pData->hSTFT, pData->inputFrameTD, BINAURALISER_FRAME_SIZE, MAX_NUM_INPUTS, TIME_SLOTS, pData->inputframeTF);
+        /* Apply time-frequency transform (TFT), for only the active sources */
+        afSTFT_forward_knownDimensions_nCH(pData->hSTFT, pData->inputFrameTD, BINAURALISER_FRAME_SIZE, MAX_NUM_INPUTS, TIME_SLOTS, nSources, pData->inputframeTF);
 
         /* Rotate source directions */
         if(enableRotation && pData->recalc_M_rotFLAG){
@@ -247,26 +270,62 @@ void binauraliser_process
             pData->recalc_M_rotFLAG = 0;
         }
 
-        /* interpolate hrtfs and apply to each source */
-        memset(FLATTEN3D(pData->outputframeTF), 0, HYBRID_BANDS*NUM_EARS*TIME_SLOTS * sizeof(float_complex));
+        /* interpolate hrtfs */
         for (ch = 0; ch < nSources; ch++) {
             if(pData->recalc_hrtf_interpFLAG[ch]){
+                /* The new fade starts from the HRTFs applied on the last hop (which may be part-way through the previous fade) */
+                for (band = 0; band < HYBRID_BANDS; band++)
+                    for (ear = 0; ear < NUM_EARS; ear++)
+                        pData->hrtf_interp_prev[ch][band][ear] = pData->hrtf_hop[band][ear][ch];
+                pData->hrtf_fadePos[ch] = 0;
+
+                /* (the HRTFs of previously visited directions are taken from the cache, rather than interpolated again) */
                 if(enableRotation)
-                    binauraliser_interpHRTFs(hBin, pData->interpMode, pData->src_dirs_rot_deg[ch][0], pData->src_dirs_rot_deg[ch][1], pData->hrtf_interp[ch]);
+                    binauraliser_getCachedHRTF(hBin, state, pData->interpMode, pData->src_dirs_rot_deg[ch][0], pData->src_dirs_rot_deg[ch][1], pData->hrtf_interp[ch]);
                 else
-                    binauraliser_interpHRTFs(hBin, pData->interpMode, pData->src_dirs_deg[ch][0], pData->src_dirs_deg[ch][1], pData->hrtf_interp[ch]);
+                    binauraliser_getCachedHRTF(hBin, state, pData->interpMode, pData->src_dirs_deg[ch][0], pData->src_dirs_deg[ch][1], pData->hrtf_interp[ch]);
                 pData->recalc_hrtf_interpFLAG[ch] = 0;
             }
+        }
+
+        /* apply the HRTFs to the sources, and sum them into the binaural buffer (scaled by the number of sources) */
+        calpha = cmplxf(1.0f/sqrtf((float)nSources), 0.0f);
+        cbeta = cmplxf(0.0f, 0.0f);
+        for (t = 0; t < TIME_SLOTS; t++){
+            /* Sources being faded are linearly interpolated from the previous HRTF to the new one, one hop at a time (a
+             * fade may therefore span several frames, if the frame size is less than HRTF_FADE_NUM_HOPS hops). The HRTFs
+             * of the other sources are already in hrtf_hop. (The arithmetic is written out, since the C99 complex
+             * helpers cannot be inlined) */
+            for (ch = 0; ch < nSources; ch++) {
+                if(pData->hrtf_fadePos[ch] < HRTF_FADE_NUM_HOPS){
+                    pData->hrtf_fadePos[ch]++;
+                    fadeIn = (float)pData->hrtf_fadePos[ch]/(float)HRTF_FADE_NUM_HOPS;
+                    for (band = 0; band < HYBRID_BANDS; band++){
+                        for (ear = 0; ear < NUM_EARS; ear++){
+                            h_prev = (const float*)&(pData->hrtf_interp_prev[ch][band][ear]);
+                            h_new = (const float*)&(pData->hrtf_interp[ch][band][ear]);
+                            h_hop = (float*)&(pData->hrtf_hop[band][ear][ch]);
+                            if(pData->hrtf_fadePos[ch] == HRTF_FADE_NUM_HOPS){
+                                h_hop[0] = h_new[0];
+                                h_hop[1] = h_new[1];
+                            }
+                            else{
+                                h_hop[0] = h_prev[0] + fadeIn*(h_new[0] - h_prev[0]);
+                                h_hop[1] = h_prev[1] + fadeIn*(h_new[1] - h_prev[1]);
+                            }
+                        }
+                    }
+                }
+            }
 
-            /* Convolve this channel with the interpolated HRTF, and add it to the binaural buffer */
+            /* One (#NUM_EARS x nSources) mixing matrix per band */
             for (band = 0; band < HYBRID_BANDS; band++)
-                for (ear = 0; ear < NUM_EARS; ear++)
-                    cblas_caxpy(TIME_SLOTS, &pData->hrtf_interp[ch][band][ear], pData->inputframeTF[band][ch], 1, pData->outputframeTF[band][ear], 1);
+                cblas_cgemv(CblasRowMajor, CblasNoTrans, NUM_EARS, nSources, &calpha,
+                            pData->hrtf_hop[band], MAX_NUM_INPUTS,
+                            &(pData->inputframeTF[band][0][t]), TIME_SLOTS, &cbeta,
+                            &(pData->outputframeTF[band][0][t]), TIME_SLOTS);
         }
 
-        /* scale by number of sources */ 
-        cblas_sscal(/*re+im*/2*HYBRID_BANDS*NUM_EARS*TIME_SLOTS, 1.0f/sqrtf((float)nSources), (float*)FLATTEN3D(pData->outputframeTF), 1);
-
         /* inverse-TFT */
         afSTFT_backward_knownDimensions(pData->hSTFT, pData->outputframeTF, BINAURALISER_FRAME_SIZE, NUM_EARS, TIME_SLOTS, pData->outframeTD);
 
@@ -281,7 +340,7 @@ void binauraliser_process
             memset(outputs[ch],0, BINAURALISER_FRAME_SIZE*sizeof(float));
     }
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 /* Set Functions */
@@ -349,6 +408,18 @@ void binauraliser_setSofaFilePath(void* const hBin, const char* path)
     binauraliser_refreshSettings(hBin);  // re-init and re-calc
 }
 
+void binauraliser_setHRTFcacheDirectory(void* const hBin, const char* path)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+
+    free(pData->hrtfCacheDirectory);
+    pData->hrtfCacheDirectory = NULL;
+    if(path!=NULL){
+        pData->hrtfCacheDirectory = malloc1d(strlen(path) + 1);
+        strcpy(pData->hrtfCacheDirectory, path);
+    }
+}
+
 void binauraliser_setEnableHRIRsDiffuseEQ(void* const hBin, int newState)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
@@ -480,7 +551,7 @@ int binauraliser_getFrameSize(void)
 CODEC_STATUS binauraliser_getCodecStatus(void* const hBin)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float binauraliser_getProgressBar0_1(void* const hBin)
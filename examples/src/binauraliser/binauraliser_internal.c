@@ -32,44 +32,45 @@
 
 #include "binauraliser_internal.h"
 
-void binauraliser_setCodecStatus(void* const hBin, CODEC_STATUS newStatus)
+/** Returns the index of the closest pre-computed direction in the VBAP gain table */
+static int binauraliser_getVBAPtableIndex
+(
+    binauraliser_codecState* state,
+    float azimuth_deg,
+    float elevation_deg
+)
 {
-    binauraliser_data *pData = (binauraliser_data*)(hBin);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
-    }
-    pData->codecStatus = newStatus;
+    int aziIndex, elevIndex, N_azi;
+    float aziRes, elevRes;
+
+    aziRes = (float)state->hrtf_vbapTableRes[0];
+    elevRes = (float)state->hrtf_vbapTableRes[1];
+    N_azi = (int)(360.0f / aziRes + 0.5f) + 1;
+    aziIndex = (int)(matlab_fmodf(azimuth_deg + 180.0f, 360.0f) / aziRes + 0.5f);
+    elevIndex = (int)((elevation_deg + 90.0f) / elevRes + 0.5f);
+    return elevIndex * N_azi + aziIndex;
 }
 
-void binauraliser_interpHRTFs
+/** Interpolates the HRTFs for a given direction of the VBAP gain table */
+static void binauraliser_interpHRTFs_tableIndex
 (
     void* const hBin,
+    binauraliser_codecState* state,
     INTERP_MODES mode,
-    float azimuth_deg,
-    float elevation_deg,
+    int idx3d,
     float_complex h_intrp[HYBRID_BANDS][NUM_EARS]
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
     int i, band;
-    int aziIndex, elevIndex, N_azi, idx3d;
     float_complex ipd;
     float_complex weights_cmplx[3], hrtf_fb3[NUM_EARS][3];
-    float aziRes, elevRes, weights[3], itds3[3],  itdInterp;
+    float weights[3], itds3[3],  itdInterp;
     float magnitudes3[HYBRID_BANDS][3][NUM_EARS], magInterp[HYBRID_BANDS][NUM_EARS];
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
-     
-    /* find closest pre-computed VBAP direction */
-    aziRes = (float)pData->hrtf_vbapTableRes[0];
-    elevRes = (float)pData->hrtf_vbapTableRes[1];
-    N_azi = (int)(360.0f / aziRes + 0.5f) + 1;
-    aziIndex = (int)(matlab_fmodf(azimuth_deg + 180.0f, 360.0f) / aziRes + 0.5f);
-    elevIndex = (int)((elevation_deg + 90.0f) / elevRes + 0.5f);
-    idx3d = elevIndex * N_azi + aziIndex;
+
     for (i = 0; i < 3; i++)
-        weights[i] = pData->hrtf_vbap_gtableComp[idx3d*3 + i];
+        weights[i] = state->hrtf_vbap_gtableComp[idx3d*3 + i];
 
     switch(mode){
         case INTERP_TRI:
@@ -77,8 +78,8 @@ void binauraliser_interpHRTFs
                 weights_cmplx[i] = cmplxf(weights[i], 0.0f);
             for (band = 0; band < HYBRID_BANDS; band++) {
                 for (i = 0; i < 3; i++){
-                    hrtf_fb3[0][i] = pData->hrtf_fb[band*NUM_EARS*(pData->N_hrir_dirs) + 0*(pData->N_hrir_dirs) + pData->hrtf_vbap_gtableIdx[idx3d*3+i]];
-                    hrtf_fb3[1][i] = pData->hrtf_fb[band*NUM_EARS*(pData->N_hrir_dirs) + 1*(pData->N_hrir_dirs) + pData->hrtf_vbap_gtableIdx[idx3d*3+i]];
+                    hrtf_fb3[0][i] = state->hrtf_fb[band*NUM_EARS*(state->N_hrir_dirs) + 0*(state->N_hrir_dirs) + state->hrtf_vbap_gtableIdx[idx3d*3+i]];
+                    hrtf_fb3[1][i] = state->hrtf_fb[band*NUM_EARS*(state->N_hrir_dirs) + 1*(state->N_hrir_dirs) + state->hrtf_vbap_gtableIdx[idx3d*3+i]];
                 } 
                 cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, 1, 3, &calpha,
                             (float_complex*)hrtf_fb3, 3,
@@ -90,10 +91,10 @@ void binauraliser_interpHRTFs
         case INTERP_TRI_PS:
             /* retrieve the 3 itds and hrtf magnitudes */
             for (i = 0; i < 3; i++) {
-                itds3[i] = pData->itds_s[pData->hrtf_vbap_gtableIdx[idx3d*3+i]];
+                itds3[i] = state->itds_s[state->hrtf_vbap_gtableIdx[idx3d*3+i]];
                 for (band = 0; band < HYBRID_BANDS; band++) {
-                    magnitudes3[band][i][0] = pData->hrtf_fb_mag[band*NUM_EARS*(pData->N_hrir_dirs) + 0*(pData->N_hrir_dirs) + pData->hrtf_vbap_gtableIdx[idx3d*3+i]];
-                    magnitudes3[band][i][1] = pData->hrtf_fb_mag[band*NUM_EARS*(pData->N_hrir_dirs) + 1*(pData->N_hrir_dirs) + pData->hrtf_vbap_gtableIdx[idx3d*3+i]];
+                    magnitudes3[band][i][0] = state->hrtf_fb_mag[band*NUM_EARS*(state->N_hrir_dirs) + 0*(state->N_hrir_dirs) + state->hrtf_vbap_gtableIdx[idx3d*3+i]];
+                    magnitudes3[band][i][1] = state->hrtf_fb_mag[band*NUM_EARS*(state->N_hrir_dirs) + 1*(state->N_hrir_dirs) + state->hrtf_vbap_gtableIdx[idx3d*3+i]];
                 }
             }
 
@@ -122,7 +123,210 @@ void binauraliser_interpHRTFs
     }
 }
 
-void binauraliser_initHRTFsAndGainTables(void* const hBin)
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+/** Number of integers in the "dims" array of the HRTF cache */
+#define BINAURALISER_CACHE_NUM_DIMS ( 9 )
+/** Number of arrays in the HRTF cache (excluding "dims") */
+#define BINAURALISER_CACHE_NUM_ARRAYS ( 7 )
+
+/**
+ * Describes the arrays of the HRTF cache, for the given "dims" (the weights are
+ * the last array, as they are only cached when they were computed) */
+static void binauraliser_getHRTFCacheArrays
+(
+    binauraliser_data* pData,
+    binauraliser_codecState* state,
+    const int dims[BINAURALISER_CACHE_NUM_DIMS],
+    saf_fileCache_array arrays[BINAURALISER_CACHE_NUM_ARRAYS]
+)
+{
+    const long runtimeLen = dims[3];
+    const long nDirs = dims[4];
+    const long nTable = dims[8];
+    const saf_fileCache_array cacheArrays[BINAURALISER_CACHE_NUM_ARRAYS] = {
+        { "hrirs",           (void**)&(pData->hrirs),                nDirs*NUM_EARS*runtimeLen*sizeof(float),           0 },
+        { "hrir_dirs_deg",   (void**)&(pData->hrir_dirs_deg),        nDirs*2*sizeof(float),                             0 },
+        { "itds_s",          (void**)&(state->itds_s),               nDirs*sizeof(float),                               0 },
+        { "vbap_gtableComp", (void**)&(state->hrtf_vbap_gtableComp), nTable*3*sizeof(float),                            0 },
+        { "vbap_gtableIdx",  (void**)&(state->hrtf_vbap_gtableIdx),  nTable*3*sizeof(int),                              0 },
+        { "hrtf_fb",         (void**)&(state->hrtf_fb),              HYBRID_BANDS*NUM_EARS*nDirs*sizeof(float_complex), 0 },
+        { "weights",         (void**)&(pData->weights),              nDirs*sizeof(float),                               !pData->enableHRIRsDiffuseEQ }
+    };
+
+    memcpy(arrays, cacheArrays, sizeof(cacheArrays));
+}
+
+/**
+ * Loads the HRTFs and interpolation tables from a cache file, written by
+ * binauraliser_saveHRTFsToCache(); returns 1 if successful, 0 if not (in which
+ * case pData/state are left unchanged)
+ */
+static int binauraliser_loadHRTFsFromCache
+(
+    void* const hBin,
+    binauraliser_codecState* state,
+    const char* cachePath,
+    const saf_fileCache_key* key
+)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    void* hCache;
+    int i, loaded;
+    int dims[BINAURALISER_CACHE_NUM_DIMS];
+    saf_fileCache_array arrays[BINAURALISER_CACHE_NUM_ARRAYS];
+
+    if(saf_fileCache_open(&hCache, cachePath, key)!=SAF_FILECACHE_OK)
+        return 0;
+    loaded = saf_fileCache_getDims(hCache, BINAURALISER_CACHE_NUM_DIMS, dims)==SAF_FILECACHE_OK && dims[1]>0 && dims[3]>0 && dims[4]>0 && dims[8]>0;
+    if(loaded){
+        binauraliser_getHRTFCacheArrays(pData, state, dims, arrays);
+        loaded = saf_fileCache_loadArrays(hCache, BINAURALISER_CACHE_NUM_ARRAYS, arrays)==SAF_FILECACHE_OK;
+    }
+    saf_fileCache_close(&hCache);
+    if(!loaded)
+        return 0;
+
+    pData->hrir_loaded_fs = dims[0];
+    pData->hrir_loaded_len = dims[1];
+    pData->hrir_runtime_fs = dims[2];
+    pData->hrir_runtime_len = dims[3];
+    pData->N_hrir_dirs = dims[4];
+    pData->nTriangles = dims[5];
+    state->hrtf_vbapTableRes[0] = dims[6];
+    state->hrtf_vbapTableRes[1] = dims[7];
+    state->N_hrtf_vbap_gtable = dims[8];
+    state->N_hrir_dirs = dims[4];
+
+    /* calculate magnitude responses */
+    state->hrtf_fb_mag = realloc1d(state->hrtf_fb_mag, HYBRID_BANDS*NUM_EARS*(state->N_hrir_dirs)*sizeof(float));
+    for(i=0; i<HYBRID_BANDS*NUM_EARS*(state->N_hrir_dirs); i++)
+        state->hrtf_fb_mag[i] = cabsf(state->hrtf_fb[i]);
+    return 1;
+}
+
+/** Writes the HRTFs and interpolation tables to a cache file */
+static void binauraliser_saveHRTFsToCache
+(
+    void* const hBin,
+    binauraliser_codecState* state,
+    const char* cachePath,
+    const saf_fileCache_key* key
+)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    int dims[BINAURALISER_CACHE_NUM_DIMS];
+    saf_fileCache_array arrays[BINAURALISER_CACHE_NUM_ARRAYS];
+
+    dims[0] = pData->hrir_loaded_fs;
+    dims[1] = pData->hrir_loaded_len;
+    dims[2] = pData->hrir_runtime_fs;
+    dims[3] = pData->hrir_runtime_len;
+    dims[4] = pData->N_hrir_dirs;
+    dims[5] = pData->nTriangles;
+    dims[6] = state->hrtf_vbapTableRes[0];
+    dims[7] = state->hrtf_vbapTableRes[1];
+    dims[8] = state->N_hrtf_vbap_gtable;
+    binauraliser_getHRTFCacheArrays(pData, state, dims, arrays);
+
+    /* (the weights are only computed when applying the diffuse-field EQ) */
+    if(saf_fileCache_saveArrays(cachePath, key, BINAURALISER_CACHE_NUM_DIMS, dims, pData->enableHRIRsDiffuseEQ ? BINAURALISER_CACHE_NUM_ARRAYS : BINAURALISER_CACHE_NUM_ARRAYS-1, arrays)!=SAF_FILECACHE_OK){
+        saf_print_warning("Unable to write the HRTF cache file.");
+    }
+}
+#endif /* SAF_ENABLE_SOFA_READER_MODULE */
+
+void binauraliser_setCodecStatus(void* const hBin, CODEC_STATUS newStatus)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * binauraliser_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void binauraliser_destroyCodecState(void** const phState)
+{
+    binauraliser_codecState *state = (binauraliser_codecState*)(*phState);
+
+    if(state!=NULL){
+        free(state->hrtf_vbap_gtableComp);
+        free(state->hrtf_vbap_gtableIdx);
+        free(state->hrtf_fb);
+        free(state->hrtf_fb_mag);
+        free(state->itds_s);
+        free(state);
+        state = NULL;
+        *phState = NULL;
+    }
+}
+
+void binauraliser_interpHRTFs
+(
+    void* const hBin,
+    binauraliser_codecState* state,
+    INTERP_MODES mode,
+    float azimuth_deg,
+    float elevation_deg,
+    float_complex h_intrp[HYBRID_BANDS][NUM_EARS]
+)
+{
+    /* find closest pre-computed VBAP direction, and interpolate the HRTFs for it */
+    binauraliser_interpHRTFs_tableIndex(hBin, state, mode, binauraliser_getVBAPtableIndex(state, azimuth_deg, elevation_deg), h_intrp);
+}
+
+void binauraliser_getCachedHRTF
+(
+    void* const hBin,
+    binauraliser_codecState* state,
+    INTERP_MODES mode,
+    float azimuth_deg,
+    float elevation_deg,
+    float_complex h_intrp[HYBRID_BANDS][NUM_EARS]
+)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    binauraliser_hrtfCache* cache;
+    int idx3d, set, way, lru;
+
+    /* Cached HRTFs are no longer valid if the HRTFs/tables or the interpolation mode have changed */
+    cache = pData->hrtfCache;
+    if(cache->stateID!=state->id || cache->mode!=mode){
+        for(set=0; set<HRTF_CACHE_NUM_SETS; set++)
+            for(way=0; way<HRTF_CACHE_NUM_WAYS; way++)
+                cache->tableIdx[set][way] = -1;
+        cache->stateID = state->id;
+        cache->mode = mode;
+    }
+
+    /* find closest pre-computed VBAP direction, and look it up in the cache */
+    idx3d = binauraliser_getVBAPtableIndex(state, azimuth_deg, elevation_deg);
+    set = idx3d & (HRTF_CACHE_NUM_SETS-1);
+    cache->counter++;
+    lru = 0;
+    for(way=0; way<HRTF_CACHE_NUM_WAYS; way++){
+        if(cache->tableIdx[set][way]==idx3d)
+            break;
+        /* Empty entries are used first; otherwise the oldest (the age is unaffected by the counter wrapping around) */
+        if(cache->tableIdx[set][lru]!=-1 && (cache->tableIdx[set][way]==-1 ||
+           cache->counter-cache->lastUsed[set][way] > cache->counter-cache->lastUsed[set][lru]))
+            lru = way;
+    }
+
+    /* If not already cached, interpolate the HRTFs in place of the least-recently-used entry */
+    if(way==HRTF_CACHE_NUM_WAYS){
+        way = lru;
+        binauraliser_interpHRTFs_tableIndex(hBin, state, mode, idx3d, cache->hrtfs[set][way]);
+        cache->tableIdx[set][way] = idx3d;
+    }
+    cache->lastUsed[set][way] = cache->counter;
+    memcpy(h_intrp, cache->hrtfs[set][way], HYBRID_BANDS*NUM_EARS*sizeof(float_complex));
+}
+
+void binauraliser_initHRTFsAndGainTables
+(
+    void* const hBin,
+    binauraliser_codecState* state
+)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
     int i, new_len;
@@ -130,6 +334,8 @@ void binauraliser_initHRTFsAndGainTables(void* const hBin)
 #ifdef SAF_ENABLE_SOFA_READER_MODULE
     SAF_SOFA_ERROR_CODES error;
     saf_sofa_container sofa;
+    saf_fileCache_key cacheKey;
+    char* cachePath;
 #endif
     
     strcpy(pData->progressBarText,"Loading HRIRs");
@@ -137,6 +343,15 @@ void binauraliser_initHRTFsAndGainTables(void* const hBin)
     
     /* load sofa file or load default hrir data */
 #ifdef SAF_ENABLE_SOFA_READER_MODULE
+    /* The HRTFs and tables may have already been computed for this sofa file (with the same settings) */
+    cachePath = NULL;
+    if(!pData->useDefaultHRIRsFLAG && pData->sofa_filepath!=NULL && pData->hrtfCacheDirectory!=NULL){
+        cachePath = saf_fileCache_createFilePath(pData->hrtfCacheDirectory, pData->sofa_filepath, "binauraliser", pData->fs, HOP_SIZE, pData->enableHRIRsDiffuseEQ, &cacheKey);
+        if(cachePath!=NULL && binauraliser_loadHRTFsFromCache(hBin, state, cachePath, &cacheKey)){
+            free(cachePath);
+            return;
+        }
+    }
     if(!pData->useDefaultHRIRsFLAG && pData->sofa_filepath!=NULL){
         /* Load SOFA file */
         error = saf_sofa_open(&sofa, pData->sofa_filepath);
@@ -181,8 +396,8 @@ void binauraliser_initHRTFsAndGainTables(void* const hBin)
     /* estimate the ITDs for each HRIR */
     strcpy(pData->progressBarText,"Estimating ITDs");
     pData->progressBar0_1 = 0.4f;
-    pData->itds_s = realloc1d(pData->itds_s, pData->N_hrir_dirs*sizeof(float));
-    estimateITDs(pData->hrirs, pData->N_hrir_dirs, pData->hrir_loaded_len, pData->hrir_loaded_fs, pData->itds_s);
+    state->itds_s = realloc1d(state->itds_s, pData->N_hrir_dirs*sizeof(float));
+    estimateITDs(pData->hrirs, pData->N_hrir_dirs, pData->hrir_loaded_len, pData->hrir_loaded_fs, state->itds_s);
 
     /* Resample the HRIRs if needed */
     if(pData->hrir_loaded_fs!=pData->fs){
@@ -205,25 +420,29 @@ void binauraliser_initHRTFsAndGainTables(void* const hBin)
     strcpy(pData->progressBarText,"Generating interpolation table");
     pData->progressBar0_1 = 0.6f;
     hrtf_vbap_gtable = NULL;
-    pData->hrtf_vbapTableRes[0] = 2;
-    pData->hrtf_vbapTableRes[1] = 5;
-    generateVBAPgainTable3D(pData->hrir_dirs_deg, pData->N_hrir_dirs, pData->hrtf_vbapTableRes[0], pData->hrtf_vbapTableRes[1], 1, 0, 0.0f,
-                            &hrtf_vbap_gtable, &(pData->N_hrtf_vbap_gtable), &(pData->nTriangles));
+    state->hrtf_vbapTableRes[0] = 2;
+    state->hrtf_vbapTableRes[1] = 5;
+    generateVBAPgainTable3D(pData->hrir_dirs_deg, pData->N_hrir_dirs, state->hrtf_vbapTableRes[0], state->hrtf_vbapTableRes[1], 1, 0, 0.0f,
+                            &hrtf_vbap_gtable, &(state->N_hrtf_vbap_gtable), &(pData->nTriangles));
     if(hrtf_vbap_gtable==NULL){
         /* if generating vbap gain tabled failed, re-calculate with default HRIR set */
         pData->useDefaultHRIRsFLAG = 1;
-        binauraliser_initHRTFsAndGainTables(hBin);
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+        free(cachePath);
+#endif
+        binauraliser_initHRTFsAndGainTables(hBin, state);
+        return;
     }
     
     /* compress VBAP table (i.e. remove the zero elements) */
-    pData->hrtf_vbap_gtableComp = realloc1d(pData->hrtf_vbap_gtableComp, pData->N_hrtf_vbap_gtable * 3 * sizeof(float));
-    pData->hrtf_vbap_gtableIdx  = realloc1d(pData->hrtf_vbap_gtableIdx,  pData->N_hrtf_vbap_gtable * 3 * sizeof(int));
-    compressVBAPgainTable3D(hrtf_vbap_gtable, pData->N_hrtf_vbap_gtable, pData->N_hrir_dirs, pData->hrtf_vbap_gtableComp, pData->hrtf_vbap_gtableIdx);
+    state->hrtf_vbap_gtableComp = realloc1d(state->hrtf_vbap_gtableComp, state->N_hrtf_vbap_gtable * 3 * sizeof(float));
+    state->hrtf_vbap_gtableIdx  = realloc1d(state->hrtf_vbap_gtableIdx,  state->N_hrtf_vbap_gtable * 3 * sizeof(int));
+    compressVBAPgainTable3D(hrtf_vbap_gtable, state->N_hrtf_vbap_gtable, pData->N_hrir_dirs, state->hrtf_vbap_gtableComp, state->hrtf_vbap_gtableIdx);
     
     /* convert hrirs to filterbank coefficients */
     pData->progressBar0_1 = 0.6f;
-    pData->hrtf_fb = realloc1d(pData->hrtf_fb, HYBRID_BANDS * NUM_EARS * (pData->N_hrir_dirs)*sizeof(float_complex));
-    HRIRs2HRTFs_afSTFT(pData->hrirs, pData->N_hrir_dirs, pData->hrir_runtime_len, HOP_SIZE, 0, 1, pData->hrtf_fb);
+    state->hrtf_fb = realloc1d(state->hrtf_fb, HYBRID_BANDS * NUM_EARS * (pData->N_hrir_dirs)*sizeof(float_complex));
+    HRIRs2HRTFs_afSTFT(pData->hrirs, pData->N_hrir_dirs, pData->hrir_runtime_len, HOP_SIZE, 0, 1, state->hrtf_fb);
     /* HRIR pre-processing */
     if(pData->enableHRIRsDiffuseEQ){
         /* get integration weights */
@@ -238,17 +457,22 @@ void binauraliser_initHRTFsAndGainTables(void* const hBin)
             for(int idx=0; idx < pData->N_hrir_dirs; idx++)
                 pData->weights[idx] = 4.f*SAF_PI / (float)pData->N_hrir_dirs;
         }
-        diffuseFieldEqualiseHRTFs(pData->N_hrir_dirs, pData->itds_s, pData->freqVector, HYBRID_BANDS, pData->weights, 1, 0, pData->hrtf_fb);
+        diffuseFieldEqualiseHRTFs(pData->N_hrir_dirs, state->itds_s, pData->freqVector, HYBRID_BANDS, pData->weights, 1, 0, state->hrtf_fb);
     }
 
     /* calculate magnitude responses */
-    pData->hrtf_fb_mag = realloc1d(pData->hrtf_fb_mag, HYBRID_BANDS*NUM_EARS*(pData->N_hrir_dirs)*sizeof(float)); 
+    state->hrtf_fb_mag = realloc1d(state->hrtf_fb_mag, HYBRID_BANDS*NUM_EARS*(pData->N_hrir_dirs)*sizeof(float)); 
     for(i=0; i<HYBRID_BANDS*NUM_EARS* (pData->N_hrir_dirs); i++)
-        pData->hrtf_fb_mag[i] = cabsf(pData->hrtf_fb[i]);
+        state->hrtf_fb_mag[i] = cabsf(state->hrtf_fb[i]);
+
+    state->N_hrir_dirs = pData->N_hrir_dirs;
 
-    /* The HRTFs should be re-interpolated */
-    for(i=0; i<MAX_NUM_INPUTS; i++)
-        pData->recalc_hrtf_interpFLAG[i] = 1;
+#ifdef SAF_ENABLE_SOFA_READER_MODULE
+    /* Cache the HRTFs and tables computed for this sofa file */
+    if(cachePath!=NULL && !pData->useDefaultHRIRsFLAG)
+        binauraliser_saveHRTFsToCache(hBin, state, cachePath, &cacheKey);
+    free(cachePath);
+#endif
     
     /* clean-up */
     free(hrtf_vbap_gtable);
@@ -261,13 +485,12 @@ void binauraliser_initTFT
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
  
+    /* (the afSTFT is created for the maximum number of sources, and only the
+     * active sources are then transformed by binauraliser_process(); therefore,
+     * changing the number of sources does not require any re-allocation) */
     if(pData->hSTFT==NULL)
-        afSTFT_create(&(pData->hSTFT), pData->new_nSources, NUM_EARS, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
-    else if(pData->new_nSources!=pData->nSources){
-        afSTFT_channelChange(pData->hSTFT, pData->new_nSources, NUM_EARS);
-        afSTFT_clearBuffers(pData->hSTFT);
-    }
-    pData->nSources = pData->new_nSources;
+        afSTFT_create(&(pData->hSTFT), MAX_NUM_INPUTS, NUM_EARS, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
+    saf_atomic_store(&(pData->nSources), pData->new_nSources);
 }
 
 void binauraliser_loadPreset
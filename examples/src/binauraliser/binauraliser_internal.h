@@ -55,16 +55,73 @@ extern "C" {
 #define HOP_SIZE ( 128 )                                  /**< STFT hop size */
 #define HYBRID_BANDS ( HOP_SIZE + 5 )                     /**< Number of frequency bands */
 #define TIME_SLOTS ( BINAURALISER_FRAME_SIZE / HOP_SIZE ) /**< Number of STFT timeslots */
+#if !defined(HRTF_FADE_NUM_HOPS)
+# define HRTF_FADE_NUM_HOPS ( 4 )                         /**< Number of hops (time slots) over which to fade from the previous HRTF of a source to the new one */
+#endif
+#if !defined(HRTF_CACHE_NUM_SETS)
+# define HRTF_CACHE_NUM_SETS ( 64 )                       /**< Number of sets in the interpolated HRTF cache (must be a power of 2) */
+#endif
+#if !defined(HRTF_CACHE_NUM_WAYS)
+# define HRTF_CACHE_NUM_WAYS ( 4 )                        /**< Number of interpolated HRTFs per set, in the interpolated HRTF cache */
+#endif
 
 /* Checks: */
 #if (BINAURALISER_FRAME_SIZE % HOP_SIZE != 0)
 # error "BINAURALISER_FRAME_SIZE must be an integer multiple of HOP_SIZE"
 #endif
+#if (HRTF_CACHE_NUM_SETS & (HRTF_CACHE_NUM_SETS-1)) != 0
+# error "HRTF_CACHE_NUM_SETS must be a power of 2"
+#endif
 
 /* ========================================================================== */
 /*                                 Structures                                 */
 /* ========================================================================== */
 
+/**
+ * The HRTFs and interpolation tables, as used by binauraliser_process(). These
+ * are computed by binauraliser_initCodec() and then handed over to the
+ * processing thread (see saf_utility_rcu.h); so processing carries on with the
+ * previous tables while new ones are being computed.
+ */
+typedef struct _binauraliser_codecState
+{
+    int id;                          /**< Unique ID of this state (incremented upon each (re)initialisation) */
+    int N_hrir_dirs;                 /**< number of HRIR directions */
+
+    /* vbap gain table */
+    int hrtf_vbapTableRes[2];        /**< [0] azimuth, and [1] elevation grid resolution, in degrees */
+    int N_hrtf_vbap_gtable;          /**< Number of interpolation weights/directions */
+    int* hrtf_vbap_gtableIdx;        /**< N_hrtf_vbap_gtable x 3 */
+    float* hrtf_vbap_gtableComp;     /**< N_hrtf_vbap_gtable x 3 */
+
+    /* hrir filterbank coefficients */
+    float* itds_s;                   /**< interaural-time differences for each HRIR (in seconds); nBands x 1 */
+    float_complex* hrtf_fb;          /**< hrtf filterbank coefficients; nBands x nCH x N_hrirs */
+    float* hrtf_fb_mag;              /**< magnitudes of the hrtf filterbank coefficients; nBands x nCH x N_hrirs */
+
+} binauraliser_codecState;
+
+/**
+ * Cache of interpolated HRTFs, for the (quantised) directions of the VBAP gain
+ * table; set-associative, with least-recently-used replacement.
+ *
+ * Sources which move (or are rotated with the listener's head) to a direction
+ * that was visited recently, therefore, do not require their HRTFs to be
+ * interpolated again. The cache is only accessed by the processing thread, and
+ * it is emptied whenever the #binauraliser_codecState or the interpolation
+ * mode changes.
+ */
+typedef struct _binauraliser_hrtfCache
+{
+    int stateID;                     /**< ID of the #binauraliser_codecState used to compute the cached HRTFs */
+    INTERP_MODES mode;               /**< Interpolation mode used to compute the cached HRTFs */
+    unsigned int counter;            /**< Incremented upon each look-up (used for the least-recently-used replacement) */
+    int tableIdx[HRTF_CACHE_NUM_SETS][HRTF_CACHE_NUM_WAYS];          /**< VBAP gain table index of each entry; -1: empty */
+    unsigned int lastUsed[HRTF_CACHE_NUM_SETS][HRTF_CACHE_NUM_WAYS]; /**< Value of 'counter' when each entry was last used */
+    float_complex hrtfs[HRTF_CACHE_NUM_SETS][HRTF_CACHE_NUM_WAYS][HYBRID_BANDS][NUM_EARS]; /**< Interpolated HRTFs */
+
+} binauraliser_hrtfCache;
+
 /**
  * Main structure for binauraliser. Contains variables for audio buffers,
  * afSTFT, HRTFs, internal variables, flags, user parameters
@@ -82,6 +139,7 @@ typedef struct _binauraliser
     
     /* sofa file info */
     char* sofa_filepath;             /**< absolute/relevative file path for a sofa file */
+    char* hrtfCacheDirectory;        /**< directory in which the HRTFs and tables computed for a sofa file are cached; NULL: no caching */
     float* hrirs;                    /**< time domain HRIRs; FLAT: N_hrir_dirs x #NUM_EARS x hrir_len */
     float* hrir_dirs_deg;            /**< directions of the HRIRs in degrees [azi elev]; FLAT: N_hrir_dirs x 2 */
     int N_hrir_dirs;                 /**< number of HRIR directions in the current sofa file */
@@ -91,23 +149,21 @@ typedef struct _binauraliser
     int hrir_runtime_fs;             /**< sampling rate of the HRIRs being used for processing (after any resampling) */
     float* weights;                  /**< Integration weights for the HRIR measurement grid */
     
-    /* vbap gain table */
-    int hrtf_vbapTableRes[2];        /**< [0] azimuth, and [1] elevation grid resolution, in degrees */
-    int N_hrtf_vbap_gtable;          /**< Number of interpolation weights/directions */
-    int* hrtf_vbap_gtableIdx;        /**< N_hrtf_vbap_gtable x 3 */
-    float* hrtf_vbap_gtableComp;     /**< N_hrtf_vbap_gtable x 3 */
-    
-    /* hrir filterbank coefficients */
-    float* itds_s;                   /**< interaural-time differences for each HRIR (in seconds); nBands x 1 */
-    float_complex* hrtf_fb;          /**< hrtf filterbank coefficients; nBands x nCH x N_hrirs */
-    float* hrtf_fb_mag;              /**< magnitudes of the hrtf filterbank coefficients; nBands x nCH x N_hrirs */
+    /* HRTFs and interpolation tables */
+    void* hCodecState;               /**< Hand-off of the current #binauraliser_codecState to the processing thread (saf_rcu handle) */
+    int codecStateID;                /**< ID of the last #binauraliser_codecState to be computed */
+    int hrtf_interpStateID;          /**< ID of the #binauraliser_codecState used to compute hrtf_interp */
     float_complex hrtf_interp[MAX_NUM_INPUTS][HYBRID_BANDS][NUM_EARS]; /**< Interpolated HRTFs */
+    float_complex hrtf_interp_prev[MAX_NUM_INPUTS][HYBRID_BANDS][NUM_EARS]; /**< HRTFs at the start of the current fade (faded out over #HRTF_FADE_NUM_HOPS hops) */
+    int hrtf_fadePos[MAX_NUM_INPUTS]; /**< Number of hops of the current fade that have been processed; #HRTF_FADE_NUM_HOPS: not fading */
+    float_complex hrtf_hop[HYBRID_BANDS][NUM_EARS][MAX_NUM_INPUTS]; /**< HRTFs applied on the current hop (i.e. part-way through any fades); one #NUM_EARS x #MAX_NUM_INPUTS mixing matrix per band */
+    binauraliser_hrtfCache* hrtfCache; /**< Cache of interpolated HRTFs */
     
     /* flags/status */
-    CODEC_STATUS codecStatus;        /**< see #CODEC_STATUS */
+    volatile int codecStatus;        /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;   /**< 1: binauraliser_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;            /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;           /**< Current (re)initialisation step, string */
-    PROC_STATUS procStatus;          /**< see #PROC_STATUS */
     int recalc_hrtf_interpFLAG[MAX_NUM_INPUTS]; /**< 1: re-calculate/interpolate the HRTF, 0: do not */
     int reInitHRTFsAndGainTables;    /**< 1: reinitialise the HRTFs and interpolation tables, 0: do not */
     int recalc_M_rotFLAG;            /**< 1: re-calculate the rotation matrix, 0: do not */
@@ -120,7 +176,7 @@ typedef struct _binauraliser
     int new_nSources;                          /**< New number of input/source signals (current value will be replaced by this after next re-init) */
 
     /* user parameters */
-    int nSources;                            /**< Current number of input/source signals */
+    volatile int nSources;                   /**< Current number of input/source signals */
     float src_dirs_deg[MAX_NUM_INPUTS][2];   /**< Current source/panning directions, in degrees */
     INTERP_MODES interpMode;                 /**< see #INTERP_MODES */
     int useDefaultHRIRsFLAG;                 /**< 1: use default HRIRs in database, 0: use those from SOFA file */
@@ -146,6 +202,9 @@ typedef struct _binauraliser
 void binauraliser_setCodecStatus(void* const hBin,
                                  CODEC_STATUS newStatus);
 
+/** Destroys a #binauraliser_codecState (once retired by the saf_rcu handle) */
+void binauraliser_destroyCodecState(void** const phState);
+
 /**
  * Interpolates between (up to) 3 HRTFs via amplitude-normalised VBAP gains.
  *
@@ -153,29 +212,57 @@ void binauraliser_setCodecStatus(void* const hBin,
  * re-introducing the phase.
  *
  * @param[in]  hBin          binauraliser handle
+ * @param[in]  state         HRTFs and interpolation tables to use
  * @param[in]  mode          see #INTERP_MODES 
  * @param[in]  azimuth_deg   Source azimuth in DEGREES
  * @param[in]  elevation_deg Source elevation in DEGREES
  * @param[out] h_intrp       Interpolated HRTF
  */
 void binauraliser_interpHRTFs(void* const hBin,
+                              binauraliser_codecState* state,
                               INTERP_MODES mode,
                               float azimuth_deg,
                               float elevation_deg,
                               float_complex h_intrp[HYBRID_BANDS][NUM_EARS]);
 
+/**
+ * Returns the interpolated HRTF for a given direction from the HRTF cache (see
+ * #binauraliser_hrtfCache); interpolating it with binauraliser_interpHRTFs()
+ * first, if it is not already cached.
+ *
+ * @param[in]  hBin          binauraliser handle
+ * @param[in]  state         HRTFs and interpolation tables to use
+ * @param[in]  mode          see #INTERP_MODES
+ * @param[in]  azimuth_deg   Source azimuth in DEGREES
+ * @param[in]  elevation_deg Source elevation in DEGREES
+ * @param[out] h_intrp       Interpolated HRTF
+ */
+void binauraliser_getCachedHRTF(void* const hBin,
+                                binauraliser_codecState* state,
+                                INTERP_MODES mode,
+                                float azimuth_deg,
+                                float elevation_deg,
+                                float_complex h_intrp[HYBRID_BANDS][NUM_EARS]);
+
 /**
  * Initialise the HRTFs: either loading the default set or loading from a SOFA
  * file; and then generate a VBAP gain table for interpolation.
  *
  * @note Call binauraliser_initTFT() (if needed) before calling this function
+ *
+ * @param[in]  hBin  binauraliser handle
+ * @param[out] state HRTFs and interpolation tables (not yet visible to the
+ *                   processing thread)
  */
-void binauraliser_initHRTFsAndGainTables(void* const hBin);
+void binauraliser_initHRTFsAndGainTables(void* const hBin,
+                                         binauraliser_codecState* state);
 
 /**
  * Initialise the filterbank used by binauraliser.
  *
- * @note Call this function before binauraliser_initHRTFsAndGainTables()
+ * @note Call this function before binauraliser_initHRTFsAndGainTables(). Any
+ *       subsequent change in the number of channels is applied by
+ *       binauraliser_process() itself.
  */
 void binauraliser_initTFT(void* const hBin);
 
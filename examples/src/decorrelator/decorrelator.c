@@ -48,15 +48,14 @@ void decorrelator_create
     pData->transientFrameTF = (float_complex***)malloc3d(HYBRID_BANDS, MAX_NUM_CHANNELS, TIME_SLOTS, sizeof(float_complex));
 
     /* codec data */
-    pData->hDecor = NULL;
-    pData->hDucker = NULL;
+    saf_rcu_create(&(pData->hCodecState), decorrelator_destroyCodecState);
     pData->new_nChannels = pData->nChannels;
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     
     /* flags */
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    pData->initialisingFLAG = 0;
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
 }
 
@@ -68,11 +67,10 @@ void decorrelator_destroy
     decorrelator_data *pData = (decorrelator_data*)(*phDecor);
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
         
         /* free afSTFT and buffers */ 
         if(pData->hSTFT!=NULL)
@@ -84,8 +82,7 @@ void decorrelator_destroy
         free(pData->transientFrameTF);
         free(pData->progressBarText);
 
-        transientDucker_destroy(&(pData->hDucker));
-        latticeDecorrelator_destroy(&(pData->hDecor));
+        saf_rcu_destroy(&(pData->hCodecState));
 
         free(pData);
         pData = NULL;
@@ -104,8 +101,10 @@ void decorrelator_init
     /* define frequency vector */
     pData->fs = sampleRate;
     afSTFT_getCentreFreqs(pData->hSTFT, (float)sampleRate, HYBRID_BANDS, pData->freqVector);
-    if(pData->hDecor!=NULL)
-        latticeDecorrelator_reset(pData->hDecor);
+
+    /* the decorrelators are designed for the host sampling rate (and start
+     * with cleared buffers once re-created) */
+    decorrelator_setCodecStatus(hDecor, CODEC_STATUS_NOT_INITIALISED);
 }
 
 void decorrelator_initCodec
@@ -114,47 +113,52 @@ void decorrelator_initCodec
 )
 {
     decorrelator_data *pData = (decorrelator_data*)(hDecor);
+    decorrelator_codecState* state;
     int nChannels;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the processing loop is not paused; it carries on with the
+     * previous decorrelators until the new ones are ready */
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Preparing Decorrelators");
     pData->progressBar0_1 = 0.0f;
     
-    /* (Re)Initialise afSTFT */
+    /* Initialise afSTFT (for the maximum number of channels, and only the
+     * current channels are then transformed by decorrelator_process(); therefore,
+     * changing the number of channels does not require any re-allocation) */
     nChannels = pData->new_nChannels; 
     if(pData->hSTFT==NULL)
-        afSTFT_create(&(pData->hSTFT), nChannels, nChannels, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
-    else if(pData->nChannels != nChannels) {/* Or change the number of channels */
-        afSTFT_channelChange(pData->hSTFT, nChannels, nChannels);
-        afSTFT_clearBuffers(pData->hSTFT);
-    }
+        afSTFT_create(&(pData->hSTFT), MAX_NUM_CHANNELS, MAX_NUM_CHANNELS, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
     pData->nChannels = nChannels;
+    state = (decorrelator_codecState*)malloc1d(sizeof(decorrelator_codecState));
+    state->nChannels = nChannels;
 
     /* Init transient ducker */
-    transientDucker_destroy(&(pData->hDucker));
-    transientDucker_create(&(pData->hDucker), nChannels, HYBRID_BANDS);
+    transientDucker_create(&(state->hDucker), nChannels, HYBRID_BANDS);
 
     /* Init decorrelator  */
     const int orders[4] = {20, 15, 6, 3}; /* 20th order up to 700Hz, 15th->2.4kHz, 6th->4kHz, 3rd->12kHz, NONE(only delays)->Nyquist */
     const float freqCutoffs[4] = {600.0f, 2.4e3f, 4.0e3f, 12e3f};
     //const float freqCutoffs[4] = {900.0f, 6.8e3f, 12e3f, 16e3f};
     const int maxDelay = 8;
-    latticeDecorrelator_destroy(&(pData->hDecor));
-    latticeDecorrelator_create(&(pData->hDecor), pData->fs, HOP_SIZE, pData->freqVector, HYBRID_BANDS, pData->nChannels, (int*)orders, (float*)freqCutoffs, 4, maxDelay, 0, 0.75f);
+    latticeDecorrelator_create(&(state->hDecor), pData->fs, HOP_SIZE, pData->freqVector, HYBRID_BANDS, nChannels, (int*)orders, (float*)freqCutoffs, 4, maxDelay, 0, 0.75f);
+
+    /* hand them over to the processing thread */
+    saf_rcu_publish(pData->hCodecState, (void*)state);
 
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
 }
 
 void decorrelator_process
@@ -168,19 +172,22 @@ void decorrelator_process
 )
 {
     decorrelator_data *pData = (decorrelator_data*)(hDecor);
-    int ch, i, band, enableTransientDucker, compensateLevel;
+    decorrelator_codecState* state;
+    int ch, i, band, enableTransientDucker, compensateLevel, ticket;
     float decorAmount;
     
     /* local copies of user parameters */
     int nCH;
-    nCH = pData->nChannels;
     decorAmount = pData->decorAmount;
     enableTransientDucker = pData->enableTransientDucker;
     compensateLevel = pData->compensateLevel;
 
+    /* Current decorrelators (NULL until the first initialisation is complete) */
+    state = (decorrelator_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+
     /* Process frame */
-    if (nSamples == DECORRELATOR_FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
+    if (nSamples == DECORRELATOR_FRAME_SIZE && (state!=NULL)) {
+        nCH = state->nChannels;
 
         /* Load time-domain data */
         for(i=0; i < SAF_MIN(nCH, nInputs); i++)
@@ -189,17 +196,17 @@ void decorrelator_process
             memset(pData->InputFrameTD[i], 0, DECORRELATOR_FRAME_SIZE * sizeof(float)); /* fill remaining channels with zeros */
 
         /* Apply time-frequency transform (TFT) */
-        afSTFT_forward_knownDimensions(pData->hSTFT, pData->InputFrameTD, DECORRELATOR_FRAME_SIZE, MAX_NUM_CHANNELS, TIME_SLOTS, pData->InputFrameTF);
+        afSTFT_forward_knownDimensions_nCH(pData->hSTFT, pData->InputFrameTD, DECORRELATOR_FRAME_SIZE, MAX_NUM_CHANNELS, TIME_SLOTS, nCH, pData->InputFrameTF);
 
         /* Apply decorrelation */
         if(enableTransientDucker){
             /* remove transients */
-            transientDucker_apply(pData->hDucker, pData->InputFrameTF, TIME_SLOTS, 0.95f, 0.995f, pData->OutputFrameTF, pData->transientFrameTF);
+            transientDucker_apply(state->hDucker, pData->InputFrameTF, TIME_SLOTS, 0.95f, 0.995f, pData->OutputFrameTF, pData->transientFrameTF);
             /* decorrelate only the residual */
-            latticeDecorrelator_apply(pData->hDecor,  pData->OutputFrameTF, TIME_SLOTS, pData->OutputFrameTF);
+            latticeDecorrelator_apply(state->hDecor,  pData->OutputFrameTF, TIME_SLOTS, pData->OutputFrameTF);
         }
         else
-            latticeDecorrelator_apply(pData->hDecor,  pData->InputFrameTF, TIME_SLOTS, pData->OutputFrameTF);
+            latticeDecorrelator_apply(state->hDecor,  pData->InputFrameTF, TIME_SLOTS, pData->OutputFrameTF);
 
         /* Optionally compensate for the level (as they channels wll no longer sum coherently) */
         if(compensateLevel){
@@ -221,7 +228,7 @@ void decorrelator_process
         }
 
         /* inverse-TFT */
-        afSTFT_backward_knownDimensions(pData->hSTFT, pData->OutputFrameTF, DECORRELATOR_FRAME_SIZE, MAX_NUM_CHANNELS, TIME_SLOTS, pData->OutputFrameTD);
+        afSTFT_backward_knownDimensions_nCH(pData->hSTFT, pData->OutputFrameTF, DECORRELATOR_FRAME_SIZE, MAX_NUM_CHANNELS, TIME_SLOTS, nCH, pData->OutputFrameTD);
 
         /* Copy to output buffer */
         for (ch = 0; ch < SAF_MIN(nCH, nOutputs); ch++)
@@ -233,7 +240,7 @@ void decorrelator_process
         for (ch=0; ch < nOutputs; ch++)
             memset(outputs[ch],0, DECORRELATOR_FRAME_SIZE*sizeof(float));
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 
@@ -284,7 +291,7 @@ int decorrelator_getFrameSize(void)
 CODEC_STATUS decorrelator_getCodecStatus(void* const hDecor)
 {
     decorrelator_data *pData = (decorrelator_data*)(hDecor);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float decorrelator_getProgressBar0_1(void* const hDecor)
@@ -29,10 +29,21 @@
 void decorrelator_setCodecStatus(void* const hDecor, CODEC_STATUS newStatus)
 {
     decorrelator_data *pData = (decorrelator_data*)(hDecor);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * decorrelator_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void decorrelator_destroyCodecState(void** const phState)
+{
+    decorrelator_codecState *state = (decorrelator_codecState*)(*phState);
+
+    if(state!=NULL){
+        transientDucker_destroy(&(state->hDucker));
+        latticeDecorrelator_destroy(&(state->hDecor));
+        free(state);
+        state = NULL;
+        *phState = NULL;
     }
-    pData->codecStatus = newStatus;
 }
@@ -59,6 +59,20 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
 
+/**
+ * The decorrelators and transient extractor, as used by decorrelator_process().
+ * These are created by decorrelator_initCodec() and then handed over to the
+ * processing thread (see saf_utility_rcu.h); so processing carries on with the
+ * previous ones while new ones are being created.
+ */
+typedef struct _decorrelator_codecState
+{
+    int nChannels;                    /**< Number of input/output channels */
+    void* hDecor;                     /**< Decorrelator handle */
+    void* hDucker;                    /**< Transient extractor/Ducker handle */
+
+} decorrelator_codecState;
+
 /**
  * Main structure for decorrelator. Contains variables for audio buffers, afSTFT,
  * rotation matrices, internal variables, flags, user parameters
@@ -77,14 +91,13 @@ typedef struct _decorrelator
     float freqVector[HYBRID_BANDS];   /**< frequency vector for time-frequency transform, in Hz */
      
     /* our codec configuration */
-    void* hDecor;                     /**< Decorrelator handle */
-    void* hDucker;                    /**< Transient extractor/Ducker handle */
-    CODEC_STATUS codecStatus;         /**< see #CODEC_STATUS */
+    void* hCodecState;                /**< Hand-off of the current #decorrelator_codecState to the processing thread (saf_rcu handle) */
+    volatile int codecStatus;         /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;    /**< 1: decorrelator_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;             /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;            /**< Current (re)initialisation step, string */
     
     /* internal variables */
-    PROC_STATUS procStatus;           /**< see #PROC_STATUS */
     int new_nChannels;                /**< New number of input/output channels (current value will be replaced by this after next re-init) */
 
     /* user parameters */
@@ -106,6 +119,9 @@ typedef struct _decorrelator
 void decorrelator_setCodecStatus(void* const hDecor,
                                  CODEC_STATUS newStatus);
 
+/** Destroys a #decorrelator_codecState (once retired by the saf_rcu handle) */
+void decorrelator_destroyCodecState(void** const phState);
+
 
 #ifdef __cplusplus
 } /* extern "C" { */
@@ -44,7 +44,6 @@ void dirass_create
 {
     dirass_data* pData = (dirass_data*)malloc1d(sizeof(dirass_data));
     *phDir = (void*)pData;
-    int i;
 
     /* Default user parameters */
     pData->inputOrder = pData->new_inputOrder = SH_ORDER_FIRST;
@@ -62,35 +61,16 @@ void dirass_create
     pData->aspectRatioOption = ASPECT_RATIO_2_1;
 
     /* codec data */
-    pData->pars = (dirass_codecPars*)malloc1d(sizeof(dirass_codecPars));
-    dirass_codecPars* pars = pData->pars;
-    pars->interp_dirs_deg = NULL;
-    pars->interp_dirs_rad = NULL;
-    pars->Y_up = NULL;
-    pars->interp_table = NULL;
-    pars->w = NULL;
-    pars->Cw = NULL;
-    pars->Uw = NULL;
-    pars->Cxyz = NULL;
-    pars->ss = NULL;
-    pars->ssxyz = NULL;
-    pars->est_dirs = NULL;
-    pars->est_dirs_idx = NULL;
-    pars->prev_intensity = NULL;
-    pars->prev_energy = NULL;
+    saf_rcu_create(&(pData->hCodecState), dirass_destroyCodecState);
     
     /* internal */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    pData->initialisingFLAG = 0;
 
     /* display */
-    pData->pmap = NULL;
-    for(i=0; i<NUM_DISP_SLOTS; i++)
-        pData->pmap_grid[i] = NULL;
-    pData->pmapReady = 0;
     pData->recalcPmap = 1;
 
     /* set FIFO buffers */
@@ -104,38 +84,14 @@ void dirass_destroy
 )
 {
     dirass_data *pData = (dirass_data*)(*phDir);
-    dirass_codecPars* pars;
-    int i;
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
-        
-        if(pData->pmap!=NULL)
-            free(pData->pmap);
-        for(i=0; i<NUM_DISP_SLOTS; i++)
-            free(pData->pmap_grid[i]);
-
-        pars = pData->pars;
-        free(pars->interp_dirs_deg);
-        free(pars->interp_dirs_rad);
-        free(pars->Y_up);
-        free(pars->interp_table);
-        free(pars->ss);
-        free(pars->ssxyz);
-        free(pars->Cxyz);
-        free(pars->w);
-        free(pars->Cw);
-        free(pars->Uw);
-        free(pars->est_dirs);
-        free(pars->est_dirs_idx);
-        free(pars->prev_intensity);
-        free(pars->prev_energy);
         
-        free(pData->pars);
+        saf_rcu_destroy(&(pData->hCodecState));
         free(pData->progressBarText);
         free(pData);
         pData = NULL;
@@ -149,19 +105,22 @@ void dirass_init
 )
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
+    dirass_codecState* state;
+    int ticket;
 
     pData->fs = sampleRate;
     
-    /* intialise parameters */
-    if(pars->prev_intensity!=NULL)
-        memset(pars->prev_intensity, 0, pars->grid_nDirs*3*sizeof(float));
-    if(pars->prev_energy!=NULL)
-        memset(pars->prev_energy, 0, pars->grid_nDirs*sizeof(float));
+    /* intialise parameters (of the current configuration, if there is one) */
+    state = (dirass_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    if(state!=NULL){
+        memset(state->prev_intensity, 0, state->grid_nDirs*3*sizeof(float));
+        memset(state->prev_energy, 0, state->grid_nDirs*sizeof(float));
+        state->pmapReady = 0;
+        state->dispSlotIdx = 0;
+    }
+    saf_rcu_release(pData->hCodecState, ticket);
     memset(pData->Wz12_hpf, 0, MAX_NUM_INPUT_SH_SIGNALS*2*sizeof(float));
     memset(pData->Wz12_lpf, 0, MAX_NUM_INPUT_SH_SIGNALS*2*sizeof(float));
-    pData->pmapReady = 0;
-    pData->dispSlotIdx = 0;
 }
 
 void dirass_initCodec
@@ -170,26 +129,33 @@ void dirass_initCodec
 )
 {
     dirass_data *pData = (dirass_data*)(hDir);
+    dirass_codecState* state;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the analysis is not paused; it carries on with the previous
+     * configuration until the new one is ready */
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    dirass_initAna(hDir);
+    /* compute the new configuration, and hand it over to the processing thread */
+    state = (dirass_codecState*)calloc1d(1, sizeof(dirass_codecState));
+    dirass_initAna(hDir, state);
+    saf_rcu_publish(pData->hCodecState, (void*)state);
     
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
 }
 
 void dirass_analysis
@@ -202,8 +168,8 @@ void dirass_analysis
 )
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
-    int s, i, j, k, ch, sec_nSH, secOrder, nSH, up_nSH;
+    dirass_codecState* state;
+    int s, i, j, k, ch, sec_nSH, secOrder, nSH, up_nSH, ticket;
     float intensity[3];
     
     /* local copy of user parameters */
@@ -215,10 +181,17 @@ void dirass_analysis
     chOrdering = pData->chOrdering;
     pmapAvgCoeff = pData->pmapAvgCoeff;
     DirAssMode = pData->DirAssMode;
-    upscaleOrder = pData->upscaleOrder;
     minFreq_hz = pData->minFreq_hz;
     maxFreq_hz = pData->maxFreq_hz;
-    inputOrder = pData->inputOrder;
+
+    /* Current configuration (NULL until the first initialisation is complete) */
+    state = (dirass_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    if(state==NULL){
+        saf_rcu_release(pData->hCodecState, ticket);
+        return;
+    }
+    inputOrder = state->inputOrder;
+    upscaleOrder = state->upscaleOrder;
     secOrder = inputOrder-1;
     nSH = (inputOrder+1)*(inputOrder+1);
     sec_nSH = (secOrder+1)*(secOrder+1);
@@ -236,9 +209,8 @@ void dirass_analysis
         pData->FIFO_idx++;
 
         /* Process frame if inFIFO is full and codec is ready for it */
-        if (pData->FIFO_idx >= DIRASS_FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) && isPlaying) {
+        if (pData->FIFO_idx >= DIRASS_FRAME_SIZE && isPlaying) {
             pData->FIFO_idx = 0;
-            pData->procStatus = PROC_STATUS_ONGOING;
 
             /* Load time-domain data */
             for(ch=0; ch<nSH; ch++)
@@ -260,7 +232,7 @@ void dirass_analysis
             /* update the dirass powermap */
             if(pData->recalcPmap==1){
                 pData->recalcPmap = 0;
-                pData->pmapReady = 0;
+                state->pmapReady = 0;
 
                 /* filter input signals */
                 float b[3], a[3];
@@ -274,35 +246,35 @@ void dirass_analysis
                 /* DoA estimation for each spatially-localised sector */
                 if(DirAssMode==REASS_UPSCALE || DirAssMode==REASS_NEAREST){
                     /* Beamform using the sector patterns */
-                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, DIRASS_FRAME_SIZE, sec_nSH, 1.0f,
-                                pars->Cw, sec_nSH,
+                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, state->grid_nDirs, DIRASS_FRAME_SIZE, sec_nSH, 1.0f,
+                                state->Cw, sec_nSH,
                                 (const float*)pData->SHframeTD, DIRASS_FRAME_SIZE, 0.0f,
-                                pars->ss, DIRASS_FRAME_SIZE);
+                                state->ss, DIRASS_FRAME_SIZE);
 
-                    for(i=0; i<pars->grid_nDirs; i++){
+                    for(i=0; i<state->grid_nDirs; i++){
                         /* beamforming to get velocity patterns */
                         cblas_sgemm(CblasRowMajor, CblasTrans, CblasNoTrans, 3, DIRASS_FRAME_SIZE, nSH, 1.0f,
-                                    &(pars->Cxyz[i*nSH*3]), 3,
+                                    &(state->Cxyz[i*nSH*3]), 3,
                                     (const float*)pData->SHframeTD, DIRASS_FRAME_SIZE, 0.0f,
-                                    pars->ssxyz, DIRASS_FRAME_SIZE);
+                                    state->ssxyz, DIRASS_FRAME_SIZE);
 
                         /* take the sum or mean ss.*ssxyz, to get intensity vector */
                         memset(intensity, 0, 3*sizeof(float));
                         for(k=0; k<3; k++){
                             for(j=0; j<DIRASS_FRAME_SIZE; j++)
-                                intensity[k] += pars->ssxyz[k*DIRASS_FRAME_SIZE + j] * pars->ss[i*DIRASS_FRAME_SIZE+j];
+                                intensity[k] += state->ssxyz[k*DIRASS_FRAME_SIZE + j] * state->ss[i*DIRASS_FRAME_SIZE+j];
                             intensity[k] /= (float)DIRASS_FRAME_SIZE;
 
                             /* average over time */
-                            intensity[k] = pmapAvgCoeff * (pars->prev_intensity[i*3+k]) + (1.0f-pmapAvgCoeff) * intensity[k];
-                            pars->prev_intensity[i*3+k] = intensity[k];
+                            intensity[k] = pmapAvgCoeff * (state->prev_intensity[i*3+k]) + (1.0f-pmapAvgCoeff) * intensity[k];
+                            state->prev_intensity[i*3+k] = intensity[k];
                         }
 
                         /* extract DoA [azi elev] convention */
-                        pars->est_dirs[i*2] = atan2f(intensity[1], intensity[0]);
-                        pars->est_dirs[i*2+1] = atan2f(intensity[2], sqrtf(powf(intensity[0], 2.0f) + powf(intensity[1], 2.0f)));
+                        state->est_dirs[i*2] = atan2f(intensity[1], intensity[0]);
+                        state->est_dirs[i*2+1] = atan2f(intensity[2], sqrtf(powf(intensity[0], 2.0f) + powf(intensity[1], 2.0f)));
                         if(DirAssMode==REASS_UPSCALE)
-                            pars->est_dirs[i*2+1] = M_PI/2.0f - pars->est_dirs[i*2+1]; /* convert to inclination */
+                            state->est_dirs[i*2+1] = M_PI/2.0f - state->est_dirs[i*2+1]; /* convert to inclination */
                     }
                 }
 
@@ -312,96 +284,96 @@ void dirass_analysis
                     default:
                     case REASS_MODE_OFF:
                         /* Standard beamformer-based pmap */
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, DIRASS_FRAME_SIZE, nSH, 1.0f,
-                                    pars->w, nSH,
+                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, state->grid_nDirs, DIRASS_FRAME_SIZE, nSH, 1.0f,
+                                    state->w, nSH,
                                     (const float*)pData->SHframeTD, DIRASS_FRAME_SIZE, 0.0f,
-                                    pars->ss, DIRASS_FRAME_SIZE);
+                                    state->ss, DIRASS_FRAME_SIZE);
 
                         /* sum energy over the length of the frame to obtain the pmap */
-                        memset(pData->pmap, 0, pars->grid_nDirs *sizeof(float));
-                        for(i=0; i<pars->grid_nDirs; i++)
+                        memset(state->pmap, 0, state->grid_nDirs *sizeof(float));
+                        for(i=0; i<state->grid_nDirs; i++)
                             for(j=0; j<DIRASS_FRAME_SIZE; j++)
-                                pData->pmap[i] += (pars->ss[i*DIRASS_FRAME_SIZE+j])*(pars->ss[i*DIRASS_FRAME_SIZE+j]);
+                                state->pmap[i] += (state->ss[i*DIRASS_FRAME_SIZE+j])*(state->ss[i*DIRASS_FRAME_SIZE+j]);
 
                         /* average energy over time */
-                        for(i=0; i<pars->grid_nDirs; i++){
-                            pData->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pData->pmap[i]);
-                            pars->prev_energy[i] = pData->pmap[i];
+                        for(i=0; i<state->grid_nDirs; i++){
+                            state->pmap[i] = pmapAvgCoeff * (state->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (state->pmap[i]);
+                            state->prev_energy[i] = state->pmap[i];
                         }
 
                         /* interpolate the pmap */
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
-                                    pars->interp_table, pars->grid_nDirs,
-                                    pData->pmap, 1, 0.0f,
-                                    pData->pmap_grid[pData->dispSlotIdx], 1);
+                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, state->interp_nDirs, 1, state->grid_nDirs, 1.0f,
+                                    state->interp_table, state->grid_nDirs,
+                                    state->pmap, 1, 0.0f,
+                                    state->pmap_grid[state->dispSlotIdx], 1);
                         break;
 
                     case REASS_UPSCALE:
                         /* upscale */
-                        getSHreal_recur(upscaleOrder, pars->est_dirs, pars->grid_nDirs, pars->Y_up);
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, up_nSH, DIRASS_FRAME_SIZE, pars->grid_nDirs, 1.0f,
-                                    pars->Y_up, pars->grid_nDirs,
-                                    pars->ss, DIRASS_FRAME_SIZE, 0.0f,
+                        getSHreal_recur(upscaleOrder, state->est_dirs, state->grid_nDirs, state->Y_up);
+                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, up_nSH, DIRASS_FRAME_SIZE, state->grid_nDirs, 1.0f,
+                                    state->Y_up, state->grid_nDirs,
+                                    state->ss, DIRASS_FRAME_SIZE, 0.0f,
                                     (float*)pData->SHframe_upTD, DIRASS_FRAME_SIZE);
 
                         /* Beamform using the new spatially upscaled frame */
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, DIRASS_FRAME_SIZE, up_nSH, 1.0f,
-                                    pars->Uw, up_nSH,
+                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, state->grid_nDirs, DIRASS_FRAME_SIZE, up_nSH, 1.0f,
+                                    state->Uw, up_nSH,
                                     (float*)pData->SHframe_upTD, DIRASS_FRAME_SIZE, 0.0f,
-                                    pars->ss, DIRASS_FRAME_SIZE);
+                                    state->ss, DIRASS_FRAME_SIZE);
 
                         /* sum energy over the length of the frame to obtain the pmap */
-                        memset(pData->pmap, 0, pars->grid_nDirs *sizeof(float));
-                        for(i=0; i<pars->grid_nDirs; i++)
+                        memset(state->pmap, 0, state->grid_nDirs *sizeof(float));
+                        for(i=0; i<state->grid_nDirs; i++)
                             for(j=0; j<DIRASS_FRAME_SIZE; j++)
-                                pData->pmap[i] += (pars->ss[i*DIRASS_FRAME_SIZE+j])*(pars->ss[i*DIRASS_FRAME_SIZE+j]);
+                                state->pmap[i] += (state->ss[i*DIRASS_FRAME_SIZE+j])*(state->ss[i*DIRASS_FRAME_SIZE+j]);
 
                         /* average energy over time */
-                        for(i=0; i<pars->grid_nDirs; i++){
-                            pData->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pData->pmap[i]);
-                            pars->prev_energy[i] = pData->pmap[i];
+                        for(i=0; i<state->grid_nDirs; i++){
+                            state->pmap[i] = pmapAvgCoeff * (state->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (state->pmap[i]);
+                            state->prev_energy[i] = state->pmap[i];
                         }
 
                         /* interpolate the pmap */
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
-                                    pars->interp_table, pars->grid_nDirs,
-                                    pData->pmap, 1, 0.0f,
-                                    pData->pmap_grid[pData->dispSlotIdx], 1);
+                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, state->interp_nDirs, 1, state->grid_nDirs, 1.0f,
+                                    state->interp_table, state->grid_nDirs,
+                                    state->pmap, 1, 0.0f,
+                                    state->pmap_grid[state->dispSlotIdx], 1);
                         break;
 
                     case REASS_NEAREST:
                         /* Assign the sector energies to the nearest display grid point */
-                        findClosestGridPoints(pars->interp_dirs_rad, pars->interp_nDirs, pars->est_dirs, pars->grid_nDirs, 0, pars->est_dirs_idx, NULL, NULL);
-                        memset(pData->pmap_grid[pData->dispSlotIdx], 0, pars->interp_nDirs * sizeof(float));
-                        for(i=0; i< pars->grid_nDirs; i++)
+                        findClosestGridPoints(state->interp_dirs_rad, state->interp_nDirs, state->est_dirs, state->grid_nDirs, 0, state->est_dirs_idx, NULL, NULL);
+                        memset(state->pmap_grid[state->dispSlotIdx], 0, state->interp_nDirs * sizeof(float));
+                        for(i=0; i< state->grid_nDirs; i++)
                             for(j=0; j<DIRASS_FRAME_SIZE; j++)
-                                pData->pmap[i] = (pars->ss[i*DIRASS_FRAME_SIZE+j])*(pars->ss[i*DIRASS_FRAME_SIZE+j]);
+                                state->pmap[i] = (state->ss[i*DIRASS_FRAME_SIZE+j])*(state->ss[i*DIRASS_FRAME_SIZE+j]);
 
                         /* average energy over time, and assign to nearest grid direction */
-                        for(i=0; i<pars->grid_nDirs; i++){
-                            pData->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pData->pmap[i]);
-                            pars->prev_energy[i] = pData->pmap[i];
-                            pData->pmap_grid[pData->dispSlotIdx][pars->est_dirs_idx[i]] += pData->pmap[i];
+                        for(i=0; i<state->grid_nDirs; i++){
+                            state->pmap[i] = pmapAvgCoeff * (state->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (state->pmap[i]);
+                            state->prev_energy[i] = state->pmap[i];
+                            state->pmap_grid[state->dispSlotIdx][state->est_dirs_idx[i]] += state->pmap[i];
                         }
                         break;
                 }
 
                 /* ascertain the minimum and maximum values for pmap colour scaling */
                 int ind;
-                utility_siminv(pData->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
-                pData->pmap_grid_minVal = pData->pmap_grid[pData->dispSlotIdx][ind];
-                utility_simaxv(pData->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
-                pData->pmap_grid_maxVal = pData->pmap_grid[pData->dispSlotIdx][ind];
+                utility_siminv(state->pmap_grid[state->dispSlotIdx], state->interp_nDirs, &ind);
+                pData->pmap_grid_minVal = state->pmap_grid[state->dispSlotIdx][ind];
+                utility_simaxv(state->pmap_grid[state->dispSlotIdx], state->interp_nDirs, &ind);
+                pData->pmap_grid_maxVal = state->pmap_grid[state->dispSlotIdx][ind];
 
                 /* normalise the pmap to 0..1 */
-                for(i=0; i<pars->interp_nDirs; i++)
-                    pData->pmap_grid[pData->dispSlotIdx][i] = (pData->pmap_grid[pData->dispSlotIdx][i]-pData->pmap_grid_minVal)/(pData->pmap_grid_maxVal-pData->pmap_grid_minVal+1e-11f);
+                for(i=0; i<state->interp_nDirs; i++)
+                    state->pmap_grid[state->dispSlotIdx][i] = (state->pmap_grid[state->dispSlotIdx][i]-pData->pmap_grid_minVal)/(pData->pmap_grid_maxVal-pData->pmap_grid_minVal+1e-11f);
 
                 /* signify that the pmap in the current slot is ready for plotting */
-                pData->dispSlotIdx++;
-                if(pData->dispSlotIdx>=NUM_DISP_SLOTS)
-                    pData->dispSlotIdx = 0;
-                pData->pmapReady = 1;
+                state->dispSlotIdx++;
+                if(state->dispSlotIdx>=NUM_DISP_SLOTS)
+                    state->dispSlotIdx = 0;
+                state->pmapReady = 1;
             }
         }
         else if(pData->FIFO_idx >= DIRASS_FRAME_SIZE){
@@ -410,7 +382,7 @@ void dirass_analysis
         }
     }
     
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 /* SETS */
@@ -473,12 +445,16 @@ void dirass_setUpscaleOrder(void* const hDir,  int newValue)
 void dirass_setDiRAssMode(void* const hDir,  int newMode)
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
+    dirass_codecState* state;
+    int ticket;
     if(pData->DirAssMode!=(DIRASS_REASS_MODES)newMode){
         pData->DirAssMode = (DIRASS_REASS_MODES)newMode;
-        if(pars->prev_intensity!=NULL)
-            memset(pars->prev_intensity, 0, pars->grid_nDirs*3*sizeof(float));
-        memset(pars->prev_energy, 0, pars->grid_nDirs*sizeof(float));
+        state = (dirass_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+        if(state!=NULL){
+            memset(state->prev_intensity, 0, state->grid_nDirs*3*sizeof(float));
+            memset(state->prev_energy, 0, state->grid_nDirs*sizeof(float));
+        }
+        saf_rcu_release(pData->hCodecState, ticket);
     }
 }
 
@@ -549,7 +525,7 @@ int dirass_getFrameSize(void)
 CODEC_STATUS dirass_getCodecStatus(void* const hDir)
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float dirass_getProgressBar0_1(void* const hDir)
@@ -657,11 +633,16 @@ float dirass_getMapAvgCoeff(void* const hDir)
 int dirass_getPmap(void* const hDir, float** grid_dirs, float** pmap, int* nDirs,int* pmapWidth, int* hfov, float* aspectRatio) 
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
-    if((pData->codecStatus == CODEC_STATUS_INITIALISED) && pData->pmapReady){
-        (*grid_dirs) = pars->interp_dirs_deg;
-        (*pmap) = pData->pmap_grid[pData->dispSlotIdx-1 < 0 ? NUM_DISP_SLOTS-1 : pData->dispSlotIdx-1];
-        (*nDirs) = pars->interp_nDirs;
+    dirass_codecState* state;
+    int ticket, pmapReady;
+
+    /* (the returned pointers remain valid until the next re-initialisation) */
+    state = (dirass_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    pmapReady = state!=NULL ? state->pmapReady : 0;
+    if((saf_atomic_load(&(pData->codecStatus)) == CODEC_STATUS_INITIALISED) && pmapReady){
+        (*grid_dirs) = state->interp_dirs_deg;
+        (*pmap) = state->pmap_grid[state->dispSlotIdx-1 < 0 ? NUM_DISP_SLOTS-1 : state->dispSlotIdx-1];
+        (*nDirs) = state->interp_nDirs;
         (*pmapWidth) = pData->dispWidth;
         switch(pData->HFOVoption){
             default:
@@ -677,7 +658,8 @@ int dirass_getPmap(void* const hDir, float** grid_dirs, float** pmap, int* nDirs
             case ASPECT_RATIO_4_3:  (*aspectRatio) = 4.0f/3.0f; break;
         }
     }
-    return pData->pmapReady;
+    saf_rcu_release(pData->hCodecState, ticket);
+    return pmapReady;
 }
 
 int dirass_getProcessingDelay()
@@ -40,18 +40,48 @@
 void dirass_setCodecStatus(void* const hDir, CODEC_STATUS newStatus)
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * dirass_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void dirass_destroyCodecState(void** const phState)
+{
+    dirass_codecState *state = (dirass_codecState*)(*phState);
+    int i;
+
+    if(state!=NULL){
+        free(state->interp_dirs_deg);
+        free(state->interp_dirs_rad);
+        free(state->Y_up);
+        free(state->interp_table);
+        free(state->ss);
+        free(state->ssxyz);
+        free(state->Cxyz);
+        free(state->w);
+        free(state->Cw);
+        free(state->Uw);
+        free(state->est_dirs);
+        free(state->est_dirs_idx);
+        free(state->prev_intensity);
+        free(state->prev_energy);
+        free(state->pmap);
+        for(i=0; i<NUM_DISP_SLOTS; i++)
+            free(state->pmap_grid[i]);
+        free(state);
+        state = NULL;
+        *phState = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
-void dirass_initAna(void* const hDir)
+void dirass_initAna
+(
+    void* const hDir,
+    dirass_codecState* state
+)
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
     int i, j, N_azi, N_ele, nSH_order, order, nSH_sec, order_sec, order_up, nSH_up, geosphere_ico_freq, td_degree;
     float hfov, vfov, fi, aspectRatio;
     float *grid_x_axis, *grid_y_axis, *c_n;
@@ -69,62 +99,62 @@ void dirass_initAna(void* const hDir)
     switch(pData->gridOption){
         case T_DESIGN_3:           /* 6 points */
             td_degree = 3;
-            pars->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
-            pars->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
+            state->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
+            state->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
             break;
         case T_DESIGN_4:           /* 12 points */
             td_degree = 4;
-            pars->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
-            pars->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
+            state->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
+            state->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
             break;
         case T_DESIGN_6:           /* 24 points */
             td_degree = 6;
-            pars->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
-            pars->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
+            state->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
+            state->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
             break;
         case T_DESIGN_9:           /* 48 points */
             td_degree = 9;
-            pars->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
-            pars->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
+            state->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
+            state->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
             break;
         case T_DESIGN_13:          /* 94 points */
             td_degree = 13;
-            pars->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
-            pars->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
+            state->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
+            state->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
             break;
         case T_DESIGN_18:          /* 180 points */
             td_degree = 18;
-            pars->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
-            pars->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
+            state->grid_dirs_deg = (float*)__HANDLES_Tdesign_dirs_deg[td_degree-1];
+            state->grid_nDirs = __Tdesign_nPoints_per_degree[td_degree-1];
             break;
         case GRID_GEOSPHERE_6:     /* 362 points */
             geosphere_ico_freq = 6;
-            pars->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
-            pars->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
+            state->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
+            state->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
             break;
         case T_DESIGN_30:          /* 480 points */
-            pars->grid_dirs_deg = (float*)__Tdesign_degree_30_dirs_deg;
-            pars->grid_nDirs = 480;
+            state->grid_dirs_deg = (float*)__Tdesign_degree_30_dirs_deg;
+            state->grid_nDirs = 480;
             break;
         case GRID_GEOSPHERE_8:     /* 642 points */
             geosphere_ico_freq = 8;
-            pars->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
-            pars->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
+            state->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
+            state->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
             break;
         case GRID_GEOSPHERE_9:     /* 812 points */
             geosphere_ico_freq = 9;
-            pars->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
-            pars->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
+            state->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
+            state->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
             break;
         case GRID_GEOSPHERE_10:    /* 1002 points */
             geosphere_ico_freq = 10;
-            pars->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
-            pars->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
+            state->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
+            state->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
             break;
         case GRID_GEOSPHERE_12:    /* 1442 points */
             geosphere_ico_freq = 12;
-            pars->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
-            pars->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
+            state->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
+            state->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
             break;
     }
     
@@ -151,19 +181,18 @@ void dirass_initAna(void* const hDir)
         grid_x_axis[i] = fi;
     for(fi = -vfov/2.0f,  i = 0; i<N_ele; fi+=vfov/N_ele, i++)
         grid_y_axis[i] = fi;
-    pars->interp_dirs_deg = realloc1d(pars->interp_dirs_deg, N_azi*N_ele*2*sizeof(float));
-    pars->interp_dirs_rad = realloc1d(pars->interp_dirs_rad, N_azi*N_ele*2*sizeof(float));
+    state->interp_dirs_deg = malloc1d(N_azi*N_ele*2*sizeof(float));
+    state->interp_dirs_rad = malloc1d(N_azi*N_ele*2*sizeof(float));
     for(i = 0; i<N_ele; i++){
         for(j=0; j<N_azi; j++){
-            pars->interp_dirs_deg[(i*N_azi + j)*2]   = grid_x_axis[j];
-            pars->interp_dirs_deg[(i*N_azi + j)*2+1] = grid_y_axis[i];
-            pars->interp_dirs_rad[(i*N_azi + j)*2] = grid_x_axis[j] * M_PI/180.0f;
-            pars->interp_dirs_rad[(i*N_azi + j)*2+1] = grid_y_axis[i] * M_PI/180.0f;
+            state->interp_dirs_deg[(i*N_azi + j)*2]   = grid_x_axis[j];
+            state->interp_dirs_deg[(i*N_azi + j)*2+1] = grid_y_axis[i];
+            state->interp_dirs_rad[(i*N_azi + j)*2] = grid_x_axis[j] * M_PI/180.0f;
+            state->interp_dirs_rad[(i*N_azi + j)*2+1] = grid_y_axis[i] * M_PI/180.0f;
         }
     }
-    free(pars->interp_table);
-    generateVBAPgainTable3D_srcs(pars->interp_dirs_deg, N_azi*N_ele, pars->grid_dirs_deg, pars->grid_nDirs, 0, 0, 0.0f, &(pars->interp_table), &(pars->interp_nDirs), &(pars->interp_nTri));
-    VBAPgainTable2InterpTable(pars->interp_table, pars->interp_nDirs, pars->grid_nDirs);
+    generateVBAPgainTable3D_srcs(state->interp_dirs_deg, N_azi*N_ele, state->grid_dirs_deg, state->grid_nDirs, 0, 0, 0.0f, &(state->interp_table), &(state->interp_nDirs), &(state->interp_nTri));
+    VBAPgainTable2InterpTable(state->interp_table, state->interp_nDirs, state->grid_nDirs);
     
     strcpy(pData->progressBarText,"Computing Sector coefficients");
     pData->progressBar0_1 = 0.85f;
@@ -179,13 +208,13 @@ void dirass_initAna(void* const hDir)
         case STATIC_BEAM_TYPE_HYPERCARDIOID: beamWeightsHypercardioid2Spherical(order_sec, c_n); break;
         case STATIC_BEAM_TYPE_MAX_EV: beamWeightsMaxEV(order_sec, c_n); break;
     }
-    pars->Cxyz = realloc1d(pars->Cxyz, pars->grid_nDirs * nSH_order * 3 * sizeof(float));
-    pars->Cw = realloc1d(pars->Cw, pars->grid_nDirs * nSH_sec * sizeof(float));
-    for(i=0; i<pars->grid_nDirs; i++){
-        beamWeightsVelocityPatternsReal(order_sec, c_n, pars->grid_dirs_deg[i*2]*M_PI/180.0f,
-                                        pars->grid_dirs_deg[i*2+1]*M_PI/180.0f, A_xyz, &(pars->Cxyz[i*nSH_order*3]));
-        rotateAxisCoeffsReal(order_sec, c_n, M_PI/2.0f - pars->grid_dirs_deg[i*2+1]*M_PI/180.0f,
-                             pars->grid_dirs_deg[i*2]*M_PI/180.0f, &(pars->Cw[i*nSH_sec]));
+    state->Cxyz = malloc1d(state->grid_nDirs * nSH_order * 3 * sizeof(float));
+    state->Cw = malloc1d(state->grid_nDirs * nSH_sec * sizeof(float));
+    for(i=0; i<state->grid_nDirs; i++){
+        beamWeightsVelocityPatternsReal(order_sec, c_n, state->grid_dirs_deg[i*2]*M_PI/180.0f,
+                                        state->grid_dirs_deg[i*2+1]*M_PI/180.0f, A_xyz, &(state->Cxyz[i*nSH_order*3]));
+        rotateAxisCoeffsReal(order_sec, c_n, M_PI/2.0f - state->grid_dirs_deg[i*2+1]*M_PI/180.0f,
+                             state->grid_dirs_deg[i*2]*M_PI/180.0f, &(state->Cw[i*nSH_sec]));
     }
     free(A_xyz);
     free(c_n);
@@ -197,10 +226,10 @@ void dirass_initAna(void* const hDir)
         case STATIC_BEAM_TYPE_HYPERCARDIOID: beamWeightsHypercardioid2Spherical(order, c_n); break;
         case STATIC_BEAM_TYPE_MAX_EV: beamWeightsMaxEV(order, c_n); break;
     }
-    pars->w = realloc1d(pars->w, pars->grid_nDirs * nSH_order * sizeof(float));
-    for(i=0; i<pars->grid_nDirs; i++){
-        rotateAxisCoeffsReal(order, c_n, M_PI/2.0f - pars->grid_dirs_deg[i*2+1]*M_PI/180.0f,
-                             pars->grid_dirs_deg[i*2]*M_PI/180.0f, &(pars->w[i*nSH_order]));
+    state->w = malloc1d(state->grid_nDirs * nSH_order * sizeof(float));
+    for(i=0; i<state->grid_nDirs; i++){
+        rotateAxisCoeffsReal(order, c_n, M_PI/2.0f - state->grid_dirs_deg[i*2+1]*M_PI/180.0f,
+                             state->grid_dirs_deg[i*2]*M_PI/180.0f, &(state->w[i*nSH_order]));
     }
     free(c_n);
  
@@ -211,31 +240,31 @@ void dirass_initAna(void* const hDir)
         case STATIC_BEAM_TYPE_HYPERCARDIOID: beamWeightsHypercardioid2Spherical(order_up, c_n); break;
         case STATIC_BEAM_TYPE_MAX_EV: beamWeightsMaxEV(order_up, c_n); break;
     } 
-    pars->Uw = realloc1d(pars->Uw, pars->grid_nDirs * nSH_up * sizeof(float));
-    for(i=0; i<pars->grid_nDirs; i++){
-        rotateAxisCoeffsReal(order_up, c_n, M_PI/2.0f - pars->grid_dirs_deg[i*2+1]*M_PI/180.0f,
-                             pars->grid_dirs_deg[i*2]*M_PI/180.0f, &(pars->Uw[i*nSH_up]));
+    state->Uw = malloc1d(state->grid_nDirs * nSH_up * sizeof(float));
+    for(i=0; i<state->grid_nDirs; i++){
+        rotateAxisCoeffsReal(order_up, c_n, M_PI/2.0f - state->grid_dirs_deg[i*2+1]*M_PI/180.0f,
+                             state->grid_dirs_deg[i*2]*M_PI/180.0f, &(state->Uw[i*nSH_up]));
     }
     free(c_n);
  
-    /* reallocate memory */
-    pars->Y_up = realloc1d(pars->Y_up, nSH_up * (pars->grid_nDirs)*sizeof(float));
-    pars->est_dirs = realloc1d(pars->est_dirs, pars->grid_nDirs * 2 * sizeof(float));
-    pars->ss = realloc1d(pars->ss, pars->grid_nDirs * DIRASS_FRAME_SIZE * sizeof(float));
-    pars->ssxyz = realloc1d(pars->ssxyz, 3 * DIRASS_FRAME_SIZE * sizeof(float));
-    pData->pmap = realloc1d(pData->pmap, pars->grid_nDirs*sizeof(float));
-    pars->est_dirs_idx = realloc1d(pars->est_dirs_idx, pars->grid_nDirs*sizeof(int));
-    pars->prev_intensity = realloc1d(pars->prev_intensity, pars->grid_nDirs*3*sizeof(float));
-    pars->prev_energy = realloc1d(pars->prev_energy, pars->grid_nDirs*sizeof(float));
-    memset(pars->prev_intensity, 0, pars->grid_nDirs*3*sizeof(float));
-    memset(pars->prev_energy, 0, pars->grid_nDirs*sizeof(float)); 
-    for(i=0; i<NUM_DISP_SLOTS; i++){
-        pData->pmap_grid[i] = realloc1d(pData->pmap_grid[i], pars->interp_nDirs*sizeof(float));
-        memset(pData->pmap_grid[i], 0, pars->interp_nDirs*sizeof(float));
-    }
+    /* allocate memory */
+    state->Y_up = malloc1d(nSH_up * (state->grid_nDirs)*sizeof(float));
+    state->est_dirs = malloc1d(state->grid_nDirs * 2 * sizeof(float));
+    state->ss = malloc1d(state->grid_nDirs * DIRASS_FRAME_SIZE * sizeof(float));
+    state->ssxyz = malloc1d(3 * DIRASS_FRAME_SIZE * sizeof(float));
+    state->pmap = malloc1d(state->grid_nDirs*sizeof(float));
+    state->est_dirs_idx = malloc1d(state->grid_nDirs*sizeof(int));
+    state->prev_intensity = malloc1d(state->grid_nDirs*3*sizeof(float));
+    state->prev_energy = malloc1d(state->grid_nDirs*sizeof(float));
+    memset(state->prev_intensity, 0, state->grid_nDirs*3*sizeof(float));
+    memset(state->prev_energy, 0, state->grid_nDirs*sizeof(float)); 
+    for(i=0; i<NUM_DISP_SLOTS; i++)
+        state->pmap_grid[i] = calloc1d(state->interp_nDirs, sizeof(float));
+    state->dispSlotIdx = 0;
+    state->pmapReady = 0;
     
-    pData->inputOrder = order;
-    pData->upscaleOrder = order_up;
+    state->inputOrder = pData->inputOrder = order;
+    state->upscaleOrder = pData->upscaleOrder = order_up;
     
     free(grid_x_axis);
     free(grid_y_axis);
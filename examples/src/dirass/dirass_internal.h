@@ -66,10 +66,18 @@ extern "C" {
 /* ========================================================================== */
 
 /**
- * Contains variables for scanning grids, and sector beamforming
+ * Contains variables for scanning grids, and sector beamforming, as used by
+ * dirass_analysis(). These are computed by dirass_initCodec() and then handed
+ * over to the processing thread (see saf_utility_rcu.h); so the analysis
+ * carries on with the previous configuration while a new one is computed.
+ * The buffers, which are sized for the configuration, are only written to by
+ * the processing thread.
  */
-typedef struct _dirass_codecPars
+typedef struct _dirass_codecState
 {
+    int inputOrder;           /**< Input/analysis order */
+    int upscaleOrder;         /**< Target upscale order */
+
     /* scanning grid and intepolation table */
     float* grid_dirs_deg;     /**< scanning grid directions; FLAT: grid_nDirs x 2 */
     int grid_nDirs;           /**< number of grid directions */
@@ -93,8 +101,14 @@ typedef struct _dirass_codecPars
     
     /* regular beamforming */
     float* w;                 /**< beamforming weights; FLAT: nDirs x (order+1)^2 */
+
+    /* display */
+    float* pmap;              /**< grid_nDirs x 1 */
+    float* pmap_grid[NUM_DISP_SLOTS]; /**< dirass interpolated to grid; interp_nDirs x 1 */
+    int dispSlotIdx;          /**< current display slot index */
+    int pmapReady;            /**< 0: image generation not started yet, 1: image is ready for plotting*/
      
-}dirass_codecPars;
+}dirass_codecState;
     
 /**
  * Main structure for dirass. Contains variables for audio buffers, filtering,
@@ -119,20 +133,16 @@ typedef struct _dirass
     int new_upscaleOrder;                   /**< New target upscale order */
     
     /* ana configuration */
-    CODEC_STATUS codecStatus;               /**< see #CODEC_STATUS */
-    PROC_STATUS procStatus;                 /**< see #PROC_STATUS */
+    volatile int codecStatus;               /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;          /**< 1: dirass_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;                   /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;                  /**< Current (re)initialisation step, string */
-    dirass_codecPars* pars;                 /**< codec parameters */
+    void* hCodecState;                      /**< Hand-off of the current #dirass_codecState to the processing thread (saf_rcu handle) */
     
     /* display */
-    float* pmap;                            /**< grid_nDirs x 1 */
-    float* pmap_grid[NUM_DISP_SLOTS];       /**< dirass interpolated to grid; interp_nDirs x 1 */
-    int dispSlotIdx;                        /**< current display slot index */
     float pmap_grid_minVal;                 /**< minimum value in pmap */
     float pmap_grid_maxVal;                 /**< maximum value in pmap */
     int recalcPmap;                         /**< set this to 1 to generate a new image */
-    int pmapReady;                          /**< 0: image generation not started yet, 1: image is ready for plotting*/
     
     /* User parameters */
     int inputOrder;                         /**< Current input/analysis order */
@@ -158,8 +168,17 @@ typedef struct _dirass
 /** Sets codec status (see #CODEC_STATUS enum) */
 void dirass_setCodecStatus(void* const hDir, CODEC_STATUS newStatus);
 
-/** Intialises the codec variables, based on current global/user parameters */
-void dirass_initAna(void* const hDir);
+/** Destroys a #dirass_codecState (once retired by the saf_rcu handle) */
+void dirass_destroyCodecState(void** const phState);
+
+/**
+ * Intialises the codec variables, based on current global/user parameters
+ *
+ * @param[in]  hDir  dirass handle
+ * @param[out] state New (zero-initialised) codec state to fill in
+ */
+void dirass_initAna(void* const hDir,
+                    dirass_codecState* state);
 
 
 #ifdef __cplusplus
@@ -185,7 +185,7 @@ void matrixconv_checkReInit(void* const hMCnv)
                                   pData->filter_length,
                                   pData->nInputChannels,
                                   pData->nOutputChannels,
-                                  pData->enablePartitionedConv);
+                                  pData->enablePartitionedConv==2 ? SAF_CONV_PARTITIONED_NONUNIFORM : pData->enablePartitionedConv);
         }
 
         /* Resize buffers */
@@ -238,6 +238,7 @@ void matrixconv_setFilters
 void matrixconv_setEnablePart(void* const hMCnv, int newState)
 {
     matrixconv_data *pData = (matrixconv_data*)(hMCnv);
+    newState = SAF_CLAMP(newState, 0, 2);
     if(pData->enablePartitionedConv!=newState){
         pData->enablePartitionedConv = newState;
         pData->reInitFilters = 1;
@@ -72,7 +72,7 @@ typedef struct _matrixconv
     
     /* user parameters */
     int nInputChannels;        /**< number of input channels */
-    int enablePartitionedConv; /**< 0: disabled, 1: enabled */
+    int enablePartitionedConv; /**< 0: disabled, 1: uniformly partitioned, 2: non-uniformly partitioned */
     
 } matrixconv_data;
     
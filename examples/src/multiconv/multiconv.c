@@ -175,7 +175,7 @@ void multiconv_checkReInit(void* const hMCnv)
                              pData->filters,
                              pData->filter_length,
                              pData->nfilters,
-                             pData->enablePartitionedConv);
+                             pData->enablePartitionedConv==2 ? SAF_CONV_PARTITIONED_NONUNIFORM : pData->enablePartitionedConv);
 
         /* Resize buffers */
         pData->inputFrameTD  = (float**)realloc2d((void**)pData->inputFrameTD, MAX_NUM_CHANNELS, pData->hostBlockSize_clamped, sizeof(float));
@@ -215,6 +215,7 @@ void multiconv_setFilters
 void multiconv_setEnablePart(void* const hMCnv, int newState)
 {
     multiconv_data *pData = (multiconv_data*)(hMCnv);
+    newState = SAF_CLAMP(newState, 0, 2);
     if(pData->enablePartitionedConv!=newState){
         pData->enablePartitionedConv = newState;
         pData->reInitFilters = 1;
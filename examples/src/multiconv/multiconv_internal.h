@@ -69,7 +69,7 @@ typedef struct _multiconv
     
     /* user parameters */
     int nChannels;         /**< Current number of input/output channels */
-    int enablePartitionedConv; /**< 1: enable partitioned convolution, 0: regular convolution (fft over the length of the filter) */
+    int enablePartitionedConv; /**< 1: enable uniformly partitioned convolution, 2: enable non-uniformly partitioned convolution, 0: regular convolution (fft over the length of the filter) */
     
 } multiconv_data;
 
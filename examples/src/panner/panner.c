@@ -78,7 +78,9 @@ void panner_create
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    pData->initialisingFLAG = 0;
+    saf_rcu_create(&(pData->hCodecState), panner_destroyCodecState);
+    pData->codecStateID = pData->G_srcStateID = 0;
     for(ch=0; ch<MAX_NUM_INPUTS; ch++)
         pData->recalc_gainsFLAG[ch] = 1;
     pData->vbap_gtable = NULL;
@@ -94,11 +96,10 @@ void panner_destroy
     panner_data *pData = (panner_data*)(*phPan);
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
         
         /* free afSTFT and buffers */
         if(pData->hSTFT !=NULL)
@@ -107,6 +108,7 @@ void panner_destroy
         free(pData->outputFrameTD);
         free(pData->inputframeTF);
         free(pData->outputframeTF);
+        saf_rcu_destroy(&(pData->hCodecState));
         free(pData->vbap_gtable);
         free(pData->progressBarText);
         
@@ -140,17 +142,20 @@ void panner_initCodec
 )
 {
     panner_data *pData = (panner_data*)(hPan);
+    panner_codecState* state;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the processing loop is not paused; it carries on with the
+     * previous gain table until the new one is ready */
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
@@ -162,11 +167,25 @@ void panner_initCodec
         panner_initGainTables(hPan);
         pData->reInitGainTables = 0;
     }
+
+    /* hand the gain table over to the processing thread */
+    state = (panner_codecState*)malloc1d(sizeof(panner_codecState));
+    state->id = ++(pData->codecStateID);
+    state->nSources = pData->nSources;
+    state->nLoudpkrs = pData->nLoudpkrs;
+    state->output_nDims = pData->output_nDims;
+    state->vbapTableRes[0] = pData->vbapTableRes[0];
+    state->vbapTableRes[1] = pData->vbapTableRes[1];
+    state->N_vbap_gtable = pData->N_vbap_gtable;
+    state->vbap_gtable = malloc1d(state->N_vbap_gtable * state->nLoudpkrs * sizeof(float));
+    memcpy(state->vbap_gtable, pData->vbap_gtable, state->N_vbap_gtable * state->nLoudpkrs * sizeof(float));
+    saf_rcu_publish(pData->hCodecState, (void*)state);
     
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
     
 }
 
@@ -181,7 +200,8 @@ void panner_process
 )
 {
     panner_data *pData = (panner_data*)(hPan);
-    int t, ch, ls, i, band, nSources, nLoudspeakers, N_azi, aziIndex, elevIndex, idx3d, idx2D;
+    panner_codecState* state;
+    int t, ch, ls, i, band, nSources, nLoudspeakers, ticket, N_azi, aziIndex, elevIndex, idx3d, idx2D;
     float aziRes, elevRes, pv_f, gains3D_sum_pvf, gains2D_sum_pvf, Rxyz[3][3], hypotxy;
     float src_dirs[MAX_NUM_INPUTS][2], pValue[HYBRID_BANDS], gains3D[MAX_NUM_OUTPUTS], gains2D[MAX_NUM_OUTPUTS];
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
@@ -190,12 +210,21 @@ void panner_process
     /* copy user parameters to local variables */
     memcpy(src_dirs, pData->src_dirs_deg, MAX_NUM_INPUTS*2*sizeof(float));
     memcpy(pValue, pData->pValue, HYBRID_BANDS*sizeof(float));
-    nSources = pData->nSources;
-    nLoudspeakers = pData->nLoudpkrs;
+
+    /* Current gain table (NULL until the first initialisation is complete) */
+    state = (panner_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
 
     /* apply panner */
-    if ((nSamples == PANNER_FRAME_SIZE) && (pData->vbap_gtable != NULL) && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
+    if ((nSamples == PANNER_FRAME_SIZE) && (state!=NULL)) {
+        nSources = state->nSources;
+        nLoudspeakers = state->nLoudpkrs;
+
+        /* The panning gains should be recalculated, if the gain table has changed */
+        if(state->id!=pData->G_srcStateID){
+            for(ch=0; ch<MAX_NUM_INPUTS; ch++)
+                pData->recalc_gainsFLAG[ch] = 1;
+            pData->G_srcStateID = state->id;
+        }
 
         /* Load time-domain data */
         for(i=0; i < SAF_MIN(nSources,nInputs); i++)
@@ -204,7 +233,7 @@ void panner_process
             memset(pData->inputFrameTD[i], 0, PANNER_FRAME_SIZE * sizeof(float));
 
         /* Apply time-frequency transform (TFT) */
-        afSTFT_forward_knownDimensions(pData->hSTFT, pData->inputFrameTD, PANNER_FRAME_SIZE, MAX_NUM_INPUTS, TIME_SLOTS, pData->inputframeTF);
+        afSTFT_forward_knownDimensions_nCH(pData->hSTFT, pData->inputFrameTD, PANNER_FRAME_SIZE, MAX_NUM_INPUTS, TIME_SLOTS, nSources, pData->inputframeTF);
         memset(FLATTEN3D(pData->outputframeTF), 0, HYBRID_BANDS*MAX_NUM_OUTPUTS*TIME_SLOTS * sizeof(float_complex));
         memset(outputTemp, 0, MAX_NUM_OUTPUTS*TIME_SLOTS * sizeof(float_complex));
 
@@ -230,9 +259,9 @@ void panner_process
         }
 
         /* Apply VBAP Panning */
-        if(pData->output_nDims == 3){/* 3-D case */
-            aziRes = (float)pData->vbapTableRes[0];
-            elevRes = (float)pData->vbapTableRes[1];
+        if(state->output_nDims == 3){/* 3-D case */
+            aziRes = (float)state->vbapTableRes[0];
+            elevRes = (float)state->vbapTableRes[1];
             N_azi = (int)(360.0f / aziRes + 0.5f) + 1;
             for (ch = 0; ch < nSources; ch++) {
                 /* recalculate frequency dependent panning gains */
@@ -243,7 +272,7 @@ void panner_process
                     elevIndex = (int)((pData->src_dirs_rot_deg[ch][1] + 90.0f) / elevRes + 0.5f);
                     idx3d = elevIndex * N_azi + aziIndex;
                     for (ls = 0; ls < nLoudspeakers; ls++)
-                        gains3D[ls] =  pData->vbap_gtable[idx3d*nLoudspeakers+ls];
+                        gains3D[ls] =  state->vbap_gtable[idx3d*nLoudspeakers+ls];
                     for (band = 0; band < HYBRID_BANDS; band++){
                         /* apply pValue per frequency */
                         pv_f = pData->pValue[band];
@@ -274,14 +303,14 @@ void panner_process
             }
         }
         else{/* 2-D case */
-            aziRes = (float)pData->vbapTableRes[0];
+            aziRes = (float)state->vbapTableRes[0];
             for (ch = 0; ch < nSources; ch++) {
                 /* recalculate frequency dependent panning gains */
                 if(pData->recalc_gainsFLAG[ch]){
                     //idx2D = (int)((matlab_fmodf(pData->src_dirs_deg[ch][0]+180.0f,360.0f)/aziRes)+0.5f);
                     idx2D = (int)((matlab_fmodf(pData->src_dirs_rot_deg[ch][0]+180.0f,360.0f)/aziRes)+0.5f);
                     for (ls = 0; ls < nLoudspeakers; ls++)
-                        gains2D[ls] = pData->vbap_gtable[idx2D*nLoudspeakers+ls];
+                        gains2D[ls] = state->vbap_gtable[idx2D*nLoudspeakers+ls];
                     for (band = 0; band < HYBRID_BANDS; band++){
                         /* apply pValue per frequency */
                         pv_f = pData->pValue[band];
@@ -314,7 +343,7 @@ void panner_process
             cblas_sscal(/*re+im*/2*nLoudspeakers*TIME_SLOTS, 1.0f/sqrtf((float)nSources), (float*)FLATTEN2D(pData->outputframeTF[band]), 1);
 
         /* inverse-TFT and copy to output */
-        afSTFT_backward_knownDimensions(pData->hSTFT, pData->outputframeTF, PANNER_FRAME_SIZE, MAX_NUM_OUTPUTS, TIME_SLOTS, pData->outputFrameTD);
+        afSTFT_backward_knownDimensions_nCH(pData->hSTFT, pData->outputframeTF, PANNER_FRAME_SIZE, MAX_NUM_OUTPUTS, TIME_SLOTS, nLoudspeakers, pData->outputFrameTD);
         for (ch = 0; ch < SAF_MIN(nLoudspeakers, nOutputs); ch++)
             utility_svvcopy(pData->outputFrameTD[ch], PANNER_FRAME_SIZE, outputs[ch]);
         for (; ch < nOutputs; ch++)
@@ -326,7 +355,7 @@ void panner_process
             memset(outputs[ch],0, PANNER_FRAME_SIZE*sizeof(float));
 
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 
@@ -543,7 +572,7 @@ int panner_getFrameSize(void)
 CODEC_STATUS panner_getCodecStatus(void* const hPan)
 {
     panner_data *pData = (panner_data*)(hPan);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float panner_getProgressBar0_1(void* const hPan)
@@ -47,12 +47,22 @@
 void panner_setCodecStatus(void* const hPan, CODEC_STATUS newStatus)
 {
     panner_data *pData = (panner_data*)(hPan);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * panner_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void panner_destroyCodecState(void** const phState)
+{
+    panner_codecState *state = (panner_codecState*)(*phState);
+
+    if(state!=NULL){
+        free(state->vbap_gtable);
+        free(state);
+        state = NULL;
+        *phState = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
 void panner_initGainTables(void* const hPan)
@@ -103,12 +113,12 @@ void panner_initTFT
 {
     panner_data *pData = (panner_data*)(hPan);
     
+    /* (the afSTFT is created for the maximum number of channels, and only the
+     * current sources and loudspeakers are then transformed by panner_process();
+     * therefore, changing the number of channels does not require any
+     * re-allocation) */
     if(pData->hSTFT==NULL)
-        afSTFT_create(&(pData->hSTFT), pData->new_nSources, pData->new_nLoudpkrs, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
-    else if (pData->new_nSources!=pData->nSources || pData->new_nLoudpkrs!=pData->nLoudpkrs){
-        afSTFT_channelChange(pData->hSTFT, pData->new_nSources, pData->new_nLoudpkrs);
-        afSTFT_clearBuffers(pData->hSTFT); 
-    }
+        afSTFT_create(&(pData->hSTFT), MAX_NUM_INPUTS, MAX_NUM_OUTPUTS, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
     pData->nSources = pData->new_nSources;
     pData->nLoudpkrs = pData->new_nLoudpkrs;
 }
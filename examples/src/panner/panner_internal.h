@@ -77,6 +77,24 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
 
+/**
+ * The VBAP gain table, as used by panner_process(). This is computed by
+ * panner_initCodec() and then handed over to the processing thread (see
+ * saf_utility_rcu.h); so processing carries on with the previous gain table
+ * while a new one is being computed.
+ */
+typedef struct _panner_codecState
+{
+    int id;                         /**< Unique ID of this state (incremented upon each (re)initialisation) */
+    int nSources;                   /**< Number of inputs/sources */
+    int nLoudpkrs;                  /**< Number of loudspeakers in the array */
+    int output_nDims;               /**< Dimensionality of the loudspeaker array, 2: 2-D, 3: 3-D */
+    int vbapTableRes[2];            /**< [0] azimuth, and [1] elevation grid resolution, in degrees */
+    int N_vbap_gtable;              /**< Number of directions in the VBAP gain table */
+    float* vbap_gtable;             /**< VBAP gains; FLAT: N_vbap_gtable x nLoudpkrs */
+
+} panner_codecState;
+
 /**
  * Main structure for panner. Contains variables for audio buffers, afSTFT,
  * internal variables, flags, user parameters
@@ -98,11 +116,14 @@ typedef struct _panner
     int vbapTableRes[2];            /**< [0] azimuth, and [1] elevation grid resolution, in degrees */
     float* vbap_gtable;             /**< Current VBAP gains; FLAT: N_hrtf_vbap_gtable x nLoudpkrs */
     int N_vbap_gtable;              /**< Number of directions in the VBAP gain table */
+    void* hCodecState;              /**< Hand-off of the current #panner_codecState to the processing thread (saf_rcu handle) */
+    int codecStateID;               /**< ID of the last #panner_codecState to be computed */
+    int G_srcStateID;               /**< ID of the #panner_codecState used to compute G_src */
     float_complex G_src[HYBRID_BANDS][MAX_NUM_INPUTS][MAX_NUM_OUTPUTS];  /**< Current VBAP gains per source */
     
     /* flags */
-    CODEC_STATUS codecStatus;       /**< see #CODEC_STATUS */
-    PROC_STATUS procStatus;         /**< see #PROC_STATUS */
+    volatile int codecStatus;       /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;  /**< 1: panner_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;           /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;          /**< Current (re)initialisation step, string */
     int recalc_gainsFLAG[MAX_NUM_INPUTS]; /**< 1: VBAP gains need to be recalculated for this source, 0: do not */
@@ -144,6 +165,9 @@ typedef struct _panner
 
 /** Sets codec status (see #CODEC_STATUS enum) */
 void panner_setCodecStatus(void* const hPan, CODEC_STATUS newStatus);
+
+/** Destroys a #panner_codecState (once retired by the saf_rcu handle) */
+void panner_destroyCodecState(void** const phState);
     
 /**
  * Intialises the VBAP gain table used for panning.
@@ -41,7 +41,6 @@ void pitch_shifter_create
     pData->fftsize_option = PITCH_SHIFTER_FFTSIZE_4096;
 
     /* internals */
-    pData->hSmb = NULL;
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
@@ -50,7 +49,8 @@ void pitch_shifter_create
     pData->stepsize = 1024; /* same here */
 
     /* flags */
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    pData->initialisingFLAG = 0;
+    saf_rcu_create(&(pData->hCodecState), pitch_shifter_destroyCodecState);
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
 
     /* set FIFO buffers */
@@ -67,14 +67,11 @@ void pitch_shifter_destroy
     pitch_shifter_data *pData = (pitch_shifter_data*)(*phPS);
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
-
-        if (pData->hSmb != NULL)
-            smb_pitchShift_destroy(&(pData->hSmb));
+        saf_rcu_destroy(&(pData->hCodecState));
         free(pData);
         pData = NULL;
     }
@@ -100,27 +97,26 @@ void pitch_shifter_initCodec
 )
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
+    pitch_shifter_codecState* state;
     int nChannels, fftSize, osamp;
 
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the processing loop is not paused; it carries on with the
+     * previous pitch-shifter until the new one is ready */
 
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising pitch shifter");
     pData->progressBar0_1 = 0.0f;
 
     nChannels = pData->new_nChannels;
 
-    /* destroy current handle*/
-    if (pData->hSmb != NULL)
-        smb_pitchShift_destroy(&(pData->hSmb));
-
     /* Config */
     switch(pData->osamp_option){
         default:
@@ -144,14 +140,18 @@ void pitch_shifter_initCodec
     pData->fftFrameSize = fftSize;
     pData->stepsize = fftSize/osamp;
 
-    /* Create new handle */
-    smb_pitchShift_create(&(pData->hSmb), nChannels, fftSize, osamp, pData->sampleRate);
+    /* Create new handle (the previous one is destroyed once retired) */
+    state = (pitch_shifter_codecState*)malloc1d(sizeof(pitch_shifter_codecState));
+    state->nChannels = nChannels;
+    smb_pitchShift_create(&(state->hSmb), nChannels, fftSize, osamp, pData->sampleRate);
     pData->nChannels = nChannels;
+    saf_rcu_publish(pData->hCodecState, (void*)state);
 
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
 }
 
 void pitch_shifter_process
@@ -165,8 +165,12 @@ void pitch_shifter_process
 )
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
-    int s, ch, nChannels;
-    nChannels = pData->nChannels;
+    pitch_shifter_codecState* state;
+    int s, ch, nChannels, ticket;
+
+    /* Current pitch-shifter (NULL until the first initialisation is complete) */
+    state = (pitch_shifter_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    nChannels = state!=NULL ? state->nChannels : 0;
 
     /* Loop over all samples */
     for(s=0; s<nSamples; s++){
@@ -186,16 +190,15 @@ void pitch_shifter_process
         pData->FIFO_idx++;
 
         /* Process frame if inFIFO is full and codec is ready for it */
-        if (pData->FIFO_idx >= PITCH_SHIFTER_FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
+        if (pData->FIFO_idx >= PITCH_SHIFTER_FRAME_SIZE && (state!=NULL) ) {
             pData->FIFO_idx = 0;
-            pData->procStatus = PROC_STATUS_ONGOING;
 
             /* load input */
             for(ch=0; ch<nChannels; ch++)
                 memcpy(pData->inputFrame[ch], pData->inFIFO[ch], PITCH_SHIFTER_FRAME_SIZE*sizeof(float));
 
             /* Apply pitch shifting */
-            smb_pitchShift_apply(pData->hSmb, pData->pitchShift_factor, PITCH_SHIFTER_FRAME_SIZE, (float*)pData->inputFrame, (float*)pData->outputFrame);
+            smb_pitchShift_apply(state->hSmb, pData->pitchShift_factor, PITCH_SHIFTER_FRAME_SIZE, (float*)pData->inputFrame, (float*)pData->outputFrame);
 
             /* Copy to output */
             for(ch=0; ch<nChannels; ch++)
@@ -208,7 +211,7 @@ void pitch_shifter_process
         }
     }
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 /* sets */
@@ -264,7 +267,7 @@ int pitch_shifter_getFrameSize(void)
 CODEC_STATUS pitch_shifter_getCodecStatus(void* const hBin)
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hBin);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float pitch_shifter_getProgressBar0_1(void* const hBin)
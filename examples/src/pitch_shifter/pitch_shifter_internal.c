@@ -29,11 +29,22 @@
 void pitch_shifter_setCodecStatus(void* const hPS, CODEC_STATUS newStatus)
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * pitch_shifter_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void pitch_shifter_destroyCodecState(void** const phState)
+{
+    pitch_shifter_codecState *state = (pitch_shifter_codecState*)(*phState);
+
+    if(state!=NULL){
+        if (state->hSmb != NULL)
+            smb_pitchShift_destroy(&(state->hSmb));
+        free(state);
+        state = NULL;
+        *phState = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
@@ -50,6 +50,19 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
 
+/**
+ * The pitch-shifter, as used by pitch_shifter_process(). This is created by
+ * pitch_shifter_initCodec() and then handed over to the processing thread (see
+ * saf_utility_rcu.h); so processing carries on with the previous pitch-shifter
+ * while a new one is being created.
+ */
+typedef struct _pitch_shifter_codecState
+{
+    int nChannels;                  /**< Number of input/output channels */
+    void* hSmb;                     /**< pitch-shifter handle */
+
+} pitch_shifter_codecState;
+
 /** Main struct for the pitch_shifter */
 typedef struct _pitch_shifter
 {
@@ -59,11 +72,11 @@ typedef struct _pitch_shifter
     float outFIFO[MAX_NUM_CHANNELS][PITCH_SHIFTER_FRAME_SIZE]; /**< Output FIFO buffer */
 
     /* internal */
-    void* hSmb;                     /**< pitch-shifter handle */
-    CODEC_STATUS codecStatus;       /**< see #CODEC_STATUS */
+    void* hCodecState;              /**< Hand-off of the current #pitch_shifter_codecState to the processing thread (saf_rcu handle) */
+    volatile int codecStatus;       /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;  /**< 1: pitch_shifter_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;           /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;          /**< Current (re)initialisation step, string */
-    PROC_STATUS procStatus;         /**< see #PROC_STATUS */
     float sampleRate;               /**< Host sampling rate, in Hz */
     float inputFrame[MAX_NUM_CHANNELS][PITCH_SHIFTER_FRAME_SIZE];  /**< Current input frame */
     float outputFrame[MAX_NUM_CHANNELS][PITCH_SHIFTER_FRAME_SIZE]; /**< Current output frame */
@@ -87,6 +100,9 @@ typedef struct _pitch_shifter
 /** Sets codec status (see #CODEC_STATUS enum) */
 void pitch_shifter_setCodecStatus(void* const hPS,
                                   CODEC_STATUS newStatus);
+
+/** Destroys a #pitch_shifter_codecState (once retired by the saf_rcu handle) */
+void pitch_shifter_destroyCodecState(void** const phState);
     
     
 #ifdef __cplusplus
@@ -39,7 +39,7 @@ void powermap_create
 {
     powermap_data* pData = (powermap_data*)malloc1d(sizeof(powermap_data));
     *phPm = (void*)pData;
-    int n, i, band;
+    int band;
 
     /* Default user parameters */
     pData->masterOrder = pData->new_masterOrder = SH_ORDER_FIRST;
@@ -56,34 +56,26 @@ void powermap_create
     pData->chOrdering = CH_ACN;
     pData->norm = NORM_SN3D;
     
+    /* (the afSTFT is created for the maximum number of SH signals, and only the
+     * current number is then transformed by powermap_analysis(); therefore,
+     * changing the analysis order does not require any re-allocation) */
     afSTFT_create(&(pData->hSTFT), MAX_NUM_SH_SIGNALS, 0, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
     pData->SHframeTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, POWERMAP_FRAME_SIZE, sizeof(float));
     pData->SHframeTF = (float_complex***)malloc3d(HYBRID_BANDS, MAX_NUM_SH_SIGNALS, TIME_SLOTS, sizeof(float_complex));
 
     /* codec data */
-    pData->pars = (powermap_codecPars*)malloc1d(sizeof(powermap_codecPars));
-    powermap_codecPars* pars = pData->pars;
-    pars->interp_dirs_deg = NULL;
-    for(n=0; n<MAX_SH_ORDER; n++){
-        pars->Y_grid[n] = NULL;
-        pars->Y_grid_cmplx[n] = NULL;
-    }
-    pars->interp_table = NULL;
+    saf_rcu_create(&(pData->hCodecState), powermap_destroyCodecState);
     
     /* internal */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    pData->initialisingFLAG = 0;
     pData->dispWidth = 140;
+    pData->CxOrder = pData->masterOrder;
 
     /* display */
-    pData->pmap = NULL;
-    pData->prev_pmap = NULL;
-    for(i=0; i<NUM_DISP_SLOTS; i++)
-        pData->pmap_grid[i] = NULL;
-    pData->pmapReady = 0;
     pData->recalcPmap = 1;
 
     /* set FIFO buffer */
@@ -97,34 +89,18 @@ void powermap_destroy
 )
 {
     powermap_data *pData = (powermap_data*)(*phPm);
-    powermap_codecPars* pars;
-    int i;
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
-
-        pars = pData->pars;
-
         /* free afSTFT and buffers */
         afSTFT_destroy(&(pData->hSTFT));
         free(pData->SHframeTD);
         free(pData->SHframeTF);
         
-        free(pData->pmap);
-        free(pData->prev_pmap);
-        for(i=0; i<NUM_DISP_SLOTS; i++)
-            free(pData->pmap_grid[i]);
-        free(pars->interp_dirs_deg);
-        for(i=0; i<MAX_SH_ORDER; i++){
-            free(pars->Y_grid[i]);
-            free(pars->Y_grid_cmplx[i]);
-        }
-        free(pars->interp_table);
-        free(pData->pars);
+        saf_rcu_destroy(&(pData->hCodecState));
         free(pData->progressBarText);
         free(pData);
         pData = NULL;
@@ -138,7 +114,8 @@ void powermap_init
 )
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
+    powermap_codecState* state;
+    int ticket;
     
     pData->fs = sampleRate;
     
@@ -147,10 +124,13 @@ void powermap_init
     
     /* intialise parameters */
     memset(pData->Cx, 0 , MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*HYBRID_BANDS*sizeof(float_complex));
-    if(pData->prev_pmap!=NULL)
-        memset(pData->prev_pmap, 0, pars->grid_nDirs*sizeof(float));
-    pData->pmapReady = 0;
-    pData->dispSlotIdx = 0;
+    state = (powermap_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    if(state!=NULL){
+        memset(state->prev_pmap, 0, state->grid_nDirs*sizeof(float));
+        state->pmapReady = 0;
+        state->dispSlotIdx = 0;
+    }
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 void powermap_initCodec
@@ -159,27 +139,33 @@ void powermap_initCodec
 )
 {
     powermap_data *pData = (powermap_data*)(hPm);
+    powermap_codecState* state;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the analysis is not paused; it carries on with the previous
+     * configuration until the new one is ready */
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    powermap_initTFT(hPm);
-    powermap_initAna(hPm);
+    /* compute the new configuration, and hand it over to the processing thread */
+    state = (powermap_codecState*)calloc1d(1, sizeof(powermap_codecState));
+    powermap_initAna(hPm, state);
+    saf_rcu_publish(pData->hCodecState, (void*)state);
     
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
 }
 
 void powermap_analysis
@@ -192,8 +178,8 @@ void powermap_analysis
 )
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
-    int s, i, j, ch, band, nSH_order, order_band, nSH_maxOrder, maxOrder;
+    powermap_codecState* state;
+    int s, i, j, ch, band, nSH_order, order_band, nSH_maxOrder, maxOrder, ticket;
     float C_grp_trace, pmapEQ_band;
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
     float_complex new_Cx[MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS];
@@ -215,9 +201,23 @@ void powermap_analysis
     covAvgCoeff = SAF_MIN(pData->covAvgCoeff, MAX_COV_AVG_COEFF);
     pmapAvgCoeff = pData->pmapAvgCoeff;
     pmap_mode = pData->pmap_mode;
-    masterOrder = pData->masterOrder;
+
+    /* Current configuration (NULL until the first initialisation is complete) */
+    state = (powermap_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    if(state==NULL){
+        saf_rcu_release(pData->hCodecState, ticket);
+        return;
+    }
+    masterOrder = state->masterOrder;
     nSH = (masterOrder+1)*(masterOrder+1);
 
+    /* The covariance matrices (and filterbank buffers) are reset upon a change in order */
+    if(pData->CxOrder != masterOrder){
+        afSTFT_clearBuffers(pData->hSTFT);
+        memset(pData->Cx, 0 , MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*HYBRID_BANDS*sizeof(float_complex));
+        pData->CxOrder = masterOrder;
+    }
+
     /* Loop over all samples */
     for(s=0; s<nSamples; s++){
         /* Load input signals into inFIFO buffer */
@@ -230,9 +230,8 @@ void powermap_analysis
         pData->FIFO_idx++;
 
         /* Process frame if inFIFO is full and codec is ready for it */
-        if (pData->FIFO_idx >= POWERMAP_FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) && isPlaying ) {
+        if (pData->FIFO_idx >= POWERMAP_FRAME_SIZE && isPlaying ) {
             pData->FIFO_idx = 0;
-            pData->procStatus = PROC_STATUS_ONGOING;
 
             /* Load time-domain data */
             for(ch=0; ch<nSH; ch++)
@@ -252,7 +251,7 @@ void powermap_analysis
             }
 
             /* apply the time-frequency transform */
-            afSTFT_forward_knownDimensions(pData->hSTFT, pData->SHframeTD, POWERMAP_FRAME_SIZE, MAX_NUM_SH_SIGNALS, TIME_SLOTS, pData->SHframeTF);
+            afSTFT_forward_knownDimensions_nCH(pData->hSTFT, pData->SHframeTD, POWERMAP_FRAME_SIZE, MAX_NUM_SH_SIGNALS, TIME_SLOTS, nSH, pData->SHframeTF);
 
             /* Update covarience matrix per band */
             for(band=0; band<HYBRID_BANDS; band++){
@@ -269,7 +268,7 @@ void powermap_analysis
             /* update the powermap */
             if(pData->recalcPmap==1){
                 pData->recalcPmap = 0;
-                pData->pmapReady = 0;
+                state->pmapReady = 0;
 
                 /* determine maximum analysis order */
                 maxOrder = 1;
@@ -295,79 +294,79 @@ void powermap_analysis
                 switch(pmap_mode){
                     default:
                     case PM_MODE_PWD:
-                        generatePWDmap(maxOrder, (float_complex*)C_grp, pars->Y_grid_cmplx[maxOrder-1], pars->grid_nDirs, pData->pmap);
+                        generatePWDmap(maxOrder, (float_complex*)C_grp, state->Y_grid_cmplx[maxOrder-1], state->grid_nDirs, state->pmap);
                         break;
 
                     case PM_MODE_MVDR:
                         if(C_grp_trace>1e-8f)
-                            generateMVDRmap(maxOrder, (float_complex*)C_grp, pars->Y_grid_cmplx[maxOrder-1], pars->grid_nDirs, 8.0f, pData->pmap, NULL);
+                            generateMVDRmap(maxOrder, (float_complex*)C_grp, state->Y_grid_cmplx[maxOrder-1], state->grid_nDirs, 8.0f, state->pmap, NULL);
                         else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
+                            memset(state->pmap, 0, state->grid_nDirs*sizeof(float));
                         break;
 
                     case PM_MODE_CROPAC_LCMV:
                         if(C_grp_trace>1e-8f)
-                            generateCroPaCLCMVmap(maxOrder, (float_complex*)C_grp, pars->Y_grid_cmplx[maxOrder-1], pars->grid_nDirs, 8.0f, 0.0f, pData->pmap);
+                            generateCroPaCLCMVmap(maxOrder, (float_complex*)C_grp, state->Y_grid_cmplx[maxOrder-1], state->grid_nDirs, 8.0f, 0.0f, state->pmap);
                         else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
+                            memset(state->pmap, 0, state->grid_nDirs*sizeof(float));
                         break;
 
                     case PM_MODE_MUSIC:
                         if(C_grp_trace>1e-8f)
-                            generateMUSICmap(maxOrder, (float_complex*)C_grp, pars->Y_grid_cmplx[maxOrder-1], nSources, pars->grid_nDirs, 0, pData->pmap);
+                            generateMUSICmap(maxOrder, (float_complex*)C_grp, state->Y_grid_cmplx[maxOrder-1], nSources, state->grid_nDirs, 0, state->pmap);
                         else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
+                            memset(state->pmap, 0, state->grid_nDirs*sizeof(float));
                         break;
 
                     case PM_MODE_MUSIC_LOG:
                         if(C_grp_trace>1e-8f)
-                            generateMUSICmap(maxOrder, (float_complex*)C_grp, pars->Y_grid_cmplx[maxOrder-1], nSources, pars->grid_nDirs, 1, pData->pmap);
+                            generateMUSICmap(maxOrder, (float_complex*)C_grp, state->Y_grid_cmplx[maxOrder-1], nSources, state->grid_nDirs, 1, state->pmap);
                         else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
+                            memset(state->pmap, 0, state->grid_nDirs*sizeof(float));
                         break;
 
                     case PM_MODE_MINNORM:
                         if(C_grp_trace>1e-8f)
-                            generateMinNormMap(maxOrder, (float_complex*)C_grp, pars->Y_grid_cmplx[maxOrder-1], nSources, pars->grid_nDirs, 0, pData->pmap);
+                            generateMinNormMap(maxOrder, (float_complex*)C_grp, state->Y_grid_cmplx[maxOrder-1], nSources, state->grid_nDirs, 0, state->pmap);
                         else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
+                            memset(state->pmap, 0, state->grid_nDirs*sizeof(float));
                         break;
 
                     case PM_MODE_MINNORM_LOG:
                         if(C_grp_trace>1e-8f)
-                            generateMinNormMap(maxOrder, (float_complex*)C_grp, pars->Y_grid_cmplx[maxOrder-1], nSources, pars->grid_nDirs, 1, pData->pmap);
+                            generateMinNormMap(maxOrder, (float_complex*)C_grp, state->Y_grid_cmplx[maxOrder-1], nSources, state->grid_nDirs, 1, state->pmap);
                         else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
+                            memset(state->pmap, 0, state->grid_nDirs*sizeof(float));
                         break;
                 }
 
                 /* average powermap over time */
-                for(i=0; i<pars->grid_nDirs; i++)
-                    pData->pmap[i] =  (1.0f-pmapAvgCoeff) * (pData->pmap[i] )+ pmapAvgCoeff * (pData->prev_pmap[i]);
-                utility_svvcopy(pData->pmap, pars->grid_nDirs, pData->prev_pmap);
+                for(i=0; i<state->grid_nDirs; i++)
+                    state->pmap[i] =  (1.0f-pmapAvgCoeff) * (state->pmap[i] )+ pmapAvgCoeff * (state->prev_pmap[i]);
+                utility_svvcopy(state->pmap, state->grid_nDirs, state->prev_pmap);
 
                 /* interpolate powermap */
-                cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
-                            pars->interp_table, pars->grid_nDirs,
-                            pData->pmap, 1, 0.0f,
-                            pData->pmap_grid[pData->dispSlotIdx], 1);
+                cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, state->interp_nDirs, 1, state->grid_nDirs, 1.0f,
+                            state->interp_table, state->grid_nDirs,
+                            state->pmap, 1, 0.0f,
+                            state->pmap_grid[state->dispSlotIdx], 1);
 
                 /* ascertain minimum and maximum values for powermap colour scaling */
                 int ind;
-                utility_siminv(pData->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
-                pData->pmap_grid_minVal = pData->pmap_grid[pData->dispSlotIdx][ind];
-                utility_simaxv(pData->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
-                pData->pmap_grid_maxVal = pData->pmap_grid[pData->dispSlotIdx][ind];
+                utility_siminv(state->pmap_grid[state->dispSlotIdx], state->interp_nDirs, &ind);
+                pData->pmap_grid_minVal = state->pmap_grid[state->dispSlotIdx][ind];
+                utility_simaxv(state->pmap_grid[state->dispSlotIdx], state->interp_nDirs, &ind);
+                pData->pmap_grid_maxVal = state->pmap_grid[state->dispSlotIdx][ind];
 
                 /* normalise the powermap to 0..1 */
-                for(i=0; i<pars->interp_nDirs; i++)
-                    pData->pmap_grid[pData->dispSlotIdx][i] = (pData->pmap_grid[pData->dispSlotIdx][i]-pData->pmap_grid_minVal)/(pData->pmap_grid_maxVal-pData->pmap_grid_minVal+1e-11f);
+                for(i=0; i<state->interp_nDirs; i++)
+                    state->pmap_grid[state->dispSlotIdx][i] = (state->pmap_grid[state->dispSlotIdx][i]-pData->pmap_grid_minVal)/(pData->pmap_grid_maxVal-pData->pmap_grid_minVal+1e-11f);
 
                 /* signify that the powermap in current slot is ready for plotting */
-                pData->dispSlotIdx++;
-                if(pData->dispSlotIdx>=NUM_DISP_SLOTS)
-                    pData->dispSlotIdx = 0;
-                pData->pmapReady = 1;
+                state->dispSlotIdx++;
+                if(state->dispSlotIdx>=NUM_DISP_SLOTS)
+                    state->dispSlotIdx = 0;
+                state->pmapReady = 1;
             }
         }
         else if(pData->FIFO_idx >= POWERMAP_FRAME_SIZE){
@@ -376,7 +375,7 @@ void powermap_analysis
         }
     }
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 /* SETS */
@@ -389,10 +388,13 @@ void powermap_refreshSettings(void* const hPm)
 void powermap_setPowermapMode(void* const hPm, int newMode)
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
+    powermap_codecState* state;
+    int ticket;
     pData->pmap_mode = (POWERMAP_MODES)newMode;
-    if(pData->prev_pmap!=NULL)
-        memset(pData->prev_pmap, 0, pars->grid_nDirs*sizeof(float));
+    state = (powermap_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    if(state!=NULL)
+        memset(state->prev_pmap, 0, state->grid_nDirs*sizeof(float));
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 void powermap_setMasterOrder(void* const hPm,  int newValue)
@@ -578,7 +580,7 @@ int powermap_getFrameSize(void)
 CODEC_STATUS powermap_getCodecStatus(void* const hPm)
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float powermap_getProgressBar0_1(void* const hPm)
@@ -719,11 +721,16 @@ float powermap_getPowermapAvgCoeff(void* const hPm)
 int powermap_getPmap(void* const hPm, float** grid_dirs, float** pmap, int* nDirs,int* pmapWidth, int* hfov, int* aspectRatio) //TODO: hfov and aspectRatio should be float, if 16:9 etc options are added
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
-    if((pData->codecStatus == CODEC_STATUS_INITIALISED) && pData->pmapReady){
-        (*grid_dirs) = pars->interp_dirs_deg;
-        (*pmap) = pData->pmap_grid[pData->dispSlotIdx-1 < 0 ? NUM_DISP_SLOTS-1 : pData->dispSlotIdx-1];
-        (*nDirs) = pars->interp_nDirs;
+    powermap_codecState* state;
+    int ticket, pmapReady;
+
+    /* (the returned pointers remain valid until the next re-initialisation) */
+    state = (powermap_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    pmapReady = state!=NULL ? state->pmapReady : 0;
+    if((saf_atomic_load(&(pData->codecStatus)) == CODEC_STATUS_INITIALISED) && pmapReady){
+        (*grid_dirs) = state->interp_dirs_deg;
+        (*pmap) = state->pmap_grid[state->dispSlotIdx-1 < 0 ? NUM_DISP_SLOTS-1 : state->dispSlotIdx-1];
+        (*nDirs) = state->interp_nDirs;
         (*pmapWidth) = pData->dispWidth;
         switch(pData->HFOVoption){
             default:
@@ -738,7 +745,8 @@ int powermap_getPmap(void* const hPm, float** grid_dirs, float** pmap, int* nDir
                 break;
         }
     }
-    return pData->pmapReady;
+    saf_rcu_release(pData->hCodecState, ticket);
+    return pmapReady;
 }
 
 int powermap_getProcessingDelay()
@@ -35,18 +35,41 @@
 void powermap_setCodecStatus(void* const hPm, CODEC_STATUS newStatus)
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * powermap_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void powermap_destroyCodecState(void** const phState)
+{
+    powermap_codecState *state = (powermap_codecState*)(*phState);
+    int i;
+
+    if(state!=NULL){
+        free(state->interp_dirs_deg);
+        free(state->interp_table);
+        for(i=0; i<MAX_SH_ORDER; i++){
+            free(state->Y_grid[i]);
+            free(state->Y_grid_cmplx[i]);
+        }
+        free(state->pmap);
+        free(state->prev_pmap);
+        for(i=0; i<NUM_DISP_SLOTS; i++)
+            free(state->pmap_grid[i]);
+        free(state);
+        state = NULL;
+        *phState = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
-void powermap_initAna(void* const hPm)
+void powermap_initAna
+(
+    void* const hPm,
+    powermap_codecState* state
+)
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
     int i, j, n, N_azi, N_ele, nSH_order, order;
     float scaleY, hfov, vfov, fi, aspectRatio;
     float* Y_grid_N, *grid_x_axis, *grid_y_axis;
@@ -55,22 +78,20 @@ void powermap_initAna(void* const hPm)
     
     /* Store Y_grid per order */
     int geosphere_ico_freq = 9;
-    pars->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
-    pars->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
-    Y_grid_N = malloc1d(((order+1)*(order+1))*(pars->grid_nDirs)*sizeof(float));
-    getRSH(order, pars->grid_dirs_deg, pars->grid_nDirs, Y_grid_N);
+    state->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
+    state->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
+    Y_grid_N = malloc1d(((order+1)*(order+1))*(state->grid_nDirs)*sizeof(float));
+    getRSH(order, state->grid_dirs_deg, state->grid_nDirs, Y_grid_N);
     for(n=1; n<=order; n++){
         nSH_order = (n+1)*(n+1);
         scaleY = 1.0f/(float)nSH_order;
-        free(pars->Y_grid[n-1]);
-        free(pars->Y_grid_cmplx[n-1]);
-        pars->Y_grid[n-1] = malloc1d(nSH_order * (pars->grid_nDirs)*sizeof(float));
-        pars->Y_grid_cmplx[n-1] = malloc1d(nSH_order * (pars->grid_nDirs)*sizeof(float_complex));
-        memcpy(pars->Y_grid[n-1], Y_grid_N, nSH_order * (pars->grid_nDirs)*sizeof(float));
-        utility_svsmul(pars->Y_grid[n-1], &scaleY, nSH_order * (pars->grid_nDirs), NULL);
+        state->Y_grid[n-1] = malloc1d(nSH_order * (state->grid_nDirs)*sizeof(float));
+        state->Y_grid_cmplx[n-1] = malloc1d(nSH_order * (state->grid_nDirs)*sizeof(float_complex));
+        memcpy(state->Y_grid[n-1], Y_grid_N, nSH_order * (state->grid_nDirs)*sizeof(float));
+        utility_svsmul(state->Y_grid[n-1], &scaleY, nSH_order * (state->grid_nDirs), NULL);
         for(i=0; i<nSH_order; i++)
-            for(j=0; j<pars->grid_nDirs; j++)
-                pars->Y_grid_cmplx[n-1][i*(pars->grid_nDirs)+j] = cmplxf(pars->Y_grid[n-1][i*(pars->grid_nDirs)+j], 0.0f);
+            for(j=0; j<state->grid_nDirs; j++)
+                state->Y_grid_cmplx[n-1][i*(state->grid_nDirs)+j] = cmplxf(state->Y_grid[n-1][i*(state->grid_nDirs)+j], 0.0f);
     }
 
     /* generate interpolation table for current display settings */
@@ -91,50 +112,27 @@ void powermap_initAna(void* const hPm)
         grid_x_axis[i] = fi;
     for(fi = -vfov/2.0f,  i = 0; i<N_ele; fi+=vfov/N_ele, i++)
         grid_y_axis[i] = fi;
-    free(pars->interp_dirs_deg);
-    pars->interp_dirs_deg = malloc1d(N_azi*N_ele*2*sizeof(float));
+    state->interp_dirs_deg = malloc1d(N_azi*N_ele*2*sizeof(float));
     for(i = 0; i<N_ele; i++){
         for(j=0; j<N_azi; j++){
-            pars->interp_dirs_deg[(i*N_azi + j)*2]   = grid_x_axis[j];
-            pars->interp_dirs_deg[(i*N_azi + j)*2+1] = grid_y_axis[i];
+            state->interp_dirs_deg[(i*N_azi + j)*2]   = grid_x_axis[j];
+            state->interp_dirs_deg[(i*N_azi + j)*2+1] = grid_y_axis[i];
         }
     }
-    free(pars->interp_table);
-    generateVBAPgainTable3D_srcs(pars->interp_dirs_deg, N_azi*N_ele, pars->grid_dirs_deg, pars->grid_nDirs, 0, 0, 0.0f, &(pars->interp_table), &(pars->interp_nDirs), &(pars->interp_nTri));
-    VBAPgainTable2InterpTable(pars->interp_table, pars->interp_nDirs, pars->grid_nDirs);
+    generateVBAPgainTable3D_srcs(state->interp_dirs_deg, N_azi*N_ele, state->grid_dirs_deg, state->grid_nDirs, 0, 0, 0.0f, &(state->interp_table), &(state->interp_nDirs), &(state->interp_nTri));
+    VBAPgainTable2InterpTable(state->interp_table, state->interp_nDirs, state->grid_nDirs);
     
-    /* reallocate memory for storing the powermaps */
-    free(pData->pmap);
-    pData->pmap = malloc1d(pars->grid_nDirs*sizeof(float));
-    free(pData->prev_pmap);
-    pData->prev_pmap = calloc1d(pars->grid_nDirs, sizeof(float));
-    for(i=0; i<NUM_DISP_SLOTS; i++){
-        free(pData->pmap_grid[i]);
-        pData->pmap_grid[i] = calloc1d(pars->interp_nDirs,sizeof(float));
-    }
+    /* allocate memory for storing the powermaps */
+    state->pmap = malloc1d(state->grid_nDirs*sizeof(float));
+    state->prev_pmap = calloc1d(state->grid_nDirs, sizeof(float));
+    for(i=0; i<NUM_DISP_SLOTS; i++)
+        state->pmap_grid[i] = calloc1d(state->interp_nDirs,sizeof(float));
+    state->dispSlotIdx = 0;
+    state->pmapReady = 0;
     
-    pData->masterOrder = order;
+    state->masterOrder = pData->masterOrder = order;
     
     free(Y_grid_N);
     free(grid_x_axis);
     free(grid_y_axis);
 }
-
-void powermap_initTFT
-(
-    void* const hPm
-)
-{
-    powermap_data *pData = (powermap_data*)(hPm);
-    int nSH, new_nSH;
-    
-    nSH = (pData->masterOrder+1)*(pData->masterOrder+1);
-    new_nSH = (pData->new_masterOrder+1)*(pData->new_masterOrder+1);
-    if(pData->hSTFT==NULL)
-        afSTFT_create(&(pData->hSTFT), new_nSH, 0, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
-    else if(nSH!=new_nSH){
-        afSTFT_channelChange(pData->hSTFT, new_nSH, 0);
-        afSTFT_clearBuffers(pData->hSTFT);
-        memset(pData->Cx, 0 , MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*HYBRID_BANDS*sizeof(float_complex));
-    }
-}
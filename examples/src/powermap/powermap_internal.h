@@ -66,9 +66,17 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
 
-/** Contains variables for scanning grids, and beamforming */
-typedef struct _powermap_codecPars
+/**
+ * Contains variables for scanning grids, and beamforming, as used by
+ * powermap_analysis(). These are computed by powermap_initCodec() and then
+ * handed over to the processing thread (see saf_utility_rcu.h); so the
+ * analysis carries on with the previous configuration while a new one is
+ * computed. The powermap buffers, which are sized for the configuration, are
+ * only written to by the processing thread.
+ */
+typedef struct _powermap_codecState
 {
+    int masterOrder;        /**< Maximum/master SH analysis order */
     float* grid_dirs_deg;   /**< Spherical scanning grid directions, in degrees; FLAT: grid_nDirs x 2 */
     int grid_nDirs;         /**< Number of scanning directions */
     float* interp_dirs_deg; /**< 2D rectangular window interpolation directions, in degrees; FLAT: interp_nDirs x 2 */
@@ -77,8 +85,15 @@ typedef struct _powermap_codecPars
     int interp_nTri;        /**< Number of triangles in the spherical triangulared grid */
     float* Y_grid[MAX_SH_ORDER];                 /**< real SH basis (real datatype); MAX_NUM_SH_SIGNALS x grid_nDirs */
     float_complex* Y_grid_cmplx[MAX_SH_ORDER];   /**< real SH basis (complex datatype); MAX_NUM_SH_SIGNALS x grid_nDirs */
+
+    /* display */
+    float* pmap;                    /**< grid_nDirs x 1 */
+    float* prev_pmap;               /**< grid_nDirs x 1 */
+    float* pmap_grid[NUM_DISP_SLOTS]; /**< powermap interpolated to grid; interp_nDirs x 1 */
+    int dispSlotIdx;                /**< Current display slot */
+    int pmapReady;                  /**< 0: powermap not started yet, 1: powermap is ready for plotting*/
     
-}powermap_codecPars;
+}powermap_codecState;
     
 /**
  * Main structure for powermap. Contains variables for audio buffers, internal
@@ -99,25 +114,21 @@ typedef struct _powermap
     
     /* internal */
     float_complex Cx[HYBRID_BANDS][MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS];     /**< covariance matrices per band */
+    int CxOrder;                    /**< SH order of the covariance matrices in Cx */
     int new_masterOrder;            /**< New maximum/master SH analysis order (current value will be replaced by this after next re-init) */
     int dispWidth;                  /**< Number of pixels on the horizontal in the 2D interpolated powermap image */
     
     /* ana configuration */
-    CODEC_STATUS codecStatus;       /**< see #CODEC_STATUS */
-    PROC_STATUS procStatus;         /**< see #PROC_STATUS */
+    volatile int codecStatus;       /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;  /**< 1: powermap_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;           /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;          /**< Current (re)initialisation step, string */
-    powermap_codecPars* pars;       /**< codec parameters */
+    void* hCodecState;              /**< Hand-off of the current #powermap_codecState to the processing thread (saf_rcu handle) */
     
     /* display */
-    float* pmap;                    /**< grid_nDirs x 1 */
-    float* prev_pmap;               /**< grid_nDirs x 1 */
-    float* pmap_grid[NUM_DISP_SLOTS]; /**< powermap interpolated to grid; interp_nDirs x 1 */
-    int dispSlotIdx;                /**< Current display slot */
     float pmap_grid_minVal;         /**< Current minimum value in pmap (used to normalise [0..1]) */
     float pmap_grid_maxVal;         /**< Current maximum value in pmap (used to normalise [0..1]) */
     int recalcPmap;                 /**< set this to 1 to generate a new powermap */
-    int pmapReady;                  /**< 0: powermap not started yet, 1: powermap is ready for plotting*/
     
     /* User parameters */
     int masterOrder;                /**< Current maximum/master SH analysis order */
@@ -142,15 +153,17 @@ typedef struct _powermap
 /** Sets codec status (see #CODEC_STATUS enum) */
 void powermap_setCodecStatus(void* const hPm, CODEC_STATUS newStatus);
 
-/** Intialises the codec variables, based on current global/user parameters */
-void powermap_initAna(void* const hPm);
+/** Destroys a #powermap_codecState (once retired by the saf_rcu handle) */
+void powermap_destroyCodecState(void** const phState);
 
 /**
- * Initialise the filterbank used by powermap.
+ * Intialises the codec variables, based on current global/user parameters
  *
- * @note Call this function before powermap_initAna()
+ * @param[in]  hPm   powermap handle
+ * @param[out] state New (zero-initialised) codec state to fill in
  */
-void powermap_initTFT(void* const hPm);
+void powermap_initAna(void* const hPm,
+                      powermap_codecState* state);
 
 
 #ifdef __cplusplus
@@ -91,8 +91,8 @@ void rotator_init
         pData->interpolator_fadeIn[i-1] = (float)i*1.0f/(float)ROTATOR_FRAME_SIZE;
         pData->interpolator_fadeOut[i-1] = 1.0f-pData->interpolator_fadeIn[i-1];
     }
-    memset(pData->M_rot, 0, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float));
-    memset(pData->prev_M_rot, 0, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float));
+    memset(pData->M_rot, 0, ORDER2NSHROT(MAX_SH_ORDER)*sizeof(float));
+    memset(pData->prev_M_rot, 0, ORDER2NSHROT(MAX_SH_ORDER)*sizeof(float));
     memset(pData->prev_inputFrameTD, 0, MAX_NUM_SH_SIGNALS*ROTATOR_FRAME_SIZE*sizeof(float));
     pData->M_rot_status = M_ROT_RECOMPUTE_QUATERNION;
 }
@@ -108,9 +108,8 @@ void rotator_process
 )
 {
     rotator_data *pData = (rotator_data*)(hRot);
-    int i, j, order, nSH, mixWithPreviousFLAG;
+    int i, order, nSH, mixWithPreviousFLAG;
     float Rxyz[3][3];
-    float M_rot_tmp[MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS];
     CH_ORDER chOrdering;
 
     /* locals */
@@ -136,7 +135,7 @@ void rotator_process
             /* calculate rotation matrix */
             mixWithPreviousFLAG = 0;
             if(pData->M_rot_status != M_ROT_READY){
-                memset(pData->M_rot, 0, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float));
+                memset(pData->M_rot, 0, ORDER2NSHROT(MAX_SH_ORDER)*sizeof(float));
                 if(pData->M_rot_status == M_ROT_RECOMPUTE_EULER){
                     yawPitchRoll2Rzyx (pData->yaw, pData->pitch, pData->roll, pData->useRollPitchYawFlag, Rxyz);
                     euler2Quaternion(pData->yaw, pData->pitch, pData->roll, 0,
@@ -147,26 +146,17 @@ void rotator_process
                     quaternion2euler(&(pData->Q), 0, pData->useRollPitchYawFlag ? EULER_ROTATION_ROLL_PITCH_YAW : EULER_ROTATION_YAW_PITCH_ROLL,
                                      &(pData->yaw), &(pData->pitch), &(pData->roll));
                 }
-                getSHrotMtxReal(Rxyz, (float*)M_rot_tmp, order);
-                for(i=0; i<nSH; i++)
-                    for(j=0; j<nSH; j++)
-                        pData->M_rot[i][j] = M_rot_tmp[i*nSH+j];
+                getSHrotMtxRealPacked(Rxyz, pData->M_rot, order);
                 mixWithPreviousFLAG = 1;
                 pData->M_rot_status = M_ROT_READY;
             }
 
-            /* apply rotation */
-            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, ROTATOR_FRAME_SIZE, nSH, 1.0f,
-                        (float*)(pData->M_rot), MAX_NUM_SH_SIGNALS,
-                        (float*)pData->prev_inputFrameTD, ROTATOR_FRAME_SIZE, 0.0f,
-                        (float*)pData->outputFrameTD, ROTATOR_FRAME_SIZE);
+            /* apply rotation (only the blocks along the diagonal, since each order is rotated independently) */
+            applySHrotMtxRealPacked(pData->M_rot, order, (float*)pData->prev_inputFrameTD, ROTATOR_FRAME_SIZE, (float*)pData->outputFrameTD);
 
             /* Fade between (linearly inerpolate) the new rotation matrix and the previous rotation matrix (only if the new rotation matrix is different) */
             if(mixWithPreviousFLAG){
-                cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, ROTATOR_FRAME_SIZE, nSH, 1.0f,
-                            (float*)pData->prev_M_rot, MAX_NUM_SH_SIGNALS,
-                            (float*)pData->prev_inputFrameTD, ROTATOR_FRAME_SIZE, 0.0f,
-                            (float*)pData->tempFrame, ROTATOR_FRAME_SIZE);
+                applySHrotMtxRealPacked(pData->prev_M_rot, order, (float*)pData->prev_inputFrameTD, ROTATOR_FRAME_SIZE, (float*)pData->tempFrame);
 
                 /* Apply the linear interpolation */
                 for (i=0; i < nSH; i++){
@@ -177,7 +167,7 @@ void rotator_process
                 cblas_saxpy(nSH*ROTATOR_FRAME_SIZE, 1.0f, (float*)pData->tempFrame_fadeOut, 1, (float*)pData->outputFrameTD, 1);
 
                 /* for next frame */
-                utility_svvcopy((const float*)pData->M_rot, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS, (float*)pData->prev_M_rot);
+                utility_svvcopy((const float*)pData->M_rot, ORDER2NSHROT(MAX_SH_ORDER), (float*)pData->prev_M_rot);
             }
 
             /* for next frame */
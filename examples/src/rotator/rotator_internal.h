@@ -79,8 +79,8 @@ typedef struct _rotator
     /* Internal variables */
     float interpolator_fadeIn[ROTATOR_FRAME_SIZE];       /**< Linear Interpolator (fade-in) */
     float interpolator_fadeOut[ROTATOR_FRAME_SIZE];      /**< Linear Interpolator (fade-out) */
-    float M_rot[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS];      /**< Current SH rotation matrix [1] */
-    float prev_M_rot[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS]; /**< Previous SH rotation matrix [1] */
+    float M_rot[ORDER2NSHROT(MAX_SH_ORDER)];      /**< Current SH rotation matrix [1]; packed block-diagonal format (see getSHrotMtxRealPacked()) */
+    float prev_M_rot[ORDER2NSHROT(MAX_SH_ORDER)]; /**< Previous SH rotation matrix [1]; packed block-diagonal format */
     M_ROT_STATUS M_rot_status;      /**< see #M_ROT_STATUS */
     int fs;                         /**< Host sampling rate, in Hz */
 
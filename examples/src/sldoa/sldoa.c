@@ -68,19 +68,21 @@ void sldoa_create
     pData->chOrdering = CH_ACN;
     pData->norm = NORM_SN3D;
 
-    /* TFT */
+    /* TFT (created for the maximum number of SH signals, and only the current
+     * number is then transformed by sldoa_analysis(); therefore, changing the
+     * analysis order does not require any re-allocation) */
     afSTFT_create(&(pData->hSTFT), MAX_NUM_SH_SIGNALS, 0, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
     pData->SHframeTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, SLDOA_FRAME_SIZE, sizeof(float));
     pData->SHframeTF = (float_complex***)malloc3d(HYBRID_BANDS, MAX_NUM_SH_SIGNALS, TIME_SLOTS, sizeof(float_complex));
+    pData->stftOrder = pData->masterOrder;
 
     /* internal */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
-    for(i=0; i<MAX_SH_ORDER-1; i++)
-        pData->secCoeffs[i] = NULL;
+    pData->initialisingFLAG = 0;
+    saf_rcu_create(&(pData->hCodecState), sldoa_destroyCodecState);
     for(i=0; i<64; i++)
         for(j=0; j<NUM_GRID_DIRS; j++)
             pData->grid_Y[i][j] = (float)__grid_Y[i][j] * sqrtf(4.0*M_PI);
@@ -113,11 +115,11 @@ void sldoa_destroy
     int i;
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
+        saf_rcu_destroy(&(pData->hCodecState));
         
         /* free afSTFT and buffers */
         afSTFT_destroy(&(pData->hSTFT));
@@ -168,27 +170,33 @@ void sldoa_initCodec
 )
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
+    sldoa_codecState* state;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the analysis is not paused; it carries on with the previous
+     * coefficients until the new ones are ready */
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    sldoa_initTFT(hSld);
-    sldoa_initAna(hSld);
+    /* compute the new coefficients, and hand them over to the processing thread */
+    state = (sldoa_codecState*)calloc1d(1, sizeof(sldoa_codecState));
+    sldoa_initAna(hSld, state);
+    saf_rcu_publish(pData->hCodecState, (void*)state);
     
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
 }
 
 void sldoa_analysis
@@ -201,7 +209,8 @@ void sldoa_analysis
 )
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
-    int s, i, j, t, ch, band, nSectors, min_band, numAnalysisBands, current_disp_idx;
+    sldoa_codecState* state;
+    int s, i, j, t, ch, band, nSectors, min_band, numAnalysisBands, current_disp_idx, ticket;
     float avgCoeff, max_en[HYBRID_BANDS], min_en[HYBRID_BANDS];
     float new_doa[MAX_NUM_SECTORS][TIME_SLOTS][2], new_doa_xyz[3], doa_xyz[3], avg_xyz[3];
     float new_energy[MAX_NUM_SECTORS][TIME_SLOTS];
@@ -220,9 +229,29 @@ void sldoa_analysis
     avg_ms = pData->avg_ms;
     chOrdering = pData->chOrdering;
     norm = pData->norm;
-    masterOrder = pData->masterOrder;
+
+    /* Current coefficients (NULL until the first initialisation is complete) */
+    state = (sldoa_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    if(state==NULL){
+        saf_rcu_release(pData->hCodecState, ticket);
+        return;
+    }
+    masterOrder = state->masterOrder;
     nSH = ORDER2NSH(masterOrder);
 
+    /* (the analysis orders may have already been set for a new master order,
+     * for which the coefficients are still being computed) */
+    for(band=0; band<HYBRID_BANDS; band++){
+        analysisOrderPerBand[band] = SAF_MIN(analysisOrderPerBand[band], masterOrder);
+        nSectorsPerBand[band] = ORDER2NUMSECTORS(analysisOrderPerBand[band]);
+    }
+
+    /* The filterbank buffers are reset upon a change in order */
+    if(pData->stftOrder != masterOrder){
+        afSTFT_clearBuffers(pData->hSTFT);
+        pData->stftOrder = masterOrder;
+    }
+
     /* Loop over all samples */
     for(s=0; s<nSamples; s++){
         /* Load input signals into inFIFO buffer */
@@ -235,9 +264,8 @@ void sldoa_analysis
         pData->FIFO_idx++;
 
         /* Process frame if inFIFO is full and codec is ready for it */
-        if (pData->FIFO_idx >= SLDOA_FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) && isPlaying) {
+        if (pData->FIFO_idx >= SLDOA_FRAME_SIZE && isPlaying) {
             pData->FIFO_idx = 0;
-            pData->procStatus = PROC_STATUS_ONGOING;
             current_disp_idx = pData->current_disp_idx;
 
             /* Load time-domain data */
@@ -258,7 +286,7 @@ void sldoa_analysis
             }
         
             /* apply the time-frequency transform */
-            afSTFT_forward_knownDimensions(pData->hSTFT, pData->SHframeTD, SLDOA_FRAME_SIZE, MAX_NUM_SH_SIGNALS, TIME_SLOTS, pData->SHframeTF);
+            afSTFT_forward_knownDimensions_nCH(pData->hSTFT, pData->SHframeTD, SLDOA_FRAME_SIZE, MAX_NUM_SH_SIGNALS, TIME_SLOTS, nSH, pData->SHframeTF);
 
             /* apply sector-based, frequency-dependent DOA analysis */
             numAnalysisBands = 0;
@@ -272,7 +300,7 @@ void sldoa_analysis
                     avgCoeff = SAF_MAX(SAF_MIN(avgCoeff, 0.99999f), 0.0f); /* ensures stability */
                     sldoa_estimateDoA(pData->SHframeTF[band],
                                       analysisOrderPerBand[band],
-                                      pData->secCoeffs[analysisOrderPerBand[band]-2], /* -2, as first order is skipped */
+                                      analysisOrderPerBand[band]>1 ? state->secCoeffs[analysisOrderPerBand[band]-2] : NULL, /* -2, as first order is skipped */
                                       new_doa,
                                       new_energy);
 
@@ -339,7 +367,7 @@ void sldoa_analysis
         }
     }
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 /* SETS */
@@ -499,7 +527,7 @@ int sldoa_getFrameSize(void)
 CODEC_STATUS sldoa_getCodecStatus(void* const hSld)
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float sldoa_getProgressBar0_1(void* const hSld)
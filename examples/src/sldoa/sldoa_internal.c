@@ -50,15 +50,31 @@
 void sldoa_setCodecStatus(void* const hSld, CODEC_STATUS newStatus)
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * sldoa_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void sldoa_destroyCodecState(void** const phState)
+{
+    sldoa_codecState *state = (sldoa_codecState*)(*phState);
+    int i;
+
+    if(state!=NULL){
+        for(i=0; i<MAX_SH_ORDER-1; i++)
+            free(state->secCoeffs[i]);
+        free(state);
+        state = NULL;
+        *phState = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
-void sldoa_initAna(void* const hSld)
+void sldoa_initAna
+(
+    void* const hSld,
+    sldoa_codecState* state
+)
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
     int i, n, j, k, order, nSectors, nSH, grid_N_vbap_gtable, grid_nGroups, maxOrder;
@@ -90,9 +106,7 @@ void sldoa_initAna(void* const hSld)
                 grid_vbap_gtable_T[n*NUM_GRID_DIRS+j] = grid_vbap_gtable[j*nSectors+n];
         
         /* generate sector coefficients */
-        if(pData->secCoeffs[i]!=NULL)
-            free(pData->secCoeffs[i]);
-        pData->secCoeffs[i] = malloc1d(4 * (nSH*nSectors) * sizeof(float_complex));
+        state->secCoeffs[i] = malloc1d(4 * (nSH*nSectors) * sizeof(float_complex));
         w_SG = malloc1d(4 * (nSH) * sizeof(float));
         pinv_Y = malloc1d(NUM_GRID_DIRS*nSH*sizeof(float));
         for(n=0; n<nSectors; n++){ 
@@ -108,7 +122,7 @@ void sldoa_initAna(void* const hSld)
             /* stack the sector coefficients */
             for(j=0; j<4; j++)
                 for(k=0; k<nSH; k++)
-                    pData->secCoeffs[i][j*(nSectors*nSH)+n*nSH+k] = cmplxf(w_SG[j*nSH+k], 0.0f);
+                    state->secCoeffs[i][j*(nSectors*nSH)+n*nSH+k] = cmplxf(w_SG[j*nSH+k], 0.0f);
         }
         free(w_SG);
         free(pinv_Y);
@@ -118,25 +132,7 @@ void sldoa_initAna(void* const hSld)
     
     free(grid_vbap_gtable_T);
     
-    pData->masterOrder = maxOrder;
-}
-
-void sldoa_initTFT
-(
-    void* const hSld
-)
-{
-    sldoa_data *pData = (sldoa_data*)(hSld);
-    int nSH, new_nSH;
-    
-    nSH = (pData->masterOrder+1)*(pData->masterOrder+1);
-    new_nSH = (pData->new_masterOrder+1)*(pData->new_masterOrder+1);
-    if(pData->hSTFT==NULL)
-        afSTFT_create(&(pData->hSTFT), new_nSH, 0, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
-    else if(nSH!=new_nSH){
-        afSTFT_channelChange(pData->hSTFT, new_nSH, 0);
-        afSTFT_clearBuffers(pData->hSTFT);
-    }
+    state->masterOrder = pData->masterOrder = maxOrder;
 }
 
 void sldoa_estimateDoA
@@ -82,6 +82,19 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
    
+/**
+ * The sector beamforming coefficients, as used by sldoa_analysis(). These are
+ * computed by sldoa_initCodec() and then handed over to the processing thread
+ * (see saf_utility_rcu.h); so the analysis carries on with the previous
+ * coefficients while new ones are computed.
+ */
+typedef struct _sldoa_codecState
+{
+    int masterOrder;                                 /**< Master/maximum analysis order */
+    float_complex* secCoeffs[MAX_SH_ORDER-1];        /**< Sector beamforming weights/coefficients */
+
+} sldoa_codecState;
+
 /** Main struct for sldoa */
 typedef struct _sldoa
 {
@@ -95,18 +108,19 @@ typedef struct _sldoa
     void* hSTFT;                    /**< afSTFT handle */
     float freqVector[HYBRID_BANDS]; /**< Frequency vector (filterbank centre frequencies) */
     float fs;                       /**< Host sampling rate, in Hz */
+    int stftOrder;                  /**< SH order of the signals last passed through the afSTFT */
       
     /* ana configuration */
-    CODEC_STATUS codecStatus;       /**< see #CODEC_STATUS */
-    PROC_STATUS procStatus;         /**< see #PROC_STATUS */
+    volatile int codecStatus;       /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;  /**< 1: sldoa_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;           /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;          /**< Current (re)initialisation step, string */
+    void* hCodecState;              /**< Hand-off of the current #sldoa_codecState to the processing thread (saf_rcu handle) */
     
     /* internal */
     float grid_Y[64][NUM_GRID_DIRS];                 /**< SH basis */
     float grid_Y_dipoles_norm[3][NUM_GRID_DIRS];     /**< SH basis */
     float grid_dirs_deg[NUM_GRID_DIRS][2];           /**< Grid directions, in degrees */
-    float_complex* secCoeffs[MAX_SH_ORDER-1];        /**< Sector beamforming weights/coefficients */
     float doa_rad[HYBRID_BANDS][MAX_NUM_SECTORS][2]; /**< Current DoA estimates per band and sector, in radians */
     float energy [HYBRID_BANDS][MAX_NUM_SECTORS];    /**< Current Sector energies */
     int nSectorsPerBand[HYBRID_BANDS];               /**< Number of sectors per band */
@@ -138,6 +152,9 @@ typedef struct _sldoa
 /** Sets codec status (see #CODEC_STATUS enum) */
 void sldoa_setCodecStatus(void* const hSld, CODEC_STATUS newStatus);
 
+/** Destroys a #sldoa_codecState (once retired by the saf_rcu handle) */
+void sldoa_destroyCodecState(void** const phState);
+
 /**
  * Intialises the codec variables, based on current global/user parameters.
  *
@@ -153,18 +170,12 @@ void sldoa_setCodecStatus(void* const hSld, CODEC_STATUS newStatus);
  *          Spatially Localized Active-Intensity Vectors for Sound-Field
  *          Visualization. Journal of the Audio Engineering Society, 67(11),
  *          pp.840-854.
- */
-void sldoa_initAna(void* const hSld);
-    
-/**
- * Initialise the filterbank used by sldoa.
- *
- * @note Call this function before sldoa_initAna()
  *
- * Input Arguments:
- *     hSld - sldoa handle
+ * @param[in]  hSld  sldoa handle
+ * @param[out] state New (zero-initialised) codec state to fill in
  */
-void sldoa_initTFT(void* const hSld);
+void sldoa_initAna(void* const hSld,
+                   sldoa_codecState* state);
   
 /**
  * Estimates the DoA using the active intensity vectors derived from spatially
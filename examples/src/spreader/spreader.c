@@ -38,7 +38,7 @@ void spreader_create
 {
     spreader_data* pData = (spreader_data*)malloc1d(sizeof(spreader_data));
     *phSpr = (void*)pData;
-    int band, t, src;
+    int t;
 
     /* user parameters */
     pData->sofa_filepath = NULL;
@@ -49,8 +49,11 @@ void spreader_create
     memset(pData->src_spread, 0, SPREADER_MAX_NUM_SOURCES*sizeof(float));
     memset(pData->src_dirs_deg, 0, SPREADER_MAX_NUM_SOURCES*2*sizeof(float));
 
-    /* time-frequency transform + buffers */
-    pData->hSTFT = NULL;
+    /* time-frequency transform + buffers (the afSTFT is created for the maximum
+     * number of channels, and only the current number of sources and outputs
+     * are then transformed by spreader_process(); therefore, a new
+     * configuration does not require any re-allocation) */
+    afSTFT_create(&(pData->hSTFT), MAX_NUM_INPUTS, MAX_NUM_OUTPUTS, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
     pData->inputFrameTD = (float**)malloc2d(MAX_NUM_INPUTS, SPREADER_FRAME_SIZE, sizeof(float));
     pData->outframeTD = (float**)malloc2d(MAX_NUM_OUTPUTS, SPREADER_FRAME_SIZE, sizeof(float));
     pData->inputframeTF = (float_complex***)malloc3d(HYBRID_BANDS, MAX_NUM_INPUTS, TIME_SLOTS, sizeof(float_complex));
@@ -63,38 +66,12 @@ void spreader_create
     pData->Q = pData->nGrid = pData->h_len = 0;
     pData->h_fs = 0.0f;
     pData->h_grid = NULL;
-    pData->H_grid = NULL;
-    for(band=0; band<HYBRID_BANDS; band++)
-        pData->HHH[band] = NULL;
     pData->grid_dirs_deg = NULL;
-    pData->grid_dirs_xyz = NULL;
-    pData->weights = NULL;
-    pData->angles = NULL;
-    for(src=0; src<SPREADER_MAX_NUM_SOURCES; src++){
-        pData->hDecor[src] = NULL;
-        pData->Cy[src] = NULL;
-        pData->Cproto[src] = NULL;
-        pData->prev_M[src] = NULL;
-        pData->prev_Mr[src] = NULL;
-        pData->dirActive[src] = NULL;
-    }
-    pData->new_M = NULL;
-    pData->new_Mr = NULL;
-    pData->interp_M = NULL;
-    pData->interp_Mr = NULL;
-    pData->interp_Mr_cmplx = NULL;
     for(t=0; t<TIME_SLOTS; t++){
         pData->interpolatorFadeIn[t] = ((float)t+1.0f)/(float)TIME_SLOTS;
         pData->interpolatorFadeOut[t] = 1.0f - ((float)t+1.0f)/(float)TIME_SLOTS;
     }
-
-    /* Optimal mixing */
-    pData->hCdf = NULL;
-    pData->hCdf_res = NULL;
-    pData->Qmix = NULL;
-    pData->Qmix_cmplx = NULL;
-    pData->Cr = NULL;
-    pData->Cr_cmplx = NULL;
+    saf_rcu_create(&(pData->hCodecState), spreader_destroyCodecState);
 
     /* flags/status */
     pData->new_procMode = pData->procMode;
@@ -103,7 +80,7 @@ void spreader_create
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    pData->initialisingFLAG = 0;
 }
 
 void spreader_destroy
@@ -112,18 +89,15 @@ void spreader_destroy
 )
 {
     spreader_data *pData = (spreader_data*)(*phSpr);
-    int band, src;
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free memory during intialisation (note that the host
+         * must not call this function during the processing loop) */
+        while (saf_atomic_load(&(pData->initialisingFLAG)))
             SAF_SLEEP(10);
-        }
         
         /* free afSTFT and buffers */
-        if(pData->hSTFT !=NULL)
-            afSTFT_destroy(&(pData->hSTFT));
+        afSTFT_destroy(&(pData->hSTFT));
         free(pData->inputFrameTD);
         free(pData->outframeTD);
         free(pData->inputframeTF);
@@ -132,35 +106,9 @@ void spreader_destroy
         free(pData->outputframeTF);
 
         /* internal */
+        saf_rcu_destroy(&(pData->hCodecState));
         free(pData->h_grid);
-        free(pData->H_grid);
-        for(band=0; band<HYBRID_BANDS; band++)
-            free(pData->HHH[band]);
         free(pData->grid_dirs_deg);
-        free(pData->grid_dirs_xyz);
-        free(pData->weights);
-        free(pData->angles);
-        for(src=0; src<SPREADER_MAX_NUM_SOURCES; src++){
-            latticeDecorrelator_destroy(&(pData->hDecor[src]));
-            free(pData->Cy[src]);
-            free(pData->Cproto[src]);
-            free(pData->prev_M[src]);
-            free(pData->prev_Mr[src]);
-            free(pData->dirActive[src]);
-        }
-        free(pData->new_M);
-        free(pData->new_Mr);
-        free(pData->interp_M);
-        free(pData->interp_Mr);
-        free(pData->interp_Mr_cmplx);
-
-        /* Optimal mixing */
-        cdf4sap_cmplx_destroy(&(pData->hCdf));
-        cdf4sap_destroy(&(pData->hCdf_res));
-        free(pData->Qmix);
-        free(pData->Qmix_cmplx);
-        free(pData->Cr);
-        free(pData->Cr_cmplx);
 
         free(pData->progressBarText);
          
@@ -188,7 +136,9 @@ void spreader_initCodec
 )
 {
     spreader_data *pData = (spreader_data*)(hSpr);
+    spreader_codecState* state;
     int q, band, ng, nSources, src;
+    float* weights;
     float_complex scaleC;
 #ifdef SAF_ENABLE_SOFA_READER_MODULE
     saf_sofa_container sofa;
@@ -198,19 +148,21 @@ void spreader_initCodec
     float_complex H_tmp[MAX_NUM_CHANNELS];
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
 
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    if (saf_atomic_load(&(pData->codecStatus)) != CODEC_STATUS_NOT_INITIALISED)
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
+    if (!saf_atomic_compareExchange(&(pData->initialisingFLAG), 0, 1))
+        return; /* already happening on another thread */
+    if (!saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING)){
+        saf_atomic_store(&(pData->initialisingFLAG), 0);
+        return;
     }
+    /* Note that the processing loop is not paused; it carries on with the
+     * previous configuration until the new one is ready */
 
     nSources = pData->new_nSources;
     procMode = pData->new_procMode;
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
 
@@ -253,86 +205,82 @@ void spreader_initCodec
 
     /* Convert from the 0..360 convention, to -180..180, and pre-compute unit Cartesian vectors */
     convert_0_360To_m180_180(pData->grid_dirs_deg, pData->nGrid);
-    pData->grid_dirs_xyz = realloc1d(pData->grid_dirs_xyz, pData->nGrid*3*sizeof(float));
-    unitSph2cart(pData->grid_dirs_deg, pData->nGrid, 1, pData->grid_dirs_xyz);
-
-    /* Initialise time-frequency transform and decorrelators */
-    afSTFT_destroy(&(pData->hSTFT));
-    afSTFT_create(&(pData->hSTFT), nSources, pData->Q, HOP_SIZE, 0, 1, AFSTFT_BANDS_CH_TIME);
+    state = (spreader_codecState*)calloc1d(1, sizeof(spreader_codecState));
+    state->nSources = nSources;
+    state->procMode = procMode;
+    state->Q = pData->Q;
+    state->nGrid = pData->nGrid;
+    state->grid_dirs_xyz = malloc1d(pData->nGrid*3*sizeof(float));
+    unitSph2cart(pData->grid_dirs_deg, pData->nGrid, 1, state->grid_dirs_xyz);
+
+    /* Initialise decorrelators */
     int orders[4] = {20, 15, 6, 6}; /* 20th order up to 700Hz, 15th->2.4kHz, 6th->4kHz, 3rd->12kHz, NONE(only delays)->Nyquist */
     //float freqCutoffs[4] = {600.0f, 2.6e3f, 4.5e3f, 12e3f};
     float freqCutoffs[4] = {900.0f, 6.8e3f, 12e3f, 24e3f};
     const int maxDelay = 12;
-    for(src=0; src<SPREADER_MAX_NUM_SOURCES; src++){
-        latticeDecorrelator_destroy(&(pData->hDecor[src]));
-        latticeDecorrelator_create(&(pData->hDecor[src]), (float)pData->fs, HOP_SIZE, pData->freqVector, HYBRID_BANDS, pData->Q, orders, freqCutoffs, 4, maxDelay, 0, 0.75f);
-    }
+    for(src=0; src<SPREADER_MAX_NUM_SOURCES; src++)
+        latticeDecorrelator_create(&(state->hDecor[src]), (float)pData->fs, HOP_SIZE, pData->freqVector, HYBRID_BANDS, pData->Q, orders, freqCutoffs, 4, maxDelay, 0, 0.75f);
 
     /* Convert to filterbank coefficients and pre-compute outer products */
-    pData->H_grid = realloc1d(pData->H_grid, HYBRID_BANDS*(pData->Q)*pData->nGrid*sizeof(float_complex));
-    afSTFT_FIRtoFilterbankCoeffs(pData->h_grid, pData->nGrid, pData->Q, pData->h_len, HOP_SIZE, 0, 1, pData->H_grid);
-    pData->weights = realloc1d(pData->weights, pData->nGrid*sizeof(float));
-    getVoronoiWeights(pData->grid_dirs_deg, pData->nGrid, 0, pData->weights);
-    cblas_sscal(pData->nGrid, 1.0f/FOURPI, pData->weights, 1);
+    state->H_grid = malloc1d(HYBRID_BANDS*(pData->Q)*pData->nGrid*sizeof(float_complex));
+    afSTFT_FIRtoFilterbankCoeffs(pData->h_grid, pData->nGrid, pData->Q, pData->h_len, HOP_SIZE, 0, 1, state->H_grid);
+    weights = malloc1d(pData->nGrid*sizeof(float));
+    getVoronoiWeights(pData->grid_dirs_deg, pData->nGrid, 0, weights);
+    cblas_sscal(pData->nGrid, 1.0f/FOURPI, weights, 1);
     for(band=0; band<HYBRID_BANDS; band++){
-        pData->HHH[band] = (float_complex**)realloc2d((void**)pData->HHH[band], pData->nGrid, pData->Q * (pData->Q), sizeof(float_complex));
+        state->HHH[band] = (float_complex**)malloc2d(pData->nGrid, pData->Q * (pData->Q), sizeof(float_complex));
         for(ng=0; ng<pData->nGrid; ng++){
             for(q=0; q<pData->Q; q++)
-                H_tmp[q] = pData->H_grid[band*(pData->Q)*pData->nGrid + q*pData->nGrid + ng];
+                H_tmp[q] = state->H_grid[band*(pData->Q)*pData->nGrid + q*pData->nGrid + ng];
             cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, pData->Q, pData->Q, 1, &calpha,
                         H_tmp, 1,
                         H_tmp, 1, &cbeta,
-                        pData->HHH[band][ng], pData->Q);
-            scaleC = cmplxf(pData->weights[ng], 0.0f);
-            cblas_cscal(pData->Q * (pData->Q), &scaleC, pData->HHH[band][ng], 1);
+                        state->HHH[band][ng], pData->Q);
+            scaleC = cmplxf(weights[ng], 0.0f);
+            cblas_cscal(pData->Q * (pData->Q), &scaleC, state->HHH[band][ng], 1);
         }
     }
-    pData->angles = realloc1d(pData->angles, pData->nGrid*sizeof(float));
+    free(weights);
+    state->angles = malloc1d(pData->nGrid*sizeof(float));
 
     /* OM structures */
-    cdf4sap_cmplx_destroy(&(pData->hCdf));
-    cdf4sap_cmplx_create(&(pData->hCdf), pData->Q, pData->Q);
-    cdf4sap_destroy(&(pData->hCdf_res));
-    cdf4sap_create(&(pData->hCdf_res), pData->Q, pData->Q);
-    pData->Qmix = realloc1d(pData->Qmix, pData->Q*(pData->Q)*sizeof(float));
-    memset(pData->Qmix, 0, pData->Q*(pData->Q)*sizeof(float));
-    pData->Qmix_cmplx = realloc1d(pData->Qmix_cmplx, pData->Q*(pData->Q)*sizeof(float_complex));
-    memset(pData->Qmix_cmplx, 0, pData->Q*(pData->Q)*sizeof(float_complex));
+    cdf4sap_cmplx_batch_create(&(state->hCdf), pData->Q, pData->Q);
+    cdf4sap_batch_create(&(state->hCdf_res), pData->Q, pData->Q);
+    state->Qmix = calloc1d(pData->Q*(pData->Q), sizeof(float));
+    state->Qmix_cmplx = calloc1d(pData->Q*(pData->Q), sizeof(float_complex));
     for(q=0; q<pData->Q; q++){
-        pData->Qmix[q*(pData->Q)+q] = 1.0f;
-        pData->Qmix_cmplx[q*(pData->Q)+q] = cmplxf(1.0f, 0.0f);
+        state->Qmix[q*(pData->Q)+q] = 1.0f;
+        state->Qmix_cmplx[q*(pData->Q)+q] = cmplxf(1.0f, 0.0f);
     }
-    pData->Cr = realloc1d(pData->Cr, pData->Q*(pData->Q)*sizeof(float));
-    pData->Cr_cmplx = realloc1d(pData->Cr_cmplx, pData->Q*(pData->Q)*sizeof(float_complex));
+    state->Cr = malloc1d(HYBRID_BANDS*(pData->Q)*(pData->Q)*sizeof(float));
+    state->Cr_cmplx = malloc1d(HYBRID_BANDS*(pData->Q)*(pData->Q)*sizeof(float_complex));
+    state->Cp = malloc1d(HYBRID_BANDS*(pData->Q)*(pData->Q)*sizeof(float_complex));
+    state->CpDiag = malloc1d(HYBRID_BANDS*(pData->Q)*(pData->Q)*sizeof(float));
 
     /* mixing matrices and buffers */
     for(src=0; src<SPREADER_MAX_NUM_SOURCES; src++){
-        pData->Cy[src] = (float_complex**)realloc2d((void**)pData->Cy[src], HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float_complex));
-        memset(FLATTEN2D(pData->Cy[src]), 0, HYBRID_BANDS * (pData->Q)*(pData->Q) * sizeof(float_complex));
-        pData->Cproto[src] = (float_complex**)realloc2d((void**)pData->Cproto[src], HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float_complex));
-        memset(FLATTEN2D(pData->Cproto[src]), 0, HYBRID_BANDS * (pData->Q)*(pData->Q) * sizeof(float_complex));
-        pData->prev_M[src] = (float_complex**)realloc2d((void**)pData->prev_M[src], HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float_complex));
-        memset(FLATTEN2D(pData->prev_M[src]), 0, HYBRID_BANDS * (pData->Q)*(pData->Q) * sizeof(float_complex));
-        pData->prev_Mr[src] = (float**)realloc2d((void**)pData->prev_Mr[src], HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float));
-        memset(FLATTEN2D(pData->prev_Mr[src]), 0, HYBRID_BANDS * (pData->Q)*(pData->Q) * sizeof(float));
-        pData->dirActive[src] = realloc1d(pData->dirActive[src], pData->nGrid * sizeof(int));
-        memset(pData->dirActive[src], 0, pData->nGrid*sizeof(int));
+        state->Cy[src] = (float_complex**)calloc2d(HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float_complex));
+        state->Cproto[src] = (float_complex**)calloc2d(HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float_complex));
+        state->prev_M[src] = (float_complex**)calloc2d(HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float_complex));
+        state->prev_Mr[src] = (float**)calloc2d(HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float));
+        state->dirActive[src] = calloc1d(pData->nGrid, sizeof(int));
     }
-    pData->new_M = (float_complex**)realloc2d((void**)pData->new_M, HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float_complex));
-    pData->new_Mr = (float**)realloc2d((void**)pData->new_Mr, HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float));
-    pData->interp_M = realloc1d(pData->interp_M, (pData->Q)*(pData->Q) * sizeof(float_complex));
-    pData->interp_Mr = realloc1d(pData->interp_Mr, (pData->Q)*(pData->Q) * sizeof(float));
-    pData->interp_Mr_cmplx = realloc1d(pData->interp_Mr_cmplx, (pData->Q)*(pData->Q) * sizeof(float_complex));
-    memset(pData->interp_Mr_cmplx, 0, (pData->Q)*(pData->Q) * sizeof(float_complex));
-
-    /* New config */
+    state->new_M = (float_complex**)malloc2d(HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float_complex));
+    state->new_Mr = (float**)malloc2d(HYBRID_BANDS, (pData->Q)*(pData->Q), sizeof(float));
+    state->interp_M = malloc1d((pData->Q)*(pData->Q) * sizeof(float_complex));
+    state->interp_Mr = malloc1d((pData->Q)*(pData->Q) * sizeof(float));
+    state->interp_Mr_cmplx = calloc1d((pData->Q)*(pData->Q), sizeof(float_complex));
+
+    /* New config (handed over to the processing thread) */
     pData->nSources = nSources;
     pData->procMode = procMode;
+    saf_rcu_publish(pData->hCodecState, (void*)state);
 
-    /* done! */
+    /* done! (unless a re-init was requested in the meantime) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchange(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
+    saf_atomic_store(&(pData->initialisingFLAG), 0);
 }
 
 void spreader_process
@@ -346,30 +294,28 @@ void spreader_process
 )
 {
     spreader_data *pData = (spreader_data*)(hSpr);
-    int q, src, ng, ch, i, j, band, t, nSources, Q, centre_ind, nSpread;
+    spreader_codecState* state;
+    int q, src, ng, ch, i, j, band, t, nSources, Q, centre_ind, nSpread, nSpreadBands, ticket;
     float trace, Ey, Eproto, Gcomp;
-    float src_dirs_deg[SPREADER_MAX_NUM_SOURCES][2], src_dir_xyz[3], CprotoDiag[MAX_NUM_OUTPUTS*MAX_NUM_OUTPUTS], src_spread[MAX_NUM_OUTPUTS];
+    float src_dirs_deg[SPREADER_MAX_NUM_SOURCES][2], src_dir_xyz[3], src_spread[MAX_NUM_OUTPUTS];
     float_complex scaleC, tmp;
     float_complex tmpFrame[MAX_NUM_CHANNELS][TIME_SLOTS], H_tmp[MAX_NUM_CHANNELS], Cy[MAX_NUM_CHANNELS*MAX_NUM_CHANNELS];
     float_complex E_dir[MAX_NUM_CHANNELS*MAX_NUM_CHANNELS], V[MAX_NUM_OUTPUTS*MAX_NUM_OUTPUTS], D[MAX_NUM_OUTPUTS*MAX_NUM_OUTPUTS];
     float_complex Cproto[MAX_NUM_OUTPUTS*MAX_NUM_OUTPUTS];
-#if 0
-    float_complex Cx[MAX_NUM_OUTPUTS*MAX_NUM_OUTPUTS];
-    float CxDiag[MAX_NUM_OUTPUTS*MAX_NUM_OUTPUTS];
-#endif
     SPREADER_PROC_MODES procMode;
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
 
-    /* copy user parameters to local variables */
-    procMode = pData->procMode;
-    nSources = pData->nSources;
-    Q = pData->Q;
-    memcpy((float*)src_dirs_deg, pData->src_dirs_deg, nSources*2*sizeof(float));
-    memcpy((float*)src_spread, pData->src_spread, nSources*sizeof(float));
+    /* Current configuration (NULL until the first initialisation is complete) */
+    state = (spreader_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
 
     /* apply binaural panner */
-    if ((nSamples == SPREADER_FRAME_SIZE) && (pData->codecStatus==CODEC_STATUS_INITIALISED) ){
-        pData->procStatus = PROC_STATUS_ONGOING;
+    if ((nSamples == SPREADER_FRAME_SIZE) && (state!=NULL)){
+        /* copy user parameters to local variables */
+        procMode = state->procMode;
+        nSources = state->nSources;
+        Q = state->Q;
+        memcpy((float*)src_dirs_deg, pData->src_dirs_deg, nSources*2*sizeof(float));
+        memcpy((float*)src_spread, pData->src_spread, nSources*sizeof(float));
 
         /* Load time-domain data */
         for(i=0; i < SAF_MIN(nSources,nInputs); i++)
@@ -378,7 +324,7 @@ void spreader_process
             memset(pData->inputFrameTD[i], 0, SPREADER_FRAME_SIZE * sizeof(float));
 
         /* Apply time-frequency transform (TFT) */
-        afSTFT_forward_knownDimensions(pData->hSTFT, pData->inputFrameTD, SPREADER_FRAME_SIZE, MAX_NUM_INPUTS, TIME_SLOTS, pData->inputframeTF);
+        afSTFT_forward_knownDimensions_nCH(pData->hSTFT, pData->inputFrameTD, SPREADER_FRAME_SIZE, MAX_NUM_INPUTS, TIME_SLOTS, nSources, pData->inputframeTF);
 
         /* Zero output buffer */
         for(band=0; band<HYBRID_BANDS; band++)
@@ -388,13 +334,13 @@ void spreader_process
         for(src=0; src<nSources; src++){
             /* Find the "spread" indices */
             unitSph2cart(src_dirs_deg[src], 1, 1, src_dir_xyz);
-            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pData->nGrid, 1, 3, 1.0f,
-                        pData->grid_dirs_xyz, 3,
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, state->nGrid, 1, 3, 1.0f,
+                        state->grid_dirs_xyz, 3,
                         src_dir_xyz, 1, 0.0f,
-                        pData->angles, 1);
-            for(i=0; i<pData->nGrid; i++)
-                pData->angles[i] = acosf(SAF_MIN(pData->angles[i], 0.9999999f))*180.0f/SAF_PI;
-            utility_siminv(pData->angles, pData->nGrid, &centre_ind);
+                        state->angles, 1);
+            for(i=0; i<state->nGrid; i++)
+                state->angles[i] = acosf(SAF_MIN(state->angles[i], 0.9999999f))*180.0f/SAF_PI;
+            utility_siminv(state->angles, state->nGrid, &centre_ind);
 
             /* Define Prototype signals */
              switch(procMode){
@@ -404,15 +350,15 @@ void spreader_process
                         if(pData->freqVector[band]<MAX_SPREAD_FREQ){
                             /* Loop over all angles, and sum the H_grid's within the spreading area */
                             memset(H_tmp, 0, Q*sizeof(float_complex));
-                            for(ng=0,nSpread=0; ng<pData->nGrid; ng++){
-                                if(pData->angles[ng] <= (src_spread[src]/2.0f)){
+                            for(ng=0,nSpread=0; ng<state->nGrid; ng++){
+                                if(state->angles[ng] <= (src_spread[src]/2.0f)){
                                     for(q=0; q<Q; q++)
-                                        H_tmp[q] = ccaddf(H_tmp[q], pData->H_grid[band*Q*pData->nGrid + q*pData->nGrid + ng]);
+                                        H_tmp[q] = ccaddf(H_tmp[q], state->H_grid[band*Q*state->nGrid + q*state->nGrid + ng]);
                                     nSpread++;
-                                    pData->dirActive[src][ng] = 1;
+                                    state->dirActive[src][ng] = 1;
                                 }
                                 else
-                                    pData->dirActive[src][ng] = 0;
+                                    state->dirActive[src][ng] = 0;
                             }
                         }
                         else
@@ -421,7 +367,7 @@ void spreader_process
                         /* If no directions found in the spread area, then just include the nearest one */
                         if(nSpread==0){
                             for(q=0; q<Q; q++)
-                                H_tmp[q] = pData->H_grid[band*Q*pData->nGrid + q*pData->nGrid + centre_ind];
+                                H_tmp[q] = state->H_grid[band*Q*state->nGrid + q*state->nGrid + centre_ind];
                             nSpread=1;
                         }
 
@@ -440,7 +386,7 @@ void spreader_process
                      /* Use the centre direction as the prototype */
                      for(band=0; band<HYBRID_BANDS; band++){
                          for(q=0; q<Q; q++)
-                             H_tmp[q] = pData->H_grid[band*Q*pData->nGrid + q*pData->nGrid + centre_ind];
+                             H_tmp[q] = state->H_grid[band*Q*state->nGrid + q*state->nGrid + centre_ind];
                          cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, Q, TIME_SLOTS, 1, &calpha,
                                      H_tmp, 1,
                                      pData->inputframeTF[band][src], TIME_SLOTS, &cbeta,
@@ -465,7 +411,7 @@ void spreader_process
             }
             else{
                 /* Apply decorrelation of prototype signals */
-                latticeDecorrelator_apply(pData->hDecor[src], pData->protoframeTF, TIME_SLOTS, pData->decorframeTF);
+                latticeDecorrelator_apply(state->hDecor[src], pData->protoframeTF, TIME_SLOTS, pData->decorframeTF);
 
                 /* Compute prototype covariance matrix and average over time */
                 for(band=0; band<HYBRID_BANDS; band++){
@@ -473,8 +419,8 @@ void spreader_process
                                 FLATTEN2D(pData->protoframeTF[band]), TIME_SLOTS,
                                 FLATTEN2D(pData->protoframeTF[band]), TIME_SLOTS, &cbeta,
                                 Cproto, Q);
-                    cblas_sscal(/*re+im*/2*Q*Q, pData->covAvgCoeff, (float*)pData->Cproto[src][band], 1);
-                    cblas_saxpy(/*re+im*/2*Q*Q, 1.0f-pData->covAvgCoeff, (float*)Cproto, 1, (float*)pData->Cproto[src][band], 1);
+                    cblas_sscal(/*re+im*/2*Q*Q, pData->covAvgCoeff, (float*)state->Cproto[src][band], 1);
+                    cblas_saxpy(/*re+im*/2*Q*Q, 1.0f-pData->covAvgCoeff, (float*)Cproto, 1, (float*)state->Cproto[src][band], 1);
                 }
 
                 /* Define target covariance matrices */
@@ -483,16 +429,16 @@ void spreader_process
                     if(pData->freqVector[band]<MAX_SPREAD_FREQ){
                         memset(Cy, 0, Q*Q*sizeof(float_complex));
                         memset(H_tmp, 0, Q*sizeof(float_complex));
-                        for(ng=0, nSpread=0; ng<pData->nGrid; ng++){
-                            if(pData->angles[ng] <= (src_spread[src]/2.0f)){
-                                cblas_caxpy(Q*Q, &calpha, pData->HHH[band][ng], 1, Cy, 1);
+                        for(ng=0, nSpread=0; ng<state->nGrid; ng++){
+                            if(state->angles[ng] <= (src_spread[src]/2.0f)){
+                                cblas_caxpy(Q*Q, &calpha, state->HHH[band][ng], 1, Cy, 1);
                                 for(q=0; q<Q; q++)
-                                    H_tmp[q] = ccaddf(H_tmp[q], pData->H_grid[band*Q*pData->nGrid + q*pData->nGrid + ng]);
+                                    H_tmp[q] = ccaddf(H_tmp[q], state->H_grid[band*Q*state->nGrid + q*state->nGrid + ng]);
                                 nSpread++;
-                                pData->dirActive[src][ng] = 1;
+                                state->dirActive[src][ng] = 1;
                             }
                             else
-                                pData->dirActive[src][ng] = 0;
+                                state->dirActive[src][ng] = 0;
                         }
                     }
                     else
@@ -500,9 +446,9 @@ void spreader_process
 
                     /* If no directions found in the spread area, then just include the nearest one */
                     if(nSpread==0) {
-                        cblas_caxpy(Q*Q, &calpha, pData->HHH[band][centre_ind], 1, Cy, 1);
+                        cblas_caxpy(Q*Q, &calpha, state->HHH[band][centre_ind], 1, Cy, 1);
                         for(q=0; q<Q; q++)
-                            H_tmp[q] = pData->H_grid[band*Q*pData->nGrid + q*pData->nGrid + centre_ind];
+                            H_tmp[q] = state->H_grid[band*Q*state->nGrid + q*state->nGrid + centre_ind];
                         nSpread++;
                     }
 #if 1
@@ -516,7 +462,7 @@ void spreader_process
 
                         /* Compute signals for the centre of the spread */
                         for(q=0; q<Q; q++)
-                            H_tmp[q] = pData->H_grid[band*Q*pData->nGrid + q*pData->nGrid + centre_ind];
+                            H_tmp[q] = state->H_grid[band*Q*state->nGrid + q*state->nGrid + centre_ind];
                         cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, Q, TIME_SLOTS, 1, &calpha,
                                     H_tmp, 1,
                                     pData->inputframeTF[band][src], TIME_SLOTS, &cbeta,
@@ -534,8 +480,8 @@ void spreader_process
                     }
 #endif
                     /* Average over time */
-                    cblas_sscal(/*re+im*/2*Q*Q, pData->covAvgCoeff, (float*)pData->Cy[src][band], 1);
-                    cblas_saxpy(/*re+im*/2*Q*Q, 1.0f-pData->covAvgCoeff, (float*)Cy, 1, (float*)pData->Cy[src][band], 1);
+                    cblas_sscal(/*re+im*/2*Q*Q, pData->covAvgCoeff, (float*)state->Cy[src][band], 1);
+                    cblas_saxpy(/*re+im*/2*Q*Q, 1.0f-pData->covAvgCoeff, (float*)Cy, 1, (float*)state->Cy[src][band], 1);
                 }
 
                 /* Formulate mixing matrices */
@@ -546,15 +492,15 @@ void spreader_process
                         Ey = Eproto = 0.0f;
                         for(band=0; band<HYBRID_BANDS; band++){
                             for(i=0; i<Q; i++){
-                                Ey += crealf(pData->Cy[src][band][i*Q+i]);
-                                Eproto += crealf(pData->Cproto[src][band][i*Q+i])+0.000001f;
+                                Ey += crealf(state->Cy[src][band][i*Q+i]);
+                                Eproto += crealf(state->Cproto[src][band][i*Q+i])+0.000001f;
                             }
                         }
                         Gcomp = sqrtf(Eproto/(Ey+2.23e-9f));
 
                         /* Compute mixing matrix per band */
                         for(band=0; band<HYBRID_BANDS; band++){
-                            memcpy(Cy, pData->Cy[src][band], Q*Q*sizeof(float_complex));
+                            memcpy(Cy, state->Cy[src][band], Q*Q*sizeof(float_complex));
                             cblas_sscal(/*re+im*/2*Q*Q, Gcomp, (float*)Cy, 1);
                             utility_cseig(NULL, Cy, Q, 1, V, D, NULL);
                             for(i=0; i<Q; i++)
@@ -563,52 +509,33 @@ void spreader_process
                             cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, Q, Q, Q, &calpha,
                                         V, Q,
                                         D, Q, &cbeta,
-                                        pData->new_M[band], Q);
+                                        state->new_M[band], Q);
                         }
                         break;
 
                     case SPREADER_MODE_OM:
-                        for(band=0; band<HYBRID_BANDS; band++){
-                            if(pData->freqVector[band]<MAX_SPREAD_FREQ){
-#if 1
-                                /* Diagonalise and diagonally load the Cproto matrices */
-                                cblas_ccopy(Q*Q, pData->Cproto[src][band], 1, Cproto, 1);
-                                for(i=0; i<Q; i++){
-                                    for(j=0; j<Q; j++){
-                                        if(i==j)
-                                            Cproto[i*Q+i] = craddf(Cproto[i*Q+i], 0.00001f);
-                                        CprotoDiag[i*Q+j] = i==j ? crealf(Cproto[i*Q+i]) : 0.0f;
-                                    }
+                        /* Diagonalise and diagonally load the Cproto matrices
+                         * (spreading is only applied to the lower bands) */
+                        for(nSpreadBands=0; nSpreadBands<HYBRID_BANDS && pData->freqVector[nSpreadBands]<MAX_SPREAD_FREQ; nSpreadBands++){
+                            cblas_ccopy(Q*Q, state->Cproto[src][nSpreadBands], 1, &(state->Cp[nSpreadBands*Q*Q]), 1);
+                            for(i=0; i<Q; i++){
+                                for(j=0; j<Q; j++){
+                                    if(i==j)
+                                        state->Cp[nSpreadBands*Q*Q + i*Q+i] = craddf(state->Cp[nSpreadBands*Q*Q + i*Q+i], 0.00001f);
+                                    state->CpDiag[nSpreadBands*Q*Q + i*Q+j] = i==j ? crealf(state->Cp[nSpreadBands*Q*Q + i*Q+i]) : 0.0f;
                                 }
-
-                                /* Compute mixing matrices */
-                                formulate_M_and_Cr_cmplx(pData->hCdf, Cproto, pData->Cy[src][band], pData->Qmix_cmplx, 0, 0.2f, pData->new_M[band], pData->Cr_cmplx);
-                                for(i=0; i<Q*Q; i++)
-                                    pData->Cr[i] = crealf(pData->Cr_cmplx[i]);
-                                formulate_M_and_Cr(pData->hCdf_res, CprotoDiag, pData->Cr, pData->Qmix, 0, 0.2f, pData->new_Mr[band], NULL);
-#else
-                                for(q=0; q<Q; q++)
-                                    H_tmp[q] = pData->H_grid[band*Q*pData->nGrid + q*pData->nGrid + centre_ind];
-                                cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, Q, Q, 1, &calpha,
-                                            H_tmp, 1,
-                                            H_tmp, 1, &cbeta,
-                                            Cx, Q);
-                                memset(CxDiag, 0, Q*Q*sizeof(float));
-                                for(i=0; i<Q; i++)
-                                    CxDiag[i*Q+i] = crealf(Cx[i*Q+i]);
-
-                                /* Compute mixing matrices */
-                                formulate_M_and_Cr_cmplx(pData->hCdf, Cx, pData->Cy[src][band], pData->Qmix_cmplx, 0, 0.2f, pData->new_M[band], pData->Cr_cmplx);
-                                for(i=0; i<Q*Q; i++)
-                                    pData->Cr[i] = crealf(pData->Cr_cmplx[i]);
-                                formulate_M_and_Cr(pData->hCdf_res, CxDiag, pData->Cr, pData->Qmix, 0, 0.2f, pData->new_Mr[band], NULL);
-#endif
-                            }
-                            else{
-                                memcpy(pData->new_M[band], pData->Qmix_cmplx, Q*Q*sizeof(float_complex));
-                                memset(pData->new_Mr[band], 0, Q*Q*sizeof(float));
                             }
                         }
+
+                        /* Compute mixing matrices for all of these bands in one go */
+                        formulate_M_and_Cr_cmplx_batch(state->hCdf, nSpreadBands, state->Cp, FLATTEN2D(state->Cy[src]), state->Qmix_cmplx, 0, 0.2f, FLATTEN2D(state->new_M), state->Cr_cmplx);
+                        for(i=0; i<nSpreadBands*Q*Q; i++)
+                            state->Cr[i] = crealf(state->Cr_cmplx[i]);
+                        formulate_M_and_Cr_batch(state->hCdf_res, nSpreadBands, state->CpDiag, state->Cr, state->Qmix, 0, 0.2f, FLATTEN2D(state->new_Mr), NULL);
+                        for(band=nSpreadBands; band<HYBRID_BANDS; band++){
+                            memcpy(state->new_M[band], state->Qmix_cmplx, Q*Q*sizeof(float_complex));
+                            memset(state->new_Mr[band], 0, Q*Q*sizeof(float));
+                        }
                         break;
                 }
 
@@ -616,10 +543,10 @@ void spreader_process
                 for(band=0; band<HYBRID_BANDS; band++){
                     for(t=0; t<TIME_SLOTS; t++){
                         scaleC = cmplxf(pData->interpolatorFadeIn[t], 0.0f);
-                        utility_cvsmul(pData->new_M[band], &scaleC, Q*Q, pData->interp_M);
-                        cblas_saxpy(/*re+im*/2*Q*Q, pData->interpolatorFadeOut[t], (float*)pData->prev_M[src][band], 1, (float*)pData->interp_M, 1);
+                        utility_cvsmul(state->new_M[band], &scaleC, Q*Q, state->interp_M);
+                        cblas_saxpy(/*re+im*/2*Q*Q, pData->interpolatorFadeOut[t], (float*)state->prev_M[src][band], 1, (float*)state->interp_M, 1);
                         for(i=0; i<Q; i++) {
-                            cblas_cdotu_sub(Q, (float_complex*)(&(pData->interp_M[i*Q])), 1,
+                            cblas_cdotu_sub(Q, (float_complex*)(&(state->interp_M[i*Q])), 1,
                                             FLATTEN2D((procMode == SPREADER_MODE_EVD ? pData->decorframeTF[band] : pData->protoframeTF[band])) + t,
                                             TIME_SLOTS, &(pData->spreadframeTF[band][i][t]));
                         }
@@ -629,11 +556,11 @@ void spreader_process
                     if(procMode == SPREADER_MODE_OM){
                         if(pData->freqVector[band]<MAX_SPREAD_FREQ){
                             for(t=0; t<TIME_SLOTS; t++){
-                                utility_svsmul(pData->new_Mr[band], &(pData->interpolatorFadeIn[t]), Q*Q, pData->interp_Mr);
-                                cblas_saxpy(Q*Q, pData->interpolatorFadeOut[t], pData->prev_Mr[src][band], 1, pData->interp_Mr, 1);
-                                cblas_scopy(Q*Q, pData->interp_Mr, 1, (float*)pData->interp_Mr_cmplx, 2);
+                                utility_svsmul(state->new_Mr[band], &(pData->interpolatorFadeIn[t]), Q*Q, state->interp_Mr);
+                                cblas_saxpy(Q*Q, pData->interpolatorFadeOut[t], state->prev_Mr[src][band], 1, state->interp_Mr, 1);
+                                cblas_scopy(Q*Q, state->interp_Mr, 1, (float*)state->interp_Mr_cmplx, 2);
                                 for(i=0; i<Q; i++){
-                                    cblas_cdotu_sub(Q, (float_complex*)(&(pData->interp_Mr_cmplx[i*Q])), 1, FLATTEN2D(pData->decorframeTF[band]) + t, TIME_SLOTS, &tmp);
+                                    cblas_cdotu_sub(Q, (float_complex*)(&(state->interp_Mr_cmplx[i*Q])), 1, FLATTEN2D(pData->decorframeTF[band]) + t, TIME_SLOTS, &tmp);
                                     pData->spreadframeTF[band][i][t] = ccaddf(pData->spreadframeTF[band][i][t], tmp);
                                 }
                             }
@@ -647,12 +574,12 @@ void spreader_process
                 cblas_saxpy(/*re+im*/2*Q*TIME_SLOTS, 1.0f, (float*)FLATTEN2D(pData->spreadframeTF[band]), 1, (float*)FLATTEN2D(pData->outputframeTF[band]), 1);
 
             /* For next frame */
-            cblas_ccopy(HYBRID_BANDS*Q*Q, FLATTEN2D(pData->new_M), 1, FLATTEN2D(pData->prev_M[src]), 1);
-            cblas_scopy(HYBRID_BANDS*Q*Q, FLATTEN2D(pData->new_Mr), 1, FLATTEN2D(pData->prev_Mr[src]), 1);
+            cblas_ccopy(HYBRID_BANDS*Q*Q, FLATTEN2D(state->new_M), 1, FLATTEN2D(state->prev_M[src]), 1);
+            cblas_scopy(HYBRID_BANDS*Q*Q, FLATTEN2D(state->new_Mr), 1, FLATTEN2D(state->prev_Mr[src]), 1);
         }
 
         /* inverse-TFT */
-        afSTFT_backward_knownDimensions(pData->hSTFT, pData->outputframeTF, SPREADER_FRAME_SIZE, MAX_NUM_OUTPUTS, TIME_SLOTS, pData->outframeTD);
+        afSTFT_backward_knownDimensions_nCH(pData->hSTFT, pData->outputframeTF, SPREADER_FRAME_SIZE, MAX_NUM_OUTPUTS, TIME_SLOTS, Q, pData->outframeTD);
 
         /* Copy to output buffer */
         for (ch = 0; ch < SAF_MIN(Q, nOutputs); ch++)
@@ -665,7 +592,7 @@ void spreader_process
             memset(outputs[ch],0, SPREADER_FRAME_SIZE*sizeof(float));
     }
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_rcu_release(pData->hCodecState, ticket);
 }
 
 /* Set Functions */
@@ -757,7 +684,7 @@ int spreader_getFrameSize(void)
 CODEC_STATUS spreader_getCodecStatus(void* const hSpr)
 {
     spreader_data *pData = (spreader_data*)(hSpr);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_load(&(pData->codecStatus));
 }
 
 float spreader_getProgressBar0_1(void* const hSpr)
@@ -775,7 +702,15 @@ void spreader_getProgressBarText(void* const hSpr, char* text)
 int* spreader_getDirectionActivePtr(void* const hSpr, int index)
 {
     spreader_data *pData = (spreader_data*)(hSpr);
-    return pData->dirActive[index];
+    spreader_codecState* state;
+    int* dirActive;
+    int ticket;
+
+    /* (the returned pointer remains valid until the next re-initialisation) */
+    state = (spreader_codecState*)saf_rcu_acquire(pData->hCodecState, &ticket);
+    dirActive = state!=NULL ? state->dirActive[index] : NULL;
+    saf_rcu_release(pData->hCodecState, ticket);
+    return dirActive;
 }
 
 int spreader_getSpreadingMode(void* const hSpr)
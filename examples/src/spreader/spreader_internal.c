@@ -34,12 +34,50 @@
 void spreader_setCodecStatus(void* const hSpr, CODEC_STATUS newStatus)
 {
     spreader_data *pData = (spreader_data*)(hSpr);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    /* No need to wait for any ongoing initialisation to complete; it will not
+     * mark the codec as initialised once it is done, and so
+     * spreader_initCodec() will simply run again */
+    saf_atomic_store(&(pData->codecStatus), (int)newStatus);
+}
+
+void spreader_destroyCodecState(void** const phState)
+{
+    spreader_codecState *state = (spreader_codecState*)(*phState);
+    int band, src;
+
+    if(state!=NULL){
+        free(state->H_grid);
+        for(band=0; band<HYBRID_BANDS; band++)
+            free(state->HHH[band]);
+        free(state->grid_dirs_xyz);
+        free(state->angles);
+        for(src=0; src<SPREADER_MAX_NUM_SOURCES; src++){
+            latticeDecorrelator_destroy(&(state->hDecor[src]));
+            free(state->Cy[src]);
+            free(state->Cproto[src]);
+            free(state->prev_M[src]);
+            free(state->prev_Mr[src]);
+            free(state->dirActive[src]);
+        }
+        free(state->new_M);
+        free(state->new_Mr);
+        free(state->interp_M);
+        free(state->interp_Mr);
+        free(state->interp_Mr_cmplx);
+
+        /* Optimal mixing */
+        cdf4sap_cmplx_batch_destroy(&(state->hCdf));
+        cdf4sap_batch_destroy(&(state->hCdf_res));
+        free(state->Qmix);
+        free(state->Qmix_cmplx);
+        free(state->Cr);
+        free(state->Cr_cmplx);
+        free(state->Cp);
+        free(state->CpDiag);
+        free(state);
+        state = NULL;
+        *phState = NULL;
     }
-    pData->codecStatus = newStatus;
 }
   
 
@@ -65,6 +65,50 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
 
+/**
+ * Contains the filterbank coefficients, decorrelators, and mixing matrices, as
+ * used by spreader_process(). These are computed by spreader_initCodec() and
+ * then handed over to the processing thread (see saf_utility_rcu.h); so
+ * processing carries on with the previous configuration while a new one is
+ * computed. The buffers, which are sized for the configuration, are only
+ * written to by the processing thread.
+ */
+typedef struct _spreader_codecState
+{
+    int nSources;                      /**< Number of input signals */
+    SPREADER_PROC_MODES procMode;      /**< See #SPREADER_PROC_MODES */
+    int Q;                             /**< Number of channels in the target playback setup; for example: 2 for binaural */
+    int nGrid;                         /**< Number of directions/measurements/HRTFs etc. */
+    float_complex* H_grid;             /**< FLAT: HYBRID_BANDS x Q x nGrid */
+    float_complex** HHH[HYBRID_BANDS]; /**< Pre-computed array outer-products; HYBRID_BANDS x nGrid x FLAT: (Q x Q) */
+    float* grid_dirs_xyz;              /**< Grid directions as unit-length Cartesian coordinates; FLAT: nGrid x 3 */
+    void* hDecor[SPREADER_MAX_NUM_SOURCES]; /**< handles for decorrelators */
+    float* angles;                     /**< angles; nGrid x 1 */
+    float_complex** Cproto[SPREADER_MAX_NUM_SOURCES]; /**< Current prototype covariance matrices; HYBRID_BANDS x FLAT:(Q x Q) */
+    float_complex** Cy[SPREADER_MAX_NUM_SOURCES];     /**< Target covariance matrices; HYBRID_BANDS x FLAT:(Q x Q) */
+    float_complex** prev_M[SPREADER_MAX_NUM_SOURCES]; /**< previous mixing matrices; HYBRID_BANDS x FLAT:(Q x Q) */
+    float** prev_Mr[SPREADER_MAX_NUM_SOURCES];        /**< previous residual mixing matrices; HYBRID_BANDS x FLAT:(Q x Q) */
+    float_complex** new_M;             /**< mixing matrices; HYBRID_BANDS x FLAT:(Q x Q) */
+    float** new_Mr;                    /**< residual mixing matrices; HYBRID_BANDS x FLAT:(Q x Q) */
+    float_complex* interp_M;           /**< Interpolated mixing matrix; FLAT:(Q x Q) */
+    float* interp_Mr;                  /**< Interpolated residual mixing matrix; FLAT:(Q x Q) */
+    float_complex* interp_Mr_cmplx;    /**< Complex variant of interp_Mr */ 
+
+    /* For visualisation */
+    int* dirActive[SPREADER_MAX_NUM_SOURCES]; /**< 1: IR direction currently used for spreading, 0: not */
+
+    /* Optimal mixing solution */
+    void* hCdf;                        /**< batched covariance domain framework handle */
+    void* hCdf_res;                    /**< batched covariance domain framework handle for the residual */
+    float* Qmix;                       /**< Identity; FLAT: Q x Q */
+    float_complex* Qmix_cmplx;         /**< Identity; FLAT: Q x Q */
+    float* Cr;                         /**< Residual covariances; FLAT: HYBRID_BANDS x Q x Q */
+    float_complex* Cr_cmplx;           /**< Residual covariances; FLAT: HYBRID_BANDS x Q x Q */
+    float_complex* Cp;                 /**< Diagonally loaded prototype covariances; FLAT: HYBRID_BANDS x Q x Q */
+    float* CpDiag;                     /**< Diagonals of Cp; FLAT: HYBRID_BANDS x Q x Q */
+
+} spreader_codecState;
+
 /**
  * Main structure for spreader. Contains variables for audio buffers,
  * afSTFT, HRTFs, internal variables, flags, user parameters
@@ -89,41 +133,16 @@ typedef struct _spreader
     int h_len;                         /**< Length of time-domain filters, in samples */
     float h_fs;                        /**< Sample rate used to measure the filters */
     float* h_grid;                     /**< FLAT: nGrid x Q x h_len */
-    float_complex* H_grid;             /**< FLAT: HYBRID_BANDS x Q x nGrid */
-    float_complex** HHH[HYBRID_BANDS]; /**< Pre-computed array outer-products; HYBRID_BANDS x nGrid x FLAT: (Q x Q) */
     float* grid_dirs_deg;              /**< Grid directions, in degrees; FLAT: nGrid x 2 */
-    float* grid_dirs_xyz;              /**< Grid directions as unit-length Cartesian coordinates; FLAT: nGrid x 3 */
-    float* weights;                    /**< Integration weights; nGrid x 1 */
-    void* hDecor[SPREADER_MAX_NUM_SOURCES]; /**< handles for decorrelators */
-    float* angles;                     /**< angles; nGrid x 1 */
-    float_complex** Cproto[SPREADER_MAX_NUM_SOURCES]; /**< Current prototype covariance matrices; HYBRID_BANDS x FLAT:(Q x Q) */
-    float_complex** Cy[SPREADER_MAX_NUM_SOURCES];     /**< Target covariance matrices; HYBRID_BANDS x FLAT:(Q x Q) */
-    float_complex** prev_M[SPREADER_MAX_NUM_SOURCES]; /**< previous mixing matrices; HYBRID_BANDS x FLAT:(Q x Q) */
-    float** prev_Mr[SPREADER_MAX_NUM_SOURCES];        /**< previous residual mixing matrices; HYBRID_BANDS x FLAT:(Q x Q) */
-    float_complex** new_M;             /**< mixing matrices; HYBRID_BANDS x FLAT:(Q x Q) */
-    float** new_Mr;                    /**< residual mixing matrices; HYBRID_BANDS x FLAT:(Q x Q) */
-    float_complex* interp_M;           /**< Interpolated mixing matrix; FLAT:(Q x Q) */
-    float* interp_Mr;                  /**< Interpolated residual mixing matrix; FLAT:(Q x Q) */
-    float_complex* interp_Mr_cmplx;    /**< Complex variant of interp_Mr */ 
     float interpolatorFadeIn[TIME_SLOTS];  /**< Linear Interpolator - Fade in */
     float interpolatorFadeOut[TIME_SLOTS]; /**< Linear Interpolator - Fade out */
-
-    /* For visualisation */
-    int* dirActive[SPREADER_MAX_NUM_SOURCES]; /**< 1: IR direction currently used for spreading, 0: not */
-
-    /* Optimal mixing solution */
-    void* hCdf;                        /**< covariance domain framework handle */
-    void* hCdf_res;                    /**< covariance domain framework handle for the residual */
-    float* Qmix;                       /**< Identity; FLAT: Q x Q */
-    float_complex* Qmix_cmplx;         /**< Identity; FLAT: Q x Q */
-    float* Cr;                         /**< Residual covariance; FLAT: Q x Q */
-    float_complex* Cr_cmplx;           /**< Residual covariance; FLAT: Q x Q */
+    void* hCodecState;                 /**< Hand-off of the current #spreader_codecState to the processing thread (saf_rcu handle) */
  
     /* flags/status */
-    CODEC_STATUS codecStatus;          /**< see #CODEC_STATUS */
+    volatile int codecStatus;          /**< see #CODEC_STATUS (accessed atomically) */
+    volatile int initialisingFLAG;     /**< 1: spreader_initCodec() is currently running (accessed atomically) */
     float progressBar0_1;              /**< Current (re)initialisation progress, between [0..1] */
     char* progressBarText;             /**< Current (re)initialisation step, string */
-    PROC_STATUS procStatus;            /**< see #PROC_STATUS */
     int new_nSources;                  /**< New number of input signals (current value will be replaced by this after next re-init) */
     SPREADER_PROC_MODES new_procMode;  /**< See #SPREADER_PROC_MODES (current value will be replaced by this after next re-init) */
 
@@ -147,6 +166,9 @@ typedef struct _spreader
 void spreader_setCodecStatus(void* const hSpr,
                              CODEC_STATUS newStatus);
 
+/** Destroys a #spreader_codecState (once retired by the saf_rcu handle) */
+void spreader_destroyCodecState(void** const phState);
+
 
 #ifdef __cplusplus
 } /* extern "C" { */
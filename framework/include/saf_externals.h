@@ -169,8 +169,9 @@
  *    element-wise additions/subtractions, etc.
  *
  * Unlike e.g. Intel MKL's DFT, not all even number DFT lengths are supported by
- * vDSP. Therefore, be aware that the default kissFFT library (included in
- * framework/resources) is still used as a fall-back option in such cases.
+ * vDSP. Therefore, be aware that the default built-in FFT (power-of-2 sizes)
+ * or kissFFT library (included in framework/resources) is still used as a
+ * fall-back option in such cases.
  */
 # include "Accelerate/Accelerate.h"
 
@@ -206,8 +207,8 @@
 
 #if defined(SAF_USE_FFTW)
 /*
- * The use of FFTW is optional, but it is faster than the default kissFFT
- * DFT/FFT implementation. However, if you are on an x86 CPU then the DFT/FFT
+ * The use of FFTW is optional, but it is faster than the default built-in and
+ * kissFFT DFT/FFT implementations. However, if you are on an x86 CPU then the DFT/FFT
  * implementations found in Intel IPP, Intel MKL and Apple Accelerate are
  * usually faster options.
  *
@@ -230,29 +231,32 @@
  * back option(s).
  * SIMD accelerated fall-back options may be enabled with: SAF_ENABLE_SIMD
  *
- * By default SSE, SSE2, and SSE3 intrinsics are employed, unless one of the
- * following compiler flags are given:
- *    - AVX/AVX2 intrinsics are enabled with: -mavx2
- *    - AVX-512  intrinsics are enabled with: -mavx512f
+ * The SSE3, AVX2, and AVX-512F kernels are compiled in separate translation
+ * units (saf_utility_veclib_sse3.c, saf_utility_veclib_avx2.c and
+ * saf_utility_veclib_avx512.c), each with the compiler flags required by the
+ * respective instruction set (i.e. -msse3, -mavx2, and -mavx512f -mavx2; which
+ * the included CMake scripts pass automatically). The most suitable kernels are
+ * then selected at run-time, based on the features of the host CPU. Therefore,
+ * there is no longer any need to compile the rest of SAF with these flags, and
+ * the same binary may be run on machines with differing CPU features.
+ * The currently employed instruction set may be queried/overridden with
+ * utility_getSIMDLevel()/utility_setSIMDLevel().
  *
  * Note that intrinsics require a CPU that supports them (x86_64 architecture)
  * To find out which SIMD intrinsics are supported by your own CPU, use the
  * following terminal command on macOS: $ sysctl -a | grep machdep.cpu.features
  * Or on Linux, use: $ lscpu
  */
+# if !(defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#  error SAF_ENABLE_SIMD requires an x86/x86_64 architecture
+# endif
 # if (defined(__AVX__) && defined(__AVX2__)) || defined(__AVX512F__)
-/*
- * Note that AVX/AVX2 requires the '-mavx2' compiler flag
- * Whereas AVX-512 requires the '-mavx512f' compiler flag
- */
 #  include <immintrin.h> /* for AVX, AVX2, and/or AVX-512 */
 # endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-#  include <xmmintrin.h>  /* for SSE  */
-#  include <emmintrin.h>  /* for SSE2 */
+# include <xmmintrin.h>   /* for SSE  */
+# include <emmintrin.h>   /* for SSE2 */
+# if defined(__SSE3__)
 #  include <pmmintrin.h>  /* for SSE3 */
-# else
-#  error SAF_ENABLE_SIMD requires at least SSE, SSE2 and SSE3 support
 # endif
 #endif
 
@@ -318,16 +322,8 @@
 /* Status of SIMD intrinsics */
 #if defined(SAF_ENABLE_SIMD)
 # define SAF_SIMD_STATUS_STRING "Enabled"
-/* Which SIMD intrinsics are currently enabled? */
-# if defined(__AVX512F__)
-#  define SAF_ENABLED_SIMD_INTRINSICS_STRING "SSE, SSE2, SSE3, AVX, AVX2, AVX512F"
-# elif defined(__AVX__) && defined(__AVX2__)
-#  define SAF_ENABLED_SIMD_INTRINSICS_STRING "SSE, SSE2, SSE3, AVX, AVX2"
-# elif defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-#  define SAF_ENABLED_SIMD_INTRINSICS_STRING "SSE, SSE2, SSE3"
-# else
-#  define SAF_ENABLED_SIMD_INTRINSICS_STRING "None"
-# endif
+/* Which SIMD intrinsics may be employed? (selected at run-time, see utility_getSIMDLevel()) */
+# define SAF_ENABLED_SIMD_INTRINSICS_STRING "SSE, SSE2, SSE3, AVX, AVX2, AVX512F (run-time dispatch)"
 #else
 # define SAF_SIMD_STATUS_STRING "Disabled"
 # define SAF_ENABLED_SIMD_INTRINSICS_STRING "None"
@@ -545,3 +545,741 @@ void formulate_M_and_Cr_cmplx
             memset(Cr, 0, nYcols*nYcols*sizeof(float_complex));
     } 
 }
+
+
+/* ========================================================================== */
+/*                              Batched Functions                             */
+/* ========================================================================== */
+
+/** Number of matrices solved side by side; one per vector lane */
+#ifndef CDF4SAP_BATCH_LANES
+# define CDF4SAP_BATCH_LANES ( 16 )
+#endif
+/** Above this dimension, the batched functions fall back to the per-matrix
+ *  LAPACK based solver */
+#ifndef CDF4SAP_BATCH_MAX_DIM
+# define CDF4SAP_BATCH_MAX_DIM ( 12 )
+#endif
+/** Maximum number of sweeps for the batched one-sided Jacobi SVD */
+#define CDF4SAP_BATCH_MAX_SWEEPS ( 30 )
+/** Relative orthogonality tolerance for the batched one-sided Jacobi SVD */
+#define CDF4SAP_BATCH_JACOBI_TOL ( 1e-6f )
+
+/**
+ * Main data structure for the batched Covariance Domain Framework.
+ *
+ * The work matrices are lane-interleaved, i.e., element (i,j) of the matrix
+ * belonging to lane l is stored at [(i*nCols+j)*CDF4SAP_BATCH_LANES + l], so
+ * that each operation may be carried out for all lanes at once.
+ */
+typedef struct _cdf4sap_batch_data {
+    /* Dimensions of Cx and Cy */
+    int nXcols, nYcols;
+    int isComplex;
+
+    /* Per-matrix solver, used instead if the dimensions are too large */
+    void* hCdf;
+
+    /* lane-interleaved work matrices (real and imaginary parts) */
+    float* Cx_re, *Cx_im, *Cy_re, *Cy_im, *Q_re, *Q_im;
+    float* Ky_re, *Ky_im, *Vy_re, *Vy_im;
+    float* Kx_re, *Kx_im, *Ux_re, *Ux_im, *Vx_re, *Vx_im, *Kx_reg_inverse_re, *Kx_reg_inverse_im;
+    float* A_re, *A_im, *VA_re, *VA_im;
+    float* tmp1_re, *tmp1_im, *tmp2_re, *tmp2_im;
+    float* M_re, *M_im, *Cy_tilde_re, *Cy_tilde_im, *Cr_re, *Cr_im;
+    float* s_Cx, *s_Cy, *s_A, *G_hat;
+
+}cdf4sap_batch_data;
+
+/**
+ * Lane-interleaved matrix multiplication: C = op(A) * op(B), where op() is
+ * either nothing (0) or the conjugate transpose (1) */
+static void cdf4sap_batch_gemm
+(
+    int isComplex,
+    int transA,
+    int transB,
+    int m,
+    int n,
+    int k,
+    const float* A_re,
+    const float* A_im,
+    int lda,
+    const float* B_re,
+    const float* B_im,
+    int ldb,
+    float* C_re,
+    float* C_im,
+    int ldc
+)
+{
+    int i, j, p, l;
+    float sa, sb;
+    const float* a_re, *a_im, *b_re, *b_im;
+    float* c_re, *c_im;
+
+    sa = transA ? -1.0f : 1.0f;
+    sb = transB ? -1.0f : 1.0f;
+    for(i=0; i<m; i++){
+        for(j=0; j<n; j++){
+            c_re = &C_re[(i*ldc+j)*CDF4SAP_BATCH_LANES];
+            c_im = &C_im[(i*ldc+j)*CDF4SAP_BATCH_LANES];
+            memset(c_re, 0, CDF4SAP_BATCH_LANES*sizeof(float));
+            memset(c_im, 0, CDF4SAP_BATCH_LANES*sizeof(float));
+            for(p=0; p<k; p++){
+                a_re = &A_re[(transA ? p*lda+i : i*lda+p)*CDF4SAP_BATCH_LANES];
+                b_re = &B_re[(transB ? j*ldb+p : p*ldb+j)*CDF4SAP_BATCH_LANES];
+                if(isComplex){
+                    a_im = &A_im[(transA ? p*lda+i : i*lda+p)*CDF4SAP_BATCH_LANES];
+                    b_im = &B_im[(transB ? j*ldb+p : p*ldb+j)*CDF4SAP_BATCH_LANES];
+                    for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+                        c_re[l] += a_re[l]*b_re[l] - sa*sb*a_im[l]*b_im[l];
+                        c_im[l] += sb*a_re[l]*b_im[l] + sa*a_im[l]*b_re[l];
+                    }
+                }
+                else
+                    for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+                        c_re[l] += a_re[l]*b_re[l];
+            }
+        }
+    }
+}
+
+/**
+ * Lane-interleaved one-sided (Hestenes) Jacobi SVD
+ *
+ * The columns of X (nRows x nCols) are orthogonalised in-place, such that
+ * X_in * V = X_out, where the singular values are the column norms of X_out
+ * (returned in sigma; nCols x 1), and the left singular vectors are the
+ * normalised columns of X_out. For Hermitian positive semi-definite X, these
+ * are the eigenvalues and eigenvectors. Singular values are not sorted.
+ */
+static void cdf4sap_batch_jacobiSVD
+(
+    int isComplex,
+    int nRows,
+    int nCols,
+    float* X_re,
+    float* X_im,
+    float* V_re,
+    float* V_im,
+    float* sigma
+)
+{
+    int i, p, q, l, sweep, nRot, nRotPrev, ex;
+    float alpha[CDF4SAP_BATCH_LANES], beta[CDF4SAP_BATCH_LANES], gamma_re[CDF4SAP_BATCH_LANES], gamma_im[CDF4SAP_BATCH_LANES];
+    float c[CDF4SAP_BATCH_LANES], s[CDF4SAP_BATCH_LANES], e_re[CDF4SAP_BATCH_LANES], e_im[CDF4SAP_BATCH_LANES];
+    float scale[CDF4SAP_BATCH_LANES], noiseFloor[CDF4SAP_BATCH_LANES];
+    float g, zeta, t, xp_re, xp_im, xq_re, xq_im;
+    float* p_re, *p_im, *q_re, *q_im;
+
+    /* Scale each matrix by a power of 2, such that its largest element is in
+     * the range [0.5 1). This keeps the squared column norms clear of
+     * denormals. Columns with norms below the single-precision noise floor of
+     * the matrix are then treated as already converged */
+    for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+        scale[l] = noiseFloor[l] = 0.0f;
+    for(i=0; i<nRows*nCols; i++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            scale[l] = SAF_MAX(scale[l], fabsf(X_re[i*CDF4SAP_BATCH_LANES+l]));
+            if(isComplex)
+                scale[l] = SAF_MAX(scale[l], fabsf(X_im[i*CDF4SAP_BATCH_LANES+l]));
+        }
+    }
+    for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+        frexpf(scale[l], &ex);
+        scale[l] = scale[l] > 0.0f ? ldexpf(1.0f, -ex) : 1.0f;
+    }
+    for(i=0; i<nRows*nCols; i++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            X_re[i*CDF4SAP_BATCH_LANES+l] *= scale[l];
+            X_im[i*CDF4SAP_BATCH_LANES+l] *= scale[l];
+            noiseFloor[l] += X_re[i*CDF4SAP_BATCH_LANES+l]*X_re[i*CDF4SAP_BATCH_LANES+l] + X_im[i*CDF4SAP_BATCH_LANES+l]*X_im[i*CDF4SAP_BATCH_LANES+l];
+        }
+    }
+    for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+        noiseFloor[l] *= FLT_EPSILON*FLT_EPSILON;
+
+    /* V = I */
+    memset(V_re, 0, nCols*nCols*CDF4SAP_BATCH_LANES*sizeof(float));
+    memset(V_im, 0, nCols*nCols*CDF4SAP_BATCH_LANES*sizeof(float));
+    for(i=0; i<nCols; i++)
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+            V_re[(i*nCols+i)*CDF4SAP_BATCH_LANES+l] = 1.0f;
+
+    for(sweep=0; sweep<CDF4SAP_BATCH_MAX_SWEEPS; sweep++){
+        nRot = nRotPrev = 0;
+        for(p=0; p<nCols-1; p++){
+            for(q=p+1; q<nCols; q++){
+                /* Gram matrix of columns p and q */
+                memset(alpha, 0, CDF4SAP_BATCH_LANES*sizeof(float));
+                memset(beta, 0, CDF4SAP_BATCH_LANES*sizeof(float));
+                memset(gamma_re, 0, CDF4SAP_BATCH_LANES*sizeof(float));
+                memset(gamma_im, 0, CDF4SAP_BATCH_LANES*sizeof(float));
+                for(i=0; i<nRows; i++){
+                    p_re = &X_re[(i*nCols+p)*CDF4SAP_BATCH_LANES];
+                    q_re = &X_re[(i*nCols+q)*CDF4SAP_BATCH_LANES];
+                    for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+                        alpha[l] += p_re[l]*p_re[l];
+                        beta[l] += q_re[l]*q_re[l];
+                        gamma_re[l] += p_re[l]*q_re[l];
+                    }
+                    if(isComplex){
+                        p_im = &X_im[(i*nCols+p)*CDF4SAP_BATCH_LANES];
+                        q_im = &X_im[(i*nCols+q)*CDF4SAP_BATCH_LANES];
+                        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+                            alpha[l] += p_im[l]*p_im[l];
+                            beta[l] += q_im[l]*q_im[l];
+                            gamma_re[l] += p_im[l]*q_im[l];
+                            gamma_im[l] += p_re[l]*q_im[l] - p_im[l]*q_re[l];
+                        }
+                    }
+                }
+
+                /* Rotation that orthogonalises the two columns. The phase of
+                 * gamma is first removed from column q, which leaves a real
+                 * 2x2 symmetric problem */
+                for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+                    g = SAF_MAX(fabsf(gamma_re[l]), fabsf(gamma_im[l]));
+                    g = g > 0.0f ? g*sqrtf((gamma_re[l]/g)*(gamma_re[l]/g) + (gamma_im[l]/g)*(gamma_im[l]/g)) : 0.0f;
+                    if(g > CDF4SAP_BATCH_JACOBI_TOL*sqrtf(alpha[l])*sqrtf(beta[l]) && alpha[l] > noiseFloor[l] && beta[l] > noiseFloor[l]){
+                        zeta = (beta[l]-alpha[l])/(2.0f*g);
+                        t = (zeta >= 0.0f ? 1.0f : -1.0f)/(fabsf(zeta) + sqrtf(1.0f + zeta*zeta));
+                        c[l] = 1.0f/sqrtf(1.0f + t*t);
+                        s[l] = c[l]*t;
+                        e_re[l] = gamma_re[l]/g;
+                        e_im[l] = gamma_im[l]/g;
+                        nRot++;
+                    }
+                    else{
+                        c[l] = 1.0f;
+                        s[l] = 0.0f;
+                        e_re[l] = 1.0f;
+                        e_im[l] = 0.0f;
+                    }
+                }
+                if(nRot==nRotPrev)
+                    continue; /* no lane needs this rotation */
+                nRotPrev = nRot;
+
+                /* Apply to the columns of X and V */
+                for(i=0; i<nRows+nCols; i++){
+                    p_re = i<nRows ? &X_re[(i*nCols+p)*CDF4SAP_BATCH_LANES] : &V_re[((i-nRows)*nCols+p)*CDF4SAP_BATCH_LANES];
+                    q_re = i<nRows ? &X_re[(i*nCols+q)*CDF4SAP_BATCH_LANES] : &V_re[((i-nRows)*nCols+q)*CDF4SAP_BATCH_LANES];
+                    if(isComplex){
+                        p_im = i<nRows ? &X_im[(i*nCols+p)*CDF4SAP_BATCH_LANES] : &V_im[((i-nRows)*nCols+p)*CDF4SAP_BATCH_LANES];
+                        q_im = i<nRows ? &X_im[(i*nCols+q)*CDF4SAP_BATCH_LANES] : &V_im[((i-nRows)*nCols+q)*CDF4SAP_BATCH_LANES];
+                        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+                            xp_re = p_re[l];
+                            xp_im = p_im[l];
+                            xq_re = q_re[l]*e_re[l] + q_im[l]*e_im[l];
+                            xq_im = q_im[l]*e_re[l] - q_re[l]*e_im[l];
+                            p_re[l] = c[l]*xp_re - s[l]*xq_re;
+                            p_im[l] = c[l]*xp_im - s[l]*xq_im;
+                            q_re[l] = s[l]*xp_re + c[l]*xq_re;
+                            q_im[l] = s[l]*xp_im + c[l]*xq_im;
+                        }
+                    }
+                    else{
+                        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+                            xp_re = p_re[l];
+                            xq_re = q_re[l]*e_re[l];
+                            p_re[l] = c[l]*xp_re - s[l]*xq_re;
+                            q_re[l] = s[l]*xp_re + c[l]*xq_re;
+                        }
+                    }
+                }
+            }
+        }
+        if(nRot==0)
+            break;
+    }
+
+    /* Singular values */
+    memset(sigma, 0, nCols*CDF4SAP_BATCH_LANES*sizeof(float));
+    for(i=0; i<nRows; i++){
+        for(p=0; p<nCols; p++){
+            p_re = &X_re[(i*nCols+p)*CDF4SAP_BATCH_LANES];
+            for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+                sigma[p*CDF4SAP_BATCH_LANES+l] += p_re[l]*p_re[l];
+            if(isComplex){
+                p_im = &X_im[(i*nCols+p)*CDF4SAP_BATCH_LANES];
+                for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+                    sigma[p*CDF4SAP_BATCH_LANES+l] += p_im[l]*p_im[l];
+            }
+        }
+    }
+    for(p=0; p<nCols; p++)
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+            sigma[p*CDF4SAP_BATCH_LANES+l] = sqrtf(sigma[p*CDF4SAP_BATCH_LANES+l])/scale[l];
+
+    /* Undo the scaling */
+    for(i=0; i<nRows*nCols; i++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            X_re[i*CDF4SAP_BATCH_LANES+l] /= scale[l];
+            X_im[i*CDF4SAP_BATCH_LANES+l] /= scale[l];
+        }
+    }
+}
+
+/**
+ * Copies up to CDF4SAP_BATCH_LANES consecutive (nRows x nCols) matrices into
+ * the lane-interleaved format. Unused lanes are filled with identity matrices
+ */
+static void cdf4sap_batch_interleave
+(
+    int isComplex,
+    const float* in,
+    int nMatrices,
+    int nRows,
+    int nCols,
+    float* out_re,
+    float* out_im
+)
+{
+    int i, l, nElem;
+
+    nElem = nRows*nCols;
+    for(i=0; i<nElem; i++){
+        for(l=0; l<nMatrices; l++){
+            out_re[i*CDF4SAP_BATCH_LANES+l] = isComplex ? in[2*(l*nElem+i)] : in[l*nElem+i];
+            out_im[i*CDF4SAP_BATCH_LANES+l] = isComplex ? in[2*(l*nElem+i)+1] : 0.0f;
+        }
+        for(; l<CDF4SAP_BATCH_LANES; l++){
+            out_re[i*CDF4SAP_BATCH_LANES+l] = i/nCols == i%nCols ? 1.0f : 0.0f;
+            out_im[i*CDF4SAP_BATCH_LANES+l] = 0.0f;
+        }
+    }
+}
+
+/** Copies lane-interleaved matrices back into consecutive matrices */
+static void cdf4sap_batch_deinterleave
+(
+    int isComplex,
+    const float* in_re,
+    const float* in_im,
+    int nMatrices,
+    int nElem,
+    float* out
+)
+{
+    int i, l;
+
+    for(l=0; l<nMatrices; l++){
+        for(i=0; i<nElem; i++){
+            if(isComplex){
+                out[2*(l*nElem+i)]   = in_re[i*CDF4SAP_BATCH_LANES+l];
+                out[2*(l*nElem+i)+1] = in_im[i*CDF4SAP_BATCH_LANES+l];
+            }
+            else
+                out[l*nElem+i] = in_re[i*CDF4SAP_BATCH_LANES+l];
+        }
+    }
+}
+
+/** Copies the same (nRows x nCols) matrix into all lanes */
+static void cdf4sap_batch_broadcast
+(
+    int isComplex,
+    const float* in,
+    int nRows,
+    int nCols,
+    float* out_re,
+    float* out_im
+)
+{
+    int i, l;
+
+    for(i=0; i<nRows*nCols; i++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            out_re[i*CDF4SAP_BATCH_LANES+l] = isComplex ? in[2*i] : in[i];
+            out_im[i*CDF4SAP_BATCH_LANES+l] = isComplex ? in[2*i+1] : 0.0f;
+        }
+    }
+}
+
+static void cdf4sap_batch_create_internal
+(
+    void ** const phCdf,
+    int nXcols,
+    int nYcols,
+    int isComplex
+)
+{
+    *phCdf = malloc1d(sizeof(cdf4sap_batch_data));
+    cdf4sap_batch_data *h = (cdf4sap_batch_data*)(*phCdf);
+    int maxDim, sz;
+
+    h->nXcols = nXcols;
+    h->nYcols = nYcols;
+    h->isComplex = isComplex;
+    maxDim = SAF_MAX(nXcols, nYcols);
+
+    /* Use the per-matrix solver if the matrices are too large */
+    if(maxDim > CDF4SAP_BATCH_MAX_DIM){
+        if(isComplex)
+            cdf4sap_cmplx_create(&(h->hCdf), nXcols, nYcols);
+        else
+            cdf4sap_create(&(h->hCdf), nXcols, nYcols);
+        h->Cx_re = NULL;
+        return;
+    }
+    h->hCdf = NULL;
+
+    /* One block holds all of the lane-interleaved work matrices */
+    sz = maxDim*maxDim*CDF4SAP_BATCH_LANES;
+    h->Cx_re = calloc1d(32*sz + 4*maxDim*CDF4SAP_BATCH_LANES, sizeof(float));
+    h->Cx_im = h->Cx_re + sz;
+    h->Cy_re = h->Cx_re + 2*sz;
+    h->Cy_im = h->Cx_re + 3*sz;
+    h->Q_re = h->Cx_re + 4*sz;
+    h->Q_im = h->Cx_re + 5*sz;
+    h->Ky_re = h->Cx_re + 6*sz;
+    h->Ky_im = h->Cx_re + 7*sz;
+    h->Vy_re = h->Cx_re + 8*sz;
+    h->Vy_im = h->Cx_re + 9*sz;
+    h->Kx_re = h->Cx_re + 10*sz;
+    h->Kx_im = h->Cx_re + 11*sz;
+    h->Ux_re = h->Cx_re + 12*sz;
+    h->Ux_im = h->Cx_re + 13*sz;
+    h->Vx_re = h->Cx_re + 14*sz;
+    h->Vx_im = h->Cx_re + 15*sz;
+    h->Kx_reg_inverse_re = h->Cx_re + 16*sz;
+    h->Kx_reg_inverse_im = h->Cx_re + 17*sz;
+    h->A_re = h->Cx_re + 18*sz;
+    h->A_im = h->Cx_re + 19*sz;
+    h->VA_re = h->Cx_re + 20*sz;
+    h->VA_im = h->Cx_re + 21*sz;
+    h->tmp1_re = h->Cx_re + 22*sz;
+    h->tmp1_im = h->Cx_re + 23*sz;
+    h->tmp2_re = h->Cx_re + 24*sz;
+    h->tmp2_im = h->Cx_re + 25*sz;
+    h->M_re = h->Cx_re + 26*sz;
+    h->M_im = h->Cx_re + 27*sz;
+    h->Cy_tilde_re = h->Cx_re + 28*sz;
+    h->Cy_tilde_im = h->Cx_re + 29*sz;
+    h->Cr_re = h->Cx_re + 30*sz;
+    h->Cr_im = h->Cx_re + 31*sz;
+    h->s_Cx = h->Cx_re + 32*sz;
+    h->s_Cy = h->s_Cx + maxDim*CDF4SAP_BATCH_LANES;
+    h->s_A = h->s_Cx + 2*maxDim*CDF4SAP_BATCH_LANES;
+    h->G_hat = h->s_Cx + 3*maxDim*CDF4SAP_BATCH_LANES;
+}
+
+void cdf4sap_batch_create
+(
+    void ** const phCdf,
+    int nXcols,
+    int nYcols
+)
+{
+    cdf4sap_batch_create_internal(phCdf, nXcols, nYcols, 0);
+}
+
+void cdf4sap_cmplx_batch_create
+(
+    void ** const phCdf,
+    int nXcols,
+    int nYcols
+)
+{
+    cdf4sap_batch_create_internal(phCdf, nXcols, nYcols, 1);
+}
+
+void cdf4sap_batch_destroy
+(
+    void ** const phCdf
+)
+{
+    cdf4sap_batch_data *h = (cdf4sap_batch_data*)(*phCdf);
+
+    if(h!=NULL){
+        if(h->hCdf!=NULL){
+            if(h->isComplex)
+                cdf4sap_cmplx_destroy(&(h->hCdf));
+            else
+                cdf4sap_destroy(&(h->hCdf));
+        }
+        free(h->Cx_re);
+        free(h);
+        h = NULL;
+        *phCdf = NULL;
+    }
+}
+
+void cdf4sap_cmplx_batch_destroy
+(
+    void ** const phCdf
+)
+{
+    cdf4sap_batch_destroy(phCdf);
+}
+
+/**
+ * Solves up to CDF4SAP_BATCH_LANES problems side by side, following the same
+ * steps as formulate_M_and_Cr() and formulate_M_and_Cr_cmplx() */
+static void cdf4sap_batch_solve
+(
+    cdf4sap_batch_data* h,
+    int nMatrices,
+    const float* Cx,
+    const float* Cy,
+    int useEnergyFLAG,
+    float reg,
+    float* M,
+    float* Cr
+)
+{
+    int i, j, l, nX, nY, cplx, nSel, minIdx;
+    float scale, limit[CDF4SAP_BATCH_LANES], maxVal[CDF4SAP_BATCH_LANES], re, im, mag, sMin;
+    float* sx, *sy, *sa;
+    float_complex z;
+
+    nX = h->nXcols;
+    nY = h->nYcols;
+    cplx = h->isComplex;
+    sx = h->s_Cx;
+    sy = h->s_Cy;
+    sa = h->s_A;
+    cdf4sap_batch_interleave(cplx, Cx, nMatrices, nX, nX, h->Cx_re, h->Cx_im);
+    cdf4sap_batch_interleave(cplx, Cy, nMatrices, nY, nY, h->Cy_re, h->Cy_im);
+
+    /* Decomposition of Cy */
+    memcpy(h->Ky_re, h->Cy_re, nY*nY*CDF4SAP_BATCH_LANES*sizeof(float));
+    memcpy(h->Ky_im, h->Cy_im, nY*nY*CDF4SAP_BATCH_LANES*sizeof(float));
+    cdf4sap_batch_jacobiSVD(cplx, nY, nY, h->Ky_re, h->Ky_im, h->Vy_re, h->Vy_im, sy);
+    for(j=0; j<nY; j++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            /* U_Cy * sqrt(S_Cy), where U_Cy are the normalised columns */
+            scale = sy[j*CDF4SAP_BATCH_LANES+l] > 0.0f ? sqrtf(SAF_MAX(sy[j*CDF4SAP_BATCH_LANES+l], 2.23e-20f))/sy[j*CDF4SAP_BATCH_LANES+l] : 0.0f;
+            for(i=0; i<nY; i++){
+                h->Ky_re[(i*nY+j)*CDF4SAP_BATCH_LANES+l] *= scale;
+                h->Ky_im[(i*nY+j)*CDF4SAP_BATCH_LANES+l] *= scale;
+            }
+        }
+    }
+
+    /* Decomposition of Cx */
+    memcpy(h->Ux_re, h->Cx_re, nX*nX*CDF4SAP_BATCH_LANES*sizeof(float));
+    memcpy(h->Ux_im, h->Cx_im, nX*nX*CDF4SAP_BATCH_LANES*sizeof(float));
+    cdf4sap_batch_jacobiSVD(cplx, nX, nX, h->Ux_re, h->Ux_im, h->Vx_re, h->Vx_im, sx);
+    for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+        maxVal[l] = 0.0f;
+    for(j=0; j<nX; j++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            scale = sx[j*CDF4SAP_BATCH_LANES+l] > 0.0f ? 1.0f/sx[j*CDF4SAP_BATCH_LANES+l] : 0.0f;
+            for(i=0; i<nX; i++){
+                h->Ux_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l] *= scale;
+                h->Ux_im[(i*nX+j)*CDF4SAP_BATCH_LANES+l] *= scale;
+            }
+            sx[j*CDF4SAP_BATCH_LANES+l] = sqrtf(SAF_MAX(sx[j*CDF4SAP_BATCH_LANES+l], cplx ? 2.23e-13f : 2.23e-20f));
+            maxVal[l] = SAF_MAX(maxVal[l], sx[j*CDF4SAP_BATCH_LANES+l]);
+            for(i=0; i<nX; i++){
+                h->Kx_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l] = h->Ux_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l]*sx[j*CDF4SAP_BATCH_LANES+l];
+                h->Kx_im[(i*nX+j)*CDF4SAP_BATCH_LANES+l] = h->Ux_im[(i*nX+j)*CDF4SAP_BATCH_LANES+l]*sx[j*CDF4SAP_BATCH_LANES+l];
+            }
+        }
+    }
+
+    /* Regularisation of S_Cx, and formulate regularised Kx^-1 */
+    for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+        limit[l] = maxVal[l] * reg + 2.23e-13f;
+    for(j=0; j<nX; j++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            scale = 1.0f / SAF_MAX(sx[j*CDF4SAP_BATCH_LANES+l], limit[l]);
+            for(i=0; i<nX; i++){
+                h->Kx_reg_inverse_re[(j*nX+i)*CDF4SAP_BATCH_LANES+l] = scale*h->Ux_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l];
+                h->Kx_reg_inverse_im[(j*nX+i)*CDF4SAP_BATCH_LANES+l] = -scale*h->Ux_im[(i*nX+j)*CDF4SAP_BATCH_LANES+l];
+            }
+        }
+    }
+
+    /* Formulate normalisation matrix G_hat (only the diagonal is needed) */
+    cdf4sap_batch_gemm(cplx, 0, 1, nX, nY, nX, h->Cx_re, h->Cx_im, nX, h->Q_re, h->Q_im, nX, h->tmp1_re, h->tmp1_im, nY);
+    for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+        maxVal[l] = -2.23e13f;
+    for(i=0; i<nY; i++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            re = im = 0.0f;
+            for(j=0; j<nX; j++){
+                re += h->Q_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l]*h->tmp1_re[(j*nY+i)*CDF4SAP_BATCH_LANES+l] -
+                      h->Q_im[(i*nX+j)*CDF4SAP_BATCH_LANES+l]*h->tmp1_im[(j*nY+i)*CDF4SAP_BATCH_LANES+l];
+                im += h->Q_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l]*h->tmp1_im[(j*nY+i)*CDF4SAP_BATCH_LANES+l] +
+                      h->Q_im[(i*nX+j)*CDF4SAP_BATCH_LANES+l]*h->tmp1_re[(j*nY+i)*CDF4SAP_BATCH_LANES+l];
+            }
+            h->G_hat[i*CDF4SAP_BATCH_LANES+l] = cplx ? sqrtf(re*re + im*im) : re;
+            maxVal[l] = SAF_MAX(maxVal[l], h->G_hat[i*CDF4SAP_BATCH_LANES+l]);
+        }
+    }
+    for(l=0; l<CDF4SAP_BATCH_LANES; l++)
+        limit[l] = maxVal[l] * 0.001f + 2.23e-13f;
+    for(i=0; i<nY; i++){
+        for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+            if(cplx){
+                /* real part of csqrtf(Cy(i,i)/G(i,i)) */
+                scale = SAF_MAX(h->G_hat[i*CDF4SAP_BATCH_LANES+l], limit[l]);
+                re = h->Cy_re[(i*nY+i)*CDF4SAP_BATCH_LANES+l]/scale;
+                im = h->Cy_im[(i*nY+i)*CDF4SAP_BATCH_LANES+l]/scale;
+                h->G_hat[i*CDF4SAP_BATCH_LANES+l] = sqrtf(SAF_MAX((sqrtf(re*re+im*im) + re)/2.0f, 0.0f));
+            }
+            else
+                h->G_hat[i*CDF4SAP_BATCH_LANES+l] = sqrtf(SAF_MAX(h->Cy_re[(i*nY+i)*CDF4SAP_BATCH_LANES+l], 2.23e-13f) /
+                                                          SAF_MAX(h->G_hat[i*CDF4SAP_BATCH_LANES+l], limit[l]));
+        }
+    }
+
+    /* Formulate optimal P */
+    for(i=0; i<nY; i++){
+        for(j=0; j<nY; j++){
+            for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+                h->tmp1_re[(i*nY+j)*CDF4SAP_BATCH_LANES+l] = h->G_hat[i*CDF4SAP_BATCH_LANES+l]*h->Ky_re[(i*nY+j)*CDF4SAP_BATCH_LANES+l];
+                h->tmp1_im[(i*nY+j)*CDF4SAP_BATCH_LANES+l] = h->G_hat[i*CDF4SAP_BATCH_LANES+l]*h->Ky_im[(i*nY+j)*CDF4SAP_BATCH_LANES+l];
+            }
+        }
+    }
+    cdf4sap_batch_gemm(cplx, 1, 0, nX, nY, nY, h->Q_re, h->Q_im, nX, h->tmp1_re, h->tmp1_im, nY, h->tmp2_re, h->tmp2_im, nY);
+    cdf4sap_batch_gemm(cplx, 1, 0, nX, nY, nX, h->Kx_re, h->Kx_im, nX, h->tmp2_re, h->tmp2_im, nY, h->A_re, h->A_im, nY);
+    cdf4sap_batch_jacobiSVD(cplx, nX, nY, h->A_re, h->A_im, h->VA_re, h->VA_im, sa);
+
+    /* P = V*lambda*U^H, where only the min(nX,nY) largest singular values are
+     * retained. The left singular vectors are A(:,j)/sigma(j), so the 1/sigma
+     * scaling is folded into V */
+    nSel = SAF_MIN(nX, nY);
+    for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+        for(j=0; j<nY; j++)
+            sa[j*CDF4SAP_BATCH_LANES+l] = sa[j*CDF4SAP_BATCH_LANES+l] > 0.0f ? sa[j*CDF4SAP_BATCH_LANES+l] : 0.0f;
+        for(i=nSel; i<nY; i++){
+            minIdx = -1;
+            sMin = FLT_MAX;
+            for(j=0; j<nY; j++){
+                if(sa[j*CDF4SAP_BATCH_LANES+l]>=0.0f && sa[j*CDF4SAP_BATCH_LANES+l]<sMin){
+                    sMin = sa[j*CDF4SAP_BATCH_LANES+l];
+                    minIdx = j;
+                }
+            }
+            sa[minIdx*CDF4SAP_BATCH_LANES+l] = -1.0f; /* discard */
+        }
+        for(j=0; j<nY; j++){
+            scale = sa[j*CDF4SAP_BATCH_LANES+l] > 0.0f ? 1.0f/sa[j*CDF4SAP_BATCH_LANES+l] : 0.0f;
+            for(i=0; i<nY; i++){
+                h->VA_re[(i*nY+j)*CDF4SAP_BATCH_LANES+l] *= scale;
+                h->VA_im[(i*nY+j)*CDF4SAP_BATCH_LANES+l] *= scale;
+            }
+        }
+    }
+    cdf4sap_batch_gemm(cplx, 0, 1, nY, nX, nY, h->VA_re, h->VA_im, nY, h->A_re, h->A_im, nY, h->tmp1_re, h->tmp1_im, nX);
+
+    /* Formulate M */
+    cdf4sap_batch_gemm(cplx, 0, 0, nY, nX, nX, h->tmp1_re, h->tmp1_im, nX, h->Kx_reg_inverse_re, h->Kx_reg_inverse_im, nX, h->tmp2_re, h->tmp2_im, nX);
+    cdf4sap_batch_gemm(cplx, 0, 0, nY, nX, nY, h->Ky_re, h->Ky_im, nY, h->tmp2_re, h->tmp2_im, nX, h->M_re, h->M_im, nX);
+
+    /* Formulate residual covariance matrix */
+    if(Cr!=NULL || useEnergyFLAG){
+        cdf4sap_batch_gemm(cplx, 0, 1, nX, nY, nX, h->Cx_re, h->Cx_im, nX, h->M_re, h->M_im, nX, h->tmp1_re, h->tmp1_im, nY);
+        cdf4sap_batch_gemm(cplx, 0, 0, nY, nY, nX, h->M_re, h->M_im, nX, h->tmp1_re, h->tmp1_im, nY, h->Cy_tilde_re, h->Cy_tilde_im, nY);
+    }
+    if(Cr!=NULL){
+        for(i=0; i<nY*nY*CDF4SAP_BATCH_LANES; i++){
+            h->Cr_re[i] = h->Cy_re[i] - h->Cy_tilde_re[i];
+            h->Cr_im[i] = 0.0f; /* only the real part is returned */
+        }
+    }
+
+    /* Use energy compensation instead of residuals */
+    if(useEnergyFLAG){
+        for(i=0; i<nY; i++){
+            for(l=0; l<CDF4SAP_BATCH_LANES; l++){
+                if(cplx){
+                    z = csqrtf(ccdivf(cmplxf(h->Cy_re[(i*nY+i)*CDF4SAP_BATCH_LANES+l], h->Cy_im[(i*nY+i)*CDF4SAP_BATCH_LANES+l]),
+                                      cmplxf(h->Cy_tilde_re[(i*nY+i)*CDF4SAP_BATCH_LANES+l] + 2.23e-13f, h->Cy_tilde_im[(i*nY+i)*CDF4SAP_BATCH_LANES+l])));
+                    for(j=0; j<nX; j++){
+                        re = h->M_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l];
+                        im = h->M_im[(i*nX+j)*CDF4SAP_BATCH_LANES+l];
+                        h->M_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l] = crealf(z)*re - cimagf(z)*im;
+                        h->M_im[(i*nX+j)*CDF4SAP_BATCH_LANES+l] = crealf(z)*im + cimagf(z)*re;
+                    }
+                }
+                else{
+                    mag = sqrtf(SAF_MAX(h->Cy_re[(i*nY+i)*CDF4SAP_BATCH_LANES+l], 2.23e-20f) / (h->Cy_tilde_re[(i*nY+i)*CDF4SAP_BATCH_LANES+l]+2.23e-7f));
+                    for(j=0; j<nX; j++)
+                        h->M_re[(i*nX+j)*CDF4SAP_BATCH_LANES+l] *= mag;
+                }
+            }
+        }
+        if(Cr!=NULL)
+            memset(h->Cr_re, 0, nY*nY*CDF4SAP_BATCH_LANES*sizeof(float));
+    }
+
+    cdf4sap_batch_deinterleave(cplx, h->M_re, h->M_im, nMatrices, nY*nX, M);
+    if(Cr!=NULL)
+        cdf4sap_batch_deinterleave(cplx, h->Cr_re, h->Cr_im, nMatrices, nY*nY, Cr);
+}
+
+void formulate_M_and_Cr_batch
+(
+    void * const hCdf,
+    int batchSize,
+    float* Cx,
+    float* Cy,
+    float* Q,
+    int useEnergyFLAG,
+    float reg,
+    float* M,
+    float* Cr
+)
+{
+    cdf4sap_batch_data *h = (cdf4sap_batch_data*)(hCdf);
+    int b, nX, nY, nMatrices;
+
+    saf_assert(!h->isComplex, "Handle was created with cdf4sap_cmplx_batch_create()");
+    nX = h->nXcols;
+    nY = h->nYcols;
+
+    /* Per-matrix fall-back */
+    if(h->hCdf!=NULL){
+        for(b=0; b<batchSize; b++)
+            formulate_M_and_Cr(h->hCdf, &Cx[b*nX*nX], &Cy[b*nY*nY], Q, useEnergyFLAG, reg, &M[b*nY*nX], Cr==NULL ? NULL : &Cr[b*nY*nY]);
+        return;
+    }
+
+    cdf4sap_batch_broadcast(0, Q, nY, nX, h->Q_re, h->Q_im);
+    for(b=0; b<batchSize; b+=CDF4SAP_BATCH_LANES){
+        nMatrices = SAF_MIN(batchSize-b, CDF4SAP_BATCH_LANES);
+        cdf4sap_batch_solve(h, nMatrices, &Cx[b*nX*nX], &Cy[b*nY*nY], useEnergyFLAG, reg, &M[b*nY*nX], Cr==NULL ? NULL : &Cr[b*nY*nY]);
+    }
+}
+
+void formulate_M_and_Cr_cmplx_batch
+(
+    void * const hCdf,
+    int batchSize,
+    float_complex* Cx,
+    float_complex* Cy,
+    float_complex* Q,
+    int useEnergyFLAG,
+    float reg,
+    float_complex* M,
+    float_complex* Cr
+)
+{
+    cdf4sap_batch_data *h = (cdf4sap_batch_data*)(hCdf);
+    int b, nX, nY, nMatrices;
+
+    saf_assert(h->isComplex, "Handle was created with cdf4sap_batch_create()");
+    nX = h->nXcols;
+    nY = h->nYcols;
+
+    /* Per-matrix fall-back */
+    if(h->hCdf!=NULL){
+        for(b=0; b<batchSize; b++)
+            formulate_M_and_Cr_cmplx(h->hCdf, &Cx[b*nX*nX], &Cy[b*nY*nY], Q, useEnergyFLAG, reg, &M[b*nY*nX], Cr==NULL ? NULL : &Cr[b*nY*nY]);
+        return;
+    }
+
+    cdf4sap_batch_broadcast(1, (float*)Q, nY, nX, h->Q_re, h->Q_im);
+    for(b=0; b<batchSize; b+=CDF4SAP_BATCH_LANES){
+        nMatrices = SAF_MIN(batchSize-b, CDF4SAP_BATCH_LANES);
+        cdf4sap_batch_solve(h, nMatrices, (float*)&Cx[b*nX*nX], (float*)&Cy[b*nY*nY], useEnergyFLAG, reg,
+                            (float*)&M[b*nY*nX], Cr==NULL ? NULL : (float*)&Cr[b*nY*nY]);
+    }
+}
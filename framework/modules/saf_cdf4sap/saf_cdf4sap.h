@@ -217,6 +217,135 @@ void formulate_M_and_Cr_cmplx(/* Input Arguments */
                               float_complex* Cr);
 
 
+/* ========================================================================== */
+/*                              Batched Functions                             */
+/* ========================================================================== */
+
+/**
+ * Creates an instance of the batched Covariance Domain Framework
+ *
+ * The batched variants solve many problems of the same dimensions in one call
+ * (for example, one per frequency band), which avoids the per-call overhead of
+ * formulate_M_and_Cr() when the matrices are small. The matrix
+ * decompositions are carried out using one-sided Jacobi SVDs, which operate on
+ * several problems side by side. For larger matrices (more than 12 rows or
+ * columns), the per-matrix LAPACK based solver is used instead.
+ *
+ * @note Use this function for real-valued input/output matrices. For
+ *       complex-valued input/output matrices use cdf4sap_cmplx_batch_create().
+ *
+ * @param[in] phCdf  The address (&) of the batched CDF4SAP handle
+ * @param[in] nXcols Number of columns/rows in square input matrices 'Cx'
+ * @param[in] nYcols Number of columns/rows in square input matrices 'Cy'
+ */
+void cdf4sap_batch_create(/* Input Arguments */
+                          void ** const phCdf,
+                          int nXcols,
+                          int nYcols);
+
+/**
+ * Creates an instance of the batched Covariance Domain Framework
+ *
+ * @note Use this function for complex-valued input/output matrices. For
+ *       real-valued input/output matrices use cdf4sap_batch_create().
+ *
+ * @param[in] phCdf  The address (&) of the batched CDF4SAP handle
+ * @param[in] nXcols Number of columns/rows in square input matrices 'Cx'
+ * @param[in] nYcols Number of columns/rows in square input matrices 'Cy'
+ */
+void cdf4sap_cmplx_batch_create(/* Input Arguments */
+                                void ** const phCdf,
+                                int nXcols,
+                                int nYcols);
+
+/**
+ * Destroys an instance of the batched Covariance Domain Framework
+ *
+ * @param[in] phCdf The address (&) of the batched CDF4SAP handle
+ */
+void cdf4sap_batch_destroy(/* Input Arguments */
+                           void ** const phCdf);
+
+/**
+ * Destroys an instance of the batched Covariance Domain Framework
+ *
+ * @param[in] phCdf The address (&) of the batched CDF4SAP handle
+ */
+void cdf4sap_cmplx_batch_destroy(/* Input Arguments */
+                                 void ** const phCdf);
+
+/**
+ * Computes the optimal mixing matrices for a batch of problems, which share the
+ * same prototype matrix
+ *
+ * Each problem is solved as in formulate_M_and_Cr(), and the results match
+ * those of formulate_M_and_Cr() to within single-precision round-off.
+ *
+ * @test test__formulate_M_and_Cr_batch()
+ *
+ * @param[in]  hCdf          Batched Covariance Domain Framework handle
+ * @param[in]  batchSize     Number of problems to solve
+ * @param[in]  Cx            Covariance matrices of input 'x';
+ *                           FLAT: batchSize x nXcols x nXcols
+ * @param[in]  Cy            Target covariance matrices;
+ *                           FLAT: batchSize x nYcols x nYcols
+ * @param[in]  Q             Prototype matrix (shared by all problems);
+ *                           FLAT: nYcols x nXcols
+ * @param[in]  useEnergyFLAG See formulate_M_and_Cr()
+ * @param[in]  reg           Regularisation term (suggested: 0.2f)
+ * @param[out] M             Mixing matrices; FLAT: batchSize x nYcols x nXcols
+ * @param[out] Cr            Mixing matrix residuals, set to NULL if not
+ *                           needed; FLAT: batchSize x nYcols x nYcols
+ */
+void formulate_M_and_Cr_batch(/* Input Arguments */
+                              void * const hCdf,
+                              int batchSize,
+                              float* Cx,
+                              float* Cy,
+                              float* Q,
+                              int useEnergyFLAG,
+                              float reg,
+                              /* Output Arguments */
+                              float* M,
+                              float* Cr);
+
+/**
+ * Computes the optimal mixing matrices for a batch of problems, which share the
+ * same prototype matrix
+ *
+ * Each problem is solved as in formulate_M_and_Cr_cmplx(), and the results
+ * match those of formulate_M_and_Cr_cmplx() to within single-precision
+ * round-off.
+ *
+ * @test test__formulate_M_and_Cr_batch()
+ *
+ * @param[in]  hCdf          Batched Covariance Domain Framework handle
+ * @param[in]  batchSize     Number of problems to solve
+ * @param[in]  Cx            Covariance matrices of input 'x';
+ *                           FLAT: batchSize x nXcols x nXcols
+ * @param[in]  Cy            Target covariance matrices;
+ *                           FLAT: batchSize x nYcols x nYcols
+ * @param[in]  Q             Prototype matrix (shared by all problems);
+ *                           FLAT: nYcols x nXcols
+ * @param[in]  useEnergyFLAG See formulate_M_and_Cr_cmplx()
+ * @param[in]  reg           Regularisation term (suggested: 0.2f)
+ * @param[out] M             Mixing matrices; FLAT: batchSize x nYcols x nXcols
+ * @param[out] Cr            Mixing matrix residuals, set to NULL if not
+ *                           needed; FLAT: batchSize x nYcols x nYcols
+ */
+void formulate_M_and_Cr_cmplx_batch(/* Input Arguments */
+                                    void * const hCdf,
+                                    int batchSize,
+                                    float_complex* Cx,
+                                    float_complex* Cy,
+                                    float_complex* Q,
+                                    int useEnergyFLAG,
+                                    float reg,
+                                    /* Output Arguments */
+                                    float_complex* M,
+                                    float_complex* Cr);
+
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
@@ -105,20 +105,23 @@ void ims_shoebox_create
         }
     }
 
-    /* Circular buffers (only used/allocated when applyEchogramTD() function is called for the first time) */
+    /* Circular buffers and band-passed signals per source (allocated when a source is added) */
     memset(sc->wIdx, 0, IMS_MAX_NUM_RECEIVERS*IMS_MAX_NUM_SOURCES*2*sizeof(unsigned long));
-    sc->circ_buffer[0] = NULL;
-    sc->circ_buffer[1] = NULL;
-
-    /* IIR Filterbank per source (only used/allocated when applyEchogramTD() function is called for the first time) */
-    sc->hFaFbank = malloc1d(IMS_MAX_NUM_SOURCES*sizeof(voidPtr));
     sc->src_sigs_bands = malloc1d(IMS_MAX_NUM_SOURCES*sizeof(float**));
     for(j=0; j<IMS_MAX_NUM_SOURCES; j++){
-        sc->hFaFbank[j] = NULL;
+        sc->circ_buffer[IMS_EG_CURRENT][j] = NULL;
+        sc->circ_buffer[IMS_EG_PREV][j] = NULL;
+        sc->circ_len[j] = 0;
         sc->src_sigs_bands[j] = NULL;
     }
 
-    /* Temp buffers for cross-fading (only used/allocated when applyEchogramTD() function is called for the first time) */
+    /* IIR Filterbank (only if there is more than one band), with one channel per source */
+    sc->hFaFbank = NULL;
+    if(sc->nBands>1)
+        faf_IIRFilterbank_createMultiChannel(&(sc->hFaFbank), IMS_IIR_FILTERBANK_ORDER, sc->band_cutofffreqs,
+                                             sc->nBands-1, sc->fs, IMS_MAX_NSAMPLES_PER_FRAME, IMS_MAX_NUM_SOURCES);
+
+    /* Temp buffers for cross-fading (allocated when a receiver is added) */
     sc->rec_sig_tmp[IMS_EG_CURRENT] = malloc1d(IMS_MAX_NUM_RECEIVERS*sizeof(float**));
     sc->rec_sig_tmp[IMS_EG_PREV] = malloc1d(IMS_MAX_NUM_RECEIVERS*sizeof(float**));
     for(j=0; j<IMS_MAX_NUM_RECEIVERS; j++){
@@ -126,15 +129,18 @@ void ims_shoebox_create
         sc->rec_sig_tmp[IMS_EG_PREV][j] = NULL;
     }
     memset(sc->applyCrossFadeFLAG, 0, IMS_MAX_NUM_RECEIVERS*IMS_MAX_NUM_SOURCES*sizeof(int));
-    sc->interpolator_fIn = NULL;
-    sc->interpolator_fOut = NULL;
-    sc->tmp_frame = NULL;
+    sc->interpolator_fIn = malloc1d(IMS_MAX_NSAMPLES_PER_FRAME*sizeof(float));
+    sc->interpolator_fOut = malloc1d(IMS_MAX_NSAMPLES_PER_FRAME*sizeof(float));
+    sc->tmp_frame = malloc1d(IMS_MAX_NSAMPLES_PER_FRAME*sizeof(float));
     sc->framesize = -1;
 
     /* Lagrange interpolator look-up table */
-    for(i=0; i<IMS_LAGRANGE_LOOKUP_TABLE_SIZE; i++)
-        sc->lookup_fractions[i] = 1.0f/IMS_LAGRANGE_LOOKUP_TABLE_SIZE * (float)i;
-    lagrangeWeights(IMS_LAGRANGE_ORDER, sc->lookup_fractions, IMS_LAGRANGE_LOOKUP_TABLE_SIZE, (float*)sc->lookup_H_frac);
+    sc->lagrangeTable = NULL;
+    ims_shoebox_setFractionalDelayOrder(*phIms, IMS_LAGRANGE_ORDER);
+
+    /* Single-threaded by default */
+    sc->hThreadPool = NULL;
+    sc->nPairs = 0;
 }
 
 void ims_shoebox_destroy
@@ -158,13 +164,12 @@ void ims_shoebox_destroy
             for(j=0; j<IMS_MAX_NUM_SOURCES; j++)
                 free(sc->rirs[i][j].data);
         free(sc->rirs);
-        free(sc->circ_buffer[IMS_EG_CURRENT]);
-        free(sc->circ_buffer[IMS_EG_PREV]);
         for(j=0; j<IMS_MAX_NUM_SOURCES; j++){
-            faf_IIRFilterbank_destroy(&(sc->hFaFbank[j]));
+            free(sc->circ_buffer[IMS_EG_CURRENT][j]);
+            free(sc->circ_buffer[IMS_EG_PREV][j]);
             free(sc->src_sigs_bands[j]);
         }
-        free(sc->hFaFbank);
+        faf_IIRFilterbank_destroy(&(sc->hFaFbank));
         free(sc->src_sigs_bands);
         for(i=0; i<IMS_MAX_NUM_RECEIVERS; i++){
             free(sc->rec_sig_tmp[IMS_EG_CURRENT][i]);
@@ -175,12 +180,135 @@ void ims_shoebox_destroy
         free(sc->interpolator_fIn);
         free(sc->interpolator_fOut);
         free(sc->tmp_frame);
+        free(sc->lagrangeTable);
         free(sc);
         sc=NULL;
         *phIms = NULL;
     }
 }
 
+/**
+ * Grows the circular buffers of a source, if they are shorter than twice the
+ * longest delay of its (current and previous) echograms, across all receivers
+ *
+ * The headroom means that the past samples needed by an echogram which
+ * becomes up to twice as long are still there. This is done whenever the
+ * echograms are computed, so that ims_shoebox_applyEchogramTD() never needs
+ * to allocate memory.
+ */
+static void ims_shoebox_circBufferFit
+(
+    ims_scene_data* sc,
+    int src_idx
+)
+{
+    ims_core_workspace* wrk;
+    echogram_data *echogram_abs_0;
+    int k, im, rec_idx, rec_idx_w;
+    unsigned long circ_len;
+    float maxTime;
+
+    maxTime = 0.0f;
+    rec_idx_w = -1;
+    for(rec_idx = 0; rec_idx < IMS_MAX_NUM_RECEIVERS; rec_idx++){
+        if(sc->recs[rec_idx].ID != IMS_UNASSIGNED){
+            wrk = sc->hCoreWrkSpc[rec_idx][src_idx];
+            for(k=0; k<IMS_EG_NUM_SLOTS; k++){
+                echogram_abs_0 = (echogram_data*)(k==IMS_EG_PREV ? wrk->hPrevEchogram_abs[0] : wrk->hEchogram_abs[0]);
+                for(im=0; im<echogram_abs_0->numImageSources; im++)
+                    maxTime = SAF_MAX(maxTime, echogram_abs_0->time[im]);
+            }
+            if(rec_idx_w==-1)
+                rec_idx_w = rec_idx;
+        }
+    }
+    if(rec_idx_w==-1)
+        return;
+
+    circ_len = sc->circ_len[src_idx];
+    while( (circ_len < IMS_CIRC_BUFFER_LENGTH) && ((float)circ_len < 2.0f*(maxTime*sc->fs + (float)(sc->lagrangeOrder+1))) )
+        circ_len *= 2U;
+    if(circ_len > sc->circ_len[src_idx]){
+        /* (the receivers write the signals of this source in step, so any of their write indices will do) */
+        for(k=0; k<IMS_EG_NUM_SLOTS; k++)
+            ims_shoebox_circBufferResize(&(sc->circ_buffer[k][src_idx]), sc->nBands, sc->circ_len[src_idx], circ_len, sc->wIdx[k][rec_idx_w][src_idx]);
+        sc->circ_len[src_idx] = circ_len;
+    }
+}
+
+/** Arguments of ims_shoebox_computeEchogramTask() */
+typedef struct _ims_echogram_task_args {
+    ims_scene_data* sc; /**< Scene */
+    int maxN;           /**< Maximum reflection order (or <0) */
+    float maxTime_s;    /**< Maximum propagation time, seconds (or <0) */
+}ims_echogram_task_args;
+
+/**
+ * Computes the echograms of one queued source/receiver combination (a task
+ * function for saf_threadPool_run())
+ */
+static void ims_shoebox_computeEchogramTask
+(
+    void* userData,
+    int taskIndex,
+    int workerIndex
+)
+{
+    ims_echogram_task_args* args = (ims_echogram_task_args*)userData;
+    ims_scene_data *sc = args->sc;
+    ims_core_workspace* workspace;
+    ims_pos_xyz src2, rec2;
+    voidPtr hEchogram_tmp;
+    int src_idx, rec_idx, band;
+    (void)workerIndex;
+
+    rec_idx = sc->pair_rec_idx[taskIndex];
+    src_idx = sc->pair_src_idx[taskIndex];
+
+    /* Change y coord for Receiver and Source to match convention used inside
+     * the coreInit function */
+    rec2.x = sc->recs[rec_idx].pos.x;
+    rec2.y = sc->room_dims[1] - sc->recs[rec_idx].pos.y;
+    rec2.z = sc->recs[rec_idx].pos.z;
+    src2.x = sc->srcs[src_idx].pos.x;
+    src2.y = sc->room_dims[1] - sc->srcs[src_idx].pos.y;
+    src2.z = sc->srcs[src_idx].pos.z;
+
+    /* Workspace handle for this source/receiver combination */
+    workspace = sc->hCoreWrkSpc[rec_idx][src_idx];
+
+    /* The current echograms become the previous ones (swapping the containers,
+     * rather than copying their contents) */
+    for(band=0; band<workspace->nBands; band++){
+        hEchogram_tmp = workspace->hPrevEchogram_abs[band];
+        workspace->hPrevEchogram_abs[band] = workspace->hEchogram_abs[band];
+        workspace->hEchogram_abs[band] = hEchogram_tmp;
+    }
+
+    /* Compute echogram due to pure propagation (frequency-independent, omni-directional) */
+    if(args->maxTime_s>0.0f)
+        ims_shoebox_coreInitT(workspace, sc->room_dims, src2, rec2, args->maxTime_s, sc->c_ms);
+    else
+        ims_shoebox_coreInitN(workspace, sc->room_dims, src2, rec2, args->maxN, sc->c_ms);
+
+    /* Apply receiver directivities */
+    switch(sc->recs[rec_idx].type){
+        case RECEIVER_SH:
+            ims_shoebox_coreRecModuleSH(workspace, NSH2ORDER(sc->recs[rec_idx].nChannels));
+            break;
+    }
+
+    /* Apply boundary absorption per frequency band */
+    ims_shoebox_coreAbsorptionModule(workspace, sc->abs_wall);
+
+    /* Indicate that the echogram is now up to date, and that the RIR should be updated */
+    workspace->refreshEchogramFLAG = 0;
+    workspace->refreshRIRFLAG = 1;
+
+    /* Also indicate that applyTD() should cross-fade the next frame to void clicks */
+    sc->applyCrossFadeFLAG[rec_idx][src_idx] = 1;
+}
+
 void ims_shoebox_computeEchograms
 (
     void* hIms,
@@ -190,35 +318,23 @@ void ims_shoebox_computeEchograms
 {
     ims_scene_data *sc = (ims_scene_data*)(hIms);
     ims_core_workspace* workspace;
-    ims_pos_xyz src2, rec2;
-    int src_idx, rec_idx, band;
+    ims_echogram_task_args args;
+    int src_idx, rec_idx;
 
     saf_assert(maxN<0 || maxTime_ms<0.0f, "one of these input arguments must be the same or greater than 0, and the other one must be less than 0.");
     saf_assert(maxN>=0 || maxTime_ms>0.0f, "one of these input arguments must be the same or greater than 0, and the other one must be less than 0.");
 
-    /* Compute echograms for active source/receiver combinations */
+    /* Queue the active source/receiver combinations which require an update */
+    sc->nPairs = 0;
     for(rec_idx = 0; rec_idx < IMS_MAX_NUM_RECEIVERS; rec_idx++){
         for(src_idx = 0; src_idx < IMS_MAX_NUM_SOURCES; src_idx++){
             if( (sc->srcs[src_idx].ID != IMS_UNASSIGNED) && (sc->recs[rec_idx].ID != IMS_UNASSIGNED) ){
-                /* Change y coord for Receiver and Source to match convention
-                 * used inside the coreInit function */
-                rec2.x = sc->recs[rec_idx].pos.x;
-                rec2.y = sc->room_dims[1] - sc->recs[rec_idx].pos.y;
-                rec2.z = sc->recs[rec_idx].pos.z;
-                src2.x = sc->srcs[src_idx].pos.x;
-                src2.y = sc->room_dims[1] - sc->srcs[src_idx].pos.y;
-                src2.z = sc->srcs[src_idx].pos.z;
-
                 /* Workspace handle for this source/receiver combination */
                 workspace = sc->hCoreWrkSpc[rec_idx][src_idx];
 
-                /* Copy previous echograms */
-                for(band=0; band<workspace->nBands; band++)
-                    ims_shoebox_echogramCopy(workspace->hEchogram_abs[band], workspace->hPrevEchogram_abs[band]);
-
                 /* Force refresh if target RIR length or max reflection order has changed */
                 if(maxTime_ms>0.0f){
-                    if(workspace->d_max != maxTime_ms)
+                    if(workspace->d_max != maxTime_ms*sc->c_ms)
                         workspace->refreshEchogramFLAG = 1;
                 }
                 else{
@@ -228,32 +344,58 @@ void ims_shoebox_computeEchograms
 
                 /* Only update if it is required */
                 if(workspace->refreshEchogramFLAG){
-                    /* Compute echogram due to pure propagation (frequency-independent, omni-directional) */
-                    if(maxTime_ms>0.0f)
-                        ims_shoebox_coreInitT(workspace, sc->room_dims, src2, rec2, maxTime_ms, sc->c_ms);
-                    else
-                        ims_shoebox_coreInitN(workspace, sc->room_dims, src2, rec2, maxN, sc->c_ms);
-
-                    /* Apply receiver directivities */
-                    switch(sc->recs[rec_idx].type){
-                        case RECEIVER_SH:
-                            ims_shoebox_coreRecModuleSH(workspace, NSH2ORDER(sc->recs[rec_idx].nChannels));
-                            break;
-                    }
-
-                    /* Apply boundary absorption per frequency band */
-                    ims_shoebox_coreAbsorptionModule(workspace, sc->abs_wall);
-
-                    /* Indicate that the echogram is now up to date, and that the RIR should be updated */
-                    workspace->refreshEchogramFLAG = 0;
-                    workspace->refreshRIRFLAG = 1;
-
-                    /* Also indicate that applyTD() should cross-fade the next frame to void clicks */
-                    sc->applyCrossFadeFLAG[rec_idx][src_idx] = 1;
+                    sc->pair_rec_idx[sc->nPairs] = rec_idx;
+                    sc->pair_src_idx[sc->nPairs] = src_idx;
+                    sc->nPairs++;
                 }
             }
         }
-    }  
+    }
+
+    /* Compute echograms for the queued combinations (in parallel, if a thread pool has been set) */
+    args.sc = sc;
+    args.maxN = maxN;
+    args.maxTime_s = maxTime_ms;
+    if(sc->nPairs>0)
+        saf_threadPool_run(sc->hThreadPool, ims_shoebox_computeEchogramTask, (void*)&args, sc->nPairs);
+
+    /* Grow the circular buffers of the sources to suit the new echograms */
+    if(sc->nPairs>0)
+        for(src_idx = 0; src_idx < IMS_MAX_NUM_SOURCES; src_idx++)
+            if(sc->srcs[src_idx].ID != IMS_UNASSIGNED)
+                ims_shoebox_circBufferFit(sc, src_idx);
+}
+
+/** Arguments of ims_shoebox_renderRIRTask() */
+typedef struct _ims_rir_task_args {
+    ims_scene_data* sc;      /**< Scene */
+    int fractionalDelayFLAG; /**< 0: disabled, 1: use Lagrange interpolation */
+}ims_rir_task_args;
+
+/**
+ * Renders the RIR of one queued source/receiver combination (a task function
+ * for saf_threadPool_run())
+ */
+static void ims_shoebox_renderRIRTask
+(
+    void* userData,
+    int taskIndex,
+    int workerIndex
+)
+{
+    ims_rir_task_args* args = (ims_rir_task_args*)userData;
+    ims_scene_data *sc = args->sc;
+    ims_core_workspace* wrk;
+    int src_idx, rec_idx;
+    (void)workerIndex;
+
+    rec_idx = sc->pair_rec_idx[taskIndex];
+    src_idx = sc->pair_src_idx[taskIndex];
+    wrk = sc->hCoreWrkSpc[rec_idx][src_idx];
+
+    /* Render the RIRs for each band  */
+    ims_shoebox_renderRIR(wrk, args->fractionalDelayFLAG, sc->fs, sc->H_filt, &(sc->rirs[rec_idx][src_idx]));
+    wrk->refreshRIRFLAG = 0;
 }
 
 void ims_shoebox_renderRIRs
@@ -264,6 +406,7 @@ void ims_shoebox_renderRIRs
 {
     ims_scene_data *sc = (ims_scene_data*)(hIms);
     ims_core_workspace* wrk;
+    ims_rir_task_args args;
     int src_idx, rec_idx;
 
     /* Compute FIR Filterbank coefficients (if this is the first time this
@@ -274,24 +417,35 @@ void ims_shoebox_renderRIRs
                       sc->fs, WINDOWING_FUNCTION_HAMMING, 1, FLATTEN2D(sc->H_filt));
     }
 
-    /* Render RIRs for all active source/receiver combinations */
+    /* Queue the active source/receiver combinations which require an update */
+    sc->nPairs = 0;
     for(rec_idx = 0; rec_idx < IMS_MAX_NUM_RECEIVERS; rec_idx++){
         for(src_idx = 0; src_idx < IMS_MAX_NUM_SOURCES; src_idx++){
             if( (sc->srcs[src_idx].ID!=IMS_UNASSIGNED) && (sc->recs[rec_idx].ID!=IMS_UNASSIGNED) ){
-
                 /* Workspace handle for this source/receiver combination */
                 wrk = sc->hCoreWrkSpc[rec_idx][src_idx];
 
                 /* Only update if it is required */
                 if(wrk->refreshRIRFLAG){
-                    /* Render the RIRs for each band  */
-                    ims_shoebox_renderRIR(wrk, fractionalDelayFLAG, sc->fs, sc->H_filt, &(sc->rirs[rec_idx][src_idx]));
-
-                    wrk->refreshRIRFLAG = 0;
+                    sc->pair_rec_idx[sc->nPairs] = rec_idx;
+                    sc->pair_src_idx[sc->nPairs] = src_idx;
+                    sc->nPairs++;
                 }
             }
         }
     }
+
+    /* Render RIRs for the queued combinations (in parallel, if a thread pool
+     * has been set; except with FFTW, since fftconv() creates FFTW plans) */
+    args.sc = sc;
+    args.fractionalDelayFLAG = fractionalDelayFLAG;
+    if(sc->nPairs>0){
+#ifdef SAF_USE_FFTW
+        saf_threadPool_run(NULL, ims_shoebox_renderRIRTask, (void*)&args, sc->nPairs);
+#else
+        saf_threadPool_run(sc->hThreadPool, ims_shoebox_renderRIRTask, (void*)&args, sc->nPairs);
+#endif
+    }
 }
 
 void ims_shoebox_applyEchogramTD
@@ -305,30 +459,11 @@ void ims_shoebox_applyEchogramTD
     ims_scene_data *sc = (ims_scene_data*)(hIms);
     ims_core_workspace* wrk;
     echogram_data *echogram_abs, *echogram_abs_0;
-    int k, i, n, im, band, ch, rec_idx, src_idx, time_samples, wIdx_n;
-    unsigned long rIdx;
+    int k, i, im, band, ch, rec_idx, src_idx, time_samples, wIdx_n, nSamples_w, nSamples_a, order, nLanes, nActive;
+    unsigned long circ_len;
 
-    saf_assert(fractionalDelaysFLAG==0, "Untested!");
     saf_assert(nSamples <= IMS_MAX_NSAMPLES_PER_FRAME, "nSamples exceeds the maximum number that ims_shoebox_applyEchogramTD() can process at a time");
 
-    /* Allocate circular buffers (if this is the first time this function is being called) */
-    if(sc->circ_buffer[0] == NULL)
-        sc->circ_buffer[0] = (float***)calloc3d(IMS_MAX_NUM_SOURCES, sc->nBands, IMS_CIRC_BUFFER_LENGTH, sizeof(float));
-    if(sc->circ_buffer[1] == NULL)
-        sc->circ_buffer[1] = (float***)calloc3d(IMS_MAX_NUM_SOURCES, sc->nBands, IMS_CIRC_BUFFER_LENGTH, sizeof(float));
-
-    /* Also allocate signal buffers and filterbank handles (if this is the first time this function is being called) */
-    for(src_idx = 0; src_idx < IMS_MAX_NUM_SOURCES; src_idx++){
-        /* only allocate if source is active... */
-        if( (sc->srcs[src_idx].ID != IMS_UNASSIGNED) && (sc->src_sigs_bands[src_idx] == NULL) ){
-            if(sc->nBands>1){ /* ... and only create the filterbank if there is more than one band: */
-                faf_IIRFilterbank_create(&(sc->hFaFbank[src_idx]), IMS_IIR_FILTERBANK_ORDER, sc->band_cutofffreqs,
-                                         sc->nBands-1, sc->fs, IMS_MAX_NSAMPLES_PER_FRAME);
-            }
-            sc->src_sigs_bands[src_idx] = (float**)malloc2d(sc->nBands, IMS_MAX_NSAMPLES_PER_FRAME, sizeof(float)); 
-        }
-    }
-
     /* Find index corresponding to this receiver ID */
     rec_idx = IMS_UNASSIGNED;
     for(i=0; i<IMS_MAX_NUM_RECEIVERS; i++){
@@ -339,16 +474,9 @@ void ims_shoebox_applyEchogramTD
     }
     saf_assert(rec_idx != IMS_UNASSIGNED, "Invalid receiverID");
 
-    /* Allocate temporary buffer (if this is the first time this function is being called)  */
-    if( (sc->recs[rec_idx].ID != IMS_UNASSIGNED) && (sc->rec_sig_tmp[IMS_EG_CURRENT][rec_idx] == NULL) ){
-        sc->rec_sig_tmp[IMS_EG_CURRENT][rec_idx] = (float**)malloc2d(sc->recs[rec_idx].nChannels, IMS_MAX_NSAMPLES_PER_FRAME, sizeof(float));
-        sc->rec_sig_tmp[IMS_EG_PREV][rec_idx] = (float**)malloc2d(sc->recs[rec_idx].nChannels, IMS_MAX_NSAMPLES_PER_FRAME, sizeof(float));
-    }
+    /* Cross-fading ramps (no memory is allocated here; all buffers are allocated for up to IMS_MAX_NSAMPLES_PER_FRAME samples) */
     if(sc->framesize!=nSamples){
         sc->framesize = nSamples;
-        sc->interpolator_fIn = realloc1d(sc->interpolator_fIn, nSamples*sizeof(float));
-        sc->interpolator_fOut = realloc1d(sc->interpolator_fOut, nSamples*sizeof(float));
-        sc->tmp_frame = realloc1d(sc->tmp_frame, nSamples*sizeof(float));
         for(i=0; i<nSamples; i++){
             sc->interpolator_fIn[i] = (i+1)*1.0f/(float)nSamples;
             sc->interpolator_fOut[i] = 1.0f-sc->interpolator_fIn[i];
@@ -359,98 +487,72 @@ void ims_shoebox_applyEchogramTD
     for(ch=0; ch<sc->recs[rec_idx].nChannels; ch++) /* (looping over channels since this array is not guaranteed to be contiguous) */
         memset(sc->recs[rec_idx].sigs[ch], 0, nSamples * sizeof(float));
  
-    /* Process all active sources for this specific receiver, directly in the time-domain */
+    /* Broad-band operation */
+    nLanes = nActive = 0;
     for(src_idx = 0; src_idx < IMS_MAX_NUM_SOURCES; src_idx++){
-        if( (sc->srcs[src_idx].ID!=IMS_UNASSIGNED) && (sc->recs[rec_idx].ID!=IMS_UNASSIGNED) ){
-
-            /* Broad-band operation */
+        if(sc->srcs[src_idx].ID!=IMS_UNASSIGNED){
             if(sc->nBands==1)
                 memcpy(sc->src_sigs_bands[src_idx][0], sc->srcs[src_idx].sig, nSamples*sizeof(float));
-            else /* OR: Pass source signal through the Favrot & Faller (power-complementary) IIR filterbank */
-                faf_IIRFilterbank_apply(sc->hFaFbank[src_idx], sc->srcs[src_idx].sig, sc->src_sigs_bands[src_idx], nSamples);
+            nLanes = src_idx+1;
+            nActive++;
+        }
+        sc->fb_in[src_idx] = sc->srcs[src_idx].ID!=IMS_UNASSIGNED ? sc->srcs[src_idx].sig : NULL;
+        sc->fb_out[src_idx] = sc->src_sigs_bands[src_idx];
+    }
+
+    /* OR: Pass the source signals through the Favrot & Faller (power-complementary) IIR filterbank. Each source has its own
+     * channel. With enough sources, they are all filtered at once (and the unassigned ones in-between are fed silence). With only a
+     * few, it is faster to filter them one at a time (the channels of unassigned sources are flushed upon removal, so skipping them
+     * is the same as feeding them silence) */
+    if(sc->nBands>1){
+        if(nActive>=IMS_IIR_FILTERBANK_MIN_LANES)
+            faf_IIRFilterbank_applyMultiChannel(sc->hFaFbank, sc->fb_in, sc->fb_out, nLanes, nSamples);
+        else{
+            for(src_idx = 0; src_idx < IMS_MAX_NUM_SOURCES; src_idx++)
+                if(sc->srcs[src_idx].ID!=IMS_UNASSIGNED)
+                    faf_IIRFilterbank_applyChannel(sc->hFaFbank, src_idx, sc->srcs[src_idx].sig, sc->src_sigs_bands[src_idx], nSamples);
+        }
+    }
+
+    /* Process all active sources for this specific receiver, directly in the time-domain */
+    for(src_idx = 0; src_idx < IMS_MAX_NUM_SOURCES; src_idx++){
+        if( (sc->srcs[src_idx].ID!=IMS_UNASSIGNED) && (sc->recs[rec_idx].ID!=IMS_UNASSIGNED) ){
 
             /* Workspace handle for this source/receiver combination */
             wrk = sc->hCoreWrkSpc[rec_idx][src_idx];
 
+            /* (the circular buffers of this source were sized to suit its echograms by ims_shoebox_computeEchograms()) */
+            circ_len = sc->circ_len[src_idx];
+
             /* k=0 is for the current echogram,
              * k=1 (when applyCrossFadeFLAG is enabled) is for the previous echogram */
             for(k=sc->applyCrossFadeFLAG[rec_idx][src_idx]; k>=0; k--){
+                for(ch=0; ch<sc->recs[rec_idx].nChannels; ch++)
+                    memset(sc->rec_sig_tmp[k][rec_idx][ch], 0, nSamples*sizeof(float));
 
-                /* Loop over samples */
-                for(n=0; n<nSamples; n++){
-
-                    /* Determine write index */
-                    wIdx_n = sc->wIdx[k][rec_idx][src_idx] & IMS_CIRC_BUFFER_LENGTH_MASK;
-
-                    /* Since the time vector is the same across bands, it makes sense to determine the read-indices only once... */
-                    if(k==1)
-                        echogram_abs_0 = (echogram_data*)wrk->hPrevEchogram_abs[0];
-                    else
-                        echogram_abs_0 = (echogram_data*)wrk->hEchogram_abs[0];
-
-                    /* Handle the special case of an empty echogram */
-                    if(echogram_abs_0->numImageSources==0){
-                        /* Set output to 0... */
-                        for(ch=0; ch<sc->recs[rec_idx].nChannels; ch++)
-                            sc->rec_sig_tmp[k][rec_idx][ch][n] = 0.0f;
-
-                        /* Store current sample (per band) into the circular buffer */
-                        for(band=0; band < sc->nBands; band++){
-                            sc->circ_buffer[k][src_idx][band][wIdx_n] = sc->src_sigs_bands[src_idx][band][n];
-                            if(sc->applyCrossFadeFLAG[rec_idx][src_idx]==0)
-                                sc->circ_buffer[IMS_EG_PREV][src_idx][band][wIdx_n] = sc->src_sigs_bands[src_idx][band][n];
-                        }
-
-                        /* Increment write index */
-                        sc->wIdx[k][rec_idx][src_idx]++;
-                        if(sc->applyCrossFadeFLAG[rec_idx][src_idx]==0)
-                            sc->wIdx[IMS_EG_PREV][rec_idx][src_idx]++;
-
-                        continue; /* to next sample... */
-                    }
+                /* Since the time vector is the same across bands, it makes sense to determine the delays only once... */
+                if(k==1)
+                    echogram_abs_0 = (echogram_data*)wrk->hPrevEchogram_abs[0];
+                else
+                    echogram_abs_0 = (echogram_data*)wrk->hEchogram_abs[0];
 
+                /* (an empty echogram renders silence) */
+                if(echogram_abs_0->numImageSources>0){
                     /* Convert time from seconds to number of samples */
-                    memset(echogram_abs_0->tmp1, 0, echogram_abs_0->numImageSources*sizeof(float));
-                    cblas_saxpy(echogram_abs_0->numImageSources, (sc->fs), echogram_abs_0->time, 1, echogram_abs_0->tmp1, 1);
+                    utility_svsmul(echogram_abs_0->time, &(sc->fs), echogram_abs_0->numImageSources, echogram_abs_0->tmp1);
 
-                    /* Determine read-indices and (optionally) also the interpolation weights */
+                    /* Determine the delays and (optionally) also the interpolation filters (as indices into the look-up table) */
+                    order = sc->lagrangeOrder;
                     if(fractionalDelaysFLAG){
-                        /* Loop over all image sources, and determine the circular buffer read indices */
-                        for(im=0; im <echogram_abs_0->numImageSources; im++){
-                            /* Base read-index */
-                            time_samples = (int)(echogram_abs_0->tmp1[im]);                /* FLOOR */
-                            rIdx = IMS_CIRC_BUFFER_LENGTH-time_samples + sc->wIdx[k][rec_idx][src_idx] /* read index for this image source */
-                                   + (IMS_LAGRANGE_ORDER/2);                               /* in order to correctly centre the filter */
-                            echogram_abs_0->rIdx[im] = rIdx & IMS_CIRC_BUFFER_LENGTH_MASK; /* wrap-around if needed */
+                        for(im=0; im<echogram_abs_0->numImageSources; im++){
+                            time_samples = (int)(echogram_abs_0->tmp1[im]);            /* FLOOR */
+                            echogram_abs_0->frac_idx[im] = (int)((echogram_abs_0->tmp1[im] - (float)time_samples)*(float)IMS_LAGRANGE_LOOKUP_TABLE_SIZE + 0.5f);
+                            echogram_abs_0->delay[im] = SAF_MAX(time_samples - (order/2), 1); /* in order to correctly centre the filter (while remaining causal) */
                         }
-
-                        /* Find fractional parts */
-                        utility_svmod(echogram_abs_0->tmp1, echogram_abs_0->ones_dummy, echogram_abs_0->numImageSources, echogram_abs_0->tmp2);
-
-                        /* Find read-indices for interpolator */
-                        for(im=0; im <echogram_abs_0->numImageSources; im++){
-                            /* Centre the filter */
-                            echogram_abs_0->tmp2[im] += (float)(IMS_LAGRANGE_ORDER/2);
-
-                            /* Read-indices for lagrange interpolation */
-                            for(i=1; i<IMS_LAGRANGE_ORDER; i++){
-                                echogram_abs_0->rIdx_frac[i-1][im] = echogram_abs_0->rIdx[im] - i;
-                                /* Wrap around if needed */
-                                if(echogram_abs_0->rIdx_frac[i-1][im]<0)
-                                    echogram_abs_0->rIdx_frac[i-1][im] += IMS_CIRC_BUFFER_LENGTH;
-                            }
-                        }
-
-                        /* Compute interpolation weights */ // TODO: This line is around 50% CPU usage of the whole function, a look-up table would be faster...
-                        lagrangeWeights(IMS_LAGRANGE_ORDER, echogram_abs_0->tmp2, echogram_abs_0->numImageSources, FLATTEN2D(echogram_abs_0->h_frac));
                     }
                     else{
-                        /* Loop over all image sources, and determine the circular buffer read indices based on the nearest sample */
-                        for(im=0; im <echogram_abs_0->numImageSources; im++){
-                            time_samples = (int)(echogram_abs_0->tmp1[im] + 0.5f);         /* ROUND to nearest sample */
-                            rIdx = IMS_CIRC_BUFFER_LENGTH-time_samples + sc->wIdx[k][rec_idx][src_idx]; /* read index for this image source */
-                            echogram_abs_0->rIdx[im] = rIdx & IMS_CIRC_BUFFER_LENGTH_MASK; /* wrap-around if needed */
-                        }
+                        for(im=0; im<echogram_abs_0->numImageSources; im++)
+                            echogram_abs_0->delay[im] = (int)(echogram_abs_0->tmp1[im] + 0.5f); /* ROUND to nearest sample */
                     }
 
                     /* Loop over octave bands */
@@ -462,55 +564,38 @@ void ims_shoebox_applyEchogramTD
                             echogram_abs = (echogram_data*)wrk->hEchogram_abs[band];
                         saf_assert(echogram_abs_0->numImageSources == echogram_abs->numImageSources, "The below code is assuming that the number of image sources should be the same across octave bands!");
 
-                        /* Pull values from the circular buffer corresponding to these read indices, and store this sparse vector as a "compressed" vector */
-                        utility_ssv2cv_inds(sc->circ_buffer[k][src_idx][band], echogram_abs_0->rIdx, echogram_abs->numImageSources, echogram_abs->cb_vals[0]);
-
-                        /* Apply interpolation if enabled */
-                        if(fractionalDelaysFLAG){
-                            /* Apply the weights corresponding to the first tap in the filter */
-                            utility_svvmul(echogram_abs->cb_vals[0], echogram_abs_0->h_frac[0], echogram_abs->numImageSources, echogram_abs->tmp1);
-
-                            /* Step through the rest of the filter */
-                            for(i=1; i<IMS_LAGRANGE_ORDER; i++){
-                                /* Pull values from the circular buffer corresponding to the read-indices for the current tap in the filter */
-                                utility_ssv2cv_inds(sc->circ_buffer[k][src_idx][band], echogram_abs_0->rIdx_frac[i-1], echogram_abs->numImageSources, echogram_abs->cb_vals[0]);
-
-                                /* Apply interpolation weights */
-                                utility_svvmul(echogram_abs->cb_vals[0], echogram_abs_0->h_frac[i], echogram_abs->numImageSources, echogram_abs->tmp2);
-
-                                /* Sum */
-                                cblas_saxpy(echogram_abs->numImageSources, 1.0f, echogram_abs->tmp2, 1, echogram_abs->tmp1, 1);
-                            }
-
-                            /* Copy result */
-                            cblas_scopy(echogram_abs->numImageSources, echogram_abs->tmp1, 1, echogram_abs->cb_vals[0], 1);
+                        /* Add the delayed and scaled (per channel) band signal of each image source to the frame */
+                        for(im=0; im<echogram_abs->numImageSources; im++){
+                            if(fractionalDelaysFLAG)
+                                ims_shoebox_renderFracDelayedFrame(sc->circ_buffer[k][src_idx][band], circ_len, sc->wIdx[k][rec_idx][src_idx], sc->src_sigs_bands[src_idx][band],
+                                                                   echogram_abs_0->delay[im], &(sc->lagrangeTable[echogram_abs_0->frac_idx[im]*(order+1)]), order,
+                                                                   &(echogram_abs->value[0][im]), echogram_abs->numImageSources, sc->recs[rec_idx].nChannels,
+                                                                   nSamples, sc->tmp_frame, sc->rec_sig_tmp[k][rec_idx]);
+                            else
+                                ims_shoebox_renderDelayedFrame(sc->circ_buffer[k][src_idx][band], circ_len, sc->wIdx[k][rec_idx][src_idx], sc->src_sigs_bands[src_idx][band],
+                                                               echogram_abs_0->delay[im], &(echogram_abs->value[0][im]), echogram_abs->numImageSources,
+                                                               1.0f, sc->recs[rec_idx].nChannels, nSamples, sc->rec_sig_tmp[k][rec_idx]);
                         }
-
-                        /* Replicate these circular buffer values for all output channels */
-                        for(ch=1; ch<sc->recs[rec_idx].nChannels; ch++)
-                            cblas_scopy(echogram_abs->numImageSources, echogram_abs->cb_vals[0], 1, echogram_abs->cb_vals[ch], 1);
-
-                        /* Apply the echogram scalings to each image source - for all channels */
-                        utility_svvmul(FLATTEN2D(echogram_abs->value), FLATTEN2D(echogram_abs->cb_vals),
-                                       (sc->recs[rec_idx].nChannels)*echogram_abs->numImageSources, FLATTEN2D(echogram_abs->contrib));
-
-                        /* Render frame */
-                        for(ch=0; ch<sc->recs[rec_idx].nChannels; ch++)
-                            sc->rec_sig_tmp[k][rec_idx][ch][n] = cblas_sdot(echogram_abs->numImageSources, echogram_abs->ones_dummy,
-                                                                         1, echogram_abs->contrib[ch], 1);
-
-                        /* Store current sample into the circular buffer */
-                        sc->circ_buffer[k][src_idx][band][wIdx_n] = sc->src_sigs_bands[src_idx][band][n];
-                        if(sc->applyCrossFadeFLAG[rec_idx][src_idx]==0)
-                            sc->circ_buffer[IMS_EG_PREV][src_idx][band][wIdx_n] = sc->src_sigs_bands[src_idx][band][n];
                     }
+                }
 
-                    /* Increment write index */
-                    sc->wIdx[k][rec_idx][src_idx]++;
-                    if(sc->applyCrossFadeFLAG[rec_idx][src_idx]==0)
-                        sc->wIdx[IMS_EG_PREV][rec_idx][src_idx]++;
+                /* Store current frame (per band) into the circular buffer (only its last circ_len samples, if the frame is longer) */
+                nSamples_w = SAF_MIN(nSamples, (int)circ_len);
+                wIdx_n = (int)((sc->wIdx[k][rec_idx][src_idx] + (unsigned long)(nSamples-nSamples_w)) & (circ_len-1U));
+                nSamples_a = SAF_MIN(nSamples_w, (int)circ_len-wIdx_n); /* (before wrapping around) */
+                for(band=0; band < sc->nBands; band++){
+                    memcpy(&(sc->circ_buffer[k][src_idx][band][wIdx_n]), &(sc->src_sigs_bands[src_idx][band][nSamples-nSamples_w]), nSamples_a*sizeof(float));
+                    memcpy(sc->circ_buffer[k][src_idx][band], &(sc->src_sigs_bands[src_idx][band][nSamples-nSamples_w+nSamples_a]), (nSamples_w-nSamples_a)*sizeof(float));
+                    if(sc->applyCrossFadeFLAG[rec_idx][src_idx]==0){
+                        memcpy(&(sc->circ_buffer[IMS_EG_PREV][src_idx][band][wIdx_n]), &(sc->src_sigs_bands[src_idx][band][nSamples-nSamples_w]), nSamples_a*sizeof(float));
+                        memcpy(sc->circ_buffer[IMS_EG_PREV][src_idx][band], &(sc->src_sigs_bands[src_idx][band][nSamples-nSamples_w+nSamples_a]), (nSamples_w-nSamples_a)*sizeof(float));
+                    }
+                }
 
-                } /* Loop over samples */
+                /* Increment write index */
+                sc->wIdx[k][rec_idx][src_idx] += (unsigned long)nSamples;
+                if(sc->applyCrossFadeFLAG[rec_idx][src_idx]==0)
+                    sc->wIdx[IMS_EG_PREV][rec_idx][src_idx] += (unsigned long)nSamples;
             } /* Loop over slots */
 
             /* Cross-fade between the buffers rendered using the previous and current echograms */
@@ -592,6 +677,76 @@ void ims_shoebox_setWallAbsCoeffs
     }
 }
 
+void ims_shoebox_setThreadPool
+(
+    void* hIms,
+    void* hThreadPool
+)
+{
+    ims_scene_data *sc = (ims_scene_data*)(hIms);
+    sc->hThreadPool = hThreadPool;
+}
+
+void ims_shoebox_setFractionalDelayOrder
+(
+    void* hIms,
+    int order
+)
+{
+    ims_scene_data *sc = (ims_scene_data*)(hIms);
+    float* fractions, *weights;
+    int i, j;
+
+    saf_assert(order>=1 && order<=IMS_MAX_LAGRANGE_ORDER, "Unsupported Lagrange interpolation order");
+    sc->lagrangeOrder = order;
+
+    /* Filters for the fractions 0, 1/SIZE, ..., 1 (offset by order/2, in order to centre them) */
+    fractions = malloc1d((IMS_LAGRANGE_LOOKUP_TABLE_SIZE+1)*sizeof(float));
+    weights = malloc1d((order+1)*(IMS_LAGRANGE_LOOKUP_TABLE_SIZE+1)*sizeof(float));
+    for(i=0; i<IMS_LAGRANGE_LOOKUP_TABLE_SIZE+1; i++)
+        fractions[i] = (float)i/(float)IMS_LAGRANGE_LOOKUP_TABLE_SIZE + (float)(order/2);
+    lagrangeWeights(order, fractions, IMS_LAGRANGE_LOOKUP_TABLE_SIZE+1, weights);
+
+    /* Store the coefficients of each filter contiguously */
+    sc->lagrangeTable = realloc1d(sc->lagrangeTable, (IMS_LAGRANGE_LOOKUP_TABLE_SIZE+1)*(order+1)*sizeof(float));
+    for(i=0; i<IMS_LAGRANGE_LOOKUP_TABLE_SIZE+1; i++)
+        for(j=0; j<order+1; j++)
+            sc->lagrangeTable[i*(order+1)+j] = weights[j*(IMS_LAGRANGE_LOOKUP_TABLE_SIZE+1)+i];
+    free(fractions);
+    free(weights);
+
+    /* Longer filters also need a little more history */
+    for(i = 0; i < IMS_MAX_NUM_SOURCES; i++)
+        if(sc->srcs[i].ID != IMS_UNASSIGNED)
+            ims_shoebox_circBufferFit(sc, i);
+}
+
+long ims_shoebox_getMemoryUsage
+(
+    void* hIms
+)
+{
+    ims_scene_data *sc = (ims_scene_data*)(hIms);
+    long nBytes;
+    int i, j;
+
+    nBytes = 0;
+    for(j=0; j<IMS_MAX_NUM_SOURCES; j++){
+        if(sc->circ_buffer[IMS_EG_CURRENT][j]!=NULL)
+            nBytes += (long)(IMS_EG_NUM_SLOTS*sc->nBands*sc->circ_len[j]*sizeof(float));
+        if(sc->src_sigs_bands[j]!=NULL)
+            nBytes += (long)(sc->nBands*IMS_MAX_NSAMPLES_PER_FRAME*sizeof(float));
+    }
+    for(i=0; i<IMS_MAX_NUM_RECEIVERS; i++){
+        if(sc->rec_sig_tmp[IMS_EG_CURRENT][i]!=NULL)
+            nBytes += (long)(IMS_EG_NUM_SLOTS*sc->recs[i].nChannels*IMS_MAX_NSAMPLES_PER_FRAME*sizeof(float));
+        for(j=0; j<IMS_MAX_NUM_SOURCES; j++)
+            if(sc->rirs[i][j].data!=NULL)
+                nBytes += (long)(sc->rirs[i][j].nChannels*sc->rirs[i][j].length*sizeof(float));
+    }
+    return nBytes;
+}
+
 
 /* add/remove/update functions: */
 
@@ -643,6 +798,12 @@ int ims_shoebox_addSource
         if(sc->recs[rec].ID!=IMS_UNASSIGNED)
             ims_shoebox_coreWorkspaceCreate(&(sc->hCoreWrkSpc[rec][obj_idx]), sc->nBands);
 
+    /* Circular buffers (which grow with the echograms) and band-passed signals for this source */
+    sc->circ_len[obj_idx] = IMS_CIRC_BUFFER_MIN_LENGTH;
+    sc->circ_buffer[IMS_EG_CURRENT][obj_idx] = (float**)calloc2d(sc->nBands, IMS_CIRC_BUFFER_MIN_LENGTH, sizeof(float));
+    sc->circ_buffer[IMS_EG_PREV][obj_idx] = (float**)calloc2d(sc->nBands, IMS_CIRC_BUFFER_MIN_LENGTH, sizeof(float));
+    sc->src_sigs_bands[obj_idx] = (float**)malloc2d(sc->nBands, IMS_MAX_NSAMPLES_PER_FRAME, sizeof(float));
+
     return sc->srcs[obj_idx].ID;
 }
 
@@ -693,6 +854,10 @@ int ims_shoebox_addReceiverSH
     sc->recs[obj_idx].type = RECEIVER_SH;
     sc->recs[obj_idx].nChannels = ORDER2NSH(sh_order);
 
+    /* Temporary frames used by ims_shoebox_applyEchogramTD() */
+    sc->rec_sig_tmp[IMS_EG_CURRENT][obj_idx] = (float**)malloc2d(sc->recs[obj_idx].nChannels, IMS_MAX_NSAMPLES_PER_FRAME, sizeof(float));
+    sc->rec_sig_tmp[IMS_EG_PREV][obj_idx] = (float**)malloc2d(sc->recs[obj_idx].nChannels, IMS_MAX_NSAMPLES_PER_FRAME, sizeof(float));
+
     /* Create workspace for all receiver/source combinations, for this new receiver object */
     for(src=0; src<IMS_MAX_NUM_SOURCES; src++)
         if(sc->srcs[src].ID!=IMS_UNASSIGNED)
@@ -818,6 +983,21 @@ void ims_shoebox_removeSource
         if(sc->recs[rec].ID != IMS_UNASSIGNED)
             ims_shoebox_coreWorkspaceDestroy(&(sc->hCoreWrkSpc[rec][obj_idx]));
 
+    /* Free its circular buffers and band-passed signals, and zero its filterbank channel */
+    free(sc->circ_buffer[IMS_EG_CURRENT][obj_idx]);
+    free(sc->circ_buffer[IMS_EG_PREV][obj_idx]);
+    free(sc->src_sigs_bands[obj_idx]);
+    sc->circ_buffer[IMS_EG_CURRENT][obj_idx] = NULL;
+    sc->circ_buffer[IMS_EG_PREV][obj_idx] = NULL;
+    sc->src_sigs_bands[obj_idx] = NULL;
+    sc->circ_len[obj_idx] = 0;
+    if(sc->hFaFbank!=NULL)
+        faf_IIRFilterbank_flushChannel(sc->hFaFbank, obj_idx);
+    for(rec=0; rec<IMS_MAX_NUM_RECEIVERS; rec++){
+        sc->wIdx[IMS_EG_CURRENT][rec][obj_idx] = sc->wIdx[IMS_EG_PREV][rec][obj_idx] = 0;
+        sc->applyCrossFadeFLAG[rec][obj_idx] = 0;
+    }
+
     /* De-increment number of sources */
     sc->nSources--;
 }
@@ -846,6 +1026,12 @@ void ims_shoebox_removeReceiver
     /* Set ID to -1 (invalid, so no longer active) */
     sc->recs[obj_idx].ID = IMS_UNASSIGNED;
 
+    /* Free its temporary frames */
+    free(sc->rec_sig_tmp[IMS_EG_CURRENT][obj_idx]);
+    free(sc->rec_sig_tmp[IMS_EG_PREV][obj_idx]);
+    sc->rec_sig_tmp[IMS_EG_CURRENT][obj_idx] = NULL;
+    sc->rec_sig_tmp[IMS_EG_PREV][obj_idx] = NULL;
+
     /* Destroy workspace for all receiver/source combinations, for this dead receiver */
     for(src=0; src<IMS_MAX_NUM_SOURCES; src++)
         if(sc->srcs[src].ID != IMS_UNASSIGNED)
@@ -54,6 +54,9 @@ extern "C" {
 /** Maximum number of receivers supported by an instance of the IMS simulator */
 #define IMS_MAX_NUM_RECEIVERS 16
 
+/** Maximum order of the Lagrange fractional delay filters */
+#define IMS_MAX_LAGRANGE_ORDER 7
+
 /** Output format of the rendered room impulse responses (RIR) */
 typedef struct _ims_rir{
     float* data;        
@@ -156,6 +159,10 @@ void ims_shoebox_renderRIRs(void* hIms,
  *    of (at least) nSamples in length.
  *  - The given receiverID must exist in the simulation. If it does not, then an
  *    assertion error is triggered.
+ *  - The frame is rendered block-wise, i.e. each image source contributes a
+ *    delayed and scaled copy of the (band-passed) source signal frame. The
+ *    first frame rendered after the echograms change is cross-faded between
+ *    the previous and the new echograms.
  *
  * @param[in] hIms                 ims_shoebox handle
  * @param[in] receiverID           ID of the receiver you wish to render
@@ -179,6 +186,66 @@ void ims_shoebox_setRoomDimensions(void* hIms,
 void ims_shoebox_setWallAbsCoeffs(void* hIms,
                                   float* abs_wall);
 
+/**
+ * Sets a thread pool (see saf_threadPool_create()), over which the source/
+ * receiver combinations are spread by ims_shoebox_computeEchograms() and
+ * ims_shoebox_renderRIRs()
+ *
+ * Each combination has its own workspace, so the results do not depend on the
+ * number of threads, and no additional memory is allocated per thread. The
+ * pool is not owned by ims_shoebox, and must outlive it (or be removed by
+ * passing NULL, which is also the default, i.e. single-threaded).
+ *
+ * @note If SAF is built with FFTW, then ims_shoebox_renderRIRs() remains
+ *       single-threaded, since FFTW plans cannot be created concurrently.
+ *
+ * @test test__ims_shoebox_threaded()
+ *
+ * @param[in] hIms        ims_shoebox handle
+ * @param[in] hThreadPool Thread pool handle, or NULL
+ */
+void ims_shoebox_setThreadPool(void* hIms,
+                               void* hThreadPool);
+
+/**
+ * Sets the order of the Lagrange interpolation filters, which are used by
+ * ims_shoebox_applyEchogramTD() when fractional delays are enabled
+ *
+ * The filter coefficients are taken from a look-up table (with 1024 fractional
+ * delays per sample), which is computed by this function. The default order
+ * is 2.
+ *
+ * @test test__ims_shoebox_TD_fractionalDelays()
+ *
+ * @param[in] hIms  ims_shoebox handle
+ * @param[in] order Filter order; 1..#IMS_MAX_LAGRANGE_ORDER
+ */
+void ims_shoebox_setFractionalDelayOrder(void* hIms,
+                                         int order);
+
+/**
+ * Returns the number of bytes currently allocated for the signal buffers of
+ * the simulator
+ *
+ * This includes the circular buffers and band-passed signals of the sources
+ * (which are allocated when a source is added, and freed when it is removed),
+ * the temporary frames of the receivers used by ims_shoebox_applyEchogramTD()
+ * (allocated when a receiver is added, and freed when it is removed), and the
+ * rendered room impulse responses. The circular buffers of each source
+ * start small, and grow (in powers of 2) to twice the longest delay of its
+ * echograms, whenever ims_shoebox_computeEchograms() updates them (so that
+ * ims_shoebox_applyEchogramTD() does not allocate any memory). Therefore, if
+ * an echogram becomes more than twice as long (e.g. if maxTime_s is
+ * increased), its latest reflections will briefly miss past samples which were
+ * not kept.
+ *
+ * @test test__ims_shoebox_memoryUsage()
+ *
+ * @param[in] hIms ims_shoebox handle
+ * @returns Memory usage, in bytes
+ */
+long ims_shoebox_getMemoryUsage(void* hIms);
+
 
 /* ================== Add/Remove/Update Objects functions ==================== */
 
@@ -41,7 +41,6 @@ void ims_shoebox_echogramCreate
 {
     *phEcho = malloc1d(sizeof(echogram_data));
     echogram_data *ec = (echogram_data*)(*phEcho);
-    int i;
 
     saf_assert(include_rt_vars==0 || include_rt_vars==1, "include_rt_vars is a bool");
 
@@ -58,13 +57,8 @@ void ims_shoebox_echogramCreate
     ec->include_rt_vars = include_rt_vars;
     ec->tmp1 = NULL;
     ec->tmp2 = NULL;
-    ec->rIdx = NULL;
-    for(i=0; i<IMS_LAGRANGE_ORDER; i++)
-        ec->rIdx_frac[i] = NULL;
-    ec->h_frac = NULL;
-    ec->cb_vals = NULL;
-    ec->contrib = NULL;
-    ec->ones_dummy = NULL;
+    ec->delay = NULL;
+    ec->frac_idx = NULL;
 }
 
 void ims_shoebox_echogramResize
@@ -75,7 +69,6 @@ void ims_shoebox_echogramResize
 )
 {
     echogram_data *ec = (echogram_data*)(hEcho);
-    int i;
 
     if(ec->nChannels != nChannels || ec->numImageSources != numImageSources){
         /* Resize echogram data */
@@ -91,15 +84,8 @@ void ims_shoebox_echogramResize
         if(ec->include_rt_vars){
             ec->tmp1 = realloc1d(ec->tmp1, numImageSources*sizeof(float));
             ec->tmp2 = realloc1d(ec->tmp2, numImageSources*sizeof(float));
-            ec->rIdx = realloc1d(ec->rIdx, numImageSources*sizeof(int));
-            for(i=0; i<IMS_LAGRANGE_ORDER; i++)
-                ec->rIdx_frac[i] = realloc1d(ec->rIdx_frac[i], numImageSources*sizeof(int));
-            ec->h_frac = (float**)realloc2d((void**)ec->h_frac, IMS_LAGRANGE_ORDER+1, numImageSources, sizeof(float));
-            ec->cb_vals = (float**)realloc2d((void**)ec->cb_vals, nChannels, numImageSources, sizeof(float));
-            ec->contrib = (float**)realloc2d((void**)ec->contrib, nChannels, numImageSources, sizeof(float));
-            ec->ones_dummy = realloc1d(ec->ones_dummy, numImageSources*sizeof(float));
-            for(i=0; i<numImageSources; i++)
-                ec->ones_dummy[i] = 1.0f;
+            ec->delay = realloc1d(ec->delay, numImageSources*sizeof(int));
+            ec->frac_idx = realloc1d(ec->frac_idx, numImageSources*sizeof(int));
         }
     }
 }
@@ -141,7 +127,6 @@ void ims_shoebox_echogramDestroy
 )
 {
     echogram_data *ec = (echogram_data*)(*phEcho);
-    int i;
 
     if(ec!=NULL){
         /* Free echogram data */
@@ -155,13 +140,8 @@ void ims_shoebox_echogramDestroy
         if(ec->include_rt_vars){
             free(ec->tmp1);
             free(ec->tmp2);
-            free(ec->rIdx);
-            for(i=0; i<IMS_LAGRANGE_ORDER; i++)
-                free(ec->rIdx_frac[i]);
-            free(ec->h_frac);
-            free(ec->cb_vals);
-            free(ec->contrib);
-            free(ec->ones_dummy);
+            free(ec->delay);
+            free(ec->frac_idx);
         }
 
         free(ec);
@@ -201,6 +181,15 @@ void ims_shoebox_coreWorkspaceCreate
     wrk->s_t = wrk->s_att = NULL;
     wrk->s_ord = NULL;
 
+    /* Image source lattice */
+    wrk->nLattice = 0;
+    wrk->s_sgn_x = wrk->s_sgn_y = wrk->s_sgn_z = NULL;
+    wrk->latticeIdx = NULL;
+    wrk->s_dirs = NULL;
+    wrk->refreshAbsFLAG = 1;
+    wrk->abs_wall = (float**)calloc2d(nBands, IMS_NUM_WALLS_SHOEBOX, sizeof(float));
+    wrk->abs_lattice = NULL;
+
     /* Echogram containers */
     wrk->refreshEchogramFLAG = 1;
     ims_shoebox_echogramCreate(&(wrk->hEchogram), 0);
@@ -245,6 +234,13 @@ void ims_shoebox_coreWorkspaceDestroy
         free(wrk->s_t);
         free(wrk->s_att);
         free(wrk->s_ord);
+        free(wrk->s_sgn_x);
+        free(wrk->s_sgn_y);
+        free(wrk->s_sgn_z);
+        free(wrk->latticeIdx);
+        free(wrk->s_dirs);
+        free(wrk->abs_wall);
+        free(wrk->abs_lattice);
 
         /* Destroy echogram containers */
         ims_shoebox_echogramDestroy(&(wrk->hEchogram));
@@ -266,6 +262,77 @@ void ims_shoebox_coreWorkspaceDestroy
     }
 }
 
+/**
+ * Resizes the lattice helper variables after II, JJ, KK have been rebuilt, and
+ * flags that the cached wall attenuations need to be recomputed */
+static void ims_shoebox_latticeUpdate
+(
+    ims_core_workspace *wrk,
+    int nLattice
+)
+{
+    int i;
+
+    wrk->nLattice = nLattice;
+    wrk->s_sgn_x = realloc1d(wrk->s_sgn_x, nLattice*sizeof(float));
+    wrk->s_sgn_y = realloc1d(wrk->s_sgn_y, nLattice*sizeof(float));
+    wrk->s_sgn_z = realloc1d(wrk->s_sgn_z, nLattice*sizeof(float));
+    wrk->latticeIdx = realloc1d(wrk->latticeIdx, nLattice*sizeof(int));
+    wrk->s_dirs = realloc1d(wrk->s_dirs, nLattice*2*sizeof(float));
+    wrk->abs_lattice = (float**)realloc2d((void**)wrk->abs_lattice, wrk->nBands, nLattice, sizeof(float));
+    for(i=0; i<nLattice; i++){
+        wrk->s_sgn_x[i] = ((int)wrk->II[i]) % 2 ? -1.0f : 1.0f;
+        wrk->s_sgn_y[i] = ((int)wrk->JJ[i]) % 2 ? -1.0f : 1.0f;
+        wrk->s_sgn_z[i] = ((int)wrk->KK[i]) % 2 ? -1.0f : 1.0f;
+    }
+    wrk->refreshAbsFLAG = 1;
+}
+
+/**
+ * Computes the image source coordinates (with respect to the receiver) and
+ * distances, for all points of the lattice */
+static void ims_shoebox_latticeDistances
+(
+    ims_core_workspace *wrk,
+    float room[3],
+    ims_pos_xyz src_orig,
+    ims_pos_xyz rec_orig
+)
+{
+    int i;
+    float* s_x, *s_y, *s_z, *s_d;
+
+    s_x = wrk->s_x;
+    s_y = wrk->s_y;
+    s_z = wrk->s_z;
+    s_d = wrk->s_d;
+    for(i=0; i<wrk->nLattice; i++){
+        s_x[i] = wrk->II[i]*room[0] + wrk->s_sgn_x[i]*src_orig.x - rec_orig.x;
+        s_y[i] = wrk->JJ[i]*room[1] + wrk->s_sgn_y[i]*src_orig.y - rec_orig.y;
+        s_z[i] = wrk->KK[i]*room[2] + wrk->s_sgn_z[i]*src_orig.z - rec_orig.z;
+        s_d[i] = sqrtf(s_x[i]*s_x[i] + s_y[i]*s_y[i] + s_z[i]*s_z[i]);
+    }
+}
+
+/**
+ * Returns the attenuation due to the reflections off of a pair of opposing
+ * walls, given the (signed) reflection order along their axis, and their
+ * reflection coefficients */
+static float ims_shoebox_wallAttenuation
+(
+    int order,
+    float r_pos,
+    float r_neg
+)
+{
+    if((order%2)==0) /* ISEVEN */
+        return powf(r_pos, (float)abs(order)/2.0f) * powf(r_neg, (float)abs(order)/2.0f);
+    else if (order>0) /* ISODD AND POSITIVE */
+        return powf(r_pos, ceilf((float)order/2.0f)) * powf(r_neg, floorf((float)order/2.0f));
+    else /* ISODD AND NEGATIVE */
+        return powf(r_pos, floorf((float)abs(order)/2.0f)) * powf(r_neg, ceilf((float)abs(order)/2.0f));
+}
+
 void ims_shoebox_coreInitT
 (
     void* hWork,
@@ -333,6 +400,8 @@ void ims_shoebox_coreInitT
         wrk->s_d = realloc1d(wrk->s_d, wrk->lengthVec*sizeof(float));
         wrk->s_t = realloc1d(wrk->s_t, wrk->lengthVec*sizeof(float));
         wrk->s_att = realloc1d(wrk->s_att, wrk->lengthVec*sizeof(float));
+        ims_shoebox_latticeUpdate(wrk, wrk->lengthVec);
+        wrk->N_max = -1; /* (the lattice is no longer the one used by ims_shoebox_coreInitN()) */
     }
 
     /* Update echogram only if the source/receiver positions or room dimensions have changed */
@@ -349,12 +418,7 @@ void ims_shoebox_coreInitT
         memcpy(&(wrk->src), &src_orig, sizeof(ims_pos_xyz));
 
         /* image source coordinates with respect to receiver, and distance */
-        for(imsrc = 0; imsrc<wrk->lengthVec; imsrc++){
-            wrk->s_x[imsrc] = wrk->II[imsrc]*room[0] + powf(-1.0f, wrk->II[imsrc])*src_orig.x - rec_orig.x;
-            wrk->s_y[imsrc] = wrk->JJ[imsrc]*room[1] + powf(-1.0f, wrk->JJ[imsrc])*src_orig.y - rec_orig.y;
-            wrk->s_z[imsrc] = wrk->KK[imsrc]*room[2] + powf(-1.0f, wrk->KK[imsrc])*src_orig.z - rec_orig.z;
-            wrk->s_d[imsrc] = sqrtf(powf(wrk->s_x[imsrc], 2.0f) + powf(wrk->s_y[imsrc], 2.0f) + powf(wrk->s_z[imsrc], 2.0f));
-        }
+        ims_shoebox_latticeDistances(wrk, room, src_orig, rec_orig);
 
         /* Determine the indices where the distance is below the specified maximum */ 
         for(imsrc = 0, wrk->numImageSources = 0; imsrc<wrk->lengthVec; imsrc++){
@@ -372,6 +436,7 @@ void ims_shoebox_coreInitT
         /* Copy data into echogram struct */
         for(imsrc = 0, vIdx = 0; imsrc<wrk->lengthVec; imsrc++){
             if(wrk->validIDs[imsrc]){
+                wrk->latticeIdx[vIdx]    = imsrc;
                 echogram->time[vIdx]     = wrk->s_d[imsrc]/c_ms;
 
                 /* reflection propagation attenuation - if distance is <1m set
@@ -470,6 +535,10 @@ void ims_shoebox_coreInitN
         wrk->s_d = realloc1d(wrk->s_d, wrk->numImageSources*sizeof(float));
         wrk->s_t = realloc1d(wrk->s_t, wrk->numImageSources*sizeof(float));
         wrk->s_att = realloc1d(wrk->s_att, wrk->numImageSources*sizeof(float));
+        ims_shoebox_latticeUpdate(wrk, wrk->numImageSources);
+        for(imsrc = 0; imsrc<wrk->numImageSources; imsrc++)
+            wrk->latticeIdx[imsrc] = imsrc; /* (all lattice points are used) */
+        wrk->d_max = -1.0f; /* (the lattice is no longer the one used by ims_shoebox_coreInitT()) */
     }
 
     /* Update echogram only if the maximum reflection order, source/receiver positions or room dimensions have changed */
@@ -486,12 +555,7 @@ void ims_shoebox_coreInitN
         memcpy(&(wrk->src), &src_orig, sizeof(ims_pos_xyz));
 
         /* image source coordinates with respect to receiver, and distance */
-        for(imsrc = 0; imsrc<wrk->numImageSources; imsrc++){
-            wrk->s_x[imsrc] = wrk->II[imsrc]*room[0] + powf(-1.0f, wrk->II[imsrc])*src_orig.x - rec_orig.x;
-            wrk->s_y[imsrc] = wrk->JJ[imsrc]*room[1] + powf(-1.0f, wrk->JJ[imsrc])*src_orig.y - rec_orig.y;
-            wrk->s_z[imsrc] = wrk->KK[imsrc]*room[2] + powf(-1.0f, wrk->KK[imsrc])*src_orig.z - rec_orig.z;
-            wrk->s_d[imsrc] = sqrtf(powf(wrk->s_x[imsrc], 2.0f) + powf(wrk->s_y[imsrc], 2.0f) + powf(wrk->s_z[imsrc], 2.0f));
-        }
+        ims_shoebox_latticeDistances(wrk, room, src_orig, rec_orig);
 
         /* Resize echogram container (only done if needed) */
         ims_shoebox_echogramResize(wrk->hEchogram, wrk->numImageSources, 1/*omni-pressure*/);
@@ -530,8 +594,6 @@ void ims_shoebox_coreRecModuleSH
     echogram_data *echogram = (echogram_data*)(wrk->hEchogram);
     echogram_data *echogram_rec = (echogram_data*)(wrk->hEchogram_rec);
     int i, j, nSH;
-    float aziElev_rad[2];
-    float* sh_gains;
 
     nSH = ORDER2NSH(sh_order);
 
@@ -558,18 +620,18 @@ void ims_shoebox_coreRecModuleSH
     }
     /* Impose spherical harmonic directivities onto 'value', and store in ascending order w.r.t propagation time */
     else{
-        sh_gains = malloc1d(nSH*sizeof(float));
-        for(i=0; i<echogram_rec->numImageSources; i++){
-            /* Cartesian coordinates to spherical coordinates */
-            unitCart2sph(echogram_rec->coords[i].v, 1, 0, (float*)aziElev_rad); 
-            aziElev_rad[1] = SAF_PI/2.0f-aziElev_rad[1]; /* AziElev to AziInclination conversion */
-
-            /* Apply spherical harmonic weights */
-            getSHreal_recur(sh_order, (float*)aziElev_rad, 1, sh_gains);
-            for(j=0; j<nSH; j++)
-                echogram_rec->value[j][i] = sh_gains[j] * (echogram->value[0][echogram->sortedIdx[i]]);
-        }
-        free(sh_gains);
+        /* Cartesian coordinates to spherical coordinates (AziElev to AziInclination) */
+        unitCart2sph((float*)echogram_rec->coords, echogram_rec->numImageSources, 0, wrk->s_dirs);
+        for(i=0; i<echogram_rec->numImageSources; i++)
+            wrk->s_dirs[i*2+1] = SAF_PI/2.0f - wrk->s_dirs[i*2+1];
+
+        /* Spherical harmonic weights for all image sources; nSH x numImageSources */
+        getSHreal_recur(sh_order, wrk->s_dirs, echogram_rec->numImageSources, FLATTEN2D(echogram_rec->value));
+        for(i=0; i<echogram_rec->numImageSources; i++)
+            wrk->s_att[i] = echogram->value[0][echogram->sortedIdx[i]];
+        for(j=0; j<nSH; j++)
+            for(i=0; i<echogram_rec->numImageSources; i++)
+                echogram_rec->value[j][i] *= wrk->s_att[i];
     }
 }
 
@@ -580,10 +642,41 @@ void ims_shoebox_coreAbsorptionModule
 )
 {
     ims_core_workspace *wrk = (ims_core_workspace*)(hWork);
+    echogram_data *echogram = (echogram_data*)(wrk->hEchogram);
+    echogram_data *echogram_rec = (echogram_data*)(wrk->hEchogram_rec);
     echogram_data *echogram_abs;
-    int i,band,ch;
+    int i,band,ch,order_x,order_y,order_z;
     float r_x[2], r_y[2], r_z[2];
-    float abs_x, abs_y, abs_z, s_abs_tot;
+
+    /* The wall attenuation of each lattice point only needs to be computed
+     * again if the lattice or the absorption coefficients have changed */
+    if(!wrk->refreshAbsFLAG && memcmp(FLATTEN2D(wrk->abs_wall), FLATTEN2D(abs_wall), wrk->nBands*IMS_NUM_WALLS_SHOEBOX*sizeof(float)))
+        wrk->refreshAbsFLAG = 1;
+    if(wrk->refreshAbsFLAG){
+        memcpy(FLATTEN2D(wrk->abs_wall), FLATTEN2D(abs_wall), wrk->nBands*IMS_NUM_WALLS_SHOEBOX*sizeof(float));
+        for(band=0; band < wrk->nBands; band++){
+            /* Reflection coefficients given the absorption coefficients for x,
+             * y, z walls per frequency */
+            r_x[0] = sqrtf(1.0f - abs_wall[band][0]);
+            r_x[1] = sqrtf(1.0f - abs_wall[band][1]);
+            r_y[0] = sqrtf(1.0f - abs_wall[band][2]);
+            r_y[1] = sqrtf(1.0f - abs_wall[band][3]);
+            r_z[0] = sqrtf(1.0f - abs_wall[band][4]);
+            r_z[1] = sqrtf(1.0f - abs_wall[band][5]);
+
+            /* find total absorption coefficients by calculating the number of
+             * hits on every surface, based on the order per dimension */
+            for(i=0; i<wrk->nLattice; i++){
+                order_x = (int)(wrk->II[i] + (wrk->II[i]>0 ? 0.1f : -0.1f)); /* round */
+                order_y = (int)(wrk->JJ[i] + (wrk->JJ[i]>0 ? 0.1f : -0.1f));
+                order_z = (int)(wrk->KK[i] + (wrk->KK[i]>0 ? 0.1f : -0.1f));
+                wrk->abs_lattice[band][i] = ims_shoebox_wallAttenuation(order_x, r_x[0], r_x[1]) *
+                                            ims_shoebox_wallAttenuation(order_y, r_y[0], r_y[1]) *
+                                            ims_shoebox_wallAttenuation(order_z, r_z[0], r_z[1]);
+            }
+        }
+        wrk->refreshAbsFLAG = 0;
+    }
 
     for(band=0; band < wrk->nBands; band++){
         echogram_abs = (echogram_data*)wrk->hEchogram_abs[band];
@@ -591,49 +684,13 @@ void ims_shoebox_coreAbsorptionModule
         /* Copy "receiver" echogram data into "absorption" echogram container */
         ims_shoebox_echogramCopy(wrk->hEchogram_rec, wrk->hEchogram_abs[band]);
 
-        /* Then apply the wall absorption onto it, for this band... */
-
-        /* Reflection coefficients given the absorption coefficients for x, y, z
-         * walls per frequency */
-        r_x[0] = sqrtf(1.0f - abs_wall[band][0]);
-        r_x[1] = sqrtf(1.0f - abs_wall[band][1]);
-        r_y[0] = sqrtf(1.0f - abs_wall[band][2]);
-        r_y[1] = sqrtf(1.0f - abs_wall[band][3]);
-        r_z[0] = sqrtf(1.0f - abs_wall[band][4]);
-        r_z[1] = sqrtf(1.0f - abs_wall[band][5]);
-
-        /* find total absorption coefficients by calculating the number of hits on
-         * every surface, based on the order per dimension */
-        for(i=0; i<echogram_abs->numImageSources; i++){
-            /* Surfaces intersecting the x-axis */
-            if((echogram_abs->order[i][0]%2)==0) /* ISEVEN */
-                abs_x = powf(r_x[0], (float)abs(echogram_abs->order[i][0])/2.0f) * powf(r_x[1], (float)abs(echogram_abs->order[i][0])/2.0f);
-            else if (echogram_abs->order[i][0]>0) /* ISODD AND POSITIVE */
-                abs_x = powf(r_x[0], ceilf((float)echogram_abs->order[i][0]/2.0f)) * powf(r_x[1], floorf((float)echogram_abs->order[i][0]/2.0f));
-            else /* ISODD AND NEGATIVE */
-                abs_x = powf(r_x[0], floorf((float)abs(echogram_abs->order[i][0])/2.0f)) * powf(r_x[1], ceilf((float)abs(echogram_abs->order[i][0])/2.0f));
-
-            /* Surfaces intersecting the y-axis */
-            if((echogram_abs->order[i][1]%2)==0) /* ISEVEN */
-                abs_y = powf(r_y[0], (float)abs(echogram_abs->order[i][1])/2.0f) * powf(r_y[1], (float)abs(echogram_abs->order[i][1])/2.0f);
-            else if (echogram_abs->order[i][1]>0) /* ISODD AND POSITIVE */
-                abs_y = powf(r_y[0], ceilf((float)echogram_abs->order[i][1]/2.0f)) * powf(r_y[1], floorf((float)echogram_abs->order[i][1]/2.0f));
-            else /* ISODD AND NEGATIVE */
-                abs_y = powf(r_y[0], floorf((float)abs(echogram_abs->order[i][1])/2.0f)) * powf(r_y[1], ceilf((float)abs(echogram_abs->order[i][1])/2.0f));
-
-            /* Surfaces intersecting the y-axis */
-            if((echogram_abs->order[i][2]%2)==0) /* ISEVEN */
-                abs_z = powf(r_z[0], (float)abs(echogram_abs->order[i][2])/2.0f) * powf(r_z[1], (float)abs(echogram_abs->order[i][2])/2.0f);
-            else if (echogram_abs->order[i][2]>0) /* ISODD AND POSITIVE */
-                abs_z = powf(r_z[0], ceilf((float)echogram_abs->order[i][2]/2.0f)) * powf(r_z[1], floorf((float)echogram_abs->order[i][2]/2.0f));
-            else /* ISODD AND NEGATIVE */
-                abs_z = powf(r_z[0], floorf((float)abs(echogram_abs->order[i][2])/2.0f)) * powf(r_z[1], ceilf((float)abs(echogram_abs->order[i][2])/2.0f));
-
-            /* Apply total absorption */
-            s_abs_tot = abs_x * abs_y * abs_z; 
-            for(ch=0; ch<echogram_abs->nChannels; ch++)
-                echogram_abs->value[ch][i] *= s_abs_tot;
-        }
+        /* Then apply the wall absorption onto it, for this band (the receiver
+         * echogram is sorted, hence the double look-up) */
+        for(i=0; i<echogram_rec->numImageSources; i++)
+            echogram_abs->tmp1[i] = wrk->abs_lattice[band][wrk->latticeIdx[echogram->sortedIdx[i]]];
+        for(ch=0; ch<echogram_rec->nChannels; ch++)
+            for(i=0; i<echogram_rec->numImageSources; i++)
+                echogram_abs->value[ch][i] *= echogram_abs->tmp1[i];
     }
 }
 
@@ -708,3 +765,92 @@ void ims_shoebox_renderRIR
 
     free(temp);
 }
+
+void ims_shoebox_circBufferResize
+(
+    float*** circ_buffer,
+    int nBands,
+    unsigned long len,
+    unsigned long newLen,
+    unsigned long wIdx
+)
+{
+    float** newBuffer;
+    unsigned long n;
+    int band;
+
+    newBuffer = (float**)calloc2d(nBands, newLen, sizeof(float));
+    for(band=0; band<nBands; band++)
+        for(n=wIdx>len ? wIdx-len : 0; n<wIdx; n++)
+            newBuffer[band][n & (newLen-1U)] = (*circ_buffer)[band][n & (len-1U)];
+    free(*circ_buffer);
+    (*circ_buffer) = newBuffer;
+}
+
+void ims_shoebox_renderDelayedFrame
+(
+    float* circ_buffer,
+    unsigned long circ_len,
+    unsigned long wIdx,
+    float* sig,
+    int delay,
+    float* gain,
+    int gain_stride,
+    float scale,
+    int nChannels,
+    int nSamples,
+    float** out
+)
+{
+    unsigned long rIdx;
+    int ch, nPast, nPast_a;
+    float g;
+
+    /* The circular buffer can only hold circ_len past samples (a delay of 0 samples therefore wraps around to this maximum) */
+    delay = (int)(((unsigned long)(delay-1) & (circ_len-1U)) + 1U);
+
+    /* The first nPast output samples are taken from the circular buffer, starting at rIdx (and wrapping around after nPast_a samples) */
+    nPast = SAF_MIN(delay, nSamples);
+    rIdx = (wIdx + circ_len - (unsigned long)delay) & (circ_len-1U);
+    nPast_a = SAF_MIN(nPast, (int)(circ_len - rIdx));
+
+    for(ch=0; ch<nChannels; ch++){
+        g = scale * gain[ch*gain_stride];
+        cblas_saxpy(nPast_a, g, &circ_buffer[rIdx], 1, out[ch], 1);
+        if(nPast>nPast_a)
+            cblas_saxpy(nPast-nPast_a, g, circ_buffer, 1, &out[ch][nPast_a], 1);
+
+        /* ... and the rest are taken directly from the current input frame */
+        if(delay<nSamples)
+            cblas_saxpy(nSamples-delay, g, sig, 1, &out[ch][delay], 1);
+    }
+}
+
+void ims_shoebox_renderFracDelayedFrame
+(
+    float* circ_buffer,
+    unsigned long circ_len,
+    unsigned long wIdx,
+    float* sig,
+    int delay,
+    float* h_frac,
+    int order,
+    float* gain,
+    int gain_stride,
+    int nChannels,
+    int nSamples,
+    float* scratch,
+    float** out
+)
+{
+    int i, ch;
+
+    /* Interpolation filter (applied to the delayed input, one tap at a time) */
+    memset(scratch, 0, nSamples*sizeof(float));
+    for(i=0; i<order+1; i++)
+        ims_shoebox_renderDelayedFrame(circ_buffer, circ_len, wIdx, sig, delay+i, &h_frac[i], 1, 1.0f, 1, nSamples, &scratch);
+
+    /* Channel gains */
+    for(ch=0; ch<nChannels; ch++)
+        cblas_saxpy(nSamples, gain[ch*gain_stride], scratch, 1, out[ch], 1);
+}
@@ -48,16 +48,24 @@ extern "C" {
 #define IMS_FIR_FILTERBANK_ORDER ( 400 )
 /** IIR filter order (1st or 3rd) */
 #define IMS_IIR_FILTERBANK_ORDER ( 3 )
-/** Circular buffer length */
+/** Minimum number of active sources for which all of them are passed through
+ *  the IIR filterbank at once (vectorised across sources); with fewer, each
+ *  active source is filtered on its own, which is faster */
+#define IMS_IIR_FILTERBANK_MIN_LANES ( 3 )
+/** Maximum circular buffer length (i.e. the longest delay that can be rendered
+ *  by ims_shoebox_applyEchogramTD(), in samples) */
 #define IMS_CIRC_BUFFER_LENGTH ( 4*8192U )
-/** Circular buffer length, minus 1 */
-#define IMS_CIRC_BUFFER_LENGTH_MASK ( IMS_CIRC_BUFFER_LENGTH - 1U )
+/** Initial circular buffer length of a new source (the buffers then grow in
+ *  powers of 2, up to #IMS_CIRC_BUFFER_LENGTH, to twice the longest delay of
+ *  its echograms) */
+#define IMS_CIRC_BUFFER_MIN_LENGTH ( 1024U )
 /** Maximum number of samples that ims should expect to process at a time */
 #define IMS_MAX_NSAMPLES_PER_FRAME ( 20000 )
-/** Order of lagrange interpolation filters */
+/** Default order of lagrange interpolation filters */
 #define IMS_LAGRANGE_ORDER ( 2 )
-/** Lagrange interpolator look-up table size */
-#define IMS_LAGRANGE_LOOKUP_TABLE_SIZE ( 100 )
+/** Lagrange interpolator look-up table size (i.e. the number of fractional
+ *  delays per sample; the table has one more entry, for a fraction of 1) */
+#define IMS_LAGRANGE_LOOKUP_TABLE_SIZE ( 1024 )
 /** Index for the current echogram slot */
 #define IMS_EG_CURRENT ( 0 )
 /** Index for the previous echogram slot */
@@ -131,19 +139,12 @@ typedef struct _echogram_data
     int include_rt_vars;     /**< 0: the below vars are disabled, 1: enabled */
     float* tmp1;             /**< 1st temporary vector; numImageSources x 1 */
     float* tmp2;             /**< 2nd temporary vector; numImageSources x 1 */
-    int* rIdx;               /**< Current circular buffer read indices;
-                              *   numImageSources x 1 */
-    int* rIdx_frac[IMS_LAGRANGE_ORDER]; /**< Current circular buffer read
-                              *   indices for fractional buffers;
-                              *   IMS_LAGRANGE_ORDER x numImageSources */
-    float** h_frac;          /**< Current fractional delay coeffs;
-                              *   (IMS_LAGRANGE_ORDER+1) x numImageSources x */
-    float** cb_vals;         /**< Current circular buffer values (per channel &
-                              *   image source); nChannels x numImageSources */
-    float** contrib;         /**< Total contribution (i.e. cb_vals .* value);
-                              *   nChannels x numImageSources */
-    float* ones_dummy;       /**< Just a vector of ones, for the cblas_sdot
-                              *   sum hack, and fmodf; numImageSources x 1 */
+    int* delay;              /**< Current delay of each image source, in
+                              *   samples (for fractional delays: the delay of
+                              *   the first filter tap); numImageSources x 1 */
+    int* frac_idx;           /**< Current fractional delay of each image
+                              *   source, as an index into the Lagrange
+                              *   look-up table; numImageSources x 1 */
 
 } echogram_data;
 
@@ -171,6 +172,23 @@ typedef struct _ims_core_workspace
     int* iII, *iJJ, *iKK;
     float* s_x, *s_y, *s_z, *s_d, *s_t, *s_att;
 
+    /* Image source lattice (only rebuilt when the room dimensions, or maximum
+     * propagation time/reflection order change; and not when the source or
+     * receiver moves) */
+    int nLattice;         /**< Number of lattice points in II, JJ, KK */
+    float* s_sgn_x;       /**< (-1)^II; nLattice x 1 */
+    float* s_sgn_y;       /**< (-1)^JJ; nLattice x 1 */
+    float* s_sgn_z;       /**< (-1)^KK; nLattice x 1 */
+    int* latticeIdx;      /**< Lattice index of each image source in
+                           *   hEchogram; nLattice x 1 */
+    float* s_dirs;        /**< Image source directions [azi incl], radians;
+                           *   nLattice x 2 */
+    int refreshAbsFLAG;   /**< 1: abs_lattice needs to be recomputed, 0: no */
+    float** abs_wall;     /**< Wall absorption coefficients used to compute
+                           *   abs_lattice; nBands x 6 */
+    float** abs_lattice;  /**< Wall attenuation of each lattice point, per
+                           *   band; nBands x nLattice */
+
     /* Echograms */
     int refreshEchogramFLAG;    /**< 1: Refresh needed, 0: refresh not needed */
     void* hEchogram;            /**< Pressure echogram (single-channel) */
@@ -220,15 +238,18 @@ typedef struct _ims_scene_data
     float** H_filt;           /**< nBands x (#IMS_FIR_FILTERBANK_ORDER+1) */
     ims_rir** rirs;           /**< One per source/receiver combination */
 
-    /* Circular buffers (only used/allocated when applyEchogramTD() function is
-     * called for the first time) */
+    /* Circular buffers (allocated/freed along with each source) */
     unsigned long wIdx[IMS_EG_NUM_SLOTS][IMS_MAX_NUM_RECEIVERS][IMS_MAX_NUM_SOURCES];  /**< current write indices for circular buffers */
-    float*** circ_buffer[IMS_EG_NUM_SLOTS];  /**< [IMS_EG_NUM_SLOTS] x (nChannels x nBands x #IMS_CIRC_BUFFER_LENGTH) */
+    float** circ_buffer[IMS_EG_NUM_SLOTS][IMS_MAX_NUM_SOURCES]; /**< [IMS_EG_NUM_SLOTS] x [IMS_MAX_NUM_SOURCES] x (nBands x circ_len) */
+    unsigned long circ_len[IMS_MAX_NUM_SOURCES]; /**< Circular buffer length of each source (a power of 2) */
 
-    /* IIR filterbank (only used/allocated when applyEchogramTD() function is
-     * called for the first time) */
-    voidPtr* hFaFbank;          /**< One per source */
+    /* IIR filterbank (one channel per source) and band-passed signals
+     * (allocated/freed along with each source) */
+    void* hFaFbank;             /**< Multi-channel filterbank; one channel per
+                                 *   source (only if nBands>1) */
     float*** src_sigs_bands;    /**< nSources x nBands x nSamples */
+    float* fb_in[IMS_MAX_NUM_SOURCES];   /**< Filterbank input pointers */
+    float** fb_out[IMS_MAX_NUM_SOURCES]; /**< Filterbank output pointers */
 
     /* Temporary receiver frame used for cross-fading (only used/allocated when
      * applyEchogramTD() function is called for the first time) */
@@ -240,8 +261,19 @@ typedef struct _ims_scene_data
     int framesize;            /**< Curent framesize in samples */
 
     /* Lagrange interpolator look-up table */
-    float lookup_fractions[IMS_LAGRANGE_LOOKUP_TABLE_SIZE];
-    float lookup_H_frac[IMS_LAGRANGE_ORDER+1][IMS_LAGRANGE_LOOKUP_TABLE_SIZE];
+    int lagrangeOrder;        /**< Order of the Lagrange interpolation filters */
+    float* lagrangeTable;     /**< Filter coefficients per fractional delay;
+                               *   FLAT: (#IMS_LAGRANGE_LOOKUP_TABLE_SIZE+1) x
+                               *   (lagrangeOrder+1) */
+
+    /* Optional thread pool, over which the source/receiver combinations are
+     * spread when updating echograms and RIRs */
+    void* hThreadPool;        /**< Thread pool handle (NULL: single-threaded;
+                               *   not owned by ims_shoebox) */
+    int nPairs;               /**< Number of source/receiver combinations
+                               *   currently queued for an update */
+    int pair_rec_idx[IMS_MAX_NUM_RECEIVERS*IMS_MAX_NUM_SOURCES]; /**< Receiver index of each queued combination */
+    int pair_src_idx[IMS_MAX_NUM_RECEIVERS*IMS_MAX_NUM_SOURCES]; /**< Source index of each queued combination */
 
 } ims_scene_data;
 
@@ -369,6 +401,9 @@ void ims_shoebox_coreInitN(void* hWork,
  * Imposes spherical harmonic directivies onto the echogram computed with
  * ims_shoebox_coreInit() for a specific source/reciever combination
  *
+ * The directivities of all image sources are evaluated with one call to
+ * getSHreal_recur().
+ *
  * @note Call ims_shoebox_coreInit() before applying the directivities
  *
  * @param[in] hWork    workspace handle
@@ -384,6 +419,10 @@ void ims_shoebox_coreRecModuleSH(void* hWork,
  * Absorption coefficients are given for each of the walls on the respective
  * planes [x+ y+ z+; x- y- z-].
  *
+ * The wall attenuation only depends on the number of bounces of each image
+ * source, so it is computed once per lattice point and cached; it is only
+ * recomputed if the lattice or the absorption coefficients change.
+ *
  * @note Call ims_shoebox_coreRecModuleX before applying the absoption
  *
  * @param[in] hWork    workspace handle
@@ -409,6 +448,99 @@ void ims_shoebox_renderRIR(void* hWork,
                            float** H_filt,
                            ims_rir* rir);
 
+/**
+ * Grows the circular buffers of a source, while keeping the most recent
+ * samples (i.e. those before the current write index) in place
+ *
+ * The buffers are indexed with the write index modulo their length, so each
+ * past sample is moved to its position in the longer buffer.
+ *
+ * @param[in,out] circ_buffer Circular buffers; FLAT: nBands x len
+ * @param[in]     nBands      Number of bands
+ * @param[in]     len         Current length (a power of 2)
+ * @param[in]     newLen      New length (a power of 2, >= len)
+ * @param[in]     wIdx        Current write index of the circular buffers
+ */
+void ims_shoebox_circBufferResize(float*** circ_buffer,
+                                  int nBands,
+                                  unsigned long len,
+                                  unsigned long newLen,
+                                  unsigned long wIdx);
+
+/**
+ * Adds a delayed and scaled copy of an input frame to each channel of an
+ * output frame (i.e., renders the contribution of one image source)
+ *
+ * The samples which fall before the current frame are taken from the circular
+ * buffer, which should hold all past input samples up to (but not including)
+ * the current write index. Therefore, the current frame should only be written
+ * to the circular buffer after all of the image sources have been rendered.
+ *
+ * @param[in]  circ_buffer Circular buffer; circ_len x 1
+ * @param[in]  circ_len    Length of the circular buffer (a power of 2)
+ * @param[in]  wIdx        Current write index of the circular buffer
+ * @param[in]  sig         Current input frame; nSamples x 1
+ * @param[in]  delay       Delay, in samples (wrapped to the range 1..
+ *                         circ_len)
+ * @param[in]  gain        Gain per channel; accessed as: gain[ch*gain_stride]
+ * @param[in]  gain_stride Stride between the gains of consecutive channels
+ * @param[in]  scale       Scaling applied to all of the gains
+ * @param[in]  nChannels   Number of output channels
+ * @param[in]  nSamples    Number of samples in the frame
+ * @param[out] out         Output frame, to which the result is added;
+ *                         nChannels x nSamples
+ */
+void ims_shoebox_renderDelayedFrame(float* circ_buffer,
+                                    unsigned long circ_len,
+                                    unsigned long wIdx,
+                                    float* sig,
+                                    int delay,
+                                    float* gain,
+                                    int gain_stride,
+                                    float scale,
+                                    int nChannels,
+                                    int nSamples,
+                                    float** out);
+
+/**
+ * Adds a fractionally delayed and scaled copy of an input frame to each
+ * channel of an output frame (i.e., renders the contribution of one image
+ * source with a Lagrange interpolation filter)
+ *
+ * The input frame is first filtered (once) with the interpolation filter,
+ * and the result is then added to each channel with its respective gain.
+ * The circular buffer conventions are the same as for
+ * ims_shoebox_renderDelayedFrame().
+ *
+ * @param[in]  circ_buffer Circular buffer; circ_len x 1
+ * @param[in]  circ_len    Length of the circular buffer (a power of 2)
+ * @param[in]  wIdx        Current write index of the circular buffer
+ * @param[in]  sig         Current input frame; nSamples x 1
+ * @param[in]  delay       Delay of the first filter tap, in samples
+ * @param[in]  h_frac      Interpolation filter; (order+1) x 1
+ * @param[in]  order       Interpolation filter order
+ * @param[in]  gain        Gain per channel; accessed as: gain[ch*gain_stride]
+ * @param[in]  gain_stride Stride between the gains of consecutive channels
+ * @param[in]  nChannels   Number of output channels
+ * @param[in]  nSamples    Number of samples in the frame
+ * @param[in]  scratch     Scratch buffer; nSamples x 1
+ * @param[out] out         Output frame, to which the result is added;
+ *                         nChannels x nSamples
+ */
+void ims_shoebox_renderFracDelayedFrame(float* circ_buffer,
+                                        unsigned long circ_len,
+                                        unsigned long wIdx,
+                                        float* sig,
+                                        int delay,
+                                        float* h_frac,
+                                        int order,
+                                        float* gain,
+                                        int gain_stride,
+                                        int nChannels,
+                                        int nSamples,
+                                        float* scratch,
+                                        float** out);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
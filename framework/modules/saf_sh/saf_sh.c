@@ -474,8 +474,6 @@ void complex2realCoeffs
     free(R_N_c);
 }
 
-/* Ivanic, J., Ruedenberg, K. (1998). Rotation Matrices for Real Spherical Harmonics. Direct Determination
- * by Recursion Page: Additions and Corrections. Journal of Physical Chemistry A, 102(45), 9099?9100. */
 void getSHrotMtxReal
 (
     float Rxyz[3][3],
@@ -483,26 +481,53 @@ void getSHrotMtxReal
     int L
 )
 {
-    int i, j, M, l, m, n, d, bandIdx, denom;
-    float u, v, w;
-    float R_1[3][3], _R_lm1[64*64], _R_l[64*64];
-    float* R_lm1, *R_l;
+    int i, M, l, bandIdx, offset, nl;
+    float _RotMtx_packed[ORDER2NSHROT(7)];
+    float* RotMtx_packed;
 
     /* Prep */
     M = (L+1) * (L+1);
-    if(L<=7){
-        R_lm1 = _R_lm1;
-        R_l = _R_l;
-    }
-    else{
-        R_lm1 = malloc1d(M*M*sizeof(float));
-        R_l = malloc1d(M*M*sizeof(float));
-    }
+    if(L<=7)
+        RotMtx_packed = _RotMtx_packed;
+    else
+        RotMtx_packed = malloc1d(ORDER2NSHROT(L)*sizeof(float));
     memset(RotMtx, 0, M*M*sizeof(float));
-    
+
+    /* Compute the block for each order, and place them along the diagonal */
+    getSHrotMtxRealPacked(Rxyz, RotMtx_packed, L);
+    bandIdx = offset = 0;
+    for(l=0; l<=L; l++){
+        nl = 2*l+1;
+        for(i=0; i<nl; i++)
+            memcpy(RotMtx + (bandIdx + i)*M + bandIdx, RotMtx_packed + offset + i*nl, nl*sizeof(float));
+        bandIdx += nl;
+        offset += nl*nl;
+    }
+
+    /* clean-up */
+    if(L>7)
+        free(RotMtx_packed);
+}
+
+/* Ivanic, J., Ruedenberg, K. (1998). Rotation Matrices for Real Spherical Harmonics. Direct Determination
+ * by Recursion Page: Additions and Corrections. Journal of Physical Chemistry A, 102(45), 9099?9100. */
+void getSHrotMtxRealPacked
+(
+    float Rxyz[3][3],
+    float* RotMtx_packed/*ORDER2NSHROT(L) x 1 */,
+    int L
+)
+{
+    int i, j, l, m, n, d, denom;
+    float u, v, w;
+    float R_1[3][3];
+    float* R_lm1, *R_l;
+
     /* zeroth-band (l=0) is invariant to rotation */
-    RotMtx[0] = 1;
-    
+    RotMtx_packed[0] = 1.0f;
+    if(L<1)
+        return;
+
     /* the first band (l=1) is directly related to the rotation matrix */
     R_1[0][0] = Rxyz[1][1];
     R_1[0][1] = Rxyz[1][2];
@@ -513,19 +538,16 @@ void getSHrotMtxReal
     R_1[2][0] = Rxyz[0][1];
     R_1[2][1] = Rxyz[0][2];
     R_1[2][2] = Rxyz[0][0];
-    for (i=1; i<4; i++){
-        R_lm1[(i-1)*M+0] = R_1[i-1][0];
-        R_lm1[(i-1)*M+1] = R_1[i-1][1];
-        R_lm1[(i-1)*M+2] = R_1[i-1][2];
-        for (j=1; j<4; j++)
-            RotMtx[i*M+j] = R_1[i-1][j-1];
-    }
-    
-    /* compute rotation matrix of each subsequent band recursively */
-    bandIdx = 4;
+    R_l = RotMtx_packed + 1;
+    for (i=0; i<3; i++)
+        for (j=0; j<3; j++)
+            R_l[i*3+j] = R_1[i][j];
+
+    /* compute rotation matrix of each subsequent band recursively (from the
+     * block of the previous band, which has a row stride of 2l-1) */
     for(l = 2; l<=L; l++){
-        for(i=0; i<2*l+1; i++)
-            memset(R_l + i*M, 0, (2*l+1) * sizeof(float));
+        R_lm1 = R_l;
+        R_l = R_lm1 + (2*l-1)*(2*l-1);
         for(m=-l; m<=l; m++){
             for(n=-l; n<=l; n++){
                 /* compute u,v,w terms of Eq.8.1 (Table I) */
@@ -534,31 +556,46 @@ void getSHrotMtxReal
                 u = sqrtf( (float)((l*l-m*m)) /  (float)denom);
                 v = sqrtf( (float)((1+d)*(l+abs(m)-1)*(l+abs(m))) /  (float)denom) * (float)(1-2*d)*0.5f;
                 w = sqrtf( (float)((l-abs(m)-1)*(l-abs(m))) / (float)denom) * (float)(1-d)*(-0.5f);
-                
+
                 /* computes Eq.8.1 */
                 if (u!=0)
-                    u = u* getU(M,l,m,n,R_1,R_lm1);
+                    u = u* getU(2*l-1,l,m,n,R_1,R_lm1);
                 if (v!=0)
-                    v = v* getV(M,l,m,n,R_1,R_lm1);
+                    v = v* getV(2*l-1,l,m,n,R_1,R_lm1);
                 if (w!=0)
-                    w = w* getW(M,l,m,n,R_1,R_lm1);
-                
-                R_l[(m+l)*M+(n+l)] = u+v+w;
+                    w = w* getW(2*l-1,l,m,n,R_1,R_lm1);
+
+                R_l[(m+l)*(2*l+1)+(n+l)] = u+v+w;
             }
         }
-        
-        for(i=0; i<2*l+1; i++)
-            for(j=0; j<2*l+1; j++)
-                RotMtx[(bandIdx + i)*M + (bandIdx + j)] = R_l[i*M+j];
-        for(i=0; i<2*l+1; i++)
-            memcpy(R_lm1+i*M, R_l + i*M, (2*l+1) * sizeof(float));
-        bandIdx += 2*l+1;
     }
+}
 
-    /* clean-up */
-    if(L>7){
-        free(R_lm1);
-        free(R_l);
+void applySHrotMtxRealPacked
+(
+    float* RotMtx_packed,
+    int L,
+    float* inSig,
+    int signalLength,
+    float* outSig
+)
+{
+    int l, nl, bandIdx, offset;
+
+    /* zeroth-band is invariant to rotation */
+    cblas_scopy(signalLength, inSig, 1, outSig, 1);
+
+    /* Each of the higher bands are only rotated by their own block */
+    bandIdx = 1;
+    offset = 1;
+    for(l=1; l<=L; l++){
+        nl = 2*l+1;
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nl, signalLength, nl, 1.0f,
+                    RotMtx_packed + offset, nl,
+                    inSig + bandIdx*signalLength, signalLength, 0.0f,
+                    outSig + bandIdx*signalLength, signalLength);
+        bandIdx += nl;
+        offset += nl*nl;
     }
 }
 
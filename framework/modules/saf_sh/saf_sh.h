@@ -53,6 +53,11 @@ extern "C" {
  * Converts number of spherical harmonic components to spherical harmonic order
  * i.e: sqrt(nSH)-1 */
 #define NSH2ORDER(nSH) ( (int)(sqrt((double)nSH)-0.999) )
+/**
+ * Number of elements in a packed block-diagonal spherical harmonic rotation
+ * matrix of a given order (see getSHrotMtxRealPacked()),
+ * i.e: sum_{l=0}^{order} (2l+1)^2 */
+#define ORDER2NSHROT(order) ( ((order)+1)*(2*(order)+1)*(2*(order)+3)/3 )
 
 /* ========================================================================== */
 /*                                    Enums                                   */
@@ -327,6 +332,51 @@ void getSHrotMtxReal(float R[3][3],
                      float* RotMtx,
                      int L);
 
+/**
+ * Generates a real-valued spherical harmonic rotation matrix (the same as
+ * getSHrotMtxReal()), but stored in a packed block-diagonal format
+ *
+ * Since the rotation only mixes components of the same order, the rotation
+ * matrix is block-diagonal, with one (2l+1) x (2l+1) block per order l. These
+ * blocks are stored consecutively (each in row-major order), with the block of
+ * order l starting at element ORDER2NSHROT(l-1). The matrix should then be
+ * applied using applySHrotMtxRealPacked(), which skips all of the zeros.
+ *
+ * @param[in]  R             The 3x3 rotation matrix
+ * @param[in]  L             Order of spherical harmonic expansion
+ * @param[out] RotMtx_packed Packed SH domain rotation matrix;
+ *                           ORDER2NSHROT(L) x 1
+ */
+void getSHrotMtxRealPacked(float R[3][3],
+                           float* RotMtx_packed,
+                           int L);
+
+/**
+ * Applies a packed block-diagonal spherical harmonic rotation matrix (see
+ * getSHrotMtxRealPacked()) to spherical harmonic signals
+ *
+ * The result is the same as:
+ * \code{.m}
+ *     outSig = RotMtx * inSig; % where inSig/outSig are: (L+1)^2 x signalLength
+ * \endcode
+ * but only the blocks along the diagonal are applied; i.e. ORDER2NSHROT(L)
+ * rather than (L+1)^4 multiplications per sample.
+ *
+ * @warning The signals should follow the ACN channel ordering convention!
+ *
+ * @param[in]  RotMtx_packed Packed SH domain rotation matrix;
+ *                           ORDER2NSHROT(L) x 1
+ * @param[in]  L             Order of spherical harmonic expansion
+ * @param[in]  inSig         Input SH signals; FLAT: (L+1)^2 x signalLength
+ * @param[in]  signalLength  Number of samples
+ * @param[out] outSig        Rotated SH signals; FLAT: (L+1)^2 x signalLength
+ */
+void applySHrotMtxRealPacked(float* RotMtx_packed,
+                             int L,
+                             float* inSig,
+                             int signalLength,
+                             float* outSig);
+
 /**
  * Computes the matrices which generate the coefficients of a beampattern of
  * order (sectorOrder+1) that is essentially the product of a pattern of
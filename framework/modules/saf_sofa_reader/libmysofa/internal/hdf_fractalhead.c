@@ -69,30 +69,30 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
     reader->recursive_counter++;
 
   /* read signature */
-  if (fread(buf, 1, 4, reader->fhd) != 4 || strncmp(buf, "FHDB", 4)) {
+  if (readerRead(reader, buf, 4) != 4 || strncmp(buf, "FHDB", 4)) {
     // LCOV_EXCL_START
     mylog("cannot read signature of fractal heap indirect block\n");
     return MYSOFA_INVALID_FORMAT;
     // LCOV_EXCL_STOP
   }
   buf[4] = 0;
-  mylog("%08" PRIX64 " %.4s stack %d\n", (uint64_t)ftell(reader->fhd) - 4, buf,
+  mylog("%08" PRIX64 " %.4s stack %d\n", (uint64_t)readerTell(reader) - 4, buf,
         reader->recursive_counter);
 
-  if (fgetc(reader->fhd) != 0) {
+  if (readerGetc(reader) != 0) {
     mylog("object FHDB must have version 0\n"); // LCOV_EXCL_LINE
     return MYSOFA_UNSUPPORTED_FORMAT;           // LCOV_EXCL_LINE
   }
 
   /* ignore heap_header_address */
-  if (fseek(reader->fhd, reader->superblock.size_of_offsets, SEEK_CUR) < 0)
+  if (readerSeek(reader, reader->superblock.size_of_offsets, SEEK_CUR) < 0)
     return errno; // LCOV_EXCL_LINE
 
   size = (fractalheap->maximum_heap_size + 7) / 8;
   block_offset = readValue(reader, size);
 
   if (fractalheap->flags & 2)
-    if (fseek(reader->fhd, 4, SEEK_CUR))
+    if (readerSeek(reader, 4, SEEK_CUR))
       return errno; // LCOV_EXCL_LINE
 
   offset_size = (int)ceilf(log2f(fractalheap->maximum_heap_size) / 8);
@@ -136,14 +136,14 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
 
    */
   do {
-    typeandversion = (uint8_t)fgetc(reader->fhd);
+    typeandversion = (uint8_t)readerGetc(reader);
     offset = readValue(reader, offset_size);
     length = readValue(reader, length_size);
     if (offset > 0x10000000 || length > 0x10000000)
       return MYSOFA_UNSUPPORTED_FORMAT; // LCOV_EXCL_LINE
 
     mylog(" %d %4" PRIX64 " %" PRIX64 " %08lX\n", typeandversion, offset,
-          length, ftell(reader->fhd) - 1 - offset_size - length_size);
+          length, readerTell(reader) - 1 - offset_size - length_size);
 
     /* TODO: for the following part, the specification is incomplete */
     if (typeandversion == 3) {
@@ -158,7 +158,7 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
 
       if (!(name = malloc(length + 1)))
         return MYSOFA_NO_MEMORY; // LCOV_EXCL_LINE
-      if (fread(name, 1, length, reader->fhd) != length) {
+      if (readerRead(reader, name, length) != length) {
         free(name);               // LCOV_EXCL_LINE
         return MYSOFA_READ_ERROR; // LCOV_EXCL_LINE
       }
@@ -185,7 +185,7 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
           free(name);              // LCOV_EXCL_LINE
           return MYSOFA_NO_MEMORY; // LCOV_EXCL_LINE
         }
-        if ( (int)fread(value, 1, len, reader->fhd) != len) {
+        if ( (int)readerRead(reader, value, len) != len) {
           free(value);              // LCOV_EXCL_LINE
           free(name);               // LCOV_EXCL_LINE
           return MYSOFA_READ_ERROR; // LCOV_EXCL_LINE
@@ -228,7 +228,7 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
         if (unknown3 != 0x0000)
           return MYSOFA_INVALID_FORMAT;
 
-        len = fgetc(reader->fhd);
+        len = readerGetc(reader);
         if (len < 0)
           return MYSOFA_READ_ERROR; // LCOV_EXCL_LINE
         if (len > MAX_NAME_LENGTH)
@@ -236,7 +236,7 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
 
         if (!(name = malloc(len + 1)))
           return MYSOFA_NO_MEMORY; // LCOV_EXCL_LINE
-        if ((int)fread(name, 1, len, reader->fhd) != len) {
+        if ((int)readerRead(reader, name, len) != len) {
           free(name);               // LCOV_EXCL_LINE
           return MYSOFA_READ_ERROR; // LCOV_EXCL_LINE
         }
@@ -259,8 +259,8 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
         dir->next = dataobject->directory;
         dataobject->directory = dir;
 
-        store = ftell(reader->fhd);
-        if (fseek(reader->fhd, (long)heap_header_address, SEEK_SET)) {
+        store = readerTell(reader);
+        if (readerSeek(reader, (long)heap_header_address, SEEK_SET)) {
           free(name);   // LCOV_EXCL_LINE
           return errno; // LCOV_EXCL_LINE
         }
@@ -273,7 +273,7 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
         if (store < 0) {
           return errno; // LCOV_EXCL_LINE
         }
-        if (fseek(reader->fhd, store, SEEK_SET) < 0)
+        if (readerSeek(reader, store, SEEK_SET) < 0)
           return errno; // LCOV_EXCL_LINE
         break;
       case 0x00080008:
@@ -347,7 +347,7 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
           return MYSOFA_NO_MEMORY; // LCOV_EXCL_LINE
         len = -1;
         for (int i = 0; i < MAX_NAME_LENGTH; i++) {
-          int c = fgetc(reader->fhd);
+          int c = readerGetc(reader);
           if (c < 0 || i == MAX_NAME_LENGTH - 1) {
             free(name);               // LCOV_EXCL_LINE
             return MYSOFA_READ_ERROR; // LCOV_EXCL_LINE
@@ -391,7 +391,7 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
           free(name);              // LCOV_EXCL_LINE
           return MYSOFA_NO_MEMORY; // LCOV_EXCL_LINE
         }
-        if ((int)fread(value, 1, len, reader->fhd) != len) {
+        if ((int)readerRead(reader, value, len) != len) {
           free(value);              // LCOV_EXCL_LINE
           free(name);               // LCOV_EXCL_LINE
           return MYSOFA_READ_ERROR; // LCOV_EXCL_LINE
@@ -416,7 +416,7 @@ static int directblockRead(struct READER *reader, struct DATAOBJECT *dataobject,
         // LCOV_EXCL_START
       default:
         mylog("FHDB type 1 unsupported values %08" PRIX64 " %" PRIX64 "\n",
-              unknown2, (uint64_t)ftell(reader->fhd) - 4);
+              unknown2, (uint64_t)readerTell(reader) - 4);
         return MYSOFA_UNSUPPORTED_FORMAT;
         // LCOV_EXCL_STOP
       }
@@ -454,14 +454,14 @@ static int indirectblockRead(struct READER *reader,
   UNUSED(filter_mask);
 
   /* read signature */
-  if (fread(buf, 1, 4, reader->fhd) != 4 || strncmp(buf, "FHIB", 4)) {
+  if (readerRead(reader, buf, 4) != 4 || strncmp(buf, "FHIB", 4)) {
     mylog("cannot read signature of fractal heap indirect block\n");
     return MYSOFA_INVALID_FORMAT;
   }
   buf[4] = 0;
-  mylog("%08" PRIX64 " %.4s\n", (uint64_t)ftell(reader->fhd) - 4, buf);
+  mylog("%08" PRIX64 " %.4s\n", (uint64_t)readerTell(reader) - 4, buf);
 
-  if (fgetc(reader->fhd) != 0) {
+  if (readerGetc(reader) != 0) {
     mylog("object FHIB must have version 0\n");
     return MYSOFA_UNSUPPORTED_FORMAT;
   }
@@ -508,15 +508,15 @@ static int indirectblockRead(struct READER *reader,
     }
     mylog(">> %d %" PRIX64 " %d\n", k, child_direct_block, size);
     if (validAddress(reader, child_direct_block)) {
-      store = ftell(reader->fhd);
-      if (fseek(reader->fhd, (long)child_direct_block, SEEK_SET) < 0)
+      store = readerTell(reader);
+      if (readerSeek(reader, (long)child_direct_block, SEEK_SET) < 0)
         return errno;
       err = directblockRead(reader, dataobject, fractalheap);
       if (err)
         return err;
       if (store < 0)
         return MYSOFA_READ_ERROR;
-      if (fseek(reader->fhd, store, SEEK_SET) < 0)
+      if (readerSeek(reader, store, SEEK_SET) < 0)
         return errno;
     }
 
@@ -528,15 +528,15 @@ static int indirectblockRead(struct READER *reader,
         readValue(reader, reader->superblock.size_of_offsets);
 
     if (validAddress(reader, child_direct_block)) {
-      store = ftell(reader->fhd);
-      if (fseek(reader->fhd, (long)child_indirect_block, SEEK_SET) < 0)
+      store = readerTell(reader);
+      if (readerSeek(reader, (long)child_indirect_block, SEEK_SET) < 0)
         return errno;
       err = indirectblockRead(reader, dataobject, fractalheap, iblock_size * 2);
       if (err)
         return err;
       if (store < 0)
         return MYSOFA_READ_ERROR;
-      if (fseek(reader->fhd, store, SEEK_SET) < 0)
+      if (readerSeek(reader, store, SEEK_SET) < 0)
         return errno;
     }
 
@@ -567,14 +567,14 @@ int fractalheapRead(struct READER *reader, struct DATAOBJECT *dataobject,
   char buf[5];
 
   /* read signature */
-  if (fread(buf, 1, 4, reader->fhd) != 4 || strncmp(buf, "FRHP", 4)) {
+  if (readerRead(reader, buf, 4) != 4 || strncmp(buf, "FRHP", 4)) {
     mylog("cannot read signature of fractal heap\n");
     return MYSOFA_UNSUPPORTED_FORMAT;
   }
   buf[4] = 0;
-  mylog("%" PRIX64 " %.4s\n", (uint64_t)ftell(reader->fhd) - 4, buf);
+  mylog("%" PRIX64 " %.4s\n", (uint64_t)readerTell(reader) - 4, buf);
 
-  if (fgetc(reader->fhd) != 0) {
+  if (readerGetc(reader) != 0) {
     mylog("object fractal heap must have version 0\n");
     return MYSOFA_UNSUPPORTED_FORMAT;
   }
@@ -583,7 +583,7 @@ int fractalheapRead(struct READER *reader, struct DATAOBJECT *dataobject,
   fractalheap->encoded_length = (uint16_t)readValue(reader, 2);
   if (fractalheap->encoded_length > 0x8000)
     return MYSOFA_UNSUPPORTED_FORMAT;
-  fractalheap->flags = (uint8_t)fgetc(reader->fhd);
+  fractalheap->flags = (uint8_t)readerGetc(reader);
   fractalheap->maximum_size = (uint32_t)readValue(reader, 4);
 
   fractalheap->next_huge_object_id =
@@ -636,13 +636,12 @@ int fractalheapRead(struct READER *reader, struct DATAOBJECT *dataobject,
     if (!fractalheap->filter_information)
       return MYSOFA_NO_MEMORY;
 
-    if (fread(fractalheap->filter_information, 1, fractalheap->encoded_length,
-              reader->fhd) != fractalheap->encoded_length) {
+    if (readerRead(reader, fractalheap->filter_information, fractalheap->encoded_length) != fractalheap->encoded_length) {
       return MYSOFA_READ_ERROR;
     }
   }
 
-  if (fseek(reader->fhd, 4, SEEK_CUR) < 0) { /* skip checksum */
+  if (readerSeek(reader, 4, SEEK_CUR) < 0) { /* skip checksum */
     return MYSOFA_READ_ERROR;
   }
 
@@ -658,7 +657,7 @@ int fractalheapRead(struct READER *reader, struct DATAOBJECT *dataobject,
 
   if (validAddress(reader, fractalheap->address_of_root_block)) {
 
-    if (fseek(reader->fhd, (long)fractalheap->address_of_root_block, SEEK_SET) < 0)
+    if (readerSeek(reader, (long)fractalheap->address_of_root_block, SEEK_SET) < 0)
       return errno;
     if (fractalheap->current_row)
       err = indirectblockRead(reader, dataobject, fractalheap,
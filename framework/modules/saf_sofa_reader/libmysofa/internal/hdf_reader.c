@@ -42,9 +42,205 @@
 #include <assert.h>
 #include "hdf_reader.h"
 
+#ifdef _WIN32
+# include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# define MYSOFA_USE_MMAP
+#endif
+
 /* Only external library requirement is zlib: */
 #include "saf_externals.h"
 
+/* ========================================================================== */
+/*                                   Reader                                   */
+/* ========================================================================== */
+
+/* The whole file is made available in memory, so that parsing it amounts to
+ * decoding values straight from memory, rather than going through stdio for
+ * every byte. The file is memory-mapped where possible, and otherwise read in
+ * one go (in blocks of this many bytes). */
+#define READER_BLOCK_SIZE (1 << 20)
+
+static int readerMap(struct READER *reader, const char *filename) {
+#if defined(_WIN32)
+	HANDLE hFile, hMapping;
+	LARGE_INTEGER size;
+	void *view = NULL;
+
+	hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return 0;
+	if (GetFileSizeEx(hFile, &size) && size.QuadPart > 0) {
+		hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (hMapping != NULL) {
+			view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(hMapping); /* the view keeps the mapping alive */
+		}
+	}
+	CloseHandle(hFile);
+	if (view == NULL)
+		return 0;
+	reader->data = (const uint8_t *)view;
+	reader->size = (uint64_t)size.QuadPart;
+	reader->mapped = 1;
+	return 1;
+#elif defined(MYSOFA_USE_MMAP)
+	int fd;
+	struct stat st;
+	void *view = MAP_FAILED;
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		return 0;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+		view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); /* the mapping stays valid */
+	if (view == MAP_FAILED)
+		return 0;
+	reader->data = (const uint8_t *)view;
+	reader->size = (uint64_t)st.st_size;
+	reader->mapped = 1;
+	return 1;
+#else
+	UNUSED(reader);
+	UNUSED(filename);
+	return 0;
+#endif
+}
+
+static int readerBuffer(struct READER *reader, FILE *fhd) {
+	uint8_t *buffer = NULL, *tmp;
+	size_t size = 0, capacity = 0, n;
+
+	do {
+		if (size == capacity) {
+			capacity += READER_BLOCK_SIZE;
+			if (!(tmp = realloc(buffer, capacity))) {
+				free(buffer);            // LCOV_EXCL_LINE
+				return MYSOFA_NO_MEMORY; // LCOV_EXCL_LINE
+			}
+			buffer = tmp;
+		}
+		n = fread(buffer + size, 1, capacity - size, fhd);
+		size += n;
+	} while (n > 0);
+	if (ferror(fhd)) {
+		free(buffer);             // LCOV_EXCL_LINE
+		return MYSOFA_READ_ERROR; // LCOV_EXCL_LINE
+	}
+	reader->data = buffer;
+	reader->size = size;
+	reader->mapped = 0;
+	return MYSOFA_OK;
+}
+
+/* opens a file ("-" for stdin), returns MYSOFA_OK or an error code */
+int readerOpen(struct READER *reader, const char *filename) {
+	FILE *fhd;
+	int err;
+
+	reader->data = NULL;
+	reader->size = 0;
+	reader->pos = 0;
+	reader->mapped = 0;
+
+	if (!strcmp(filename, "-"))
+		return readerBuffer(reader, stdin);
+	if (readerMap(reader, filename))
+		return MYSOFA_OK;
+
+	/* e.g. empty files, pipes, or platforms without mapping support */
+	fhd = fopen(filename, "rb");
+	if (!fhd)
+		return errno ? errno : MYSOFA_READ_ERROR;
+	err = readerBuffer(reader, fhd);
+	fclose(fhd);
+	return err;
+}
+
+void readerClose(struct READER *reader) {
+	if (reader->mapped) {
+#if defined(_WIN32)
+		UnmapViewOfFile((LPCVOID)reader->data);
+#elif defined(MYSOFA_USE_MMAP)
+		munmap((void *)reader->data, (size_t)reader->size);
+#endif
+	}
+	else
+		free((void *)reader->data);
+	reader->data = NULL;
+	reader->size = 0;
+	reader->pos = 0;
+}
+
+/* like fgetc() */
+int readerGetc(struct READER *reader) {
+	if (reader->pos >= reader->size)
+		return EOF;
+	return reader->data[reader->pos++];
+}
+
+/* like fread(buf, 1, length, fhd) */
+size_t readerRead(struct READER *reader, void *buf, size_t length) {
+	uint64_t available;
+
+	available = reader->pos < reader->size ? reader->size - reader->pos : 0;
+	if (length > available)
+		length = (size_t)available;
+	if (length > 0)
+		memcpy(buf, reader->data + reader->pos, length);
+	reader->pos += length;
+	return length;
+}
+
+/* returns a pointer to the next 'length' bytes and skips them, or NULL if
+ * there are fewer bytes left; avoids copying e.g. compressed chunks */
+const char *readerData(struct READER *reader, size_t length) {
+	const char *data;
+
+	if (reader->pos > reader->size || length > reader->size - reader->pos)
+		return NULL;
+	data = (const char *)reader->data + reader->pos;
+	reader->pos += length;
+	return data;
+}
+
+/* like fseek() */
+int readerSeek(struct READER *reader, long offset, int whence) {
+	int64_t base;
+
+	switch (whence) {
+	case SEEK_SET:
+		base = 0;
+		break;
+	case SEEK_CUR:
+		base = (int64_t)reader->pos;
+		break;
+	case SEEK_END:
+		base = (int64_t)reader->size;
+		break;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+	if (base + offset < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+	reader->pos = (uint64_t)(base + offset);
+	return 0;
+}
+
+/* like ftell() */
+long readerTell(struct READER *reader) {
+	return (long)reader->pos;
+}
+
 /* ========================================================================== */
 /*                                 HDF Reader                                 */
 /* ========================================================================== */
@@ -58,18 +254,21 @@ int validAddress(struct READER *reader, uint64_t address) {
 
 /* little endian */
 uint64_t readValue(struct READER *reader, int size) {
-	int i, c;
+	int i;
 	uint64_t value;
-	c = fgetc(reader->fhd);
-	if (c < 0)
+	const uint8_t *p;
+	if (size < 1)
+		size = 1;
+	if (reader->pos >= reader->size || (uint64_t)size > reader->size - reader->pos) {
+		if (reader->pos < reader->size)
+			reader->pos = reader->size; /* as if read up to the end */
 		return 0xffffffffffffffffLL;
-	value = (uint8_t)c;
-	for (i = 1; i < size; i++) {
-		c = fgetc(reader->fhd);
-		if (c < 0)
-			return 0xffffffffffffffffLL;
-		value |= ((uint64_t)c) << (i * 8);
 	}
+	p = reader->data + reader->pos;
+	reader->pos += size;
+	value = 0;
+	for (i = 0; i < size; i++)
+		value |= ((uint64_t)p[i]) << (i * 8);
 	return value;
 }
 
@@ -148,19 +347,19 @@ static int readBTLF(struct READER *reader, struct BTREE *btree,
 	UNUSED(message_flags);
 
 	/* read signature */
-	if (fread(buf, 1, 4, reader->fhd) != 4 || strncmp(buf, "BTLF", 4)) {
+	if (readerRead(reader, buf, 4) != 4 || strncmp(buf, "BTLF", 4)) {
 		mylog("cannot read signature of BTLF\n"); // LCOV_EXCL_LINE
 		return MYSOFA_INVALID_FORMAT;             // LCOV_EXCL_LINE
 	}
 	buf[4] = 0;
-	mylog("%08" PRIX64 " %.4s\n", (uint64_t)ftell(reader->fhd) - 4, buf);
+	mylog("%08" PRIX64 " %.4s\n", (uint64_t)readerTell(reader) - 4, buf);
 
-	if (fgetc(reader->fhd) != 0) {
+	if (readerGetc(reader) != 0) {
 		mylog("object BTLF must have version 0\n"); // LCOV_EXCL_LINE
 		return MYSOFA_INVALID_FORMAT;               // LCOV_EXCL_LINE
 	}
 
-	type = (uint8_t)fgetc(reader->fhd);
+	type = (uint8_t)readerGetc(reader);
 
 	for (i = 0; i < number_of_records; i++) {
 
@@ -184,7 +383,7 @@ static int readBTLF(struct READER *reader, struct BTREE *btree,
 			/*heap_id = */
 			readValue(reader, 8);
 			/*message_flags = */
-			fgetc(reader->fhd);
+			readerGetc(reader);
 			/*creation_order = */
 			readValue(reader, 4);
 			/*hash_of_name = */
@@ -195,7 +394,7 @@ static int readBTLF(struct READER *reader, struct BTREE *btree,
 			/*heap_id = */
 			readValue(reader, 8);
 			/*message_flags = */
-			fgetc(reader->fhd);
+			readerGetc(reader);
 			/*creation_order = */
 			readValue(reader, 4);
 			break;
@@ -206,7 +405,7 @@ static int readBTLF(struct READER *reader, struct BTREE *btree,
 		}
 	}
 
-	/*    fseeko(reader->fhd, bthd->root_node_address + bthd->node_size,
+	/*    readerSeek(reader, bthd->root_node_address + bthd->node_size,
 	 * SEEK_SET); skip checksum */
 
 	return MYSOFA_OK;
@@ -224,25 +423,25 @@ int btreeRead(struct READER *reader, struct BTREE *btree) {
 	char buf[5];
 
 	/* read signature */
-	if (fread(buf, 1, 4, reader->fhd) != 4 || strncmp(buf, "BTHD", 4)) {
+	if (readerRead(reader, buf, 4) != 4 || strncmp(buf, "BTHD", 4)) {
 		mylog("cannot read signature of BTHD\n");
 		return MYSOFA_INVALID_FORMAT;
 	}
 	buf[4] = 0;
-	mylog("%08" PRIX64 " %.4s\n", (uint64_t)ftell(reader->fhd) - 4, buf);
+	mylog("%08" PRIX64 " %.4s\n", (uint64_t)readerTell(reader) - 4, buf);
 
-	if (fgetc(reader->fhd) != 0) {
+	if (readerGetc(reader) != 0) {
 		mylog("object BTHD must have version 0\n");
 		return MYSOFA_INVALID_FORMAT;
 	}
 
-	btree->type = (uint8_t)fgetc(reader->fhd);
+	btree->type = (uint8_t)readerGetc(reader);
 	btree->node_size = (uint32_t)readValue(reader, 4);
 	btree->record_size = (uint16_t)readValue(reader, 2);
 	btree->depth = (uint16_t)readValue(reader, 2);
 
-	btree->split_percent = (uint8_t)fgetc(reader->fhd);
-	btree->merge_percent = (uint8_t)fgetc(reader->fhd);
+	btree->split_percent = (uint8_t)readerGetc(reader);
+	btree->merge_percent = (uint8_t)readerGetc(reader);
 	btree->root_node_address =
 		(uint64_t)readValue(reader, reader->superblock.size_of_offsets);
 	btree->number_of_records = (uint16_t)readValue(reader, 2);
@@ -251,7 +450,7 @@ int btreeRead(struct READER *reader, struct BTREE *btree) {
 	btree->total_number =
 		(uint64_t)readValue(reader, reader->superblock.size_of_lengths);
 
-	/*    fseek(reader->fhd, 4, SEEK_CUR);  skip checksum */
+	/*    readerSeek(reader, 4, SEEK_CUR);  skip checksum */
 
 	if (btree->total_number > 0x10000000)
 		return MYSOFA_NO_MEMORY;
@@ -261,7 +460,7 @@ int btreeRead(struct READER *reader, struct BTREE *btree) {
 	memset(btree->records, 0, sizeof(btree->records[0]) * btree->total_number);
 
 	/* read records */
-	if (fseek(reader->fhd, btree->root_node_address, SEEK_SET) < 0)
+	if (readerSeek(reader, btree->root_node_address, SEEK_SET) < 0)
 		return errno;
 	return readBTLF(reader, btree, btree->number_of_records, btree->records);
 }
@@ -276,8 +475,9 @@ void btreeFree(struct BTREE *btree) { free(btree->records); }
 
 int treeRead(struct READER *reader, struct DATAOBJECT *data) {
 
-	int i, j, err, olen, elements, size, x, y, z, b, e, dy, dz, sx, sy, sz, dzy, szy;
-	char *input, *output;
+	int i, j, err, olen, elements, size, x, y, z, b, e, cx, cy, cz, sx, sy, sz;
+	const char *input;
+	char *output;
 
 	uint8_t node_type, node_level;
 	uint16_t entries_used;
@@ -299,15 +499,15 @@ int treeRead(struct READER *reader, struct DATAOBJECT *data) {
 	}
 
 	/* read signature */
-	if (fread(buf, 1, 4, reader->fhd) != 4 || strncmp(buf, "TREE", 4)) {
+	if (readerRead(reader, buf, 4) != 4 || strncmp(buf, "TREE", 4)) {
 		mylog("cannot read signature of TREE\n"); // LCOV_EXCL_LINE
 		return MYSOFA_INVALID_FORMAT;             // LCOV_EXCL_LINE
 	}
 	buf[4] = 0;
-	mylog("%08" PRIX64 " %.4s\n", (uint64_t)ftell(reader->fhd) - 4, buf);
+	mylog("%08" PRIX64 " %.4s\n", (uint64_t)readerTell(reader) - 4, buf);
 
-	node_type = (uint8_t)fgetc(reader->fhd);
-	node_level = (uint8_t)fgetc(reader->fhd);
+	node_type = (uint8_t)readerGetc(reader);
+	node_level = (uint8_t)readerGetc(reader);
 	entries_used = (uint16_t)readValue(reader, 2);
 	if (entries_used > 0x1000)
 		return MYSOFA_UNSUPPORTED_FORMAT; // LCOV_EXCL_LINE
@@ -319,15 +519,17 @@ int treeRead(struct READER *reader, struct DATAOBJECT *data) {
 	elements = 1;
 	for (j = 0; j < data->ds.dimensionality; j++)
 		elements *= data->datalayout_chunk[j];
-	dy = data->datalayout_chunk[1];
-	dz = data->datalayout_chunk[2];
-	sx = (int)data->ds.dimension_size[0];
-	sy = (int)data->ds.dimension_size[1];
-	sz = (int)data->ds.dimension_size[2];
-	dzy = dz * dy;
-	szy = sz * sy;
 	size = data->datalayout_chunk[data->ds.dimensionality];
 
+	/* chunk and dataset extents; unused dimensions are treated as being of
+	 * size 1 */
+	cx = data->datalayout_chunk[0];
+	cy = data->ds.dimensionality > 1 ? data->datalayout_chunk[1] : 1;
+	cz = data->ds.dimensionality > 2 ? data->datalayout_chunk[2] : 1;
+	sx = (int)data->ds.dimension_size[0];
+	sy = data->ds.dimensionality > 1 ? (int)data->ds.dimension_size[1] : 1;
+	sz = data->ds.dimensionality > 2 ? (int)data->ds.dimension_size[2] : 1;
+
 	mylog("elements %d size %d\n", elements, size);
 
 	if (elements <= 0 || size <= 0 || elements >= 0x100000 || size > 0x10)
@@ -349,6 +551,7 @@ int treeRead(struct READER *reader, struct DATAOBJECT *data) {
 				return MYSOFA_INVALID_FORMAT;                // LCOV_EXCL_LINE
 			}
 
+			start[1] = start[2] = 0;
 			for (j = 0; j < data->ds.dimensionality; j++) {
 				start[j] = (int)readValue(reader, 8);
 				mylog("start %d %" PRIu64 "\n", j, start[j]);
@@ -362,25 +565,20 @@ int treeRead(struct READER *reader, struct DATAOBJECT *data) {
 			mylog(" data at %" PRIX64 " len %u\n", child_pointer, size_of_chunk);
 
 			/* read data */
-			store = ftell(reader->fhd);
-			if (fseek(reader->fhd, child_pointer, SEEK_SET) < 0) {
+			store = readerTell(reader);
+			if (readerSeek(reader, child_pointer, SEEK_SET) < 0) {
 				free(output); // LCOV_EXCL_LINE
 				return errno; // LCOV_EXCL_LINE
 			}
 
-			if (!(input = malloc(size_of_chunk))) {
-				free(output);            // LCOV_EXCL_LINE
-				return MYSOFA_NO_MEMORY; // LCOV_EXCL_LINE
-			}
-			if (fread(input, 1, size_of_chunk, reader->fhd) != size_of_chunk) {
+			/* inflated straight from the file contents */
+			if (!(input = readerData(reader, size_of_chunk))) {
 				free(output);                 // LCOV_EXCL_LINE
-				free(input);                  // LCOV_EXCL_LINE
 				return MYSOFA_INVALID_FORMAT; // LCOV_EXCL_LINE
 			}
 
 			olen = elements * size;
 			err = gunzip(size_of_chunk, input, &olen, output);
-			free(input);
 
 			mylog("   gunzip %d %d %d\n", err, olen, elements * size);
 			if (err || olen != elements * size) {
@@ -388,92 +586,33 @@ int treeRead(struct READER *reader, struct DATAOBJECT *data) {
 				return MYSOFA_INVALID_FORMAT; // LCOV_EXCL_LINE
 			}
 
-			switch (data->ds.dimensionality) {
-			case 1:
-				for (i = 0; i < olen; i++) {
-					b = i / elements;
-					x = i % elements + start[0];
-					if (x < sx) {
+			if (data->ds.dimensionality < 1) {
+				mylog("invalid dim\n");       // LCOV_EXCL_LINE
+				free(output);                 // LCOV_EXCL_LINE
+				return MYSOFA_INTERNAL_ERROR; // LCOV_EXCL_LINE
+			}
 
-						j = x * size + b;
-						if (j >= 0 && j < data->data_len) {
-							((char *)data->data)[j] = output[i];
-						}
-					}
-				}
-				break;
-			case 2:
-				for (i = 0; i < olen; i++) {
-					b = i / elements;
-					x = i % elements;
-					y = x % dy + start[1];
-					x = x / dy + start[0];
-					if (y < sy && x < sx) {
-						j = ((x * sy + y) * size) + b;
-						if (j >= 0 && j < data->data_len) {
-							((char *)data->data)[j] = output[i];
-						}
-					}
-				}
-				break;
-			case 3:
-				/* Some minor speed ups if dz==1 */
-				if (dz == 1) {
-					if (start[2] >= sz)
-						break;
-					for (i = 0; i < olen; i++) {
-						b = i / elements;
-						x = i % elements;
-						y = x % dy + start[1];
-						x = (x / dzy) + start[0];
-						if (y < sy && x < sx) {
-							j = (x * szy + y * sz + start[2]) * size + b;
-							if (j >= 0 && j < data->data_len) {
-								((char *)data->data)[j] = output[i];
-							}
-						}
-					}
-				}
-				/* Some minor speed ups if dy==1 */
-				else if (dy == 1) {
-					if (start[1] >= sy)
-						break;
-					for (i = 0; i < olen; i++) {
-						b = i / elements;
-						x = i % elements;
-						z = x % dz + start[2];
-						x = (x / dzy) + start[0];
-						if (z < sz  && x < sx) {
-							j = (x * szy + start[1] * sz + z) * size + b;
-							if (j >= 0 && j < data->data_len) {
-								((char *)data->data)[j] = output[i];
+			/* The chunk holds the bytes of its elements shuffled (byte 'b' of
+			 * element 'i' is at output[b * elements + i]); unshuffle them, and copy
+			 * those elements that lie within the dataset into place. Looping over
+			 * the elements avoids divisions for every byte */
+			i = 0;
+			for (x = start[0]; x < start[0] + cx; x++) {
+				for (y = start[1]; y < start[1] + cy; y++) {
+					for (z = start[2]; z < start[2] + cz; z++, i++) {
+						if (x >= sx || y >= sy || z >= sz)
+							continue;
+						j = ((x * sy + y) * sz + z) * size;
+						for (b = 0; b < size; b++) {
+							if (j + b >= 0 && j + b < data->data_len) {
+								((char *)data->data)[j + b] = output[b * elements + i];
 							}
 						}
 					}
 				}
-				/* Otherwise, revert to the original code: */
-				else {
-					for (i = 0; i < olen; i++) {
-						b = i / elements;
-						x = i % elements;
-						z = x % dz + start[2];
-						y = (x / dz) % dy + start[1];
-						x = (x / dzy) + start[0];
-						if (z < sz && y < sy && x < sx) {
-							j = (x * szy + y * sz + z) * size + b;
-							if (j >= 0 && j < data->data_len) {
-								((char *)data->data)[j] = output[i];
-							}
-						}
-					}
-				}
-				break;
-			default:
-				mylog("invalid dim\n");       // LCOV_EXCL_LINE
-				return MYSOFA_INTERNAL_ERROR; // LCOV_EXCL_LINE
 			}
 
-			if (fseek(reader->fhd, store, SEEK_SET) < 0) {
+			if (readerSeek(reader, store, SEEK_SET) < 0) {
 				free(output); // LCOV_EXCL_LINE
 				return errno; // LCOV_EXCL_LINE
 			}
@@ -481,7 +620,7 @@ int treeRead(struct READER *reader, struct DATAOBJECT *data) {
 	}
 
 	free(output);
-	if (fseek(reader->fhd, 4, SEEK_CUR) < 0) /* skip checksum */
+	if (readerSeek(reader, 4, SEEK_CUR) < 0) /* skip checksum */
 		return errno;                          // LCOV_EXCL_LINE
 
 	return MYSOFA_OK;
@@ -505,21 +644,21 @@ static int readGCOL(struct READER *reader) {
 	UNUSED(reference_count);
 
 	/* read signature */
-	if (fread(buf, 1, 4, reader->fhd) != 4 || strncmp(buf, "GCOL", 4)) {
+	if (readerRead(reader, buf, 4) != 4 || strncmp(buf, "GCOL", 4)) {
 		mylog("cannot read signature of global heap collection\n");
 		return MYSOFA_INVALID_FORMAT;
 	}
 	buf[4] = 0;
 
-	if (fgetc(reader->fhd) != 1) {
+	if (readerGetc(reader) != 1) {
 		mylog("object GCOL must have version 1\n");
 		return MYSOFA_INVALID_FORMAT;
 	}
-	if (fgetc(reader->fhd) < 0 || fgetc(reader->fhd) < 0 ||
-		fgetc(reader->fhd) < 0)
+	if (readerGetc(reader) < 0 || readerGetc(reader) < 0 ||
+		readerGetc(reader) < 0)
 		return MYSOFA_READ_ERROR;
 
-	address = ftell(reader->fhd);
+	address = readerTell(reader);
 	end = address;
 	collection_size = readValue(reader, reader->superblock.size_of_lengths);
 	if (collection_size > 0x400000000) {
@@ -528,7 +667,7 @@ static int readGCOL(struct READER *reader) {
 	}
 	end += collection_size - 8;
 
-	while (ftell(reader->fhd) <= (long)(end - 8 - reader->superblock.size_of_lengths)) {
+	while (readerTell(reader) <= (long)(end - 8 - reader->superblock.size_of_lengths)) {
 
 		gcol = malloc(sizeof(*gcol));
 		if (!gcol)
@@ -539,7 +678,7 @@ static int readGCOL(struct READER *reader) {
 			break;
 		}
 		reference_count = readValue(reader, 2);
-		if (fseek(reader->fhd, 4, SEEK_CUR) < 0) {
+		if (readerSeek(reader, 4, SEEK_CUR) < 0) {
 			free(gcol);
 			return errno;
 		}
@@ -557,9 +696,9 @@ static int readGCOL(struct READER *reader) {
 		reader->gcol = gcol;
 	}
 
-	mylog(" END %08lX vs. %08" PRIX64 "\n", ftell(reader->fhd),
+	mylog(" END %08lX vs. %08" PRIX64 "\n", readerTell(reader),
 		end); /* bug in the normal hdf5 specification */
-  /*    fseek(reader->fhd, end, SEEK_SET); */
+  /*    readerSeek(reader, end, SEEK_SET); */
 	return MYSOFA_OK;
 }
 
@@ -572,13 +711,13 @@ int gcolRead(struct READER *reader, uint64_t gcol, int reference,
 		p = p->next;
 	}
 	if (!p) {
-		pos = ftell(reader->fhd);
-		if (fseek(reader->fhd, gcol, SEEK_SET) < 0)
+		pos = readerTell(reader);
+		if (readerSeek(reader, gcol, SEEK_SET) < 0)
 			return MYSOFA_READ_ERROR;
 		readGCOL(reader);
 		if (pos < 0)
 			return MYSOFA_READ_ERROR;
-		if (fseek(reader->fhd, pos, SEEK_SET) < 0)
+		if (readerSeek(reader, pos, SEEK_SET) < 0)
 			return MYSOFA_READ_ERROR;
 
 		p = reader->gcol;
@@ -605,13 +744,13 @@ for (;;) {
 	if (gcol->heap_object_index == reference) {
 		mylog("found reference at %LX\n", gcol->object_pos);
 		break;
-		pos = ftell(reader->fhd);
-		fseek(reader->fhd, gcol->object_pos, SEEK_SET);
+		pos = readerTell(reader);
+		readerSeek(reader, gcol->object_pos, SEEK_SET);
 		dt2 = *dt;
 		dt2.list = 0;
 		dt2.size = gcol->object_size;
 		readDataVar(reader, &dt2, ds);
-		fseek(reader->fhd, pos, SEEK_SET);
+		readerSeek(reader, pos, SEEK_SET);
 		break;
 	}
 	gcol = gcol->next;
@@ -629,7 +768,7 @@ for (;;) {
 	/*                                  GUNZIP                                    */
 	/* ========================================================================== */
 
-	int gunzip(int inlen, char *in, int *outlen, char *out) {
+	int gunzip(int inlen, const char *in, int *outlen, char *out) {
 		int err;
 		z_stream stream;
 
@@ -666,9 +805,9 @@ for (;;) {
 	 */
 
 	int superblockRead2or3(struct READER *reader, struct SUPERBLOCK *superblock) {
-		superblock->size_of_offsets = (uint8_t)fgetc(reader->fhd);
-		superblock->size_of_lengths = (uint8_t)fgetc(reader->fhd);
-		if (fgetc(reader->fhd) < 0) /* File Consistency Flags */
+		superblock->size_of_offsets = (uint8_t)readerGetc(reader);
+		superblock->size_of_lengths = (uint8_t)readerGetc(reader);
+		if (readerGetc(reader) < 0) /* File Consistency Flags */
 			return MYSOFA_READ_ERROR;
 
 		if (superblock->size_of_offsets < 2 || superblock->size_of_offsets > 8 ||
@@ -691,10 +830,10 @@ for (;;) {
 			return MYSOFA_UNSUPPORTED_FORMAT;
 		}
 
-		if (fseek(reader->fhd, 0L, SEEK_END))
+		if (readerSeek(reader, 0L, SEEK_END))
 			return errno;
 
-		if ((long)superblock->end_of_file_address != ftell(reader->fhd)) {
+		if ((long)superblock->end_of_file_address != readerTell(reader)) {
 			mylog("file size mismatch\n");
 			return MYSOFA_INVALID_FORMAT;
 		}
@@ -702,7 +841,7 @@ for (;;) {
 		/* end of superblock */
 
 		/* seek to first object */
-		if (fseek(reader->fhd, superblock->root_group_object_header_address,
+		if (readerSeek(reader, superblock->root_group_object_header_address,
 			SEEK_SET)) {
 			mylog("cannot seek to first object at %" PRId64 "\n",
 				superblock->root_group_object_header_address);
@@ -714,25 +853,25 @@ for (;;) {
 
 	int superblockRead0or1(struct READER *reader, struct SUPERBLOCK *superblock,
 		int version) {
-		if (fgetc(reader->fhd) !=
+		if (readerGetc(reader) !=
 			0) /* Version Number of the File’s Free Space Information */
 			return MYSOFA_INVALID_FORMAT;
 
-		if (fgetc(reader->fhd) !=
+		if (readerGetc(reader) !=
 			0) /* Version Number of the Root Group Symbol Table Entry */
 			return MYSOFA_INVALID_FORMAT;
 
-		if (fgetc(reader->fhd) != 0)
+		if (readerGetc(reader) != 0)
 			return MYSOFA_INVALID_FORMAT;
 
-		if (fgetc(reader->fhd) !=
+		if (readerGetc(reader) !=
 			0) /* Version Number of the Shared Header Message Format */
 			return MYSOFA_INVALID_FORMAT;
 
-		superblock->size_of_offsets = (uint8_t)fgetc(reader->fhd);
-		superblock->size_of_lengths = (uint8_t)fgetc(reader->fhd);
+		superblock->size_of_offsets = (uint8_t)readerGetc(reader);
+		superblock->size_of_lengths = (uint8_t)readerGetc(reader);
 
-		if (fgetc(reader->fhd) != 0)
+		if (readerGetc(reader) != 0)
 			return MYSOFA_INVALID_FORMAT;
 
 		if (superblock->size_of_offsets < 2 || superblock->size_of_offsets > 8 ||
@@ -808,16 +947,16 @@ for (;;) {
 			return MYSOFA_UNSUPPORTED_FORMAT;
 		}
 
-		if (fseek(reader->fhd, 0L, SEEK_END))
+		if (readerSeek(reader, 0L, SEEK_END))
 			return errno;
 
-		if ((long)superblock->end_of_file_address != ftell(reader->fhd)) {
+		if ((long)superblock->end_of_file_address != readerTell(reader)) {
 			mylog("file size mismatch\n");
 		}
 		/* end of superblock */
 
 		/* seek to first object */
-		if (fseek(reader->fhd, superblock->root_group_object_header_address,
+		if (readerSeek(reader, superblock->root_group_object_header_address,
 			SEEK_SET)) {
 			mylog("cannot seek to first object at %" PRId64 "\n",
 				superblock->root_group_object_header_address);
@@ -832,14 +971,14 @@ for (;;) {
 		memset(superblock, 0, sizeof(*superblock));
 
 		/* signature */
-		if (fread(buf, 1, 8, reader->fhd) != 8 ||
+		if (readerRead(reader, buf, 8) != 8 ||
 			strncmp("\211HDF\r\n\032\n", buf, 8)) {
 			mylog("file does not have correct signature");
 			return MYSOFA_INVALID_FORMAT;
 		}
 
 		/* read version of superblock, must be 0,1,2, or 3 */
-		int version = fgetc(reader->fhd);
+		int version = readerGetc(reader);
 
 		switch (version) {
 		case 0:
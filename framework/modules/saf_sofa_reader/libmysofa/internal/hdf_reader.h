@@ -203,7 +203,12 @@ void gcolFree(struct GCOL *gcol);
 int treeRead(struct READER *reader, struct DATAOBJECT *data);
 
 struct READER {
-  FILE *fhd;
+  /* contents of the file; memory-mapped, or read into a buffer where mapping
+   * is not possible (e.g. stdin) */
+  const uint8_t *data;
+  uint64_t size; /* size of the contents, in bytes */
+  uint64_t pos;  /* current read position */
+  int mapped;    /* whether 'data' is memory-mapped or malloc'd */
 
   struct DATAOBJECT *all;
 
@@ -214,10 +219,18 @@ struct READER {
   int recursive_counter;
 };
 
+int readerOpen(struct READER *reader, const char *filename);
+void readerClose(struct READER *reader);
+int readerGetc(struct READER *reader);
+size_t readerRead(struct READER *reader, void *buf, size_t length);
+const char *readerData(struct READER *reader, size_t length);
+int readerSeek(struct READER *reader, long offset, int whence);
+long readerTell(struct READER *reader);
+
 int validAddress(struct READER *reader, uint64_t address);
 uint64_t readValue(struct READER *reader, int size);
 
-int gunzip(int inlen, char *in, int *outlen, char *out);
+int gunzip(int inlen, const char *in, int *outlen, char *out);
 
 #endif /* SAF_ENABLE_SOFA_READER_MODULE */
 
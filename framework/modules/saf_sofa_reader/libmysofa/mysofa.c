@@ -308,14 +308,10 @@ MYSOFA_EXPORT struct MYSOFA_HRTF *mysofa_load(const char *filename, int *err) {
   if (filename == NULL)
     filename = CMAKE_INSTALL_PREFIX "/share/libmysofa/default.sofa";
 
-  if (strcmp(filename, "-"))
-    reader.fhd = fopen(filename, "rb");
-  else
-    reader.fhd = stdin;
-
-  if (!reader.fhd) {
+  /* the file is memory-mapped (or read into memory) and parsed from there */
+  *err = readerOpen(&reader, filename);
+  if (*err) {
     mylog("cannot open file %s\n", filename);
-    *err = errno;
     return NULL;
   }
   reader.gcol = NULL;
@@ -330,8 +326,7 @@ MYSOFA_EXPORT struct MYSOFA_HRTF *mysofa_load(const char *filename, int *err) {
 
   superblockFree(&reader, &reader.superblock);
   gcolFree(reader.gcol);
-  if (strcmp(filename, "-"))
-    fclose(reader.fhd);
+  readerClose(&reader);
 
   return hrtf;
 }
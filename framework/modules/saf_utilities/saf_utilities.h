@@ -210,6 +210,15 @@
 /* Wrappers for different FFT implementations */
 #include "saf_utility_fft.h"
 
+/* A persistent pool of worker threads */
+#include "saf_utility_threadPool.h"
+
+/* Lock-free hand-off of shared state between threads, and atomic integers */
+#include "saf_utility_rcu.h"
+
+/* Persistent on-disk cache of data derived from (large) source files */
+#include "saf_utility_fileCache.h"
+
 /* Matrix and multi-channel convolvers */
 #include "saf_utility_matrixConv.h"
 
@@ -28,14 +28,29 @@
 #include "saf_externals.h"
 
 /**
- * Internal Lattice all-pass filter structure */
-typedef struct _latticeAPF{
-    int order;
-    int filterLength;
-    float** coeffs;
-    float_complex* buffer;
-
-}latticeAPF;
+ * Internal group of lattice all-pass filters sharing the same order
+ *
+ * The filter states and coefficients are stored structure-of-arrays, with one
+ * lane per band/channel pair, such that all filters in the group may be run
+ * side by side */
+typedef struct _latticeAPF_group{
+    int order;             /**< Filter order shared by all lanes */
+    int nLanes;            /**< Number of band/channel pairs in this group */
+    int* bandIdx;          /**< Band index per lane; nLanes x 1 */
+    int* chIdx;            /**< Channel index per lane; nLanes x 1 */
+    float** num;           /**< Numerator coefficients; order x nLanes */
+    float** den;           /**< Denominator coefficients; order x nLanes */
+    float** buf_re;        /**< Filter state, real part; order x nLanes */
+    float** buf_im;        /**< Filter state, imaginary part; order x nLanes */
+    float* in_energy;      /**< Smoothed input energy; nLanes x 1 */
+    float* decor_energy;   /**< Smoothed output energy; nLanes x 1 */
+
+    /* scratch */
+    float* x_re, *x_im;    /**< Filter input; nLanes x 1 */
+    float* y_re, *y_im;    /**< Filter output; nLanes x 1 */
+    float* gain;           /**< Energy compensation gains; nLanes x 1 */
+
+}latticeAPF_group;
 
 /**
  * Internal Lattice all-pass filter based decorrelator structure */
@@ -46,18 +61,42 @@ typedef struct _latticeDecor_data{
     int maxBufferLen;
     int* orders;
     int* TF_delays;
-    latticeAPF** lttc_apf;
+    int nGroups;
+    latticeAPF_group* groups;
     float enComp_coeff;
 
     /* run-time */
-    float** in_energy;
-    float** decor_energy;
     float_complex*** delayBuffers;
     int* wIdx;
     int* rIdx;
 
 }latticeDecor_data;
 
+/** Returns the lattice coefficients for a given order and table row (NULL if
+ *  the order is not supported) */
+static const float* latticeDecorrelator_getCoeffs
+(
+    int order,
+    int row
+)
+{
+    switch(order){
+        case 20: return __lattice_coeffs_o20[row];
+        case 18: return __lattice_coeffs_o18[row];
+        case 16: return __lattice_coeffs_o16[row];
+        case 15: return __lattice_coeffs_o15[row];
+        case 14: return __lattice_coeffs_o14[row];
+        case 12: return __lattice_coeffs_o12[row];
+        case 10: return __lattice_coeffs_o10[row];
+        case 8:  return __lattice_coeffs_o8[row];
+        case 6:  return __lattice_coeffs_o6[row];
+        case 4:  return __lattice_coeffs_o4[row];
+        case 3:  return __lattice_coeffs_o3[row];
+        case 2:  return __lattice_coeffs_o2[row];
+        default: return NULL;
+    }
+}
+
 /**
  * Internal structure used by the transient Ducker */
 typedef struct _transientDucker_data{
@@ -209,7 +248,10 @@ void latticeDecorrelator_create
 {
     *phDecor = malloc1d(sizeof(latticeDecor_data));
     latticeDecor_data *h = (latticeDecor_data*)(*phDecor);
-    int i, band, ch, o, filterIdx;
+    int i, band, ch, o, g, l, filterIdx;
+    int* bandOrders;
+    const float* coeffs;
+    latticeAPF_group* grp;
 
     h->nCH = nCH;
     h->nCutoffs = nCutoffs;
@@ -219,10 +261,7 @@ void latticeDecorrelator_create
     h->orders = malloc1d(nCutoffs*sizeof(int));
     memcpy(h->orders, orders, nCutoffs*sizeof(int));
     h->TF_delays = malloc1d(nBands * nCH * sizeof(int));
-    h->lttc_apf = (latticeAPF**)malloc2d(nBands, nCH, sizeof(latticeAPF));
     h->enComp_coeff = enComp_coeff;
-    h->in_energy = (float**)calloc2d(nBands, nCH, sizeof(float));
-    h->decor_energy = (float**)calloc2d(nBands, nCH, sizeof(float));
 
     /* Static delays */
     getDecorrelationDelays(h->nCH, freqVector, h->nBands, fs, maxDelay, hopsize, h->TF_delays);
@@ -232,55 +271,72 @@ void latticeDecorrelator_create
     for(i=0; i<nBands*nCH; i++)
         maxDelay = h->TF_delays[i] > maxDelay ? h->TF_delays[i] : maxDelay;
 
-    /* set-up allpass filters per band and channel */
+    /* Find the filter order for each band (-1 if only delays are applied) */
+    bandOrders = malloc1d(nBands*sizeof(int));
     for(band=0; band<nBands; band++){
         filterIdx = -1;
-
-        /* Find filter index for this band: */
         for(o=0; o<nCutoffs; o++){
             if(freqVector[band]<freqCutoffs[o]){
                 filterIdx = o;
                 break;
             }
         }
+        bandOrders[band] = filterIdx == -1 ? -1 : orders[filterIdx];
+        if(bandOrders[band]!=-1 && latticeDecorrelator_getCoeffs(bandOrders[band], 0)==NULL){
+            saf_print_error("Unsupported filter order was specified");
+            bandOrders[band] = -1;
+        }
+    }
+
+    /* Group all band/channel pairs that share the same filter order */
+    h->nGroups = 0;
+    h->groups = malloc1d(SAF_MAX(nCutoffs,1)*sizeof(latticeAPF_group));
+    for(band=0; band<nBands; band++){
+        if(bandOrders[band]==-1)
+            continue;
+        for(g=0; g<h->nGroups; g++)
+            if(h->groups[g].order==bandOrders[band])
+                break;
+        if(g==h->nGroups){
+            h->groups[g].order = bandOrders[band];
+            h->groups[g].nLanes = 0;
+            h->nGroups++;
+        }
+        h->groups[g].nLanes += nCH;
+    }
 
-        /* Pull lattice allpass filter coefficients from database */
-        for(ch=0; ch<nCH; ch++){
-            if(filterIdx == -1){
-                /* Not needed... */
-                h->lttc_apf[band][ch].order = -1;
-                h->lttc_apf[band][ch].filterLength = 0;
-                h->lttc_apf[band][ch].coeffs = NULL;
-                h->lttc_apf[band][ch].buffer = NULL;
-            }
-            else{
-                h->lttc_apf[band][ch].order = h->orders[filterIdx];
-                h->lttc_apf[band][ch].coeffs = (float**)malloc2d(2, h->orders[filterIdx], sizeof(float));
-                h->lttc_apf[band][ch].buffer = calloc1d(h->lttc_apf[band][ch].order, sizeof(float_complex));
-
-                /* numerator coefficients */
-                switch(orders[filterIdx]){
-                    case 20: memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o20[ch+lookupOffset], (h->orders[filterIdx])*sizeof(float)); break;
-                    case 18: memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o18[ch+lookupOffset], (h->orders[filterIdx])*sizeof(float)); break;
-                    case 16: memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o16[ch+lookupOffset], (h->orders[filterIdx])*sizeof(float)); break;
-                    case 15: memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o15[ch+lookupOffset], (h->orders[filterIdx])*sizeof(float)); break;
-                    case 14: memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o14[ch+lookupOffset], (h->orders[filterIdx])*sizeof(float)); break;
-                    case 12: memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o12[ch+lookupOffset], (h->orders[filterIdx])*sizeof(float)); break;
-                    case 10: memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o10[ch+lookupOffset], (h->orders[filterIdx])*sizeof(float)); break;
-                    case 8:  memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o8[ch+lookupOffset],  (h->orders[filterIdx])*sizeof(float)); break;
-                    case 6:  memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o6[ch+lookupOffset],  (h->orders[filterIdx])*sizeof(float)); break;
-                    case 4:  memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o4[ch+lookupOffset],  (h->orders[filterIdx])*sizeof(float)); break;
-                    case 3:  memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o3[ch+lookupOffset],  (h->orders[filterIdx])*sizeof(float)); break;
-                    case 2:  memcpy(h->lttc_apf[band][ch].coeffs[0], __lattice_coeffs_o2[ch+lookupOffset],  (h->orders[filterIdx])*sizeof(float)); break;
-                    default: saf_print_error("Unsupported filter order was specified"); break;
+    /* Pull lattice allpass filter coefficients from database */
+    for(g=0; g<h->nGroups; g++){
+        grp = &(h->groups[g]);
+        grp->bandIdx = malloc1d(grp->nLanes*sizeof(int));
+        grp->chIdx = malloc1d(grp->nLanes*sizeof(int));
+        grp->num = (float**)malloc2d(grp->order, grp->nLanes, sizeof(float));
+        grp->den = (float**)malloc2d(grp->order, grp->nLanes, sizeof(float));
+        grp->buf_re = (float**)calloc2d(grp->order, grp->nLanes, sizeof(float));
+        grp->buf_im = (float**)calloc2d(grp->order, grp->nLanes, sizeof(float));
+        grp->in_energy = calloc1d(grp->nLanes, sizeof(float));
+        grp->decor_energy = calloc1d(grp->nLanes, sizeof(float));
+        grp->x_re = malloc1d(grp->nLanes*sizeof(float));
+        grp->x_im = malloc1d(grp->nLanes*sizeof(float));
+        grp->y_re = malloc1d(grp->nLanes*sizeof(float));
+        grp->y_im = malloc1d(grp->nLanes*sizeof(float));
+        grp->gain = malloc1d(grp->nLanes*sizeof(float));
+        l = 0;
+        for(band=0; band<nBands; band++){
+            if(bandOrders[band]!=grp->order)
+                continue;
+            for(ch=0; ch<nCH; ch++, l++){
+                grp->bandIdx[l] = band;
+                grp->chIdx[l] = ch;
+                coeffs = latticeDecorrelator_getCoeffs(grp->order, ch+lookupOffset);
+                for(i=0; i<grp->order; i++){
+                    grp->num[i][l] = coeffs[i];                /* numerator */
+                    grp->den[i][l] = coeffs[grp->order-i-1];   /* denominator */
                 }
-
-                /* denominator coefficients */
-                for(i=0; i<orders[filterIdx]; i++)
-                    h->lttc_apf[band][ch].coeffs[1][i] = h->lttc_apf[band][ch].coeffs[0][orders[filterIdx]-i-1];
             }
         }
     }
+    free(bandOrders);
 
     /* Run-time */
     h->maxBufferLen = maxDelay+1;
@@ -298,18 +354,29 @@ void latticeDecorrelator_destroy
 )
 {
     latticeDecor_data *h = (latticeDecor_data*)(*phDecor);
-    int band, ch;
+    latticeAPF_group* grp;
+    int g;
 
     if(h!=NULL){
         free(h->orders);
         free(h->TF_delays);
-        for(band=0; band <h->nBands; band++){
-            for(ch=0; ch<h->nCH; ch++){
-                free(h->lttc_apf[band][ch].buffer);
-                free(h->lttc_apf[band][ch].coeffs);
-            }
+        for(g=0; g<h->nGroups; g++){
+            grp = &(h->groups[g]);
+            free(grp->bandIdx);
+            free(grp->chIdx);
+            free(grp->num);
+            free(grp->den);
+            free(grp->buf_re);
+            free(grp->buf_im);
+            free(grp->in_energy);
+            free(grp->decor_energy);
+            free(grp->x_re);
+            free(grp->x_im);
+            free(grp->y_re);
+            free(grp->y_im);
+            free(grp->gain);
         }
-        free(h->lttc_apf);
+        free(h->groups);
 
         free(h->delayBuffers);
         free(h->wIdx);
@@ -326,15 +393,17 @@ void latticeDecorrelator_reset
 )
 {
     latticeDecor_data *h = (latticeDecor_data*)(hDecor);
-    int band, ch;
+    latticeAPF_group* grp;
+    int g;
 
     memset(FLATTEN3D(h->delayBuffers), 0, h->nBands * h->nCH * h->maxBufferLen * sizeof(float_complex));
-    for(band=0; band<h->nBands; band++)
-        for(ch=0; ch<h->nCH; ch++)
-            if(h->lttc_apf[band][ch].buffer!=NULL)
-                memset(h->lttc_apf[band][ch].buffer, 0, h->lttc_apf[band][ch].order * sizeof(float_complex));
-    memset(FLATTEN2D(h->in_energy), 0, h->nBands*h->nCH*sizeof(float));
-    memset(FLATTEN2D(h->decor_energy), 0, h->nBands*h->nCH*sizeof(float));
+    for(g=0; g<h->nGroups; g++){
+        grp = &(h->groups[g]);
+        memset(FLATTEN2D(grp->buf_re), 0, grp->order*grp->nLanes*sizeof(float));
+        memset(FLATTEN2D(grp->buf_im), 0, grp->order*grp->nLanes*sizeof(float));
+        memset(grp->in_energy, 0, grp->nLanes*sizeof(float));
+        memset(grp->decor_energy, 0, grp->nLanes*sizeof(float));
+    }
 }
 
 void latticeDecorrelator_apply
@@ -346,83 +415,96 @@ void latticeDecorrelator_apply
 )
 {
     latticeDecor_data *h = (latticeDecor_data*)(hDecor);
-    int band, ch, t, i;
-    float_complex ytmp, xtmp;
+    latticeAPF_group* grp;
+    int band, ch, t, i, g, l, nLanes, idx, rIdx, wIdx, delay;
+    float a, b, x_re, x_im, y_re, y_im;
+    float *x_r, *x_i, *y_r, *y_i, *gain, *in_en, *dec_en, *num, *den, *s_re, *s_im, *s1_re, *s1_im;
+    float_complex* delayBuffer;
 
-    for(t=0; t<nTimeSlots; t++){
-        for(band=0; band <h->nBands; band++){
-            for(ch=0; ch<h->nCH; ch++){
-                /* Apply fixed delay */
-                h->delayBuffers[band][ch][h->wIdx[band*(h->nCH) + ch]] = inFrame[band][ch][t];
-                decorFrame[band][ch][t] = h->delayBuffers[band][ch][h->rIdx[band*(h->nCH) + ch]];
+    /* Apply fixed delays */
+    for(band=0; band <h->nBands; band++){
+        for(ch=0; ch<h->nCH; ch++){
+            idx = band*(h->nCH) + ch;
+            delayBuffer = h->delayBuffers[band][ch];
+            delay = h->TF_delays[idx];
+            rIdx = h->rIdx[idx];
+            wIdx = h->wIdx[idx];
+            for(t=0; t<nTimeSlots; t++){
+                delayBuffer[wIdx] = inFrame[band][ch][t];
+                decorFrame[band][ch][t] = delayBuffer[rIdx];
 
                 /* increment and wrap-around as needed */
-                h->rIdx[band*(h->nCH) + ch]++;
-                h->wIdx[band*(h->nCH) + ch]++;
-                if( h->rIdx[band*(h->nCH) + ch] > h->TF_delays[band*(h->nCH) + ch] )
-                    h->rIdx[band*(h->nCH) + ch] = 0;
-                if( h->wIdx[band*(h->nCH) + ch] > h->TF_delays[band*(h->nCH) + ch] )
-                    h->wIdx[band*(h->nCH) + ch] = 0;
+                rIdx = rIdx==delay ? 0 : rIdx+1;
+                wIdx = wIdx==delay ? 0 : wIdx+1;
             }
+            h->rIdx[idx] = rIdx;
+            h->wIdx[idx] = wIdx;
         }
     }
 
-    /* Apply lattice allpass filters */
-#if _MSC_VER >= 1900
-    for(band=0; band <h->nBands; band++){
-        for(ch=0; ch<h->nCH; ch++){
-            if(h->lttc_apf[band][ch].buffer!=NULL){ /* only if filter is defined... */
-                for(t=0; t<nTimeSlots; t++){
-                    /* Compute energy of the input */
-                    h->in_energy[band][ch] = (1.0f-h->enComp_coeff)*powf(cabsf(inFrame[band][ch][t]),2.0f) + (h->enComp_coeff)*h->in_energy[band][ch];
-
-                    /* First tap in filter */
-                    xtmp = decorFrame[band][ch][t];
-                    ytmp = ccaddf(h->lttc_apf[band][ch].buffer[0], crmulf(xtmp, (h->lttc_apf[band][ch].coeffs[0][0])));
-                    decorFrame[band][ch][t] = ytmp;
-
-                    /* Energy compensation */
-                    h->decor_energy[band][ch] = (1.0f-h->enComp_coeff)*powf(cabsf(decorFrame[band][ch][t]),2.0f) + (h->enComp_coeff)*h->decor_energy[band][ch];
-                    decorFrame[band][ch][t] = crmulf(decorFrame[band][ch][t], SAF_MIN(sqrtf(h->in_energy[band][ch]/(h->decor_energy[band][ch]+2.23e-9f)), 1.0f));
-
-                    /* propagate through the rest of the lattice filter structure */
-                    for(i=0; i<h->lttc_apf[band][ch].order-1; i++){
-                        h->lttc_apf[band][ch].buffer[i] = ccaddf(h->lttc_apf[band][ch].buffer[i+1],
-                                                                 ccsubf(crmulf(xtmp, h->lttc_apf[band][ch].coeffs[0][i+1]),    /* numerator */
-                                                                        crmulf(ytmp, h->lttc_apf[band][ch].coeffs[1][i+1])));  /* denominator */
-                    }
-                }
+    /* Apply lattice allpass filters; all band/channel pairs with the same
+     * filter order are processed together, one lane per pair */
+    a = h->enComp_coeff;
+    b = 1.0f - h->enComp_coeff;
+    for(g=0; g<h->nGroups; g++){
+        grp = &(h->groups[g]);
+        nLanes = grp->nLanes;
+        x_r = grp->x_re;  x_i = grp->x_im;
+        y_r = grp->y_re;  y_i = grp->y_im;
+        gain = grp->gain;
+        in_en = grp->in_energy;
+        dec_en = grp->decor_energy;
+        for(t=0; t<nTimeSlots; t++){
+            /* Compute energy of the input */
+            for(l=0; l<nLanes; l++){
+                x_re = crealf(inFrame[grp->bandIdx[l]][grp->chIdx[l]][t]);
+                x_im = cimagf(inFrame[grp->bandIdx[l]][grp->chIdx[l]][t]);
+                in_en[l] = b*(x_re*x_re + x_im*x_im) + a*in_en[l];
             }
-        }
-    }
-#else
-    for(band=0; band <h->nBands; band++){
-        for(ch=0; ch<h->nCH; ch++){
-            if(h->lttc_apf[band][ch].buffer!=NULL){ /* only if filter is defined */
-                for(t=0; t<nTimeSlots; t++){
-                    /* Compute energy of the input */
-                    h->in_energy[band][ch] = (1.0f-h->enComp_coeff)*powf(cabsf(inFrame[band][ch][t]),2.0f) + (h->enComp_coeff)*h->in_energy[band][ch];
-
-                    /* First tap in filter */
-                    xtmp = decorFrame[band][ch][t];
-                    ytmp = xtmp * (h->lttc_apf[band][ch].coeffs[0][0]) + h->lttc_apf[band][ch].buffer[0];
-                    decorFrame[band][ch][t] = ytmp;
-
-                    /* Energy compensation */
-                    h->decor_energy[band][ch] = (1.0f-h->enComp_coeff)*powf(cabsf(decorFrame[band][ch][t]), 2.0f) + (h->enComp_coeff)*(h->decor_energy[band][ch]);
-                    decorFrame[band][ch][t] *= SAF_MIN(sqrtf(h->in_energy[band][ch]/(h->decor_energy[band][ch]+2.23e-9f)), 1.0f);
-
-                    /* propagate through the rest of the lattice filter structure */
-                    for(i=0; i<h->lttc_apf[band][ch].order-1; i++){
-                        h->lttc_apf[band][ch].buffer[i] = h->lttc_apf[band][ch].buffer[i+1] +
-                                                          h->lttc_apf[band][ch].coeffs[0][i+1] * xtmp - /* numerator */
-                                                          h->lttc_apf[band][ch].coeffs[1][i+1] * ytmp;  /* denominator */
-                    }
+
+            /* Gather the delayed signals */
+            for(l=0; l<nLanes; l++){
+                x_r[l] = crealf(decorFrame[grp->bandIdx[l]][grp->chIdx[l]][t]);
+                x_i[l] = cimagf(decorFrame[grp->bandIdx[l]][grp->chIdx[l]][t]);
+            }
+
+            /* First tap in filter */
+            num = grp->num[0];
+            s_re = grp->buf_re[0];
+            s_im = grp->buf_im[0];
+            for(l=0; l<nLanes; l++){
+                y_r[l] = x_r[l]*num[l] + s_re[l];
+                y_i[l] = x_i[l]*num[l] + s_im[l];
+            }
+
+            /* Energy compensation */
+            for(l=0; l<nLanes; l++){
+                dec_en[l] = b*(y_r[l]*y_r[l] + y_i[l]*y_i[l]) + a*dec_en[l];
+                gain[l] = SAF_MIN(sqrtf(in_en[l]/(dec_en[l]+2.23e-9f)), 1.0f);
+            }
+
+            /* propagate through the rest of the lattice filter structure */
+            for(i=0; i<grp->order-1; i++){
+                num = grp->num[i+1];
+                den = grp->den[i+1];
+                s_re = grp->buf_re[i];
+                s_im = grp->buf_im[i];
+                s1_re = grp->buf_re[i+1];
+                s1_im = grp->buf_im[i+1];
+                for(l=0; l<nLanes; l++){
+                    s_re[l] = s1_re[l] + num[l]*x_r[l] - den[l]*y_r[l];
+                    s_im[l] = s1_im[l] + num[l]*x_i[l] - den[l]*y_i[l];
                 }
             }
+
+            /* Scatter the energy compensated output */
+            for(l=0; l<nLanes; l++){
+                y_re = gain[l]*y_r[l];
+                y_im = gain[l]*y_i[l];
+                decorFrame[grp->bandIdx[l]][grp->chIdx[l]][t] = cmplxf(y_re, y_im);
+            }
         }
     }
-#endif
 }
 
 void transientDucker_create
@@ -20,10 +20,11 @@
  * @brief Wrappers for optimised discrete/fast Fourier transform (FFT) routines
  *
  * @note If none of the supported optimised FFT implementations are linked, then
- *       saf_fft employs the highly respectable KissFFT (BSD 3-Clause License):
- *       https://github.com/mborgerding/kissfft
+ *       saf_fft employs the built-in SIMD FFT (saf_utility_fft_builtin.c) for
+ *       power-of-2 sizes, and the highly respectable KissFFT (BSD 3-Clause
+ *       License) for all other sizes: https://github.com/mborgerding/kissfft
  * @note If using Apple Accelerate's vDSP for the FFT with an unsupported FFT
- *       size, then KissFFT is employed instead.
+ *       size, then the built-in FFT/KissFFT are employed instead.
  * @note If you would like to use some other FFT implementation, then feel free
  *       to add it and submit a pull request :-)
  *
@@ -37,6 +38,7 @@
 
 #include "saf_utilities.h"
 #include "saf_externals.h"
+#include "saf_utility_fft_builtin.h"
 #ifdef SAF_USE_APPLE_ACCELERATE
 # include "AvailabilityVersions.h"
 # ifdef __MAC_12_0
@@ -49,10 +51,12 @@ typedef struct _saf_stft_data {
     int winsize, hopsize, fftsize, nCHin, nCHout, nBands;
     void* hFFT;
     int numOvrlpAddBlocks, bufferlength, nPrevHops;
-    float* window, *insig_rect_win, *insig_win, *outsig_win;
+    float* window, *insig_rect_win;
+    float* insig_win;  /**< Windowed inputs; FLAT: nCHin x fftsize */
+    float* outsig_win; /**< Windowed outputs; FLAT: nCHout x fftsize */
     float** overlapAddBuffer;
     float*** prev_inhops;
-    float_complex* tmp_fft;
+    float_complex* tmp_fft; /**< Spectra; FLAT: MAX(nCHin, nCHout) x nBands */
     SAF_STFT_FDDATA_FORMAT FDformat;
 
 }saf_stft_data;
@@ -61,7 +65,7 @@ typedef struct _saf_stft_data {
 typedef struct _saf_rfft_data {
     int N;
     float  Scale;
-    int useKissFFT_FLAG;
+    int useDefaultFFT_FLAG;
 #if defined(SAF_USE_FFTW)
     fftwf_plan p_fwd;
     fftwf_plan p_bwd;
@@ -92,16 +96,37 @@ typedef struct _saf_rfft_data {
     MKL_LONG input_strides[2], output_strides[2], Status;
 #endif
     /* DEFAULT: */
+    void* hBuiltinFFT; /**< Built-in FFT (power-of-2 sizes); NULL if KissFFT is used instead */
     kiss_fftr_cfg kissFFThandle_fwd;
     kiss_fftr_cfg kissFFThandle_bkw;
 
+    /* Batched transforms; the layouts (nBatch, strideTD, strideFD) of the
+     * forward and backward plans, as created by saf_rfft_planBatch() */
+    int fwdBatch[3], bwdBatch[3];
+#if defined(SAF_USE_FFTW)
+    fftwf_plan p_fwd_batch;
+    fftwf_plan p_bwd_batch;
+    float* fwd_batchTD;
+    float* bwd_batchTD;
+    fftwf_complex* fwd_batchFD;
+    fftwf_complex* bwd_batchFD;
+#elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
+    DFTI_DESCRIPTOR_HANDLE MKL_FFT_Handle_fwdBatch;
+    DFTI_DESCRIPTOR_HANDLE MKL_FFT_Handle_bwdBatch;
+#elif defined(SAF_USE_APPLE_ACCELERATE) && !defined(SAF_USE_INTERLEAVED_VDSP)
+    FFTSetup VDSP_batchSetup;          /**< vDSP_fftm_zrip setup; 0 if N is not 2^x */
+    vDSP_Length VDSP_batchLog2n;
+    DSPSplitComplex VDSP_fwdBatchSplit; /**< FLAT: nBatch x N/2 */
+    DSPSplitComplex VDSP_bwdBatchSplit; /**< FLAT: nBatch x N/2 */
+#endif
+
 }saf_rfft_data;
 
 /** Data structure for complex-complex FFT transforms */
 typedef struct _saf_fft_data {
     int N;
     float  Scale;
-    int useKissFFT_FLAG;
+    int useDefaultFFT_FLAG;
 #if defined(SAF_USE_FFTW)
     fftwf_plan p_fwd;
     fftwf_plan p_bwd;
@@ -132,6 +157,7 @@ typedef struct _saf_fft_data {
     MKL_LONG Status;
 #endif
     /* DEFAULT: */
+    void* hBuiltinFFT; /**< Built-in FFT (power-of-2 sizes); NULL if KissFFT is used instead */
     kiss_fft_cfg kissFFThandle_fwd;
     kiss_fft_cfg kissFFThandle_bkw;
 
@@ -294,6 +320,45 @@ void hilbert
 /*                     Short-time Fourier Transform (STFT)                    */
 /* ========================================================================== */
 
+/**
+ * (Re)allocates the intermediate buffers of saf_stft, which hold the data of
+ * all channels, so that they may be transformed with one (batched) call.
+ * Note that the zero-padding of the windowed inputs is retained.
+ */
+static void saf_stft_allocScratch
+(
+    saf_stft_data *h
+)
+{
+    free(h->insig_win);
+    free(h->outsig_win);
+    free(h->tmp_fft);
+    h->insig_win = calloc1d(SAF_MAX(h->nCHin, 1)*(h->fftsize), sizeof(float));
+    h->outsig_win = malloc1d(SAF_MAX(h->nCHout, 1)*(h->fftsize)*sizeof(float));
+    h->tmp_fft = malloc1d(SAF_MAX(SAF_MAX(h->nCHin, h->nCHout), 1)*(h->nBands)*sizeof(float_complex));
+
+    /* Batched plans for the layouts used by saf_stft_forward/backward */
+    saf_rfft_planBatch(h->hFFT, h->fftsize, h->nBands, h->nCHin, h->nCHout);
+}
+
+/**
+ * Returns 1 if the spectra of nCH channels are stored one after the other in
+ * memory (e.g. if allocated with malloc3d()), and 0 otherwise
+ */
+static int saf_stft_isContiguous
+(
+    float_complex** dataFD,
+    int nCH,
+    int nBands
+)
+{
+    int ch;
+    for(ch=1; ch<nCH; ch++)
+        if(dataFD[ch] != dataFD[0] + ch*nBands)
+            return 0;
+    return 1;
+}
+
 void saf_stft_create
 (
     void ** const phSTFT,
@@ -318,11 +383,12 @@ void saf_stft_create
     h->fftsize = 2*winsize;
     saf_rfft_create(&(h->hFFT), h->fftsize);
     h->insig_rect_win = calloc1d(h->fftsize, sizeof(float));
-    h->insig_win = calloc1d(h->fftsize, sizeof(float));
 
-    /* Intermediate buffers */
-    h->tmp_fft = malloc1d(h->nBands * sizeof(float_complex));
-    h->outsig_win = malloc1d(h->fftsize*sizeof(float));
+    /* Intermediate buffers (all channels are transformed at once) */
+    h->insig_win = NULL;
+    h->outsig_win = NULL;
+    h->tmp_fft = NULL;
+    saf_stft_allocScratch(h);
     h->nPrevHops = winsize/hopsize-1;
     if (h->nPrevHops>0)
         h->prev_inhops = (float***)calloc3d(h->nPrevHops, nCHin, hopsize, sizeof(float));
@@ -355,6 +421,7 @@ void saf_stft_destroy
         free(h->overlapAddBuffer);
         free(h->insig_rect_win);
         free(h->insig_win);
+        free(h->outsig_win);
         free(h->tmp_fft);
         free(h->prev_inhops);
         free(h);
@@ -373,39 +440,23 @@ void saf_stft_forward
 )
 {
     saf_stft_data *h = (saf_stft_data*)(hSTFT);
-    int ch, j, nHops, t, band, idx, hIdx;
+    int ch, j, nHops, t, band, idx, hIdx, directFLAG;
+    float_complex* spectra;
 
     saf_assert(framesize % h->hopsize == 0, "framesize must be multiple of hopsize");  
     nHops = framesize/h->hopsize;
 
-    /* For linear time-invariant (LTI) operation (i.e. no previous hops are
-     * required) */
-    if(h->winsize==h->hopsize){
-        for (t = 0; t<nHops; t++){
-            for(ch=0; ch < h->nCHin; ch++){
+    idx = 0;
+    for (t = 0; t<nHops; t++){
+        for(ch=0; ch < h->nCHin; ch++){
+            /* For linear time-invariant (LTI) operation (i.e. no previous hops are
+             * required) */
+            if(h->winsize==h->hopsize){
                 /* Window input signal (Rectangular) */
-                memcpy(h->insig_rect_win, &dataTD[ch][t*(h->hopsize)], h->winsize*sizeof(float));
-
-                /* Apply FFT and copy data to output dataFD buffer */
-                switch(h->FDformat){
-                    case SAF_STFT_TIME_CH_BANDS:
-                        saf_rfft_forward(h->hFFT, h->insig_rect_win, dataFD[t][ch]);
-                        break;
-
-                    case SAF_STFT_BANDS_CH_TIME:
-                        saf_rfft_forward(h->hFFT, h->insig_rect_win, h->tmp_fft);
-                        for(band=0; band<h->nBands; band++)
-                            dataFD[band][ch][t] = h->tmp_fft[band];
-                        break;
-                }
+                memcpy(&(h->insig_win[ch*(h->fftsize)]), &dataTD[ch][t*(h->hopsize)], h->winsize*sizeof(float));
             }
-        }
-    }
-    /* For oversampled TF transforms */
-    else{
-        idx = 0;
-        for (t = 0; t<nHops; t++){
-            for(ch=0; ch < h->nCHin; ch++){
+            /* For oversampled TF transforms */
+            else{
                 hIdx = 0;
                 /* Window input signal */
                 while (hIdx < h->winsize){
@@ -415,23 +466,29 @@ void saf_stft_forward
                     memcpy(h->prev_inhops[h->nPrevHops-1][ch], &dataTD[ch][idx], h->hopsize*sizeof(float));
                     hIdx += h->hopsize;
                 }
-                utility_svvmul(h->insig_rect_win, h->window, h->winsize, h->insig_win);
+                utility_svvmul(h->insig_rect_win, h->window, h->winsize, &(h->insig_win[ch*(h->fftsize)]));
+            }
+        }
+        idx += h->hopsize;
 
-                /* Apply FFT and copy data to output dataFD buffer */
-                switch(h->FDformat){
-                    case SAF_STFT_TIME_CH_BANDS:
-                        saf_rfft_forward(h->hFFT, h->insig_win, dataFD[t][ch]);
-                        break;
+        /* Apply FFT (to all channels at once) and copy data to output dataFD buffer */
+        directFLAG = h->FDformat==SAF_STFT_TIME_CH_BANDS && h->nCHin>0 && saf_stft_isContiguous(dataFD[t], h->nCHin, h->nBands);
+        spectra = directFLAG ? dataFD[t][0] : h->tmp_fft;
+        saf_rfft_forward_batch(h->hFFT, h->insig_win, h->fftsize, spectra, h->nBands, h->nCHin);
+        if(!directFLAG){
+            switch(h->FDformat){
+                case SAF_STFT_TIME_CH_BANDS:
+                    for(ch=0; ch < h->nCHin; ch++)
+                        memcpy(dataFD[t][ch], &(spectra[ch*(h->nBands)]), h->nBands*sizeof(float_complex));
+                    break;
 
-                    case SAF_STFT_BANDS_CH_TIME:
-                        saf_rfft_forward(h->hFFT, h->insig_win, h->tmp_fft);
+                case SAF_STFT_BANDS_CH_TIME:
+                    for(ch=0; ch < h->nCHin; ch++)
                         for(band=0; band<h->nBands; band++)
-                            dataFD[band][ch][t] = h->tmp_fft[band];
-                        break;
-                }
+                            dataFD[band][ch][t] = spectra[ch*(h->nBands)+band];
+                    break;
             }
-            idx += h->hopsize;
-        } 
+        }
     }
 }
 
@@ -445,11 +502,33 @@ void saf_stft_backward
 {
     saf_stft_data *h = (saf_stft_data*)(hSTFT);
     int t, ch, nHops, band;
+    float_complex* spectra;
 
     saf_assert(framesize % h->hopsize == 0, "framesize must be multiple of hopsize");
     nHops = framesize/h->hopsize;
 
     for (t = 0; t<nHops; t++){
+        /* Gather the spectra of all channels, and apply inverse FFT (to all channels at once) */
+        switch(h->FDformat){
+            case SAF_STFT_TIME_CH_BANDS:
+                if(h->nCHout>0 && saf_stft_isContiguous(dataFD[t], h->nCHout, h->nBands))
+                    spectra = dataFD[t][0];
+                else{
+                    for(ch=0; ch < h->nCHout; ch++)
+                        memcpy(&(h->tmp_fft[ch*(h->nBands)]), dataFD[t][ch], h->nBands*sizeof(float_complex));
+                    spectra = h->tmp_fft;
+                }
+                break;
+            default:
+            case SAF_STFT_BANDS_CH_TIME:
+                for(ch=0; ch < h->nCHout; ch++)
+                    for(band=0; band<h->nBands; band++)
+                        h->tmp_fft[ch*(h->nBands)+band] = dataFD[band][ch][t];
+                spectra = h->tmp_fft;
+                break;
+        }
+        saf_rfft_backward_batch(h->hFFT, spectra, h->nBands, h->outsig_win, h->fftsize, h->nCHout);
+
         for(ch=0; ch < h->nCHout; ch++){
             /* Shift data down */
             memcpy(h->overlapAddBuffer[ch], h->overlapAddBuffer[ch] + h->hopsize, (h->numOvrlpAddBlocks-1)*(h->hopsize)*sizeof(float));
@@ -457,20 +536,8 @@ void saf_stft_backward
             /* Append with zeros */
             memset(h->overlapAddBuffer[ch] + (h->numOvrlpAddBlocks-1)*(h->hopsize), 0, h->hopsize*sizeof(float));
 
-            /* Apply inverse FFT */
-            switch(h->FDformat){
-                case SAF_STFT_TIME_CH_BANDS:
-                    saf_rfft_backward(h->hFFT, dataFD[t][ch], h->outsig_win);
-                    break;
-                case SAF_STFT_BANDS_CH_TIME:
-                    for(band=0; band<h->nBands; band++)
-                        h->tmp_fft[band] = dataFD[band][ch][t];
-                    saf_rfft_backward(h->hFFT, h->tmp_fft, h->outsig_win);
-                    break;
-            }
-
             /* Overlap-Add 1:hopsize to output buffer */
-            cblas_saxpy(h->fftsize, 1.0f, h->outsig_win, 1, h->overlapAddBuffer[ch], 1);
+            cblas_saxpy(h->fftsize, 1.0f, &(h->outsig_win[ch*(h->fftsize)]), 1, h->overlapAddBuffer[ch], 1);
             memcpy(dataTD[ch] + t*(h->hopsize), h->overlapAddBuffer[ch], h->hopsize*sizeof(float));
         }
     }
@@ -521,6 +588,9 @@ void saf_stft_channelChange
 
         h->nCHout = new_nCHout;
     }
+
+    /* Intermediate buffers */
+    saf_stft_allocScratch(h);
 }
 
 
@@ -528,6 +598,113 @@ void saf_stft_channelChange
 /*                Real<->Half-Complex (Conjugate-Symmetric) FFT               */
 /* ========================================================================== */
 
+#if defined(SAF_USE_FFTW) || defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64) || \
+    (defined(SAF_USE_APPLE_ACCELERATE) && !defined(SAF_USE_INTERLEAVED_VDSP))
+/**
+ * Destroys the batched (many) plan of a saf_rfft instance
+ *
+ * @param[in] h   saf_rfft data
+ * @param[in] bwd 0: forward plan, 1: backward plan
+ */
+static void saf_rfft_destroyBatchPlan
+(
+    saf_rfft_data *h,
+    int bwd
+)
+{
+# if defined(SAF_USE_FFTW)
+    if(!bwd && h->p_fwd_batch!=NULL){
+        fftwf_destroy_plan(h->p_fwd_batch);
+        free(h->fwd_batchTD);
+        free(h->fwd_batchFD);
+        h->p_fwd_batch = NULL;
+    }
+    else if(bwd && h->p_bwd_batch!=NULL){
+        fftwf_destroy_plan(h->p_bwd_batch);
+        free(h->bwd_batchTD);
+        free(h->bwd_batchFD);
+        h->p_bwd_batch = NULL;
+    }
+# elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
+    if(!bwd && h->MKL_FFT_Handle_fwdBatch!=0)
+        h->Status = DftiFreeDescriptor(&(h->MKL_FFT_Handle_fwdBatch));
+    else if(bwd && h->MKL_FFT_Handle_bwdBatch!=0)
+        h->Status = DftiFreeDescriptor(&(h->MKL_FFT_Handle_bwdBatch));
+# else
+    DSPSplitComplex* split;
+    split = bwd ? &(h->VDSP_bwdBatchSplit) : &(h->VDSP_fwdBatchSplit);
+    free(split->realp);
+    free(split->imagp);
+    split->realp = split->imagp = NULL;
+# endif
+    memset(bwd ? h->bwdBatch : h->fwdBatch, 0, 3*sizeof(int));
+}
+
+/**
+ * (Re)creates the batched (many) plan of a saf_rfft instance, if the requested
+ * layout differs from that of the current plan
+ *
+ * @note vDSP_fftm_zrip() transforms the split-complex vectors held by the plan,
+ *       so only nBatch is relevant in this case; and a plan for nBatch vectors
+ *       may also be used for fewer vectors.
+ * @param[in] h        saf_rfft data
+ * @param[in] bwd      0: forward plan, 1: backward plan
+ * @param[in] nBatch   Number of transforms
+ * @param[in] strideTD Distance between consecutive time-domain vectors
+ * @param[in] strideFD Distance between consecutive frequency-domain vectors
+ */
+static void saf_rfft_createBatchPlan
+(
+    saf_rfft_data *h,
+    int bwd,
+    int nBatch,
+    int strideTD,
+    int strideFD
+)
+{
+    int* layout;
+    layout = bwd ? h->bwdBatch : h->fwdBatch;
+    if(layout[0]==nBatch && layout[1]==strideTD && layout[2]==strideFD)
+        return; /* Already planned */
+    saf_rfft_destroyBatchPlan(h, bwd);
+# if defined(SAF_USE_FFTW)
+    if(!bwd){
+        h->fwd_batchTD = malloc1d(nBatch*strideTD*sizeof(float));
+        h->fwd_batchFD = malloc1d(nBatch*strideFD*sizeof(fftwf_complex));
+        h->p_fwd_batch = fftwf_plan_many_dft_r2c(1, &(h->N), nBatch, h->fwd_batchTD, NULL, 1, strideTD,
+                                                 h->fwd_batchFD, NULL, 1, strideFD, FFTW_ESTIMATE);
+    }
+    else{
+        h->bwd_batchTD = malloc1d(nBatch*strideTD*sizeof(float));
+        h->bwd_batchFD = malloc1d(nBatch*strideFD*sizeof(fftwf_complex));
+        h->p_bwd_batch = fftwf_plan_many_dft_c2r(1, &(h->N), nBatch, h->bwd_batchFD, NULL, 1, strideFD,
+                                                 h->bwd_batchTD, NULL, 1, strideTD, FFTW_ESTIMATE);
+    }
+# elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
+    DFTI_DESCRIPTOR_HANDLE* phBatch;
+    phBatch = bwd ? &(h->MKL_FFT_Handle_bwdBatch) : &(h->MKL_FFT_Handle_fwdBatch);
+    h->Status = DftiCreateDescriptor(phBatch, DFTI_SINGLE, DFTI_REAL, 1, h->N);
+    h->Status = DftiSetValue(*phBatch, DFTI_PLACEMENT, DFTI_NOT_INPLACE);
+    h->Status = DftiSetValue(*phBatch, DFTI_CONJUGATE_EVEN_STORAGE, DFTI_COMPLEX_COMPLEX);
+    h->Status = DftiSetValue(*phBatch, DFTI_BACKWARD_SCALE, h->Scale);
+    h->Status = DftiSetValue(*phBatch, DFTI_NUMBER_OF_TRANSFORMS, (MKL_LONG)nBatch);
+    h->Status = DftiSetValue(*phBatch, DFTI_INPUT_DISTANCE,  (MKL_LONG)(bwd ? strideFD : strideTD));
+    h->Status = DftiSetValue(*phBatch, DFTI_OUTPUT_DISTANCE, (MKL_LONG)(bwd ? strideTD : strideFD));
+    h->Status = DftiCommitDescriptor(*phBatch);
+# else
+    if(h->VDSP_batchSetup==0)
+        return; /* Not supported for this N */
+    DSPSplitComplex* split;
+    split = bwd ? &(h->VDSP_bwdBatchSplit) : &(h->VDSP_fwdBatchSplit);
+    split->realp = malloc1d(nBatch*(h->N/2)*sizeof(float));
+    split->imagp = malloc1d(nBatch*(h->N/2)*sizeof(float));
+# endif
+    layout[0] = nBatch;
+    layout[1] = strideTD;
+    layout[2] = strideFD;
+}
+#endif
+
 void saf_rfft_create
 (
     void ** const phFFT,
@@ -540,8 +717,13 @@ void saf_rfft_create
     h->N = N;
     h->Scale = 1.0f/(float)N; /* output scaling after ifft */
     saf_assert(N>=2 && ISEVEN(N), "Only even (non zero) FFT sizes are supported");
-    h->useKissFFT_FLAG = 0;
+    h->useDefaultFFT_FLAG = 0;
+    memset(h->fwdBatch, 0, 3*sizeof(int));
+    memset(h->bwdBatch, 0, 3*sizeof(int));
 #if defined(SAF_USE_FFTW)
+    h->p_fwd_batch = h->p_bwd_batch = NULL;
+    h->fwd_batchTD = h->bwd_batchTD = NULL;
+    h->fwd_batchFD = h->bwd_batchFD = NULL;
     h->fwd_bufferTD = malloc1d(h->N*sizeof(float));
     h->bwd_bufferTD = malloc1d(h->N*sizeof(float));
     h->fwd_bufferFD = malloc1d((h->N/2+1)*sizeof(fftwf_complex));
@@ -579,7 +761,7 @@ void saf_rfft_create
     h->DFT_bwd = vDSP_DFT_zrop_CreateSetup(0, N, vDSP_DFT_INVERSE);
 # endif
     if(h->DFT_fwd==0 || h->DFT_bwd==0) /* specified N not supported by vDSP, so must use the default */
-        h->useKissFFT_FLAG = 1;
+        h->useDefaultFFT_FLAG = 1;
     else{
         /* Note that DFT lengths must satisfy: f * 2.^g, where f is 1, 3, 5, or 15, and g >=4 */
         saf_assert(h->DFT_fwd!=0 && h->DFT_bwd!=0, "Failed to create vDSP DFT");
@@ -590,7 +772,17 @@ void saf_rfft_create
         h->VDSP_split.imagp = malloc1d((h->N/2)*sizeof(float));
 # endif
     }
+# ifndef SAF_USE_INTERLEAVED_VDSP
+    /* vDSP_fftm_zrip() is only defined for 2^x lengths */
+    h->VDSP_batchSetup = 0;
+    h->VDSP_batchLog2n = (vDSP_Length)(log2f((float)N)+0.1f);
+    h->VDSP_fwdBatchSplit.realp = h->VDSP_fwdBatchSplit.imagp = NULL;
+    h->VDSP_bwdBatchSplit.realp = h->VDSP_bwdBatchSplit.imagp = NULL;
+    if(!h->useDefaultFFT_FLAG && (1<<(h->VDSP_batchLog2n))==N)
+        h->VDSP_batchSetup = vDSP_create_fftsetup(h->VDSP_batchLog2n, kFFTRadix2);
+# endif
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
+    h->MKL_FFT_Handle_fwdBatch = h->MKL_FFT_Handle_bwdBatch = 0;
     h->MKL_FFT_Handle = 0;
     h->Status = DftiCreateDescriptor(&(h->MKL_FFT_Handle), DFTI_SINGLE, DFTI_REAL, 1, h->N); /* 1-D, single precision, real_input->fft->half_complex->ifft->real_output */
     h->Status = DftiSetValue(h->MKL_FFT_Handle, DFTI_PLACEMENT, DFTI_NOT_INPLACE); /* Not inplace, i.e. output has its own dedicated memory */
@@ -604,12 +796,17 @@ void saf_rfft_create
     h->Status = DftiCommitDescriptor(h->MKL_FFT_Handle);
 #else
     /* Must use default FFT: */
-    h->useKissFFT_FLAG = 1;
+    h->useDefaultFFT_FLAG = 1;
 #endif
     /* DEFAULT: */
-    if(h->useKissFFT_FLAG){
-        h->kissFFThandle_fwd = kiss_fftr_alloc(h->N, 0, NULL, NULL);
-        h->kissFFThandle_bkw = kiss_fftr_alloc(h->N, 1, NULL, NULL);
+    h->hBuiltinFFT = NULL;
+    if(h->useDefaultFFT_FLAG){
+        if(saf_fftBuiltin_isSupported(h->N))
+            saf_rfftBuiltin_create(&(h->hBuiltinFFT), h->N);
+        else{
+            h->kissFFThandle_fwd = kiss_fftr_alloc(h->N, 0, NULL, NULL);
+            h->kissFFThandle_bkw = kiss_fftr_alloc(h->N, 1, NULL, NULL);
+        }
     }
 }
 
@@ -627,6 +824,8 @@ void saf_rfft_destroy
         free(h->bwd_bufferFD);
         fftwf_destroy_plan(h->p_bwd);
         fftwf_destroy_plan(h->p_fwd);
+        saf_rfft_destroyBatchPlan(h, 0);
+        saf_rfft_destroyBatchPlan(h, 1);
 #elif defined(SAF_USE_INTEL_IPP)
         if(h->useIPPfft_FLAG){
             if(h->memSpec)
@@ -639,7 +838,7 @@ void saf_rfft_destroy
         if(h->buffer)
             ippFree(h->buffer);
 #elif defined(SAF_USE_APPLE_ACCELERATE)
-        if(!h->useKissFFT_FLAG){
+        if(!h->useDefaultFFT_FLAG){
 # ifdef SAF_USE_INTERLEAVED_VDSP
             vDSP_DFT_Interleaved_DestroySetup(h->DFT_fwd);
             vDSP_DFT_Interleaved_DestroySetup(h->DFT_bwd);
@@ -652,12 +851,24 @@ void saf_rfft_destroy
             free(h->VDSP_split.imagp);
 # endif
         }
+# ifndef SAF_USE_INTERLEAVED_VDSP
+        if(h->VDSP_batchSetup!=0)
+            vDSP_destroy_fftsetup(h->VDSP_batchSetup);
+        saf_rfft_destroyBatchPlan(h, 0);
+        saf_rfft_destroyBatchPlan(h, 1);
+# endif
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
         h->Status = DftiFreeDescriptor(&(h->MKL_FFT_Handle));
+        saf_rfft_destroyBatchPlan(h, 0);
+        saf_rfft_destroyBatchPlan(h, 1);
 #endif
-        if(h->useKissFFT_FLAG){
-            kiss_fftr_free(h->kissFFThandle_fwd);
-            kiss_fftr_free(h->kissFFThandle_bkw);
+        if(h->useDefaultFFT_FLAG){
+            if(h->hBuiltinFFT!=NULL)
+                saf_rfftBuiltin_destroy(&(h->hBuiltinFFT));
+            else{
+                kiss_fftr_free(h->kissFFThandle_fwd);
+                kiss_fftr_free(h->kissFFThandle_bkw);
+            }
         }
 
         free(h);
@@ -684,7 +895,7 @@ void saf_rfft_forward
     else
         ippsDFTFwd_RToCCS_32f((Ipp32f*)inputTD, (Ipp32f*)outputFD, h->hDFTspec, h->buffer);
 #elif defined(SAF_USE_APPLE_ACCELERATE)
-    if(!h->useKissFFT_FLAG){
+    if(!h->useDefaultFFT_FLAG){
 # ifdef SAF_USE_INTERLEAVED_VDSP
         saf_print_error("Not implemented yet");
 # else
@@ -706,8 +917,12 @@ void saf_rfft_forward
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     h->Status = DftiComputeForward(h->MKL_FFT_Handle, inputTD, outputFD);
 #endif
-    if(h->useKissFFT_FLAG)
-        kiss_fftr(h->kissFFThandle_fwd, inputTD, (kiss_fft_cpx*)outputFD);
+    if(h->useDefaultFFT_FLAG){
+        if(h->hBuiltinFFT!=NULL)
+            saf_rfftBuiltin_forward(h->hBuiltinFFT, inputTD, outputFD);
+        else
+            kiss_fftr(h->kissFFThandle_fwd, inputTD, (kiss_fft_cpx*)outputFD);
+    }
 }
 
 void saf_rfft_backward
@@ -730,7 +945,7 @@ void saf_rfft_backward
     else
         ippsDFTInv_CCSToR_32f((Ipp32f*)inputFD, (Ipp32f*)outputTD, h->hDFTspec, h->buffer);
 #elif defined(SAF_USE_APPLE_ACCELERATE)
-    if(!h->useKissFFT_FLAG){
+    if(!h->useDefaultFFT_FLAG){
 # ifdef SAF_USE_INTERLEAVED_VDSP
         saf_print_error("Not implemented yet");
 # else
@@ -746,12 +961,160 @@ void saf_rfft_backward
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     h->Status = DftiComputeBackward(h->MKL_FFT_Handle, inputFD, outputTD);
 #endif
-    if(h->useKissFFT_FLAG){
-        kiss_fftri(h->kissFFThandle_bkw, (kiss_fft_cpx*)inputFD, outputTD);
-        cblas_sscal(h->N, 1.0f/(float)(h->N), outputTD, 1);
+    if(h->useDefaultFFT_FLAG){
+        if(h->hBuiltinFFT!=NULL)
+            saf_rfftBuiltin_backward(h->hBuiltinFFT, inputFD, outputTD); /* (scaling is applied internally) */
+        else{
+            kiss_fftri(h->kissFFThandle_bkw, (kiss_fft_cpx*)inputFD, outputTD);
+            cblas_sscal(h->N, 1.0f/(float)(h->N), outputTD, 1);
+        }
     }
 }
 
+void saf_rfft_planBatch
+(
+    void * const hFFT,
+    int strideTD,
+    int strideFD,
+    int nBatchFwd,
+    int nBatchBwd
+)
+{
+    saf_rfft_data *h = (saf_rfft_data*)(hFFT);
+
+    saf_assert(strideTD>=h->N && strideFD>=h->N/2+1, "Vectors must not overlap");
+    SAF_UNUSED(h);
+#if defined(SAF_USE_FFTW) || defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64) || \
+    (defined(SAF_USE_APPLE_ACCELERATE) && !defined(SAF_USE_INTERLEAVED_VDSP))
+    if(nBatchFwd>1)
+        saf_rfft_createBatchPlan(h, 0, nBatchFwd, strideTD, strideFD);
+    else
+        saf_rfft_destroyBatchPlan(h, 0);
+    if(nBatchBwd>1)
+        saf_rfft_createBatchPlan(h, 1, nBatchBwd, strideTD, strideFD);
+    else
+        saf_rfft_destroyBatchPlan(h, 1);
+#else
+    SAF_UNUSED(strideTD);
+    SAF_UNUSED(strideFD);
+    SAF_UNUSED(nBatchFwd);
+    SAF_UNUSED(nBatchBwd);
+#endif
+}
+
+void saf_rfft_forward_batch
+(
+    void * const hFFT,
+    float* inputTD,
+    int strideTD,
+    float_complex* outputFD,
+    int strideFD,
+    int nBatch
+)
+{
+    saf_rfft_data *h = (saf_rfft_data*)(hFFT);
+    int b;
+
+    saf_assert(strideTD>=h->N && strideFD>=h->N/2+1, "Vectors must not overlap");
+    SAF_UNUSED(h);
+#if defined(SAF_USE_FFTW)
+    if(nBatch>1 && h->fwdBatch[0]==nBatch && h->fwdBatch[1]==strideTD && h->fwdBatch[2]==strideFD){
+        for(b=0; b<nBatch; b++)
+            cblas_scopy(h->N, &inputTD[b*strideTD], 1, &(h->fwd_batchTD[b*strideTD]), 1);
+        fftwf_execute(h->p_fwd_batch);
+        for(b=0; b<nBatch; b++)
+            cblas_ccopy(h->N/2+1, &(h->fwd_batchFD[b*strideFD]), 1, &outputFD[b*strideFD], 1);
+        return;
+    }
+#elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
+    if(nBatch>1 && h->fwdBatch[0]==nBatch && h->fwdBatch[1]==strideTD && h->fwdBatch[2]==strideFD){
+        h->Status = DftiComputeForward(h->MKL_FFT_Handle_fwdBatch, inputTD, outputFD);
+        return;
+    }
+#elif defined(SAF_USE_APPLE_ACCELERATE) && !defined(SAF_USE_INTERLEAVED_VDSP)
+    if(nBatch>1 && nBatch<=h->fwdBatch[0]){
+        DSPSplitComplex split;
+        for(b=0; b<nBatch; b++){
+            split.realp = &(h->VDSP_fwdBatchSplit.realp[b*(h->N/2)]);
+            split.imagp = &(h->VDSP_fwdBatchSplit.imagp[b*(h->N/2)]);
+            vDSP_ctoz((DSPComplex*)&inputTD[b*strideTD], 2, &split, 1, (h->N)/2);
+        }
+        vDSP_fftm_zrip(h->VDSP_batchSetup, &(h->VDSP_fwdBatchSplit), 1, (h->N)/2, h->VDSP_batchLog2n, nBatch, kFFTDirection_Forward);
+        for(b=0; b<nBatch; b++){
+            /* Same packing and (2x) scaling as with vDSP_DFT_Execute() in saf_rfft_forward() */
+            split.realp = &(h->VDSP_fwdBatchSplit.realp[b*(h->N/2)]);
+            split.imagp = &(h->VDSP_fwdBatchSplit.imagp[b*(h->N/2)]);
+            outputFD[b*strideFD] = cmplxf(split.realp[0], 0.0f);
+            cblas_scopy(h->N/2-1, &split.realp[1], 1, &((float*)(&outputFD[b*strideFD]))[2], 2);
+            cblas_scopy(h->N/2-1, &split.imagp[1], 1, &((float*)(&outputFD[b*strideFD]))[3], 2);
+            outputFD[b*strideFD+h->N/2] = cmplxf(split.imagp[0], 0.0f);
+            cblas_sscal(2*(h->N/2+1), 0.5f, (float*)&outputFD[b*strideFD], 1);
+        }
+        return;
+    }
+#endif
+    /* Otherwise, one transform at a time: */
+    for(b=0; b<nBatch; b++)
+        saf_rfft_forward(hFFT, &inputTD[b*strideTD], &outputFD[b*strideFD]);
+}
+
+void saf_rfft_backward_batch
+(
+    void * const hFFT,
+    float_complex* inputFD,
+    int strideFD,
+    float* outputTD,
+    int strideTD,
+    int nBatch
+)
+{
+    saf_rfft_data *h = (saf_rfft_data*)(hFFT);
+    int b;
+
+    saf_assert(strideTD>=h->N && strideFD>=h->N/2+1, "Vectors must not overlap");
+    SAF_UNUSED(h);
+#if defined(SAF_USE_FFTW)
+    if(nBatch>1 && h->bwdBatch[0]==nBatch && h->bwdBatch[1]==strideTD && h->bwdBatch[2]==strideFD){
+        for(b=0; b<nBatch; b++)
+            cblas_ccopy(h->N/2+1, &inputFD[b*strideFD], 1, &(h->bwd_batchFD[b*strideFD]), 1);
+        fftwf_execute(h->p_bwd_batch);
+        for(b=0; b<nBatch; b++){
+            cblas_scopy(h->N, &(h->bwd_batchTD[b*strideTD]), 1, &outputTD[b*strideTD], 1);
+            cblas_sscal(h->N, h->Scale, &outputTD[b*strideTD], 1);
+        }
+        return;
+    }
+#elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
+    if(nBatch>1 && h->bwdBatch[0]==nBatch && h->bwdBatch[1]==strideTD && h->bwdBatch[2]==strideFD){
+        h->Status = DftiComputeBackward(h->MKL_FFT_Handle_bwdBatch, inputFD, outputTD);
+        return;
+    }
+#elif defined(SAF_USE_APPLE_ACCELERATE) && !defined(SAF_USE_INTERLEAVED_VDSP)
+    if(nBatch>1 && nBatch<=h->bwdBatch[0]){
+        DSPSplitComplex split;
+        for(b=0; b<nBatch; b++){
+            split.realp = &(h->VDSP_bwdBatchSplit.realp[b*(h->N/2)]);
+            split.imagp = &(h->VDSP_bwdBatchSplit.imagp[b*(h->N/2)]);
+            split.realp[0] = crealf(inputFD[b*strideFD]);
+            split.imagp[0] = crealf(inputFD[b*strideFD+h->N/2]);
+            cblas_scopy(h->N/2-1, &((float*)(&inputFD[b*strideFD]))[2], 2, &split.realp[1], 1);
+            cblas_scopy(h->N/2-1, &((float*)(&inputFD[b*strideFD]))[3], 2, &split.imagp[1], 1);
+        }
+        vDSP_fftm_zrip(h->VDSP_batchSetup, &(h->VDSP_bwdBatchSplit), 1, (h->N)/2, h->VDSP_batchLog2n, nBatch, kFFTDirection_Inverse);
+        for(b=0; b<nBatch; b++){
+            split.realp = &(h->VDSP_bwdBatchSplit.realp[b*(h->N/2)]);
+            split.imagp = &(h->VDSP_bwdBatchSplit.imagp[b*(h->N/2)]);
+            vDSP_ztoc(&split, 1, (DSPComplex*)&outputTD[b*strideTD], 2, (h->N)/2);
+            vDSP_vsmul(&outputTD[b*strideTD], 1, &(h->Scale), &outputTD[b*strideTD], 1, h->N);
+        }
+        return;
+    }
+#endif
+    /* Otherwise, one transform at a time: */
+    for(b=0; b<nBatch; b++)
+        saf_rfft_backward(hFFT, &inputFD[b*strideFD], &outputTD[b*strideTD]);
+}
+
 
 /* ========================================================================== */
 /*                            Complex<->Complex FFT                           */
@@ -769,7 +1132,7 @@ void saf_fft_create
     h->N = N;
     h->Scale = 1.0f/(float)N; /* output scaling after ifft */
     saf_assert(N>=2, "Only even (non zero) FFT sizes are supported");
-    h->useKissFFT_FLAG = 0;
+    h->useDefaultFFT_FLAG = 0;
 #if defined(SAF_USE_FFTW)
     h->fwd_bufferTD = malloc1d(h->N*sizeof(fftwf_complex));
     h->bwd_bufferTD = malloc1d(h->N*sizeof(fftwf_complex));
@@ -808,7 +1171,7 @@ void saf_fft_create
     h->DFT_bwd = vDSP_DFT_zop_CreateSetup(0, N, vDSP_DFT_INVERSE);
 # endif
     if(h->DFT_fwd==0 || h->DFT_bwd==0) /* specified N not supported by vDSP, so must use the default */
-        h->useKissFFT_FLAG = 1;
+        h->useDefaultFFT_FLAG = 1;
     else{
         /* Note that DFT lengths must satisfy: f * 2.^g, where f is 1, 3, 5, or 15, and g >=3 */
         saf_assert(h->DFT_fwd!=0 && h->DFT_bwd!=0, "Failed to create vDSP DFT");
@@ -830,12 +1193,17 @@ void saf_fft_create
     h->Status = DftiCommitDescriptor(h->MKL_FFT_Handle);
 #else
     /* Must use default FFT: */
-    h->useKissFFT_FLAG = 1;
+    h->useDefaultFFT_FLAG = 1;
 #endif
     /* DEFAULT: */
-    if(h->useKissFFT_FLAG){
-        h->kissFFThandle_fwd = kiss_fft_alloc(h->N, 0, NULL, NULL);
-        h->kissFFThandle_bkw = kiss_fft_alloc(h->N, 1, NULL, NULL);
+    h->hBuiltinFFT = NULL;
+    if(h->useDefaultFFT_FLAG){
+        if(saf_fftBuiltin_isSupported(h->N))
+            saf_fftBuiltin_create(&(h->hBuiltinFFT), h->N);
+        else{
+            h->kissFFThandle_fwd = kiss_fft_alloc(h->N, 0, NULL, NULL);
+            h->kissFFThandle_bkw = kiss_fft_alloc(h->N, 1, NULL, NULL);
+        }
     }
 }
 
@@ -866,7 +1234,7 @@ void saf_fft_destroy
         if (h->buffer)
             ippFree(h->buffer);
 #elif defined(SAF_USE_APPLE_ACCELERATE)
-        if(!h->useKissFFT_FLAG){
+        if(!h->useDefaultFFT_FLAG){
 # ifdef SAF_USE_INTERLEAVED_VDSP
             vDSP_DFT_Interleaved_DestroySetup(h->DFT_fwd);
             vDSP_DFT_Interleaved_DestroySetup(h->DFT_bwd);
@@ -882,9 +1250,13 @@ void saf_fft_destroy
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
         h->Status = DftiFreeDescriptor(&(h->MKL_FFT_Handle));
 #endif
-        if(h->useKissFFT_FLAG){
-            kiss_fft_free(h->kissFFThandle_fwd);
-            kiss_fft_free(h->kissFFThandle_bkw);
+        if(h->useDefaultFFT_FLAG){
+            if(h->hBuiltinFFT!=NULL)
+                saf_fftBuiltin_destroy(&(h->hBuiltinFFT));
+            else{
+                kiss_fft_free(h->kissFFThandle_fwd);
+                kiss_fft_free(h->kissFFThandle_bkw);
+            }
         }
 
         free(h);
@@ -911,7 +1283,7 @@ void saf_fft_forward
     else
         ippsDFTFwd_CToC_32fc((Ipp32fc*)inputTD, (Ipp32fc*)outputFD, h->hDFTspec, h->buffer);
 #elif defined(SAF_USE_APPLE_ACCELERATE)
-    if(!h->useKissFFT_FLAG){
+    if(!h->useDefaultFFT_FLAG){
 # ifdef SAF_USE_INTERLEAVED_VDSP
         saf_print_error("Not implemented yet");
 # else
@@ -925,8 +1297,12 @@ void saf_fft_forward
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     h->Status = DftiComputeForward(h->MKL_FFT_Handle, inputTD, outputFD);
 #endif
-    if(h->useKissFFT_FLAG)
-        kiss_fft(h->kissFFThandle_fwd, (kiss_fft_cpx*)inputTD, (kiss_fft_cpx*)outputFD);
+    if(h->useDefaultFFT_FLAG){
+        if(h->hBuiltinFFT!=NULL)
+            saf_fftBuiltin_forward(h->hBuiltinFFT, inputTD, outputFD);
+        else
+            kiss_fft(h->kissFFThandle_fwd, (kiss_fft_cpx*)inputTD, (kiss_fft_cpx*)outputFD);
+    }
 }
 
 void saf_fft_backward
@@ -949,7 +1325,7 @@ void saf_fft_backward
     else
         ippsDFTInv_CToC_32fc((Ipp32fc*)inputFD, (Ipp32fc*)outputTD, h->hDFTspec, h->buffer);
 #elif defined(SAF_USE_APPLE_ACCELERATE)
-    if(!h->useKissFFT_FLAG){
+    if(!h->useDefaultFFT_FLAG){
 # ifdef SAF_USE_INTERLEAVED_VDSP
         saf_print_error("Not implemented yet");
 # else
@@ -964,8 +1340,12 @@ void saf_fft_backward
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     h->Status = DftiComputeBackward(h->MKL_FFT_Handle, inputFD, outputTD);
 #endif
-    if(h->useKissFFT_FLAG){
-        kiss_fft(h->kissFFThandle_bkw, (kiss_fft_cpx*)inputFD, (kiss_fft_cpx*)outputTD);
-        cblas_sscal(/*re+im*/2*(h->N), 1.0f/(float)(h->N), (float*)outputTD, 1);
+    if(h->useDefaultFFT_FLAG){
+        if(h->hBuiltinFFT!=NULL)
+            saf_fftBuiltin_backward(h->hBuiltinFFT, inputFD, outputTD); /* (scaling is applied internally) */
+        else{
+            kiss_fft(h->kissFFThandle_bkw, (kiss_fft_cpx*)inputFD, (kiss_fft_cpx*)outputTD);
+            cblas_sscal(/*re+im*/2*(h->N), 1.0f/(float)(h->N), (float*)outputTD, 1);
+        }
     }
 }
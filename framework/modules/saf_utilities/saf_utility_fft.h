@@ -277,6 +277,81 @@ void saf_rfft_backward(void * const hFFT,
                        float_complex* inputFD,
                        float* outputTD);
 
+/**
+ * Creates the batched ("many") plans employed by saf_rfft_forward_batch() and
+ * saf_rfft_backward_batch() for the given layout
+ *
+ * This function allocates memory, and should therefore be called when the
+ * number of channels changes, rather than from the audio thread. Calling it
+ * again with the same layout does nothing, and an nBatch of 0 or 1 frees the
+ * corresponding plan.
+ *
+ * @test test__saf_rfft_batch()
+ *
+ * @param[in] hFFT      saf_rfft handle
+ * @param[in] strideTD  Distance between consecutive time-domain vectors (>=N)
+ * @param[in] strideFD  Distance between consecutive frequency-domain vectors
+ *                      (>=N/2+1)
+ * @param[in] nBatchFwd Number of vectors for saf_rfft_forward_batch()
+ * @param[in] nBatchBwd Number of vectors for saf_rfft_backward_batch()
+ */
+void saf_rfft_planBatch(void * const hFFT,
+                        int strideTD,
+                        int strideFD,
+                        int nBatchFwd,
+                        int nBatchBwd);
+
+/**
+ * Performs the forward-FFT operation for a batch of vectors (e.g. one per
+ * channel); equivalent to calling saf_rfft_forward() nBatch times
+ *
+ * The vectors are stored one after another, with the given distances between
+ * the start of each vector (e.g. strideTD=N and strideFD=N/2+1 for densely
+ * packed nBatch x N and nBatch x (N/2+1) matrices). If FFTW or Intel MKL are
+ * used, and a plan has been created for this layout (nBatch, strideTD,
+ * strideFD) with saf_rfft_planBatch(), then all of the vectors are transformed
+ * with a single batched ("many") plan. Apple Accelerate similarly employs
+ * vDSP_fftm_zrip() for 2^x sizes, if a plan has been created for at least
+ * nBatch vectors (the strides are irrelevant in this case). Otherwise, the
+ * vectors are transformed one at a time. No memory is allocated by this
+ * function.
+ *
+ * @test test__saf_rfft_batch()
+ *
+ * @param[in]  hFFT     saf_rfft handle
+ * @param[in]  inputTD  Time-domain inputs; FLAT: nBatch x strideTD
+ * @param[in]  strideTD Distance between consecutive input vectors (>=N)
+ * @param[out] outputFD Frequency-domain outputs; FLAT: nBatch x strideFD
+ * @param[in]  strideFD Distance between consecutive output vectors (>=N/2+1)
+ * @param[in]  nBatch   Number of vectors
+ */
+void saf_rfft_forward_batch(void * const hFFT,
+                            float* inputTD,
+                            int strideTD,
+                            float_complex* outputFD,
+                            int strideFD,
+                            int nBatch);
+
+/**
+ * Performs the backward-FFT operation for a batch of vectors (e.g. one per
+ * channel); equivalent to calling saf_rfft_backward() nBatch times
+ *
+ * @note The same conventions and caveats as saf_rfft_forward_batch() apply.
+ *
+ * @param[in]  hFFT     saf_rfft handle
+ * @param[in]  inputFD  Frequency-domain inputs; FLAT: nBatch x strideFD
+ * @param[in]  strideFD Distance between consecutive input vectors (>=N/2+1)
+ * @param[out] outputTD Time-domain outputs; FLAT: nBatch x strideTD
+ * @param[in]  strideTD Distance between consecutive output vectors (>=N)
+ * @param[in]  nBatch   Number of vectors
+ */
+void saf_rfft_backward_batch(void * const hFFT,
+                             float_complex* inputFD,
+                             int strideFD,
+                             float* outputTD,
+                             int strideTD,
+                             int nBatch);
+
 
 /* ========================================================================== */
 /*                            Complex<->Complex FFT                           */
@@ -0,0 +1,514 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_fft_builtin.c
+ * @ingroup Utilities
+ * @brief Built-in (power-of-2) FFT, employed by saf_rfft and saf_fft when no
+ *        optimised FFT is available
+ *
+ * Stockham auto-sort formulation: for a sub-transform length 'n' and stride
+ * 's', each radix-4 stage computes (with m=n/4, W=exp(-i*2*pi/n)):
+ * \code{.m}
+ *     a=x(q+s*p); b=x(q+s*(p+m)); c=x(q+s*(p+2m)); d=x(q+s*(p+3m));
+ *     y(q+s*4p)     =  (a+c) +   (b+d);
+ *     y(q+s*(4p+1)) = ((a-c) - i*(b-d)) * W^p;
+ *     y(q+s*(4p+2)) = ((a+c) -   (b+d)) * W^(2p);
+ *     y(q+s*(4p+3)) = ((a-c) + i*(b-d)) * W^(3p);
+ * \endcode
+ * for p=0:m-1 and q=0:s-1, after which n=n/4 and s=4s. Since the inner loop
+ * (over q) shares the same twiddle factors, it maps directly onto SIMD
+ * registers once s>=4. For the first stage (s=1), the SIMD registers instead
+ * span 4 consecutive values of p, and are transposed before being stored.
+ * This file only employs the baseline 4-wide instruction sets (SSE2/NEON);
+ * the 8- and 16-wide stages are compiled, with the required flags, in
+ * saf_utility_veclib_avx2.c and saf_utility_veclib_avx512.c, and are selected
+ * at run-time (if SAF_ENABLE_SIMD is defined).
+ * The inverse transform is obtained by swapping the real and imaginary parts
+ * of the input and output.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include "saf_utility_fft_builtin.h"
+#ifdef SAF_ENABLE_SIMD
+# include "saf_utility_veclib_simd.h"
+#endif
+
+/* Select the SIMD instruction sets that are available to this translation unit
+ * (SSE2 and NEON are part of the x86_64 and AArch64 baselines, respectively,
+ * so no compiler flags are required for them) */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+# include <emmintrin.h>
+# define SAF_FFT_V4 /**< 4-wide SSE */
+typedef __m128 saf_v4;
+# define V4_LOAD(p)        _mm_loadu_ps(p)
+# define V4_STORE(p, a)    _mm_storeu_ps(p, a)
+# define V4_SET1(s)        _mm_set1_ps(s)
+# define V4_ADD(a, b)      _mm_add_ps(a, b)
+# define V4_SUB(a, b)      _mm_sub_ps(a, b)
+# define V4_MUL(a, b)      _mm_mul_ps(a, b)
+/* Stores a[0],b[0],c[0],d[0],a[1],b[1],... */
+# define V4_STORE_INTERLEAVED4(p, a, b, c, d) do{ \
+    __m128 r0_ = (a), r1_ = (b), r2_ = (c), r3_ = (d); \
+    _MM_TRANSPOSE4_PS(r0_, r1_, r2_, r3_); \
+    _mm_storeu_ps((p), r0_);    _mm_storeu_ps((p)+4, r1_); \
+    _mm_storeu_ps((p)+8, r2_);  _mm_storeu_ps((p)+12, r3_); \
+} while(0)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+# define SAF_FFT_V4 /**< 4-wide NEON */
+typedef float32x4_t saf_v4;
+# define V4_LOAD(p)        vld1q_f32(p)
+# define V4_STORE(p, a)    vst1q_f32(p, a)
+# define V4_SET1(s)        vdupq_n_f32(s)
+# define V4_ADD(a, b)      vaddq_f32(a, b)
+# define V4_SUB(a, b)      vsubq_f32(a, b)
+# define V4_MUL(a, b)      vmulq_f32(a, b)
+/* Stores a[0],b[0],c[0],d[0],a[1],b[1],... */
+# define V4_STORE_INTERLEAVED4(p, a, b, c, d) do{ \
+    float32x4x4_t v_; \
+    v_.val[0] = (a); v_.val[1] = (b); v_.val[2] = (c); v_.val[3] = (d); \
+    vst4q_f32((p), v_); \
+} while(0)
+#endif
+
+#define S_ADD(a, b) ((a)+(b)) /**< scalar add */
+#define S_SUB(a, b) ((a)-(b)) /**< scalar sub */
+#define S_MUL(a, b) ((a)*(b)) /**< scalar mul */
+
+/** Data structure for the built-in complex<->complex FFT */
+typedef struct _saf_fftBuiltin_data {
+    int N;
+    int nRadix4;     /**< Number of radix-4 stages */
+    int radix2FLAG;  /**< 1: a final radix-2 stage is required (odd powers of 2) */
+    float** tw;      /**< Twiddles for each radix-4 stage; nRadix4 x (6*n/4); |w1r|w1i|w2r|w2i|w3r|w3i| */
+    float* re[2];    /**< Ping-pong buffers (real parts); 2 x N */
+    float* im[2];    /**< Ping-pong buffers (imaginary parts); 2 x N */
+
+}saf_fftBuiltin_data;
+
+/** Data structure for the built-in real<->half-complex FFT */
+typedef struct _saf_rfftBuiltin_data {
+    int N;
+    void* hCFFT;     /**< Complex FFT of length N/2 */
+    float* cosTab;   /**< cos(2*pi*k/N); (N/2+1) x 1 */
+    float* sinTab;   /**< sin(2*pi*k/N); (N/2+1) x 1 */
+
+}saf_rfftBuiltin_data;
+
+
+/* ========================================================================== */
+/*                                   Stages                                   */
+/* ========================================================================== */
+
+void saf_fftBuiltin_radix4Stage
+(
+    int n,
+    int s,
+    const float* tw,
+    const float* xr,
+    const float* xi,
+    float* yr,
+    float* yi
+)
+{
+    int p, q, m, i0, i1, i2, i3, o0;
+    m = n/4;
+    p = 0;
+
+#ifdef SAF_FFT_V4
+    /* First stage: vectorise over p (the twiddles are contiguous), and transpose
+     * before storing, since the outputs for each p are contiguous */
+    if(s==1 && m>=4){
+        for(p=0; p<m; p+=4){
+            saf_v4 ar = V4_LOAD(xr+p),     ai = V4_LOAD(xi+p);
+            saf_v4 br = V4_LOAD(xr+p+m),   bi = V4_LOAD(xi+p+m);
+            saf_v4 cr = V4_LOAD(xr+p+2*m), ci = V4_LOAD(xi+p+2*m);
+            saf_v4 dr = V4_LOAD(xr+p+3*m), di = V4_LOAD(xi+p+3*m);
+            saf_v4 w1r = V4_LOAD(tw+p),     w1i = V4_LOAD(tw+m+p);
+            saf_v4 w2r = V4_LOAD(tw+2*m+p), w2i = V4_LOAD(tw+3*m+p);
+            saf_v4 w3r = V4_LOAD(tw+4*m+p), w3i = V4_LOAD(tw+5*m+p);
+            saf_v4 y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+            SAF_FFT_RADIX4_BUTTERFLY(saf_v4, V4_ADD, V4_SUB, V4_MUL)
+            V4_STORE_INTERLEAVED4(yr+4*p, y0r, y1r, y2r, y3r);
+            V4_STORE_INTERLEAVED4(yi+4*p, y0i, y1i, y2i, y3i);
+        }
+        return;
+    }
+#endif
+
+    for(p=0; p<m; p++){
+        i0 = s*p;
+        i1 = s*(p+m);
+        i2 = s*(p+2*m);
+        i3 = s*(p+3*m);
+        o0 = s*4*p;
+        q = 0;
+#ifdef SAF_FFT_V4
+        /* Vectorise over q (the twiddles are the same for all q) */
+        if(s>=4){
+            saf_v4 w1r = V4_SET1(tw[p]),     w1i = V4_SET1(tw[m+p]);
+            saf_v4 w2r = V4_SET1(tw[2*m+p]), w2i = V4_SET1(tw[3*m+p]);
+            saf_v4 w3r = V4_SET1(tw[4*m+p]), w3i = V4_SET1(tw[5*m+p]);
+            for(; q<s; q+=4){
+                saf_v4 ar = V4_LOAD(xr+i0+q), ai = V4_LOAD(xi+i0+q);
+                saf_v4 br = V4_LOAD(xr+i1+q), bi = V4_LOAD(xi+i1+q);
+                saf_v4 cr = V4_LOAD(xr+i2+q), ci = V4_LOAD(xi+i2+q);
+                saf_v4 dr = V4_LOAD(xr+i3+q), di = V4_LOAD(xi+i3+q);
+                saf_v4 y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+                SAF_FFT_RADIX4_BUTTERFLY(saf_v4, V4_ADD, V4_SUB, V4_MUL)
+                V4_STORE(yr+o0+q, y0r);     V4_STORE(yi+o0+q, y0i);
+                V4_STORE(yr+o0+s+q, y1r);   V4_STORE(yi+o0+s+q, y1i);
+                V4_STORE(yr+o0+2*s+q, y2r); V4_STORE(yi+o0+2*s+q, y2i);
+                V4_STORE(yr+o0+3*s+q, y3r); V4_STORE(yi+o0+3*s+q, y3i);
+            }
+            continue;
+        }
+#endif
+        {
+            float w1r = tw[p],     w1i = tw[m+p];
+            float w2r = tw[2*m+p], w2i = tw[3*m+p];
+            float w3r = tw[4*m+p], w3i = tw[5*m+p];
+            for(; q<s; q++){
+                float ar = xr[i0+q], ai = xi[i0+q];
+                float br = xr[i1+q], bi = xi[i1+q];
+                float cr = xr[i2+q], ci = xi[i2+q];
+                float dr = xr[i3+q], di = xi[i3+q];
+                float y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+                SAF_FFT_RADIX4_BUTTERFLY(float, S_ADD, S_SUB, S_MUL)
+                yr[o0+q] = y0r;     yi[o0+q] = y0i;
+                yr[o0+s+q] = y1r;   yi[o0+s+q] = y1i;
+                yr[o0+2*s+q] = y2r; yi[o0+2*s+q] = y2i;
+                yr[o0+3*s+q] = y3r; yi[o0+3*s+q] = y3i;
+            }
+        }
+    }
+}
+
+/** The final radix-2 stage (n=2, stride s), where all twiddles are 1 */
+static void saf_fftBuiltin_radix2Stage
+(
+    int s,
+    const float* xr,
+    const float* xi,
+    float* yr,
+    float* yi
+)
+{
+    int q;
+    q = 0;
+#ifdef SAF_FFT_V4
+    for(; q<(s-3); q+=4){
+        saf_v4 ar = V4_LOAD(xr+q), ai = V4_LOAD(xi+q);
+        saf_v4 br = V4_LOAD(xr+s+q), bi = V4_LOAD(xi+s+q);
+        V4_STORE(yr+q, V4_ADD(ar, br));   V4_STORE(yi+q, V4_ADD(ai, bi));
+        V4_STORE(yr+s+q, V4_SUB(ar, br)); V4_STORE(yi+s+q, V4_SUB(ai, bi));
+    }
+#endif
+    for(; q<s; q++){
+        float ar = xr[q], ai = xi[q], br = xr[s+q], bi = xi[s+q];
+        yr[q] = ar + br;    yi[q] = ai + bi;
+        yr[s+q] = ar - br;  yi[s+q] = ai - bi;
+    }
+}
+
+/**
+ * Performs the forward transform of the data in the first ping-pong buffers,
+ * and returns the index of the ping-pong buffers holding the result. The
+ * inverse transform is obtained by swapping the real and imaginary parts of the
+ * input and output (i.e., swapRIFLAG=1).
+ */
+static int saf_fftBuiltin_execute
+(
+    saf_fftBuiltin_data* h,
+    int swapRIFLAG
+)
+{
+    int st, n, s, cur;
+    float* xr, *xi, *yr, *yi;
+
+    n = h->N;
+    s = 1;
+    cur = 0;
+    for(st=0; st<h->nRadix4+h->radix2FLAG; st++){
+        xr = swapRIFLAG ? h->im[cur]  : h->re[cur];
+        xi = swapRIFLAG ? h->re[cur]  : h->im[cur];
+        yr = swapRIFLAG ? h->im[!cur] : h->re[!cur];
+        yi = swapRIFLAG ? h->re[!cur] : h->im[!cur];
+        if(st<h->nRadix4){
+#ifdef SAF_ENABLE_SIMD
+            saf_veclib_simd()->fftRadix4Stage(n, s, h->tw[st], xr, xi, yr, yi);
+#else
+            saf_fftBuiltin_radix4Stage(n, s, h->tw[st], xr, xi, yr, yi);
+#endif
+        }
+        else
+            saf_fftBuiltin_radix2Stage(s, xr, xi, yr, yi);
+        n /= 4;
+        s *= 4;
+        cur = !cur;
+    }
+    return cur;
+}
+
+
+/* ========================================================================== */
+/*                            Complex<->Complex FFT                           */
+/* ========================================================================== */
+
+int saf_fftBuiltin_isSupported(int N)
+{
+    return N>=1 && (N & (N-1))==0;
+}
+
+void saf_fftBuiltin_create
+(
+    void ** const phFFT,
+    int N
+)
+{
+    *phFFT = malloc1d(sizeof(saf_fftBuiltin_data));
+    saf_fftBuiltin_data *h = (saf_fftBuiltin_data*)(*phFFT);
+    int st, n, m, p, k, log2N;
+    double theta;
+
+    saf_assert(saf_fftBuiltin_isSupported(N), "Only powers of 2 are supported");
+    h->N = N;
+    for(log2N=0; (1<<log2N)<N; log2N++){}
+    h->nRadix4 = log2N/2;
+    h->radix2FLAG = log2N%2;
+
+    /* Twiddle factors for each radix-4 stage: W_n^(k*p), k=1,2,3, p=0:n/4-1 */
+    h->tw = h->nRadix4>0 ? (float**)malloc1d(h->nRadix4*sizeof(float*)) : NULL;
+    n = N;
+    for(st=0; st<h->nRadix4; st++){
+        m = n/4;
+        h->tw[st] = malloc1d(6*m*sizeof(float));
+        for(k=1; k<=3; k++){
+            for(p=0; p<m; p++){
+                theta = -2.0*SAF_PId*(double)(k*p)/(double)n;
+                h->tw[st][(2*k-2)*m+p] = (float)cos(theta);
+                h->tw[st][(2*k-1)*m+p] = (float)sin(theta);
+            }
+        }
+        n = m;
+    }
+
+    /* Ping-pong buffers */
+    h->re[0] = malloc1d(N*sizeof(float));
+    h->re[1] = malloc1d(N*sizeof(float));
+    h->im[0] = malloc1d(N*sizeof(float));
+    h->im[1] = malloc1d(N*sizeof(float));
+}
+
+void saf_fftBuiltin_destroy
+(
+    void ** const phFFT
+)
+{
+    saf_fftBuiltin_data *h = (saf_fftBuiltin_data*)(*phFFT);
+    int st;
+
+    if(h!=NULL){
+        for(st=0; st<h->nRadix4; st++)
+            free(h->tw[st]);
+        free(h->tw);
+        free(h->re[0]);
+        free(h->re[1]);
+        free(h->im[0]);
+        free(h->im[1]);
+        free(h);
+        h=NULL;
+        *phFFT = NULL;
+    }
+}
+
+void saf_fftBuiltin_forward
+(
+    void * const hFFT,
+    const float_complex* inputTD,
+    float_complex* outputFD
+)
+{
+    saf_fftBuiltin_data *h = (saf_fftBuiltin_data*)(hFFT);
+    int i, cur;
+    const float* in;
+    float* out;
+
+    in = (const float*)inputTD;
+    out = (float*)outputFD;
+    for(i=0; i<h->N; i++){
+        h->re[0][i] = in[2*i];
+        h->im[0][i] = in[2*i+1];
+    }
+    cur = saf_fftBuiltin_execute(h, 0);
+    for(i=0; i<h->N; i++){
+        out[2*i]   = h->re[cur][i];
+        out[2*i+1] = h->im[cur][i];
+    }
+}
+
+void saf_fftBuiltin_backward
+(
+    void * const hFFT,
+    const float_complex* inputFD,
+    float_complex* outputTD
+)
+{
+    saf_fftBuiltin_data *h = (saf_fftBuiltin_data*)(hFFT);
+    int i, cur;
+    float scale;
+    const float* in;
+    float* out;
+
+    in = (const float*)inputFD;
+    out = (float*)outputTD;
+    scale = 1.0f/(float)h->N;
+    for(i=0; i<h->N; i++){
+        h->re[0][i] = in[2*i];
+        h->im[0][i] = in[2*i+1];
+    }
+    cur = saf_fftBuiltin_execute(h, 1);
+    for(i=0; i<h->N; i++){
+        out[2*i]   = scale * h->re[cur][i];
+        out[2*i+1] = scale * h->im[cur][i];
+    }
+}
+
+
+/* ========================================================================== */
+/*                Real<->Half-Complex (Conjugate-Symmetric) FFT               */
+/* ========================================================================== */
+
+void saf_rfftBuiltin_create
+(
+    void ** const phFFT,
+    int N
+)
+{
+    *phFFT = malloc1d(sizeof(saf_rfftBuiltin_data));
+    saf_rfftBuiltin_data *h = (saf_rfftBuiltin_data*)(*phFFT);
+    int k;
+
+    saf_assert(N>=2 && saf_fftBuiltin_isSupported(N), "Only powers of 2 are supported");
+    h->N = N;
+    saf_fftBuiltin_create(&(h->hCFFT), N/2);
+    h->cosTab = malloc1d((N/2+1)*sizeof(float));
+    h->sinTab = malloc1d((N/2+1)*sizeof(float));
+    for(k=0; k<=N/2; k++){
+        h->cosTab[k] = (float)cos(2.0*SAF_PId*(double)k/(double)N);
+        h->sinTab[k] = (float)sin(2.0*SAF_PId*(double)k/(double)N);
+    }
+}
+
+void saf_rfftBuiltin_destroy
+(
+    void ** const phFFT
+)
+{
+    saf_rfftBuiltin_data *h = (saf_rfftBuiltin_data*)(*phFFT);
+
+    if(h!=NULL){
+        saf_fftBuiltin_destroy(&(h->hCFFT));
+        free(h->cosTab);
+        free(h->sinTab);
+        free(h);
+        h=NULL;
+        *phFFT = NULL;
+    }
+}
+
+void saf_rfftBuiltin_forward
+(
+    void * const hFFT,
+    const float* inputTD,
+    float_complex* outputFD
+)
+{
+    saf_rfftBuiltin_data *h = (saf_rfftBuiltin_data*)(hFFT);
+    saf_fftBuiltin_data *c = (saf_fftBuiltin_data*)(h->hCFFT);
+    int k, M, cur;
+    float Ar, Ai, Br, Bi, Er, Ei, Dr, Di;
+    float* Zr, *Zi, *out;
+
+    /* The even and odd samples are treated as the real and imaginary parts of
+     * a half-length complex sequence 'z', and Z=fft(z) */
+    M = h->N/2;
+    for(k=0; k<M; k++){
+        c->re[0][k] = inputTD[2*k];
+        c->im[0][k] = inputTD[2*k+1];
+    }
+    cur = saf_fftBuiltin_execute(c, 0);
+    Zr = c->re[cur];
+    Zi = c->im[cur];
+
+    /* X(k) = (Z(k)+conj(Z(M-k)))/2 - i*W_N^k*(Z(k)-conj(Z(M-k)))/2, k=0:M; where Z(M)=Z(0) */
+    out = (float*)outputFD;
+    out[0]     = Zr[0] + Zi[0];
+    out[1]     = 0.0f;
+    out[2*M]   = Zr[0] - Zi[0];
+    out[2*M+1] = 0.0f;
+    for(k=1; k<M; k++){
+        Ar = Zr[k];    Ai = Zi[k];
+        Br = Zr[M-k];  Bi = -Zi[M-k];
+        Er = Ar + Br;  Ei = Ai + Bi;
+        Dr = Ar - Br;  Di = Ai - Bi;
+        out[2*k]   = 0.5f * (Er + h->cosTab[k]*Di - h->sinTab[k]*Dr);
+        out[2*k+1] = 0.5f * (Ei - h->cosTab[k]*Dr - h->sinTab[k]*Di);
+    }
+}
+
+void saf_rfftBuiltin_backward
+(
+    void * const hFFT,
+    const float_complex* inputFD,
+    float* outputTD
+)
+{
+    saf_rfftBuiltin_data *h = (saf_rfftBuiltin_data*)(hFFT);
+    saf_fftBuiltin_data *c = (saf_fftBuiltin_data*)(h->hCFFT);
+    int k, M, cur;
+    float Ar, Ai, Br, Bi, Er, Ei, Dr, Di, scale;
+    const float* in;
+    float* zr, *zi;
+
+    /* 2*Z(k) = (X(k)+conj(X(M-k))) + i*conj(W_N^k)*(X(k)-conj(X(M-k))), k=0:M-1 */
+    M = h->N/2;
+    in = (const float*)inputFD;
+    c->re[0][0] = in[0] + in[2*M];
+    c->im[0][0] = in[0] - in[2*M];
+    for(k=1; k<M; k++){
+        Ar = in[2*k];      Ai = in[2*k+1];
+        Br = in[2*(M-k)];  Bi = -in[2*(M-k)+1];
+        Er = Ar + Br;  Ei = Ai + Bi;
+        Dr = Ar - Br;  Di = Ai - Bi;
+        c->re[0][k] = Er - h->cosTab[k]*Di - h->sinTab[k]*Dr;
+        c->im[0][k] = Ei + h->cosTab[k]*Dr - h->sinTab[k]*Di;
+    }
+
+    /* z=ifft(2*Z)*M/N, where the real and imaginary parts of 'z' are the even and odd samples */
+    cur = saf_fftBuiltin_execute(c, 1);
+    zr = c->re[cur];
+    zi = c->im[cur];
+    scale = 1.0f/(float)h->N;
+    for(k=0; k<M; k++){
+        outputTD[2*k]   = scale * zr[k];
+        outputTD[2*k+1] = scale * zi[k];
+    }
+}
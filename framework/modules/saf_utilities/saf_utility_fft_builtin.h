@@ -0,0 +1,171 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_fft_builtin.h
+ * @ingroup Utilities
+ * @brief Internal header for the built-in (power-of-2) FFT, which is employed
+ *        by saf_rfft and saf_fft when no optimised FFT is available (i.e.,
+ *        instead of kissFFT)
+ *
+ * The transforms are computed with radix-4 Stockham (auto-sort) stages, plus
+ * a final radix-2 stage for odd powers of 2, on split (real/imaginary) data
+ * and with precomputed twiddle tables. The butterflies employ SSE (x86_64) or
+ * NEON (ARM) intrinsics; if SAF_ENABLE_SIMD is defined, then the wider AVX and
+ * AVX-512 butterflies in saf_utility_veclib_avx2.c/saf_utility_veclib_avx512.c
+ * are also employed, if the host CPU supports them (see
+ * saf_veclib_simd_kernels::fftRadix4Stage). Real transforms are computed via a
+ * half-length complex transform.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#ifndef __SAF_UTILITY_FFT_BUILTIN_H_INCLUDED__
+#define __SAF_UTILITY_FFT_BUILTIN_H_INCLUDED__
+
+#include "saf_utilities.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * The radix-4 butterfly, for any vector type (given its ADD/SUB/MUL ops);
+ * inputs: a,b,c,d (re/im), twiddles w1,w2,w3 (re/im); outputs: y0-y3 (re/im)
+ */
+#define SAF_FFT_RADIX4_BUTTERFLY(T, ADD, SUB, MUL) \
+    T apc_r = ADD(ar, cr), apc_i = ADD(ai, ci); \
+    T amc_r = SUB(ar, cr), amc_i = SUB(ai, ci); \
+    T bpd_r = ADD(br, dr), bpd_i = ADD(bi, di); \
+    T bmd_r = SUB(br, dr), bmd_i = SUB(bi, di); \
+    T t_r, t_i; \
+    y0r = ADD(apc_r, bpd_r); \
+    y0i = ADD(apc_i, bpd_i); \
+    t_r = SUB(apc_r, bpd_r);  t_i = SUB(apc_i, bpd_i);  /* (a+c) - (b+d) */ \
+    y2r = SUB(MUL(t_r, w2r), MUL(t_i, w2i)); \
+    y2i = ADD(MUL(t_r, w2i), MUL(t_i, w2r)); \
+    t_r = ADD(amc_r, bmd_i);  t_i = SUB(amc_i, bmd_r);  /* (a-c) - i(b-d) */ \
+    y1r = SUB(MUL(t_r, w1r), MUL(t_i, w1i)); \
+    y1i = ADD(MUL(t_r, w1i), MUL(t_i, w1r)); \
+    t_r = SUB(amc_r, bmd_i);  t_i = ADD(amc_i, bmd_r);  /* (a-c) + i(b-d) */ \
+    y3r = SUB(MUL(t_r, w3r), MUL(t_i, w3i)); \
+    y3i = ADD(MUL(t_r, w3i), MUL(t_i, w3r));
+
+/** Returns 1 if the built-in FFT supports this length (powers of 2), 0 if not */
+int saf_fftBuiltin_isSupported(int N);
+
+/**
+ * One radix-4 Stockham stage of the built-in FFT, employing the baseline SIMD
+ * instruction set (SSE2 or NEON), or plain C
+ *
+ * The wider kernels (saf_veclib_simd_kernels::fftRadix4Stage) fall back to
+ * this function for the stages that they do not vectorise.
+ *
+ * @param[in]  n  Sub-transform length
+ * @param[in]  s  Stride
+ * @param[in]  tw Twiddles; FLAT: |w1r|w1i|w2r|w2i|w3r|w3i|, each n/4 x 1
+ * @param[in]  xr Input (real parts); n*s x 1
+ * @param[in]  xi Input (imaginary parts); n*s x 1
+ * @param[out] yr Output (real parts); n*s x 1
+ * @param[out] yi Output (imaginary parts); n*s x 1
+ */
+void saf_fftBuiltin_radix4Stage(int n,
+                                int s,
+                                const float* tw,
+                                const float* xr,
+                                const float* xi,
+                                float* yr,
+                                float* yi);
+
+/**
+ * Creates an instance of the built-in complex<->complex FFT
+ *
+ * @param[in] phFFT (&) address of the handle
+ * @param[in] N     FFT size (must be a power of 2)
+ */
+void saf_fftBuiltin_create(void ** const phFFT,
+                           int N);
+
+/** Destroys an instance of the built-in complex<->complex FFT */
+void saf_fftBuiltin_destroy(void ** const phFFT);
+
+/**
+ * Forward complex<->complex FFT (in-place operation is supported)
+ *
+ * @param[in]  hFFT     Handle
+ * @param[in]  inputTD  Time-domain input; N x 1
+ * @param[out] outputFD Frequency-domain output; N x 1
+ */
+void saf_fftBuiltin_forward(void * const hFFT,
+                            const float_complex* inputTD,
+                            float_complex* outputFD);
+
+/**
+ * Backward complex<->complex FFT, including the 1/N scaling (in-place
+ * operation is supported)
+ *
+ * @param[in]  hFFT     Handle
+ * @param[in]  inputFD  Frequency-domain input; N x 1
+ * @param[out] outputTD Time-domain output; N x 1
+ */
+void saf_fftBuiltin_backward(void * const hFFT,
+                             const float_complex* inputFD,
+                             float_complex* outputTD);
+
+/**
+ * Creates an instance of the built-in real<->half-complex FFT
+ *
+ * @param[in] phFFT (&) address of the handle
+ * @param[in] N     FFT size (must be a power of 2, and at least 2)
+ */
+void saf_rfftBuiltin_create(void ** const phFFT,
+                            int N);
+
+/** Destroys an instance of the built-in real<->half-complex FFT */
+void saf_rfftBuiltin_destroy(void ** const phFFT);
+
+/**
+ * Forward real to half-complex FFT
+ *
+ * @param[in]  hFFT     Handle
+ * @param[in]  inputTD  Time-domain input; N x 1
+ * @param[out] outputFD Frequency-domain output; (N/2 + 1) x 1
+ */
+void saf_rfftBuiltin_forward(void * const hFFT,
+                             const float* inputTD,
+                             float_complex* outputFD);
+
+/**
+ * Backward half-complex to real FFT, including the 1/N scaling
+ *
+ * @note The imaginary parts of the DC and Nyquist bins are ignored.
+ *
+ * @param[in]  hFFT     Handle
+ * @param[in]  inputFD  Frequency-domain input; (N/2 + 1) x 1
+ * @param[out] outputTD Time-domain output; N x 1
+ */
+void saf_rfftBuiltin_backward(void * const hFFT,
+                              const float_complex* inputFD,
+                              float* outputTD);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __SAF_UTILITY_FFT_BUILTIN_H_INCLUDED__ */
@@ -0,0 +1,531 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_fileCache.c
+ * @ingroup Utilities
+ * @brief A persistent on-disk cache for data that is expensive to derive from
+ *        a source file (e.g. filterbank HRTFs pre-processed from a SOFA file)
+ *
+ * File layout (native byte order, which is verified when opening):
+ *   - a header (safFileCache_header), including the key;
+ *   - a table of contents (safFileCache_entry per array);
+ *   - the array data, each starting at a multiple of
+ *     #SAF_FILECACHE_ALIGNMENT bytes from the start of the file.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include "saf_utilities.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef _WIN32
+# include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# define SAF_FILECACHE_USE_MMAP
+#endif
+
+/** Identifies cache files */
+#define SAF_FILECACHE_MAGIC "SAFCACHE"
+/** Written as-is, in order to detect files written on a machine of different endianness */
+#define SAF_FILECACHE_BYTE_ORDER_MARK ( 0x01020304U )
+/** Alignment of the array data, in bytes */
+#define SAF_FILECACHE_ALIGNMENT ( 64 )
+/** Number of bytes read at a time when hashing files */
+#define SAF_FILECACHE_READ_CHUNK_SIZE ( 1<<20 )
+/** FNV-1a 64-bit offset basis */
+#define SAF_FNV1A_OFFSET_BASIS ( 0xcbf29ce484222325ULL )
+/** FNV-1a 64-bit prime */
+#define SAF_FNV1A_PRIME ( 0x100000001b3ULL )
+
+/** Header of a cache file (80 bytes; no padding) */
+typedef struct _safFileCache_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    char tag[SAF_FILECACHE_MAX_TAG_LENGTH];
+    uint64_t contentHash;
+    int32_t sampleRate;
+    int32_t hopSize;
+    int32_t options;
+    uint32_t nArrays;
+    uint64_t fileSize;
+    uint64_t payloadHash;  /**< Hash of everything following the header */
+
+}safFileCache_header;
+
+/** Table of contents entry for each array (48 bytes; no padding) */
+typedef struct _safFileCache_entry {
+    char name[SAF_FILECACHE_MAX_NAME_LENGTH];
+    uint64_t offset;       /**< From the start of the file, in bytes */
+    uint64_t nBytes;
+
+}safFileCache_entry;
+
+/** Data structure for an opened cache file */
+typedef struct _safFileCache_data {
+    unsigned char* base;   /**< Start of the file contents */
+    uint64_t size;         /**< Size of the file, in bytes */
+    safFileCache_header* header;
+    safFileCache_entry* entries;
+#if defined(_WIN32)
+    HANDLE hFile;
+    HANDLE hMapping;
+#elif !defined(SAF_FILECACHE_USE_MMAP)
+    void* buffer;          /**< The file contents are read into this buffer, where mapping is not supported */
+#endif
+
+}safFileCache_data;
+
+/** Continues an FNV-1a hash over 'len' bytes */
+static uint64_t saf_fnv1a
+(
+    uint64_t hash,
+    const unsigned char* bytes,
+    size_t len
+)
+{
+    size_t i;
+    for(i=0; i<len; i++){
+        hash ^= (uint64_t)bytes[i];
+        hash *= SAF_FNV1A_PRIME;
+    }
+    return hash;
+}
+
+/** Rounds 'x' up to the next multiple of #SAF_FILECACHE_ALIGNMENT */
+static uint64_t saf_fileCache_align
+(
+    uint64_t x
+)
+{
+    return (x + SAF_FILECACHE_ALIGNMENT - 1) / SAF_FILECACHE_ALIGNMENT * SAF_FILECACHE_ALIGNMENT;
+}
+
+SAF_FILECACHE_ERROR_CODES saf_fileCache_hashFile
+(
+    const char* path,
+    unsigned long long* hash
+)
+{
+    FILE* f;
+    unsigned char* chunk;
+    size_t nRead;
+    uint64_t h, fileSize;
+
+    f = fopen(path, "rb");
+    if(f==NULL)
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    chunk = malloc1d(SAF_FILECACHE_READ_CHUNK_SIZE);
+    h = SAF_FNV1A_OFFSET_BASIS;
+    fileSize = 0;
+    while((nRead = fread(chunk, 1, SAF_FILECACHE_READ_CHUNK_SIZE, f)) > 0){
+        h = saf_fnv1a(h, chunk, nRead);
+        fileSize += (uint64_t)nRead;
+    }
+    /* (the file size is also mixed in, since trailing zero bytes would otherwise only weakly affect the hash) */
+    h = saf_fnv1a(h, (unsigned char*)&fileSize, sizeof(uint64_t));
+    free(chunk);
+    if(ferror(f)){
+        fclose(f);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+    fclose(f);
+    *hash = (unsigned long long)h;
+    return SAF_FILECACHE_OK;
+}
+
+char* saf_fileCache_createFilePath
+(
+    const char* directory,
+    const char* sourcePath,
+    const char* tag,
+    int sampleRate,
+    int hopSize,
+    int options,
+    saf_fileCache_key* key
+)
+{
+    char* path;
+    int maxLength;
+
+    saf_assert(strlen(tag) < SAF_FILECACHE_MAX_TAG_LENGTH, "Tag is too long");
+    memset(key, 0, sizeof(saf_fileCache_key));
+    if(saf_fileCache_hashFile(sourcePath, &(key->contentHash))!=SAF_FILECACHE_OK)
+        return NULL;
+    memcpy(key->tag, tag, strlen(tag));
+    key->sampleRate = sampleRate;
+    key->hopSize = hopSize;
+    key->options = options;
+    maxLength = (int)strlen(directory) + SAF_FILECACHE_MAX_FILENAME_LENGTH;
+    path = malloc1d(maxLength);
+    saf_fileCache_getFilePath(directory, key, maxLength, path);
+    return path;
+}
+
+void saf_fileCache_getFilePath
+(
+    const char* directory,
+    const saf_fileCache_key* key,
+    int maxLength,
+    char* path
+)
+{
+    size_t len;
+    const char* sep;
+
+    /* Append a separator, unless the directory already ends with one */
+    len = strlen(directory);
+    sep = len>0 && (directory[len-1]=='/' || directory[len-1]=='\\') ? "" : "/";
+    snprintf(path, (size_t)maxLength, "%s%s%.*s_%016llx_%d_%d_%d.safcache", directory, sep,
+             SAF_FILECACHE_MAX_TAG_LENGTH-1, key->tag, key->contentHash, key->sampleRate, key->hopSize, key->options);
+}
+
+SAF_FILECACHE_ERROR_CODES saf_fileCache_save
+(
+    const char* path,
+    const saf_fileCache_key* key,
+    int nArrays,
+    const char** names,
+    const void** data,
+    const long* nBytes
+)
+{
+    FILE* f;
+    char* tmpPath;
+    int i, ok;
+    uint64_t offset, h;
+    size_t pathLen;
+    safFileCache_header header;
+    safFileCache_entry* entries;
+    const unsigned char zeros[SAF_FILECACHE_ALIGNMENT] = {0};
+
+    /* Table of contents */
+    entries = calloc1d(nArrays > 0 ? nArrays : 1, sizeof(safFileCache_entry));
+    offset = saf_fileCache_align(sizeof(safFileCache_header) + (uint64_t)nArrays*sizeof(safFileCache_entry));
+    for(i=0; i<nArrays; i++){
+        saf_assert(strlen(names[i]) < SAF_FILECACHE_MAX_NAME_LENGTH, "Array name is too long");
+        memcpy(entries[i].name, names[i], strlen(names[i]));
+        entries[i].offset = offset;
+        entries[i].nBytes = (uint64_t)nBytes[i];
+        offset = saf_fileCache_align(offset + (uint64_t)nBytes[i]);
+    }
+
+    /* Header (the payload hash covers the table of contents, the padding and the data) */
+    memset(&header, 0, sizeof(safFileCache_header));
+    memcpy(header.magic, SAF_FILECACHE_MAGIC, 8);
+    header.version = SAF_FILECACHE_VERSION;
+    header.byteOrderMark = SAF_FILECACHE_BYTE_ORDER_MARK;
+    memcpy(header.tag, key->tag, SAF_FILECACHE_MAX_TAG_LENGTH-1); /* (the last character remains null) */
+    header.contentHash = (uint64_t)key->contentHash;
+    header.sampleRate = (int32_t)key->sampleRate;
+    header.hopSize = (int32_t)key->hopSize;
+    header.options = (int32_t)key->options;
+    header.nArrays = (uint32_t)nArrays;
+    header.fileSize = offset;
+    h = saf_fnv1a(SAF_FNV1A_OFFSET_BASIS, (unsigned char*)entries, (size_t)nArrays*sizeof(safFileCache_entry));
+    offset = sizeof(safFileCache_header) + (uint64_t)nArrays*sizeof(safFileCache_entry);
+    for(i=0; i<nArrays; i++){
+        h = saf_fnv1a(h, zeros, (size_t)(entries[i].offset - offset));
+        if(nBytes[i]>0)
+            h = saf_fnv1a(h, (const unsigned char*)data[i], (size_t)nBytes[i]);
+        offset = entries[i].offset + entries[i].nBytes;
+    }
+    h = saf_fnv1a(h, zeros, (size_t)(header.fileSize - offset));
+    header.payloadHash = h;
+
+    /* Write to a temporary file (unique to this call), and then move it into place */
+    pathLen = strlen(path) + 64;
+    tmpPath = malloc1d(pathLen);
+    snprintf(tmpPath, pathLen, "%s.%lx%lx.tmp", path, (unsigned long)(uintptr_t)&header, (unsigned long)clock());
+    f = fopen(tmpPath, "wb");
+    if(f==NULL){
+        free(entries);
+        free(tmpPath);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+    ok = fwrite(&header, sizeof(safFileCache_header), 1, f)==1;
+    if(nArrays>0)
+        ok = ok && fwrite(entries, sizeof(safFileCache_entry), (size_t)nArrays, f)==(size_t)nArrays;
+    offset = sizeof(safFileCache_header) + (uint64_t)nArrays*sizeof(safFileCache_entry);
+    for(i=0; i<nArrays && ok; i++){
+        ok = fwrite(zeros, 1, (size_t)(entries[i].offset - offset), f)==(size_t)(entries[i].offset - offset);
+        if(nBytes[i]>0)
+            ok = ok && fwrite(data[i], 1, (size_t)nBytes[i], f)==(size_t)nBytes[i];
+        offset = entries[i].offset + entries[i].nBytes;
+    }
+    ok = ok && fwrite(zeros, 1, (size_t)(header.fileSize - offset), f)==(size_t)(header.fileSize - offset);
+    ok = (fclose(f)==0) && ok;
+#ifdef _WIN32
+    ok = ok && MoveFileExA(tmpPath, path, MOVEFILE_REPLACE_EXISTING);
+#else
+    ok = ok && rename(tmpPath, path)==0;
+#endif
+    if(!ok)
+        remove(tmpPath);
+
+    /* clean-up */
+    free(entries);
+    free(tmpPath);
+    return ok ? SAF_FILECACHE_OK : SAF_FILECACHE_ERROR_FILE_IO;
+}
+
+SAF_FILECACHE_ERROR_CODES saf_fileCache_open
+(
+    void ** const phCache,
+    const char* path,
+    const saf_fileCache_key* key
+)
+{
+    safFileCache_data* h;
+    safFileCache_header* hdr;
+    uint32_t i;
+    uint64_t tocEnd, hash;
+    SAF_FILECACHE_ERROR_CODES error;
+#if defined(_WIN32)
+    LARGE_INTEGER fileSize;
+#elif defined(SAF_FILECACHE_USE_MMAP)
+    int fd;
+    struct stat st;
+    void* mapped;
+#else
+    FILE* f;
+    long fileSize;
+#endif
+
+    *phCache = NULL;
+    h = calloc1d(1, sizeof(safFileCache_data));
+
+    /* Map (or read) the whole file */
+#if defined(_WIN32)
+    h->hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(h->hFile==INVALID_HANDLE_VALUE || !GetFileSizeEx(h->hFile, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(safFileCache_header)){
+        if(h->hFile!=INVALID_HANDLE_VALUE)
+            CloseHandle(h->hFile);
+        free(h);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+    h->size = (uint64_t)fileSize.QuadPart;
+    h->hMapping = CreateFileMappingA(h->hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    h->base = h->hMapping!=NULL ? (unsigned char*)MapViewOfFile(h->hMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if(h->base==NULL){
+        if(h->hMapping!=NULL)
+            CloseHandle(h->hMapping);
+        CloseHandle(h->hFile);
+        free(h);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+#elif defined(SAF_FILECACHE_USE_MMAP)
+    fd = open(path, O_RDONLY);
+    if(fd<0 || fstat(fd, &st)!=0 || st.st_size < (off_t)sizeof(safFileCache_header)){
+        if(fd>=0)
+            close(fd);
+        free(h);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+    h->size = (uint64_t)st.st_size;
+    mapped = mmap(NULL, (size_t)h->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /* (the mapping remains valid) */
+    if(mapped==MAP_FAILED){
+        free(h);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+    h->base = (unsigned char*)mapped;
+#else
+    f = fopen(path, "rb");
+    if(f==NULL){
+        free(h);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+    fseek(f, 0, SEEK_END);
+    fileSize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if(fileSize < (long)sizeof(safFileCache_header)){
+        fclose(f);
+        free(h);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+    h->size = (uint64_t)fileSize;
+    h->buffer = malloc1d((size_t)fileSize);
+    if(fread(h->buffer, 1, (size_t)fileSize, f)!=(size_t)fileSize){
+        fclose(f);
+        free(h->buffer);
+        free(h);
+        return SAF_FILECACHE_ERROR_FILE_IO;
+    }
+    fclose(f);
+    h->base = (unsigned char*)h->buffer;
+#endif
+    hdr = h->header = (safFileCache_header*)h->base;
+    h->entries = (safFileCache_entry*)(h->base + sizeof(safFileCache_header));
+
+    /* Check that this is an intact cache file, written for the same key */
+    error = SAF_FILECACHE_OK;
+    tocEnd = sizeof(safFileCache_header) + (uint64_t)hdr->nArrays*sizeof(safFileCache_entry);
+    if(memcmp(hdr->magic, SAF_FILECACHE_MAGIC, 8)!=0 || hdr->byteOrderMark!=SAF_FILECACHE_BYTE_ORDER_MARK)
+        error = SAF_FILECACHE_ERROR_INVALID_FILE;
+    else if(hdr->version!=SAF_FILECACHE_VERSION)
+        error = SAF_FILECACHE_ERROR_VERSION_MISMATCH;
+    else if(hdr->fileSize!=h->size || tocEnd > h->size)
+        error = SAF_FILECACHE_ERROR_INVALID_FILE;
+    else if(strncmp(hdr->tag, key->tag, SAF_FILECACHE_MAX_TAG_LENGTH-1)!=0 || hdr->contentHash!=(uint64_t)key->contentHash ||
+            hdr->sampleRate!=(int32_t)key->sampleRate || hdr->hopSize!=(int32_t)key->hopSize || hdr->options!=(int32_t)key->options)
+        error = SAF_FILECACHE_ERROR_KEY_MISMATCH;
+    else{
+        for(i=0; i<hdr->nArrays; i++){
+            if(h->entries[i].offset % SAF_FILECACHE_ALIGNMENT != 0 || h->entries[i].offset < tocEnd ||
+               h->entries[i].offset > h->size || h->entries[i].nBytes > h->size - h->entries[i].offset ||
+               memchr(h->entries[i].name, '\0', SAF_FILECACHE_MAX_NAME_LENGTH)==NULL)
+                error = SAF_FILECACHE_ERROR_INVALID_FILE;
+        }
+        if(error==SAF_FILECACHE_OK){
+            hash = saf_fnv1a(SAF_FNV1A_OFFSET_BASIS, h->base + sizeof(safFileCache_header), (size_t)(h->size - sizeof(safFileCache_header)));
+            if(hash!=hdr->payloadHash)
+                error = SAF_FILECACHE_ERROR_INVALID_FILE;
+        }
+    }
+    if(error!=SAF_FILECACHE_OK){
+        *phCache = (void*)h;
+        saf_fileCache_close(phCache);
+        return error;
+    }
+
+    *phCache = (void*)h;
+    return SAF_FILECACHE_OK;
+}
+
+const void* saf_fileCache_get
+(
+    void * const hCache,
+    const char* name,
+    long nBytes
+)
+{
+    safFileCache_data* h = (safFileCache_data*)(hCache);
+    uint32_t i;
+
+    for(i=0; i<h->header->nArrays; i++)
+        if(strncmp(h->entries[i].name, name, SAF_FILECACHE_MAX_NAME_LENGTH)==0)
+            return h->entries[i].nBytes==(uint64_t)nBytes ? (const void*)(h->base + h->entries[i].offset) : NULL;
+    return NULL;
+}
+
+SAF_FILECACHE_ERROR_CODES saf_fileCache_getDims
+(
+    void * const hCache,
+    int nDims,
+    int* dims
+)
+{
+    const int* cached;
+
+    cached = (const int*)saf_fileCache_get(hCache, "dims", (long)nDims*sizeof(int));
+    if(cached==NULL)
+        return SAF_FILECACHE_ERROR_INVALID_FILE;
+    memcpy(dims, cached, nDims*sizeof(int));
+    return SAF_FILECACHE_OK;
+}
+
+SAF_FILECACHE_ERROR_CODES saf_fileCache_loadArrays
+(
+    void * const hCache,
+    int nArrays,
+    const saf_fileCache_array* arrays
+)
+{
+    int i;
+    const void* cached;
+
+    /* Check that all of the (non-optional) arrays are there first, so that either all or none of them are copied */
+    for(i=0; i<nArrays; i++)
+        if(!arrays[i].optional && saf_fileCache_get(hCache, arrays[i].name, arrays[i].nBytes)==NULL)
+            return SAF_FILECACHE_ERROR_INVALID_FILE;
+    for(i=0; i<nArrays; i++){
+        cached = saf_fileCache_get(hCache, arrays[i].name, arrays[i].nBytes);
+        if(cached!=NULL){
+            *(arrays[i].ppData) = realloc1d(*(arrays[i].ppData), arrays[i].nBytes);
+            memcpy(*(arrays[i].ppData), cached, arrays[i].nBytes);
+        }
+    }
+    return SAF_FILECACHE_OK;
+}
+
+SAF_FILECACHE_ERROR_CODES saf_fileCache_saveArrays
+(
+    const char* path,
+    const saf_fileCache_key* key,
+    int nDims,
+    const int* dims,
+    int nArrays,
+    const saf_fileCache_array* arrays
+)
+{
+    int i;
+    const char** names;
+    const void** data;
+    long* nBytes;
+    SAF_FILECACHE_ERROR_CODES errCode;
+
+    names = malloc1d((nArrays+1)*sizeof(char*));
+    data = malloc1d((nArrays+1)*sizeof(void*));
+    nBytes = malloc1d((nArrays+1)*sizeof(long));
+    names[0] = "dims";
+    data[0] = dims;
+    nBytes[0] = (long)nDims*sizeof(int);
+    for(i=0; i<nArrays; i++){
+        names[i+1] = arrays[i].name;
+        data[i+1] = *(arrays[i].ppData);
+        nBytes[i+1] = arrays[i].nBytes;
+    }
+    errCode = saf_fileCache_save(path, key, nArrays+1, names, data, nBytes);
+
+    /* clean-up */
+    free((void*)names);
+    free((void*)data);
+    free(nBytes);
+    return errCode;
+}
+
+void saf_fileCache_close
+(
+    void ** const phCache
+)
+{
+    safFileCache_data* h = (safFileCache_data*)(*phCache);
+
+    if(h!=NULL){
+#if defined(_WIN32)
+        UnmapViewOfFile(h->base);
+        CloseHandle(h->hMapping);
+        CloseHandle(h->hFile);
+#elif defined(SAF_FILECACHE_USE_MMAP)
+        munmap(h->base, (size_t)h->size);
+#else
+        free(h->buffer);
+#endif
+        free(h);
+        h = NULL;
+        *phCache = NULL;
+    }
+}
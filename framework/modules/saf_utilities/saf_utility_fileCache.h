@@ -0,0 +1,286 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ *@addtogroup Utilities
+ *@{
+ * @file saf_utility_fileCache.h
+ * @brief A persistent on-disk cache for data that is expensive to derive from
+ *        a source file (e.g. filterbank HRTFs pre-processed from a SOFA file)
+ *
+ * A cache file holds a number of named arrays, along with the key under which
+ * they were computed: a hash of the contents of the source file, the sampling
+ * rate, the hop size, a tag describing what was cached, and any other options
+ * that affect the cached data. The file is memory-mapped when opened (where
+ * supported), so the cached arrays may be copied straight out of the page
+ * cache.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#ifndef SAF_FILECACHE_H_INCLUDED
+#define SAF_FILECACHE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Version of the cache file format; files written with any other version are
+ * rejected (bump whenever the layout, or how any cached data is computed,
+ * changes) */
+#define SAF_FILECACHE_VERSION ( 1 )
+
+/** Maximum length of a tag (including the terminating null character) */
+#define SAF_FILECACHE_MAX_TAG_LENGTH ( 32 )
+
+/** Maximum length of an array name (including the terminating null character) */
+#define SAF_FILECACHE_MAX_NAME_LENGTH ( 32 )
+
+/**
+ * Maximum length of the file names returned by saf_fileCache_getFilePath()
+ * (excluding the directory, but including the terminating null character) */
+#define SAF_FILECACHE_MAX_FILENAME_LENGTH ( 128 )
+
+/** saf_fileCache error codes */
+typedef enum {
+    /** None of the error checks failed */
+    SAF_FILECACHE_OK,
+    /** The file could not be opened, read, or written */
+    SAF_FILECACHE_ERROR_FILE_IO,
+    /** Not a cache file, or it is truncated/corrupted */
+    SAF_FILECACHE_ERROR_INVALID_FILE,
+    /** The file was written with a different #SAF_FILECACHE_VERSION */
+    SAF_FILECACHE_ERROR_VERSION_MISMATCH,
+    /** The file was written for a different key */
+    SAF_FILECACHE_ERROR_KEY_MISMATCH
+
+} SAF_FILECACHE_ERROR_CODES;
+
+/** Key under which data is cached; zero-initialise it before filling it in */
+typedef struct _saf_fileCache_key {
+    char tag[SAF_FILECACHE_MAX_TAG_LENGTH]; /**< What is cached, e.g. "binauraliser" */
+    unsigned long long contentHash;         /**< Hash of the source file contents; see saf_fileCache_hashFile() */
+    int sampleRate;                         /**< Sampling rate the data was computed for, Hz */
+    int hopSize;                            /**< Hop size the data was computed for, samples */
+    int options;                            /**< Any other options that affect the cached data */
+
+} saf_fileCache_key;
+
+/**
+ * An array to be loaded from, or saved to, a cache file with
+ * saf_fileCache_loadArrays() and saf_fileCache_saveArrays() */
+typedef struct _saf_fileCache_array {
+    const char* name; /**< Array name */
+    void** ppData;    /**< (&) address of the array (allocated with malloc1d();
+                       *   it is reallocated when loading) */
+    long nBytes;      /**< Size of the array, in bytes */
+    int optional;     /**< 0: the array must be in the file; 1: the array is
+                       *   left unchanged if it is not in the file */
+
+} saf_fileCache_array;
+
+/**
+ * Computes a 64-bit hash (FNV-1a) of the contents of a file
+ *
+ * @test test__saf_fileCache()
+ *
+ * @param[in]  path Path to the file
+ * @param[out] hash (&) hash of the file contents
+ * @returns SAF_FILECACHE_OK, or SAF_FILECACHE_ERROR_FILE_IO if the file could
+ *          not be read
+ */
+SAF_FILECACHE_ERROR_CODES saf_fileCache_hashFile(/* Input Arguments */
+                                                 const char* path,
+                                                 /* Output Arguments */
+                                                 unsigned long long* hash);
+
+/**
+ * Fills in the key for a given source file, and returns the path of its cache
+ * file
+ *
+ * Combines saf_fileCache_hashFile() and saf_fileCache_getFilePath().
+ *
+ * @param[in]  directory  Cache directory
+ * @param[in]  sourcePath Path to the source file
+ * @param[in]  tag        What is cached (shorter than
+ *                        #SAF_FILECACHE_MAX_TAG_LENGTH)
+ * @param[in]  sampleRate Sampling rate the data is computed for, Hz
+ * @param[in]  hopSize    Hop size the data is computed for, samples
+ * @param[in]  options    Any other options that affect the cached data
+ * @param[out] key        Key
+ * @returns Path of the cache file (free it when no longer needed); NULL if the
+ *          source file could not be read
+ */
+char* saf_fileCache_createFilePath(/* Input Arguments */
+                                   const char* directory,
+                                   const char* sourcePath,
+                                   const char* tag,
+                                   int sampleRate,
+                                   int hopSize,
+                                   int options,
+                                   /* Output Arguments */
+                                   saf_fileCache_key* key);
+
+/**
+ * Returns the path of the cache file for a given key and directory
+ *
+ * The file name is derived from all of the fields of the key, so that data
+ * cached for different keys may coexist in the same directory.
+ *
+ * @param[in]  directory Cache directory
+ * @param[in]  key       Key
+ * @param[in]  maxLength Length of 'path' (including the null character); at
+ *                       least strlen(directory) +
+ *                       #SAF_FILECACHE_MAX_FILENAME_LENGTH avoids truncation
+ * @param[out] path      Path of the cache file
+ */
+void saf_fileCache_getFilePath(/* Input Arguments */
+                               const char* directory,
+                               const saf_fileCache_key* key,
+                               int maxLength,
+                               /* Output Arguments */
+                               char* path);
+
+/**
+ * Writes a cache file, holding the given named arrays
+ *
+ * The file is first written under a temporary name, and then renamed, so that
+ * other instances never see a partially written file.
+ *
+ * @param[in] path    Path of the cache file
+ * @param[in] key     Key under which the data was computed
+ * @param[in] nArrays Number of arrays
+ * @param[in] names   Array names; nArrays x 1 (each shorter than
+ *                    #SAF_FILECACHE_MAX_NAME_LENGTH)
+ * @param[in] data    Array data; nArrays x 1 (NULL allowed if nBytes is 0)
+ * @param[in] nBytes  Array sizes, in bytes; nArrays x 1
+ * @returns SAF_FILECACHE_OK, or SAF_FILECACHE_ERROR_FILE_IO
+ */
+SAF_FILECACHE_ERROR_CODES saf_fileCache_save(/* Input Arguments */
+                                             const char* path,
+                                             const saf_fileCache_key* key,
+                                             int nArrays,
+                                             const char** names,
+                                             const void** data,
+                                             const long* nBytes);
+
+/**
+ * Opens (memory-maps) a cache file, and verifies that it is intact and was
+ * written for the given key
+ *
+ * @param[in] phCache (&) address of saf_fileCache handle; NULL if the file
+ *                    could not be opened, or did not pass the checks
+ * @param[in] path    Path of the cache file
+ * @param[in] key     Expected key
+ * @returns SAF_FILECACHE_OK, or an error code (see #SAF_FILECACHE_ERROR_CODES)
+ */
+SAF_FILECACHE_ERROR_CODES saf_fileCache_open(/* Input Arguments */
+                                             void ** const phCache,
+                                             const char* path,
+                                             const saf_fileCache_key* key);
+
+/**
+ * Returns a pointer to the data of a named array in an opened cache file
+ *
+ * @note The data remains valid until saf_fileCache_close() is called. Each
+ *       array starts at a multiple of 64 bytes from the start of the file, so
+ *       it is 64-byte aligned in memory whenever the file is memory-mapped.
+ *
+ * @param[in] hCache saf_fileCache handle
+ * @param[in] name   Array name
+ * @param[in] nBytes Expected size of the array, in bytes
+ * @returns Pointer to the data; NULL if there is no array with this name, or
+ *          if it is not of the expected size
+ */
+const void* saf_fileCache_get(/* Input Arguments */
+                              void * const hCache,
+                              const char* name,
+                              long nBytes);
+
+/**
+ * Copies the integer array named "dims" (written by saf_fileCache_saveArrays())
+ * out of an opened cache file
+ *
+ * @param[in]  hCache saf_fileCache handle
+ * @param[in]  nDims  Number of integers
+ * @param[out] dims   Integers; nDims x 1
+ * @returns SAF_FILECACHE_OK, or SAF_FILECACHE_ERROR_INVALID_FILE if there is no
+ *          such array of this size
+ */
+SAF_FILECACHE_ERROR_CODES saf_fileCache_getDims(/* Input Arguments */
+                                                void * const hCache,
+                                                int nDims,
+                                                /* Output Arguments */
+                                                int* dims);
+
+/**
+ * Copies the given arrays out of an opened cache file
+ *
+ * The arrays are only copied if all of the non-optional ones are in the file
+ * (with the expected sizes); otherwise, none of them are changed.
+ *
+ * @param[in] hCache  saf_fileCache handle
+ * @param[in] nArrays Number of arrays
+ * @param[in] arrays  Arrays to copy (each is reallocated to nBytes);
+ *                    nArrays x 1
+ * @returns SAF_FILECACHE_OK, or SAF_FILECACHE_ERROR_INVALID_FILE if any of the
+ *          non-optional arrays is missing
+ */
+SAF_FILECACHE_ERROR_CODES saf_fileCache_loadArrays(/* Input Arguments */
+                                                   void * const hCache,
+                                                   int nArrays,
+                                                   const saf_fileCache_array* arrays);
+
+/**
+ * Writes a cache file, holding an integer array named "dims" (e.g. the array
+ * sizes, which should be read back first with saf_fileCache_getDims()),
+ * followed by the given arrays
+ *
+ * @param[in] path    Path of the cache file
+ * @param[in] key     Key under which the data was computed
+ * @param[in] nDims   Number of integers in 'dims'
+ * @param[in] dims    Integers; nDims x 1
+ * @param[in] nArrays Number of arrays
+ * @param[in] arrays  Arrays to write; nArrays x 1
+ * @returns SAF_FILECACHE_OK, or SAF_FILECACHE_ERROR_FILE_IO
+ */
+SAF_FILECACHE_ERROR_CODES saf_fileCache_saveArrays(/* Input Arguments */
+                                                   const char* path,
+                                                   const saf_fileCache_key* key,
+                                                   int nDims,
+                                                   const int* dims,
+                                                   int nArrays,
+                                                   const saf_fileCache_array* arrays);
+
+/**
+ * Closes (unmaps) a cache file
+ *
+ * @param[in] phCache (&) address of saf_fileCache handle
+ */
+void saf_fileCache_close(/* Input Arguments */
+                         void ** const phCache);
+
+
+#ifdef __cplusplus
+}/* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* SAF_FILECACHE_H_INCLUDED */
+
+/**@} */ /* doxygen addtogroup Utilities */
@@ -193,6 +193,70 @@ static void applyIIR_3
     }
 }
 
+/**
+ * Applies the same IIR filter of order 1 to several signals (lanes) side by
+ * side; the signals are interleaved (nSamples x nLanes), and the filter state
+ * of lane 'l' is wz[l] */
+static void applyIIRLanes_1
+(
+    float* in_signal,
+    int nSamples,
+    int nLanes,
+    float* b,
+    float* a,
+    float* wz,
+    float* out_signal
+)
+{
+    int n, l;
+    float wn, b0, b1, a1;
+
+    b0 = b[0]; b1 = b[1]; a1 = a[1];
+    for (n=0; n<nSamples; n++){
+        for (l=0; l<nLanes; l++){
+            wn = in_signal[n*nLanes+l] - a1 * wz[l];
+            out_signal[n*nLanes+l] = b0 * wn + b1 * wz[l];
+            wz[l] = wn;
+        }
+    }
+}
+
+/**
+ * Applies the same IIR filter of order 3 to several signals (lanes) side by
+ * side; the signals are interleaved (nSamples x nLanes), and the filter state
+ * of lane 'l' is wz[k*wz_stride+l], k=0..2 */
+static void applyIIRLanes_3
+(
+    float* in_signal,
+    int nSamples,
+    int nLanes,
+    float* b,
+    float* a,
+    float* wz,
+    int wz_stride,
+    float* out_signal
+)
+{
+    int n, l;
+    float wn, b0, b1, b2, b3, a1, a2, a3;
+    float* wz0, *wz1, *wz2;
+
+    b0 = b[0]; b1 = b[1]; b2 = b[2]; b3 = b[3];
+    a1 = a[1]; a2 = a[2]; a3 = a[3];
+    wz0 = wz;
+    wz1 = &wz[wz_stride];
+    wz2 = &wz[2*wz_stride];
+    for (n=0; n<nSamples; n++){
+        for (l=0; l<nLanes; l++){
+            wn = in_signal[n*nLanes+l] - a1 * wz0[l] - a2 * wz1[l] - a3 * wz2[l];
+            out_signal[n*nLanes+l] = b0 * wn + b1 * wz0[l] + b2 * wz1[l] + b3 * wz2[l];
+            wz2[l] = wz1[l];
+            wz1[l] = wz0[l];
+            wz0[l] = wn;
+        }
+    }
+}
+
 
 /* ========================================================================== */
 /*                               Misc. Functions                              */
@@ -892,9 +956,14 @@ void butterCoeffs
     free(kern);
 }
 
+/** Number of samples processed at a time by faf_IIRFilterbank_applyMultiChannel()
+ *  (the channels are interleaved into blocks of this length) */
+#define FAF_LANE_BLOCK_SIZE ( 32 )
+
 /** Main structure for the Favrot&Faller filterbank */
 typedef struct _faf_IIRFB_data{
     int nBands;       /**< Number of bands in the filterbank */
+    int nChannels;    /**< Number of channels (each with its own delay buffers) */
     int nFilters;     /**< Number of filters used by the filterbank */
     int filtLen;      /**< Filter length */
     int filtOrder;    /**< Filter order (must be 1 or 3) */
@@ -904,12 +973,24 @@ typedef struct _faf_IIRFB_data{
     float** a_lpf;    /**< Denominator filter coeffs for low-pass filters */
     float** b_hpf;    /**< Numerator filter coeffs for high-pass filters */
     float** a_hpf;    /**< Denominator filter coeffs for high-pass filters */
-    float*** wz_lpf;  /**< Delay buffers for low-pass filters */
-    float*** wz_hpf;  /**< Delay buffers for high-pass filters */
-    float*** wz_apf1; /**< Delay buffers for all-pass filter part 1 */
-    float*** wz_apf2; /**< Delay buffers for all-pass filter part 2 */
+    float*** wz_lpf;  /**< Delay buffers for low-pass filters; nBands x
+                       *   nFilters x (filtOrder*nChannels) */
+    float*** wz_hpf;  /**< Delay buffers for high-pass filters; nBands x
+                       *   nFilters x (filtOrder*nChannels) */
+    float*** wz_apf1; /**< Delay buffers for all-pass filter part 1; nBands x
+                       *   nFilters x (filtOrder*nChannels) */
+    float*** wz_apf2; /**< Delay buffers for all-pass filter part 2; nBands x
+                       *   nFilters x (filtOrder*nChannels) */
     float* tmp;       /**< Temporary buffer; maxNSamplesToExpect x 1 */
     float* tmp2;      /**< Temporary buffer; maxNSamplesToExpect x 1 */
+    float* lane_in;   /**< Interleaved input block;
+                       *   #FAF_LANE_BLOCK_SIZE x nChannels */
+    float* lane_out;  /**< Interleaved band block;
+                       *   #FAF_LANE_BLOCK_SIZE x nChannels */
+    float* lane_tmp;  /**< Interleaved temporary block;
+                       *   #FAF_LANE_BLOCK_SIZE x nChannels */
+    float* lane_tmp2; /**< Interleaved temporary block;
+                       *   #FAF_LANE_BLOCK_SIZE x nChannels */
 
 }faf_IIRFB_data;
 
@@ -922,6 +1003,20 @@ void faf_IIRFilterbank_create
     float sampleRate,
     int maxNumSamples
 )
+{
+    faf_IIRFilterbank_createMultiChannel(phFaF, order, fc, nCutoffFreq, sampleRate, maxNumSamples, 1);
+}
+
+void faf_IIRFilterbank_createMultiChannel
+(
+    void** phFaF,
+    int order,
+    float* fc,
+    int nCutoffFreq,
+    float sampleRate,
+    int maxNumSamples,
+    int nChannels
+)
 {
     *phFaF = malloc1d(sizeof(faf_IIRFB_data));
     faf_IIRFB_data *fb = (faf_IIRFB_data*)(*phFaF);
@@ -933,6 +1028,7 @@ void faf_IIRFilterbank_create
 
     saf_assert( (order==1) || (order==3), "Only odd number orders are supported, and 5th order+ is numerically unstable");
     saf_assert(nCutoffFreq>1, "Number of filterbank cut-off frequencies must be more than 1");
+    saf_assert(nChannels>0, "Number of channels must be at least 1");
     filtLen = order + 1;
     fb->filtOrder = order;
     fb->filtLen = filtLen;
@@ -947,13 +1043,18 @@ void faf_IIRFilterbank_create
     fb->a_hpf = (float**)malloc2d(nCutoffFreq, filtLen, sizeof(float));
     fb->b_lpf = (float**)malloc2d(nCutoffFreq, filtLen, sizeof(float));
     fb->a_lpf = (float**)malloc2d(nCutoffFreq, filtLen, sizeof(float));
-    fb->wz_hpf = (float***)calloc3d(fb->nBands, nCutoffFreq, order, sizeof(float));
-    fb->wz_lpf = (float***)calloc3d(fb->nBands, nCutoffFreq, order, sizeof(float));
-    fb->wz_apf1 = (float***)calloc3d(fb->nBands, nCutoffFreq, order, sizeof(float));
-    fb->wz_apf2 = (float***)calloc3d(fb->nBands, nCutoffFreq, order, sizeof(float));
+    fb->nChannels = nChannels;
+    fb->wz_hpf = (float***)calloc3d(fb->nBands, nCutoffFreq, order*nChannels, sizeof(float));
+    fb->wz_lpf = (float***)calloc3d(fb->nBands, nCutoffFreq, order*nChannels, sizeof(float));
+    fb->wz_apf1 = (float***)calloc3d(fb->nBands, nCutoffFreq, order*nChannels, sizeof(float));
+    fb->wz_apf2 = (float***)calloc3d(fb->nBands, nCutoffFreq, order*nChannels, sizeof(float));
     fb->maxNSamplesToExpect = maxNumSamples;
     fb->tmp = malloc1d(maxNumSamples*sizeof(float));
     fb->tmp2 = malloc1d(maxNumSamples*sizeof(float));
+    fb->lane_in = malloc1d(FAF_LANE_BLOCK_SIZE*nChannels*sizeof(float));
+    fb->lane_out = malloc1d(FAF_LANE_BLOCK_SIZE*nChannels*sizeof(float));
+    fb->lane_tmp = malloc1d(FAF_LANE_BLOCK_SIZE*nChannels*sizeof(float));
+    fb->lane_tmp2 = malloc1d(FAF_LANE_BLOCK_SIZE*nChannels*sizeof(float));
 
     /* Compute low-pass and complementary high-pass filter coefficients for each
      * cut-off frequency */
@@ -1042,6 +1143,36 @@ void faf_IIRFilterbank_create
     }
 }
 
+/**
+ * Applies one of the filters of the Favrot & Faller filterbank to a single
+ * channel, using the delay buffers of that channel (which are strided by the
+ * number of channels of the filterbank) */
+static void faf_IIRFilterbank_applyFilter
+(
+    faf_IIRFB_data *fb,
+    int channel,
+    float* in,
+    int nSamples,
+    float* b,
+    float* a,
+    float* wz,
+    float* out
+)
+{
+    float wz_ch[3];
+    int k;
+
+    if(fb->nChannels==1)
+        applyIIR(in, nSamples, fb->filtLen, b, a, wz, out);
+    else{
+        for(k=0; k<fb->filtOrder; k++)
+            wz_ch[k] = wz[k*fb->nChannels+channel];
+        applyIIR(in, nSamples, fb->filtLen, b, a, wz_ch, out);
+        for(k=0; k<fb->filtOrder; k++)
+            wz[k*fb->nChannels+channel] = wz_ch[k];
+    }
+}
+
 void faf_IIRFilterbank_apply
 (
     void* hFaF,
@@ -1049,11 +1180,25 @@ void faf_IIRFilterbank_apply
     float** outBands,
     int nSamples
 )
+{
+    saf_assert(((faf_IIRFB_data*)(hFaF))->nChannels==1, "Use faf_IIRFilterbank_applyMultiChannel() for multi-channel filterbanks");
+    faf_IIRFilterbank_applyChannel(hFaF, 0, inSig, outBands, nSamples);
+}
+
+void faf_IIRFilterbank_applyChannel
+(
+    void* hFaF,
+    int channel,
+    float* inSig,
+    float** outBands,
+    int nSamples
+)
 {
     faf_IIRFB_data *fb = (faf_IIRFB_data*)(hFaF);
     int band,j;
 
     saf_assert(nSamples <= fb->maxNSamplesToExpect, "Number of samples exceeds the maximum number informed when calling faf_IIRFilterbank_create()");
+    saf_assert(channel>=0 && channel<fb->nChannels, "Invalid channel index");
 
     /* Copy input signal to all output bands/channels */
     for(band=0; band<fb->nBands; band++)
@@ -1061,18 +1206,18 @@ void faf_IIRFilterbank_apply
 
     /* Band 0 */
     for (j = 0; j<fb->nFilters; j++)
-        applyIIR(outBands[0], nSamples, fb->filtLen, fb->b_lpf[j], fb->a_lpf[j], fb->wz_lpf[0][j], outBands[0]);
+        faf_IIRFilterbank_applyFilter(fb, channel, outBands[0], nSamples, fb->b_lpf[j], fb->a_lpf[j], fb->wz_lpf[0][j], outBands[0]);
 
     /* Band 1 */
-    applyIIR(outBands[1], nSamples, fb->filtLen, fb->b_hpf[0], fb->a_hpf[0], fb->wz_hpf[1][0], outBands[1]);
+    faf_IIRFilterbank_applyFilter(fb, channel, outBands[1], nSamples, fb->b_hpf[0], fb->a_hpf[0], fb->wz_hpf[1][0], outBands[1]);
     for (j = 1; j<fb->nFilters; j++)
-        applyIIR(outBands[1], nSamples, fb->filtLen, fb->b_lpf[j], fb->a_lpf[j], fb->wz_lpf[1][j], outBands[1]);
+        faf_IIRFilterbank_applyFilter(fb, channel, outBands[1], nSamples, fb->b_lpf[j], fb->a_lpf[j], fb->wz_lpf[1][j], outBands[1]);
 
     /* All-pass filters (bands 2..N-1) */
     for (band = 2; band < fb->nBands; band++){
         for (j=0; j<=band-2; j++){
-            applyIIR(outBands[band], nSamples, fb->filtLen, fb->b_lpf[j], fb->a_lpf[j], fb->wz_apf1[band][j], fb->tmp);
-            applyIIR(outBands[band], nSamples, fb->filtLen, fb->b_hpf[j], fb->a_hpf[j], fb->wz_apf2[band][j], fb->tmp2);
+            faf_IIRFilterbank_applyFilter(fb, channel, outBands[band], nSamples, fb->b_lpf[j], fb->a_lpf[j], fb->wz_apf1[band][j], fb->tmp);
+            faf_IIRFilterbank_applyFilter(fb, channel, outBands[band], nSamples, fb->b_hpf[j], fb->a_hpf[j], fb->wz_apf2[band][j], fb->tmp2);
             utility_svvadd(fb->tmp, fb->tmp2, nSamples, outBands[band]);
         }
     }
@@ -1080,17 +1225,95 @@ void faf_IIRFilterbank_apply
     /* Bands 2..N-2 */
     for(band = 2; band< fb->nBands-1; band++){
         /* high-pass filter */
-        applyIIR(outBands[band], nSamples, fb->filtLen, fb->b_hpf[band-1], fb->a_hpf[band-1], fb->wz_hpf[band][band-1], outBands[band]);
+        faf_IIRFilterbank_applyFilter(fb, channel, outBands[band], nSamples, fb->b_hpf[band-1], fb->a_hpf[band-1], fb->wz_hpf[band][band-1], outBands[band]);
 
         /* low-pass filters */
         for(j=band; j<fb->nBands-1; j++)
-            applyIIR(outBands[band], nSamples, fb->filtLen, fb->b_lpf[j], fb->a_lpf[j], fb->wz_lpf[band][j], outBands[band]);
+            faf_IIRFilterbank_applyFilter(fb, channel, outBands[band], nSamples, fb->b_lpf[j], fb->a_lpf[j], fb->wz_lpf[band][j], outBands[band]);
     }
 
     /* Band N-1 */
     if (fb->nBands>2){
-        applyIIR(outBands[fb->nBands-1], nSamples, fb->filtLen, fb->b_hpf[fb->nFilters-1], fb->a_hpf[fb->nFilters-1],
-                 fb->wz_hpf[fb->nBands-1][fb->nFilters-1], outBands[fb->nBands-1]);
+        faf_IIRFilterbank_applyFilter(fb, channel, outBands[fb->nBands-1], nSamples, fb->b_hpf[fb->nFilters-1], fb->a_hpf[fb->nFilters-1],
+                                      fb->wz_hpf[fb->nBands-1][fb->nFilters-1], outBands[fb->nBands-1]);
+    }
+}
+
+/**
+ * Applies one of the filters of the Favrot & Faller filterbank to an
+ * interleaved block of channels (lanes) */
+static void faf_IIRFilterbank_applyLanes
+(
+    faf_IIRFB_data *fb,
+    float* in,
+    int nSamples,
+    int nLanes,
+    float* b,
+    float* a,
+    float* wz,
+    float* out
+)
+{
+    if(fb->filtOrder==1)
+        applyIIRLanes_1(in, nSamples, nLanes, b, a, wz, out);
+    else
+        applyIIRLanes_3(in, nSamples, nLanes, b, a, wz, fb->nChannels, out);
+}
+
+void faf_IIRFilterbank_applyMultiChannel
+(
+    void* hFaF,
+    float** inSigs,
+    float*** outBands,
+    int nChannels,
+    int nSamples
+)
+{
+    faf_IIRFB_data *fb = (faf_IIRFB_data*)(hFaF);
+    int n0, blockLen, n, band, ch, j, nBands, nFilters;
+
+    saf_assert(nChannels <= fb->nChannels, "Number of channels exceeds the number informed when calling faf_IIRFilterbank_createMultiChannel()");
+    nBands = fb->nBands;
+    nFilters = fb->nFilters;
+
+    for(n0=0; n0<nSamples; n0+=FAF_LANE_BLOCK_SIZE){
+        blockLen = SAF_MIN(FAF_LANE_BLOCK_SIZE, nSamples-n0);
+
+        /* Interleave this block of the input signals, such that each channel is a lane */
+        for(ch=0; ch<nChannels; ch++){
+            if(inSigs[ch]==NULL)
+                for(n=0; n<blockLen; n++)
+                    fb->lane_in[n*nChannels+ch] = 0.0f;
+            else
+                for(n=0; n<blockLen; n++)
+                    fb->lane_in[n*nChannels+ch] = inSigs[ch][n0+n];
+        }
+
+        /* Same filters per band as in faf_IIRFilterbank_apply(), but for all channels at once */
+        for(band=0; band<nBands; band++){
+            memcpy(fb->lane_out, fb->lane_in, blockLen*nChannels*sizeof(float));
+
+            /* All-pass filters (bands 2..N-1) */
+            for (j=0; j<=band-2; j++){
+                faf_IIRFilterbank_applyLanes(fb, fb->lane_out, blockLen, nChannels, fb->b_lpf[j], fb->a_lpf[j], fb->wz_apf1[band][j], fb->lane_tmp);
+                faf_IIRFilterbank_applyLanes(fb, fb->lane_out, blockLen, nChannels, fb->b_hpf[j], fb->a_hpf[j], fb->wz_apf2[band][j], fb->lane_tmp2);
+                utility_svvadd(fb->lane_tmp, fb->lane_tmp2, blockLen*nChannels, fb->lane_out);
+            }
+
+            /* High-pass filter (bands 1..N-1) */
+            if(band>0)
+                faf_IIRFilterbank_applyLanes(fb, fb->lane_out, blockLen, nChannels, fb->b_hpf[band-1], fb->a_hpf[band-1], fb->wz_hpf[band][band-1], fb->lane_out);
+
+            /* Low-pass filters (bands 0..N-2) */
+            for(j=band; j<nFilters; j++)
+                faf_IIRFilterbank_applyLanes(fb, fb->lane_out, blockLen, nChannels, fb->b_lpf[j], fb->a_lpf[j], fb->wz_lpf[band][j], fb->lane_out);
+
+            /* De-interleave */
+            for(ch=0; ch<nChannels; ch++)
+                if(outBands[ch]!=NULL)
+                    for(n=0; n<blockLen; n++)
+                        outBands[ch][band][n0+n] = fb->lane_out[n*nChannels+ch];
+        }
     }
 }
 
@@ -1101,10 +1324,32 @@ void faf_IIRFilterbank_flushBuffers
 {
     faf_IIRFB_data *fb = (faf_IIRFB_data*)(hFaF);
 
-    memset(FLATTEN3D(fb->wz_hpf),  0, (fb->nBands) * (fb->nFilters) * (fb->filtOrder) * sizeof(float));
-    memset(FLATTEN3D(fb->wz_lpf),  0, (fb->nBands) * (fb->nFilters) * (fb->filtOrder) * sizeof(float));
-    memset(FLATTEN3D(fb->wz_apf1), 0, (fb->nBands) * (fb->nFilters) * (fb->filtOrder) * sizeof(float));
-    memset(FLATTEN3D(fb->wz_apf2), 0, (fb->nBands) * (fb->nFilters) * (fb->filtOrder) * sizeof(float));
+    memset(FLATTEN3D(fb->wz_hpf),  0, (fb->nBands) * (fb->nFilters) * (fb->filtOrder) * (fb->nChannels) * sizeof(float));
+    memset(FLATTEN3D(fb->wz_lpf),  0, (fb->nBands) * (fb->nFilters) * (fb->filtOrder) * (fb->nChannels) * sizeof(float));
+    memset(FLATTEN3D(fb->wz_apf1), 0, (fb->nBands) * (fb->nFilters) * (fb->filtOrder) * (fb->nChannels) * sizeof(float));
+    memset(FLATTEN3D(fb->wz_apf2), 0, (fb->nBands) * (fb->nFilters) * (fb->filtOrder) * (fb->nChannels) * sizeof(float));
+}
+
+void faf_IIRFilterbank_flushChannel
+(
+    void* hFaF,
+    int channel
+)
+{
+    faf_IIRFB_data *fb = (faf_IIRFB_data*)(hFaF);
+    int band, j, k;
+
+    saf_assert(channel>=0 && channel<fb->nChannels, "Invalid channel index");
+    for(band=0; band<fb->nBands; band++){
+        for(j=0; j<fb->nFilters; j++){
+            for(k=0; k<fb->filtOrder; k++){
+                fb->wz_hpf[band][j][k*fb->nChannels+channel] = 0.0f;
+                fb->wz_lpf[band][j][k*fb->nChannels+channel] = 0.0f;
+                fb->wz_apf1[band][j][k*fb->nChannels+channel] = 0.0f;
+                fb->wz_apf2[band][j][k*fb->nChannels+channel] = 0.0f;
+            }
+        }
+    }
 }
 
 void faf_IIRFilterbank_destroy
@@ -1125,6 +1370,11 @@ void faf_IIRFilterbank_destroy
         free(fb->wz_apf2);
         free(fb->tmp);
         free(fb->tmp2);
+        free(fb->lane_in);
+        free(fb->lane_out);
+        free(fb->lane_tmp);
+        free(fb->lane_tmp2);
+        free(fb);
         fb=NULL;
         *phFaF = NULL;
     }
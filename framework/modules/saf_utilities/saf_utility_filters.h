@@ -372,6 +372,34 @@ void faf_IIRFilterbank_create(void** phFaF,
                               float sampleRate,
                               int maxNumSamples);
 
+/**
+ * Creates an instance of the Favrot & Faller filterbank, for processing
+ * multiple channels at once
+ *
+ * Same as faf_IIRFilterbank_create(), except that each of the nChannels
+ * channels has its own delay buffers. The delay buffers are stored such that
+ * the channels may be filtered side by side (i.e., vectorised across channels),
+ * with faf_IIRFilterbank_applyMultiChannel().
+ *
+ * @test test__faf_IIRFilterbank_multiChannel()
+ *
+ * @param[in] phFaF         (&) address of the faf_IIRFilterbank handle
+ * @param[in] order         Filter order, 1 or 3
+ * @param[in] fc            Vector of cutoff frequencies; nCutoffFreqs x 1
+ * @param[in] nCutoffFreqs  Number of cutoff frequencies in vector 'fc'.
+ * @param[in] sampleRate    Sampling rate in Hz
+ * @param[in] maxNumSamples Maximum number of samples to expect at a time when
+ *                          calling faf_IIRFilterbank_apply()
+ * @param[in] nChannels     Maximum number of channels
+ */
+void faf_IIRFilterbank_createMultiChannel(void** phFaF,
+                                          int order,
+                                          float* fc,
+                                          int nCutoffFreqs,
+                                          float sampleRate,
+                                          int maxNumSamples,
+                                          int nChannels);
+
 /**
  * Applies the Favrot & Faller filterbank
  *
@@ -385,6 +413,51 @@ void faf_IIRFilterbank_apply(void* hFaF,
                              float** outBands,
                              int nSamples);
 
+/**
+ * Applies the Favrot & Faller filterbank to one channel of a multi-channel
+ * filterbank
+ *
+ * Same filtering as faf_IIRFilterbank_applyMultiChannel(), but one channel at
+ * a time (i.e. without interleaving the channels). This is the faster option
+ * when only one or two channels are to be processed. Both functions
+ * share the same delay buffers, so they may be used interchangeably between
+ * calls.
+ *
+ * @param[in]  hFaF     faf_IIRFilterbank handle
+ * @param[in]  channel  Index of the channel (and its delay buffers)
+ * @param[in]  inSig    Input signal; nSamples x 1
+ * @param[out] outBands Output band signals; (nCutoffFreqs+1) x nSamples
+ * @param[in]  nSamples Number of samples to process
+ */
+void faf_IIRFilterbank_applyChannel(void* hFaF,
+                                    int channel,
+                                    float* inSig,
+                                    float** outBands,
+                                    int nSamples);
+
+/**
+ * Applies the Favrot & Faller filterbank to multiple channels at once
+ *
+ * The channels are interleaved in short blocks, and then each filter is
+ * applied to all of them side by side. Channel 'ch' always uses the delay
+ * buffers of channel 'ch' of the filterbank. A NULL input channel is treated
+ * as silence, and a NULL output channel is not written.
+ *
+ * @param[in]  hFaF      faf_IIRFilterbank handle (created with
+ *                       faf_IIRFilterbank_createMultiChannel())
+ * @param[in]  inSigs    Input signals; nChannels x nSamples
+ * @param[out] outBands  Output band signals;
+ *                       nChannels x (nCutoffFreqs+1) x nSamples
+ * @param[in]  nChannels Number of channels to process (the first nChannels
+ *                       of the filterbank)
+ * @param[in]  nSamples  Number of samples to process
+ */
+void faf_IIRFilterbank_applyMultiChannel(void* hFaF,
+                                         float** inSigs,
+                                         float*** outBands,
+                                         int nChannels,
+                                         int nSamples);
+
 /**
  * Zeros the delay lines used during faf_IIRFilterbank_apply()
  *
@@ -392,6 +465,15 @@ void faf_IIRFilterbank_apply(void* hFaF,
  */
 void faf_IIRFilterbank_flushBuffers(void* hFaF);
 
+/**
+ * Zeros the delay lines of one channel of a multi-channel filterbank
+ *
+ * @param[in] hFaF    faf_IIRFilterbank handle
+ * @param[in] channel Channel index
+ */
+void faf_IIRFilterbank_flushChannel(void* hFaF,
+                                    int channel);
+
 /**
  * Destroys an instance of the Favrot & Faller filterbank
  *
@@ -27,10 +27,431 @@
 #include "saf_utilities.h"
 #include "saf_externals.h"
 
+/**
+ * Multiplies the partitioned filter spectra with the input spectra stored in a
+ * circular frequency-domain delay line (FDL)
+ *
+ * The FDL holds nBlocks slots of blockLen complex values; the most recent
+ * input spectra are in slot 'head', the previous ones in slot 'head+1', and so
+ * on (modulo nBlocks). Partition 'nb' of H is therefore multiplied with slot
+ * '(head+nb) % nBlocks', which requires at most two contiguous vector
+ * multiplications.
+ *
+ * @param[in]  H         Partitioned filter spectra; FLAT: nBlocks x blockLen
+ * @param[in]  X_fdl     Input spectra FDL; FLAT: nBlocks x blockLen
+ * @param[in]  head      Index of the FDL slot holding the most recent spectra
+ * @param[in]  nBlocks   Number of partitions/FDL slots
+ * @param[in]  blockLen  Number of complex values per partition/slot
+ * @param[out] HX        Filtered spectra; FLAT: nBlocks x blockLen
+ */
+static void cvvmul_fdl
+(
+    float_complex* H,
+    float_complex* X_fdl,
+    int head,
+    int nBlocks,
+    int blockLen,
+    float_complex* HX
+)
+{
+    int nTail;
+
+    nTail = nBlocks-head;
+    utility_cvvmul(H, &(X_fdl[head*blockLen]), nTail*blockLen, HX);
+    if(head>0)
+        utility_cvvmul(&(H[nTail*blockLen]), X_fdl, head*blockLen, &(HX[nTail*blockLen]));
+}
+
+/* ========================================================================== */
+/*                   Non-Uniformly Partitioned Convolver                      */
+/* ========================================================================== */
+
+/** Maximum partition size employed by the non-uniformly partitioned mode */
+#define SAF_NUPC_MAX_BLOCK_SIZE ( 8192 )
+/** Number of partitions per size, before the size is doubled */
+#define SAF_NUPC_NUM_PARTS_PER_SIZE ( 2 )
+/**
+ * Number of (partition, input) spectra accumulated per unit of work; i.e.,
+ * roughly the cost of one forward fft, (see #_safNUPC_stage)
+ */
+#define SAF_NUPC_NUM_TERMS_PER_UNIT ( 4 )
+
+/**
+ * Scratch memory for one stage of the non-uniformly partitioned convolver;
+ * one per thread, so that the output channels may be processed in parallel.
+ */
+typedef struct _safNUPC_scratch {
+    void* hFFT;
+    float* z_n;
+    float_complex* HX;
+
+}safNUPC_scratch;
+
+/**
+ * Data structure for one stage (i.e., one partition size) of the non-uniformly
+ * partitioned convolver.
+ *
+ * Each stage is a uniformly-partitioned overlap-save convolver, which covers
+ * the filter taps: offset ... offset+nParts*blockSize-1, and which receives a
+ * new block of input once every nHopsPerBlock hops.
+ *
+ * The work required for each new block is divided into units: the forward
+ * fft of each input channel, followed by the accumulation of
+ * #SAF_NUPC_NUM_TERMS_PER_UNIT filtered spectra for each output channel, and
+ * finally the inverse fft of each output channel. These units are spread
+ * evenly over the nHopsToSpread hops, which precede the hop at which the
+ * output of the stage is first required.
+ */
+typedef struct _safNUPC_stage {
+    int blockSize, fftSize, nBins;
+    int nParts, offset;
+    int nHopsPerBlock, hopCount, fdlHead;
+    int nChunks;       /* number of accumulation units per output channel (+1 for the inverse fft) */
+    int nUnits;        /* total number of units of work per block */
+    int unitPos;       /* number of units completed for the current block */
+    int nHopsToSpread; /* number of hops over which the units are spread */
+    int spreadHop;     /* number of hops spent on the current block so far */
+    int wPos;          /* position in the ring buffer where the output begins */
+    float* x_buf;      /* nCHin x fftSize; [previous block, block being filled] */
+    float* x_fft;      /* nCHin x fftSize; the (complete) block being transformed */
+    float_complex* X_fdl;
+    float_complex** H_f;
+    float_complex* Y;  /* nCHout x nBins; output spectra being accumulated */
+    safNUPC_scratch* w; /* nThreads x 1 */
+
+}safNUPC_stage;
+
+/**
+ * Data structure for the non-uniformly partitioned convolver.
+ *
+ * The first stage employs partitions equal to the hop size, and is therefore
+ * computed every hop, (i.e., no latency is introduced beyond the hop size).
+ * The partition sizes of subsequent stages are doubled (up to
+ * #SAF_NUPC_MAX_BLOCK_SIZE), with #SAF_NUPC_NUM_PARTS_PER_SIZE partitions each.
+ * Since a stage with partition size B starts at a filter offset of at least
+ * 2B-2*hopSize (or B-hopSize if it is the first), its output is not required
+ * until B/hopSize-1 hops after its input block is complete. The work for each
+ * block is therefore spread over these hops, and its output is accumulated
+ * into an output ring buffer until it is required.
+ */
+typedef struct _safNUPC_data {
+    int hopSize, nCHin, nCHout;
+    int diagFLAG; /* 1: nCHin==nCHout, and filter 'i' maps input 'i' to output 'i' */
+    int nStages;
+    safNUPC_stage* stages;
+    int ringLen, ringPos;
+    float* ring;  /* nCHout x ringLen */
+    void* hThreadPool;
+    int nThreads;
+    int curStage, curStart, curEnd; /* stage and accumulation units currently being processed by the threads */
+
+}safNUPC_data;
+
+/**
+ * Creates an instance of the non-uniformly partitioned convolver
+ *
+ * @param[in] phNU        (&) address of convolver handle
+ * @param[in] hopSize     Hop size in samples
+ * @param[in] H           Filters; FLAT: nCHout x nCHin x length_h, or
+ *                        nCHin x length_h if diagFLAG==1
+ * @param[in] length_h    Length of the filters
+ * @param[in] nCHin       Number of input channels
+ * @param[in] nCHout      Number of output channels
+ * @param[in] diagFLAG    '1': one filter per channel (multiConv), '0': one
+ *                        filter per input/output pair (matrixConv)
+ * @param[in] uniformFLAG '1': only use partitions equal to the hop size,
+ *                        '0': use non-uniform partitions
+ * @param[in] hThreadPool Thread pool used to process the output channels in
+ *                        parallel (NULL: single-threaded)
+ */
+static void saf_nupc_create
+(
+    void ** const phNU,
+    int hopSize,
+    float* H,
+    int length_h,
+    int nCHin,
+    int nCHout,
+    int diagFLAG,
+    int uniformFLAG,
+    void* hThreadPool
+)
+{
+    *phNU = malloc1d(sizeof(safNUPC_data));
+    safNUPC_data *h = (safNUPC_data*)(*phNU);
+    safNUPC_stage* st;
+    int s, t, no, ni, nb, nH, offset, blockSize, nParts, nTaps, maxBlockSize;
+    float* h_pad;
+
+    h->hopSize = hopSize;
+    h->nCHin = nCHin;
+    h->nCHout = diagFLAG ? nCHin : nCHout;
+    h->diagFLAG = diagFLAG;
+    h->hThreadPool = hThreadPool;
+    h->nThreads = saf_threadPool_getNumThreads(hThreadPool);
+    h->curStage = h->curStart = h->curEnd = 0;
+    maxBlockSize = SAF_MAX(hopSize, SAF_NUPC_MAX_BLOCK_SIZE);
+
+    /* Partitioning scheme */
+    h->stages = NULL;
+    h->nStages = 0;
+    offset = 0;
+    blockSize = hopSize;
+    do{
+        nParts = (int)ceilf((float)(length_h-offset)/(float)blockSize);
+        if(!uniformFLAG && blockSize<maxBlockSize)
+            nParts = SAF_MIN(nParts, SAF_NUPC_NUM_PARTS_PER_SIZE);
+        nParts = SAF_MAX(nParts, 1);
+        h->nStages++;
+        h->stages = realloc1d(h->stages, h->nStages*sizeof(safNUPC_stage));
+        h->stages[h->nStages-1].blockSize = blockSize;
+        h->stages[h->nStages-1].nParts = nParts;
+        h->stages[h->nStages-1].offset = offset;
+        offset += nParts*blockSize;
+        blockSize *= 2;
+    } while(offset<length_h);
+
+    /* Output ring buffer, long enough to hold the output of the final stage */
+    h->ringLen = hopSize * (int)ceilf((float)(hopSize + h->stages[h->nStages-1].offset)/(float)hopSize);
+    h->ringPos = 0;
+    h->ring = calloc1d(h->nCHout*(h->ringLen), sizeof(float));
+
+    /* Initialise the stages, and perform fft on the filter partitions */
+    nH = diagFLAG ? 1 : h->nCHout;
+    for(s=0; s<h->nStages; s++){
+        st = &(h->stages[s]);
+        st->fftSize = 2*(st->blockSize);
+        st->nBins = st->blockSize+1;
+        st->nHopsPerBlock = st->blockSize/hopSize;
+        st->hopCount = 0;
+        st->fdlHead = 0;
+        st->nChunks = (st->nParts*(diagFLAG ? 1 : nCHin) + SAF_NUPC_NUM_TERMS_PER_UNIT - 1)/SAF_NUPC_NUM_TERMS_PER_UNIT;
+        st->nUnits = nCHin + (st->nChunks+1)*(h->nCHout);
+        st->unitPos = st->nUnits; /* (nothing to do until the first block is complete) */
+        saf_assert(st->offset+hopSize-st->blockSize>=0, "Output of a stage is required before its input block is complete");
+        st->nHopsToSpread = SAF_MIN(st->nHopsPerBlock, (st->offset+hopSize-st->blockSize)/hopSize + 1);
+        st->spreadHop = 0;
+        st->wPos = 0;
+        st->x_buf = calloc1d(nCHin*(st->fftSize), sizeof(float));
+        st->x_fft = malloc1d(nCHin*(st->fftSize)*sizeof(float));
+        st->X_fdl = calloc1d(st->nParts*nCHin*(st->nBins), sizeof(float_complex));
+        st->Y = malloc1d(h->nCHout*(st->nBins)*sizeof(float_complex));
+        st->w = malloc1d(h->nThreads*sizeof(safNUPC_scratch));
+        for(t=0; t<h->nThreads; t++){
+            saf_rfft_create(&(st->w[t].hFFT), st->fftSize);
+            st->w[t].z_n = malloc1d(st->fftSize*sizeof(float));
+            st->w[t].HX = malloc1d(st->nBins*sizeof(float_complex));
+        }
+        saf_rfft_planBatch(st->w[0].hFFT, st->fftSize, st->nBins, nCHin, 0); /* (used if all inputs are transformed on the same hop) */
+        st->H_f = (float_complex**)malloc2d(nH, st->nParts*nCHin*(st->nBins), sizeof(float_complex));
+        h_pad = calloc1d(st->fftSize, sizeof(float));
+        for(no=0; no<nH; no++){
+            for(ni=0; ni<nCHin; ni++){
+                for(nb=0; nb<st->nParts; nb++){
+                    /* zero pad filter partition, to be twice the partition size */
+                    memset(h_pad, 0, st->fftSize*sizeof(float));
+                    nTaps = SAF_MIN(st->blockSize, length_h - (st->offset + nb*(st->blockSize)));
+                    if(nTaps>0)
+                        memcpy(h_pad, &(H[no*nCHin*length_h + ni*length_h + st->offset + nb*(st->blockSize)]), nTaps*sizeof(float));
+                    saf_rfft_forward(st->w[0].hFFT, h_pad, &(st->H_f[no][nb*nCHin*(st->nBins)+ni*(st->nBins)]));
+                }
+            }
+        }
+        free(h_pad);
+    }
+}
+
+/**
+ * Destroys an instance of the non-uniformly partitioned convolver
+ *
+ * @param[in] phNU (&) address of convolver handle
+ */
+static void saf_nupc_destroy
+(
+    void ** const phNU
+)
+{
+    safNUPC_data *h = (safNUPC_data*)(*phNU);
+    safNUPC_stage* st;
+    int s, t;
+
+    if(h!=NULL){
+        for(s=0; s<h->nStages; s++){
+            st = &(h->stages[s]);
+            for(t=0; t<h->nThreads; t++){
+                saf_rfft_destroy(&(st->w[t].hFFT));
+                free(st->w[t].z_n);
+                free(st->w[t].HX);
+            }
+            free(st->w);
+            free(st->x_buf);
+            free(st->x_fft);
+            free(st->X_fdl);
+            free(st->Y);
+            free(st->H_f);
+        }
+        free(h->stages);
+        free(h->ring);
+        free(h);
+        h=NULL;
+        *phNU = NULL;
+    }
+}
+
+/**
+ * Adds a block of samples to the output ring buffer (wrapping if needed)
+ */
+static void saf_nupc_ringAdd
+(
+    float* ring,
+    int ringLen,
+    int pos,
+    float* x,
+    int len
+)
+{
+    int len1;
+
+    len1 = SAF_MIN(len, ringLen-pos);
+    cblas_saxpy(len1, 1.0f, x, 1, &ring[pos], 1);
+    if(len1<len)
+        cblas_saxpy(len-len1, 1.0f, &x[len1], 1, ring, 1);
+}
+
+/**
+ * Performs the accumulation and inverse fft units (curStart ... curEnd-1,
+ * numbered over all output channels) of the current stage that belong to one
+ * output channel (task function for saf_threadPool_run())
+ */
+static void saf_nupc_outputTask
+(
+    void* userData,
+    int no,
+    int workerIndex
+)
+{
+    safNUPC_data *h = (safNUPC_data*)(userData);
+    safNUPC_stage* st = &(h->stages[h->curStage]);
+    safNUPC_scratch* w = &(st->w[workerIndex]);
+    int c, c0, c1, t, nSum, nb, ni, slot;
+    float_complex* H_no, *Y_no;
+
+    /* Units of this output channel are: no, no+nCHout, no+2*nCHout, ... */
+    c0 = h->curStart<=no ? 0 : (h->curStart - no + h->nCHout - 1)/(h->nCHout);
+    c1 = h->curEnd<=no ? 0 : (h->curEnd - no + h->nCHout - 1)/(h->nCHout);
+    H_no = h->diagFLAG ? st->H_f[0] : st->H_f[no];
+    Y_no = &(st->Y[no*(st->nBins)]);
+    nSum = h->diagFLAG ? st->nParts : st->nParts*(h->nCHin);
+
+    /* Apply convolution, accumulating over partitions (and inputs) in the frequency domain */
+    for(c=c0; c<SAF_MIN(c1, st->nChunks); c++){
+        for(t=c*SAF_NUPC_NUM_TERMS_PER_UNIT; t<SAF_MIN((c+1)*SAF_NUPC_NUM_TERMS_PER_UNIT, nSum); t++){
+            nb = h->diagFLAG ? t : t/(h->nCHin);
+            ni = h->diagFLAG ? no : t%(h->nCHin);
+            slot = (st->fdlHead + nb) % st->nParts;
+            if(t==0)
+                utility_cvvmul(&(H_no[(nb*(h->nCHin)+ni)*(st->nBins)]), &(st->X_fdl[(slot*(h->nCHin)+ni)*(st->nBins)]), st->nBins, Y_no);
+            else{
+                utility_cvvmul(&(H_no[(nb*(h->nCHin)+ni)*(st->nBins)]), &(st->X_fdl[(slot*(h->nCHin)+ni)*(st->nBins)]), st->nBins, w->HX);
+                cblas_saxpy(2*(st->nBins), 1.0f, (const float*)w->HX, 1, (float*)Y_no, 1);
+            }
+        }
+    }
+
+    /* inverse fft; the last block of the result is free of circular aliasing */
+    if(c0<=st->nChunks && c1==st->nChunks+1){
+        saf_rfft_backward(w->hFFT, Y_no, w->z_n);
+        saf_nupc_ringAdd(&(h->ring[no*(h->ringLen)]), h->ringLen, st->wPos, &(w->z_n[st->blockSize]), st->blockSize);
+    }
+}
+
+/**
+ * Performs the non-uniformly partitioned convolution
+ *
+ * @param[in]  hNU        Convolver handle
+ * @param[in]  inputSig   Input signals;  FLAT: nCHin  x hopSize
+ * @param[out] outputSig  Output signals; FLAT: nCHout x hopSize
+ */
+static void saf_nupc_apply
+(
+    void * const hNU,
+    float* inputSig,
+    float* outputSig
+)
+{
+    safNUPC_data *h = (safNUPC_data*)(hNU);
+    safNUPC_stage* st;
+    int s, ni, no, unitEnd, nFFT;
+
+    for(s=0; s<h->nStages; s++){
+        st = &(h->stages[s]);
+
+        /* Append the new input to the block currently being filled */
+        for(ni=0; ni<h->nCHin; ni++)
+            cblas_scopy(h->hopSize, &(inputSig[ni*(h->hopSize)]), 1, &(st->x_buf[ni*(st->fftSize) + st->blockSize + st->hopCount*(h->hopSize)]), 1);
+        st->hopCount++;
+        if(st->hopCount==st->nHopsPerBlock){
+            st->hopCount = 0;
+            saf_assert(st->unitPos==st->nUnits, "The work for the previous block should have been completed by now");
+
+            /* Block is complete; keep [previous block, current block] for the forward fft, and move the current block along */
+            cblas_scopy(h->nCHin*(st->fftSize), st->x_buf, 1, st->x_fft, 1);
+            for(ni=0; ni<h->nCHin; ni++)
+                cblas_scopy(st->blockSize, &(st->x_buf[ni*(st->fftSize) + st->blockSize]), 1, &(st->x_buf[ni*(st->fftSize)]), 1);
+
+            /* Its spectra go in the (new) head slot of the FDL, and its output begins at this position in the output ring buffer */
+            st->fdlHead = (st->fdlHead + st->nParts - 1) % st->nParts;
+            st->wPos = (h->ringPos + h->hopSize - st->blockSize + st->offset) % h->ringLen;
+            st->unitPos = 0;
+            st->spreadHop = 0;
+        }
+        if(st->unitPos==st->nUnits)
+            continue;
+
+        /* Perform this hop's share of the units of work for the current block (rounded to the nearest unit, rather than
+         * up, so that the stages do not all perform their first units on the hops on which all of their blocks complete) */
+        unitEnd = ((st->spreadHop+1)*(st->nUnits) + st->nHopsToSpread/2)/(st->nHopsToSpread);
+        st->spreadHop++;
+        if(st->unitPos<h->nCHin){
+            /* forward fft of the inputs */
+            nFFT = SAF_MIN(unitEnd, h->nCHin) - st->unitPos;
+            saf_rfft_forward_batch(st->w[0].hFFT, &(st->x_fft[st->unitPos*(st->fftSize)]), st->fftSize,
+                                   &(st->X_fdl[((st->fdlHead)*(h->nCHin) + st->unitPos)*(st->nBins)]), st->nBins, nFFT);
+            st->unitPos += nFFT;
+        }
+        if(st->unitPos<unitEnd){
+            /* Apply convolution and inverse fft (spread over the threads, one output channel per task) */
+            h->curStage = s;
+            h->curStart = st->unitPos - h->nCHin;
+            h->curEnd = unitEnd - h->nCHin;
+            saf_threadPool_run(h->hThreadPool, saf_nupc_outputTask, (void*)h, h->nCHout);
+            st->unitPos = unitEnd;
+        }
+    }
+
+    /* Output the current hop, and clear it for re-use */
+    for(no=0; no<h->nCHout; no++){
+        cblas_scopy(h->hopSize, &(h->ring[no*(h->ringLen) + h->ringPos]), 1, &(outputSig[no*(h->hopSize)]), 1);
+        memset(&(h->ring[no*(h->ringLen) + h->ringPos]), 0, h->hopSize*sizeof(float));
+    }
+    h->ringPos = (h->ringPos + h->hopSize) % h->ringLen;
+}
+
 /* ========================================================================== */
 /*                              Matrix Convolver                              */
 /* ========================================================================== */
 
+/**
+ * Scratch memory for the matrix convolver; one per thread, so that the output
+ * channels may be processed in parallel.
+ */
+typedef struct _safMatConv_scratch {
+    void* hFFT;
+    float* hx_n, *z_n;
+    float_complex* HX_n, *Y_n;
+
+}safMatConv_scratch;
+
 /**
  * Data structure for the matrix convolver.
  */
@@ -39,14 +460,87 @@ typedef struct _safMatConv_data {
     int length_h, nCHin, nCHout;
     int numFilterBlocks, numOvrlpAddBlocks;
     int usePartFLAG;
-    void* hFFT;
-    float* x_pad, *y_pad, *hx_n, *z_n, *ovrlpAddBuffer, *y_n_overlap;
-    float_complex* H_f, *X_n, *HX_n;
+    int fdlHead;
+    float* x_pad, *y_pad, *ovrlpAddBuffer, *y_n_overlap;
+    float_complex* H_f, *X_n;
     float_complex** Hpart_f;
+    void* hNUPC;
+    void* hThreadPool;
+    int nThreads;
+    safMatConv_scratch* w; /* nThreads x 1 */
+    float* outputSig;      /* output buffer of the current saf_matrixConv_apply() call */
     
 }safMatConv_data;
- 
-void  saf_matrixConv_create
+
+/**
+ * Applies the convolution for one output channel (task function for
+ * saf_threadPool_run()); the input spectra must have already been computed.
+ */
+static void saf_matrixConv_outputTask
+(
+    void* userData,
+    int no,
+    int workerIndex
+)
+{
+    safMatConv_data *h = (safMatConv_data*)(userData);
+    safMatConv_scratch* w = &(h->w[workerIndex]);
+    float* outputSig = h->outputSig;
+    int ni, nb;
+
+    /* apply non-partitioned convolution */
+    if(!h->usePartFLAG){
+        /* Multiply spectra together */
+        utility_cvvmul(&(h->H_f[no*(h->nCHin)*(h->nBins)]), h->X_n, (h->nCHin)*(h->nBins), w->HX_n);
+
+        /* ifft (all inputs at once) and sum */
+        saf_rfft_backward_batch(w->hFFT, w->HX_n, h->nBins, w->hx_n, h->fftSize, h->nCHin);
+        memset(w->z_n, 0, (h->fftSize) * sizeof(float));
+        for(ni=0; ni<h->nCHin; ni++)
+            cblas_saxpy(h->fftSize, 1.0f, &(w->hx_n[ni*(h->fftSize)]), 1, w->z_n, 1);
+
+        /* shuffle the over-lap add buffer */
+        memmove(&(h->ovrlpAddBuffer[no*(h->fftSize)]), &(h->ovrlpAddBuffer[no*(h->fftSize)+(h->hopSize)]), (h->numOvrlpAddBlocks-1)*(h->hopSize)*sizeof(float));
+        memset(&(h->ovrlpAddBuffer[no*(h->fftSize)+(h->numOvrlpAddBlocks-1)*(h->hopSize)]), 0, (h->hopSize)*sizeof(float));
+
+        /* sum with overlap-add buffer */
+        cblas_saxpy(h->fftSize, 1.0f, w->z_n, 1, &(h->ovrlpAddBuffer[no*(h->fftSize)]), 1);
+
+        /* truncate buffer and output */
+        cblas_scopy(h->hopSize, &(h->ovrlpAddBuffer[no*(h->fftSize)]), 1, &(outputSig[no*(h->hopSize)]), 1);
+    }
+    /* apply partitioned convolution */
+    else if(h->usePartFLAG==SAF_CONV_PARTITIONED){
+        /* apply convolution and inverse fft */
+        cvvmul_fdl(h->Hpart_f[no], h->X_n, h->fdlHead, h->numFilterBlocks, (h->nCHin) * (h->nBins), w->HX_n); /* This is the bulk of the CPU work */
+        saf_rfft_backward_batch(w->hFFT, w->HX_n, h->nBins, w->hx_n, h->fftSize, h->numFilterBlocks*(h->nCHin));
+
+        /* output frame for this channel is the sum over all partitions and input channels */
+        memset(w->z_n, 0, (h->fftSize) * sizeof(float));
+        for(nb=0; nb<h->numFilterBlocks*(h->nCHin); nb++)
+            cblas_saxpy(h->fftSize, 1.0f, &(w->hx_n[nb*(h->fftSize)]), 1, w->z_n, 1);
+
+        /* sum with overlap buffer and copy the result to the output buffer */
+        utility_svvadd(w->z_n, (const float*)&(h->y_n_overlap[no*(h->hopSize)]), h->hopSize, &(outputSig[no*(h->hopSize)]));
+
+        /* for next iteration: */
+        cblas_scopy(h->hopSize, &(w->z_n[h->hopSize]), 1, &(h->y_n_overlap[no*(h->hopSize)]), 1);
+    }
+    /* apply uniformly-partitioned overlap-save convolution */
+    else{
+        /* apply convolution, accumulating over all partitions and inputs in the frequency domain */
+        cvvmul_fdl(h->Hpart_f[no], h->X_n, h->fdlHead, h->numFilterBlocks, (h->nCHin) * (h->nBins), w->HX_n); /* This is the bulk of the CPU work */
+        cblas_ccopy(h->nBins, w->HX_n, 1, w->Y_n, 1);
+        for(nb=1; nb<h->numFilterBlocks*(h->nCHin); nb++)
+            cblas_saxpy(2*(h->nBins), 1.0f, (const float*)&(w->HX_n[nb*(h->nBins)]), 1, (float*)w->Y_n, 1);
+
+        /* one inverse fft per output; the last hop of the result is free of circular aliasing */
+        saf_rfft_backward(w->hFFT, w->Y_n, w->z_n);
+        cblas_scopy(h->hopSize, &(w->z_n[h->hopSize]), 1, &(outputSig[no*(h->hopSize)]), 1);
+    }
+}
+
+void saf_matrixConv_create
 (
     void ** const phMC,
     int hopSize,
@@ -56,40 +550,73 @@ void  saf_matrixConv_create
     int nCHout,
     int usePartFLAG
 )
+{
+    saf_matrixConv_createThreaded(phMC, hopSize, H, length_h, nCHin, nCHout, usePartFLAG, NULL);
+}
+
+void saf_matrixConv_createThreaded
+(
+    void ** const phMC,
+    int hopSize,
+    float* H,         /* nCHout x nCHin x length_h */
+    int length_h,
+    int nCHin,
+    int nCHout,
+    int usePartFLAG,
+    void* hThreadPool
+)
 {
     *phMC = malloc1d(sizeof(safMatConv_data));
     safMatConv_data *h = (safMatConv_data*)(*phMC);
-    int no, ni, nb;
+    int no, ni, nb, t;
     float* h_pad, *h_pad_2hops;
     
+    saf_assert(usePartFLAG>=SAF_CONV_NONPARTITIONED && usePartFLAG<=SAF_CONV_PARTITIONED_NONUNIFORM, "Unsupported convolution mode");
     h->hopSize = hopSize;
     h->length_h = length_h;
     h->nCHin = nCHin;
     h->nCHout = nCHout;
     h->usePartFLAG = usePartFLAG;
+    h->fdlHead = 0;
+    h->hNUPC = NULL;
+    h->hThreadPool = hThreadPool;
+    h->nThreads = saf_threadPool_getNumThreads(hThreadPool);
+    h->w = NULL;
+    h->outputSig = NULL;
     
-    if(!h->usePartFLAG){
+    if(h->usePartFLAG==SAF_CONV_PARTITIONED_NONUNIFORM){
+        /* intialise non-uniformly partitioned convolution mode */
+        saf_nupc_create(&(h->hNUPC), hopSize, H, length_h, nCHin, nCHout, 0, 0, hThreadPool);
+    }
+    else if(!h->usePartFLAG){
         /* intialise non-partitioned convolution mode */
         h->numOvrlpAddBlocks = (int)(ceilf((float)(hopSize+length_h-1)/(float)hopSize)+0.1f);
         //h->numOvrlpAddBlocks = nextpow2((int)(ceilf((float)(hopSize+length_h-1)/(float)hopSize)+0.1f));
         h->fftSize = (h->numOvrlpAddBlocks)*hopSize;
         h->nBins = h->fftSize/2 + 1;
         
-        /* Allocate memory for buffers and perform fft on H */
+        /* Allocate memory for buffers (incl. per-thread scratch) and perform fft on H */
         h->ovrlpAddBuffer = calloc1d(nCHout*(h->fftSize), sizeof(float));
         h->x_pad = calloc1d((h->nCHin)*(h->fftSize), sizeof(float)); // CALLOC
         h->y_pad = malloc1d((h->nCHout)*(h->fftSize)*sizeof(float));
-        h->hx_n = malloc1d((h->fftSize) * sizeof(float));
         h->H_f = malloc1d((h->nCHout)*(h->nCHin)*(h->nBins)*sizeof(float_complex));
-        h->X_n = malloc1d((h->nCHout)*(h->nCHin)*(h->nBins)*sizeof(float_complex));
-        h->HX_n = malloc1d((h->nCHout)*(h->nCHin)*(h->nBins)*sizeof(float_complex));
-        h->z_n = malloc1d((h->fftSize) * sizeof(float));
-        saf_rfft_create(&(h->hFFT), h->fftSize);
+        h->X_n = malloc1d((h->nCHin)*(h->nBins)*sizeof(float_complex));
+        h->w = malloc1d(h->nThreads*sizeof(safMatConv_scratch));
+        for(t=0; t<h->nThreads; t++){
+            saf_rfft_create(&(h->w[t].hFFT), h->fftSize);
+            h->w[t].hx_n = malloc1d((h->nCHin)*(h->fftSize)*sizeof(float));
+            h->w[t].z_n = malloc1d((h->fftSize) * sizeof(float));
+            h->w[t].HX_n = calloc1d((h->nCHin)*(h->nBins), sizeof(float_complex));
+            h->w[t].Y_n = NULL;
+
+            /* Batched plans; the inputs are transformed by the calling thread, and the outputs by the worker threads */
+            saf_rfft_planBatch(h->w[t].hFFT, h->fftSize, h->nBins, t==0 ? nCHin : 0, nCHin);
+        }
         h_pad = calloc1d(h->fftSize, sizeof(float));
         for(no=0; no<nCHout; no++){
             for(ni=0; ni<nCHin; ni++){
                 memcpy(h_pad, &(H[no*nCHin*length_h+ni*length_h]), length_h*sizeof(float));
-                saf_rfft_forward(h->hFFT, h_pad, &(h->H_f[no*nCHin*(h->nBins)+ni*(h->nBins)]));
+                saf_rfft_forward(h->w[0].hFFT, h_pad, &(h->H_f[no*nCHin*(h->nBins)+ni*(h->nBins)]));
             }
         }
         free(h_pad);
@@ -102,24 +629,46 @@ void  saf_matrixConv_create
         h->numFilterBlocks = (int)ceilf((float)length_h/(float)hopSize); /* number of partitions */
         saf_assert(h->numFilterBlocks>=1, "Number of filter blocks/partitions must be at least 1");
         
-        /* Allocate memory for buffers and perform fft on partitioned H */
+        /* Allocate memory for buffers (incl. per-thread scratch) and perform fft on partitioned H */
         h_pad = calloc1d(h->numFilterBlocks * hopSize, sizeof(float));
         h_pad_2hops = calloc1d(2 * hopSize, sizeof(float));
         h->Hpart_f = malloc1d(nCHout*sizeof(float_complex*));
         h->X_n = calloc1d(h->numFilterBlocks * nCHin * (h->nBins), sizeof(float_complex));
-        h->HX_n = malloc1d(h->numFilterBlocks * nCHin * (h->nBins) * sizeof(float_complex));
-        h->x_pad = calloc1d(2 * hopSize, sizeof(float));
-        h->hx_n = malloc1d(h->numFilterBlocks*nCHin*(h->fftSize)*sizeof(float));
-        h->y_n_overlap = calloc1d(nCHout*hopSize, sizeof(float));
-        h->z_n = malloc1d((h->fftSize) * sizeof(float));
-        saf_rfft_create(&(h->hFFT), h->fftSize);
+        h->w = malloc1d(h->nThreads*sizeof(safMatConv_scratch));
+        for(t=0; t<h->nThreads; t++){
+            saf_rfft_create(&(h->w[t].hFFT), h->fftSize);
+            h->w[t].HX_n = malloc1d(h->numFilterBlocks * nCHin * (h->nBins) * sizeof(float_complex));
+            h->w[t].z_n = malloc1d((h->fftSize) * sizeof(float));
+            if(h->usePartFLAG==SAF_CONV_PARTITIONED){
+                h->w[t].hx_n = malloc1d(h->numFilterBlocks*nCHin*(h->fftSize)*sizeof(float));
+                h->w[t].Y_n = NULL;
+            }
+            else{
+                h->w[t].hx_n = NULL;
+                h->w[t].Y_n = malloc1d((h->nBins) * sizeof(float_complex));
+            }
+
+            /* Batched plans; the inputs are transformed by the calling thread, and the outputs by the worker threads */
+            saf_rfft_planBatch(h->w[t].hFFT, h->fftSize, h->nBins, t==0 ? nCHin : 0,
+                               h->usePartFLAG==SAF_CONV_PARTITIONED ? h->numFilterBlocks*nCHin : 0);
+        }
+        if(h->usePartFLAG==SAF_CONV_PARTITIONED){
+            /* each input is zero-padded to 2 hops */
+            h->x_pad = calloc1d(nCHin * 2 * hopSize, sizeof(float));
+            h->y_n_overlap = calloc1d(nCHout*hopSize, sizeof(float));
+        }
+        else{
+            /* overlap-save: each input keeps [previous hop, current hop] */
+            h->x_pad = calloc1d(nCHin * 2 * hopSize, sizeof(float));
+            h->y_n_overlap = NULL;
+        }
         for(no=0; no<nCHout; no++){
             h->Hpart_f[no] = malloc1d(h->numFilterBlocks*nCHin*(h->nBins)*sizeof(float_complex));
             for(ni=0; ni<nCHin; ni++){
                 memcpy(h_pad, &H[no*nCHin*length_h+ni*length_h], length_h*sizeof(float)); /* zero pad filter, to be multiple of hopsize */
                 for (nb=0; nb<h->numFilterBlocks; nb++){
                     memcpy(h_pad_2hops, &(h_pad[nb*hopSize]), hopSize*sizeof(float));
-                    saf_rfft_forward(h->hFFT, h_pad_2hops, &(h->Hpart_f[no][nb*nCHin*(h->nBins)+ni*(h->nBins)]));
+                    saf_rfft_forward(h->w[0].hFFT, h_pad_2hops, &(h->Hpart_f[no][nb*nCHin*(h->nBins)+ni*(h->nBins)]));
                 }
             }
         }
@@ -135,15 +684,24 @@ void saf_matrixConv_destroy
 )
 {
     safMatConv_data *h = (safMatConv_data*)(*phMC);
-    int no;
+    int no, t;
     
-    if(h!=NULL){
-        saf_rfft_destroy(&(h->hFFT));
+    if(h!=NULL && h->usePartFLAG==SAF_CONV_PARTITIONED_NONUNIFORM){
+        saf_nupc_destroy(&(h->hNUPC));
+        free(h);
+        h=NULL;
+    }
+    else if(h!=NULL){
+        for(t=0; t<h->nThreads; t++){
+            saf_rfft_destroy(&(h->w[t].hFFT));
+            free(h->w[t].hx_n);
+            free(h->w[t].z_n);
+            free(h->w[t].HX_n);
+            free(h->w[t].Y_n);
+        }
+        free(h->w);
         free(h->X_n);
         free(h->x_pad);
-        free(h->z_n);
-        free(h->hx_n);
-        free(h->HX_n);
         if(!h->usePartFLAG){
             free(h->ovrlpAddBuffer);
             free(h->y_pad);
@@ -168,71 +726,44 @@ void saf_matrixConv_apply
 )
 {
     safMatConv_data *h = (safMatConv_data*)(hMC);
-    int ni, no, nb;
+    int ni;
     
-    /* apply non-partitioned convolution */
+    /* apply non-uniformly partitioned convolution */
+    if(h->usePartFLAG==SAF_CONV_PARTITIONED_NONUNIFORM){
+        saf_nupc_apply(h->hNUPC, inputSig, outputSig);
+        return;
+    }
+
+    /* non-partitioned convolution */
     if(!h->usePartFLAG){
-        /* zero-pad input signals and perform fft */
-        for(ni=0; ni<h->nCHin; ni++){
+        /* zero-pad input signals and perform fft (all inputs at once) */
+        for(ni=0; ni<h->nCHin; ni++)
             cblas_scopy(h->hopSize, &inputSig[ni*(h->hopSize)], 1, &(h->x_pad[ni*(h->fftSize)]), 1);
-            saf_rfft_forward(h->hFFT, &(h->x_pad[ni*(h->fftSize)]), &(h->X_n[ni*(h->nBins)]));
-        }
-
-        /* Replicate for all outputs */
-        for(no=1; no<h->nCHout; no++)
-            cblas_ccopy(h->nCHin*(h->nBins), h->X_n, 1, &(h->X_n[no*ni*(h->nBins)]), 1);
-
-        /* Multiply spectra together */
-        utility_cvvmul(h->H_f, h->X_n, (h->nCHout)*(h->nCHin)*h->nBins, h->HX_n);
-
-        /* Loop over outputs */
-        for(no=0; no<h->nCHout; no++){
-            /* ifft and sum */
-            memset(h->z_n, 0, (h->fftSize) * sizeof(float));
-            for(ni=0; ni<h->nCHin; ni++){
-                saf_rfft_backward(h->hFFT, &(h->HX_n[no*(h->nCHin)*(h->nBins)+ni*(h->nBins)]), h->hx_n);
-                cblas_saxpy(h->fftSize, 1.0f, h->hx_n, 1, h->z_n, 1);
-            }
-
-            /* shuffle the over-lap add buffer */
-            memmove(&(h->ovrlpAddBuffer[no*(h->fftSize)]), &(h->ovrlpAddBuffer[no*(h->fftSize)+(h->hopSize)]), (h->numOvrlpAddBlocks-1)*(h->hopSize)*sizeof(float));
-            memset(&(h->ovrlpAddBuffer[no*(h->fftSize)+(h->numOvrlpAddBlocks-1)*(h->hopSize)]), 0, (h->hopSize)*sizeof(float));
-
-            /* sum with overlap-add buffer */
-            cblas_saxpy(h->fftSize, 1.0f, h->z_n, 1, &(h->ovrlpAddBuffer[no*(h->fftSize)]), 1);
-
-            /* truncate buffer and output */
-            cblas_scopy(h->hopSize, &(h->ovrlpAddBuffer[no*(h->fftSize)]), 1, &(outputSig[no*(h->hopSize)]), 1); 
-        }
+        saf_rfft_forward_batch(h->w[0].hFFT, h->x_pad, h->fftSize, h->X_n, h->nBins, h->nCHin);
     }
-    /* apply partitioned convolution */
+    /* partitioned convolution */
+    else if(h->usePartFLAG==SAF_CONV_PARTITIONED){
+        /* zero-pad input signals and perform fft (all inputs at once). Store in the (new) head slot of the FDL. */
+        h->fdlHead = (h->fdlHead + h->numFilterBlocks - 1) % h->numFilterBlocks;
+        for(ni=0; ni<h->nCHin; ni++)
+            cblas_scopy(h->hopSize, &(inputSig[ni*(h->hopSize)]), 1, &(h->x_pad[ni*(h->fftSize)]), 1);
+        saf_rfft_forward_batch(h->w[0].hFFT, h->x_pad, h->fftSize, &(h->X_n[(h->fdlHead)*(h->nCHin)*(h->nBins)]), h->nBins, h->nCHin);
+    }
+    /* uniformly-partitioned overlap-save convolution */
     else{
-        /* zero-pad input signals and perform fft. Store in partition slot 1. */
-        memmove(&(h->X_n[1*(h->nCHin)*(h->nBins)]), h->X_n, (h->numFilterBlocks-1)*(h->nCHin)*(h->nBins)*sizeof(float_complex)); /* shuffle */
-        for(ni=0; ni<h->nCHin; ni++){ 
-            cblas_scopy(h->hopSize, &(inputSig[ni*(h->hopSize)]), 1, h->x_pad, 1);
-            saf_rfft_forward(h->hFFT, h->x_pad, &(h->X_n[0*(h->nCHin)*(h->nBins)+ni*(h->nBins)]));
-        }
-        
-        /* apply convolution and inverse fft */
-        for(no=0; no<h->nCHout; no++){
-            utility_cvvmul(h->Hpart_f[no], h->X_n, h->numFilterBlocks * (h->nCHin) * (h->nBins), h->HX_n); /* This is the bulk of the CPU work */
-            for(nb=0; nb<h->numFilterBlocks; nb++)
-                for(ni=0; ni<h->nCHin; ni++)
-                    saf_rfft_backward(h->hFFT, &(h->HX_n[nb*(h->nCHin)*(h->nBins)+ni*(h->nBins)]), &(h->hx_n[nb*(h->nCHin)*(h->fftSize)+ni*(h->fftSize)]));
-            
-            /* output frame for this channel is the sum over all partitions and input channels */
-            memset(h->z_n, 0, (h->fftSize) * sizeof(float));
-            for(nb=0; nb<h->numFilterBlocks*(h->nCHin); nb++)
-                cblas_saxpy(h->fftSize, 1.0f, &(h->hx_n[nb*(h->fftSize)]), 1, h->z_n, 1);
-
-            /* sum with overlap buffer and copy the result to the output buffer */
-            utility_svvadd(h->z_n, (const float*)&(h->y_n_overlap[no*(h->hopSize)]), h->hopSize, &(outputSig[no*(h->hopSize)]));
-
-            /* for next iteration: */
-            cblas_scopy(h->hopSize, &(h->z_n[h->hopSize]), 1, &(h->y_n_overlap[no*(h->hopSize)]), 1);
+        /* slide the input buffers by one hop, and perform fft (all inputs at once). Store in the (new) head slot of the FDL. */
+        h->fdlHead = (h->fdlHead + h->numFilterBlocks - 1) % h->numFilterBlocks;
+        for(ni=0; ni<h->nCHin; ni++){
+            cblas_scopy(h->hopSize, &(h->x_pad[ni*(h->fftSize)+(h->hopSize)]), 1, &(h->x_pad[ni*(h->fftSize)]), 1);
+            cblas_scopy(h->hopSize, &(inputSig[ni*(h->hopSize)]), 1, &(h->x_pad[ni*(h->fftSize)+(h->hopSize)]), 1);
         }
+        saf_rfft_forward_batch(h->w[0].hFFT, h->x_pad, h->fftSize, &(h->X_n[(h->fdlHead)*(h->nCHin)*(h->nBins)]), h->nBins, h->nCHin);
     }
+
+    /* apply convolution and inverse fft (spread over the threads, one output channel per task) */
+    h->outputSig = outputSig;
+    saf_threadPool_run(h->hThreadPool, saf_matrixConv_outputTask, (void*)h, h->nCHout);
+    h->outputSig = NULL;
 }
 
 
@@ -248,9 +779,11 @@ typedef struct _safMulConv_data {
     int length_h, nCH;
     int numOvrlpAddBlocks, numFilterBlocks;
     int usePartFLAG;
+    int fdlHead;
     void* hFFT;
     float* x_pad, *z_n, *ovrlpAddBuffer, *hx_n, *y_n_overlap;
     float_complex* X_n, *HX_n, *Z_n, *H_f, *Hpart_f;
+    void* hNUPC;
     
 }safMulConv_data;
 
@@ -271,10 +804,17 @@ void saf_multiConv_create
     
     h->hopSize = hopSize;
     h->length_h = length_h;
+    saf_assert(usePartFLAG>=SAF_CONV_NONPARTITIONED && usePartFLAG<=SAF_CONV_PARTITIONED_NONUNIFORM, "Unsupported convolution mode");
     h->nCH = nCH;
     h->usePartFLAG = usePartFLAG; 
+    h->fdlHead = 0;
+    h->hNUPC = NULL;
     
-    if(!h->usePartFLAG){
+    if(h->usePartFLAG==SAF_CONV_PARTITIONED_OLS || h->usePartFLAG==SAF_CONV_PARTITIONED_NONUNIFORM){
+        /* intialise uniformly (overlap-save) or non-uniformly partitioned convolution mode */
+        saf_nupc_create(&(h->hNUPC), hopSize, H, length_h, nCH, nCH, 1, h->usePartFLAG==SAF_CONV_PARTITIONED_OLS, NULL);
+    }
+    else if(!h->usePartFLAG){
         /* intialise non-partitioned convolution mode */
         h->numOvrlpAddBlocks = (int)(ceilf((float)(hopSize+length_h-1)/(float)hopSize)+0.1f);
         h->fftSize = (h->numOvrlpAddBlocks*hopSize);
@@ -286,9 +826,10 @@ void saf_multiConv_create
         h->H_f = malloc1d(nCH*(h->nBins)*sizeof(float_complex));
         h->X_n = calloc1d(nCH * (h->nBins), sizeof(float_complex));
         h->Z_n = malloc1d(nCH * (h->nBins) * sizeof(float_complex));
-        h->x_pad = calloc1d(h->fftSize, sizeof(float));
+        h->x_pad = calloc1d(nCH*(h->fftSize), sizeof(float));
         h->z_n = malloc1d(nCH*(h->fftSize)*sizeof(float));
         saf_rfft_create(&(h->hFFT), h->fftSize);
+        saf_rfft_planBatch(h->hFFT, h->fftSize, h->nBins, nCH, nCH);
         for(nc=0; nc<nCH; nc++){
             memcpy(h_pad, &H[nc*length_h], length_h*sizeof(float)); /* zero pad filter, to be multiple of hopsize */
             saf_rfft_forward(h->hFFT, h_pad, &(h->H_f[nc*(h->nBins)]));
@@ -309,11 +850,12 @@ void saf_multiConv_create
         h->Hpart_f = malloc1d(h->numFilterBlocks*nCH*(h->nBins)*sizeof(float_complex));
         h->X_n = calloc1d(h->numFilterBlocks * nCH * (h->nBins), sizeof(float_complex));
         h->HX_n = calloc1d(h->numFilterBlocks * nCH * (h->nBins), sizeof(float_complex));
-        h->x_pad = calloc1d(2 * hopSize, sizeof(float));
+        h->x_pad = calloc1d(nCH * 2 * hopSize, sizeof(float));
         h->hx_n = malloc1d(h->numFilterBlocks*nCH*(h->fftSize)*sizeof(float));
         h->z_n = calloc1d(h->fftSize, sizeof(float));
         h->y_n_overlap = calloc1d(nCH*hopSize, sizeof(float));
         saf_rfft_create(&(h->hFFT), h->fftSize);
+        saf_rfft_planBatch(h->hFFT, h->fftSize, h->nBins, nCH, h->numFilterBlocks*nCH);
         for(nc=0; nc<nCH; nc++){
             memcpy(h_pad, &H[nc*length_h], length_h*sizeof(float)); /* zero pad filter, to be multiple of hopsize */
             for (nb=0; nb<h->numFilterBlocks; nb++){
@@ -334,7 +876,12 @@ void saf_multiConv_destroy
 {
     safMulConv_data *h = (safMulConv_data*)(*phMC);
     
-    if(h!=NULL){
+    if(h!=NULL && h->hNUPC!=NULL){
+        saf_nupc_destroy(&(h->hNUPC));
+        free(h);
+        h=NULL;
+    }
+    else if(h!=NULL){
         saf_rfft_destroy(&(h->hFFT));
         free(h->X_n);
         free(h->x_pad);
@@ -364,19 +911,23 @@ void saf_multiConv_apply
     safMulConv_data *h = (safMulConv_data*)(hMC);
     int nc, nb;
     
+    /* apply uniformly (overlap-save) or non-uniformly partitioned convolution */
+    if(h->hNUPC!=NULL){
+        saf_nupc_apply(h->hNUPC, inputSig, outputSig);
+        return;
+    }
+
     /* apply non-partitioned convolution */
     if(!h->usePartFLAG){
-        /* zero-pad input signals and perform fft. */
-        for(nc=0; nc<h->nCH; nc++){
-            memcpy(h->x_pad, &(inputSig[nc*(h->hopSize)]), h->hopSize *sizeof(float));
-            saf_rfft_forward(h->hFFT, h->x_pad, &(h->X_n[nc*(h->nBins)]));
-        }
+        /* zero-pad input signals and perform fft (all channels at once). */
+        for(nc=0; nc<h->nCH; nc++)
+            memcpy(&(h->x_pad[nc*(h->fftSize)]), &(inputSig[nc*(h->hopSize)]), h->hopSize *sizeof(float));
+        saf_rfft_forward_batch(h->hFFT, h->x_pad, h->fftSize, h->X_n, h->nBins, h->nCH);
         
         /* apply convolution and inverse fft */
         utility_cvvmul(h->H_f, h->X_n, (h->nCH) * (h->nBins), h->Z_n); /* This is the bulk of the CPU work */
+        saf_rfft_backward_batch(h->hFFT, h->Z_n, h->nBins, h->z_n, h->fftSize, h->nCH);
         for(nc=0; nc<h->nCH; nc++){
-            saf_rfft_backward(h->hFFT, &(h->Z_n[nc*(h->nBins)]), &(h->z_n[nc*(h->fftSize)]));
-            
             /* sum with overlap buffer and copy the result to the output buffer */
             utility_svvcopy(&(h->ovrlpAddBuffer[nc*(h->fftSize)+(h->hopSize)]), (h->numOvrlpAddBlocks-1)*(h->hopSize), &(h->ovrlpAddBuffer[nc*(h->fftSize)]));
             memset(&(h->ovrlpAddBuffer[nc*(h->fftSize)+(h->numOvrlpAddBlocks-1)*(h->hopSize)]), 0, (h->hopSize)*sizeof(float));
@@ -386,19 +937,16 @@ void saf_multiConv_apply
     }
     /* apply partitioned convolution */
     else{
-        /* zero-pad input signals and perform fft. Store in partition slot 1. */
-        memcpy(&(h->X_n[1*(h->nCH)*(h->nBins)]), h->X_n, (h->numFilterBlocks-1)*(h->nCH)*(h->nBins)*sizeof(float_complex));
-        for(nc=0; nc<h->nCH; nc++){
-            memcpy(h->x_pad, &(inputSig[nc*(h->hopSize)]), h->hopSize * sizeof(float));
-            saf_rfft_forward(h->hFFT, h->x_pad, &(h->X_n[0*(h->nCH)*(h->nBins)+nc*(h->nBins)]));
-        }
+        /* zero-pad input signals and perform fft (all channels at once). Store in the (new) head slot of the FDL. */
+        h->fdlHead = (h->fdlHead + h->numFilterBlocks - 1) % h->numFilterBlocks;
+        for(nc=0; nc<h->nCH; nc++)
+            memcpy(&(h->x_pad[nc*(h->fftSize)]), &(inputSig[nc*(h->hopSize)]), h->hopSize * sizeof(float));
+        saf_rfft_forward_batch(h->hFFT, h->x_pad, h->fftSize, &(h->X_n[(h->fdlHead)*(h->nCH)*(h->nBins)]), h->nBins, h->nCH);
         
-        /* apply convolution and inverse fft */
-        utility_cvvmul(h->Hpart_f, h->X_n, h->numFilterBlocks * (h->nCH) * (h->nBins), h->HX_n); /* This is the bulk of the CPU work */
+        /* apply convolution and inverse fft (all partitions and channels at once) */
+        cvvmul_fdl(h->Hpart_f, h->X_n, h->fdlHead, h->numFilterBlocks, (h->nCH) * (h->nBins), h->HX_n); /* This is the bulk of the CPU work */
+        saf_rfft_backward_batch(h->hFFT, h->HX_n, h->nBins, h->hx_n, h->fftSize, h->numFilterBlocks*(h->nCH));
         for(nc=0; nc<h->nCH; nc++){
-            for(nb=0; nb<h->numFilterBlocks; nb++)
-                saf_rfft_backward(h->hFFT, &(h->HX_n[nb*(h->nCH)*(h->nBins)+nc*(h->nBins)]), &(h->hx_n[nb*(h->nCH)*(h->fftSize)+nc*(h->fftSize)]));
-            
             /* output frame for this channel is the sum over all partitions */
             memset(h->z_n, 0, h->fftSize*sizeof(float));
             for(nb=0; nb<h->numFilterBlocks; nb++)
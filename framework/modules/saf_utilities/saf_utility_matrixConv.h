@@ -32,6 +32,43 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/* ========================================================================== */
+/*                                    Enums                                   */
+/* ========================================================================== */
+
+/**
+ * Convolution modes supported by saf_matrixConv and saf_multiConv (passed as
+ * the 'usePartFLAG' argument to saf_matrixConv_create()/saf_multiConv_create())
+ *
+ * The non-uniformly partitioned mode employs partitions equal to the hop size
+ * for the head of the filters (i.e., no latency is introduced beyond the hop
+ * size), and partitions that double in size for the tail of the filters, in
+ * a manner similar to [1]. This drastically reduces the number of partitions
+ * required for long filters and small hop sizes. A larger partition only
+ * receives a new block of input once every (partition size/hop size) hops,
+ * but its output is not required until as many hops later; the work for each
+ * block is therefore spread evenly over these hops, so that the CPU load
+ * remains roughly constant over hops.
+ *
+ * @see [1] Gardner, W.G., 1995. Efficient convolution without input-output
+ *          delay. Journal of the Audio Engineering Society, 43(3), 127-136.
+ */
+typedef enum {
+    SAF_CONV_NONPARTITIONED = 0,    /**< Normal fft-based convolution (fft over
+                                     *   the length of the filters) */
+    SAF_CONV_PARTITIONED,           /**< fft-based uniformly-partitioned
+                                     *   convolution (inverse fft per
+                                     *   partition, summed in the time
+                                     *   domain) */
+    SAF_CONV_PARTITIONED_OLS,       /**< fft-based uniformly-partitioned
+                                     *   overlap-save convolution, with
+                                     *   frequency-domain accumulation */
+    SAF_CONV_PARTITIONED_NONUNIFORM /**< fft-based non-uniformly-partitioned
+                                     *   overlap-save convolution, with
+                                     *   frequency-domain accumulation */
+}SAF_CONV_MODES;
+
+
 /* ========================================================================== */
 /*                              Matrix Convolver                              */
 /* ========================================================================== */
@@ -41,7 +78,17 @@ extern "C" {
  *
  * This is a matrix convolver intended for block-by-block processing.
  *
+ * @note The partitioned overlap-save modes (SAF_CONV_PARTITIONED_OLS and
+ *       SAF_CONV_PARTITIONED_NONUNIFORM) multiply
+ *       and accumulate over all partitions and input channels in the
+ *       frequency domain, and therefore require only one inverse FFT per
+ *       output channel per hop (and partition size); rather than one per
+ *       partition and input channel, as is the case for SAF_CONV_PARTITIONED.
+ *       The output of all modes is equivalent, up to floating-point round-off
+ *       error.
+ *
  * @test test__saf_matrixConv()
+ * @test test__saf_matrixConv_partitioned()
  *
  * @param[in] phMC        (&) address of matrixConv handle
  * @param[in] hopSize     Hop size in samples.
@@ -49,8 +96,11 @@ extern "C" {
  * @param[in] length_h    Length of the filters
  * @param[in] nCHin       Number of input channels
  * @param[in] nCHout      Number of output channels
- * @param[in] usePartFLAG '0': normal fft-based convolution, '1': fft-based
- *                        partitioned convolution
+ * @param[in] usePartFLAG Convolution mode, see #SAF_CONV_MODES ('0': normal
+ *                        fft-based convolution, '1': fft-based partitioned
+ *                        convolution, '2': fft-based uniformly-partitioned
+ *                        overlap-save convolution, '3': fft-based
+ *                        non-uniformly partitioned convolution)
  */
 void saf_matrixConv_create(/* Input Arguments */
                            void ** const phMC,
@@ -61,6 +111,44 @@ void saf_matrixConv_create(/* Input Arguments */
                            int nCHout,
                            int usePartFLAG);
 
+/**
+ * Creates an instance of matrixConv, which spreads the output channels over
+ * the threads of a thread pool (see saf_threadPool_create())
+ *
+ * The input spectra are computed on the calling thread of
+ * saf_matrixConv_apply(), after which the convolution and inverse FFT(s) of
+ * each output channel are executed as separate tasks. Each thread employs its
+ * own scratch memory, and the output channels are statically assigned to the
+ * threads; therefore, the output is identical to that of a matrixConv instance
+ * created using saf_matrixConv_create(), and no memory is allocated in
+ * saf_matrixConv_apply().
+ *
+ * @note The thread pool may be shared by multiple matrixConv instances, but
+ *       these instances must then be applied from the same thread. The thread
+ *       pool must also outlive the matrixConv instance.
+ *
+ * @test test__saf_matrixConv_threaded()
+ *
+ * @param[in] phMC        (&) address of matrixConv handle
+ * @param[in] hopSize     Hop size in samples.
+ * @param[in] H           Time-domain filters; FLAT: nCHout x nCHin x length_h
+ * @param[in] length_h    Length of the filters
+ * @param[in] nCHin       Number of input channels
+ * @param[in] nCHout      Number of output channels
+ * @param[in] usePartFLAG Convolution mode, see #SAF_CONV_MODES
+ * @param[in] hThreadPool Thread pool handle (NULL: single-threaded, i.e. the
+ *                        same as saf_matrixConv_create())
+ */
+void saf_matrixConv_createThreaded(/* Input Arguments */
+                                   void ** const phMC,
+                                   int hopSize,
+                                   float* H,
+                                   int length_h,
+                                   int nCHin,
+                                   int nCHout,
+                                   int usePartFLAG,
+                                   void* hThreadPool);
+
 /**
  * Destroys an instance of matrixConv
  *
@@ -98,13 +186,18 @@ void saf_matrixConv_apply(/* Input Arguments */
  * @note nCH can just be 1, in which case this is simply a single-channel
  *       convolver.
  *
+ * @test test__saf_multiConv()
+ *
  * @param[in] phMC        (&) address of multiConv handle
  * @param[in] hopSize     Hop size in samples.
  * @param[in] H           Time-domain filters; FLAT: nCH x length_h
  * @param[in] length_h    Length of the filters
  * @param[in] nCH         Number of filters & input/output channels
- * @param[in] usePartFLAG '0': normal fft-based convolution, '1': fft-based
- *                        partitioned convolution
+ * @param[in] usePartFLAG Convolution mode, see #SAF_CONV_MODES ('0': normal
+ *                        fft-based convolution, '1': fft-based partitioned
+ *                        convolution, '2': fft-based uniformly-partitioned
+ *                        overlap-save convolution, '3': fft-based
+ *                        non-uniformly partitioned convolution)
  */
 void saf_multiConv_create(/* Input Arguments */
                           void ** const phMC,
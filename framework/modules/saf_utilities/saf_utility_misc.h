@@ -46,11 +46,11 @@ extern "C" {
 #  define _POSIX_C_SOURCE 199309L /* or greater */
 # endif
 # include <time.h>
-# define SAF_SLEEP(msecs) do {     \
-   struct timespec ts;             \
-   ts.tv_sec = msecs/1000;         \
-   ts.tv_nsec = msecs%1000*1000;   \
-   nanosleep(&ts, NULL);           \
+# define SAF_SLEEP(msecs) do {         \
+   struct timespec ts;                 \
+   ts.tv_sec = (msecs)/1000;           \
+   ts.tv_nsec = (msecs)%1000*1000000L; \
+   nanosleep(&ts, NULL);               \
 } while (0)
 #else
 # error "Unknown system"
@@ -25,73 +25,12 @@
  */
 
 #include "saf_utilities.h"
-
-/**
- * Enables the use of the saf_utility_fft wrapper, instead of "smbFft" used in
- * the original implementation */
-#define SMB_ENABLE_SAF_FFT
+#include <float.h>
 
 /* ========================================================================== */
 /*                              SMB PitchShifter                              */
 /* ========================================================================== */
 
-#ifndef SMB_ENABLE_SAF_FFT
-static void smbFft(float *fftBuffer, int fftFrameSize, long sign)
-/*
-    FFT routine, (C)1996 S.M.Bernsee. Sign = -1 is FFT, 1 is iFFT (inverse)
-    Fills fftBuffer[0...2*fftFrameSize-1] with the Fourier transform of the
-    time domain data in fftBuffer[0...2*fftFrameSize-1]. The FFT array takes
-    and returns the cosine and sine parts in an interleaved manner, ie.
-    fftBuffer[0] = cosPart[0], fftBuffer[1] = sinPart[0], asf. fftFrameSize
-    must be a power of 2. It expects a complex input signal (see footnote 2),
-    ie. when working with 'common' audio signals our input signal has to be
-    passed as {in[0],0.,in[1],0.,in[2],0.,...} asf. In that case, the transform
-    of the frequencies of interest is in fftBuffer[0...fftFrameSize].
-*/
-{
-    float wr, wi, arg, *p1, *p2, temp;
-    float tr, ti, ur, ui, *p1r, *p1i, *p2r, *p2i;
-    long i, bitm, j, le, le2, k;
-
-    for (i = 2; i < 2*fftFrameSize-2; i += 2) {
-        for (bitm = 2, j = 0; bitm < 2*fftFrameSize; bitm <<= 1) {
-            if (i & bitm) j++;
-            j <<= 1;
-        }
-        if (i < j) {
-            p1 = fftBuffer+i; p2 = fftBuffer+j;
-            temp = *p1; *(p1++) = *p2;
-            *(p2++) = temp; temp = *p1;
-            *p1 = *p2; *p2 = temp;
-        }
-    }
-    for (k = 0, le = 2; k < (int)(log(fftFrameSize)/log(2.)+.5); k++) {
-        le <<= 1;
-        le2 = le>>1;
-        ur = 1.0;
-        ui = 0.0;
-        arg = M_PI / (le2>>1);
-        wr = cos(arg);
-        wi = sign*sin(arg);
-        for (j = 0; j < le2; j += 2) {
-            p1r = fftBuffer+j; p1i = p1r+1;
-            p2r = p1r+le2; p2i = p2r+1;
-            for (i = j; i < 2*fftFrameSize; i += le) {
-                tr = *p2r * ur - *p2i * ui;
-                ti = *p2r * ui + *p2i * ur;
-                *p2r = *p1r - tr; *p2i = *p1i - ti;
-                *p1r += tr; *p1i += ti;
-                p1r += le; p1i += le;
-                p2r += le; p2i += le;
-            }
-            tr = ur*wr - ui*wi;
-            ui = ur*wi + ui*wr;
-            ur = tr;
-        }
-    }
-}
-#endif
-
 /**
  * Main structure for the SMB pitch shifter
  */
@@ -100,33 +39,215 @@ typedef struct _smb_pitchShift_data
     /* parameters */
     int fftFrameSize, osamp, nCH;
     float sampleRate, pitchShiftFactor;
+    int fastApprox;                    /**< 1: fast atan2f/cosf/sinf approximations, 0: libm */
 
     /* internals */
     void* hFFT;
     float* window;
     float** gInFIFO, **gOutFIFO;
-#ifdef SMB_ENABLE_SAF_FFT
-    float_complex** gFFTworksp_td;
-    float_complex** gFFTworksp_fd;
-#else
-    float** gFFTworksp;
-#endif
+    float** gFFTworksp_td;             /**< nCH x fftFrameSize */
+    float_complex** gFFTworksp_fd;     /**< nCH x (fftFrameSize/2+1) */
     float** gLastPhase, **gSumPhase;
     float** gOutputAccum;
     float** gAnaFreq, **gAnaMagn;
     float** gSynFreq, **gSynMagn;
-    int* gRover;
+    int gRover;                        /**< FIFO read/write position (the same for all channels) */
     int stepSize, inFifoLatency;
 
 }smb_pitchShift_data;
 
-void smb_pitchShift_create
+/**
+ * Rectangular to polar conversion (magnitude is scaled by 2), using a 9th order
+ * polynomial approximation of atan() on [0 1] (max error ~1.2e-5 rad), which
+ * is then mapped to the appropriate octant. Written branch-free, so that the
+ * loop may be auto-vectorised */
+static void smb_cart2polFast
+(
+    float_complex* X,
+    int len,
+    float* magn,
+    float* phase
+)
+{
+    int k;
+    float re, im, ax, ay, mx, mn, a, s, r;
+    float* x;
+
+    x = (float*)X;
+    for(k=0; k<len; k++){
+        re = x[2*k];
+        im = x[2*k+1];
+        ax = fabsf(re);
+        ay = fabsf(im);
+        mx = ax>ay ? ax : ay;
+        mn = ax>ay ? ay : ax;
+        a = mn/(mx+FLT_MIN);
+        s = a*a;
+        r = a*(0.9998660f + s*(-0.3302995f + s*(0.1801410f + s*(-0.0851330f + s*0.0208351f))));
+        r = ay>ax ? 1.57079637f-r : r;
+        r = re<0.0f ? 3.14159274f-r : r;
+        phase[k] = im<0.0f ? -r : r;
+        magn[k] = 2.0f*sqrtf(re*re + im*im);
+    }
+}
+
+/**
+ * Polar to rectangular conversion, using the minimax polynomials of Cephes'
+ * sinf/cosf on [-pi/4 pi/4] (max error ~1e-7) after reducing the phase to the
+ * nearest quadrant. Phases are expected to be within [-pi pi]. Written
+ * branch-free, so that the loop may be auto-vectorised */
+static void smb_pol2cartFast
+(
+    float* magn,
+    float* phase,
+    int len,
+    float_complex* X
+)
+{
+    int k, q;
+    float p, r, r2, c, s, cq, sq;
+    float* x;
+
+    x = (float*)X;
+    for(k=0; k<len; k++){
+        p = phase[k];
+        q = (int)(p*0.636619772f + (p>=0.0f ? 0.5f : -0.5f));
+        r = (p - (float)q*1.5703125f) - (float)q*4.83826794e-4f; /* (pi/2 split in two, for accuracy) */
+        r2 = r*r;
+        s = r + r*r2*(-1.6666654611e-1f + r2*(8.3321608736e-3f + r2*-1.9515295891e-4f));
+        c = 1.0f - 0.5f*r2 + r2*r2*(4.166664568298827e-2f + r2*(-1.388731625493765e-3f + r2*2.443315711809948e-5f));
+        cq = q&1 ? s : c;
+        sq = q&1 ? c : s;
+        cq = (q+1)&2 ? -cq : cq;
+        sq = q&2 ? -sq : sq;
+        x[2*k]   = magn[k]*cq;
+        x[2*k+1] = magn[k]*sq;
+    }
+}
+
+/** Processes one hop (analysis, pitch shifting, synthesis) for all channels */
+static void smb_pitchShift_processHop
+(
+    smb_pitchShift_data *h
+)
+{
+    float tmp, freqPerBin, expct;
+    float* x;
+    int ch, k, qpd, index, fftFrameSize2;
+
+    /* set up some handy variables */
+    fftFrameSize2 = h->fftFrameSize/2;
+    freqPerBin = h->sampleRate/(float)h->fftFrameSize;
+    expct = 2.0f*SAF_PI*(float)(h->stepSize)/(float)h->fftFrameSize;
+
+    /* do windowing and transform (all channels at once) */
+    for(ch=0; ch<h->nCH; ch++)
+        utility_svvmul(h->gInFIFO[ch], h->window, h->fftFrameSize, h->gFFTworksp_td[ch]);
+    saf_rfft_forward_batch(h->hFFT, FLATTEN2D(h->gFFTworksp_td), h->fftFrameSize, FLATTEN2D(h->gFFTworksp_fd), fftFrameSize2+1, h->nCH);
+
+    for(ch=0; ch<h->nCH; ch++){
+        /* ***************** ANALYSIS ******************* */
+        /* compute magnitude and phase (gAnaFreq is used to hold the phase) */
+        if(h->fastApprox)
+            smb_cart2polFast(h->gFFTworksp_fd[ch], fftFrameSize2+1, h->gAnaMagn[ch], h->gAnaFreq[ch]);
+        else{
+            x = (float*)h->gFFTworksp_fd[ch];
+            for (k = 0; k <= fftFrameSize2; k++) {
+                h->gAnaMagn[ch][k] = 2.0f*sqrtf(x[2*k]*x[2*k] + x[2*k+1]*x[2*k+1]);
+                h->gAnaFreq[ch][k] = atan2f(x[2*k+1], x[2*k]);
+            }
+        }
+        for (k = 0; k <= fftFrameSize2; k++) {
+            /* compute phase difference */
+            tmp = h->gAnaFreq[ch][k] - h->gLastPhase[ch][k];
+            h->gLastPhase[ch][k] = h->gAnaFreq[ch][k];
+
+            /* subtract expected phase difference */
+            tmp -= (float)k*expct;
+
+            /* map delta phase into +/- Pi interval */
+            qpd = (int)(tmp/SAF_PI);
+            qpd += qpd>=0 ? qpd&1 : -(qpd&1);
+            tmp -= SAF_PI*(float)qpd;
+
+            /* get deviation from bin frequency from the +/- Pi interval */
+            tmp = (float)h->osamp*tmp/(2.0f*SAF_PI);
+
+            /* compute the k-th partials' true frequency, and store it */
+            h->gAnaFreq[ch][k] = (float)k*freqPerBin + tmp*freqPerBin;
+        }
+
+        /* ***************** PROCESSING ******************* */
+        /* this does the actual pitch shifting */
+        memset(h->gSynMagn[ch], 0, h->fftFrameSize*sizeof(float));
+        memset(h->gSynFreq[ch], 0, h->fftFrameSize*sizeof(float));
+        for (k = 0; k <= fftFrameSize2; k++) {
+            index = (int)((float)k*(h->pitchShiftFactor));
+            if (index <= fftFrameSize2) {
+                h->gSynMagn[ch][index] += (h->gAnaMagn[ch][k]);
+                h->gSynFreq[ch][index] = h->gAnaFreq[ch][k] * (h->pitchShiftFactor);
+            }
+        }
+
+        /* ***************** SYNTHESIS ******************* */
+        for (k = 0; k <= fftFrameSize2; k++) {
+            /* subtract bin mid frequency, and get bin deviation from freq deviation */
+            tmp = (h->gSynFreq[ch][k] - (float)k*freqPerBin)/freqPerBin;
+
+            /* take osamp into account, and add the overlap phase advance back in */
+            tmp = 2.0f*SAF_PI*tmp/(float)(h->osamp) + (float)k*expct;
+
+            /* accumulate delta phase to get bin phase, and wrap it to +/- Pi
+             * (otherwise, float precision is gradually lost as it grows) */
+            tmp += h->gSumPhase[ch][k];
+            qpd = (int)(tmp*(0.5f/SAF_PI) + (tmp>=0.0f ? 0.5f : -0.5f));
+            h->gSumPhase[ch][k] = tmp - 2.0f*SAF_PI*(float)qpd;
+        }
+
+        /* get real and imag parts */
+        if(h->fastApprox)
+            smb_pol2cartFast(h->gSynMagn[ch], h->gSumPhase[ch], fftFrameSize2+1, h->gFFTworksp_fd[ch]);
+        else{
+            x = (float*)h->gFFTworksp_fd[ch];
+            for (k = 0; k <= fftFrameSize2; k++) {
+                x[2*k]   = h->gSynMagn[ch][k]*cosf(h->gSumPhase[ch][k]);
+                x[2*k+1] = h->gSynMagn[ch][k]*sinf(h->gSumPhase[ch][k]);
+            }
+        }
+
+        /* Only the real parts of DC and Nyquist contribute to a real signal;
+         * they are doubled, since the other bins are implicitly doubled by the
+         * Hermitian symmetry assumed by saf_rfft_backward() */
+        h->gFFTworksp_fd[ch][0] = cmplxf(2.0f*crealf(h->gFFTworksp_fd[ch][0]), 0.0f);
+        h->gFFTworksp_fd[ch][fftFrameSize2] = cmplxf(2.0f*crealf(h->gFFTworksp_fd[ch][fftFrameSize2]), 0.0f);
+    }
+
+    /* do inverse transform (all channels at once) */
+    saf_rfft_backward_batch(h->hFFT, FLATTEN2D(h->gFFTworksp_fd), fftFrameSize2+1, FLATTEN2D(h->gFFTworksp_td), h->fftFrameSize, h->nCH);
+
+    for(ch=0; ch<h->nCH; ch++){
+        /* do windowing and add to output accumulator */
+        for(k=0; k < h->fftFrameSize; k++)
+            h->gOutputAccum[ch][k] += (h->window[k])*(h->gFFTworksp_td[ch][k])/(float)(h->osamp);
+        memcpy(h->gOutFIFO[ch], h->gOutputAccum[ch], h->stepSize*sizeof(float));
+
+        /* shift accumulator */
+        memmove(h->gOutputAccum[ch], h->gOutputAccum[ch] + (h->stepSize), h->fftFrameSize*sizeof(float));
+
+        /* move input FIFO */
+        memmove(h->gInFIFO[ch], h->gInFIFO[ch] + (h->stepSize), h->inFifoLatency*sizeof(float));
+    }
+}
+
+/** Creates an instance of SMB PitchShifter (see smb_pitchShift_create()) */
+static void smb_pitchShift_createInternal
 (
     void** hSmb,
     int nCH,
     int fftFrameSize,
     int osamp,
-    float sampleRate
+    float sampleRate,
+    int fastApprox
 )
 {
     *hSmb = malloc(sizeof(smb_pitchShift_data));
@@ -138,25 +259,20 @@ void smb_pitchShift_create
     h->sampleRate = sampleRate;
     h->nCH = nCH;
     h->pitchShiftFactor = 1.0f;
+    h->fastApprox = fastApprox;
 
     /* internals */
-    saf_fft_create(&(h->hFFT), fftFrameSize);
+    saf_rfft_create(&(h->hFFT), fftFrameSize);
     h->stepSize = fftFrameSize/h->osamp;
     h->inFifoLatency = fftFrameSize - (h->stepSize);
-    h->gRover = (int*)malloc1d(nCH * sizeof(int));
-    for(i=0; i<nCH; i++)
-        h->gRover[i] = h->inFifoLatency;
+    h->gRover = h->inFifoLatency;
     h->window = (float*)malloc1d(fftFrameSize*sizeof(float));
     for (i = 0; i < fftFrameSize; i++)
         h->window[i] = -0.5f*cosf(2.0f*SAF_PI*(float)i/(float)fftFrameSize)+0.5f;
     h->gInFIFO = (float**)calloc2d(nCH,fftFrameSize,sizeof(float));
     h->gOutFIFO = (float**)calloc2d(nCH,fftFrameSize,sizeof(float));
-#ifdef SMB_ENABLE_SAF_FFT
-    h->gFFTworksp_td = (float_complex**)calloc2d(nCH,fftFrameSize,sizeof(float_complex));
-    h->gFFTworksp_fd = (float_complex**)calloc2d(nCH,fftFrameSize,sizeof(float_complex));
-#else
-    h->gFFTworksp = (float**)calloc2d(nCH,2*fftFrameSize,sizeof(float));
-#endif
+    h->gFFTworksp_td = (float**)calloc2d(nCH,fftFrameSize,sizeof(float));
+    h->gFFTworksp_fd = (float_complex**)calloc2d(nCH,fftFrameSize/2+1,sizeof(float_complex));
     h->gLastPhase = (float**)calloc2d(nCH,fftFrameSize/2+1,sizeof(float));
     h->gSumPhase = (float**)calloc2d(nCH,fftFrameSize/2+1,sizeof(float));
     h->gOutputAccum = (float**)calloc2d(nCH,2*(h->fftFrameSize),sizeof(float));
@@ -164,6 +280,33 @@ void smb_pitchShift_create
     h->gAnaMagn = (float**)calloc2d(nCH,fftFrameSize,sizeof(float));
     h->gSynFreq = (float**)malloc2d(nCH,fftFrameSize,sizeof(float));
     h->gSynMagn = (float**)malloc2d(nCH,fftFrameSize,sizeof(float));
+
+    /* Batched plans for the transforms of all channels at once */
+    saf_rfft_planBatch(h->hFFT, fftFrameSize, fftFrameSize/2+1, nCH, nCH);
+}
+
+void smb_pitchShift_create
+(
+    void** hSmb,
+    int nCH,
+    int fftFrameSize,
+    int osamp,
+    float sampleRate
+)
+{
+    smb_pitchShift_createInternal(hSmb, nCH, fftFrameSize, osamp, sampleRate, 0);
+}
+
+void smb_pitchShift_createFast
+(
+    void** hSmb,
+    int nCH,
+    int fftFrameSize,
+    int osamp,
+    float sampleRate
+)
+{
+    smb_pitchShift_createInternal(hSmb, nCH, fftFrameSize, osamp, sampleRate, 1);
 }
 
 void smb_pitchShift_destroy
@@ -173,17 +316,12 @@ void smb_pitchShift_destroy
 {
     smb_pitchShift_data *h = (smb_pitchShift_data*)(*hSmb);
     if(h!=NULL){
-        saf_fft_destroy(&(h->hFFT));
+        saf_rfft_destroy(&(h->hFFT));
         free(h->window);
-        free(h->gRover);
         free(h->gInFIFO);
         free(h->gOutFIFO);
-#ifdef SMB_ENABLE_SAF_FFT
         free(h->gFFTworksp_td);
         free(h->gFFTworksp_fd);
-#else
-        free(h->gFFTworksp);
-#endif
         free(h->gLastPhase);
         free(h->gSumPhase);
         free(h->gOutputAccum);
@@ -218,14 +356,7 @@ void smb_pitchShift_apply
 )
 {
     smb_pitchShift_data *h = (smb_pitchShift_data*)(hSmb);
-    float magn, phase, tmp, real, imag;
-    float freqPerBin, expct;
-    int ch, i, k, qpd, index, fftFrameSize2;
-
-    /* set up some handy variables */
-    fftFrameSize2 = h->fftFrameSize/2;
-    freqPerBin = h->sampleRate/(float)h->fftFrameSize;
-    expct = 2.0f*SAF_PI*(float)(h->stepSize)/(float)h->fftFrameSize;
+    int ch, i, nSamples;
 
     /* flush buffers */
     if(h->pitchShiftFactor!=pitchShift){
@@ -237,146 +368,20 @@ void smb_pitchShift_apply
         }
     }
 
-    /* main processing loop */
-    for(ch=0; ch<h->nCH; ch++){
-        for (i = 0; i < frameSize; i++){
-            /* As long as we have not yet collected enough data just read in */
-            h->gInFIFO[ch][h->gRover[ch]] = indata[ch*frameSize+i];
-            outdata[ch*frameSize+i] = h->gOutFIFO[ch][h->gRover[ch]-(h->inFifoLatency)];
-            h->gRover[ch]++;
-
-            /* now we have enough data for processing */
-            if (h->gRover[ch] >= h->fftFrameSize) {
-                h->gRover[ch] = h->inFifoLatency;
-
-#ifdef SMB_ENABLE_SAF_FFT
-                for (k = 0; k < h->fftFrameSize;k++)
-                    h->gFFTworksp_td[ch][k] = cmplxf(h->gInFIFO[ch][k] * (float)h->window[k], 0.0f);
-                saf_fft_forward(h->hFFT, h->gFFTworksp_td[ch], h->gFFTworksp_fd[ch]);
-#else
-                /* do windowing and re,im interleave */
-                for (k = 0; k < h->fftFrameSize;k++) {
-                    h->gFFTworksp[ch][2*k] = h->gInFIFO[ch][k] * h->window[k];
-                    h->gFFTworksp[ch][2*k+1] = 0.;
-                }
-
-                /* do transform */
-                smbFft(h->gFFTworksp[ch], h->fftFrameSize, -1);
-#endif
-
-                /* ***************** ANALYSIS ******************* */
-                for (k = 0; k <= fftFrameSize2; k++) {
-#ifdef SMB_ENABLE_SAF_FFT
-                    real = crealf(h->gFFTworksp_fd[ch][k]);
-                    imag = cimagf(h->gFFTworksp_fd[ch][k]);
-#else
-                    /* de-interlace FFT buffer */
-                    real = h->gFFTworksp[ch][2*k];
-                    imag = h->gFFTworksp[ch][2*k+1];
-#endif
-                    /* compute magnitude and phase */
-                    magn = 2.0f*sqrtf(real*real + imag*imag);
-                    phase = atan2f(imag,real);
-
-                    /* compute phase difference */
-                    tmp = phase - h->gLastPhase[ch][k];
-                    h->gLastPhase[ch][k] = phase;
-
-                    /* subtract expected phase difference */
-                    tmp -= (float)k*expct;
-
-                    /* map delta phase into +/- Pi interval */
-                    qpd = (int)(tmp/SAF_PI);
-                    if (qpd >= 0) qpd += qpd&1;
-                    else qpd -= qpd&1;
-                    tmp -= SAF_PI*(float)qpd;
-
-                    /* get deviation from bin frequency from the +/- Pi interval */
-                    tmp = (float)h->osamp*tmp/(2.0f*SAF_PI);
-
-                    /* compute the k-th partials' true frequency */
-                    tmp = (float)k*freqPerBin + tmp*freqPerBin;
-
-                    /* store magnitude and true frequency in analysis arrays */
-                    h->gAnaMagn[ch][k] = magn;
-                    h->gAnaFreq[ch][k] = tmp;
-
-                }
-
-                /* ***************** PROCESSING ******************* */
-                /* this does the actual pitch shifting */
-                memset(h->gSynMagn[ch], 0, h->fftFrameSize*sizeof(float));
-                memset(h->gSynFreq[ch], 0, h->fftFrameSize*sizeof(float));
-                for (k = 0; k <= fftFrameSize2; k++) {
-                    index = (int)((float)k*(h->pitchShiftFactor));
-                    if (index <= fftFrameSize2) {
-                        h->gSynMagn[ch][index] += (h->gAnaMagn[ch][k]);
-                        h->gSynFreq[ch][index] = h->gAnaFreq[ch][k] * (h->pitchShiftFactor);
-                    }
-                }
-
-                /* ***************** SYNTHESIS ******************* */
-                /* this is the synthesis step */
-                for (k = 0; k <= fftFrameSize2; k++) {
-                    /* get magnitude and true frequency from synthesis arrays */
-                    magn = h->gSynMagn[ch][k];
-                    tmp = h->gSynFreq[ch][k];
-
-                    /* subtract bin mid frequency */
-                    tmp -= (float)k*freqPerBin;
-
-                    /* get bin deviation from freq deviation */
-                    tmp /= freqPerBin;
-
-                    /* take osamp into account */
-                    tmp = 2.0f*SAF_PI*tmp/(h->osamp);
-
-                    /* add the overlap phase advance back in */
-                    tmp += (float)k*expct;
-
-                    /* accumulate delta phase to get bin phase */
-                    h->gSumPhase[ch][k] += tmp;
-                    phase = h->gSumPhase[ch][k];
-
-#ifdef SMB_ENABLE_SAF_FFT
-                    h->gFFTworksp_fd[ch][k] = cmplxf(magn*cosf(phase), magn*sinf(phase));
-#else
-                    /* get real and imag part and re-interleave */
-                    h->gFFTworksp[ch][2*k] = magn*cos(phase);
-                    h->gFFTworksp[ch][2*k+1] = magn*sin(phase);
-#endif
-                }
-
-#ifdef SMB_ENABLE_SAF_FFT
-                for (k = fftFrameSize2+1; k < h->fftFrameSize; k++)
-                    h->gFFTworksp_fd[ch][k] = cmplxf(0.0f, 0.0f);
-
-                saf_fft_backward(h->hFFT, h->gFFTworksp_fd[ch], h->gFFTworksp_td[ch]);
-
-                for(k=0; k < h->fftFrameSize; k++)
-                    h->gOutputAccum[ch][k] += 2.0f*(h->window[k])*crealf(h->gFFTworksp_td[ch][k])/((h->osamp)); 
-#else
-                /* zero negative frequencies */
-                for (k = h->fftFrameSize+2; k < 2*(h->fftFrameSize); k++)
-                    h->gFFTworksp[ch][k] = 0.;
-
-                /* do inverse transform */
-                smbFft(h->gFFTworksp[ch], h->fftFrameSize, 1);
-
-                /* do windowing and add to output accumulator */
-                for(k=0; k < h->fftFrameSize; k++)
-                    h->gOutputAccum[ch][k] += 2.*(h->window[k])*(h->gFFTworksp[ch][2*k])/(fftFrameSize2*(h->osamp));
-#endif
-                for (k = 0; k < h->stepSize; k++)
-                    h->gOutFIFO[ch][k] = h->gOutputAccum[ch][k];
-
-                /* shift accumulator */
-                memmove(h->gOutputAccum[ch], h->gOutputAccum[ch] + (h->stepSize), h->fftFrameSize*sizeof(float));
-
-                /* move input FIFO */
-                for (k = 0; k < h->inFifoLatency; k++)
-                    h->gInFIFO[ch][k] = h->gInFIFO[ch][k+h->stepSize];
-             }
-         }
+    /* main processing loop; the FIFOs are filled/emptied a block at a time,
+     * up until the next hop is due, at which point all channels are processed */
+    for(i=0; i<frameSize; i+=nSamples){
+        nSamples = SAF_MIN(frameSize-i, h->fftFrameSize - h->gRover);
+        for(ch=0; ch<h->nCH; ch++){
+            memcpy(&(h->gInFIFO[ch][h->gRover]), &indata[ch*frameSize+i], nSamples*sizeof(float));
+            memcpy(&outdata[ch*frameSize+i], &(h->gOutFIFO[ch][h->gRover-(h->inFifoLatency)]), nSamples*sizeof(float));
+        }
+        h->gRover += nSamples;
+
+        /* now we have enough data for processing */
+        if (h->gRover >= h->fftFrameSize) {
+            h->gRover = h->inFifoLatency;
+            smb_pitchShift_processHop(h);
+        }
     }
 }
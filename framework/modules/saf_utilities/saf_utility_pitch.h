@@ -58,6 +58,30 @@ void smb_pitchShift_create(/* Input Arguments */
                            int osamp,
                            float sampleRate);
 
+/**
+ * Creates an instance of SMB PitchShifter, which employs fast polynomial
+ * approximations of atan2f(), cosf() and sinf() for converting between the
+ * rectangular and polar forms of the spectra
+ *
+ * The approximations are accurate to within ~1.2e-5 radians, which is not
+ * audible; but the output is not identical to that of an instance obtained
+ * via smb_pitchShift_create().
+ *
+ * @test test__smb_pitchShifter_fast()
+ *
+ * @param[in] hSmb         (&) address of smb pitchShifter handle
+ * @param[in] nCH          number of channels
+ * @param[in] fftFrameSize FFT size
+ * @param[in] osamp        Oversampling/overlapping factor
+ * @param[in] sampleRate   Sampling rate, Hz
+ */
+void smb_pitchShift_createFast(/* Input Arguments */
+                               void** hSmb,
+                               int nCH,
+                               int fftFrameSize,
+                               int osamp,
+                               float sampleRate);
+
 /**
  * Destroys an instance of SMB PitchShifter
  *
@@ -74,7 +98,9 @@ void smb_pitchShift_destroy(/* Input Arguments */
  * distributed under the WOL license. It has been modified to better work with
  * frame-by-frame processing. It also supports multiple input channels and
  * employs saf_utility_fft.h and saf_utility_veclib.h for additional run-time
- * optimisations.
+ * optimisations. The input/output FIFOs are handled block-wise, and all
+ * channels are transformed together (with real FFTs) whenever a new hop is
+ * due.
  *
  * @param[in]  hSmb       (&) smb pitchShifter handle
  * @param[in]  pitchShift Pitch shift factor, 0.5: down 1 octave, 1: no shift,
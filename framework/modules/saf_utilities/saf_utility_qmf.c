@@ -35,6 +35,7 @@
 #define QMF_MAX_HOP_SIZE ( 128 )        /**< Maximum hop size supported */
 #define QMF_HYBRID_FILTER_LENGTH ( 13 ) /**< Hybrid-filter length */
 #define QMF_NBANDS_2_SUBDIVIDE ( 3 )    /**< Number of QMF bands to subdivide */
+#define QMF_HYBRID_DELAY_LENGTH ( (QMF_HYBRID_FILTER_LENGTH-1)/2 + 1 ) /**< Length of the delay-lines for the bands that are not subdivided */
 
 /** Prototype filter/window */
 static const double __qmf_protofilter[1280] =
@@ -117,30 +118,33 @@ typedef struct _qmf_data {
     int procDelay;                    /**< Processing delay in samples */
     QMF_FDDATA_FORMAT format;         /**< see #QMF_FDDATA_FORMAT */ 
 
-    /* QMF Analysis and Synthesis filters */
-    float_complex** h_a;
-    float** h_s_real;
-    float** h_s_imag;
+    /* QMF Analysis and Synthesis modulators; applied via a 2*hopsize FFT */
+    void* hFFT;                       /**< saf_fft handle; 2*hopsize */
+    float_complex* mod_twiddle;       /**< exp(-j*pi*n/(2*hopsize)); 2*hopsize x 1 */
+    float_complex* ana_twiddle;       /**< Analysis post-twiddle (incl. scaling); hopsize x 1 */
+    float_complex* syn_twiddle;       /**< Synthesis pre-twiddle (incl. scaling); hopsize x 1 */
+    float_complex* fft_in;            /**< FFT input buffer; 2*hopsize x 1 */
+    float_complex* fft_out;           /**< FFT output buffer; 2*hopsize x 1 */
 
     /* Prototype window */
     float* h_p;
 
     /* For run-time */
-    float** buffer_ana;
-    float** buffer_syn;
+    float** buffer_ana;               /**< Analysis ring buffers, 10 blocks of hopsize (newest block time-reversed); nCHin x (10*hopsize) */
+    float** buffer_syn;               /**< Synthesis ring buffers, 10 blocks of 2*hopsize; nCHout x (20*hopsize) */
+    int anaIdx;                       /**< Block in buffer_ana holding the newest hop */
+    int synIdx;                       /**< Block in buffer_syn holding the newest frame */
     float* buffer_win;
     float* win_sum;
-    float* win_sum_cmplx_dummy; /* treated as complex data type (interleaved with zeros for imag parts) */
     float_complex* qmfTF_frame;
-    float* qmfTF_frame_tmp; /* used when taking the real/imag parts */
-    float* tmp_real_frame;
-    float* tmp_imag_frame;
 
     /* For hybrid filtering */
     float_complex fb8bandCoeffs[8][QMF_HYBRID_FILTER_LENGTH];
     float_complex fb4bandCoeffs[2][QMF_HYBRID_FILTER_LENGTH];
-    float_complex*** hybBuffer;
-    float_complex*** qmfDelayBuffer;
+    float_complex*** hybBuffer;       /**< Mirrored ring buffers; nCHin x #QMF_NBANDS_2_SUBDIVIDE x (2*#QMF_HYBRID_FILTER_LENGTH) */
+    float_complex*** qmfDelayBuffer;  /**< Ring buffers; nCHin x #QMF_HYBRID_DELAY_LENGTH x (hopsize-#QMF_NBANDS_2_SUBDIVIDE) */
+    int hybIdx;                       /**< Position of the newest sample in hybBuffer */
+    int dlyIdx;                       /**< Row of qmfDelayBuffer holding the newest hop */
     float_complex* hybQmfTF_frame;
 
 }qmf_data;
@@ -159,8 +163,8 @@ void qmf_create
     *phQMF = malloc1d(sizeof(qmf_data));
     qmf_data *h = (qmf_data*)(*phQMF);
     int i,j,K,N,dsFactor;
-    float scale, eq;
-    float* k_tmp, *n_tmp;
+    float eq;
+    double scale, k_i, c, d;
 
     saf_assert(hopsize==4 || hopsize==8 || hopsize==16 || hopsize==32 || hopsize==64 || hopsize==128, "Unsupported hopsize");
 
@@ -173,31 +177,37 @@ void qmf_create
     
     K = hopsize;
     N = 2*hopsize;
-    k_tmp = malloc1d(K*sizeof(float));
-    n_tmp = malloc1d(N*sizeof(float));
-
-    /* QMF Analysis filters */
-    h->h_a = (float_complex**)malloc2d(K, N, sizeof(float_complex));
-    scale = (float)QMF_MAX_HOP_SIZE / (2.0f*(float)hopsize); /* (Used to balance the levels between different hopsizes) */
-    for(i=0; i<K; i++)
-        k_tmp[i] = SAF_PI/2.0f/(float)K * ((float)i+0.5f);
-    for(i=0; i<N; i++)
-        n_tmp[i] = 2.0f*(float)i - 2.0f*(float)K/(float)QMF_MAX_HOP_SIZE;
-    for(i=0; i<K; i++)
-        for(j=0; j<N; j++)
-            h->h_a[i][j] = crmulf(cexpf(cmplxf(0.0f, k_tmp[i]*n_tmp[j])), scale);
-
-    /* QMF Synthesis filters */
-    h->h_s_real = (float**)malloc2d(N, K, sizeof(float));
-    h->h_s_imag = (float**)malloc2d(N, K, sizeof(float));
-    scale = 2.0f / QMF_MAX_HOP_SIZE; /* (Used to balance the levels between different hopsizes) */
+
+    /* The QMF analysis modulators are: scale*exp(j*k_i*(2n-c)), and the
+     * synthesis modulators are: scale*exp(j*k_i*(2n-d)), where
+     * k_i = pi/(2K)*(i+0.5), for band i=0:K-1 and sample n=0:N-1. Since
+     * 2*k_i*n = 2*pi*i*n/N + pi*n/N, both can be applied with an N-point FFT
+     * sandwiched between a time-domain twiddle, exp(-j*pi*n/N), and a
+     * band-wise twiddle, exp(-j*k_i*c) or exp(j*k_i*d); i.e. O(N log N) per
+     * hop, rather than an O(N^2) matrix-vector product */
+    saf_fft_create(&(h->hFFT), N);
+    h->mod_twiddle = malloc1d(N*sizeof(float_complex));
+    h->ana_twiddle = malloc1d(K*sizeof(float_complex));
+    h->syn_twiddle = malloc1d(K*sizeof(float_complex));
+    h->fft_in = malloc1d(N*sizeof(float_complex));
+    h->fft_out = malloc1d(N*sizeof(float_complex));
     for(i=0; i<N; i++)
-        n_tmp[i] = 2.0f*(float)i - (2.0f*(float)QMF_MAX_HOP_SIZE-1.0f)*(float)K/((float)QMF_MAX_HOP_SIZE/2.0f);
-    for(i=0; i<N; i++){
-        for(j=0; j<K; j++){
-            h->h_s_real[i][j] = scale * cosf(k_tmp[j]*n_tmp[i]);
-            h->h_s_imag[i][j] = scale * sinf(k_tmp[j]*n_tmp[i]);
-        }
+        h->mod_twiddle[i] = cmplxf((float)cos(-SAF_PId*(double)i/(double)N), (float)sin(-SAF_PId*(double)i/(double)N));
+
+    /* QMF Analysis modulators */
+    scale = (double)QMF_MAX_HOP_SIZE / (2.0*(double)K); /* (Used to balance the levels between different hopsizes) */
+    c = 2.0*(double)K/(double)QMF_MAX_HOP_SIZE;
+    for(i=0; i<K; i++){
+        k_i = SAF_PId/2.0/(double)K * ((double)i+0.5);
+        h->ana_twiddle[i] = cmplxf((float)(scale*cos(-k_i*c)), (float)(scale*sin(-k_i*c)));
+    }
+
+    /* QMF Synthesis modulators */
+    scale = 2.0 / (double)QMF_MAX_HOP_SIZE; /* (Used to balance the levels between different hopsizes) */
+    d = (2.0*(double)QMF_MAX_HOP_SIZE-1.0)*(double)K/((double)QMF_MAX_HOP_SIZE/2.0);
+    for(i=0; i<K; i++){
+        k_i = SAF_PId/2.0/(double)K * ((double)i+0.5);
+        h->syn_twiddle[i] = cmplxf((float)(scale*cos(k_i*d)), (float)(scale*sin(k_i*d)));
     }
 
     /* Prototype filter */
@@ -213,19 +223,16 @@ void qmf_create
     }
 
     /* Run-time buffers */
-    h->buffer_ana = (float**)malloc1d(nCHin*sizeof(float*)); /* actually faster to go with non-contiguous allocated memory here due to memmove... */
+    h->buffer_ana = (float**)malloc1d(nCHin*sizeof(float*)); /* (non-contiguous, so that channels may be added/removed individually) */
     for(i=0; i<nCHin; i++)
         h->buffer_ana[i] = calloc1d(hopsize * 10, sizeof(float));
     h->buffer_syn = (float**)malloc1d(nCHout*sizeof(float*));
     for(i=0; i<nCHout; i++)
         h->buffer_syn[i] = calloc1d(hopsize * 20, sizeof(float));
+    h->anaIdx = h->synIdx = 0;
     h->buffer_win = malloc1d(hopsize * 10 * sizeof(float));
     h->win_sum = malloc1d(hopsize * 2 * sizeof(float));
-    h->win_sum_cmplx_dummy = calloc1d(hopsize * 4, sizeof(float)); /* ca */
     h->qmfTF_frame = malloc1d(hopsize * sizeof(float_complex));
-    h->qmfTF_frame_tmp = malloc1d(hopsize * sizeof(float));
-    h->tmp_real_frame = malloc1d(hopsize * 2 * sizeof(float));
-    h->tmp_imag_frame = malloc1d(hopsize * 2 * sizeof(float));
 
     /* Init hybrid filtering coefficients: */
     if(hybridmode){
@@ -251,8 +258,9 @@ void qmf_create
                                                 cosf(2.0f*SAF_PI*(float)i*((float)j-(((float)QMF_HYBRID_FILTER_LENGTH-1.0f)/2.0f))/2.0f), 0.0f);
 
         /* For run-time */
-        h->qmfDelayBuffer = (float_complex***)calloc3d(nCHin, hopsize-QMF_NBANDS_2_SUBDIVIDE, (QMF_HYBRID_FILTER_LENGTH-1)/2 + 1, sizeof(float_complex)); /* ca */
-        h->hybBuffer = (float_complex***)calloc3d(nCHin, QMF_NBANDS_2_SUBDIVIDE, QMF_HYBRID_FILTER_LENGTH, sizeof(float_complex));
+        h->qmfDelayBuffer = (float_complex***)calloc3d(nCHin, QMF_HYBRID_DELAY_LENGTH, hopsize-QMF_NBANDS_2_SUBDIVIDE, sizeof(float_complex)); /* ca */
+        h->hybBuffer = (float_complex***)calloc3d(nCHin, QMF_NBANDS_2_SUBDIVIDE, 2*QMF_HYBRID_FILTER_LENGTH, sizeof(float_complex));
+        h->hybIdx = h->dlyIdx = 0;
         h->hybQmfTF_frame = malloc1d(h->nBands * sizeof(float_complex));
 
         /* Processing delay */
@@ -262,10 +270,6 @@ void qmf_create
         /* Processing delay */
         h->procDelay = hopsize*9+1;
     }
-
-    /* clean-up */
-    free(k_tmp);
-    free(n_tmp);
 }
 
 void qmf_destroy
@@ -277,10 +281,13 @@ void qmf_destroy
     int i;
 
     if(h!=NULL){
-        /* QMF Analysis and Synthesis filters */
-        free(h->h_a);
-        free(h->h_s_real);
-        free(h->h_s_imag);
+        /* QMF Analysis and Synthesis modulators */
+        saf_fft_destroy(&(h->hFFT));
+        free(h->mod_twiddle);
+        free(h->ana_twiddle);
+        free(h->syn_twiddle);
+        free(h->fft_in);
+        free(h->fft_out);
 
         /* Prototype window */
         free(h->h_p);
@@ -292,11 +299,7 @@ void qmf_destroy
             free(h->buffer_syn[i]);
         free(h->buffer_win);
         free(h->win_sum);
-        free(h->win_sum_cmplx_dummy);
         free(h->qmfTF_frame);
-        free(h->qmfTF_frame_tmp);
-        free(h->tmp_real_frame);
-        free(h->tmp_imag_frame);
 
         /* For hybrid filtering */
         if(h->hybridmode){
@@ -320,59 +323,75 @@ void qmf_analysis
 )
 {
     qmf_data *h = (qmf_data*)(hQMF);
-    int i, ch, t, nHops, band;
+    int i, ch, t, nHops, band, anaIdx, hybIdx, dlyIdx;
+    float* fin, *fout, *tw, *out;
     float_complex subBands8[8], subBands2[2];
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
 
     saf_assert(framesize % h->hopsize == 0, "framesize must be multiple of hopsize");  
     nHops = framesize/h->hopsize;
 
+    anaIdx = h->anaIdx;
+    hybIdx = h->hybridmode ? h->hybIdx : 0;
+    dlyIdx = h->hybridmode ? h->dlyIdx : 0;
     for(ch=0; ch<h->nCHin; ch++){
+        /* All channels advance their ring buffers in lock-step */
+        anaIdx = h->anaIdx;
+        hybIdx = h->hybridmode ? h->hybIdx : 0;
+        dlyIdx = h->hybridmode ? h->dlyIdx : 0;
         for(t=0; t<nHops; t++){
-            /* Shift samples to the right by one hopsize, and copy the current frame
-               to the beginning */
-            memmove(&(h->buffer_ana[ch][h->hopsize]), h->buffer_ana[ch], h->hopsize * 9 * sizeof(float));
-            cblas_scopy(h->hopsize, &dataTD[ch][t*(h->hopsize)], -1, h->buffer_ana[ch], 1);
+            /* The current frame (time-reversed) replaces the oldest block, which
+             * then becomes the newest; i.e. block (anaIdx+b)%10 was written b hops ago */
+            anaIdx = (anaIdx + 9) % 10;
+            cblas_scopy(h->hopsize, &dataTD[ch][t*(h->hopsize)], -1, &(h->buffer_ana[ch][anaIdx*(h->hopsize)]), 1);
 
-            /* Apply prototype filter/window */
-            utility_svvmul(h->buffer_ana[ch], h->h_p, h->hopsize*10, h->buffer_win);
+            /* Apply prototype filter/window (directly from the ring buffer) */
+            for(i=0; i<10; i++)
+                utility_svvmul(&(h->buffer_ana[ch][((anaIdx+i)%10)*(h->hopsize)]), &(h->h_p[i*(h->hopsize)]), h->hopsize, &(h->buffer_win[i*(h->hopsize)]));
 
             /* Sum all 5 consecutive 1:2*hopsize */
             utility_svvadd(h->buffer_win, &(h->buffer_win[h->hopsize*2]), h->hopsize*2, h->win_sum);
             cblas_saxpy(h->hopsize*2, 1.0f, h->buffer_win + h->hopsize*4, 1, h->win_sum, 1);
             cblas_saxpy(h->hopsize*2, 1.0f, h->buffer_win + h->hopsize*6, 1, h->win_sum, 1);
             cblas_saxpy(h->hopsize*2, 1.0f, h->buffer_win + h->hopsize*8, 1, h->win_sum, 1);
-            cblas_scopy(h->hopsize*2, h->win_sum, 1, h->win_sum_cmplx_dummy, 2);
 
-            /* Apply complex-QMF analysis modulators  */
-            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, h->hopsize, 1, h->hopsize*2, &calpha,
-                        FLATTEN2D(h->h_a), h->hopsize*2,
-                        (float_complex*)h->win_sum_cmplx_dummy, 1, &cbeta,
-                        h->qmfTF_frame, 1);
+            /* Apply complex-QMF analysis modulators: X[i] = ana_twiddle[i] * conj(FFT(win_sum .* mod_twiddle))[i] */
+            fin = (float*)h->fft_in;
+            tw = (float*)h->mod_twiddle;
+            for(i=0; i<h->hopsize*2; i++){
+                fin[2*i]   = h->win_sum[i] * tw[2*i];
+                fin[2*i+1] = h->win_sum[i] * tw[2*i+1];
+            }
+            saf_fft_forward(h->hFFT, h->fft_in, h->fft_out);
+            fout = (float*)h->fft_out;
+            tw = (float*)h->ana_twiddle;
+            out = (float*)h->qmfTF_frame;
+            for(i=0; i<h->hopsize; i++){
+                out[2*i]   = tw[2*i]   * fout[2*i] + tw[2*i+1] * fout[2*i+1];
+                out[2*i+1] = tw[2*i+1] * fout[2*i] - tw[2*i]   * fout[2*i+1];
+            }
 
             /* Subdivide the lowest 3 bands */
             if(h->hybridmode){
-                /* Shift buffer down by 1 frame */
-                memmove(h->hybBuffer[ch][0], &(h->hybBuffer[ch][0][1]), (QMF_HYBRID_FILTER_LENGTH-1)*sizeof(float_complex));
-                memmove(h->hybBuffer[ch][1], &(h->hybBuffer[ch][1][1]), (QMF_HYBRID_FILTER_LENGTH-1)*sizeof(float_complex));
-                memmove(h->hybBuffer[ch][2], &(h->hybBuffer[ch][2][1]), (QMF_HYBRID_FILTER_LENGTH-1)*sizeof(float_complex));
-
-                /* Append new frame to hybrid filtering buffer */
-                h->hybBuffer[ch][0][QMF_HYBRID_FILTER_LENGTH-1] =  h->qmfTF_frame[0];
-                h->hybBuffer[ch][1][QMF_HYBRID_FILTER_LENGTH-1] =  h->qmfTF_frame[1];
-                h->hybBuffer[ch][2][QMF_HYBRID_FILTER_LENGTH-1] =  h->qmfTF_frame[2];
+                /* Append new frame to the hybrid filtering buffers. Each sample
+                 * is written twice (hybIdx and hybIdx+QMF_HYBRID_FILTER_LENGTH),
+                 * so that the last QMF_HYBRID_FILTER_LENGTH samples are always
+                 * contiguous in memory, starting from hybIdx+1 (oldest first) */
+                hybIdx = (hybIdx + 1) % QMF_HYBRID_FILTER_LENGTH;
+                for(i=0; i<QMF_NBANDS_2_SUBDIVIDE; i++){
+                    h->hybBuffer[ch][i][hybIdx] = h->qmfTF_frame[i];
+                    h->hybBuffer[ch][i][hybIdx+QMF_HYBRID_FILTER_LENGTH] = h->qmfTF_frame[i];
+                }
 
                 /* Delay all the other QMF bands (i.e., the ones not being subdivided)
                  * so that they align with the hybrid bands in time: */
-                for(i=0; i<h->hopsize - QMF_NBANDS_2_SUBDIVIDE; i++){
-                    memmove(h->qmfDelayBuffer[ch][i], &(h->qmfDelayBuffer[ch][i][1]), ((QMF_HYBRID_FILTER_LENGTH-1)/2)*sizeof(float_complex));
-                    h->qmfDelayBuffer[ch][i][(QMF_HYBRID_FILTER_LENGTH-1)/2] = h->qmfTF_frame[i+QMF_NBANDS_2_SUBDIVIDE];
-                }
+                cblas_ccopy(h->hopsize - QMF_NBANDS_2_SUBDIVIDE, &(h->qmfTF_frame[QMF_NBANDS_2_SUBDIVIDE]), 1, h->qmfDelayBuffer[ch][dlyIdx], 1);
+                dlyIdx = (dlyIdx + 1) % QMF_HYBRID_DELAY_LENGTH;
 
                 /* Subdivide first QMF band into 8 subbands, and form hybrid bands 1-6 */
                 cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 8, 1, QMF_HYBRID_FILTER_LENGTH, &calpha,
                             h->fb8bandCoeffs, QMF_HYBRID_FILTER_LENGTH,
-                            h->hybBuffer[ch][0], 1, &cbeta,
+                            &(h->hybBuffer[ch][0][hybIdx+1]), 1, &cbeta,
                             subBands8, 1);
                 h->hybQmfTF_frame[0] = subBands8[6];
                 h->hybQmfTF_frame[1] = subBands8[7];
@@ -389,7 +408,7 @@ void qmf_analysis
                 /* Subdivide second QMF band to get hybrid bands 7 and 8 */
                 cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 2, 1, QMF_HYBRID_FILTER_LENGTH, &calpha,
                             h->fb4bandCoeffs, QMF_HYBRID_FILTER_LENGTH,
-                            h->hybBuffer[ch][1], 1, &cbeta,
+                            &(h->hybBuffer[ch][1][hybIdx+1]), 1, &cbeta,
                             subBands2, 1);
                 h->hybQmfTF_frame[6] = subBands2[1]; /* Flipped! */
                 h->hybQmfTF_frame[7] = subBands2[0];
@@ -397,14 +416,14 @@ void qmf_analysis
                 /* Subdivide third QMF band to get hybrid bands 9 and 10 */
                 cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 2, 1, QMF_HYBRID_FILTER_LENGTH, &calpha,
                             h->fb4bandCoeffs, QMF_HYBRID_FILTER_LENGTH,
-                            h->hybBuffer[ch][2], 1, &cbeta,
+                            &(h->hybBuffer[ch][2][hybIdx+1]), 1, &cbeta,
                             subBands2, 1);
                 h->hybQmfTF_frame[8] = subBands2[0];
                 h->hybQmfTF_frame[9] = subBands2[1];
 
-                /* The remaining bands are then just the delayed qmf bands, 4:end */
-                cblas_ccopy(h->hopsize - QMF_NBANDS_2_SUBDIVIDE, FLATTEN2D(h->qmfDelayBuffer[ch]),
-                            (QMF_HYBRID_FILTER_LENGTH-1)/2 + 1, &(h->hybQmfTF_frame[10]), 1);
+                /* The remaining bands are then just the delayed qmf bands, 4:end
+                 * (the oldest row, which is the next one to be overwritten) */
+                cblas_ccopy(h->hopsize - QMF_NBANDS_2_SUBDIVIDE, h->qmfDelayBuffer[ch][dlyIdx], 1, &(h->hybQmfTF_frame[10]), 1);
             }
 
             /* copy to output */
@@ -432,6 +451,11 @@ void qmf_analysis
             }
         }
     }
+    h->anaIdx = anaIdx;
+    if(h->hybridmode){
+        h->hybIdx = hybIdx;
+        h->dlyIdx = dlyIdx;
+    }
 }
 
 void qmf_synthesis
@@ -443,12 +467,16 @@ void qmf_synthesis
 )
 {
     qmf_data *h = (qmf_data*)(hQMF);
-    int ch, t, nHops, band;
+    int i, ch, t, nHops, band, synIdx;
+    float* fin, *fout, *tw, *in, *syn;
 
     saf_assert(framesize % h->hopsize == 0, "framesize must be multiple of hopsize");
     nHops = framesize/h->hopsize;
 
+    synIdx = h->synIdx;
     for(ch=0; ch<h->nCHout; ch++){
+        /* All channels advance their ring buffers in lock-step */
+        synIdx = h->synIdx;
         for(t=0; t<nHops; t++){
             /* Load frequency domain data */
             if(h->hybridmode){
@@ -491,35 +519,33 @@ void qmf_synthesis
                 }
             }
 
-            /* Shift samples to the right by 2*hopsize */
-            memmove(h->buffer_syn[ch] + h->hopsize*2, h->buffer_syn[ch], h->hopsize * 18 * sizeof(float));
-
-            /* Apply complex-QMF synthesis modulators */
-            cblas_scopy(h->hopsize, (float*)h->qmfTF_frame, 2, h->qmfTF_frame_tmp, 1); /* creal(h->qmfTF_frame) */
-            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, h->hopsize*2, 1, h->hopsize, 1.0f,
-                        FLATTEN2D(h->h_s_real), h->hopsize,
-                        h->qmfTF_frame_tmp, 1, 0.0f,
-                        h->tmp_real_frame, 1);
-            cblas_scopy(h->hopsize, &((float*)h->qmfTF_frame)[1], 2, h->qmfTF_frame_tmp, 1); /* cimag(h->qmfTF_frame) */
-            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, h->hopsize*2, 1, h->hopsize, 1.0f,
-                        FLATTEN2D(h->h_s_imag), h->hopsize,
-                        h->qmfTF_frame_tmp, 1, 0.0f,
-                        h->tmp_imag_frame, 1);
-
-            /* Append new synthesis frame */
-            utility_svvsub(h->tmp_real_frame, h->tmp_imag_frame, h->hopsize*2, h->buffer_syn[ch]);
-
-            /* Apply prototype filter/window */
-            utility_svvmul(h->buffer_syn[ch], h->h_p, h->hopsize, h->buffer_win);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*3,  h->h_p + h->hopsize,   h->hopsize, h->buffer_win + h->hopsize);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*4,  h->h_p + h->hopsize*2, h->hopsize, h->buffer_win + h->hopsize*2);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*7,  h->h_p + h->hopsize*3, h->hopsize, h->buffer_win + h->hopsize*3);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*8,  h->h_p + h->hopsize*4, h->hopsize, h->buffer_win + h->hopsize*4);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*11, h->h_p + h->hopsize*5, h->hopsize, h->buffer_win + h->hopsize*5);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*12, h->h_p + h->hopsize*6, h->hopsize, h->buffer_win + h->hopsize*6);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*15, h->h_p + h->hopsize*7, h->hopsize, h->buffer_win + h->hopsize*7);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*16, h->h_p + h->hopsize*8, h->hopsize, h->buffer_win + h->hopsize*8);
-            utility_svvmul(h->buffer_syn[ch] + h->hopsize*19, h->h_p + h->hopsize*9, h->hopsize, h->buffer_win + h->hopsize*9);
+            /* The new synthesis frame replaces the oldest block, which then
+             * becomes the newest; i.e. block (synIdx+b)%10 was written b hops ago */
+            synIdx = (synIdx + 9) % 10;
+            syn = &(h->buffer_syn[ch][synIdx*2*(h->hopsize)]);
+
+            /* Apply complex-QMF synthesis modulators, and append new synthesis frame:
+             * y[n] = real(mod_twiddle[n] * FFT([conj(X) .* syn_twiddle; zeros])[n]) */
+            fin = (float*)h->fft_in;
+            tw = (float*)h->syn_twiddle;
+            in = (float*)h->qmfTF_frame;
+            for(i=0; i<h->hopsize; i++){
+                fin[2*i]   = in[2*i] * tw[2*i]   + in[2*i+1] * tw[2*i+1];
+                fin[2*i+1] = in[2*i] * tw[2*i+1] - in[2*i+1] * tw[2*i];
+            }
+            memset(h->fft_in + h->hopsize, 0, h->hopsize*sizeof(float_complex));
+            saf_fft_forward(h->hFFT, h->fft_in, h->fft_out);
+            fout = (float*)h->fft_out;
+            tw = (float*)h->mod_twiddle;
+            for(i=0; i<h->hopsize*2; i++)
+                syn[i] = tw[2*i] * fout[2*i] - tw[2*i+1] * fout[2*i+1];
+
+            /* Apply prototype filter/window (directly from the ring buffer); the
+             * i-th hopsize segment of the window is applied to the first half of
+             * the frame written i hops ago if i is even, and its second half if
+             * i is odd */
+            for(i=0; i<10; i++)
+                utility_svvmul(&(h->buffer_syn[ch][((synIdx+i)%10)*2*(h->hopsize) + (i%2)*(h->hopsize)]), &(h->h_p[i*(h->hopsize)]), h->hopsize, &(h->buffer_win[i*(h->hopsize)]));
 
             /* Sum all 1:hopsizes to get output frame */
             utility_svvadd(h->buffer_win, h->buffer_win + h->hopsize,   h->hopsize, dataTD[ch] + t*(h->hopsize));
@@ -533,6 +559,7 @@ void qmf_synthesis
             cblas_saxpy(h->hopsize, 1.0f, h->buffer_win + h->hopsize*9, 1, dataTD[ch] + t*(h->hopsize), 1);
         }
     }
+    h->synIdx = synIdx;
 }
 
 void qmf_channelChange
@@ -548,17 +575,17 @@ void qmf_channelChange
     if(h->nCHin!=new_nCHin){
         /* resize hybrid analysis buffers */
         if(h->hybridmode){
-            h->qmfDelayBuffer = (float_complex***)realloc3d_r((void***)h->qmfDelayBuffer, new_nCHin, h->hopsize-QMF_NBANDS_2_SUBDIVIDE,
-                                                              (QMF_HYBRID_FILTER_LENGTH-1)/2 + 1, h->nCHin, h->hopsize-QMF_NBANDS_2_SUBDIVIDE,
-                                                              (QMF_HYBRID_FILTER_LENGTH-1)/2 + 1, sizeof(float_complex));
+            h->qmfDelayBuffer = (float_complex***)realloc3d_r((void***)h->qmfDelayBuffer, new_nCHin, QMF_HYBRID_DELAY_LENGTH,
+                                                              h->hopsize-QMF_NBANDS_2_SUBDIVIDE, h->nCHin, QMF_HYBRID_DELAY_LENGTH,
+                                                              h->hopsize-QMF_NBANDS_2_SUBDIVIDE, sizeof(float_complex));
             h->hybBuffer = (float_complex***)realloc3d_r((void***)h->hybBuffer, new_nCHin, QMF_NBANDS_2_SUBDIVIDE,
-                                                         QMF_HYBRID_FILTER_LENGTH, h->nCHin, QMF_NBANDS_2_SUBDIVIDE,
-                                                         QMF_HYBRID_FILTER_LENGTH, sizeof(float_complex));
+                                                         2*QMF_HYBRID_FILTER_LENGTH, h->nCHin, QMF_NBANDS_2_SUBDIVIDE,
+                                                         2*QMF_HYBRID_FILTER_LENGTH, sizeof(float_complex));
 
             /* zero any new channels */
             for(i=h->nCHin; i<new_nCHin; i++){
-                memset(FLATTEN2D(h->qmfDelayBuffer[i]), 0, (h->hopsize-QMF_NBANDS_2_SUBDIVIDE) * ((QMF_HYBRID_FILTER_LENGTH-1)/2 + 1) * sizeof(float_complex));
-                memset(FLATTEN2D(h->hybBuffer[i]), 0, QMF_NBANDS_2_SUBDIVIDE * QMF_HYBRID_FILTER_LENGTH * sizeof(float_complex));
+                memset(FLATTEN2D(h->qmfDelayBuffer[i]), 0, QMF_HYBRID_DELAY_LENGTH * (h->hopsize-QMF_NBANDS_2_SUBDIVIDE) * sizeof(float_complex));
+                memset(FLATTEN2D(h->hybBuffer[i]), 0, QMF_NBANDS_2_SUBDIVIDE * 2*QMF_HYBRID_FILTER_LENGTH * sizeof(float_complex));
             }
         }
 
@@ -596,14 +623,18 @@ void qmf_clearBuffers
     for(i=0; i<h->nCHin; i++){
         memset(h->buffer_ana[i], 0, h->hopsize * 10 * sizeof(float));
         if(h->hybridmode){
-            memset(FLATTEN3D(h->qmfDelayBuffer), 0, h->nCHin*(h->hopsize-QMF_NBANDS_2_SUBDIVIDE)* ((QMF_HYBRID_FILTER_LENGTH-1)/2 + 1)*sizeof(float_complex));
-            memset(FLATTEN3D(h->hybBuffer), 0, h->nCHin*QMF_NBANDS_2_SUBDIVIDE*QMF_HYBRID_FILTER_LENGTH*sizeof(float_complex));
+            memset(FLATTEN3D(h->qmfDelayBuffer), 0, h->nCHin*QMF_HYBRID_DELAY_LENGTH*(h->hopsize-QMF_NBANDS_2_SUBDIVIDE)*sizeof(float_complex));
+            memset(FLATTEN3D(h->hybBuffer), 0, h->nCHin*QMF_NBANDS_2_SUBDIVIDE*2*QMF_HYBRID_FILTER_LENGTH*sizeof(float_complex));
         }
     }
+    h->anaIdx = 0;
+    if(h->hybridmode)
+        h->hybIdx = h->dlyIdx = 0;
 
     /* flush synthesis buffers */
     for(i=0; i<h->nCHout; i++)
         memset(h->buffer_syn[i], 0, h->hopsize * 20 * sizeof(float));
+    h->synIdx = 0;
 }
 
 int qmf_getProcDelay
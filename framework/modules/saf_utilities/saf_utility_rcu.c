@@ -0,0 +1,191 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_rcu.c
+ * @ingroup Utilities
+ * @brief A lock-free (read-copy-update) hand-off of shared state between a
+ *        writer thread and one or more reader threads, and atomic integers
+ *
+ * The state is double-buffered: the writer places the new state in the slot
+ * that is not current, and then flips the 'current' index. Each slot has a
+ * count of the readers holding it, which the writer polls before destroying
+ * the state that was retired by the flip.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include "saf_utilities.h"
+
+#if defined(_MSC_VER)
+# include <windows.h>
+#endif
+
+/* ========================================================================== */
+/*                              Atomic Integers                               */
+/* ========================================================================== */
+
+int saf_atomic_load(volatile int* ptr)
+{
+#if defined(_MSC_VER)
+    return (int)InterlockedCompareExchange((volatile LONG*)ptr, 0, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+#endif
+}
+
+void saf_atomic_store(volatile int* ptr, int value)
+{
+#if defined(_MSC_VER)
+    InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+int saf_atomic_compareExchange(volatile int* ptr, int expected, int desired)
+{
+#if defined(_MSC_VER)
+    return (int)InterlockedCompareExchange((volatile LONG*)ptr, (LONG)desired, (LONG)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/** Atomically adds 'value' to the integer */
+static void saf_atomic_add(volatile int* ptr, int value)
+{
+#if defined(_MSC_VER)
+    InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value);
+#else
+    __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+/* ========================================================================== */
+/*                             Read-Copy-Update                               */
+/* ========================================================================== */
+
+/** Data structure for the state hand-off */
+typedef struct _saf_rcu_data {
+    void* volatile state[2];   /**< The two state slots */
+    volatile int nReaders[2];  /**< Number of readers holding each slot */
+    volatile int current;      /**< Index of the current slot */
+    saf_rcu_destroyFn destroyFn;
+
+}saf_rcu_data;
+
+/** Waits until no reader holds slot 'i', and then destroys its state */
+static void saf_rcu_retire(saf_rcu_data* h, int i)
+{
+    void* state;
+
+    while(saf_atomic_load(&(h->nReaders[i]))>0)
+        SAF_SLEEP(1);
+    state = h->state[i];
+    h->state[i] = NULL;
+    if(state!=NULL && h->destroyFn!=NULL)
+        h->destroyFn(&state);
+}
+
+void saf_rcu_create
+(
+    void ** const phRCU,
+    saf_rcu_destroyFn destroyFn
+)
+{
+    *phRCU = malloc1d(sizeof(saf_rcu_data));
+    saf_rcu_data *h = (saf_rcu_data*)(*phRCU);
+
+    h->state[0] = h->state[1] = NULL;
+    h->nReaders[0] = h->nReaders[1] = 0;
+    h->current = 0;
+    h->destroyFn = destroyFn;
+}
+
+void saf_rcu_destroy
+(
+    void ** const phRCU
+)
+{
+    saf_rcu_data *h = (saf_rcu_data*)(*phRCU);
+
+    if(h!=NULL){
+        saf_rcu_retire(h, 0);
+        saf_rcu_retire(h, 1);
+        free(h);
+        h=NULL;
+        *phRCU = NULL;
+    }
+}
+
+void* saf_rcu_acquire
+(
+    void * const hRCU,
+    int* ticket
+)
+{
+    saf_rcu_data *h = (saf_rcu_data*)(hRCU);
+    int i;
+
+    /* Register as a reader of the current slot; if the writer flipped the
+     * current index in the meantime, then the slot may be about to be retired,
+     * so try again with the new one */
+    for(;;){
+        i = saf_atomic_load(&(h->current));
+        saf_atomic_add(&(h->nReaders[i]), 1);
+        if(saf_atomic_load(&(h->current))==i)
+            break;
+        saf_atomic_add(&(h->nReaders[i]), -1);
+    }
+    (*ticket) = i;
+    return h->state[i];
+}
+
+void saf_rcu_release
+(
+    void * const hRCU,
+    int ticket
+)
+{
+    saf_rcu_data *h = (saf_rcu_data*)(hRCU);
+    saf_atomic_add(&(h->nReaders[ticket]), -1);
+}
+
+void saf_rcu_publish
+(
+    void * const hRCU,
+    void* newState
+)
+{
+    saf_rcu_data *h = (saf_rcu_data*)(hRCU);
+    int i;
+
+    /* The slot that is not current has already been retired, apart from any
+     * readers which registered with it just before the last flip (and which
+     * are about to back off, see saf_rcu_acquire()) */
+    i = !saf_atomic_load(&(h->current));
+    while(saf_atomic_load(&(h->nReaders[i]))>0)
+        SAF_SLEEP(1);
+    h->state[i] = newState;
+    saf_atomic_store(&(h->current), i);
+
+    /* Wait for the readers of the previous state, and then destroy it */
+    saf_rcu_retire(h, !i);
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ *@addtogroup Utilities
+ *@{
+ * @file saf_utility_rcu.h
+ * @brief A lock-free (read-copy-update) hand-off of shared state between a
+ *        writer thread and one or more reader threads, and atomic integers
+ *
+ * Intended for e.g. passing the tables computed by an initialisation thread
+ * over to the audio processing thread: the writer builds a new state object
+ * off to the side and publishes it with an atomic pointer swap, while the
+ * readers simply pick up whichever state is current at the start of each
+ * block. Readers never wait on the writer; instead, the writer waits (after
+ * the swap) until the readers are done with the previous state, before
+ * destroying it.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#ifndef SAF_RCU_H_INCLUDED
+#define SAF_RCU_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* ========================================================================== */
+/*                              Atomic Integers                               */
+/* ========================================================================== */
+
+/** Atomically loads an integer (sequentially consistent) */
+int saf_atomic_load(/* Input Arguments */
+                    volatile int* ptr);
+
+/** Atomically stores an integer (sequentially consistent) */
+void saf_atomic_store(/* Input Arguments */
+                      volatile int* ptr,
+                      int value);
+
+/**
+ * Atomically replaces the integer with 'desired', only if it is currently
+ * equal to 'expected'
+ *
+ * @returns 1 if the integer was replaced, 0 if not
+ */
+int saf_atomic_compareExchange(/* Input Arguments */
+                               volatile int* ptr,
+                               int expected,
+                               int desired);
+
+
+/* ========================================================================== */
+/*                             Read-Copy-Update                               */
+/* ========================================================================== */
+
+/**
+ * Function used to destroy a state object once it has been retired and all
+ * readers are done with it (may be NULL, if the states are not owned)
+ */
+typedef void (*saf_rcu_destroyFn)(void ** const phState);
+
+/**
+ * Creates an instance of the state hand-off (initially with no state, i.e.
+ * saf_rcu_acquire() returns NULL until a state is published)
+ *
+ * @test test__saf_rcu()
+ *
+ * @param[in] phRCU     (&) address of the handle
+ * @param[in] destroyFn Function used to destroy retired states (or NULL)
+ */
+void saf_rcu_create(/* Input Arguments */
+                    void ** const phRCU,
+                    saf_rcu_destroyFn destroyFn);
+
+/**
+ * Destroys an instance of the state hand-off, including the current state
+ *
+ * @warning No readers may be active while the handle is destroyed.
+ *
+ * @param[in] phRCU (&) address of the handle
+ */
+void saf_rcu_destroy(/* Input Arguments */
+                     void ** const phRCU);
+
+/**
+ * Returns the current state (or NULL if none has been published), which
+ * remains valid until it is handed back with saf_rcu_release()
+ *
+ * This never waits on the writer, and may be called from real-time threads
+ * and by multiple readers at the same time.
+ *
+ * @param[in]  hRCU   Handle
+ * @param[out] ticket (&) Ticket to pass on to saf_rcu_release()
+ * @returns the current state, or NULL
+ */
+void* saf_rcu_acquire(/* Input Arguments */
+                      void * const hRCU,
+                      /* Output Arguments */
+                      int* ticket);
+
+/**
+ * Hands back a state previously obtained with saf_rcu_acquire() (which must
+ * not be accessed afterwards)
+ *
+ * @param[in] hRCU   Handle
+ * @param[in] ticket Ticket returned by saf_rcu_acquire()
+ */
+void saf_rcu_release(/* Input Arguments */
+                     void * const hRCU,
+                     int ticket);
+
+/**
+ * Makes 'newState' the current state, and then waits until no reader holds
+ * the previous state anymore, before destroying it (with the destroyFn)
+ *
+ * @note Only one thread may call this function at a time. Publishing NULL
+ *       retracts the current state; once this function returns, none of the
+ *       readers are using the previous state.
+ *
+ * @param[in] hRCU     Handle
+ * @param[in] newState New state (or NULL)
+ */
+void saf_rcu_publish(/* Input Arguments */
+                     void * const hRCU,
+                     void* newState);
+
+
+#ifdef __cplusplus
+}/* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* SAF_RCU_H_INCLUDED */
+
+/**@} */ /* doxygen addtogroup Utilities */
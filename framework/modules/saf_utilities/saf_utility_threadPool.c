@@ -0,0 +1,264 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_threadPool.c
+ * @ingroup Utilities
+ * @brief A persistent pool of worker threads
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include "saf_utilities.h"
+#include "saf_externals.h"
+
+#ifdef _WIN32
+# include <windows.h>
+# include <process.h>
+typedef HANDLE             saf_thread_t;
+typedef CRITICAL_SECTION   saf_mutex_t;
+typedef CONDITION_VARIABLE saf_cond_t;
+# define SAF_MUTEX_INIT(m)     InitializeCriticalSection(m)
+# define SAF_MUTEX_DESTROY(m)  DeleteCriticalSection(m)
+# define SAF_MUTEX_LOCK(m)     EnterCriticalSection(m)
+# define SAF_MUTEX_UNLOCK(m)   LeaveCriticalSection(m)
+# define SAF_COND_INIT(c)      InitializeConditionVariable(c)
+# define SAF_COND_DESTROY(c)
+# define SAF_COND_WAIT(c,m)    SleepConditionVariableCS(c, m, INFINITE)
+# define SAF_COND_BROADCAST(c) WakeAllConditionVariable(c)
+# define SAF_COND_SIGNAL(c)    WakeConditionVariable(c)
+#else
+# include <pthread.h>
+typedef pthread_t          saf_thread_t;
+typedef pthread_mutex_t    saf_mutex_t;
+typedef pthread_cond_t     saf_cond_t;
+# define SAF_MUTEX_INIT(m)     pthread_mutex_init(m, NULL)
+# define SAF_MUTEX_DESTROY(m)  pthread_mutex_destroy(m)
+# define SAF_MUTEX_LOCK(m)     pthread_mutex_lock(m)
+# define SAF_MUTEX_UNLOCK(m)   pthread_mutex_unlock(m)
+# define SAF_COND_INIT(c)      pthread_cond_init(c, NULL)
+# define SAF_COND_DESTROY(c)   pthread_cond_destroy(c)
+# define SAF_COND_WAIT(c,m)    pthread_cond_wait(c, m)
+# define SAF_COND_BROADCAST(c) pthread_cond_broadcast(c)
+# define SAF_COND_SIGNAL(c)    pthread_cond_signal(c)
+#endif
+
+/* forward declaration */
+typedef struct _safThreadPool_data safThreadPool_data;
+
+/** Arguments passed to each worker thread */
+typedef struct _safThreadPool_worker {
+    safThreadPool_data* pool;
+    int workerIndex;
+
+}safThreadPool_worker;
+
+/**
+ * Data structure for the thread pool
+ */
+struct _safThreadPool_data {
+    int nThreads;
+    saf_thread_t threads[SAF_THREADPOOL_MAX_NUM_THREADS];
+    safThreadPool_worker workers[SAF_THREADPOOL_MAX_NUM_THREADS];
+    saf_mutex_t mutex;
+    saf_cond_t startCond;  /**< Signalled when a new job is posted */
+    saf_cond_t doneCond;   /**< Signalled when the last worker finishes */
+
+    /* Current job */
+    saf_threadPool_task task;
+    void* userData;
+    int nTasks;
+    unsigned int jobID;    /**< Incremented for every new job */
+    int nWorkersBusy;      /**< Number of worker threads yet to finish the job */
+    int quitFLAG;
+};
+
+/** Executes the tasks assigned to worker 'workerIndex' */
+static void saf_threadPool_runTasks
+(
+    saf_threadPool_task task,
+    void* userData,
+    int nTasks,
+    int nThreads,
+    int workerIndex
+)
+{
+    int i;
+    for(i=workerIndex; i<nTasks; i+=nThreads)
+        task(userData, i, workerIndex);
+}
+
+/** Main loop of each worker thread */
+#ifdef _WIN32
+static unsigned __stdcall saf_threadPool_workerMain(void* arg)
+#else
+static void* saf_threadPool_workerMain(void* arg)
+#endif
+{
+    safThreadPool_worker* w = (safThreadPool_worker*)arg;
+    safThreadPool_data* h = w->pool;
+    unsigned int lastJobID;
+    saf_threadPool_task task;
+    void* userData;
+    int nTasks;
+
+    /* Note: a job may already have been posted before this thread got the
+     * chance to run, so the job ID is compared against its initial value (0),
+     * rather than whatever it happens to be at this point */
+    lastJobID = 0;
+    SAF_MUTEX_LOCK(&(h->mutex));
+    for(;;){
+        /* Sleep until a new job is posted (or the pool is destroyed) */
+        while(h->jobID==lastJobID && !h->quitFLAG)
+            SAF_COND_WAIT(&(h->startCond), &(h->mutex));
+        if(h->quitFLAG)
+            break;
+        lastJobID = h->jobID;
+        task = h->task;
+        userData = h->userData;
+        nTasks = h->nTasks;
+        SAF_MUTEX_UNLOCK(&(h->mutex));
+
+        saf_threadPool_runTasks(task, userData, nTasks, h->nThreads, w->workerIndex);
+
+        /* Let the calling thread know once all workers are done */
+        SAF_MUTEX_LOCK(&(h->mutex));
+        h->nWorkersBusy--;
+        if(h->nWorkersBusy==0)
+            SAF_COND_SIGNAL(&(h->doneCond));
+    }
+    SAF_MUTEX_UNLOCK(&(h->mutex));
+    return 0;
+}
+
+void saf_threadPool_create
+(
+    void ** const phTP,
+    int nThreads
+)
+{
+    *phTP = malloc1d(sizeof(safThreadPool_data));
+    safThreadPool_data *h = (safThreadPool_data*)(*phTP);
+    int i;
+#ifndef _WIN32
+    int err;
+#endif
+
+    saf_assert(nThreads>=1 && nThreads<=SAF_THREADPOOL_MAX_NUM_THREADS, "Unsupported number of threads");
+    h->nThreads = nThreads;
+    h->task = NULL;
+    h->userData = NULL;
+    h->nTasks = 0;
+    h->jobID = 0;
+    h->nWorkersBusy = 0;
+    h->quitFLAG = 0;
+    SAF_MUTEX_INIT(&(h->mutex));
+    SAF_COND_INIT(&(h->startCond));
+    SAF_COND_INIT(&(h->doneCond));
+
+    /* Worker 0 is the calling thread of saf_threadPool_run() */
+    for(i=1; i<nThreads; i++){
+        h->workers[i].pool = h;
+        h->workers[i].workerIndex = i;
+#ifdef _WIN32
+        h->threads[i] = (HANDLE)_beginthreadex(NULL, 0, saf_threadPool_workerMain, &(h->workers[i]), 0, NULL);
+        if(h->threads[i]==0)
+            saf_print_error("Failed to create thread");
+#else
+        err = pthread_create(&(h->threads[i]), NULL, saf_threadPool_workerMain, &(h->workers[i]));
+        if(err!=0)
+            saf_print_error("Failed to create thread");
+#endif
+    }
+}
+
+void saf_threadPool_destroy
+(
+    void ** const phTP
+)
+{
+    safThreadPool_data *h = (safThreadPool_data*)(*phTP);
+    int i;
+
+    if(h!=NULL){
+        SAF_MUTEX_LOCK(&(h->mutex));
+        h->quitFLAG = 1;
+        SAF_COND_BROADCAST(&(h->startCond));
+        SAF_MUTEX_UNLOCK(&(h->mutex));
+        for(i=1; i<h->nThreads; i++){
+#ifdef _WIN32
+            WaitForSingleObject(h->threads[i], INFINITE);
+            CloseHandle(h->threads[i]);
+#else
+            pthread_join(h->threads[i], NULL);
+#endif
+        }
+        SAF_COND_DESTROY(&(h->startCond));
+        SAF_COND_DESTROY(&(h->doneCond));
+        SAF_MUTEX_DESTROY(&(h->mutex));
+        free(h);
+        h=NULL;
+        *phTP = NULL;
+    }
+}
+
+int saf_threadPool_getNumThreads
+(
+    void * const hTP
+)
+{
+    safThreadPool_data *h = (safThreadPool_data*)(hTP);
+    return h==NULL ? 1 : h->nThreads;
+}
+
+void saf_threadPool_run
+(
+    void * const hTP,
+    saf_threadPool_task task,
+    void* userData,
+    int nTasks
+)
+{
+    safThreadPool_data *h = (safThreadPool_data*)(hTP);
+
+    /* Run everything on the calling thread, if there are no worker threads to
+     * help out, or if there is only one task */
+    if(h==NULL || h->nThreads==1 || nTasks<=1){
+        saf_threadPool_runTasks(task, userData, nTasks, 1, 0);
+        return;
+    }
+
+    /* Post the job */
+    SAF_MUTEX_LOCK(&(h->mutex));
+    h->task = task;
+    h->userData = userData;
+    h->nTasks = nTasks;
+    h->nWorkersBusy = h->nThreads-1;
+    h->jobID++;
+    SAF_COND_BROADCAST(&(h->startCond));
+    SAF_MUTEX_UNLOCK(&(h->mutex));
+
+    /* The calling thread is worker 0 */
+    saf_threadPool_runTasks(task, userData, nTasks, h->nThreads, 0);
+
+    /* Wait for the worker threads to finish */
+    SAF_MUTEX_LOCK(&(h->mutex));
+    while(h->nWorkersBusy>0)
+        SAF_COND_WAIT(&(h->doneCond), &(h->mutex));
+    SAF_MUTEX_UNLOCK(&(h->mutex));
+}
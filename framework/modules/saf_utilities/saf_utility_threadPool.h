@@ -0,0 +1,117 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ *@addtogroup Utilities
+ *@{
+ * @file saf_utility_threadPool.h
+ * @brief A persistent pool of worker threads
+ *
+ * The pool is intended for spreading independent tasks (e.g. the output
+ * channels of a matrix convolver) over multiple CPU cores. The worker threads
+ * are created once, and then sleep until saf_threadPool_run() is called; no
+ * memory is allocated when running tasks.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#ifndef SAF_THREADPOOL_H_INCLUDED
+#define SAF_THREADPOOL_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** Maximum number of threads supported by the thread pool */
+#define SAF_THREADPOOL_MAX_NUM_THREADS ( 64 )
+
+/**
+ * A task to be executed by the thread pool
+ *
+ * @param[in] userData    Pointer passed to saf_threadPool_run()
+ * @param[in] taskIndex   Index of the task to execute; 0..nTasks-1
+ * @param[in] workerIndex Index of the thread executing the task;
+ *                        0..nThreads-1 (may be used to select per-thread
+ *                        scratch memory)
+ */
+typedef void (*saf_threadPool_task)(void* userData,
+                                    int taskIndex,
+                                    int workerIndex);
+
+/**
+ * Creates an instance of the thread pool
+ *
+ * @note The calling thread of saf_threadPool_run() also executes tasks (as
+ *       worker 0), therefore nThreads-1 worker threads are created. A pool with
+ *       nThreads=1 simply executes all tasks on the calling thread.
+ *
+ * @test test__saf_matrixConv_threaded()
+ *
+ * @param[in] phTP     (&) address of thread pool handle
+ * @param[in] nThreads Number of threads; 1..SAF_THREADPOOL_MAX_NUM_THREADS
+ */
+void saf_threadPool_create(/* Input Arguments */
+                           void ** const phTP,
+                           int nThreads);
+
+/**
+ * Destroys an instance of the thread pool (joining all worker threads)
+ *
+ * @param[in] phTP (&) address of thread pool handle
+ */
+void saf_threadPool_destroy(/* Input Arguments */
+                            void ** const phTP);
+
+/**
+ * Returns the number of threads of the thread pool (including the calling
+ * thread)
+ *
+ * @param[in] hTP thread pool handle (may be NULL, in which case 1 is returned)
+ */
+int saf_threadPool_getNumThreads(void * const hTP);
+
+/**
+ * Executes nTasks tasks over the threads of the pool, and returns once all
+ * tasks are complete
+ *
+ * Tasks are statically assigned to the threads (task 'i' is always executed
+ * by thread 'i % nThreads'), so the per-thread scratch memory used for any
+ * given task, and therefore the result, does not depend on thread scheduling.
+ *
+ * @note Only one thread may call this function at a time (per pool instance).
+ *
+ * @param[in] hTP      thread pool handle (may be NULL, in which case all tasks
+ *                     are executed on the calling thread)
+ * @param[in] task     Task function
+ * @param[in] userData Pointer passed on to the task function
+ * @param[in] nTasks   Number of tasks to execute
+ */
+void saf_threadPool_run(/* Input Arguments */
+                        void * const hTP,
+                        saf_threadPool_task task,
+                        void* userData,
+                        int nTasks);
+
+
+#ifdef __cplusplus
+}/* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* SAF_THREADPOOL_H_INCLUDED */
+
+/**@} */ /* doxygen addtogroup Utilities */
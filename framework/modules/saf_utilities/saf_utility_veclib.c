@@ -47,6 +47,7 @@
 
 #include "saf_utilities.h"
 #include "saf_externals.h"
+#include "saf_utility_veclib_simd.h"
 
 /* Specify which LAPACK interface should be used: */
 #if defined(SAF_USE_INTEL_MKL_LP64)
@@ -531,22 +532,7 @@ void utility_svrecip
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmsInv(len, a, c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len-15); i+=16)
-        _mm512_storeu_ps(c+i, _mm512_rcp14_ps(_mm512_loadu_ps(a+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len-7); i+=8)
-        _mm256_storeu_ps(c+i, _mm256_rcp_ps(_mm256_loadu_ps(a+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len-3); i+=4)
-        _mm_storeu_ps(c+i, _mm_rcp_ps(_mm_loadu_ps(a+i)));
-# endif
-    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
-        c[i] = 1.0f/a[i];
+    saf_veclib_simd()->svrecip(a, len, c);
 #else
     int i;
     for(i=0; i<len; i++)
@@ -661,22 +647,7 @@ void utility_svvadd
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmsAdd(len, a, b, c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len-15); i+=16)
-        _mm512_storeu_ps(c+i, _mm512_add_ps(_mm512_loadu_ps(a+i), _mm512_loadu_ps(b+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len-7); i+=8)
-        _mm256_storeu_ps(c+i, _mm256_add_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len-3); i+=4)
-        _mm_storeu_ps(c+i, _mm_add_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
-# endif
-    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
-        c[i] = a[i] + b[i];
+    saf_veclib_simd()->svvadd(a, b, len, c);
 #elif defined(NDEBUG)
     int i;
     /* try to indirectly "trigger" some compiler optimisations */
@@ -717,25 +688,7 @@ void utility_cvvadd
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmcAdd(len, (MKL_Complex8*)a, (MKL_Complex8*)b, (MKL_Complex8*)c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i, len2;
-    float* sa, *sb, *sc;
-    len2 = len*2;
-    sa = (float*)a; sb = (float*)b; sc = (float*)c;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len2-15); i+=16)
-        _mm512_storeu_ps(sc+i, _mm512_add_ps(_mm512_loadu_ps(sa+i), _mm512_loadu_ps(sb+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len2-7); i+=8)
-        _mm256_storeu_ps(sc+i, _mm256_add_ps(_mm256_loadu_ps(sa+i), _mm256_loadu_ps(sb+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len2-3); i+=4)
-        _mm_storeu_ps(sc+i, _mm_add_ps(_mm_loadu_ps(sa+i), _mm_loadu_ps(sb+i)));
-# endif
-    for(; i<len2; i++) /* The residual (if len2 was not divisable by the step size): */
-        sc[i] = sa[i] + sb[i];
+    saf_veclib_simd()->svvadd((const float*)a, (const float*)b, /*re+im*/2*len, (float*)c);
 #elif __STDC_VERSION__ >= 199901L && defined(NDEBUG)
     int i;
     /* try to indirectly "trigger" some compiler optimisations */
@@ -776,22 +729,7 @@ void utility_dvvadd
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmdAdd(len, a, b, c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len-7); i+=8)
-        _mm512_storeu_pd(c+i, _mm512_add_pd(_mm512_loadu_pd(a+i), _mm512_loadu_pd(b+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len-3); i+=4)
-        _mm256_storeu_pd(c+i, _mm256_add_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len-1); i+=2)
-        _mm_storeu_pd(c+i, _mm_add_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i)));
-# endif
-    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
-        c[i] = a[i] + b[i];
+    saf_veclib_simd()->dvvadd(a, b, len, c);
 #else
     int j;
     for (j = 0; j < len; j++)
@@ -821,25 +759,7 @@ void utility_zvvadd
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmzAdd(len, (MKL_Complex16*)a, (MKL_Complex16*)b, (MKL_Complex16*)c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i, len2;
-    double* sa, *sb, *sc;
-    len2 = len*2;
-    sa = (double*)a; sb = (double*)b; sc = (double*)c;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len2-7); i+=8)
-        _mm512_storeu_pd(sc+i, _mm512_add_pd(_mm512_loadu_pd(sa+i), _mm512_loadu_pd(sb+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len2-3); i+=4)
-        _mm256_storeu_pd(sc+i, _mm256_add_pd(_mm256_loadu_pd(sa+i), _mm256_loadu_pd(sb+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len2-1); i+=2)
-        _mm_storeu_pd(sc+i, _mm_add_pd(_mm_loadu_pd(sa+i), _mm_loadu_pd(sb+i)));
-# endif
-    for(; i<len2; i++) /* The residual (if len2 was not divisable by the step size): */
-        sc[i] = sa[i] + sb[i];
+    saf_veclib_simd()->dvvadd((const double*)a, (const double*)b, /*re+im*/2*len, (double*)c);
 #else
     int j;
     for (j = 0; j < len; j++)
@@ -874,22 +794,7 @@ void utility_svvsub
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmsSub(len, a, b, c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len-15); i+=16)
-        _mm512_storeu_ps(c+i, _mm512_sub_ps(_mm512_loadu_ps(a+i), _mm512_loadu_ps(b+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len-7); i+=8)
-        _mm256_storeu_ps(c+i, _mm256_sub_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len-3); i+=4)
-        _mm_storeu_ps(c+i, _mm_sub_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
-# endif
-    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
-        c[i] = a[i] - b[i];
+    saf_veclib_simd()->svvsub(a, b, len, c);
 #elif defined(NDEBUG)
     int i;
     /* try to indirectly "trigger" some compiler optimisations */
@@ -930,25 +835,7 @@ void utility_cvvsub
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmcSub(len, (MKL_Complex8*)a, (MKL_Complex8*)b, (MKL_Complex8*)c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i, len2;
-    float* sa, *sb, *sc;
-    len2 = len*2;
-    sa = (float*)a; sb = (float*)b; sc = (float*)c;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len2-15); i+=16)
-        _mm512_storeu_ps(sc+i, _mm512_sub_ps(_mm512_loadu_ps(sa+i), _mm512_loadu_ps(sb+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len2-7); i+=8)
-        _mm256_storeu_ps(sc+i, _mm256_sub_ps(_mm256_loadu_ps(sa+i), _mm256_loadu_ps(sb+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len2-3); i+=4)
-        _mm_storeu_ps(sc+i, _mm_sub_ps(_mm_loadu_ps(sa+i), _mm_loadu_ps(sb+i)));
-# endif
-    for(; i<len2; i++) /* The residual (if len2 was not divisable by the step size): */
-        sc[i] = sa[i] - sb[i];
+    saf_veclib_simd()->svvsub((const float*)a, (const float*)b, /*re+im*/2*len, (float*)c);
 #elif __STDC_VERSION__ >= 199901L && defined(NDEBUG)
     int i;
     /* try to indirectly "trigger" some compiler optimisations */
@@ -989,22 +876,7 @@ void utility_dvvsub
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmdSub(len, a, b, c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len-7); i+=8)
-        _mm512_storeu_pd(c+i, _mm512_sub_pd(_mm512_loadu_pd(a+i), _mm512_loadu_pd(b+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len-3); i+=4)
-        _mm256_storeu_pd(c+i, _mm256_sub_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len-1); i+=2)
-        _mm_storeu_pd(c+i, _mm_sub_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i)));
-# endif
-    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
-        c[i] = a[i] - b[i];
+    saf_veclib_simd()->dvvsub(a, b, len, c);
 #else
     int j;
     for (j = 0; j < len; j++)
@@ -1034,25 +906,7 @@ void utility_zvvsub
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmzSub(len, (MKL_Complex16*)a, (MKL_Complex16*)b, (MKL_Complex16*)c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i, len2;
-    double* sa, *sb, *sc;
-    len2 = len*2;
-    sa = (double*)a; sb = (double*)b; sc = (double*)c;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len2-7); i+=8)
-        _mm512_storeu_pd(sc+i, _mm512_sub_pd(_mm512_loadu_pd(sa+i), _mm512_loadu_pd(sb+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len2-3); i+=4)
-        _mm256_storeu_pd(sc+i, _mm256_sub_pd(_mm256_loadu_pd(sa+i), _mm256_loadu_pd(sb+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len2-1); i+=2)
-        _mm_storeu_pd(sc+i, _mm_sub_pd(_mm_loadu_pd(sa+i), _mm_loadu_pd(sb+i)));
-# endif
-    for(;i<len2; i++) /* The residual (if len2 was not divisable by the step size): */
-        sc[i] = sa[i] - sb[i];
+    saf_veclib_simd()->dvvsub((const double*)a, (const double*)b, /*re+im*/2*len, (double*)c);
 #else
     int j;
     for (j = 0; j < len; j++)
@@ -1087,22 +941,7 @@ void utility_svvmul
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmsMul(len, a, b, c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-    i = 0;
-# if defined(__AVX512F__)
-    for(; i<(len-15); i+=16)
-        _mm512_storeu_ps(c+i, _mm512_mul_ps(_mm512_loadu_ps(a+i), _mm512_loadu_ps(b+i)));
-# endif
-# if defined(__AVX__) && defined(__AVX2__)
-    for(; i<(len-7); i+=8)
-        _mm256_storeu_ps(c+i, _mm256_mul_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
-# endif
-# if defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(; i<(len-3); i+=4)
-        _mm_storeu_ps(c+i, _mm_mul_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
-# endif
-    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
-        c[i] = a[i] * b[i];
+    saf_veclib_simd()->svvmul(a, b, len, c);
 #elif defined(NDEBUG)
     int i;
     /* try to indirectly "trigger" some compiler optimisations */
@@ -1148,49 +987,7 @@ void utility_cvvmul
 #elif defined(SAF_USE_INTEL_MKL_LP64) || defined(SAF_USE_INTEL_MKL_ILP64)
     vmcMul(len, (MKL_Complex8*)a, (MKL_Complex8*)b, (MKL_Complex8*)c, SAF_INTEL_MKL_VML_MODE);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-    float* sa, *sb, *sc;
-    sa = (float*)a; sb = (float*)b; sc = (float*)c;
-# if (defined(__AVX__) && defined(__AVX2__)) || defined(__AVX512F__) /* I couldn't figure out an alternative for addsub with AVX-512... */
-    __m256i permute_ri = _mm256_set_epi32(6, 7, 4, 5, 2, 3, 0, 1);
-    for(i=0; i<(len-3); i+=4){
-        /* Load only the real parts of a */
-        __m256 src1 = _mm256_moveldup_ps(_mm256_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|a3|b3|a4|b4|*/); /*|a1|a1|a2|a2|a3|a3|a4|a4|*/
-        /* Load real+imag parts of b */
-        __m256 src2 = _mm256_loadu_ps(sb+2*i); /*|c1|d1|c2|d2|c3|d3|c4|d4|*/
-        /* Multiply together */
-        __m256 tmp1 = _mm256_mul_ps(src1, src2);
-        /* Swap the real+imag parts of b to be imag+real instead: */
-        __m256 b1 = _mm256_permutevar8x32_ps(src2, permute_ri);
-        /* Load only the imag parts of a */
-        src1 = _mm256_movehdup_ps(_mm256_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|a3|b3|a4|b4|*/); /*|b1|b1|b2|b2|b3|b3|b4|b4|*/
-        /* Multiply together */
-        __m256 tmp2 = _mm256_mul_ps(src1, b1);
-        /* Add even indices, subtract odd indices */
-        _mm256_storeu_ps(sc+2*i, _mm256_addsub_ps(tmp1, tmp2));
-    }
-# elif defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    for(i=0; i<(len-1); i+=2){
-        /* Load only the real parts of a */
-        __m128 src1 = _mm_moveldup_ps(_mm_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|*/); /*|a1|a1|a2|a2|*/
-        /* Load real+imag parts of b */
-        __m128 src2 = _mm_loadu_ps(sb+2*i); /*|c1|d1|c2|d2|*/
-        /* Multiply together */
-        __m128 tmp1 = _mm_mul_ps(src1, src2);
-        /* Swap the real+imag parts of b to be imag+real instead: */
-        __m128 b1 = _mm_shuffle_ps(src2, src2, _MM_SHUFFLE(2, 3, 0, 1));
-        /* Load only the imag parts of a */
-        src1 = _mm_movehdup_ps(_mm_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|*/); /*|b1|b1|b2|b2|*/
-        /* Multiply together */
-        __m128 tmp2 = _mm_mul_ps(src1, b1);
-        /* Add even indices, subtract odd indices */
-        _mm_storeu_ps(sc+2*i, _mm_addsub_ps(tmp1, tmp2));
-    }
-# endif
-    for(;i<len; i++){ /* The residual (if len was not divisable by the step size): */
-        sc[2*i]   = sa[2*i] * sb[2*i]   - sa[2*i+1] * sb[2*i+1];
-        sc[2*i+1] = sa[2*i] * sb[2*i+1] + sa[2*i+1] * sb[2*i];
-    }
+    saf_veclib_simd()->cvvmul(a, b, len, c);
 #elif __STDC_VERSION__ >= 199901L && defined(NDEBUG)
     int i;
     /* try to indirectly "trigger" some compiler optimisations */
@@ -1387,22 +1184,7 @@ void utility_svsadd
 #elif defined(SAF_USE_APPLE_ACCELERATE)
     vDSP_vsadd(a, 1, s, c, 1, (vDSP_Length)len);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-# if defined(__AVX512F__)
-    __m512 s16 = _mm512_set1_ps(s[0]);
-    for(i=0; i<(len-15); i+=16)
-        _mm512_storeu_ps(c+i, _mm512_add_ps(_mm512_loadu_ps(a+i), s16));
-# elif defined(__AVX__) && defined(__AVX2__)
-    __m256 s8 = _mm256_set1_ps(s[0]);
-    for(i=0; i<(len-7); i+=8)
-        _mm256_storeu_ps(c+i, _mm256_add_ps(_mm256_loadu_ps(a+i), s8));
-# elif defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    __m128 s4 = _mm_load_ps1(s);
-    for(i=0; i<(len-3); i+=4)
-        _mm_storeu_ps(c+i, _mm_add_ps(_mm_loadu_ps(a+i), s4));
-# endif
-    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
-        c[i] = a[i] + s[0];
+    saf_veclib_simd()->svsadd(a, s[0], len, c);
 #else
     int i;
     for(i=0; i<len; i++)
@@ -1430,22 +1212,7 @@ void utility_svssub
     inv_s = -s[0];
     vDSP_vsadd(a, 1, &inv_s, c, 1, (vDSP_Length)len);
 #elif defined(SAF_ENABLE_SIMD)
-    int i;
-# if defined(__AVX512F__)
-    __m512 s16 = _mm512_set1_ps(s[0]);
-    for(i=0; i<(len-15); i+=16)
-        _mm512_storeu_ps(c+i, _mm512_sub_ps(_mm512_loadu_ps(a+i), s16));
-# elif defined(__AVX__) && defined(__AVX2__)
-    __m256 s8 = _mm256_set1_ps(s[0]);
-    for(i=0; i<(len-7); i+=8)
-        _mm256_storeu_ps(c+i, _mm256_sub_ps(_mm256_loadu_ps(a+i), s8));
-# elif defined(__SSE__) && defined(__SSE2__) && defined(__SSE3__)
-    __m128 s4 = _mm_load_ps1(s);
-    for(i=0; i<(len-3); i+=4)
-        _mm_storeu_ps(c+i, _mm_sub_ps(_mm_loadu_ps(a+i), s4));
-# endif
-    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
-        c[i] = a[i] - s[0];
+    saf_veclib_simd()->svssub(a, s[0], len, c);
 #else
     int i;
     for(i=0; i<len; i++)
@@ -57,6 +57,59 @@ typedef enum {
  * v -> vector
  * m -> matrix */
 
+/**
+ * SIMD instruction sets that may be employed by the saf_utility_veclib
+ * functions (only applicable if SAF_ENABLE_SIMD is defined, and only for the
+ * functions that are not provided by the employed performance library)
+ */
+typedef enum {
+    SAF_SIMD_NONE = 0, /**< Plain C implementations */
+    SAF_SIMD_SSE3,     /**< SSE, SSE2 and SSE3 intrinsics */
+    SAF_SIMD_AVX2,     /**< AVX and AVX2 intrinsics */
+    SAF_SIMD_AVX512F   /**< AVX-512F intrinsics */
+}SAF_SIMD_LEVELS;
+
+
+/* ========================================================================== */
+/*                       SIMD Run-time Dispatch Control                       */
+/* ========================================================================== */
+
+/**
+ * Returns the SIMD instruction set currently employed by the saf_utility_veclib
+ * functions
+ *
+ * If SAF_ENABLE_SIMD is defined, then the kernels for each instruction set are
+ * compiled in separate translation units, and the highest level supported by
+ * the host CPU (as reported by cpuid) is selected upon first use. Therefore, a
+ * single binary may be distributed to machines with differing CPU features.
+ * If SAF_ENABLE_SIMD is not defined, then SAF_SIMD_NONE is always returned.
+ *
+ * @test test__utility_simdDispatch()
+ */
+SAF_SIMD_LEVELS utility_getSIMDLevel(void);
+
+/**
+ * Returns the highest SIMD instruction set that is supported by both the host
+ * CPU and the build configuration
+ */
+SAF_SIMD_LEVELS utility_getMaxSIMDLevel(void);
+
+/**
+ * Forces the SIMD instruction set to be employed by the saf_utility_veclib
+ * functions (e.g. for benchmarking purposes)
+ *
+ * @note The requested level is clamped to utility_getMaxSIMDLevel(). This
+ *       function must not be called while any processing is running (on any
+ *       thread), since the kernels would then be swapped part-way through,
+ *       e.g., a hop of audio. The level selected upon first use is otherwise
+ *       safe to query from any thread.
+ *
+ * @param[in] level Requested SIMD instruction set, see #SAF_SIMD_LEVELS
+ * @returns The SIMD instruction set that was actually selected
+ */
+SAF_SIMD_LEVELS utility_setSIMDLevel(SAF_SIMD_LEVELS level);
+
+
 /* ========================================================================== */
 /*                     Built-in CBLAS Functions (Level 0)                     */
 /* ========================================================================== */
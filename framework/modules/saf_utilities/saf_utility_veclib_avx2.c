@@ -0,0 +1,205 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_veclib_avx2.c
+ * @ingroup Utilities
+ * @brief AVX and AVX2 kernels for saf_utility_veclib (and the built-in FFT)
+ *
+ * @note This file must be compiled with AVX2 support (e.g. '-mavx2' or
+ *       '/arch:AVX2'), otherwise saf_veclib_getKernels_avx2() returns NULL.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include "saf_utility_veclib_simd.h"
+
+#if defined(SAF_ENABLE_SIMD) && defined(__AVX__) && defined(__AVX2__)
+
+static void svvadd_avx2(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_add_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
+    for(; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_add_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + b[i];
+}
+
+static void svvsub_avx2(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_sub_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
+    for(; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_sub_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - b[i];
+}
+
+static void svvmul_avx2(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_mul_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
+    for(; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_mul_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] * b[i];
+}
+
+static void dvvadd_avx2(const double* a, const double* b, const int len, double* c)
+{
+    int i;
+    for(i=0; i<(len-3); i+=4)
+        _mm256_storeu_pd(c+i, _mm256_add_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i)));
+    for(; i<(len-1); i+=2)
+        _mm_storeu_pd(c+i, _mm_add_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + b[i];
+}
+
+static void dvvsub_avx2(const double* a, const double* b, const int len, double* c)
+{
+    int i;
+    for(i=0; i<(len-3); i+=4)
+        _mm256_storeu_pd(c+i, _mm256_sub_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i)));
+    for(; i<(len-1); i+=2)
+        _mm_storeu_pd(c+i, _mm_sub_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - b[i];
+}
+
+static void cvvmul_avx2(const float_complex* a, const float_complex* b, const int len, float_complex* c)
+{
+    int i;
+    float* sa, *sb, *sc;
+    sa = (float*)a; sb = (float*)b; sc = (float*)c;
+    __m256i permute_ri = _mm256_set_epi32(6, 7, 4, 5, 2, 3, 0, 1);
+    for(i=0; i<(len-3); i+=4){
+        /* Load only the real parts of a */
+        __m256 src1 = _mm256_moveldup_ps(_mm256_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|a3|b3|a4|b4|*/); /*|a1|a1|a2|a2|a3|a3|a4|a4|*/
+        /* Load real+imag parts of b */
+        __m256 src2 = _mm256_loadu_ps(sb+2*i); /*|c1|d1|c2|d2|c3|d3|c4|d4|*/
+        /* Multiply together */
+        __m256 tmp1 = _mm256_mul_ps(src1, src2);
+        /* Swap the real+imag parts of b to be imag+real instead: */
+        __m256 b1 = _mm256_permutevar8x32_ps(src2, permute_ri);
+        /* Load only the imag parts of a */
+        src1 = _mm256_movehdup_ps(_mm256_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|a3|b3|a4|b4|*/); /*|b1|b1|b2|b2|b3|b3|b4|b4|*/
+        /* Multiply together */
+        __m256 tmp2 = _mm256_mul_ps(src1, b1);
+        /* Add even indices, subtract odd indices */
+        _mm256_storeu_ps(sc+2*i, _mm256_addsub_ps(tmp1, tmp2));
+    }
+    for(;i<len; i++){ /* The residual (if len was not divisable by the step size): */
+        sc[2*i]   = sa[2*i] * sb[2*i]   - sa[2*i+1] * sb[2*i+1];
+        sc[2*i+1] = sa[2*i] * sb[2*i+1] + sa[2*i+1] * sb[2*i];
+    }
+}
+
+static void svrecip_avx2(const float* a, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_rcp_ps(_mm256_loadu_ps(a+i)));
+    for(; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_rcp_ps(_mm_loadu_ps(a+i)));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = 1.0f/a[i];
+}
+
+static void svsadd_avx2(const float* a, const float s, const int len, float* c)
+{
+    int i;
+    __m256 s8 = _mm256_set1_ps(s);
+    for(i=0; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_add_ps(_mm256_loadu_ps(a+i), s8));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + s;
+}
+
+static void svssub_avx2(const float* a, const float s, const int len, float* c)
+{
+    int i;
+    __m256 s8 = _mm256_set1_ps(s);
+    for(i=0; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_sub_ps(_mm256_loadu_ps(a+i), s8));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - s;
+}
+
+/**
+ * One radix-4 stage of the built-in FFT, vectorised over the stride (q), with
+ * 8 values per register; the other stages (s<8) employ the baseline stage
+ */
+static void fftRadix4Stage_avx2(int n, int s, const float* tw, const float* xr, const float* xi, float* yr, float* yi)
+{
+    int p, q, m, i0, i1, i2, i3, o0;
+    if(s<8){
+        saf_fftBuiltin_radix4Stage(n, s, tw, xr, xi, yr, yi);
+        return;
+    }
+    m = n/4;
+    for(p=0; p<m; p++){
+        i0 = s*p;
+        i1 = s*(p+m);
+        i2 = s*(p+2*m);
+        i3 = s*(p+3*m);
+        o0 = s*4*p;
+        __m256 w1r = _mm256_set1_ps(tw[p]),     w1i = _mm256_set1_ps(tw[m+p]);
+        __m256 w2r = _mm256_set1_ps(tw[2*m+p]), w2i = _mm256_set1_ps(tw[3*m+p]);
+        __m256 w3r = _mm256_set1_ps(tw[4*m+p]), w3i = _mm256_set1_ps(tw[5*m+p]);
+        for(q=0; q<s; q+=8){
+            __m256 ar = _mm256_loadu_ps(xr+i0+q), ai = _mm256_loadu_ps(xi+i0+q);
+            __m256 br = _mm256_loadu_ps(xr+i1+q), bi = _mm256_loadu_ps(xi+i1+q);
+            __m256 cr = _mm256_loadu_ps(xr+i2+q), ci = _mm256_loadu_ps(xi+i2+q);
+            __m256 dr = _mm256_loadu_ps(xr+i3+q), di = _mm256_loadu_ps(xi+i3+q);
+            __m256 y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+            SAF_FFT_RADIX4_BUTTERFLY(__m256, _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps)
+            _mm256_storeu_ps(yr+o0+q, y0r);     _mm256_storeu_ps(yi+o0+q, y0i);
+            _mm256_storeu_ps(yr+o0+s+q, y1r);   _mm256_storeu_ps(yi+o0+s+q, y1i);
+            _mm256_storeu_ps(yr+o0+2*s+q, y2r); _mm256_storeu_ps(yi+o0+2*s+q, y2i);
+            _mm256_storeu_ps(yr+o0+3*s+q, y3r); _mm256_storeu_ps(yi+o0+3*s+q, y3i);
+        }
+    }
+}
+
+static const saf_veclib_simd_kernels saf_veclib_kernels_avx2 = {
+    svvadd_avx2, svvsub_avx2, svvmul_avx2,
+    dvvadd_avx2, dvvsub_avx2,
+    cvvmul_avx2,
+    svrecip_avx2,
+    svsadd_avx2, svssub_avx2,
+    fftRadix4Stage_avx2
+};
+
+const saf_veclib_simd_kernels* saf_veclib_getKernels_avx2(void)
+{
+    return &saf_veclib_kernels_avx2;
+}
+
+#else
+
+const saf_veclib_simd_kernels* saf_veclib_getKernels_avx2(void)
+{
+    return NULL;
+}
+
+#endif /* SAF_ENABLE_SIMD && __AVX2__ */
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_veclib_avx512.c
+ * @ingroup Utilities
+ * @brief AVX-512F kernels for saf_utility_veclib (and the built-in FFT)
+ *
+ * @note This file must be compiled with AVX-512F and AVX2 support (e.g.
+ *       '-mavx512f -mavx2' or '/arch:AVX512'), otherwise
+ *       saf_veclib_getKernels_avx512() returns NULL.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include "saf_utility_veclib_simd.h"
+
+#if defined(SAF_ENABLE_SIMD) && defined(__AVX512F__) && defined(__AVX2__)
+
+static void svvadd_avx512(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-15); i+=16)
+        _mm512_storeu_ps(c+i, _mm512_add_ps(_mm512_loadu_ps(a+i), _mm512_loadu_ps(b+i)));
+    for(; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_add_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
+    for(; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_add_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + b[i];
+}
+
+static void svvsub_avx512(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-15); i+=16)
+        _mm512_storeu_ps(c+i, _mm512_sub_ps(_mm512_loadu_ps(a+i), _mm512_loadu_ps(b+i)));
+    for(; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_sub_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
+    for(; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_sub_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - b[i];
+}
+
+static void svvmul_avx512(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-15); i+=16)
+        _mm512_storeu_ps(c+i, _mm512_mul_ps(_mm512_loadu_ps(a+i), _mm512_loadu_ps(b+i)));
+    for(; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_mul_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
+    for(; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_mul_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] * b[i];
+}
+
+static void dvvadd_avx512(const double* a, const double* b, const int len, double* c)
+{
+    int i;
+    for(i=0; i<(len-7); i+=8)
+        _mm512_storeu_pd(c+i, _mm512_add_pd(_mm512_loadu_pd(a+i), _mm512_loadu_pd(b+i)));
+    for(; i<(len-3); i+=4)
+        _mm256_storeu_pd(c+i, _mm256_add_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i)));
+    for(; i<(len-1); i+=2)
+        _mm_storeu_pd(c+i, _mm_add_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + b[i];
+}
+
+static void dvvsub_avx512(const double* a, const double* b, const int len, double* c)
+{
+    int i;
+    for(i=0; i<(len-7); i+=8)
+        _mm512_storeu_pd(c+i, _mm512_sub_pd(_mm512_loadu_pd(a+i), _mm512_loadu_pd(b+i)));
+    for(; i<(len-3); i+=4)
+        _mm256_storeu_pd(c+i, _mm256_sub_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i)));
+    for(; i<(len-1); i+=2)
+        _mm_storeu_pd(c+i, _mm_sub_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - b[i];
+}
+
+static void cvvmul_avx512(const float_complex* a, const float_complex* b, const int len, float_complex* c)
+{
+    int i;
+    float* sa, *sb, *sc;
+    sa = (float*)a; sb = (float*)b; sc = (float*)c;
+    for(i=0; i<(len-7); i+=8){
+        /* Load only the real parts of a */
+        __m512 src1 = _mm512_moveldup_ps(_mm512_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|...*/); /*|a1|a1|a2|a2|...*/
+        /* Load real+imag parts of b */
+        __m512 src2 = _mm512_loadu_ps(sb+2*i); /*|c1|d1|c2|d2|...*/
+        /* Swap the real+imag parts of b to be imag+real instead: */
+        __m512 b1 = _mm512_permute_ps(src2, _MM_SHUFFLE(2, 3, 0, 1));
+        /* Load only the imag parts of a, and multiply with the swapped b */
+        __m512 tmp2 = _mm512_mul_ps(_mm512_movehdup_ps(_mm512_loadu_ps(sa+2*i))/*|b1|b1|b2|b2|...*/, b1);
+        /* Multiply the real parts of a with b, then subtract tmp2 from even indices, and add tmp2 to odd indices
+         * (there is no addsub for AVX-512, but there is a fused multiply-addsub) */
+        _mm512_storeu_ps(sc+2*i, _mm512_fmaddsub_ps(src1, src2, tmp2));
+    }
+    for(;i<len; i++){ /* The residual (if len was not divisable by the step size): */
+        sc[2*i]   = sa[2*i] * sb[2*i]   - sa[2*i+1] * sb[2*i+1];
+        sc[2*i+1] = sa[2*i] * sb[2*i+1] + sa[2*i+1] * sb[2*i];
+    }
+}
+
+static void svrecip_avx512(const float* a, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-15); i+=16)
+        _mm512_storeu_ps(c+i, _mm512_rcp14_ps(_mm512_loadu_ps(a+i)));
+    for(; i<(len-7); i+=8)
+        _mm256_storeu_ps(c+i, _mm256_rcp_ps(_mm256_loadu_ps(a+i)));
+    for(; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_rcp_ps(_mm_loadu_ps(a+i)));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = 1.0f/a[i];
+}
+
+static void svsadd_avx512(const float* a, const float s, const int len, float* c)
+{
+    int i;
+    __m512 s16 = _mm512_set1_ps(s);
+    for(i=0; i<(len-15); i+=16)
+        _mm512_storeu_ps(c+i, _mm512_add_ps(_mm512_loadu_ps(a+i), s16));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + s;
+}
+
+static void svssub_avx512(const float* a, const float s, const int len, float* c)
+{
+    int i;
+    __m512 s16 = _mm512_set1_ps(s);
+    for(i=0; i<(len-15); i+=16)
+        _mm512_storeu_ps(c+i, _mm512_sub_ps(_mm512_loadu_ps(a+i), s16));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - s;
+}
+
+/**
+ * One radix-4 stage of the built-in FFT, vectorised over the stride (q), with
+ * 16 values per register; the other stages (s<16) employ the baseline stage
+ */
+static void fftRadix4Stage_avx512(int n, int s, const float* tw, const float* xr, const float* xi, float* yr, float* yi)
+{
+    int p, q, m, i0, i1, i2, i3, o0;
+    if(s<16){
+        saf_fftBuiltin_radix4Stage(n, s, tw, xr, xi, yr, yi);
+        return;
+    }
+    m = n/4;
+    for(p=0; p<m; p++){
+        i0 = s*p;
+        i1 = s*(p+m);
+        i2 = s*(p+2*m);
+        i3 = s*(p+3*m);
+        o0 = s*4*p;
+        __m512 w1r = _mm512_set1_ps(tw[p]),     w1i = _mm512_set1_ps(tw[m+p]);
+        __m512 w2r = _mm512_set1_ps(tw[2*m+p]), w2i = _mm512_set1_ps(tw[3*m+p]);
+        __m512 w3r = _mm512_set1_ps(tw[4*m+p]), w3i = _mm512_set1_ps(tw[5*m+p]);
+        for(q=0; q<s; q+=16){
+            __m512 ar = _mm512_loadu_ps(xr+i0+q), ai = _mm512_loadu_ps(xi+i0+q);
+            __m512 br = _mm512_loadu_ps(xr+i1+q), bi = _mm512_loadu_ps(xi+i1+q);
+            __m512 cr = _mm512_loadu_ps(xr+i2+q), ci = _mm512_loadu_ps(xi+i2+q);
+            __m512 dr = _mm512_loadu_ps(xr+i3+q), di = _mm512_loadu_ps(xi+i3+q);
+            __m512 y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+            SAF_FFT_RADIX4_BUTTERFLY(__m512, _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps)
+            _mm512_storeu_ps(yr+o0+q, y0r);     _mm512_storeu_ps(yi+o0+q, y0i);
+            _mm512_storeu_ps(yr+o0+s+q, y1r);   _mm512_storeu_ps(yi+o0+s+q, y1i);
+            _mm512_storeu_ps(yr+o0+2*s+q, y2r); _mm512_storeu_ps(yi+o0+2*s+q, y2i);
+            _mm512_storeu_ps(yr+o0+3*s+q, y3r); _mm512_storeu_ps(yi+o0+3*s+q, y3i);
+        }
+    }
+}
+
+static const saf_veclib_simd_kernels saf_veclib_kernels_avx512 = {
+    svvadd_avx512, svvsub_avx512, svvmul_avx512,
+    dvvadd_avx512, dvvsub_avx512,
+    cvvmul_avx512,
+    svrecip_avx512,
+    svsadd_avx512, svssub_avx512,
+    fftRadix4Stage_avx512
+};
+
+const saf_veclib_simd_kernels* saf_veclib_getKernels_avx512(void)
+{
+    return &saf_veclib_kernels_avx512;
+}
+
+#else
+
+const saf_veclib_simd_kernels* saf_veclib_getKernels_avx512(void)
+{
+    return NULL;
+}
+
+#endif /* SAF_ENABLE_SIMD && __AVX512F__ */
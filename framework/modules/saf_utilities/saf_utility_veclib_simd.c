@@ -0,0 +1,257 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_veclib_simd.c
+ * @ingroup Utilities
+ * @brief Run-time (cpuid based) selection of the SIMD kernels employed by
+ *        saf_utility_veclib
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include "saf_utility_veclib_simd.h"
+
+#if defined(SAF_ENABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+# define SAF_VECLIB_SIMD_X86 /**< cpuid is available */
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# else
+#  include <cpuid.h>
+# endif
+#endif
+
+
+/* ========================================================================== */
+/*                               Scalar Kernels                               */
+/* ========================================================================== */
+
+static void svvadd_scalar(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] + b[i];
+}
+
+static void svvsub_scalar(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] - b[i];
+}
+
+static void svvmul_scalar(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] * b[i];
+}
+
+static void dvvadd_scalar(const double* a, const double* b, const int len, double* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] + b[i];
+}
+
+static void dvvsub_scalar(const double* a, const double* b, const int len, double* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] - b[i];
+}
+
+static void cvvmul_scalar(const float_complex* a, const float_complex* b, const int len, float_complex* c)
+{
+    int i;
+    float* sa, *sb, *sc;
+    sa = (float*)a; sb = (float*)b; sc = (float*)c;
+    for(i=0; i<len; i++){
+        sc[2*i]   = sa[2*i] * sb[2*i]   - sa[2*i+1] * sb[2*i+1];
+        sc[2*i+1] = sa[2*i] * sb[2*i+1] + sa[2*i+1] * sb[2*i];
+    }
+}
+
+static void svrecip_scalar(const float* a, const int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = 1.0f/a[i];
+}
+
+static void svsadd_scalar(const float* a, const float s, const int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] + s;
+}
+
+static void svssub_scalar(const float* a, const float s, const int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] - s;
+}
+
+static const saf_veclib_simd_kernels saf_veclib_kernels_scalar = {
+    svvadd_scalar, svvsub_scalar, svvmul_scalar,
+    dvvadd_scalar, dvvsub_scalar,
+    cvvmul_scalar,
+    svrecip_scalar,
+    svsadd_scalar, svssub_scalar,
+    saf_fftBuiltin_radix4Stage
+};
+
+const saf_veclib_simd_kernels* saf_veclib_getKernels_scalar(void)
+{
+    return &saf_veclib_kernels_scalar;
+}
+
+
+/* ========================================================================== */
+/*                               CPU Detection                                */
+/* ========================================================================== */
+
+#ifdef SAF_VECLIB_SIMD_X86
+/** Wrapper for the cpuid instruction; regs: |eax|ebx|ecx|edx| */
+static void saf_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+{
+# if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, (int)leaf, (int)subleaf);
+    regs[0] = (unsigned int)r[0]; regs[1] = (unsigned int)r[1];
+    regs[2] = (unsigned int)r[2]; regs[3] = (unsigned int)r[3];
+# else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+# endif
+}
+
+/** Returns the XCR0 register (i.e. which register states the OS saves) */
+static unsigned long long saf_xgetbv(void)
+{
+# if defined(_MSC_VER)
+    return (unsigned long long)_xgetbv(0);
+# else
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+# endif
+}
+#endif /* SAF_VECLIB_SIMD_X86 */
+
+/** Returns the highest SIMD level supported by the host CPU (and OS) */
+static SAF_SIMD_LEVELS saf_veclib_detectSIMDLevel(void)
+{
+    SAF_SIMD_LEVELS level;
+    level = SAF_SIMD_NONE;
+#ifdef SAF_VECLIB_SIMD_X86
+    unsigned int regs[4], maxLeaf;
+    unsigned long long xcr0;
+
+    saf_cpuid(0, 0, regs);
+    maxLeaf = regs[0];
+    if(maxLeaf<1)
+        return level;
+    saf_cpuid(1, 0, regs);
+    if((regs[3] & (1u<<25)) && (regs[3] & (1u<<26)) && (regs[2] & 1u)) /* SSE, SSE2, SSE3 */
+        level = SAF_SIMD_SSE3;
+    else
+        return level;
+
+    /* AVX requires the OS to save the YMM registers (OSXSAVE + AVX bits, XCR0 bits 1 and 2) */
+    if(!(regs[2] & (1u<<27)) || !(regs[2] & (1u<<28)) || maxLeaf<7)
+        return level;
+    xcr0 = saf_xgetbv();
+    if((xcr0 & 0x6) != 0x6)
+        return level;
+    saf_cpuid(7, 0, regs);
+    if(regs[1] & (1u<<5)) /* AVX2 */
+        level = SAF_SIMD_AVX2;
+    else
+        return level;
+
+    /* AVX-512 additionally requires the OS to save the opmask and ZMM registers (XCR0 bits 5, 6 and 7) */
+    if((regs[1] & (1u<<16)) && (xcr0 & 0xE6) == 0xE6) /* AVX-512F */
+        level = SAF_SIMD_AVX512F;
+#endif
+    return level;
+}
+
+/** Returns the kernels for a given SIMD level (NULL if they were not compiled) */
+static const saf_veclib_simd_kernels* saf_veclib_getKernels(SAF_SIMD_LEVELS level)
+{
+    switch(level){
+        case SAF_SIMD_AVX512F: return saf_veclib_getKernels_avx512();
+        case SAF_SIMD_AVX2:    return saf_veclib_getKernels_avx2();
+        case SAF_SIMD_SSE3:    return saf_veclib_getKernels_sse3();
+        default:
+        case SAF_SIMD_NONE:    return saf_veclib_getKernels_scalar();
+    }
+}
+
+
+/* ========================================================================== */
+/*                                  Dispatch                                  */
+/* ========================================================================== */
+
+/**
+ * Currently selected level (-1 until first use). It is only ever accessed
+ * atomically, since the veclib functions may be first called by several
+ * threads at once (e.g. the saf_threadPool workers, or the processing and
+ * initialisation threads of the examples)
+ */
+static volatile int saf_veclib_simdLevel = -1;
+
+const saf_veclib_simd_kernels* saf_veclib_simd(void)
+{
+    return saf_veclib_getKernels(utility_getSIMDLevel());
+}
+
+SAF_SIMD_LEVELS utility_getSIMDLevel(void)
+{
+    int level;
+
+    level = saf_atomic_load(&saf_veclib_simdLevel);
+    if(level<0){
+        /* First use: select the highest level supported. Threads racing to get here all pick the same level, and only
+         * the first compare-exchange takes effect */
+        saf_atomic_compareExchange(&saf_veclib_simdLevel, -1, (int)utility_getMaxSIMDLevel());
+        level = saf_atomic_load(&saf_veclib_simdLevel);
+    }
+    return (SAF_SIMD_LEVELS)level;
+}
+
+SAF_SIMD_LEVELS utility_getMaxSIMDLevel(void)
+{
+    SAF_SIMD_LEVELS level;
+
+    /* The highest level supported by the CPU, for which the kernels were also compiled */
+    level = saf_veclib_detectSIMDLevel();
+    while(level>SAF_SIMD_NONE && saf_veclib_getKernels(level)==NULL)
+        level = (SAF_SIMD_LEVELS)(level-1);
+    return level;
+}
+
+SAF_SIMD_LEVELS utility_setSIMDLevel(SAF_SIMD_LEVELS level)
+{
+    level = SAF_MIN(SAF_MAX(level, SAF_SIMD_NONE), utility_getMaxSIMDLevel());
+    while(level>SAF_SIMD_NONE && saf_veclib_getKernels(level)==NULL)
+        level = (SAF_SIMD_LEVELS)(level-1);
+    saf_atomic_store(&saf_veclib_simdLevel, (int)level);
+    return level;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_veclib_simd.h
+ * @ingroup Utilities
+ * @brief Internal header for the run-time dispatched SIMD kernels employed by
+ *        saf_utility_veclib (when SAF_ENABLE_SIMD is defined)
+ *
+ * The kernels for each instruction set are compiled in separate translation
+ * units, each with the compiler flags required by that instruction set:
+ *   - saf_utility_veclib_sse3.c:   -msse3
+ *   - saf_utility_veclib_avx2.c:   -mavx2            (MSVC: /arch:AVX2)
+ *   - saf_utility_veclib_avx512.c: -mavx512f -mavx2  (MSVC: /arch:AVX512)
+ *
+ * The most suitable kernels are then selected upon first use, based on the
+ * features of the host CPU (via cpuid); see utility_getSIMDLevel().
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#ifndef __SAF_UTILITY_VECLIB_SIMD_H_INCLUDED__
+#define __SAF_UTILITY_VECLIB_SIMD_H_INCLUDED__
+
+#include "saf_utilities.h"
+#include "saf_externals.h"
+#include "saf_utility_fft_builtin.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** Table of vector kernels for one SIMD instruction set */
+typedef struct _saf_veclib_simd_kernels {
+    /** c = a + b; FLAT: len x 1 */
+    void (*svvadd)(const float* a, const float* b, const int len, float* c);
+    /** c = a - b; FLAT: len x 1 */
+    void (*svvsub)(const float* a, const float* b, const int len, float* c);
+    /** c = a .* b; FLAT: len x 1 */
+    void (*svvmul)(const float* a, const float* b, const int len, float* c);
+    /** c = a + b; FLAT: len x 1 */
+    void (*dvvadd)(const double* a, const double* b, const int len, double* c);
+    /** c = a - b; FLAT: len x 1 */
+    void (*dvvsub)(const double* a, const double* b, const int len, double* c);
+    /** c = a .* b (complex); FLAT: len x 1 */
+    void (*cvvmul)(const float_complex* a, const float_complex* b, const int len, float_complex* c);
+    /** c = 1 ./ a (may be approximate); FLAT: len x 1 */
+    void (*svrecip)(const float* a, const int len, float* c);
+    /** c = a + s; FLAT: len x 1 */
+    void (*svsadd)(const float* a, const float s, const int len, float* c);
+    /** c = a - s; FLAT: len x 1 */
+    void (*svssub)(const float* a, const float s, const int len, float* c);
+    /** One radix-4 stage of the built-in FFT; see saf_fftBuiltin_radix4Stage() */
+    void (*fftRadix4Stage)(int n, int s, const float* tw, const float* xr, const float* xi, float* yr, float* yi);
+
+}saf_veclib_simd_kernels;
+
+/** Returns the scalar (plain C) kernels */
+const saf_veclib_simd_kernels* saf_veclib_getKernels_scalar(void);
+
+/**
+ * Returns the SSE3 kernels, or NULL if saf_utility_veclib_sse3.c was not
+ * compiled with SSE3 support */
+const saf_veclib_simd_kernels* saf_veclib_getKernels_sse3(void);
+
+/**
+ * Returns the AVX2 kernels, or NULL if saf_utility_veclib_avx2.c was not
+ * compiled with AVX2 support */
+const saf_veclib_simd_kernels* saf_veclib_getKernels_avx2(void);
+
+/**
+ * Returns the AVX-512F kernels, or NULL if saf_utility_veclib_avx512.c was not
+ * compiled with AVX-512F support */
+const saf_veclib_simd_kernels* saf_veclib_getKernels_avx512(void);
+
+/**
+ * Returns the currently selected kernels (selecting them, based on the host
+ * CPU, upon first call)
+ */
+const saf_veclib_simd_kernels* saf_veclib_simd(void);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __SAF_UTILITY_VECLIB_SIMD_H_INCLUDED__ */
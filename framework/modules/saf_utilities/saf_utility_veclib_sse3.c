@@ -0,0 +1,159 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_veclib_sse3.c
+ * @ingroup Utilities
+ * @brief SSE, SSE2 and SSE3 kernels for saf_utility_veclib
+ *
+ * @note This file must be compiled with SSE3 support (e.g. '-msse3'),
+ *       otherwise saf_veclib_getKernels_sse3() returns NULL.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include "saf_utility_veclib_simd.h"
+
+/* Note that MSVC does not define __SSE3__, but SSE3 intrinsics are always
+ * available when targeting x64 */
+#if defined(SAF_ENABLE_SIMD) && (defined(__SSE3__) || (defined(_MSC_VER) && defined(_M_X64)))
+# include <pmmintrin.h>
+
+static void svvadd_sse3(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_add_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + b[i];
+}
+
+static void svvsub_sse3(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_sub_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - b[i];
+}
+
+static void svvmul_sse3(const float* a, const float* b, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_mul_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] * b[i];
+}
+
+static void dvvadd_sse3(const double* a, const double* b, const int len, double* c)
+{
+    int i;
+    for(i=0; i<(len-1); i+=2)
+        _mm_storeu_pd(c+i, _mm_add_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + b[i];
+}
+
+static void dvvsub_sse3(const double* a, const double* b, const int len, double* c)
+{
+    int i;
+    for(i=0; i<(len-1); i+=2)
+        _mm_storeu_pd(c+i, _mm_sub_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i)));
+    for(; i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - b[i];
+}
+
+static void cvvmul_sse3(const float_complex* a, const float_complex* b, const int len, float_complex* c)
+{
+    int i;
+    float* sa, *sb, *sc;
+    sa = (float*)a; sb = (float*)b; sc = (float*)c;
+    for(i=0; i<(len-1); i+=2){
+        /* Load only the real parts of a */
+        __m128 src1 = _mm_moveldup_ps(_mm_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|*/); /*|a1|a1|a2|a2|*/
+        /* Load real+imag parts of b */
+        __m128 src2 = _mm_loadu_ps(sb+2*i); /*|c1|d1|c2|d2|*/
+        /* Multiply together */
+        __m128 tmp1 = _mm_mul_ps(src1, src2);
+        /* Swap the real+imag parts of b to be imag+real instead: */
+        __m128 b1 = _mm_shuffle_ps(src2, src2, _MM_SHUFFLE(2, 3, 0, 1));
+        /* Load only the imag parts of a */
+        src1 = _mm_movehdup_ps(_mm_loadu_ps(sa+2*i)/*|a1|b1|a2|b2|*/); /*|b1|b1|b2|b2|*/
+        /* Multiply together */
+        __m128 tmp2 = _mm_mul_ps(src1, b1);
+        /* Add even indices, subtract odd indices */
+        _mm_storeu_ps(sc+2*i, _mm_addsub_ps(tmp1, tmp2));
+    }
+    for(;i<len; i++){ /* The residual (if len was not divisable by the step size): */
+        sc[2*i]   = sa[2*i] * sb[2*i]   - sa[2*i+1] * sb[2*i+1];
+        sc[2*i+1] = sa[2*i] * sb[2*i+1] + sa[2*i+1] * sb[2*i];
+    }
+}
+
+static void svrecip_sse3(const float* a, const int len, float* c)
+{
+    int i;
+    for(i=0; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_rcp_ps(_mm_loadu_ps(a+i)));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = 1.0f/a[i];
+}
+
+static void svsadd_sse3(const float* a, const float s, const int len, float* c)
+{
+    int i;
+    __m128 s4 = _mm_set1_ps(s);
+    for(i=0; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_add_ps(_mm_loadu_ps(a+i), s4));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] + s;
+}
+
+static void svssub_sse3(const float* a, const float s, const int len, float* c)
+{
+    int i;
+    __m128 s4 = _mm_set1_ps(s);
+    for(i=0; i<(len-3); i+=4)
+        _mm_storeu_ps(c+i, _mm_sub_ps(_mm_loadu_ps(a+i), s4));
+    for(;i<len; i++) /* The residual (if len was not divisable by the step size): */
+        c[i] = a[i] - s;
+}
+
+static const saf_veclib_simd_kernels saf_veclib_kernels_sse3 = {
+    svvadd_sse3, svvsub_sse3, svvmul_sse3,
+    dvvadd_sse3, dvvsub_sse3,
+    cvvmul_sse3,
+    svrecip_sse3,
+    svsadd_sse3, svssub_sse3,
+    saf_fftBuiltin_radix4Stage /* (SSE2 is already employed by the baseline stage) */
+};
+
+const saf_veclib_simd_kernels* saf_veclib_getKernels_sse3(void)
+{
+    return &saf_veclib_kernels_sse3;
+}
+
+#else
+
+const saf_veclib_simd_kernels* saf_veclib_getKernels_sse3(void)
+{
+    return NULL;
+}
+
+#endif /* SAF_ENABLE_SIMD && __SSE3__ */
@@ -74,6 +74,8 @@ void afSTFTlib_init
     
     h->inChannels = inChannels;
     h->outChannels = outChannels;
+    h->nActiveIn = inChannels;
+    h->nActiveOut = outChannels;
     h->hopSize = hopSize;
     dsFactor = 1024/hopSize;
     h->hLen = 10240/dsFactor;
@@ -204,6 +206,8 @@ void afSTFTlib_channelChange
     }
     h->inChannels = new_inChannels;
     h->outChannels = new_outChannels;
+    h->nActiveIn = new_inChannels;
+    h->nActiveOut = new_outChannels;
     if (h->hybridMode){
         hyb_h->inChannels = new_inChannels;
         hyb_h->outChannels = new_outChannels;
@@ -238,18 +242,35 @@ void afSTFTlib_forward
 (
     void* handle,
     float** inTD,
-    complexVector* outFD
+    complexVector* outFD,
+    int nCH
 )
 {
     afSTFTlib_internal_data *h = (afSTFTlib_internal_data*)(handle);
-    int ch,k,hopIndex_this,hopIndex_this2;
+    afHybrid *hyb_h = h->h_afHybrid;
+    int ch,k,hopIndex_this,hopIndex_this2,sample;
     float *p1,*p2,*p3;
 #ifndef AFSTFT_USE_SAF_UTILITIES
     float *p4;
 #endif
     int lr;
     
-    for (ch=0;ch<h->inChannels;ch++)
+    /* Channels which are (re)activated should not start with old history */
+    for (ch=h->nActiveIn;ch<nCH;ch++)
+    {
+        memset(h->inBuffer[ch], 0, h->hLen*sizeof(float));
+        if (h->hybridMode)
+        {
+            for (sample=0;sample<7;sample++)
+            {
+                memset(hyb_h->analysisBuffer[ch][sample].re, 0, sizeof(float)*(h->hopSize+1));
+                memset(hyb_h->analysisBuffer[ch][sample].im, 0, sizeof(float)*(h->hopSize+1));
+            }
+        }
+    }
+    h->nActiveIn = nCH;
+    
+    for (ch=0;ch<nCH;ch++)
     {
         /* Copy the input frame into the memory buffer */
         hopIndex_this2 = h->hopIndexIn;
@@ -328,7 +349,7 @@ void afSTFTlib_forward
     /* Subdivide lowest bands with half-band filters if hybrid mode is enabled */
     if (h->hybridMode)
     {
-        afHybridForward(h->h_afHybrid, outFD);
+        afHybridForward(h->h_afHybrid, outFD, nCH);
     }
 }
 
@@ -336,7 +357,8 @@ void afSTFTlib_inverse
 (
     void* handle,
     complexVector* inFD,
-    float** outTD
+    float** outTD,
+    int nCH
 )
 {
     afSTFTlib_internal_data *h = (afSTFTlib_internal_data*)(handle);
@@ -347,13 +369,18 @@ void afSTFTlib_inverse
 #endif
     int lr;
     
+    /* Channels which are (re)activated should not start with old overlap-add tails */
+    for (ch=h->nActiveOut;ch<nCH;ch++)
+        memset(h->outBuffer[ch], 0, h->hLen*sizeof(float));
+    h->nActiveOut = nCH;
+    
     /* Combine subdivided lowest bands if hybrid mode is enabled */
     if (h->hybridMode)
     {
-        afHybridInverse(h->h_afHybrid, inFD);
+        afHybridInverse(h->h_afHybrid, inFD, nCH);
     }
     
-    for (ch=0;ch<h->outChannels;ch++)
+    for (ch=0;ch<nCH;ch++)
     {
         /* Copy data from input to internal memory */
         hopIndex_this2 = h->hopIndexOut;
@@ -523,7 +550,8 @@ void afHybridInit
 void afHybridForward
 (
     void* handle,
-    complexVector* FD
+    complexVector* FD,
+    int nCH
 )
 {
     afHybrid *h = (afHybrid*)(handle);
@@ -538,7 +566,7 @@ void afHybridForward
         h->loopPointer = 0;
     }
 
-    for (ch=0;ch<h->inChannels;ch++)
+    for (ch=0;ch<nCH;ch++)
     {
         /* Copy data from input to the memory buffer */
         pr1 = FD[ch].re;
@@ -625,14 +653,15 @@ void afHybridForward
 void afHybridInverse
 (
     void* handle,
-    complexVector* FD
+    complexVector* FD,
+    int nCH
 )
 {
     afHybrid *h = (afHybrid*)(handle);
     int ch,realImag;
     float *pr;
 
-    for (ch=0;ch<h->outChannels;ch++)
+    for (ch=0;ch<nCH;ch++)
     {
         pr = FD[ch].re;
         for (realImag=0;realImag<2;realImag++)
@@ -94,6 +94,8 @@ typedef struct {
 typedef struct{
     int inChannels;
     int outChannels;
+    int nActiveIn;  /* Number of input channels transformed by the last call */
+    int nActiveOut; /* Number of output channels transformed by the last call */
     int hopSize;
     int hLen;
     int LDmode;
@@ -172,15 +174,23 @@ void afSTFTlib_channelChange(void* handle,
 /** Flushes time-domain buffers with zeros */
 void afSTFTlib_clearBuffers(void* handle);
 
-/** Applies the forward afSTFT transform */
+/**
+ * Applies the forward afSTFT transform to the first nCH input channels
+ * (nCH<=inChannels); the buffers of any channels which were inactive during
+ * the previous call are flushed first */
 void afSTFTlib_forward(void* handle,
                        float** inTD,
-                       complexVector* outFD);
+                       complexVector* outFD,
+                       int nCH);
 
-/** Applies the backward afSTFT transform. */
+/**
+ * Applies the backward afSTFT transform to the first nCH output channels
+ * (nCH<=outChannels); the buffers of any channels which were inactive during
+ * the previous call are flushed first */
 void afSTFTlib_inverse(void* handle,
                        complexVector* inFD,
-                       float** outTD);
+                       float** outTD,
+                       int nCH);
 
 /** Destroys an instance of afSTFTlib */
 void afSTFTlib_free(void* handle);
@@ -191,13 +201,15 @@ void afHybridInit(void** handle,
                   int inChannels,
                   int outChannels);
 
-/** Forward hybrid-filtering transform */
+/** Forward hybrid-filtering transform (of the first nCH channels) */
 void afHybridForward(void* handle,
-                     complexVector* FD);
+                     complexVector* FD,
+                     int nCH);
 
-/** Inverse hybrid-filtering transform */
+/** Inverse hybrid-filtering transform (of the first nCH channels) */
 void afHybridInverse(void* handle,
-                     complexVector* FD);
+                     complexVector* FD,
+                     int nCH);
 
 /** Frees an instnce of the afHybrid filtering structure */
 void afHybridFree(void* handle);
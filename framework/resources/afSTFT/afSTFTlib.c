@@ -245,7 +245,7 @@ void afSTFT_forward
         /* forward transform */
         for(ch = 0; ch < h->nCHin; ch++)
             utility_svvcopy(&(dataTD[ch][t*(h->hopsize)]), (h->hopsize), h->tempHopFrameTD[ch]);
-        afSTFTlib_forward(h->hInt, h->tempHopFrameTD, h->STFTInputFrameTF);
+        afSTFTlib_forward(h->hInt, h->tempHopFrameTD, h->STFTInputFrameTF, h->nCHin);
 
         /* store */
         switch(h->format){
@@ -273,32 +273,48 @@ void afSTFT_forward_knownDimensions
     int dataFD_nHops,
     float_complex*** dataFD
 )
+{
+    afSTFT_data *h = (afSTFT_data*)(hSTFT);
+    afSTFT_forward_knownDimensions_nCH(hSTFT, dataTD, framesize, dataFD_nCH, dataFD_nHops, h->nCHin, dataFD);
+}
+
+void afSTFT_forward_knownDimensions_nCH
+(
+    void * const hSTFT,
+    float** dataTD,
+    int framesize,
+    int dataFD_nCH,
+    int dataFD_nHops,
+    int nCHin,
+    float_complex*** dataFD
+)
 {
     afSTFT_data *h = (afSTFT_data*)(hSTFT);
     int ch, t, nHops;
     float_complex* pDataFD;
 
     assert(framesize % h->hopsize == 0); /* framesize must be multiple of hopsize */
+    assert(nCHin>=0 && nCHin<=h->nCHin);
     nHops = framesize/h->hopsize;
     pDataFD = &dataFD[0][0][0];
 
     /* Loop over hops */
     for(t=0; t < nHops; t++) {
         /* forward transform */
-        for(ch = 0; ch < h->nCHin; ch++)
+        for(ch = 0; ch < nCHin; ch++)
             utility_svvcopy(&(dataTD[ch][t*(h->hopsize)]), (h->hopsize), h->tempHopFrameTD[ch]);
-        afSTFTlib_forward(h->hInt, h->tempHopFrameTD, h->STFTInputFrameTF);
+        afSTFTlib_forward(h->hInt, h->tempHopFrameTD, h->STFTInputFrameTF, nCHin);
 
         /* store */
         switch(h->format){
             case AFSTFT_BANDS_CH_TIME:
-                for(ch=0; ch < h->nCHin; ch++){
+                for(ch=0; ch < nCHin; ch++){
                     cblas_scopy(h->nBands, h->STFTInputFrameTF[ch].re, 1, (float*)&pDataFD[0*dataFD_nCH*nHops + ch*dataFD_nHops + t], dataFD_nCH*dataFD_nHops*2);
                     cblas_scopy(h->nBands, h->STFTInputFrameTF[ch].im, 1, &((float*)&pDataFD[0*dataFD_nCH*nHops + ch*dataFD_nHops + t])[1], dataFD_nCH*dataFD_nHops*2);
                 }
                 break;
             case AFSTFT_TIME_CH_BANDS:
-                for(ch=0; ch < h->nCHin; ch++){
+                for(ch=0; ch < nCHin; ch++){
                     cblas_scopy(h->nBands, h->STFTInputFrameTF[ch].re, 1, (float*)dataFD[t][ch], 2);
                     cblas_scopy(h->nBands, h->STFTInputFrameTF[ch].im, 1, &((float*)dataFD[t][ch])[1], 2);
                 }
@@ -326,7 +342,7 @@ void afSTFT_forward_flat
         /* forward transform */
         for(ch = 0; ch < h->nCHin; ch++)
             utility_svvcopy(&(dataTD[ch * framesize + t*(h->hopsize)]), (h->hopsize), h->tempHopFrameTD[ch]);
-        afSTFTlib_forward(h->hInt, h->tempHopFrameTD, h->STFTInputFrameTF);
+        afSTFTlib_forward(h->hInt, h->tempHopFrameTD, h->STFTInputFrameTF, h->nCHin);
 
         /* store */
         switch(h->format){
@@ -379,7 +395,7 @@ void afSTFT_backward
                 }
                 break;
         }
-        afSTFTlib_inverse(h->hInt, h->STFTOutputFrameTF, h->tempHopFrameTD);
+        afSTFTlib_inverse(h->hInt, h->STFTOutputFrameTF, h->tempHopFrameTD, h->nCHout);
 
         /* store */
         for (ch = 0; ch <  h->nCHout; ch++)
@@ -396,12 +412,28 @@ void afSTFT_backward_knownDimensions
     int dataFD_nHops,
     float** dataTD
 )
+{
+    afSTFT_data *h = (afSTFT_data*)(hSTFT);
+    afSTFT_backward_knownDimensions_nCH(hSTFT, dataFD, framesize, dataFD_nCH, dataFD_nHops, h->nCHout, dataTD);
+}
+
+void afSTFT_backward_knownDimensions_nCH
+(
+    void * const hSTFT,
+    float_complex*** dataFD,
+    int framesize,
+    int dataFD_nCH,
+    int dataFD_nHops,
+    int nCHout,
+    float** dataTD
+)
 {
     afSTFT_data *h = (afSTFT_data*)(hSTFT);
     int ch, t, nHops;
     float_complex* pDataFD;
 
     assert(framesize % h->hopsize == 0); /* framesize must be multiple of hopsize */
+    assert(nCHout>=0 && nCHout<=h->nCHout);
     nHops = framesize/h->hopsize;
     pDataFD = &dataFD[0][0][0];
 
@@ -410,22 +442,22 @@ void afSTFT_backward_knownDimensions
         /* backward transform */
         switch(h->format){
             case AFSTFT_BANDS_CH_TIME:
-                for(ch=0; ch < h->nCHout; ch++){
+                for(ch=0; ch < nCHout; ch++){
                     cblas_scopy(h->nBands, (float*)&pDataFD[0*dataFD_nCH*nHops + ch*dataFD_nHops + t], dataFD_nCH*dataFD_nHops*2, h->STFTOutputFrameTF[ch].re, 1);
                     cblas_scopy(h->nBands, &((float*)&pDataFD[0*dataFD_nCH*nHops + ch*dataFD_nHops + t])[1], dataFD_nCH*dataFD_nHops*2, h->STFTOutputFrameTF[ch].im, 1);
                 }
                 break;
             case AFSTFT_TIME_CH_BANDS:
-                for(ch = 0; ch < h->nCHout; ch++) {
+                for(ch = 0; ch < nCHout; ch++) {
                     cblas_scopy(h->nBands, (float*)dataFD[t][ch], 2, h->STFTOutputFrameTF[ch].re, 1);
                     cblas_scopy(h->nBands, &((float*)dataFD[t][ch])[1], 2, h->STFTOutputFrameTF[ch].im, 1);
                 }
                 break;
         }
-        afSTFTlib_inverse(h->hInt, h->STFTOutputFrameTF, h->tempHopFrameTD);
+        afSTFTlib_inverse(h->hInt, h->STFTOutputFrameTF, h->tempHopFrameTD, nCHout);
 
         /* store */
-        for (ch = 0; ch <  h->nCHout; ch++)
+        for (ch = 0; ch <  nCHout; ch++)
             memcpy(&(dataTD[ch][t*(h->hopsize)]), h->tempHopFrameTD[ch], h->hopsize*sizeof(float));
     }
 }
@@ -465,7 +497,7 @@ void afSTFT_backward_flat
                 }
                 break;
         }
-        afSTFTlib_inverse(h->hInt, h->STFTOutputFrameTF, h->tempHopFrameTD);
+        afSTFTlib_inverse(h->hInt, h->STFTOutputFrameTF, h->tempHopFrameTD, h->nCHout);
 
         /* store */
         for (ch = 0; ch <  h->nCHout; ch++)
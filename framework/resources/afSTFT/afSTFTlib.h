@@ -145,6 +145,34 @@ void afSTFT_forward_knownDimensions(void * const hSTFT,
                                     int dataFD_nHops,
                                     float_complex*** dataFD);
 
+/**
+ * Performs forward afSTFT transform (dataFD dimensions are known), for only the
+ * first nCHin input channels
+ *
+ * This allows the number of channels to vary from call to call, without
+ * re-allocating the afSTFT (i.e. unlike afSTFT_channelChange()); for example,
+ * the afSTFT may be created for the maximum number of channels, while only the
+ * channels which are actually in use are transformed. The run-time buffers of
+ * any channels which were not transformed by the previous call are flushed
+ * with zeros before they are transformed again.
+ *
+ * @param[in]  hSTFT        afSTFT handle
+ * @param[in]  dataTD       Time-domain input; nCHin x framesize
+ * @param[in]  framesize    Frame size of time-domain data
+ * @param[in]  dataFD_nCH   Number of channels dataFD is allocated (the max)
+ * @param[in]  dataFD_nHops Number of timeslots dataFD is allocated (the max)
+ * @param[in]  nCHin        Number of input channels to transform; 0..nCHin of
+ *                          the afSTFT instance
+ * @param[out] dataFD       Frequency-domain output; #AFSTFT_FDDATA_FORMAT
+ */
+void afSTFT_forward_knownDimensions_nCH(void * const hSTFT,
+                                        float** dataTD,
+                                        int framesize,
+                                        int dataFD_nCH,
+                                        int dataFD_nHops,
+                                        int nCHin,
+                                        float_complex*** dataFD);
+
 /**
  * Performs forward afSTFT transform (flattened arrays)
  *
@@ -192,6 +220,29 @@ void afSTFT_backward_knownDimensions(void * const hSTFT,
                                      int dataFD_nHops,
                                      float** dataTD);
 
+/**
+ * Performs backward afSTFT transform (dataFD dimensions are known), for only
+ * the first nCHout output channels
+ *
+ * @note See afSTFT_forward_knownDimensions_nCH()
+ *
+ * @param[in]  hSTFT        afSTFT handle
+ * @param[in]  dataFD       Frequency-domain input; #AFSTFT_FDDATA_FORMAT
+ * @param[in]  framesize    Frame size of time-domain data
+ * @param[in]  dataFD_nCH   Number of channels dataFD is allocated (the max)
+ * @param[in]  dataFD_nHops Number of timeslots dataFD is allocated (the max)
+ * @param[in]  nCHout       Number of output channels to transform; 0..nCHout
+ *                          of the afSTFT instance
+ * @param[out] dataTD       Time-domain output;  nCHout x framesize
+ */
+void afSTFT_backward_knownDimensions_nCH(void * const hSTFT,
+                                         float_complex*** dataFD,
+                                         int framesize,
+                                         int dataFD_nCH,
+                                         int dataFD_nHops,
+                                         int nCHout,
+                                         float** dataTD);
+
 /**
  * Performs backward afSTFT transform (flattened arrays)
  *
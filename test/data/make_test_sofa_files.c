@@ -0,0 +1,187 @@
+/*
+ * Copyright 2026 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file make_test_sofa_files.c
+ * @brief Generates the synthetic SOFA files employed by the SOFA reader unit
+ *        tests (this program is not part of the build, and requires HDF5)
+ *
+ * Usage:
+ * @code
+ *   cc make_test_sofa_files.c -lhdf5 -lm -o make_test_sofa_files
+ *   ./make_test_sofa_files saf_test_hrirs.sofa 0
+ *   ./make_test_sofa_files saf_test_hrirs_deflated.sofa 1
+ * @endcode
+ * where the second argument selects contiguous storage (0), or chunked storage
+ * with the shuffle and deflate filters (1) for the SourcePosition and Data.IR
+ * variables.
+ *
+ * The files follow the SimpleFreeFieldHRIR convention. The source directions
+ * and the (band-limited impulse) HRIRs are given by closed-form expressions,
+ * which test__sofa_testFiles() evaluates again to check the loaded data; the
+ * two must therefore be kept in sync.
+ *
+ * @author Leo McCormack
+ * @date 17.10.2026
+ * @license ISC
+ */
+
+#include <hdf5.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_SOFA_M    ( 24 )    /**< Number of source directions */
+#define TEST_SOFA_R    ( 2 )     /**< Number of receivers (ears) */
+#define TEST_SOFA_N    ( 64 )    /**< Length of the HRIRs, in samples */
+#define TEST_SOFA_FS   ( 48000 ) /**< Sampling rate, in Hz */
+#define TEST_SOFA_CHUNK ( 8 )    /**< Number of source directions per chunk (deflated file) */
+
+static void writeStringAttribute(hid_t loc, const char* name, const char* value)
+{
+    hid_t type, space, attr;
+    type = H5Tcopy(H5T_C_S1);
+    H5Tset_size(type, strlen(value)+1);
+    H5Tset_strpad(type, H5T_STR_NULLTERM);
+    space = H5Screate(H5S_SCALAR);
+    attr = H5Acreate2(loc, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attr, type, value);
+    H5Aclose(attr);
+    H5Sclose(space);
+    H5Tclose(type);
+}
+
+static void writeDimension(hid_t file, const char* name, hsize_t length)
+{
+    char str[128];
+    hid_t space, dset;
+    space = H5Screate_simple(1, &length, NULL);
+    dset = H5Dcreate2(file, name, H5T_IEEE_F32LE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    sprintf(str, "This is a netCDF dimension but not a netCDF variable.%10d", (int)length);
+    writeStringAttribute(dset, "CLASS", "DIMENSION_SCALE");
+    writeStringAttribute(dset, "NAME", str);
+    H5Dclose(dset);
+    H5Sclose(space);
+}
+
+static hid_t writeVariable(hid_t file, const char* name, int rank, const hsize_t* dims, const double* data, int deflate)
+{
+    int i;
+    hsize_t chunk[3];
+    hid_t space, plist, dset;
+    space = H5Screate_simple(rank, dims, NULL);
+    plist = H5Pcreate(H5P_DATASET_CREATE);
+    if(deflate){
+        for(i=0; i<rank; i++)
+            chunk[i] = dims[i];
+        chunk[0] = chunk[0] < TEST_SOFA_CHUNK ? chunk[0] : TEST_SOFA_CHUNK;
+        H5Pset_chunk(plist, rank, chunk);
+        H5Pset_shuffle(plist);
+        H5Pset_deflate(plist, 6);
+    }
+    dset = H5Dcreate2(file, name, H5T_IEEE_F64LE, space, H5P_DEFAULT, plist, H5P_DEFAULT);
+    H5Dwrite(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    H5Pclose(plist);
+    H5Sclose(space);
+    return dset; /* (closed by the caller, after adding any attributes) */
+}
+
+static void writePositionVariable(hid_t file, const char* name, int rank, const hsize_t* dims, const double* data,
+                                  int deflate, const char* type, const char* units)
+{
+    hid_t dset;
+    dset = writeVariable(file, name, rank, dims, data, deflate);
+    writeStringAttribute(dset, "Type", type);
+    writeStringAttribute(dset, "Units", units);
+    H5Dclose(dset);
+}
+
+int main(int argc, char** argv)
+{
+    int m, r, n, deflate;
+    double azi, elev, itd, delay, gain, t;
+    double* pos, *ir;
+    hid_t fapl, fcpl, file;
+    hsize_t dimsIR[3] = {TEST_SOFA_M, TEST_SOFA_R, TEST_SOFA_N}, dimsSrc[2] = {TEST_SOFA_M, 3};
+    hsize_t dimsList[2] = {1, 3}, dimsRec[3] = {TEST_SOFA_R, 3, 1}, dimsEmit[3] = {1, 3, 1};
+    hsize_t dimsFs[1] = {1}, dimsDelay[2] = {1, TEST_SOFA_R};
+    double fs = TEST_SOFA_FS, recPos[6] = {0.0, 0.09, 0.0, 0.0, -0.09, 0.0}, zeros[3] = {0.0, 0.0, 0.0};
+    double up[3] = {0.0, 0.0, 1.0}, view[3] = {1.0, 0.0, 0.0}, delays[TEST_SOFA_R] = {0.0, 0.0};
+
+    if(argc!=3)
+        return 1;
+    deflate = atoi(argv[2]);
+
+    /* Source directions: a spherical Fibonacci grid, in degrees (at 1.5 m); and
+     * HRIRs: windowed fractional delays, with an interaural time and level
+     * difference */
+    pos = malloc(TEST_SOFA_M*3*sizeof(double));
+    ir = malloc(TEST_SOFA_M*TEST_SOFA_R*TEST_SOFA_N*sizeof(double));
+    for(m=0; m<TEST_SOFA_M; m++){
+        elev = asin(1.0 - 2.0*((double)m+0.5)/(double)TEST_SOFA_M);
+        azi = fmod((double)m*2.399963229728653, 2.0*M_PI);
+        pos[m*3+0] = azi*180.0/M_PI;
+        pos[m*3+1] = elev*180.0/M_PI;
+        pos[m*3+2] = 1.5;
+        itd = 0.00035*sin(azi)*cos(elev);
+        for(r=0; r<TEST_SOFA_R; r++){
+            delay = (double)(TEST_SOFA_N/8) + (r==0 ? -1.0 : 1.0)*itd*(double)TEST_SOFA_FS;
+            gain = 1.0 + (r==0 ? 0.3 : -0.3)*sin(azi)*cos(elev);
+            for(n=0; n<TEST_SOFA_N; n++){
+                t = (double)n - delay;
+                ir[(m*TEST_SOFA_R+r)*TEST_SOFA_N+n] = gain * (fabs(t)<1e-9 ? 1.0 : sin(M_PI*t)/(M_PI*t)) * exp(-fabs(t)/(double)(TEST_SOFA_N/16));
+            }
+        }
+    }
+
+    /* Write the file (in the HDF5 layout employed by netCDF-4) */
+    fapl = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_libver_bounds(fapl, H5F_LIBVER_V18, H5F_LIBVER_V18);
+    fcpl = H5Pcreate(H5P_FILE_CREATE);
+    H5Pset_link_creation_order(fcpl, H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
+    H5Pset_attr_creation_order(fcpl, H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
+    file = H5Fcreate(argv[1], H5F_ACC_TRUNC, fcpl, fapl);
+    writeStringAttribute(file, "Conventions", "SOFA");
+    writeStringAttribute(file, "Version", "1.0");
+    writeStringAttribute(file, "SOFAConventions", "SimpleFreeFieldHRIR");
+    writeStringAttribute(file, "SOFAConventionsVersion", "1.0");
+    writeStringAttribute(file, "APIName", "make_test_sofa_files");
+    writeStringAttribute(file, "APIVersion", "1.0");
+    writeStringAttribute(file, "DataType", "FIR");
+    writeStringAttribute(file, "RoomType", "free field");
+    writeStringAttribute(file, "Title", "Spatial_Audio_Framework SOFA reader test data");
+    writeDimension(file, "C", 3);
+    writeDimension(file, "I", 1);
+    writeDimension(file, "M", TEST_SOFA_M);
+    writeDimension(file, "R", TEST_SOFA_R);
+    writeDimension(file, "E", 1);
+    writeDimension(file, "N", TEST_SOFA_N);
+    writePositionVariable(file, "ListenerPosition", 2, dimsList, zeros, 0, "cartesian", "metre");
+    writePositionVariable(file, "ReceiverPosition", 3, dimsRec, recPos, 0, "cartesian", "metre");
+    writePositionVariable(file, "SourcePosition", 2, dimsSrc, pos, deflate, "spherical", "degree, degree, metre");
+    writePositionVariable(file, "EmitterPosition", 3, dimsEmit, zeros, 0, "cartesian", "metre");
+    writePositionVariable(file, "ListenerUp", 2, dimsList, up, 0, "cartesian", "metre");
+    writePositionVariable(file, "ListenerView", 2, dimsList, view, 0, "cartesian", "metre");
+    H5Dclose(writeVariable(file, "Data.IR", 3, dimsIR, ir, deflate));
+    H5Dclose(writeVariable(file, "Data.SamplingRate", 1, dimsFs, &fs, 0));
+    H5Dclose(writeVariable(file, "Data.Delay", 2, dimsDelay, delays, 0));
+    H5Fclose(file);
+    H5Pclose(fcpl);
+    H5Pclose(fapl);
+    free(pos);
+    free(ir);
+    return 0;
+}
@@ -109,20 +109,79 @@ void test__saf_stft_LTI(void);
 /**
  * Testing the forward and backward real-(half)complex FFT (saf_rfft) */
 void test__saf_rfft(void);
+/**
+ * Testing that the batched real<->half-complex FFTs are equivalent to
+ * transforming each vector individually (for both dense and padded layouts) */
+void test__saf_rfft_batch(void);
 /**
  * Testing the forward and backward complex-complex FFT (saf_fft) */
 void test__saf_fft(void);
+/**
+ * Testing that saf_rfft/saf_fft are equivalent to kissFFT for the 2^x FFT sizes
+ * used by the examples (saf_fft with each SIMD level supported by the host
+ * CPU), and comparing their run-times */
+void test__saf_fft_vs_kissFFT(void);
 /**
  * Testing the saf_matrixConv */
 void test__saf_matrixConv(void);
+/**
+ * Testing that the partitioned modes of saf_matrixConv (including the
+ * non-uniformly partitioned mode) yield the same output as the non-partitioned
+ * mode (and reporting the time taken by each mode) */
+void test__saf_matrixConv_partitioned(void);
+/**
+ * Testing that saf_matrixConv yields the same output regardless of the number
+ * of threads employed (and reporting the time taken for 1..N threads) */
+void test__saf_matrixConv_threaded(void);
+/**
+ * Testing that saf_rcu hands over a sequence of states from one thread to
+ * another, without destroying any state which is still held by the reader */
+void test__saf_rcu(void);
+/**
+ * Testing that saf_fileCache returns the arrays it cached (also via the array
+ * helpers), and that it rejects other keys, as well as corrupted or non-cache
+ * files */
+void test__saf_fileCache(void);
+/**
+ * Testing that the partitioned modes of saf_multiConv (including the
+ * non-uniformly partitioned mode) yield the same output as the non-partitioned
+ * mode, and that the uniformly partitioned mode is bit-identical to shifting
+ * the whole FDL every hop (and reporting the time taken and memory moved per
+ * hop) */
+void test__saf_multiConv(void);
+/**
+ * Testing that the work of the non-uniformly partitioned mode of saf_multiConv
+ * is spread over the hops, (i.e., that the most expensive hop does not cost
+ * many times more than the average hop) */
+void test__saf_multiConv_hopLoad(void);
+/**
+ * Testing that each SIMD instruction set (supported by the host CPU) yields the
+ * same results as the plain C implementations of the veclib functions (and
+ * reporting the time taken by each) */
+void test__utility_simdDispatch(void);
 /**
  * Testing the (near)-perfect reconstruction performance of the QMF filterbank
  */
 void test__qmf(void);
+/**
+ * Testing the FFT-based modulators of the QMF filterbank for all supported
+ * hopsizes (band selectivity and reconstruction), and timing them
+ */
+void test__qmf_fftModulation(void);
+/**
+ * Testing that the QMF ring buffers are bit-exact irrespective of the frame
+ * sizes used and of channel count changes
+ */
+void test__qmf_ringBuffers(void);
 /**
  * Testing that the smb_pitchShifter can shift the energy of input spectra by
  * one octave down */
 void test__smb_pitchShifter(void);
+/**
+ * Testing that the smb_pitchShifter using the fast approximations can also
+ * shift the energy down one octave, and that its output is close to that of
+ * the default one; also times the two for different numbers of channels */
+void test__smb_pitchShifter_fast(void);
 /**
  * Testing the sortf() function (sorting real floating point numbers) */
 void test__sortf(void);
@@ -144,7 +203,8 @@ void test__getVoronoiWeights(void);
 void test__unique_i(void);
 /**
  * Testing the performance of the latticeDecorrelator, verifying that the inter-
- * channel cross-correlation coefficients are near 0 */
+ * channel cross-correlation coefficients are near 0, and that processing blocks
+ * of time slots in-place matches processing one time slot at a time */
 void test__latticeDecorrelator(void);
 /**
  * Testing that the coefficients computed with butterCoeffs() are numerically
@@ -154,6 +214,12 @@ void test__butterCoeffs(void);
  * Testing that the faf_IIRFilterbank can reconstruct the original signal power
  */
 void test__faf_IIRFilterbank(void);
+/**
+ * Testing that the multi-channel faf_IIRFilterbank gives the same output as
+ * one single-channel faf_IIRFilterbank per channel, whether its channels are
+ * filtered all at once or one at a time; also timing all three for 1..128
+ * channels */
+void test__faf_IIRFilterbank_multiChannel(void);
 /**
  * Testing computing the matrix exponential - comparing the output to that of
  * the "expm" function in Matlab */
@@ -172,6 +238,11 @@ void test__formulate_M_and_Cr(void);
  * Testing the formulate_M_and_Cr_cmplx() function, and verifying that the
  * output mixing matrices yield signals that have the target covariance */
 void test__formulate_M_and_Cr_cmplx(void);
+/**
+ * Testing that formulate_M_and_Cr_batch() and formulate_M_and_Cr_cmplx_batch()
+ * match their per-matrix counterparts (including the fallback used for larger
+ * matrices), and timing the two for a spreader-like workload */
+void test__formulate_M_and_Cr_batch(void);
 
 
 /* ========================================================================== */
@@ -204,6 +275,10 @@ void test__getSHcomplex(void);
 /**
  * Testing the spherical harmonic rotation matrix function getSHrotMtxReal() */
 void test__getSHrotMtxReal(void);
+/**
+ * Testing that the packed block-diagonal SH rotation matrices yield the same
+ * result as the dense SH rotation matrices; also timing them */
+void test__getSHrotMtxRealPacked(void);
 /**
  * Testing the real to complex spherical harmonic conversion, using
  * getSHcomplex() as the reference */
@@ -250,6 +325,29 @@ void test__resampleHRIRs(void);
  * Testing the ims shoebox simulator, when applying the echograms in the time-
  * domain */
 void test__ims_shoebox_TD(void);
+/**
+ * Testing that ims_shoebox_applyEchogramTD() is equivalent to convolving with
+ * the room impulse responses, when applied block-wise; also timing it */
+void test__ims_shoebox_TD_blockwise(void);
+/**
+ * Testing ims_shoebox_applyEchogramTD() with fractional delays (Lagrange
+ * interpolation, for different orders), against the block-wise/convolution
+ * equivalence and the integer delay output; also timing it */
+void test__ims_shoebox_TD_fractionalDelays(void);
+/**
+ * Testing that the ims shoebox buffers are allocated/freed along with the
+ * sources, and that growing the circular buffers keeps their past samples */
+void test__ims_shoebox_memoryUsage(void);
+/**
+ * Testing that echograms which are updated as the source and receiver move
+ * (and as the wall absorption and limits change) match those computed from
+ * scratch; also timing the updates */
+void test__ims_shoebox_echogramUpdate(void);
+/**
+ * Testing that spreading the source/receiver combinations of the ims shoebox
+ * simulator over a thread pool does not change the output; also timing a
+ * scene with 64 sources and 4 receivers for different numbers of threads */
+void test__ims_shoebox_threaded(void);
 /**
  * Testing the ims shoebox simulator, when generating room impulse respones
  * (RIRs) from the computed echograms */
@@ -276,6 +374,14 @@ void test__mysofa_load(void);
 /**
  * Testing that the two SOFA readers produce the same results */
 void test__sofa_comparison(void);
+/**
+ * Testing that the SOFA files in test/data (one contiguous, and one chunked
+ * with the shuffle and deflate filters) are loaded correctly by both readers */
+void test__sofa_testFiles(void);
+/**
+ * Times both SOFA readers on the files in test/data, and on the (big) file at
+ * SAF_TEST_SOFA_FILE_PATH if it exists */
+void test__sofa_reader_benchmark(void);
 
 #endif /* SAF_ENABLE_SOFA_READER_MODULE */
 
@@ -302,6 +408,11 @@ void test__tracker3d(void);
  * Testing the alias-free STFT filterbank (near)-perfect reconstruction
  * performance */
 void test__afSTFT(void);
+/**
+ * Testing that the afSTFT may transform fewer channels than it was created
+ * for (without re-allocating), and timing it versus the number of active
+ * channels */
+void test__afSTFT_activeChannels(void);
 /**
  * Testing the realloc2d_r() function (reallocating 2-D array, while retaining
  * the previous data order; except truncated or extended) */
@@ -339,6 +450,15 @@ void test__saf_example_ambi_enc(void);
  * Testing the SAF array2sh.h example (this may also serve as a tutorial on how
  * to use it) */
 void test__saf_example_array2sh(void);
+/**
+ * Testing the SAF binauraliser.h example (this may also serve as a tutorial on
+ * how to use it) */
+void test__saf_example_binauraliser(void);
+/**
+ * Testing that the binauraliser.h example fades from the previous HRTFs of a
+ * source to the new ones over several hops, when the source moves (even if the
+ * frame size is only one hop) */
+void test__saf_example_binauraliser_hrtfFade(void);
 /**
  * Testing the SAF rotator.h example (this may also serve as a tutorial on how
  * to use it) */
@@ -92,10 +92,22 @@ int main_test(void) {
     RUN_TEST(test__saf_stft_50pc_overlap);
     RUN_TEST(test__saf_stft_LTI);
     RUN_TEST(test__saf_matrixConv);
+    RUN_TEST(test__saf_matrixConv_partitioned);
+    RUN_TEST(test__saf_matrixConv_threaded);
+    RUN_TEST(test__saf_rcu);
+    RUN_TEST(test__saf_fileCache);
+    RUN_TEST(test__saf_multiConv);
+    RUN_TEST(test__saf_multiConv_hopLoad);
     RUN_TEST(test__saf_rfft);
+    RUN_TEST(test__saf_rfft_batch);
     RUN_TEST(test__saf_fft);
+    RUN_TEST(test__saf_fft_vs_kissFFT);
+    RUN_TEST(test__utility_simdDispatch);
     RUN_TEST(test__qmf);
+    RUN_TEST(test__qmf_fftModulation);
+    RUN_TEST(test__qmf_ringBuffers);
     RUN_TEST(test__smb_pitchShifter);
+    RUN_TEST(test__smb_pitchShifter_fast);
     RUN_TEST(test__sortf);
     RUN_TEST(test__sortz);
     RUN_TEST(test__cmplxPairUp);
@@ -104,11 +116,13 @@ int main_test(void) {
     RUN_TEST(test__latticeDecorrelator);
     RUN_TEST(test__butterCoeffs);
     RUN_TEST(test__faf_IIRFilterbank);
+    RUN_TEST(test__faf_IIRFilterbank_multiChannel);
     RUN_TEST(test__gexpm);
 
     /* SAF cdf4sap module unit tests */
     RUN_TEST(test__formulate_M_and_Cr);
     RUN_TEST(test__formulate_M_and_Cr_cmplx);
+    RUN_TEST(test__formulate_M_and_Cr_batch);
 
     /* SAF hoa module unit tests */
     RUN_TEST(test__getLoudspeakerDecoderMtx);
@@ -119,6 +133,7 @@ int main_test(void) {
     RUN_TEST(test__getSHreal_recur);
     RUN_TEST(test__getSHcomplex);
     RUN_TEST(test__getSHrotMtxReal);
+    RUN_TEST(test__getSHrotMtxRealPacked);
     RUN_TEST(test__real2complexSHMtx);
     RUN_TEST(test__complex2realSHMtx);
     RUN_TEST(test__computeSectorCoeffsEP);
@@ -134,6 +149,11 @@ int main_test(void) {
     /* SAF reverb modules unit tests */
     RUN_TEST(test__ims_shoebox_RIR);
     RUN_TEST(test__ims_shoebox_TD);
+    RUN_TEST(test__ims_shoebox_TD_blockwise);
+    RUN_TEST(test__ims_shoebox_TD_fractionalDelays);
+    RUN_TEST(test__ims_shoebox_memoryUsage);
+    RUN_TEST(test__ims_shoebox_echogramUpdate);
+    RUN_TEST(test__ims_shoebox_threaded);
 
     /* SAF vbap modules unit tests */
 
@@ -142,6 +162,8 @@ int main_test(void) {
     RUN_TEST(test__saf_sofa_open);
     RUN_TEST(test__mysofa_load);
     RUN_TEST(test__sofa_comparison);
+    RUN_TEST(test__sofa_testFiles);
+    RUN_TEST(test__sofa_reader_benchmark);
 #endif /* SAF_ENABLE_SOFA_READER_MODULE */
 
     /* SAF tracker module unit tests */
@@ -151,6 +173,7 @@ int main_test(void) {
 
     /* SAF resources unit tests */
     RUN_TEST(test__afSTFT);
+    RUN_TEST(test__afSTFT_activeChannels);
     RUN_TEST(test__realloc2d_r);
     RUN_TEST(test__malloc4d);
     RUN_TEST(test__malloc5d);
@@ -162,6 +185,8 @@ int main_test(void) {
     RUN_TEST(test__saf_example_ambi_dec);
     RUN_TEST(test__saf_example_ambi_enc);
     RUN_TEST(test__saf_example_array2sh); 
+    RUN_TEST(test__saf_example_binauraliser);
+    RUN_TEST(test__saf_example_binauraliser_hrtfFade);
     RUN_TEST(test__saf_example_rotator);
     RUN_TEST(test__saf_example_spreader);
 #endif /* SAF_ENABLE_EXAMPLES_TESTS */
@@ -343,3 +343,185 @@ void test__formulate_M_and_Cr_cmplx(void){
     }
 }
 
+
+void test__formulate_M_and_Cr_batch(void){
+    int i, j, k, b, cfg, isComplex, energyFLAG, nX, nY, lenSig, maxX;
+    float reg, maxM, maxCr;
+    float_complex** x, **y, *Cx, *Cy, *Q, *M, *Cr, *M_batch, *Cr_batch;
+    float* Cx_re, *Cy_re, *Q_re, *M_re, *Cr_re, *M_batch_re, *Cr_batch_re;
+    void* hCdf, *hCdf_batch;
+    double t_single, t_batch;
+    tick_t start;
+    const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+
+    /* Config */
+    const float acceptedTolerance = 0.001f; /* relative to the largest entry */
+    const int batchSize = 37; /* deliberately not a multiple of the lane count */
+    const int nConfigs = 6;
+    const int configs[6][2] = { {2,2}, {4,4}, {8,8}, {6,4}, {4,6}, {14,14} }; /* nX, nY; the last exceeds the batched limit */
+    const int nBenchBands = 133, nBenchSources = 4, nBenchQ = 3;
+    const int benchQ[3] = { 2, 4, 8 };
+
+    /* Compare the batched solver with the per-matrix solver on random problems */
+    reg = 0.2f;
+    for(isComplex=0; isComplex<2; isComplex++){
+        for(cfg=0; cfg<nConfigs; cfg++){
+            nX = configs[cfg][0];
+            nY = configs[cfg][1];
+            lenSig = 4*SAF_MAX(nX, nY); /* ensures full-rank covariance matrices */
+            x = (float_complex**)malloc2d(SAF_MAX(nX, nY), lenSig, sizeof(float_complex));
+            y = (float_complex**)malloc2d(SAF_MAX(nX, nY), lenSig, sizeof(float_complex));
+            Cx = malloc1d(batchSize*nX*nX*sizeof(float_complex));
+            Cy = malloc1d(batchSize*nY*nY*sizeof(float_complex));
+            Q = calloc1d(nY*nX, sizeof(float_complex));
+            M = malloc1d(nY*nX*sizeof(float_complex));
+            Cr = malloc1d(nY*nY*sizeof(float_complex));
+            M_batch = malloc1d(batchSize*nY*nX*sizeof(float_complex));
+            Cr_batch = malloc1d(batchSize*nY*nY*sizeof(float_complex));
+            Cx_re = malloc1d(batchSize*nX*nX*sizeof(float));
+            Cy_re = malloc1d(batchSize*nY*nY*sizeof(float));
+            Q_re = calloc1d(nY*nX, sizeof(float));
+            M_re = malloc1d(nY*nX*sizeof(float));
+            Cr_re = malloc1d(nY*nY*sizeof(float));
+            M_batch_re = malloc1d(batchSize*nY*nX*sizeof(float));
+            Cr_batch_re = malloc1d(batchSize*nY*nY*sizeof(float));
+            for(i=0; i<SAF_MIN(nX, nY); i++){
+                Q[i*nX+i] = cmplxf(1.0f, 0.0f);
+                Q_re[i*nX+i] = 1.0f;
+            }
+
+            /* Input and target covariance matrices */
+            for(b=0; b<batchSize; b++){
+                if(isComplex){
+                    rand_cmplx_m1_1(FLATTEN2D(x), nX*lenSig);
+                    rand_cmplx_m1_1(FLATTEN2D(y), nY*lenSig);
+                    cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, nX, nX, lenSig, &calpha,
+                                FLATTEN2D(x), lenSig,
+                                FLATTEN2D(x), lenSig, &cbeta,
+                                &Cx[b*nX*nX], nX);
+                    cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, nY, nY, lenSig, &calpha,
+                                FLATTEN2D(y), lenSig,
+                                FLATTEN2D(y), lenSig, &cbeta,
+                                &Cy[b*nY*nY], nY);
+                }
+                else{
+                    rand_m1_1((float*)FLATTEN2D(x), nX*lenSig);
+                    rand_m1_1((float*)FLATTEN2D(y), nY*lenSig);
+                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, nX, nX, lenSig, 1.0f,
+                                (float*)FLATTEN2D(x), lenSig,
+                                (float*)FLATTEN2D(x), lenSig, 0.0f,
+                                &Cx_re[b*nX*nX], nX);
+                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, nY, nY, lenSig, 1.0f,
+                                (float*)FLATTEN2D(y), lenSig,
+                                (float*)FLATTEN2D(y), lenSig, 0.0f,
+                                &Cy_re[b*nY*nY], nY);
+                }
+            }
+
+            for(energyFLAG=0; energyFLAG<2; energyFLAG++){
+                if(isComplex){
+                    cdf4sap_cmplx_batch_create(&hCdf_batch, nX, nY);
+                    formulate_M_and_Cr_cmplx_batch(hCdf_batch, batchSize, Cx, Cy, Q, energyFLAG, reg, M_batch, Cr_batch);
+                    cdf4sap_cmplx_batch_destroy(&hCdf_batch);
+                    cdf4sap_cmplx_create(&hCdf, nX, nY);
+                    for(b=0; b<batchSize; b++){
+                        formulate_M_and_Cr_cmplx(hCdf, &Cx[b*nX*nX], &Cy[b*nY*nY], Q, energyFLAG, reg, M, Cr);
+                        maxM = maxCr = 0.0f;
+                        for(i=0; i<nY*nX; i++)
+                            maxM = SAF_MAX(maxM, cabsf(M[i]));
+                        for(i=0; i<nY*nY; i++) /* (Cr may be pure round-off, so scale by Cy) */
+                            maxCr = SAF_MAX(maxCr, cabsf(Cy[b*nY*nY+i]));
+                        for(i=0; i<nY*nX; i++){
+                            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*maxM, crealf(M[i]), crealf(M_batch[b*nY*nX+i]));
+                            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*maxM, cimagf(M[i]), cimagf(M_batch[b*nY*nX+i]));
+                        }
+                        for(i=0; i<nY*nY; i++){
+                            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*maxCr, crealf(Cr[i]), crealf(Cr_batch[b*nY*nY+i]));
+                            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*maxCr, cimagf(Cr[i]), cimagf(Cr_batch[b*nY*nY+i]));
+                        }
+                    }
+                    cdf4sap_cmplx_destroy(&hCdf);
+                }
+                else{
+                    cdf4sap_batch_create(&hCdf_batch, nX, nY);
+                    formulate_M_and_Cr_batch(hCdf_batch, batchSize, Cx_re, Cy_re, Q_re, energyFLAG, reg, M_batch_re, Cr_batch_re);
+                    cdf4sap_batch_destroy(&hCdf_batch);
+                    cdf4sap_create(&hCdf, nX, nY);
+                    for(b=0; b<batchSize; b++){
+                        formulate_M_and_Cr(hCdf, &Cx_re[b*nX*nX], &Cy_re[b*nY*nY], Q_re, energyFLAG, reg, M_re, Cr_re);
+                        maxM = maxCr = 0.0f;
+                        for(i=0; i<nY*nX; i++)
+                            maxM = SAF_MAX(maxM, fabsf(M_re[i]));
+                        for(i=0; i<nY*nY; i++) /* (Cr may be pure round-off, so scale by Cy) */
+                            maxCr = SAF_MAX(maxCr, fabsf(Cy_re[b*nY*nY+i]));
+                        for(i=0; i<nY*nX; i++)
+                            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*maxM, M_re[i], M_batch_re[b*nY*nX+i]);
+                        for(i=0; i<nY*nY; i++)
+                            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*maxCr, Cr_re[i], Cr_batch_re[b*nY*nY+i]);
+                    }
+                    cdf4sap_destroy(&hCdf);
+                }
+            }
+
+            /* Clean-up */
+            free(x);
+            free(y);
+            free(Cx);
+            free(Cy);
+            free(Q);
+            free(M);
+            free(Cr);
+            free(M_batch);
+            free(Cr_batch);
+            free(Cx_re);
+            free(Cy_re);
+            free(Q_re);
+            free(M_re);
+            free(Cr_re);
+            free(M_batch_re);
+            free(Cr_batch_re);
+        }
+    }
+
+    /* Time the two solvers for a spreader-like workload (complex, square) */
+    for(k=0; k<nBenchQ; k++){
+        nX = nY = benchQ[k];
+        lenSig = 4*nX;
+        maxX = nBenchBands*nBenchSources;
+        x = (float_complex**)malloc2d(nX, lenSig, sizeof(float_complex));
+        Cx = malloc1d(maxX*nX*nX*sizeof(float_complex));
+        Cy = malloc1d(maxX*nX*nX*sizeof(float_complex));
+        Q = calloc1d(nX*nX, sizeof(float_complex));
+        M = malloc1d(maxX*nX*nX*sizeof(float_complex));
+        for(i=0; i<nX; i++)
+            Q[i*nX+i] = cmplxf(1.0f, 0.0f);
+        for(b=0; b<maxX; b++){
+            rand_cmplx_m1_1(FLATTEN2D(x), nX*lenSig);
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, nX, nX, lenSig, &calpha,
+                        FLATTEN2D(x), lenSig,
+                        FLATTEN2D(x), lenSig, &cbeta,
+                        &Cx[b*nX*nX], nX);
+            for(i=0; i<nX; i++)
+                for(j=0; j<nX; j++)
+                    Cy[b*nX*nX+i*nX+j] = Cx[b*nX*nX+j*nX+i]; /* any valid covariance will do */
+        }
+        cdf4sap_cmplx_create(&hCdf, nX, nX);
+        start = timer_current();
+        for(b=0; b<maxX; b++)
+            formulate_M_and_Cr_cmplx(hCdf, &Cx[b*nX*nX], &Cy[b*nX*nX], Q, 0, reg, &M[b*nX*nX], NULL);
+        t_single = (double)timer_elapsed(start);
+        cdf4sap_cmplx_destroy(&hCdf);
+        cdf4sap_cmplx_batch_create(&hCdf_batch, nX, nX);
+        start = timer_current();
+        for(b=0; b<nBenchSources; b++)
+            formulate_M_and_Cr_cmplx_batch(hCdf_batch, nBenchBands, &Cx[b*nBenchBands*nX*nX], &Cy[b*nBenchBands*nX*nX], Q, 0, reg, &M[b*nBenchBands*nX*nX], NULL);
+        t_batch = (double)timer_elapsed(start);
+        cdf4sap_cmplx_batch_destroy(&hCdf_batch);
+        printf("    Q=%d, %d bands x %d sources: per-matrix %.3f ms, batched %.3f ms\n", nX, nBenchBands, nBenchSources, 1e3*t_single, 1e3*t_batch);
+        free(x);
+        free(Cx);
+        free(Cy);
+        free(Q);
+        free(M);
+    }
+}
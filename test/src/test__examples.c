@@ -354,6 +354,182 @@ void test__saf_example_array2sh(void){
     free(shSig_frame);
 }
 
+void test__saf_example_binauraliser(void){
+    int i, ch, framesize, nSources;
+    void* hBin, *hBin_rot;
+    float** inSigs, **outSigs, **outSigs_rot;
+    float** inSig_frame, **outSig_frame;
+    tick_t start;
+    double elapsed;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int fs = 48000;
+    const int signalLength = fs;
+    const float yaw_deg = 60.0f;
+
+    /* Create and initialise two instances of binauraliser: the first with a
+     * source at yaw_deg, and the second with a source at 0 degrees and the
+     * scene rotated by yaw_deg */
+    binauraliser_create(&hBin);
+    binauraliser_create(&hBin_rot);
+    binauraliser_setUseDefaultHRIRsflag(hBin, 1);
+    binauraliser_setUseDefaultHRIRsflag(hBin_rot, 1);
+    binauraliser_setNumSources(hBin, 1);
+    binauraliser_setNumSources(hBin_rot, 1);
+    binauraliser_setSourceAzi_deg(hBin, 0, yaw_deg);
+    binauraliser_setSourceAzi_deg(hBin_rot, 0, 0.0f);
+    binauraliser_setEnableRotation(hBin_rot, 1);
+    binauraliser_setYaw(hBin_rot, yaw_deg);
+    binauraliser_init(hBin, fs);
+    binauraliser_init(hBin_rot, fs);
+    binauraliser_initCodec(hBin);
+    binauraliser_initCodec(hBin_rot);
+
+    /* Define input mono signal */
+    nSources = binauraliser_getMaxNumSources();
+    inSigs = (float**)malloc2d(nSources,signalLength,sizeof(float));
+    outSigs = (float**)calloc2d(NUM_EARS,signalLength,sizeof(float));
+    outSigs_rot = (float**)calloc2d(NUM_EARS,signalLength,sizeof(float));
+    rand_m1_1(FLATTEN2D(inSigs), nSources*signalLength); /* white-noise signals */
+
+    /* Apply binauraliser */
+    framesize = binauraliser_getFrameSize();
+    inSig_frame = (float**)malloc1d(nSources*sizeof(float*));
+    outSig_frame = (float**)malloc1d(NUM_EARS*sizeof(float*));
+    for(i=0; i<(int)((float)signalLength/(float)framesize); i++){
+        for(ch=0; ch<nSources; ch++)
+            inSig_frame[ch] = &inSigs[ch][i*framesize];
+        for(ch=0; ch<NUM_EARS; ch++)
+            outSig_frame[ch] = &outSigs[ch][i*framesize];
+        binauraliser_process(hBin, (const float* const*)inSig_frame, outSig_frame, 1, NUM_EARS, framesize);
+        for(ch=0; ch<NUM_EARS; ch++)
+            outSig_frame[ch] = &outSigs_rot[ch][i*framesize];
+        binauraliser_process(hBin_rot, (const float* const*)inSig_frame, outSig_frame, 1, NUM_EARS, framesize);
+    }
+
+    /* Both should have arrived at the same HRTFs */
+    for(ch=0; ch<NUM_EARS; ch++)
+        for(i=0; i<signalLength; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outSigs[ch][i], outSigs_rot[ch][i]);
+
+    /* The maximum number of sources, with the head-rotation being updated every
+     * frame (the interpolated HRTFs of recently visited directions are cached) */
+    binauraliser_setInputConfigPreset(hBin_rot, SOURCE_CONFIG_PRESET_T_DESIGN_60);
+    binauraliser_setNumSources(hBin_rot, nSources);
+    binauraliser_initCodec(hBin_rot);
+    start = timer_current();
+    for(i=0; i<(int)((float)signalLength/(float)framesize); i++){
+        binauraliser_setYaw(hBin_rot, 10.0f*sinf(2.0f*SAF_PI*(float)(i*framesize)/(float)fs)); /* 1 Hz head-shake */
+        for(ch=0; ch<nSources; ch++)
+            inSig_frame[ch] = &inSigs[ch][i*framesize];
+        for(ch=0; ch<NUM_EARS; ch++)
+            outSig_frame[ch] = &outSigs_rot[ch][i*framesize];
+        binauraliser_process(hBin_rot, (const float* const*)inSig_frame, outSig_frame, nSources, NUM_EARS, framesize);
+    }
+    elapsed = (double)timer_elapsed(start);
+    printf("    %d sources, head-rotation updated every frame: %lfs (for %lfs of audio)\n", nSources, elapsed, (double)signalLength/(double)fs);
+    for(ch=0; ch<NUM_EARS; ch++)
+        for(i=0; i<signalLength; i++)
+            TEST_ASSERT_FALSE(isnan(outSigs_rot[ch][i]) || isinf(outSigs_rot[ch][i]));
+
+    /* Clean-up */
+    binauraliser_destroy(&hBin);
+    binauraliser_destroy(&hBin_rot);
+    free(inSigs);
+    free(outSigs);
+    free(outSigs_rot);
+    free(inSig_frame);
+    free(outSig_frame);
+}
+
+void test__saf_example_binauraliser_hrtfFade(void){
+    int i, k, ch, fr, framesize, nFrames, nIntermediate;
+    void* hBin[3];
+    float* inSig, ***outSigs;
+    float* inSig_frame[1], *outSig_frame[NUM_EARS];
+    double distA, distB, distAB, distA_prev;
+
+    /* Config */
+    const float acceptedTolerance = 0.0001f;
+    const int fs = 48000;
+    const int switchFrame = 100;
+    const float azi_A = 90.0f;
+    const float azi_B = -90.0f;
+
+    /* Three instances of binauraliser, each with one source: the first at
+     * azi_A, the second at azi_B, and the third at azi_A, which then moves to
+     * azi_B at the start of frame 'switchFrame' */
+    for(k=0; k<3; k++){
+        binauraliser_create(&hBin[k]);
+        binauraliser_setUseDefaultHRIRsflag(hBin[k], 1);
+        binauraliser_setNumSources(hBin[k], 1);
+        binauraliser_setSourceAzi_deg(hBin[k], 0, k==1 ? azi_B : azi_A);
+        binauraliser_init(hBin[k], fs);
+        binauraliser_initCodec(hBin[k]);
+    }
+
+    /* Input signal (deterministic, so that the random number sequence of the
+     * other tests is not disturbed) */
+    framesize = binauraliser_getFrameSize();
+    nFrames = 2*switchFrame;
+    inSig = malloc1d(nFrames*framesize*sizeof(float));
+    for(i=0; i<nFrames*framesize; i++)
+        inSig[i] = sinf(0.1f*(float)i) + 0.5f*sinf(0.95f*(float)i);
+    outSigs = (float***)malloc3d(3, NUM_EARS, nFrames*framesize, sizeof(float));
+
+    /* Apply binauraliser */
+    for(fr=0; fr<nFrames; fr++){
+        if(fr==switchFrame)
+            binauraliser_setSourceAzi_deg(hBin[2], 0, azi_B);
+        inSig_frame[0] = &inSig[fr*framesize];
+        for(k=0; k<3; k++){
+            for(ch=0; ch<NUM_EARS; ch++)
+                outSig_frame[ch] = &outSigs[k][ch][fr*framesize];
+            binauraliser_process(hBin[k], (const float* const*)inSig_frame, outSig_frame, 1, NUM_EARS, framesize);
+        }
+    }
+
+    /* Before the switch, the output should be that of a source at azi_A, and
+     * long after the switch, that of a source at azi_B */
+    for(ch=0; ch<NUM_EARS; ch++){
+        for(i=0; i<switchFrame*framesize; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outSigs[0][ch][i], outSigs[2][ch][i]);
+        for(i=(nFrames-switchFrame/2)*framesize; i<nFrames*framesize; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outSigs[1][ch][i], outSigs[2][ch][i]);
+    }
+
+    /* In between, the HRTFs should be faded from those of azi_A to those of
+     * azi_B over several hops; i.e. the output should move steadily away from
+     * that of azi_A and towards that of azi_B, and lie clearly in between the
+     * two for more frames than the filterbank alone would smear an abrupt
+     * switch over (one frame, for the default frame size) */
+    nIntermediate = 0;
+    distA_prev = 0.0;
+    for(fr=switchFrame; fr<nFrames; fr++){
+        distA = distB = distAB = 0.0;
+        for(i=fr*framesize; i<(fr+1)*framesize; i++){
+            distA  += pow((double)(outSigs[2][0][i] - outSigs[0][0][i]), 2.0);
+            distB  += pow((double)(outSigs[2][0][i] - outSigs[1][0][i]), 2.0);
+            distAB += pow((double)(outSigs[0][0][i] - outSigs[1][0][i]), 2.0);
+        }
+        distA = sqrt(distA/distAB);
+        distB = sqrt(distB/distAB);
+        if(distA>0.1 && distB>0.1){
+            nIntermediate++;
+            TEST_ASSERT_TRUE(distA>distA_prev);
+        }
+        distA_prev = distA;
+    }
+    TEST_ASSERT_TRUE(nIntermediate>=3);
+
+    /* Clean-up */
+    for(k=0; k<3; k++)
+        binauraliser_destroy(&hBin[k]);
+    free(inSig);
+    free(outSigs);
+}
+
 void test__saf_example_rotator(void){
     int ch, nSH, i, j, delay, framesize;
     void* hRot;
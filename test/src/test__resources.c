@@ -99,6 +99,84 @@ void test__afSTFT(void){
     free(freqVector);
 }
 
+void test__afSTFT_activeChannels(void){
+    int frame, ch, band, t, n, nActive, prevActive, nBands, nHops;
+    void* hSTFT, *hSTFT_ref;
+    double elapsed;
+    float** inframe, **outframe, **outframe_ref;
+    float_complex*** inspec, ***inspec_ref;
+    tick_t start;
+
+    /* prep */
+    const float acceptedTolerance = 1e-5f;
+    const int framesize = 512;
+    const int hopsize = 128;
+    const int hybridMode = 1;
+    const int maxNumCH = 64;
+    const int nFrames = 20;
+    const int nBenchFrames = 200;
+    inframe = (float**)malloc2d(maxNumCH,framesize,sizeof(float));
+    outframe = (float**)malloc2d(maxNumCH,framesize,sizeof(float));
+    outframe_ref = (float**)malloc2d(maxNumCH,framesize,sizeof(float));
+
+    /* Set-up, for the maximum number of channels */
+    nHops = framesize/hopsize;
+    afSTFT_create(&hSTFT, maxNumCH, maxNumCH, hopsize, 0, hybridMode, AFSTFT_BANDS_CH_TIME);
+    nBands = afSTFT_getNBands(hSTFT);
+    inspec = (float_complex***)malloc3d(nBands, maxNumCH, nHops, sizeof(float_complex));
+    inspec_ref = (float_complex***)malloc3d(nBands, maxNumCH, nHops, sizeof(float_complex));
+
+    /* Increase the number of active channels (without clearing or re-allocating), and check that the newly activated
+     * channels are equivalent to those of an afSTFT configured for exactly that number of channels */
+    prevActive = 0;
+    for(nActive=1; nActive<=maxNumCH; nActive*=2){
+        afSTFT_create(&hSTFT_ref, nActive, nActive, hopsize, 0, hybridMode, AFSTFT_BANDS_CH_TIME);
+        for(frame=0; frame<nFrames; frame++){
+            rand_m1_1(FLATTEN2D(inframe), maxNumCH*framesize);
+            afSTFT_forward_knownDimensions_nCH(hSTFT, inframe, framesize, maxNumCH, nHops, nActive, inspec);
+            afSTFT_forward_knownDimensions(hSTFT_ref, inframe, framesize, maxNumCH, nHops, inspec_ref);
+            for(band=0; band<nBands; band++){
+                for(ch=prevActive; ch<nActive; ch++){
+                    for(t=0; t<nHops; t++){
+                        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(inspec_ref[band][ch][t]), crealf(inspec[band][ch][t]));
+                        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(inspec_ref[band][ch][t]), cimagf(inspec[band][ch][t]));
+                    }
+                }
+            }
+            afSTFT_backward_knownDimensions_nCH(hSTFT, inspec_ref, framesize, maxNumCH, nHops, nActive, outframe);
+            afSTFT_backward_knownDimensions(hSTFT_ref, inspec_ref, framesize, maxNumCH, nHops, outframe_ref);
+            for(ch=prevActive; ch<nActive; ch++)
+                for(n=0; n<framesize; n++)
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outframe_ref[ch][n], outframe[ch][n]);
+        }
+        afSTFT_destroy(&hSTFT_ref);
+        prevActive = nActive;
+    }
+
+    /* CPU time of the forward+backward transforms, as a function of the number of active channels */
+    printf("    afSTFT %d channels, hop %d, forward+backward:", maxNumCH, hopsize);
+    rand_m1_1(FLATTEN2D(inframe), maxNumCH*framesize);
+    for(nActive=1; nActive<=maxNumCH; nActive*=2){
+        afSTFT_clearBuffers(hSTFT);
+        start = timer_current();
+        for(frame=0; frame<nBenchFrames; frame++){
+            afSTFT_forward_knownDimensions_nCH(hSTFT, inframe, framesize, maxNumCH, nHops, nActive, inspec);
+            afSTFT_backward_knownDimensions_nCH(hSTFT, inspec, framesize, maxNumCH, nHops, nActive, outframe);
+        }
+        elapsed = (double)timer_elapsed(start);
+        printf(" %d active %lfms/frame;", nActive, 1e3*elapsed/(double)nBenchFrames);
+    }
+    printf("\n");
+
+    /* Clean-up */
+    afSTFT_destroy(&hSTFT);
+    free(inframe);
+    free(outframe);
+    free(outframe_ref);
+    free(inspec);
+    free(inspec_ref);
+}
+
 void test__realloc2d_r(void){
     int s, r, i, j, k;
     typedef struct _test_data{
@@ -151,3 +151,547 @@ void test__ims_shoebox_TD(void){
     free(rec_sh_outsigs);
     ims_shoebox_destroy(&hIms);
 }
+
+void test__ims_shoebox_TD_blockwise(void){
+    void* hIms, *hIms_ir;
+    float* src_frame;
+    float** src_sig, **ir_sig, **src_sig_rep, **rec_frame, **rec_sig, ***rec_irs, **ref;
+    int i, ch, frame, nFrames, receiverID, irReceiverID;
+    double elapsed;
+    tick_t start;
+
+    /* Config */
+    const float acceptedTolerance = 0.001f;
+    const int signalLength = 8192;
+    const int framesize = 512;
+    const int sh_order = 1;
+    const int nSH = ORDER2NSH(sh_order);
+    const int nBands = 5;
+    const int nBenchSources = 8;
+    const int nBenchFrames = 20;
+    const float maxTime_s = 0.05f; /* 50ms */
+    const float abs_wall[5][6] =  /* Absorption Coefficients per Octave band, and per wall */
+      { {0.180791250f, 0.207307300f, 0.134990800f, 0.229002250f, 0.212128400f, 0.241055000f},
+        {0.225971250f, 0.259113700f, 0.168725200f, 0.286230250f, 0.265139600f, 0.301295000f},
+        {0.258251250f, 0.296128100f, 0.192827600f, 0.327118250f, 0.303014800f, 0.344335000f},
+        {0.301331250f, 0.345526500f, 0.224994001f, 0.381686250f, 0.353562000f, 0.401775000f},
+        {0.361571250f, 0.414601700f, 0.269973200f, 0.457990250f, 0.424243600f, 0.482095000f} };
+    const float src_pos[3]  = {5.1f, 6.0f, 1.1f};
+    const float rec_pos[3]  = {8.8f, 5.5f, 0.9f};
+    const float roomdims[3] = {10.0f, 7.0f, 3.0f};
+
+    /* Allocate memory */
+    src_sig = (float**)malloc2d(1, signalLength, sizeof(float));
+    ir_sig = (float**)calloc2d(1, signalLength, sizeof(float));
+    src_sig_rep = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    src_frame = malloc1d(framesize*sizeof(float));
+    rec_frame = (float**)malloc2d(nSH, framesize, sizeof(float));
+    rec_sig = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    rec_irs = (float***)malloc3d(1, nSH, signalLength, sizeof(float));
+    ref = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    rand_m1_1(src_sig[0], signalLength);
+
+    /* Set-up two identical rooms, with one source and one spherical harmonic receiver */
+    ims_shoebox_create(&hIms, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, 48e3f);
+    ims_shoebox_create(&hIms_ir, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, 48e3f);
+    ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+    receiverID = ims_shoebox_addReceiverSH(hIms, sh_order, (float*)rec_pos, &rec_frame);
+    ims_shoebox_addSource(hIms_ir, (float*)src_pos, &ir_sig[0]);
+    irReceiverID = ims_shoebox_addReceiverSH(hIms_ir, sh_order, (float*)rec_pos, &rec_irs[0]);
+    ims_shoebox_computeEchograms(hIms, -1, maxTime_s);
+    ims_shoebox_computeEchograms(hIms_ir, -1, maxTime_s);
+
+    /* The first frame after computing new echograms is cross-faded with the previous (empty) echograms, so start with silence */
+    memset(src_frame, 0, framesize*sizeof(float));
+    ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, 0);
+    ims_shoebox_applyEchogramTD(hIms_ir, irReceiverID, signalLength, 0);
+
+    /* Obtain the impulse responses, by processing a unit impulse all at once */
+    ir_sig[0][0] = 1.0f;
+    ims_shoebox_applyEchogramTD(hIms_ir, irReceiverID, signalLength, 0);
+
+    /* Process the source signal block-wise */
+    nFrames = signalLength/framesize;
+    for(frame=0; frame<nFrames; frame++){
+        memcpy(src_frame, &src_sig[0][frame*framesize], framesize*sizeof(float));
+        ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, 0);
+        for(ch=0; ch<nSH; ch++)
+            memcpy(&rec_sig[ch][frame*framesize], rec_frame[ch], framesize*sizeof(float));
+    }
+
+    /* The output should be equal to the source signal convolved with the impulse responses */
+    for(ch=0; ch<nSH; ch++)
+        memcpy(src_sig_rep[ch], src_sig[0], signalLength*sizeof(float));
+    fftfilt(FLATTEN2D(src_sig_rep), FLATTEN3D(rec_irs), signalLength, signalLength, nSH, FLATTEN2D(ref));
+    for(ch=0; ch<nSH; ch++)
+        for(i=0; i<signalLength; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, ref[ch][i], rec_sig[ch][i]);
+
+    /* Time the rendering with some more sources */
+    for(i=1; i<nBenchSources; i++)
+        ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+    ims_shoebox_computeEchograms(hIms, -1, maxTime_s);
+    start = timer_current();
+    for(frame=0; frame<nBenchFrames; frame++){
+        rand_m1_1(src_frame, framesize);
+        ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, 0);
+    }
+    elapsed = (double)timer_elapsed(start);
+    printf("    ims_shoebox_applyEchogramTD: %d sources, %d bands, SH order %d, %.0fms echograms: %lfms per %d sample frame\n",
+           nBenchSources, nBands, sh_order, 1e3f*maxTime_s, 1e3*elapsed/(double)nBenchFrames, framesize);
+
+    /* clean-up */
+    free(src_sig);
+    free(ir_sig);
+    free(src_sig_rep);
+    free(src_frame);
+    free(rec_frame);
+    free(rec_sig);
+    free(rec_irs);
+    free(ref);
+    ims_shoebox_destroy(&hIms);
+    ims_shoebox_destroy(&hIms_ir);
+}
+
+void test__ims_shoebox_TD_fractionalDelays(void){
+    void* hIms, *hIms_ir;
+    float* src_frame;
+    float** src_sig, **ir_sig, **src_sig_rep, **rec_frame, **rec_sig, ***rec_irs, **ref, **rec_sig_int, **rec_sig_max;
+    float err, energy;
+    int i, ch, frame, nFrames, receiverID, irReceiverID, o, order, fracFLAG;
+    double elapsed;
+    tick_t start;
+
+    /* Config */
+    const float acceptedTolerance = 0.001f;
+    const float acceptedRelTolerance_int = 0.05f;  /* integer delays: up to half a sample out */
+    const float acceptedRelTolerance_ord = 0.01f;  /* interpolation orders should all agree at this frequency */
+    const int orders[5] = {IMS_MAX_LAGRANGE_ORDER, 1, 2, 3, 5};
+    const int signalLength = 8192;
+    const int framesize = 512;
+    const int steadyState = 4096;
+    const int sh_order = 1;
+    const int nSH = ORDER2NSH(sh_order);
+    const int nBands = 5;
+    const int nBenchSources = 8;
+    const int nBenchFrames = 20;
+    const float maxTime_s = 0.05f; /* 50ms */
+    const float freq = 500.0f;
+    const float fs = 48e3f;
+    const float abs_wall[5][6] =  /* Absorption Coefficients per Octave band, and per wall */
+      { {0.180791250f, 0.207307300f, 0.134990800f, 0.229002250f, 0.212128400f, 0.241055000f},
+        {0.225971250f, 0.259113700f, 0.168725200f, 0.286230250f, 0.265139600f, 0.301295000f},
+        {0.258251250f, 0.296128100f, 0.192827600f, 0.327118250f, 0.303014800f, 0.344335000f},
+        {0.301331250f, 0.345526500f, 0.224994001f, 0.381686250f, 0.353562000f, 0.401775000f},
+        {0.361571250f, 0.414601700f, 0.269973200f, 0.457990250f, 0.424243600f, 0.482095000f} };
+    const float src_pos[3]  = {5.1f, 6.0f, 1.1f};
+    const float rec_pos[3]  = {8.8f, 5.5f, 0.9f};
+    const float roomdims[3] = {10.0f, 7.0f, 3.0f};
+
+    /* Allocate memory */
+    src_sig = (float**)malloc2d(1, signalLength, sizeof(float));
+    ir_sig = (float**)calloc2d(1, signalLength, sizeof(float));
+    src_sig_rep = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    src_frame = malloc1d(framesize*sizeof(float));
+    rec_frame = (float**)malloc2d(nSH, framesize, sizeof(float));
+    rec_sig = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    rec_sig_int = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    rec_sig_max = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    rec_irs = (float***)malloc3d(1, nSH, signalLength, sizeof(float));
+    ref = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    for(i=0; i<signalLength; i++)
+        src_sig[0][i] = sinf(2.0f*SAF_PI*freq*(float)i/fs);
+
+    /* Render the sine block-wise with integer delays, and then with each interpolation order */
+    for(o=-1; o<5; o++){
+        fracFLAG = o>=0 ? 1 : 0;
+        order = o>=0 ? orders[o] : 0;
+
+        /* Set-up two identical rooms, with one source and one spherical harmonic receiver */
+        ims_shoebox_create(&hIms, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, fs);
+        ims_shoebox_create(&hIms_ir, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, fs);
+        if(fracFLAG){
+            ims_shoebox_setFractionalDelayOrder(hIms, order);
+            ims_shoebox_setFractionalDelayOrder(hIms_ir, order);
+        }
+        ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+        receiverID = ims_shoebox_addReceiverSH(hIms, sh_order, (float*)rec_pos, &rec_frame);
+        ims_shoebox_addSource(hIms_ir, (float*)src_pos, &ir_sig[0]);
+        irReceiverID = ims_shoebox_addReceiverSH(hIms_ir, sh_order, (float*)rec_pos, &rec_irs[0]);
+        ims_shoebox_computeEchograms(hIms, -1, maxTime_s);
+        ims_shoebox_computeEchograms(hIms_ir, -1, maxTime_s);
+
+        /* The first frame after computing new echograms is cross-faded with the previous (empty) echograms, so start with silence */
+        memset(src_frame, 0, framesize*sizeof(float));
+        memset(ir_sig[0], 0, signalLength*sizeof(float));
+        ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, fracFLAG);
+        ims_shoebox_applyEchogramTD(hIms_ir, irReceiverID, signalLength, fracFLAG);
+
+        /* Obtain the impulse responses, by processing a unit impulse all at once */
+        ir_sig[0][0] = 1.0f;
+        ims_shoebox_applyEchogramTD(hIms_ir, irReceiverID, signalLength, fracFLAG);
+
+        /* Process the source signal block-wise */
+        nFrames = signalLength/framesize;
+        for(frame=0; frame<nFrames; frame++){
+            memcpy(src_frame, &src_sig[0][frame*framesize], framesize*sizeof(float));
+            ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, fracFLAG);
+            for(ch=0; ch<nSH; ch++)
+                memcpy(&rec_sig[ch][frame*framesize], rec_frame[ch], framesize*sizeof(float));
+        }
+
+        /* The output should be equal to the source signal convolved with the impulse responses */
+        for(ch=0; ch<nSH; ch++)
+            memcpy(src_sig_rep[ch], src_sig[0], signalLength*sizeof(float));
+        fftfilt(FLATTEN2D(src_sig_rep), FLATTEN3D(rec_irs), signalLength, signalLength, nSH, FLATTEN2D(ref));
+        for(ch=0; ch<nSH; ch++)
+            for(i=0; i<signalLength; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, ref[ch][i], rec_sig[ch][i]);
+
+        /* Once in steady-state: the interpolated output should be close to the one obtained with integer delays, and very close to the one obtained with the highest order */
+        if(!fracFLAG)
+            memcpy(FLATTEN2D(rec_sig_int), FLATTEN2D(rec_sig), nSH*signalLength*sizeof(float));
+        else if(order==IMS_MAX_LAGRANGE_ORDER)
+            memcpy(FLATTEN2D(rec_sig_max), FLATTEN2D(rec_sig), nSH*signalLength*sizeof(float));
+        if(fracFLAG){
+            energy = err = 0.0f;
+            for(ch=0; ch<nSH; ch++){
+                for(i=steadyState; i<signalLength; i++){
+                    energy += rec_sig[ch][i]*rec_sig[ch][i];
+                    err += (rec_sig[ch][i]-rec_sig_int[ch][i])*(rec_sig[ch][i]-rec_sig_int[ch][i]);
+                }
+            }
+            TEST_ASSERT_TRUE(sqrtf(err/energy) < acceptedRelTolerance_int);
+            err = 0.0f;
+            for(ch=0; ch<nSH; ch++)
+                for(i=steadyState; i<signalLength; i++)
+                    err += (rec_sig[ch][i]-rec_sig_max[ch][i])*(rec_sig[ch][i]-rec_sig_max[ch][i]);
+            TEST_ASSERT_TRUE(sqrtf(err/energy) < acceptedRelTolerance_ord);
+        }
+
+        /* Time the rendering with some more sources */
+        for(i=1; i<nBenchSources; i++)
+            ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+        ims_shoebox_computeEchograms(hIms, -1, maxTime_s);
+        start = timer_current();
+        for(frame=0; frame<nBenchFrames; frame++){
+            rand_m1_1(src_frame, framesize);
+            ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, fracFLAG);
+        }
+        elapsed = (double)timer_elapsed(start);
+        if(fracFLAG)
+            printf("    ims_shoebox_applyEchogramTD (Lagrange order %d): %lfms per %d sample frame\n", order, 1e3*elapsed/(double)nBenchFrames, framesize);
+        else
+            printf("    ims_shoebox_applyEchogramTD (integer delays): %lfms per %d sample frame\n", 1e3*elapsed/(double)nBenchFrames, framesize);
+
+        ims_shoebox_destroy(&hIms);
+        ims_shoebox_destroy(&hIms_ir);
+    }
+
+    /* clean-up */
+    free(src_sig);
+    free(ir_sig);
+    free(src_sig_rep);
+    free(src_frame);
+    free(rec_frame);
+    free(rec_sig);
+    free(rec_sig_int);
+    free(rec_sig_max);
+    free(rec_irs);
+    free(ref);
+}
+
+void test__ims_shoebox_memoryUsage(void){
+    void* hIms, *hIms_ref;
+    float* src_frame;
+    float** rec_frame, **rec_frame_ref;
+    int i, ch, frame, receiverID, receiverID_ref, sourceIDs[4];
+    long mem0, mem1, mem4, memRec;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int framesize = 512;
+    const int longFramesize = 8192; /* (longer than the circular buffers of 'hIms') */
+    const int nFrames = 16;
+    const int sh_order = 1;
+    const int nSH = ORDER2NSH(sh_order);
+    const int nBands = 5;
+    const float maxTime1_s = 0.02f;  /* 20ms */
+    const float maxTime2_s = 0.035f; /* 35ms (longer, but by less than 2x) */
+    const float abs_wall[5][6] =  /* Absorption Coefficients per Octave band, and per wall */
+      { {0.180791250f, 0.207307300f, 0.134990800f, 0.229002250f, 0.212128400f, 0.241055000f},
+        {0.225971250f, 0.259113700f, 0.168725200f, 0.286230250f, 0.265139600f, 0.301295000f},
+        {0.258251250f, 0.296128100f, 0.192827600f, 0.327118250f, 0.303014800f, 0.344335000f},
+        {0.301331250f, 0.345526500f, 0.224994001f, 0.381686250f, 0.353562000f, 0.401775000f},
+        {0.361571250f, 0.414601700f, 0.269973200f, 0.457990250f, 0.424243600f, 0.482095000f} };
+    const float src_pos[3]  = {5.1f, 6.0f, 1.1f};
+    const float rec_pos[3]  = {8.8f, 5.5f, 0.9f};
+    const float roomdims[3] = {10.0f, 7.0f, 3.0f};
+
+    /* Allocate memory */
+    src_frame = malloc1d(longFramesize*sizeof(float));
+    rec_frame = (float**)malloc2d(nSH, longFramesize, sizeof(float));
+    rec_frame_ref = (float**)malloc2d(nSH, longFramesize, sizeof(float));
+
+    /* Buffers are allocated/freed along with the receivers and sources */
+    ims_shoebox_create(&hIms, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, 48e3f);
+    TEST_ASSERT_TRUE(ims_shoebox_getMemoryUsage(hIms) == 0);
+    receiverID = ims_shoebox_addReceiverSH(hIms, sh_order, (float*)rec_pos, &rec_frame);
+    mem0 = ims_shoebox_getMemoryUsage(hIms);
+    TEST_ASSERT_TRUE(mem0 > 0);
+    sourceIDs[0] = ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+    mem1 = ims_shoebox_getMemoryUsage(hIms) - mem0;
+    TEST_ASSERT_TRUE(mem1 > 0);
+    for(i=1; i<4; i++)
+        sourceIDs[i] = ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+    mem4 = ims_shoebox_getMemoryUsage(hIms);
+    TEST_ASSERT_TRUE(mem4 == mem0 + 4*mem1);
+
+    /* The circular buffers grow with the echograms, as they are computed (rendering does not allocate anything) */
+    ims_shoebox_computeEchograms(hIms, -1, maxTime2_s);
+    TEST_ASSERT_TRUE(ims_shoebox_getMemoryUsage(hIms) > mem4);
+    memset(src_frame, 0, framesize*sizeof(float));
+    memRec = ims_shoebox_getMemoryUsage(hIms);
+    ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, 0);
+    TEST_ASSERT_TRUE(ims_shoebox_getMemoryUsage(hIms) == memRec);
+    printf("    ims_shoebox_getMemoryUsage: 4 sources, %d bands, %.0fms echograms: %.1f kB\n",
+           nBands, 1e3f*maxTime2_s, (double)ims_shoebox_getMemoryUsage(hIms)/1024.0);
+
+    /* Removing all of the sources leaves only the receiver buffers */
+    ims_shoebox_removeSource(hIms, sourceIDs[3]);
+    TEST_ASSERT_TRUE(ims_shoebox_getMemoryUsage(hIms) < memRec);
+    for(i=0; i<3; i++)
+        ims_shoebox_removeSource(hIms, sourceIDs[i]);
+    memRec = ims_shoebox_getMemoryUsage(hIms);
+    TEST_ASSERT_TRUE(memRec == mem0);
+    ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+    TEST_ASSERT_TRUE(ims_shoebox_getMemoryUsage(hIms) == memRec + mem1);
+    ims_shoebox_removeReceiver(hIms, receiverID);
+    TEST_ASSERT_TRUE(ims_shoebox_getMemoryUsage(hIms) == mem1);
+    ims_shoebox_destroy(&hIms);
+
+    /* Growing the buffers should keep the past samples; comparing against a room whose buffers are already long */
+    ims_shoebox_create(&hIms, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, 48e3f);
+    ims_shoebox_create(&hIms_ref, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, 48e3f);
+    ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+    ims_shoebox_addSource(hIms_ref, (float*)src_pos, &src_frame);
+    receiverID = ims_shoebox_addReceiverSH(hIms, sh_order, (float*)rec_pos, &rec_frame);
+    receiverID_ref = ims_shoebox_addReceiverSH(hIms_ref, sh_order, (float*)rec_pos, &rec_frame_ref);
+    memset(src_frame, 0, framesize*sizeof(float));
+    ims_shoebox_computeEchograms(hIms_ref, -1, 4.0f*maxTime2_s);
+    ims_shoebox_applyEchogramTD(hIms_ref, receiverID_ref, framesize, 0);
+    ims_shoebox_computeEchograms(hIms_ref, -1, maxTime1_s);
+    ims_shoebox_applyEchogramTD(hIms_ref, receiverID_ref, framesize, 0);
+    ims_shoebox_computeEchograms(hIms, -1, maxTime1_s);
+    ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, 0);
+    ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, 0);
+    TEST_ASSERT_TRUE(ims_shoebox_getMemoryUsage(hIms) < ims_shoebox_getMemoryUsage(hIms_ref));
+    for(frame=0; frame<nFrames; frame++){
+        if(frame==nFrames/2){
+            ims_shoebox_computeEchograms(hIms, -1, maxTime2_s);
+            ims_shoebox_computeEchograms(hIms_ref, -1, maxTime2_s);
+        }
+        rand_m1_1(src_frame, framesize);
+        ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, 0);
+        ims_shoebox_applyEchogramTD(hIms_ref, receiverID_ref, framesize, 0);
+        for(ch=0; ch<nSH; ch++)
+            for(i=0; i<framesize; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, rec_frame_ref[ch][i], rec_frame[ch][i]);
+    }
+
+    /* Frames may also be longer than the circular buffers (only their most recent samples are kept) */
+    TEST_ASSERT_TRUE(ims_shoebox_getMemoryUsage(hIms) < ims_shoebox_getMemoryUsage(hIms_ref));
+    for(frame=0; frame<4; frame++){
+        rand_m1_1(src_frame, longFramesize);
+        ims_shoebox_applyEchogramTD(hIms, receiverID, longFramesize, 0);
+        ims_shoebox_applyEchogramTD(hIms_ref, receiverID_ref, longFramesize, 0);
+        for(ch=0; ch<nSH; ch++)
+            for(i=0; i<longFramesize; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, rec_frame_ref[ch][i], rec_frame[ch][i]);
+    }
+
+    /* clean-up */
+    free(src_frame);
+    free(rec_frame);
+    free(rec_frame_ref);
+    ims_shoebox_destroy(&hIms);
+    ims_shoebox_destroy(&hIms_ref);
+}
+
+void test__ims_shoebox_echogramUpdate(void){
+    void* hIms, *hIms_ref;
+    float* src_frame;
+    float** rec_frame, **rec_frame_ref;
+    float mov_src_pos[3], mov_rec_pos[3], abs_wall2[5][6];
+    int i, ch, band, frame, receiverID, receiverID_ref;
+    double elapsed;
+    tick_t start;
+
+    /* Config */
+    const float acceptedTolerance = 0.0001f;
+    const int framesize = 512;
+    const int nFrames = 4;
+    const int sh_order = 3;
+    const int nSH = ORDER2NSH(sh_order);
+    const int nBands = 5;
+    const int nUpdates = 20;
+    const int maxN = 7;
+    const float maxTime_s = 0.05f; /* 50ms */
+    const float abs_wall[5][6] =  /* Absorption Coefficients per Octave band, and per wall */
+      { {0.180791250f, 0.207307300f, 0.134990800f, 0.229002250f, 0.212128400f, 0.241055000f},
+        {0.225971250f, 0.259113700f, 0.168725200f, 0.286230250f, 0.265139600f, 0.301295000f},
+        {0.258251250f, 0.296128100f, 0.192827600f, 0.327118250f, 0.303014800f, 0.344335000f},
+        {0.301331250f, 0.345526500f, 0.224994001f, 0.381686250f, 0.353562000f, 0.401775000f},
+        {0.361571250f, 0.414601700f, 0.269973200f, 0.457990250f, 0.424243600f, 0.482095000f} };
+    const float src_pos[3]  = {5.1f, 6.0f, 1.1f};
+    const float rec_pos[3]  = {8.8f, 5.5f, 0.9f};
+    const float roomdims[3] = {10.0f, 7.0f, 3.0f};
+
+    /* Allocate memory */
+    src_frame = malloc1d(framesize*sizeof(float));
+    rec_frame = (float**)malloc2d(nSH, framesize, sizeof(float));
+    rec_frame_ref = (float**)malloc2d(nSH, framesize, sizeof(float));
+    for(band=0; band<nBands; band++)
+        for(i=0; i<6; i++)
+            abs_wall2[band][i] = 0.5f*abs_wall[band][i];
+
+    /* Move the source and receiver around, such that the echograms are updated incrementally */
+    ims_shoebox_create(&hIms, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, 48e3f);
+    ims_shoebox_addSource(hIms, (float*)src_pos, &src_frame);
+    receiverID = ims_shoebox_addReceiverSH(hIms, sh_order, (float*)rec_pos, &rec_frame);
+    memcpy(mov_src_pos, src_pos, 3*sizeof(float));
+    memcpy(mov_rec_pos, rec_pos, 3*sizeof(float));
+    elapsed = 0.0;
+    for(i=0; i<nUpdates; i++){
+        mov_src_pos[1] = 2.0f + (float)i/10.0f;
+        mov_rec_pos[0] = 3.0f + (float)i/10.0f;
+        ims_shoebox_updateSource(hIms, 0, mov_src_pos);
+        ims_shoebox_updateReceiver(hIms, receiverID, mov_rec_pos);
+        start = timer_current();
+        ims_shoebox_computeEchograms(hIms, maxN, -1.0f);
+        elapsed += (double)timer_elapsed(start);
+    }
+    printf("    ims_shoebox_computeEchograms: maxN %d, %d bands, SH order %d: %lfms per source/receiver movement\n",
+           maxN, nBands, sh_order, 1e3*elapsed/(double)nUpdates);
+
+    /* Then also change the wall absorption and switch to a maximum propagation time */
+    ims_shoebox_setWallAbsCoeffs(hIms, (float*)abs_wall2);
+    ims_shoebox_computeEchograms(hIms, -1, maxTime_s);
+
+    /* Reference room, set-up directly with the final parameters */
+    ims_shoebox_create(&hIms_ref, (float*)roomdims, (float*)abs_wall2, 250.0f, nBands, 343.0f, 48e3f);
+    ims_shoebox_addSource(hIms_ref, mov_src_pos, &src_frame);
+    receiverID_ref = ims_shoebox_addReceiverSH(hIms_ref, sh_order, mov_rec_pos, &rec_frame_ref);
+    ims_shoebox_computeEchograms(hIms_ref, -1, maxTime_s);
+
+    /* Both rooms should then render the same output (the first frame is
+     * skipped, since it is cross-faded with different previous echograms) */
+    for(frame=0; frame<nFrames; frame++){
+        rand_m1_1(src_frame, framesize);
+        ims_shoebox_applyEchogramTD(hIms, receiverID, framesize, 0);
+        ims_shoebox_applyEchogramTD(hIms_ref, receiverID_ref, framesize, 0);
+        for(ch=0; ch<nSH && frame>0; ch++)
+            for(i=0; i<framesize; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, rec_frame_ref[ch][i], rec_frame[ch][i]);
+    }
+
+    /* clean-up */
+    free(src_frame);
+    free(rec_frame);
+    free(rec_frame_ref);
+    ims_shoebox_destroy(&hIms);
+    ims_shoebox_destroy(&hIms_ref);
+}
+
+void test__ims_shoebox_threaded(void){
+    void* hIms, *hThreadPool;
+    float** src_sigs, ****rec_sigs, **src_pos;
+    float rec_pos[3];
+    int s, r, nt, update, nThreads, sourceIDs[64], receiverIDs[4];
+    double t_echograms, t_rirs;
+    tick_t start;
+
+    /* Config */
+    const int nSources = 64;
+    const int nReceivers = 4;
+    const int sh_order = 1;
+    const int nSH = ORDER2NSH(sh_order);
+    const int nBands = 5;
+    const int nUpdates = 2;
+    const int framesize = 256;
+    const int maxNumThreads = 4;
+    const float maxTime_s = 0.05f; /* 50ms */
+    const float abs_wall[5][6] =  /* Absorption Coefficients per Octave band, and per wall */
+      { {0.180791250f, 0.207307300f, 0.134990800f, 0.229002250f, 0.212128400f, 0.241055000f},
+        {0.225971250f, 0.259113700f, 0.168725200f, 0.286230250f, 0.265139600f, 0.301295000f},
+        {0.258251250f, 0.296128100f, 0.192827600f, 0.327118250f, 0.303014800f, 0.344335000f},
+        {0.301331250f, 0.345526500f, 0.224994001f, 0.381686250f, 0.353562000f, 0.401775000f},
+        {0.361571250f, 0.414601700f, 0.269973200f, 0.457990250f, 0.424243600f, 0.482095000f} };
+    const float roomdims[3] = {10.0f, 7.0f, 3.0f};
+
+    /* Allocate memory; rec_sigs: 2 (reference/threaded) x nReceivers x nSH x framesize */
+    src_sigs = (float**)malloc2d(nSources, framesize, sizeof(float));
+    rec_sigs = (float****)malloc4d(2, nReceivers, nSH, framesize, sizeof(float));
+    src_pos = (float**)malloc2d(nSources, 3, sizeof(float));
+    rand_m1_1(FLATTEN2D(src_sigs), nSources*framesize);
+
+    printf("    ims_shoebox %d sources x %d receivers (SH order %d), %d bands, %.0fms echograms:\n",
+           nSources, nReceivers, sh_order, nBands, 1e3f*maxTime_s);
+
+    /* Reference (no thread pool), followed by 1..maxNumThreads threads */
+    for(nThreads = 0; nThreads<=maxNumThreads; nThreads = nThreads==0 ? 1 : 2*nThreads){
+        if(nThreads>0)
+            saf_threadPool_create(&hThreadPool, nThreads);
+        else
+            hThreadPool = NULL;
+        nt = nThreads==0 ? 0 : 1;
+
+        /* Set-up the scene, with the sources placed on a grid */
+        ims_shoebox_create(&hIms, (float*)roomdims, (float*)abs_wall, 250.0f, nBands, 343.0f, 48e3f);
+        ims_shoebox_setThreadPool(hIms, hThreadPool);
+        for(s=0; s<nSources; s++){
+            src_pos[s][0] = 1.0f + 1.0f*(float)(s%8);
+            src_pos[s][1] = 1.0f + 0.6f*(float)(s/8);
+            src_pos[s][2] = 1.5f;
+            sourceIDs[s] = ims_shoebox_addSource(hIms, src_pos[s], &src_sigs[s]);
+        }
+        for(r=0; r<nReceivers; r++){
+            rec_pos[0] = 2.0f + 2.0f*(float)r;
+            rec_pos[1] = 3.5f;
+            rec_pos[2] = 1.2f;
+            receiverIDs[r] = ims_shoebox_addReceiverSH(hIms, sh_order, rec_pos, &rec_sigs[nt][r]);
+        }
+
+        /* Move all of the sources a few times */
+        t_echograms = t_rirs = 0.0;
+        for(update=0; update<nUpdates; update++){
+            for(s=0; s<nSources; s++){
+                src_pos[s][2] = 1.5f + 0.1f*(float)update;
+                ims_shoebox_updateSource(hIms, sourceIDs[s], src_pos[s]);
+            }
+            start = timer_current();
+            ims_shoebox_computeEchograms(hIms, -1, maxTime_s);
+            t_echograms += (double)timer_elapsed(start);
+            start = timer_current();
+            ims_shoebox_renderRIRs(hIms, 0);
+            t_rirs += (double)timer_elapsed(start);
+        }
+        if(nThreads>0)
+            printf("     %d thread(s): computeEchograms %lfms, renderRIRs %lfms (per update)\n", nThreads,
+                   1e3*t_echograms/(double)nUpdates, 1e3*t_rirs/(double)nUpdates);
+
+        /* The rendered output should not depend on the number of threads */
+        for(r=0; r<nReceivers; r++)
+            ims_shoebox_applyEchogramTD(hIms, receiverIDs[r], framesize, 0);
+        if(nThreads>0)
+            TEST_ASSERT_TRUE(memcmp(FLATTEN3D(rec_sigs[0]), FLATTEN3D(rec_sigs[1]), nReceivers*nSH*framesize*sizeof(float))==0);
+
+        ims_shoebox_destroy(&hIms);
+        saf_threadPool_destroy(&hThreadPool);
+    }
+
+    /* clean-up */
+    free(src_sigs);
+    free(rec_sigs);
+    free(src_pos);
+}
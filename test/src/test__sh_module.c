@@ -228,6 +228,60 @@ void test__getSHrotMtxReal(void){
     free(Mrot);
 }
 
+void test__getSHrotMtxRealPacked(void){
+    int i, j, order, nSH, it;
+    float Rzyx[3][3];
+    float* Mrot, *Mrot_packed, *inSig, *outSig_ref, *outSig;
+    double t_dense, t_packed;
+    tick_t start;
+
+    /* Config */
+    const float acceptedTolerance = 0.0001f;
+    const int maxOrder = 10;
+    const int signalLength = 512;
+    const int nIterations = 200;
+
+    printf("    SH rotation of %d samples, dense vs packed block-diagonal (ms):", signalLength);
+    for(order=1; order<=maxOrder; order++){
+        nSH = ORDER2NSH(order);
+        Mrot = malloc1d(nSH*nSH*sizeof(float));
+        Mrot_packed = malloc1d(ORDER2NSHROT(order)*sizeof(float));
+        inSig = malloc1d(nSH*signalLength*sizeof(float));
+        outSig_ref = malloc1d(nSH*signalLength*sizeof(float));
+        outSig = malloc1d(nSH*signalLength*sizeof(float));
+        rand_m1_1(inSig, nSH*signalLength);
+
+        /* The packed blocks should be the same as the blocks along the diagonal of the dense matrix */
+        yawPitchRoll2Rzyx(0.04f*(float)order, 0.54f,-0.4f, 0, Rzyx);
+        getSHrotMtxReal(Rzyx, Mrot, order);
+        getSHrotMtxRealPacked(Rzyx, Mrot_packed, order);
+
+        /* Time the rotation, when applied with the dense matrix and with the packed matrix */
+        start = timer_current();
+        for(it=0; it<nIterations; it++)
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, signalLength, nSH, 1.0f,
+                        Mrot, nSH, inSig, signalLength, 0.0f, outSig_ref, signalLength);
+        t_dense = 1e3*(double)timer_elapsed(start)/(double)nIterations;
+        start = timer_current();
+        for(it=0; it<nIterations; it++)
+            applySHrotMtxRealPacked(Mrot_packed, order, inSig, signalLength, outSig);
+        t_packed = 1e3*(double)timer_elapsed(start)/(double)nIterations;
+        printf(" N=%d: %.4f vs %.4f;", order, t_dense, t_packed);
+
+        /* Both should yield the same rotated signals */
+        for(i=0; i<nSH; i++)
+            for(j=0; j<signalLength; j++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outSig_ref[i*signalLength+j], outSig[i*signalLength+j]);
+
+        free(Mrot);
+        free(Mrot_packed);
+        free(inSig);
+        free(outSig_ref);
+        free(outSig);
+    }
+    printf("\n");
+}
+
 void test__real2complexSHMtx(void){
     int o, it, j, nSH, order;
     float* Y_real_ref;
@@ -27,6 +27,9 @@
 #ifndef SAF_TEST_SOFA_FILE_PATH
 # define SAF_TEST_SOFA_FILE_PATH "/Users/mccorml1/Documents/FABIAN_HRTF_DATABASE_V1/1 HRIRs/SOFA/FABIAN_HRIR_measured_HATO_20.sofa"
 #endif
+#ifndef SAF_TEST_DATA_PATH
+# define SAF_TEST_DATA_PATH "../../test/data/" /* (the CMake project passes the absolute path) */
+#endif
 
 #ifdef SAF_ENABLE_SOFA_READER_MODULE
 
@@ -76,4 +79,108 @@ void test__sofa_comparison(void){
     mysofa_free(hrtf);
 }
 
+void test__sofa_testFiles(void){
+    int f, m, r, n, err;
+    double azi, elev, itd, delay, gain, t, ir_ref;
+    char path[512];
+    SAF_SOFA_ERROR_CODES error;
+    saf_sofa_container sofa;
+    struct MYSOFA_HRTF *hrtf[2];
+
+    /* Config (see test/data/make_test_sofa_files.c) */
+    const float acceptedTolerance = 0.000001f;
+    const char* fileNames[2] = {"saf_test_hrirs.sofa", "saf_test_hrirs_deflated.sofa"}; /* contiguous, chunked+shuffled+deflated */
+    const int M = 24, R = 2, N = 64, fs = 48000;
+
+    for(f=0; f<2; f++){
+        snprintf(path, sizeof(path), "%s%s", SAF_TEST_DATA_PATH, fileNames[f]);
+
+        /* Load with libmysofa, and check against the expressions used to generate the file */
+        hrtf[f] = mysofa_load(path, &err);
+        TEST_ASSERT_TRUE(err==MYSOFA_OK && hrtf[f]!=NULL);
+        TEST_ASSERT_TRUE(hrtf[f]->M==(unsigned)M && hrtf[f]->R==(unsigned)R && hrtf[f]->N==(unsigned)N && hrtf[f]->C==3);
+        TEST_ASSERT_EQUAL_FLOAT((float)fs, hrtf[f]->DataSamplingRate.values[0]);
+        for(m=0; m<M; m++){
+            elev = asin(1.0 - 2.0*((double)m+0.5)/(double)M);
+            azi = fmod((double)m*2.399963229728653, 2.0*M_PI);
+            TEST_ASSERT_FLOAT_WITHIN(0.00001f, (float)(azi*180.0/M_PI), hrtf[f]->SourcePosition.values[m*3+0]);
+            TEST_ASSERT_FLOAT_WITHIN(0.00001f, (float)(elev*180.0/M_PI), hrtf[f]->SourcePosition.values[m*3+1]);
+            TEST_ASSERT_FLOAT_WITHIN(0.00001f, 1.5f, hrtf[f]->SourcePosition.values[m*3+2]);
+            itd = 0.00035*sin(azi)*cos(elev);
+            for(r=0; r<R; r++){
+                delay = (double)(N/8) + (r==0 ? -1.0 : 1.0)*itd*(double)fs;
+                gain = 1.0 + (r==0 ? 0.3 : -0.3)*sin(azi)*cos(elev);
+                for(n=0; n<N; n++){
+                    t = (double)n - delay;
+                    ir_ref = gain * (fabs(t)<1e-9 ? 1.0 : sin(M_PI*t)/(M_PI*t)) * exp(-fabs(t)/(double)(N/16));
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, (float)ir_ref, hrtf[f]->DataIR.values[(m*R+r)*N+n]);
+                }
+            }
+        }
+
+        /* saf_sofa_open() should load the same data */
+        error = saf_sofa_open(&sofa, path);
+        TEST_ASSERT_TRUE(error==SAF_SOFA_OK);
+        TEST_ASSERT_TRUE(sofa.nSources==M && sofa.nReceivers==R && sofa.DataLengthIR==N);
+        TEST_ASSERT_EQUAL_FLOAT((float)fs, sofa.DataSamplingRate);
+        for(m=0; m<M*R*N; m++)
+            TEST_ASSERT_EQUAL_FLOAT(hrtf[f]->DataIR.values[m], sofa.DataIR[m]);
+        for(m=0; m<M*3; m++)
+            TEST_ASSERT_EQUAL_FLOAT(hrtf[f]->SourcePosition.values[m], sofa.SourcePosition[m]);
+        saf_sofa_close(&sofa);
+    }
+
+    /* The contiguous and the deflated files should load bit-exactly the same */
+    TEST_ASSERT_EQUAL_MEMORY(hrtf[0]->DataIR.values, hrtf[1]->DataIR.values, M*R*N*sizeof(float));
+    TEST_ASSERT_EQUAL_MEMORY(hrtf[0]->SourcePosition.values, hrtf[1]->SourcePosition.values, M*3*sizeof(float));
+
+    mysofa_free(hrtf[0]);
+    mysofa_free(hrtf[1]);
+}
+
+void test__sofa_reader_benchmark(void){
+    int f, i, err, nFiles;
+    double elapsed, best_mysofa, best_saf;
+    char path[3][512];
+    FILE* fp;
+    tick_t start;
+    SAF_SOFA_ERROR_CODES error;
+    saf_sofa_container sofa;
+    struct MYSOFA_HRTF *hrtf;
+
+    /* Config */
+    const int nRuns = 5;
+
+    /* The small test files, and the (big) SAF_TEST_SOFA_FILE_PATH file, if it exists */
+    snprintf(path[0], sizeof(path[0]), "%s%s", SAF_TEST_DATA_PATH, "saf_test_hrirs.sofa");
+    snprintf(path[1], sizeof(path[1]), "%s%s", SAF_TEST_DATA_PATH, "saf_test_hrirs_deflated.sofa");
+    snprintf(path[2], sizeof(path[2]), "%s", SAF_TEST_SOFA_FILE_PATH);
+    nFiles = 3;
+    if((fp = fopen(path[2], "rb"))==NULL)
+        nFiles = 2;
+    else
+        fclose(fp);
+
+    /* Best time of nRuns loads, for both loaders */
+    for(f=0; f<nFiles; f++){
+        best_mysofa = best_saf = 1e9;
+        for(i=0; i<nRuns; i++){
+            start = timer_current();
+            hrtf = mysofa_load(path[f], &err);
+            elapsed = (double)timer_elapsed(start);
+            best_mysofa = SAF_MIN(best_mysofa, elapsed);
+            TEST_ASSERT_TRUE(err==MYSOFA_OK);
+            mysofa_free(hrtf);
+
+            start = timer_current();
+            error = saf_sofa_open(&sofa, path[f]);
+            elapsed = (double)timer_elapsed(start);
+            best_saf = SAF_MIN(best_saf, elapsed);
+            TEST_ASSERT_TRUE(error==SAF_SOFA_OK);
+            saf_sofa_close(&sofa);
+        }
+        printf("    %s: mysofa_load %lfs, saf_sofa_open %lfs\n", path[f], best_mysofa, best_saf);
+    }
+}
+
 #endif /* SAF_ENABLE_SOFA_READER_MODULE */
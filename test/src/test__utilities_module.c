@@ -299,6 +299,617 @@ void test__saf_matrixConv(void){
     saf_matrixConv_destroy(&hMatrixConv);
 }
 
+void test__saf_matrixConv_partitioned(void){
+    int i, j, frame, mode;
+    float** inputTD, ***outputTD, **inputFrameTD, **outputFrameTD;
+    float*** filters;
+    void* hMatrixConv;
+    tick_t start;
+    double elapsed[4];
+
+    /* config */
+    const float acceptedTolerance = 0.001f;
+    const int signalLength = 16384;
+    const int hostBlockSize = 256;
+    const int filterLength = 8192;
+    const int nInputs = 8;
+    const int nOutputs = 8;
+
+    /* prep */
+    inputTD = (float**)malloc2d(nInputs, signalLength, sizeof(float));
+    outputTD = (float***)malloc3d(4, nOutputs, signalLength, sizeof(float));
+    inputFrameTD = (float**)malloc2d(nInputs, hostBlockSize, sizeof(float));
+    outputFrameTD = (float**)calloc2d(nOutputs, hostBlockSize, sizeof(float));
+    filters = (float***)malloc3d(nOutputs, nInputs, filterLength, sizeof(float));
+    rand_m1_1(FLATTEN3D(filters), nOutputs*nInputs*filterLength);
+    cblas_sscal(nOutputs*nInputs*filterLength, 1.0f/sqrtf((float)(nInputs*filterLength)), FLATTEN3D(filters), 1);
+    rand_m1_1(FLATTEN2D(inputTD), nInputs*signalLength);
+
+    /* Apply all of the supported convolution modes (SAF_CONV_MODES) */
+    for(mode = SAF_CONV_NONPARTITIONED; mode<=SAF_CONV_PARTITIONED_NONUNIFORM; mode++){
+        saf_matrixConv_create(&hMatrixConv, hostBlockSize, FLATTEN3D(filters), filterLength,
+                              nInputs, nOutputs, mode);
+        start = timer_current();
+        for(frame = 0; frame<(int)signalLength/hostBlockSize; frame++){
+            for(i = 0; i<nInputs; i++)
+                memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+
+            saf_matrixConv_apply(hMatrixConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+
+            for(i = 0; i<nOutputs; i++)
+                memcpy(&outputTD[mode][i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+        }
+        elapsed[mode] = (double)timer_elapsed(start);
+        saf_matrixConv_destroy(&hMatrixConv);
+    }
+    printf("    matrixConv %dx%d, %d taps, hop %d: non-partitioned %lfs, partitioned %lfs, overlap-save %lfs, non-uniform %lfs\n",
+           nInputs, nOutputs, filterLength, hostBlockSize, elapsed[0], elapsed[1], elapsed[2], elapsed[3]);
+
+    /* All modes should yield the same output */
+    for(i = 0; i<nOutputs; i++){
+        for(j = 0; j<signalLength; j++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outputTD[0][i][j], outputTD[1][i][j]);
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outputTD[0][i][j], outputTD[2][i][j]);
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outputTD[0][i][j], outputTD[3][i][j]);
+        }
+    }
+
+    /* Clean-up */
+    free(inputTD);
+    free(outputTD);
+    free(inputFrameTD);
+    free(outputFrameTD);
+    free(filters);
+}
+
+void test__saf_matrixConv_threaded(void){
+    int i, frame, mode, nt, nFrames, nThreads;
+    float** inputTD, ***outputTD, **inputFrameTD, **outputFrameTD;
+    float*** filters;
+    void* hMatrixConv, *hThreadPool;
+    tick_t start;
+    double elapsed;
+
+    /* config */
+    const int signalLength = 8192;
+    const int hostBlockSize = 256;
+    const int filterLength = 2048;
+    const int nInputs = 16;
+    const int nOutputs = 16;
+    const int maxNumThreads = 8;
+
+    /* prep */
+    nFrames = signalLength/hostBlockSize;
+    inputTD = (float**)malloc2d(nInputs, signalLength, sizeof(float));
+    outputTD = (float***)malloc3d(2, nOutputs, signalLength, sizeof(float));
+    inputFrameTD = (float**)malloc2d(nInputs, hostBlockSize, sizeof(float));
+    outputFrameTD = (float**)calloc2d(nOutputs, hostBlockSize, sizeof(float));
+    filters = (float***)malloc3d(nOutputs, nInputs, filterLength, sizeof(float));
+    rand_m1_1(FLATTEN3D(filters), nOutputs*nInputs*filterLength);
+    cblas_sscal(nOutputs*nInputs*filterLength, 1.0f/sqrtf((float)(nInputs*filterLength)), FLATTEN3D(filters), 1);
+    rand_m1_1(FLATTEN2D(inputTD), nInputs*signalLength);
+
+    for(mode = SAF_CONV_NONPARTITIONED; mode<=SAF_CONV_PARTITIONED_NONUNIFORM; mode++){
+        printf("    matrixConv %dx%d, %d taps, hop %d, mode %d:", nInputs, nOutputs, filterLength, hostBlockSize, mode);
+
+        /* Reference (no thread pool), followed by 1..maxNumThreads threads */
+        for(nThreads = 0; nThreads<=maxNumThreads; nThreads = nThreads==0 ? 1 : 2*nThreads){
+            if(nThreads>0)
+                saf_threadPool_create(&hThreadPool, nThreads);
+            else
+                hThreadPool = NULL;
+            saf_matrixConv_createThreaded(&hMatrixConv, hostBlockSize, FLATTEN3D(filters), filterLength,
+                                          nInputs, nOutputs, mode, hThreadPool);
+            nt = nThreads==0 ? 0 : 1;
+            start = timer_current();
+            for(frame = 0; frame<nFrames; frame++){
+                for(i = 0; i<nInputs; i++)
+                    memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+
+                saf_matrixConv_apply(hMatrixConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+
+                for(i = 0; i<nOutputs; i++)
+                    memcpy(&outputTD[nt][i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+            }
+            elapsed = (double)timer_elapsed(start);
+            saf_matrixConv_destroy(&hMatrixConv);
+            saf_threadPool_destroy(&hThreadPool);
+            if(nThreads>0)
+                printf(" %d thread(s) %lfs;", nThreads, elapsed);
+
+            /* The output should not depend on the number of threads */
+            if(nThreads>0)
+                TEST_ASSERT_TRUE(memcmp(FLATTEN2D(outputTD[0]), FLATTEN2D(outputTD[1]), nOutputs*nFrames*hostBlockSize*sizeof(float))==0);
+        }
+        printf("\n");
+    }
+
+    /* Clean-up */
+    free(inputTD);
+    free(outputTD);
+    free(inputFrameTD);
+    free(outputFrameTD);
+    free(filters);
+}
+
+/** State object handed over by test__saf_rcu() */
+typedef struct _test_rcu_state {
+    int id;             /**< Increases with each published state */
+    volatile int magic; /**< #TEST_RCU_ALIVE until the state is destroyed */
+}test_rcu_state;
+
+/** Data shared between the writer and reader tasks of test__saf_rcu() */
+typedef struct _test_rcu_data {
+    void* hRCU;               /**< saf_rcu handle */
+    test_rcu_state* states;   /**< All states (only freed once the test is done) */
+    int nStates;              /**< Number of states to publish */
+    volatile int writerDone;  /**< 1: all states have been published */
+    int nReads, nErrors;      /**< Only written by the reader task */
+}test_rcu_data;
+
+#define TEST_RCU_ALIVE ( 0x5AF5AF )
+#define TEST_RCU_DEAD  ( -1 )
+
+/** Marks the retired state as destroyed (instead of freeing it) */
+static void test_rcu_destroyState(void ** const phState)
+{
+    test_rcu_state* state = (test_rcu_state*)(*phState);
+    state->magic = TEST_RCU_DEAD;
+    *phState = NULL;
+}
+
+/** Task 0: publishes the states in order; task 1: reads them concurrently */
+static void test_rcu_task(void* userData, int taskIndex, int workerIndex)
+{
+    test_rcu_data* data = (test_rcu_data*)userData;
+    test_rcu_state* state;
+    int i, k, ticket, lastID;
+    volatile int dummy;
+    SAF_UNUSED(workerIndex);
+
+    if(taskIndex==0){
+        for(i=0; i<data->nStates; i++){
+            data->states[i].id = i;
+            data->states[i].magic = TEST_RCU_ALIVE;
+            saf_rcu_publish(data->hRCU, (void*)&(data->states[i]));
+        }
+        saf_atomic_store(&(data->writerDone), 1);
+    }
+    else{
+        lastID = -1;
+        while(!saf_atomic_load(&(data->writerDone))){
+            state = (test_rcu_state*)saf_rcu_acquire(data->hRCU, &ticket);
+            if(state!=NULL){
+                /* The state must not be destroyed while it is held, and must
+                 * not go back in time */
+                for(k=0, dummy=0; k<100; k++)
+                    dummy += state->magic==TEST_RCU_ALIVE ? 0 : 1;
+                data->nErrors += dummy + (state->id<lastID ? 1 : 0);
+                lastID = state->id;
+                data->nReads++;
+            }
+            saf_rcu_release(data->hRCU, ticket);
+        }
+    }
+}
+
+void test__saf_rcu(void){
+    int i, nDead, ticket;
+    void* hThreadPool;
+    test_rcu_data data;
+    test_rcu_state* state;
+
+    /* config */
+    const int nStates = 500;
+
+    /* No state until one is published */
+    saf_rcu_create(&(data.hRCU), test_rcu_destroyState);
+    TEST_ASSERT_TRUE(saf_rcu_acquire(data.hRCU, &ticket)==NULL);
+    saf_rcu_release(data.hRCU, ticket);
+
+    /* One thread publishes new states, while another reads them */
+    data.states = (test_rcu_state*)malloc1d(nStates*sizeof(test_rcu_state));
+    data.nStates = nStates;
+    data.writerDone = 0;
+    data.nReads = data.nErrors = 0;
+    saf_threadPool_create(&hThreadPool, 2);
+    saf_threadPool_run(hThreadPool, test_rcu_task, (void*)&data, 2);
+    saf_threadPool_destroy(&hThreadPool);
+    TEST_ASSERT_EQUAL(0, data.nErrors);
+
+    /* Only the last state should remain, and all of the others destroyed */
+    state = (test_rcu_state*)saf_rcu_acquire(data.hRCU, &ticket);
+    TEST_ASSERT_TRUE(state==&(data.states[nStates-1]));
+    TEST_ASSERT_EQUAL(TEST_RCU_ALIVE, state->magic);
+    saf_rcu_release(data.hRCU, ticket);
+    for(i=0, nDead=0; i<nStates-1; i++)
+        nDead += data.states[i].magic==TEST_RCU_DEAD ? 1 : 0;
+    TEST_ASSERT_EQUAL(nStates-1, nDead);
+
+    /* Publishing NULL retracts (and destroys) the current state */
+    saf_rcu_publish(data.hRCU, NULL);
+    TEST_ASSERT_EQUAL(TEST_RCU_DEAD, data.states[nStates-1].magic);
+    TEST_ASSERT_TRUE(saf_rcu_acquire(data.hRCU, &ticket)==NULL);
+    saf_rcu_release(data.hRCU, ticket);
+
+    /* Atomic integers */
+    i = 3;
+    TEST_ASSERT_EQUAL(3, saf_atomic_load(&i));
+    TEST_ASSERT_FALSE(saf_atomic_compareExchange(&i, 2, 5));
+    TEST_ASSERT_TRUE(saf_atomic_compareExchange(&i, 3, 5));
+    saf_atomic_store(&i, 7);
+    TEST_ASSERT_EQUAL(7, i);
+
+    /* Clean-up */
+    saf_rcu_destroy(&(data.hRCU));
+    free(data.states);
+}
+
+void test__saf_fileCache(void){
+    int i;
+    FILE* f;
+    void* hCache;
+    unsigned char byte;
+    unsigned long long hash, hash2;
+    char cachePath[256];
+    float* src, *floats;
+    int* ints;
+    float_complex* cmplx;
+    saf_fileCache_key key, key2;
+    const char* names[4];
+    const void* data[4];
+    long nBytes[4];
+    char* arraysPath;
+    int dims[2], dims2[2];
+    float* floats2, *missing;
+    int* ints2;
+    saf_fileCache_array arrays[3];
+
+    /* config */
+    const char* srcPath = "test__saf_fileCache_src.bin";
+    const int nSrc = 300000;
+    const int nFloats = 1000;
+    const int nInts = 37;
+    const int nCmplx = 513;
+
+    /* Write a (random) source file, and hash it */
+    src = malloc1d(nSrc*sizeof(float));
+    rand_m1_1(src, nSrc);
+    f = fopen(srcPath, "wb");
+    TEST_ASSERT_TRUE(f!=NULL);
+    TEST_ASSERT_EQUAL(nSrc, (int)fwrite(src, sizeof(float), nSrc, f));
+    fclose(f);
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_hashFile(srcPath, &hash));
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_hashFile(srcPath, &hash2));
+    TEST_ASSERT_TRUE(hash==hash2);
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_FILE_IO, saf_fileCache_hashFile("test__saf_fileCache_missing.bin", &hash2));
+
+    /* Cache some arrays (including an empty one) under a key for this file */
+    floats = malloc1d(nFloats*sizeof(float));
+    ints = malloc1d(nInts*sizeof(int));
+    cmplx = malloc1d(nCmplx*sizeof(float_complex));
+    rand_m1_1(floats, nFloats);
+    for(i=0; i<nInts; i++)
+        ints[i] = i*i-100;
+    rand_m1_1((float*)cmplx, 2*nCmplx);
+    names[0] = "floats";  data[0] = floats;  nBytes[0] = nFloats*sizeof(float);
+    names[1] = "ints";    data[1] = ints;    nBytes[1] = nInts*sizeof(int);
+    names[2] = "cmplx";   data[2] = cmplx;   nBytes[2] = nCmplx*sizeof(float_complex);
+    names[3] = "empty";   data[3] = NULL;    nBytes[3] = 0;
+    memset(&key, 0, sizeof(saf_fileCache_key));
+    strcpy(key.tag, "test");
+    key.contentHash = hash;
+    key.sampleRate = 48000;
+    key.hopSize = 128;
+    key.options = 1;
+    saf_fileCache_getFilePath(".", &key, 256, cachePath);
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_save(cachePath, &key, 4, names, data, nBytes));
+
+    /* Read them back */
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_open(&hCache, cachePath, &key));
+    TEST_ASSERT_TRUE(hCache!=NULL);
+    for(i=0; i<3; i++){
+        TEST_ASSERT_TRUE(saf_fileCache_get(hCache, names[i], nBytes[i])!=NULL);
+        TEST_ASSERT_EQUAL(0, memcmp(saf_fileCache_get(hCache, names[i], nBytes[i]), data[i], nBytes[i]));
+    }
+    TEST_ASSERT_TRUE(saf_fileCache_get(hCache, "empty", 0)!=NULL);
+    TEST_ASSERT_TRUE(saf_fileCache_get(hCache, "floats", nBytes[0]-sizeof(float))==NULL); /* wrong size */
+    TEST_ASSERT_TRUE(saf_fileCache_get(hCache, "missing", nBytes[0])==NULL);
+    saf_fileCache_close(&hCache);
+    TEST_ASSERT_TRUE(hCache==NULL);
+
+    /* The same, with the array helpers (the sizes are cached in "dims") */
+    TEST_ASSERT_TRUE(saf_fileCache_createFilePath(".", "test__saf_fileCache_missing.bin", "test_arrays", 48000, 128, 1, &key2)==NULL);
+    arraysPath = saf_fileCache_createFilePath(".", srcPath, "test_arrays", 48000, 128, 1, &key2);
+    TEST_ASSERT_TRUE(arraysPath!=NULL);
+    TEST_ASSERT_TRUE(key2.contentHash==hash && strcmp(key2.tag, "test_arrays")==0);
+    dims[0] = nFloats;
+    dims[1] = nInts;
+    arrays[0].name = "floats";  arrays[0].ppData = (void**)&floats;  arrays[0].nBytes = nFloats*sizeof(float);  arrays[0].optional = 0;
+    arrays[1].name = "ints";    arrays[1].ppData = (void**)&ints;    arrays[1].nBytes = nInts*sizeof(int);      arrays[1].optional = 0;
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_saveArrays(arraysPath, &key2, 2, dims, 2, arrays));
+    floats2 = NULL;
+    ints2 = NULL;
+    missing = malloc1d(sizeof(float));
+    missing[0] = 1.0f;
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_open(&hCache, arraysPath, &key2));
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_INVALID_FILE, saf_fileCache_getDims(hCache, 3, dims2)); /* wrong size */
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_getDims(hCache, 2, dims2));
+    TEST_ASSERT_TRUE(dims2[0]==nFloats && dims2[1]==nInts);
+    arrays[0].ppData = (void**)&floats2;
+    arrays[1].ppData = (void**)&ints2;
+    arrays[2].name = "missing"; arrays[2].ppData = (void**)&missing; arrays[2].nBytes = sizeof(float); arrays[2].optional = 0;
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_INVALID_FILE, saf_fileCache_loadArrays(hCache, 3, arrays));
+    TEST_ASSERT_TRUE(floats2==NULL && ints2==NULL); /* (none are copied if any required array is missing) */
+    arrays[2].optional = 1;
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_loadArrays(hCache, 3, arrays));
+    TEST_ASSERT_TRUE(floats2!=NULL && ints2!=NULL && missing[0]==1.0f);
+    TEST_ASSERT_EQUAL(0, memcmp(floats, floats2, nFloats*sizeof(float)));
+    TEST_ASSERT_EQUAL(0, memcmp(ints, ints2, nInts*sizeof(int)));
+    saf_fileCache_close(&hCache);
+    remove(arraysPath);
+    free(arraysPath);
+    free(floats2);
+    free(ints2);
+    free(missing);
+
+    /* Any other key must be rejected */
+    key2 = key;
+    key2.sampleRate = 44100;
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_KEY_MISMATCH, saf_fileCache_open(&hCache, cachePath, &key2));
+    TEST_ASSERT_TRUE(hCache==NULL);
+    key2 = key;
+    key2.options = 0;
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_KEY_MISMATCH, saf_fileCache_open(&hCache, cachePath, &key2));
+    key2 = key;
+    strcpy(key2.tag, "other");
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_KEY_MISMATCH, saf_fileCache_open(&hCache, cachePath, &key2));
+
+    /* Changing the source file must change its hash */
+    src[nSrc/2] += 1.0f;
+    f = fopen(srcPath, "wb");
+    TEST_ASSERT_TRUE(f!=NULL);
+    TEST_ASSERT_EQUAL(nSrc, (int)fwrite(src, sizeof(float), nSrc, f));
+    fclose(f);
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_OK, saf_fileCache_hashFile(srcPath, &hash2));
+    TEST_ASSERT_TRUE(hash!=hash2);
+
+    /* Files which are not cache files, missing, or corrupted must be rejected */
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_INVALID_FILE, saf_fileCache_open(&hCache, srcPath, &key));
+    TEST_ASSERT_TRUE(hCache==NULL);
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_FILE_IO, saf_fileCache_open(&hCache, "test__saf_fileCache_missing.bin", &key));
+    f = fopen(cachePath, "r+b");
+    TEST_ASSERT_TRUE(f!=NULL);
+    fseek(f, 1000, SEEK_SET); /* (somewhere in the "floats" array) */
+    TEST_ASSERT_EQUAL(1, (int)fread(&byte, 1, 1, f));
+    byte ^= 0x10;
+    fseek(f, 1000, SEEK_SET);
+    TEST_ASSERT_EQUAL(1, (int)fwrite(&byte, 1, 1, f));
+    fclose(f);
+    TEST_ASSERT_EQUAL(SAF_FILECACHE_ERROR_INVALID_FILE, saf_fileCache_open(&hCache, cachePath, &key));
+    TEST_ASSERT_TRUE(hCache==NULL);
+
+    /* Clean-up */
+    remove(srcPath);
+    remove(cachePath);
+    free(src);
+    free(floats);
+    free(ints);
+    free(cmplx);
+}
+
+/**
+ * Reference: the uniformly-partitioned mode of saf_multiConv_apply(), as it was
+ * before the FDL became a ring buffer (i.e. the whole FDL is shifted by one
+ * slot every hop). The same (batched) FFT calls are used, so that only the FDL
+ * differs.
+ */
+static void test_multiConv_shiftingFDL
+(
+    float** filters,
+    int filterLength,
+    int nCH,
+    int hopSize,
+    float** inputTD,
+    int signalLength,
+    float** outputTD
+)
+{
+    int nc, nb, frame, fftSize, nBins, numFilterBlocks;
+    float* h_pad, *x_pad, *hx_n, *z_n, *y_n_overlap;
+    float_complex* Hpart_f, *X_n, *HX_n;
+    void* hFFT;
+
+    fftSize = 2*hopSize;
+    nBins = hopSize+1;
+    numFilterBlocks = (int)ceilf((float)filterLength/(float)hopSize);
+    h_pad = calloc1d(2*hopSize, sizeof(float));
+    x_pad = calloc1d(nCH*fftSize, sizeof(float));
+    hx_n = malloc1d(numFilterBlocks*nCH*fftSize*sizeof(float));
+    z_n = calloc1d(fftSize, sizeof(float));
+    y_n_overlap = calloc1d(nCH*hopSize, sizeof(float));
+    Hpart_f = malloc1d(numFilterBlocks*nCH*nBins*sizeof(float_complex));
+    X_n = calloc1d(numFilterBlocks*nCH*nBins, sizeof(float_complex));
+    HX_n = malloc1d(numFilterBlocks*nCH*nBins*sizeof(float_complex));
+    saf_rfft_create(&hFFT, fftSize);
+    saf_rfft_planBatch(hFFT, fftSize, nBins, nCH, numFilterBlocks*nCH);
+    for(nc=0; nc<nCH; nc++){
+        for(nb=0; nb<numFilterBlocks; nb++){
+            memset(h_pad, 0, hopSize*sizeof(float));
+            memcpy(h_pad, &filters[nc][nb*hopSize], SAF_MIN(hopSize, filterLength-nb*hopSize)*sizeof(float));
+            saf_rfft_forward(hFFT, h_pad, &Hpart_f[nb*nCH*nBins+nc*nBins]);
+        }
+    }
+    for(frame=0; frame<signalLength/hopSize; frame++){
+        /* shift the FDL, and store the new input spectra in slot 0 */
+        memmove(&X_n[nCH*nBins], X_n, (numFilterBlocks-1)*nCH*nBins*sizeof(float_complex));
+        for(nc=0; nc<nCH; nc++)
+            memcpy(&x_pad[nc*fftSize], &inputTD[nc][frame*hopSize], hopSize*sizeof(float));
+        saf_rfft_forward_batch(hFFT, x_pad, fftSize, X_n, nBins, nCH);
+
+        /* apply convolution and inverse fft, and sum over the partitions */
+        utility_cvvmul(Hpart_f, X_n, numFilterBlocks*nCH*nBins, HX_n);
+        saf_rfft_backward_batch(hFFT, HX_n, nBins, hx_n, fftSize, numFilterBlocks*nCH);
+        for(nc=0; nc<nCH; nc++){
+            memset(z_n, 0, fftSize*sizeof(float));
+            for(nb=0; nb<numFilterBlocks; nb++)
+                cblas_saxpy(fftSize, 1.0f, &hx_n[nb*nCH*fftSize+nc*fftSize], 1, z_n, 1);
+            utility_svvadd(z_n, &y_n_overlap[nc*hopSize], hopSize, &outputTD[nc][frame*hopSize]);
+            memcpy(&y_n_overlap[nc*hopSize], &z_n[hopSize], hopSize*sizeof(float));
+        }
+    }
+    saf_rfft_destroy(&hFFT);
+    free(h_pad);
+    free(x_pad);
+    free(hx_n);
+    free(z_n);
+    free(y_n_overlap);
+    free(Hpart_f);
+    free(X_n);
+    free(HX_n);
+}
+
+void test__saf_multiConv(void){
+    int i, j, frame, mode, nFrames, numFilterBlocks;
+    float** inputTD, ***outputTD, **inputFrameTD, **outputFrameTD, **outputTD_ref;
+    float** filters;
+    void* hMultiConv;
+    tick_t start;
+    double elapsed[4], elapsed_ref, fdlBytes, shiftBytesPerHop;
+
+    /* config */
+    const float acceptedTolerance = 0.001f;
+    const int signalLength = 16384;
+    const int hostBlockSize = 128;
+    const int filterLength = 16384;
+    const int nCH = 8;
+
+    /* prep (seeded locally, so that the inputs are the same regardless of the tests run before) */
+    srand(1);
+    nFrames = signalLength/hostBlockSize;
+    inputTD = (float**)malloc2d(nCH, signalLength, sizeof(float));
+    outputTD = (float***)malloc3d(4, nCH, signalLength, sizeof(float));
+    inputFrameTD = (float**)malloc2d(nCH, hostBlockSize, sizeof(float));
+    outputFrameTD = (float**)calloc2d(nCH, hostBlockSize, sizeof(float));
+    outputTD_ref = (float**)malloc2d(nCH, signalLength, sizeof(float));
+    filters = (float**)malloc2d(nCH, filterLength, sizeof(float));
+    rand_m1_1(FLATTEN2D(filters), nCH*filterLength);
+    cblas_sscal(nCH*filterLength, 1.0f/sqrtf((float)filterLength), FLATTEN2D(filters), 1);
+    rand_m1_1(FLATTEN2D(inputTD), nCH*signalLength);
+
+    /* Apply all of the supported convolution modes (SAF_CONV_MODES) */
+    for(mode = SAF_CONV_NONPARTITIONED; mode<=SAF_CONV_PARTITIONED_NONUNIFORM; mode++){
+        saf_multiConv_create(&hMultiConv, hostBlockSize, FLATTEN2D(filters), filterLength, nCH, mode);
+        start = timer_current();
+        for(frame = 0; frame<nFrames; frame++){
+            for(i = 0; i<nCH; i++)
+                memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+
+            saf_multiConv_apply(hMultiConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+
+            for(i = 0; i<nCH; i++)
+                memcpy(&outputTD[mode][i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+        }
+        elapsed[mode] = (double)timer_elapsed(start);
+        saf_multiConv_destroy(&hMultiConv);
+    }
+    printf("    multiConv %d channels, %d taps, hop %d: non-partitioned %lfms/hop, partitioned %lfms/hop, overlap-save %lfms/hop, non-uniform %lfms/hop\n",
+           nCH, filterLength, hostBlockSize,
+           1e3*elapsed[0]/(double)nFrames, 1e3*elapsed[1]/(double)nFrames, 1e3*elapsed[2]/(double)nFrames, 1e3*elapsed[3]/(double)nFrames);
+
+    /* The partitioned mode should yield exactly the same output as when the whole FDL was shifted every hop */
+    start = timer_current();
+    test_multiConv_shiftingFDL(filters, filterLength, nCH, hostBlockSize, inputTD, signalLength, outputTD_ref);
+    elapsed_ref = (double)timer_elapsed(start);
+    for(i = 0; i<nCH; i++)
+        TEST_ASSERT_EQUAL(0, memcmp(outputTD_ref[i], outputTD[SAF_CONV_PARTITIONED][i], nFrames*hostBlockSize*sizeof(float)));
+
+    /* Memory traffic saved: shifting the FDL read and wrote all but one of its slots every hop */
+    numFilterBlocks = (filterLength+hostBlockSize-1)/hostBlockSize;
+    fdlBytes = (double)numFilterBlocks*nCH*(hostBlockSize+1)*sizeof(float_complex);
+    shiftBytesPerHop = 2.0*(double)(numFilterBlocks-1)*nCH*(hostBlockSize+1)*sizeof(float_complex);
+    printf("    multiConv partitioned (FDL: %.1f MB): shifting FDL %lfms/hop, moving %.1f MB/hop (%.1f GB/s); ring buffer %lfms/hop, moving 0 MB/hop\n",
+           fdlBytes/1048576.0, 1e3*elapsed_ref/(double)nFrames, shiftBytesPerHop/1048576.0,
+           shiftBytesPerHop*(double)nFrames/elapsed_ref/1e9, 1e3*elapsed[SAF_CONV_PARTITIONED]/(double)nFrames);
+
+    /* All modes should yield the same output */
+    for(mode = SAF_CONV_PARTITIONED; mode<=SAF_CONV_PARTITIONED_NONUNIFORM; mode++)
+        for(i = 0; i<nCH; i++)
+            for(j = 0; j<nFrames*hostBlockSize; j++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outputTD[0][i][j], outputTD[mode][i][j]);
+
+    /* Clean-up */
+    free(inputTD);
+    free(outputTD);
+    free(inputFrameTD);
+    free(outputFrameTD);
+    free(outputTD_ref);
+    free(filters);
+}
+
+void test__saf_multiConv_hopLoad(void){
+    int ch, i, period, phase, nPeriods, nHopsPerPeriod;
+    float** inputFrameTD, **outputFrameTD;
+    float** filters;
+    double* minHopTime;
+    double hopTime, maxHopTime, meanHopTime;
+    void* hMultiConv;
+    tick_t start;
+
+    /* config */
+    const int hostBlockSize = 128;
+    const int filterLength = 65536;
+    const int nCH = 4;
+    const int maxBlockSize = 8192;      /* largest partition size (SAF_NUPC_MAX_BLOCK_SIZE) */
+    const double maxPeakToMean = 4.0;  /* the peak hop may not be more than this many times the mean */
+
+    /* prep (the signals only need to be non-zero, so rand() is left alone, as the tests that follow depend on it) */
+    inputFrameTD = (float**)malloc2d(nCH, hostBlockSize, sizeof(float));
+    outputFrameTD = (float**)calloc2d(nCH, hostBlockSize, sizeof(float));
+    filters = (float**)malloc2d(nCH, filterLength, sizeof(float));
+    for(ch=0; ch<nCH; ch++){
+        for(i=0; i<filterLength; i++)
+            filters[ch][i] = sinf(0.1f*(float)((ch+1)*i))/sqrtf((float)filterLength);
+        for(i=0; i<hostBlockSize; i++)
+            inputFrameTD[ch][i] = cosf(0.01f*(float)((ch+1)*i));
+    }
+    saf_multiConv_create(&hMultiConv, hostBlockSize, FLATTEN2D(filters), filterLength, nCH, SAF_CONV_PARTITIONED_NONUNIFORM);
+
+    /* The work schedule repeats every (largest partition size/hop size) hops. So time each hop, and keep the
+     * fastest time for each position in this period (discarding the occasional outlier due to the OS) */
+    nHopsPerPeriod = maxBlockSize/hostBlockSize;
+    nPeriods = 16;
+    minHopTime = malloc1d(nHopsPerPeriod*sizeof(double));
+    for(phase=0; phase<nHopsPerPeriod; phase++)
+        minHopTime[phase] = 1e9;
+    for(period=0; period<nPeriods+1; period++){
+        for(phase=0; phase<nHopsPerPeriod; phase++){
+            start = timer_current();
+            saf_multiConv_apply(hMultiConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+            hopTime = (double)timer_elapsed(start);
+            if(period>0) /* (first period is a warm-up) */
+                minHopTime[phase] = SAF_MIN(minHopTime[phase], hopTime);
+        }
+    }
+    maxHopTime = meanHopTime = 0.0;
+    for(phase=0; phase<nHopsPerPeriod; phase++){
+        maxHopTime = SAF_MAX(maxHopTime, minHopTime[phase]);
+        meanHopTime += minHopTime[phase]/(double)nHopsPerPeriod;
+    }
+    printf("    multiConv %d channels, %d taps, hop %d (non-uniform): mean %lfms/hop, peak %lfms/hop\n",
+           nCH, filterLength, hostBlockSize, 1e3*meanHopTime, 1e3*maxHopTime);
+
+    /* The work for the large partitions should be spread over the hops, rather than all done on the same hop */
+    TEST_ASSERT_TRUE(maxHopTime < maxPeakToMean*meanHopTime);
+
+    /* Clean-up */
+    saf_multiConv_destroy(&hMultiConv);
+    free(minHopTime);
+    free(inputFrameTD);
+    free(outputFrameTD);
+    free(filters);
+}
+
 void test__saf_rfft(void){
     int i, j, N;
     float* x_td, *test;
@@ -338,6 +949,73 @@ void test__saf_rfft(void){
     }
 }
 
+void test__saf_rfft_batch(void){
+    int i, j, b, N, nBins, strideTD, strideFD;
+    float* x_td, *test, *ref_td;
+    float_complex* x_fd, *ref_fd;
+    void *hFFT;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int nBatch = 7;
+    const int fftSizesToTest[6] = {16, 256, 1024, 4096, 80, 1920};
+    const float guardValue = 12345.0f;
+
+    /* Loop over the different FFT sizes, with both densely packed and padded layouts */
+    for (i=0; i<12; i++){
+        N = fftSizesToTest[i/2];
+        nBins = N/2+1;
+        strideTD = i%2 ? N+3 : N;
+        strideFD = i%2 ? nBins+5 : nBins;
+
+        /* prep */
+        x_td = malloc1d(nBatch*strideTD*sizeof(float));
+        test = malloc1d(nBatch*strideTD*sizeof(float));
+        ref_td = malloc1d(N*sizeof(float));
+        x_fd = malloc1d(nBatch*strideFD*sizeof(float_complex));
+        ref_fd = malloc1d(nBins*sizeof(float_complex));
+        rand_m1_1(x_td, nBatch*strideTD);
+        for(j=0; j<nBatch*strideTD; j++)
+            test[j] = guardValue;
+        for(j=0; j<nBatch*strideFD; j++)
+            x_fd[j] = cmplxf(guardValue, guardValue);
+        saf_rfft_create(&hFFT, N);
+        saf_rfft_planBatch(hFFT, strideTD, strideFD, nBatch, nBatch);
+
+        /* forward and backward transforms of all vectors at once */
+        saf_rfft_forward_batch(hFFT, x_td, strideTD, x_fd, strideFD, nBatch);
+        saf_rfft_backward_batch(hFFT, x_fd, strideFD, test, strideTD, nBatch);
+
+        for(b=0; b<nBatch; b++){
+            /* Check that the batched transforms are equivalent to transforming each vector individually */
+            saf_rfft_forward(hFFT, &x_td[b*strideTD], ref_fd);
+            for(j=0; j<nBins; j++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(ref_fd[j]), crealf(x_fd[b*strideFD+j]));
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(ref_fd[j]), cimagf(x_fd[b*strideFD+j]));
+            }
+            saf_rfft_backward(hFFT, &x_fd[b*strideFD], ref_td);
+            for(j=0; j<N; j++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, ref_td[j], test[b*strideTD+j]);
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, x_td[b*strideTD+j], test[b*strideTD+j]);
+            }
+
+            /* Check that the padding between the vectors has not been written to */
+            for(j=N; j<strideTD; j++)
+                TEST_ASSERT_TRUE(test[b*strideTD+j]==guardValue);
+            for(j=nBins; j<strideFD; j++)
+                TEST_ASSERT_TRUE(crealf(x_fd[b*strideFD+j])==guardValue);
+        }
+
+        /* clean-up */
+        saf_rfft_destroy(&hFFT);
+        free(x_fd);
+        free(x_td);
+        free(test);
+        free(ref_td);
+        free(ref_fd);
+    }
+}
+
 void test__saf_fft(void){
     int i, j, N;
     float_complex* x_td, *test;
@@ -379,6 +1057,211 @@ void test__saf_fft(void){
     }
 }
 
+void test__saf_fft_vs_kissFFT(void){
+    int i, j, k, r, N, level;
+    float* x_td;
+    float_complex* x_td_c, *y_fd, *ref_fd;
+    void *hFFT;
+    kiss_fftr_cfg kissR;
+    kiss_fft_cfg kissC;
+    SAF_SIMD_LEVELS originalLevel, maxLevel;
+    tick_t start;
+    double t_saf, t_kiss;
+    float tol;
+
+    /* Config */
+    const float acceptedTolerance = 0.00002f; /* (scaled by sqrt(N), since the FFT is unnormalised) */
+    const int nTrials = 200;
+    const int nRuns = 5; /* the fastest run of nTrials is reported, as a single run is easily disturbed */
+    const int nFFTsizes = 9;
+    const int fftSizesToTest[9] = {64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384}; /* the 2^x sizes used by the examples */
+
+    originalLevel = utility_getSIMDLevel();
+    maxLevel = utility_getMaxSIMDLevel();
+
+    /* Loop over the different FFT sizes */
+    for (i=0; i<nFFTsizes; i++){
+        N = fftSizesToTest[i];
+        tol = acceptedTolerance*sqrtf((float)N);
+
+        /* prep */
+        x_td = malloc1d(N*sizeof(float));
+        x_td_c = malloc1d(N*sizeof(float_complex));
+        y_fd = malloc1d(N*sizeof(float_complex));
+        ref_fd = malloc1d(N*sizeof(float_complex));
+        rand_m1_1(x_td, N);
+        rand_m1_1((float*)x_td_c, 2*N);
+
+        /* real<->half-complex: check that saf_rfft and kissFFT are equivalent, and time them both */
+        saf_rfft_create(&hFFT, N);
+        kissR = kiss_fftr_alloc(N, 0, NULL, NULL);
+        saf_rfft_forward(hFFT, x_td, y_fd);
+        kiss_fftr(kissR, x_td, (kiss_fft_cpx*)ref_fd);
+        for(j=0; j<N/2+1; j++){
+            TEST_ASSERT_FLOAT_WITHIN(tol, crealf(ref_fd[j]), crealf(y_fd[j]));
+            TEST_ASSERT_FLOAT_WITHIN(tol, cimagf(ref_fd[j]), cimagf(y_fd[j]));
+        }
+        t_saf = t_kiss = 1e9;
+        for(r=0; r<nRuns; r++){
+            start = timer_current();
+            for(k=0; k<nTrials; k++)
+                saf_rfft_forward(hFFT, x_td, y_fd);
+            t_saf = SAF_MIN(t_saf, (double)timer_elapsed(start));
+            start = timer_current();
+            for(k=0; k<nTrials; k++)
+                kiss_fftr(kissR, x_td, (kiss_fft_cpx*)ref_fd);
+            t_kiss = SAF_MIN(t_kiss, (double)timer_elapsed(start));
+        }
+        printf("    N=%d: rfft %lfs (kissFFT %lfs);", N, t_saf, t_kiss);
+        saf_rfft_destroy(&hFFT);
+        kiss_fftr_free(kissR);
+
+        /* complex<->complex (with each SIMD level, since the built-in FFT selects its kernels accordingly) */
+        kissC = kiss_fft_alloc(N, 0, NULL, NULL);
+        t_kiss = 1e9;
+        for(r=0; r<nRuns; r++){
+            start = timer_current();
+            for(k=0; k<nTrials; k++)
+                kiss_fft(kissC, (kiss_fft_cpx*)x_td_c, (kiss_fft_cpx*)ref_fd);
+            t_kiss = SAF_MIN(t_kiss, (double)timer_elapsed(start));
+        }
+        printf(" fft (kissFFT %lfs)", t_kiss);
+        for(level=SAF_SIMD_NONE; level<=(int)maxLevel; level++){
+            utility_setSIMDLevel((SAF_SIMD_LEVELS)level);
+            saf_fft_create(&hFFT, N);
+            saf_fft_forward(hFFT, x_td_c, y_fd);
+            for(j=0; j<N; j++){
+                TEST_ASSERT_FLOAT_WITHIN(tol, crealf(ref_fd[j]), crealf(y_fd[j]));
+                TEST_ASSERT_FLOAT_WITHIN(tol, cimagf(ref_fd[j]), cimagf(y_fd[j]));
+            }
+            t_saf = 1e9;
+            for(r=0; r<nRuns; r++){
+                start = timer_current();
+                for(k=0; k<nTrials; k++)
+                    saf_fft_forward(hFFT, x_td_c, y_fd);
+                t_saf = SAF_MIN(t_saf, (double)timer_elapsed(start));
+            }
+            printf(" level %d %lfs", level, t_saf);
+            saf_fft_destroy(&hFFT);
+        }
+        printf("\n");
+        utility_setSIMDLevel(originalLevel);
+        kiss_fft_free(kissC);
+
+        /* clean-up */
+        free(x_td);
+        free(x_td_c);
+        free(y_fd);
+        free(ref_fd);
+    }
+}
+
+void test__utility_simdDispatch(void){
+    int i, level, trial;
+    float* a, *b, *c, *ref;
+    double* ad, *bd, *cd, *refd;
+    float_complex* az, *bz, *cz, *refz;
+    SAF_SIMD_LEVELS originalLevel, maxLevel;
+    tick_t start;
+    double elapsed;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const float acceptedTolerance_rcp = 0.001f; /* rcp intrinsics are approximate */
+    const int len = 1027; /* deliberately not divisable by any SIMD step size */
+    const int nTrials = 2000;
+    const float scalar = 0.5f;
+
+    /* Prep */
+    a = malloc1d(len*sizeof(float));
+    b = malloc1d(len*sizeof(float));
+    c = malloc1d(len*sizeof(float));
+    ref = malloc1d(len*sizeof(float));
+    ad = malloc1d(len*sizeof(double));
+    bd = malloc1d(len*sizeof(double));
+    cd = malloc1d(len*sizeof(double));
+    refd = malloc1d(len*sizeof(double));
+    az = malloc1d(len*sizeof(float_complex));
+    bz = malloc1d(len*sizeof(float_complex));
+    cz = malloc1d(len*sizeof(float_complex));
+    refz = malloc1d(len*sizeof(float_complex));
+    rand_m1_1(a, len);
+    rand_0_1(b, len);
+    rand_m1_1((float*)az, 2*len);
+    rand_m1_1((float*)bz, 2*len);
+    for(i=0; i<len; i++){
+        b[i] += 0.1f; /* (avoid division by ~0) */
+        ad[i] = (double)a[i];
+        bd[i] = (double)b[i];
+    }
+    originalLevel = utility_getSIMDLevel();
+    maxLevel = utility_getMaxSIMDLevel();
+    TEST_ASSERT_TRUE(originalLevel<=maxLevel);
+
+    /* Each level should yield the same results as the reference implementations */
+    for(level=SAF_SIMD_NONE; level<=(int)maxLevel; level++){
+        TEST_ASSERT_TRUE(utility_setSIMDLevel((SAF_SIMD_LEVELS)level)==(SAF_SIMD_LEVELS)level);
+
+        utility_svvadd(a, b, len, c);
+        for(i=0; i<len; i++)
+            TEST_ASSERT_TRUE(c[i]==a[i]+b[i]);
+        utility_svvsub(a, b, len, c);
+        for(i=0; i<len; i++)
+            TEST_ASSERT_TRUE(c[i]==a[i]-b[i]);
+        utility_svvmul(a, b, len, c);
+        for(i=0; i<len; i++)
+            TEST_ASSERT_TRUE(c[i]==a[i]*b[i]);
+        utility_svsadd(a, &scalar, len, c);
+        for(i=0; i<len; i++)
+            TEST_ASSERT_TRUE(c[i]==a[i]+scalar);
+        utility_svssub(a, &scalar, len, c);
+        for(i=0; i<len; i++)
+            TEST_ASSERT_TRUE(c[i]==a[i]-scalar);
+        utility_svrecip(b, len, c);
+        for(i=0; i<len; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance_rcp, 1.0f, c[i]*b[i]);
+        utility_dvvadd(ad, bd, len, cd);
+        for(i=0; i<len; i++)
+            TEST_ASSERT_TRUE(cd[i]==ad[i]+bd[i]);
+        utility_dvvsub(ad, bd, len, cd);
+        for(i=0; i<len; i++)
+            TEST_ASSERT_TRUE(cd[i]==ad[i]-bd[i]);
+        utility_cvvmul(az, bz, len, cz);
+        for(i=0; i<len; i++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(az[i])*crealf(bz[i]) - cimagf(az[i])*cimagf(bz[i]), crealf(cz[i]));
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(az[i])*cimagf(bz[i]) + cimagf(az[i])*crealf(bz[i]), cimagf(cz[i]));
+        }
+
+        /* Timing */
+        start = timer_current();
+        for(trial=0; trial<nTrials; trial++){
+            utility_svvmul(a, b, len, ref);
+            utility_svvadd(a, ref, len, c);
+            utility_cvvmul(az, bz, len, refz);
+            utility_dvvadd(ad, bd, len, refd);
+        }
+        elapsed = (double)timer_elapsed(start);
+        printf("    veclib SIMD level %d: %lfs\n", level, elapsed);
+    }
+
+    /* Restore the original level */
+    TEST_ASSERT_TRUE(utility_setSIMDLevel(originalLevel)==originalLevel);
+
+    /* clean-up */
+    free(a);
+    free(b);
+    free(c);
+    free(ref);
+    free(ad);
+    free(bd);
+    free(cd);
+    free(refd);
+    free(az);
+    free(bz);
+    free(cz);
+    free(refz);
+}
+
 void test__qmf(void){
     int frame, nFrames, ch, i, nBands, procDelay, band, nHops;
     void* hQMF;
@@ -445,6 +1328,166 @@ void test__qmf(void){
     free(freqVector);
 }
 
+void test__qmf_fftModulation(void){
+    int i, ch, t, hopsize, band, maxBand, nBands, nHops, procDelay, rep;
+    void* hQMF;
+    float maxEnergy, energy, err, ref;
+    float* freqVector;
+    float** insig, **outsig;
+    float_complex*** spec;
+    double start, elapsed;
+
+    /* Config */
+    const int fs = 48000;
+    const int nCH = 64;
+    const int nReps = 50;
+
+    /* The modulators are applied via FFTs; check all supported hopsizes */
+    for(hopsize=4; hopsize<=128; hopsize*=2){
+        nHops = 64;
+        qmf_create(&hQMF, 1, 1, hopsize, 0, QMF_BANDS_CH_TIME);
+        procDelay = qmf_getProcDelay(hQMF);
+        nBands = qmf_getNBands(hQMF);
+        freqVector = malloc1d(nBands*sizeof(float));
+        qmf_getCentreFreqs(hQMF, (float)fs, nBands, freqVector);
+        insig = (float**)malloc2d(1, nHops*hopsize, sizeof(float));
+        outsig = (float**)malloc2d(1, nHops*hopsize, sizeof(float));
+        spec = (float_complex***)malloc3d(nBands, 1, nHops, sizeof(float_complex));
+
+        /* A sine tone at the centre frequency of a band should end up (mostly) in that band */
+        for(band=0; band<nBands; band+=SAF_MAX(nBands/8,1)){
+            qmf_clearBuffers(hQMF);
+            for(i=0; i<nHops*hopsize; i++)
+                insig[0][i] = sinf(2.0f*SAF_PI*(float)i*freqVector[band]/(float)fs);
+            qmf_analysis(hQMF, insig, nHops*hopsize, spec);
+            maxBand = -1;
+            maxEnergy = 0.0f;
+            for(i=0; i<nBands; i++){
+                energy = 0.0f;
+                for(t=nHops/2; t<nHops; t++)
+                    energy += powf(cabsf(spec[i][0][t]), 2.0f);
+                if(energy>maxEnergy){
+                    maxEnergy = energy;
+                    maxBand = i;
+                }
+            }
+            TEST_ASSERT_EQUAL_INT(band, maxBand);
+        }
+
+        /* Analysis followed by synthesis should (near) perfectly reconstruct the input */
+        qmf_clearBuffers(hQMF);
+        rand_m1_1(insig[0], nHops*hopsize);
+        qmf_analysis(hQMF, insig, nHops*hopsize, spec);
+        qmf_synthesis(hQMF, spec, nHops*hopsize, outsig);
+        err = ref = 0.0f;
+        for(i=0; i<nHops*hopsize-procDelay; i++){
+            err += powf(insig[0][i] - outsig[0][i+procDelay], 2.0f);
+            ref += powf(insig[0][i], 2.0f);
+        }
+        TEST_ASSERT_TRUE(10.0f*log10f(err/ref) < -40.0f);
+
+        qmf_destroy(&hQMF);
+        free(freqVector);
+        free(insig);
+        free(outsig);
+        free(spec);
+    }
+
+    /* Per-hop cost of 64 channel analysis + synthesis */
+    printf("    qmf %d channels, analysis+synthesis:", nCH);
+    for(hopsize=16; hopsize<=128; hopsize*=2){
+        nHops = 4;
+        qmf_create(&hQMF, nCH, nCH, hopsize, 1, QMF_BANDS_CH_TIME);
+        nBands = qmf_getNBands(hQMF);
+        insig = (float**)malloc2d(nCH, nHops*hopsize, sizeof(float));
+        outsig = (float**)malloc2d(nCH, nHops*hopsize, sizeof(float));
+        spec = (float_complex***)malloc3d(nBands, nCH, nHops, sizeof(float_complex));
+        for(ch=0; ch<nCH; ch++)
+            rand_m1_1(insig[ch], nHops*hopsize);
+        start = timer_current();
+        for(rep=0; rep<nReps; rep++){
+            qmf_analysis(hQMF, insig, nHops*hopsize, spec);
+            qmf_synthesis(hQMF, spec, nHops*hopsize, outsig);
+        }
+        elapsed = (double)timer_elapsed(start);
+        printf(" hop %d %lfms/hop;", hopsize, 1e3*elapsed/(double)(nReps*nHops));
+        qmf_destroy(&hQMF);
+        free(insig);
+        free(outsig);
+        free(spec);
+    }
+    printf("\n");
+}
+
+void test__qmf_ringBuffers(void){
+    int i, ch, band, hybridMode, nBands, nHops, hop, frameHops;
+    void* hQMF_ref, *hQMF;
+    float** insig, **outsig_ref, **outsig, **inframe, **outframe;
+    float_complex*** spec_ref, ***spec, ***specframe;
+
+    /* Config */
+    const int hopsize = 32;
+    const int nCH = 3;
+    const int nHopsTotal = 120;
+
+    /* prep */
+    insig = (float**)malloc2d(nCH, nHopsTotal*hopsize, sizeof(float));
+    outsig_ref = (float**)malloc2d(nCH, nHopsTotal*hopsize, sizeof(float));
+    outsig = (float**)calloc2d(nCH, nHopsTotal*hopsize, sizeof(float));
+    inframe = (float**)malloc2d(nCH, 7*hopsize, sizeof(float));
+    outframe = (float**)malloc2d(nCH, 7*hopsize, sizeof(float));
+    rand_m1_1(FLATTEN2D(insig), nCH*nHopsTotal*hopsize);
+
+    for(hybridMode=0; hybridMode<2; hybridMode++){
+        /* Reference: the whole signal in one go */
+        qmf_create(&hQMF_ref, nCH, nCH, hopsize, hybridMode, QMF_BANDS_CH_TIME);
+        nBands = qmf_getNBands(hQMF_ref);
+        spec_ref = (float_complex***)malloc3d(nBands, nCH, nHopsTotal, sizeof(float_complex));
+        spec = (float_complex***)calloc3d(nBands, nCH, nHopsTotal, sizeof(float_complex));
+        specframe = (float_complex***)malloc3d(nBands, nCH, 7, sizeof(float_complex));
+        qmf_analysis(hQMF_ref, insig, nHopsTotal*hopsize, spec_ref);
+        qmf_synthesis(hQMF_ref, spec_ref, nHopsTotal*hopsize, outsig_ref);
+
+        /* Same signal, in frames of varying length (wrapping the ring buffers at
+         * different points), and with the channel count changing mid-stream */
+        qmf_create(&hQMF, 1, 1, hopsize, hybridMode, QMF_BANDS_CH_TIME);
+        for(hop=0, frameHops=1; hop<nHopsTotal; hop+=nHops, frameHops = frameHops%7+1){
+            nHops = SAF_MIN(frameHops, nHopsTotal-hop);
+            if(hop>=nHopsTotal/2)
+                qmf_channelChange(hQMF, nCH, nCH);
+            for(ch=0; ch<nCH; ch++)
+                memcpy(inframe[ch], &insig[ch][hop*hopsize], nHops*hopsize*sizeof(float));
+            qmf_analysis(hQMF, inframe, nHops*hopsize, specframe);
+            for(band=0; band<nBands; band++)
+                for(ch=0; ch<(hop>=nHopsTotal/2 ? nCH : 1); ch++)
+                    memcpy(&spec[band][ch][hop], specframe[band][ch], nHops*sizeof(float_complex));
+            qmf_synthesis(hQMF, specframe, nHops*hopsize, outframe);
+            for(ch=0; ch<(hop>=nHopsTotal/2 ? nCH : 1); ch++)
+                memcpy(&outsig[ch][hop*hopsize], outframe[ch], nHops*hopsize*sizeof(float));
+        }
+
+        /* The first channel should be bit-exact with the reference throughout */
+        for(band=0; band<nBands; band++)
+            for(i=0; i<nHopsTotal; i++)
+                TEST_ASSERT_TRUE(crealf(spec[band][0][i])==crealf(spec_ref[band][0][i]) && cimagf(spec[band][0][i])==cimagf(spec_ref[band][0][i]));
+        for(i=0; i<nHopsTotal*hopsize; i++)
+            TEST_ASSERT_TRUE(outsig[0][i]==outsig_ref[0][i]);
+
+        qmf_destroy(&hQMF_ref);
+        qmf_destroy(&hQMF);
+        free(spec_ref);
+        free(spec);
+        free(specframe);
+    }
+
+    /* Clean-up */
+    free(insig);
+    free(outsig_ref);
+    free(outsig);
+    free(inframe);
+    free(outframe);
+}
+
 void test__smb_pitchShifter(void){
     float* inputData, *outputData;
     void* hPS, *hFFT;
@@ -485,6 +1528,81 @@ void test__smb_pitchShifter(void){
     free(out_fft);
 }
 
+void test__smb_pitchShifter_fast(void){
+    float* inputData, *outputData, *outputData_fast;
+    void* hPS, *hPS_fast, *hFFT;
+    float_complex* out_fft;
+    float frequency, err, ref;
+    int i, nCH, fast, frame, ind;
+    double start, elapsed[2];
+
+    /* Config */
+    const int sampleRate = 48000;
+    const int FFTsize = 4096;
+    const int osfactor = 4;
+    const int frameSize = 512;
+    const int nSamples = 16*FFTsize;
+    const int nFramesBench = 100;
+
+    /* prep */
+    inputData = malloc1d(64*nSamples*sizeof(float));
+    outputData = calloc1d(64*nSamples,sizeof(float));
+    outputData_fast = calloc1d(64*nSamples,sizeof(float));
+    frequency = (float)sampleRate/8.0f;
+    for(i=0; i<nSamples; i++) /* sine tone at quarter Nyquist: */
+        inputData[i] = sinf(2.0f * M_PI * (float)i * frequency/(float)sampleRate);
+
+    /* Pitch shift down one octave, with and without the fast approximations, frame-by-frame */
+    smb_pitchShift_create(&hPS, 1, FFTsize, osfactor, (float)sampleRate);
+    smb_pitchShift_createFast(&hPS_fast, 1, FFTsize, osfactor, (float)sampleRate);
+    for(frame=0; frame<nSamples/frameSize; frame++){
+        smb_pitchShift_apply(hPS, 0.5, frameSize, &inputData[frame*frameSize], &outputData[frame*frameSize]);
+        smb_pitchShift_apply(hPS_fast, 0.5, frameSize, &inputData[frame*frameSize], &outputData_fast[frame*frameSize]);
+    }
+
+    /* Take FFT, the bin with the highest energy should correspond to 1/8 Nyquist */
+    out_fft = malloc1d((nSamples / 2 + 1) * sizeof(float_complex));
+    saf_rfft_create(&hFFT, nSamples);
+    saf_rfft_forward(hFFT, outputData_fast, out_fft);
+    utility_cimaxv(out_fft, nSamples/2+1, &ind);
+    TEST_ASSERT_TRUE(ind == nSamples/16);
+
+    /* The approximations should be inaudible */
+    err = ref = 0.0f;
+    for(i=0; i<nSamples; i++){
+        err += powf(outputData[i]-outputData_fast[i], 2.0f);
+        ref += powf(outputData[i], 2.0f);
+    }
+    TEST_ASSERT_TRUE(10.0f*log10f(err/ref) < -60.0f);
+    smb_pitchShift_destroy(&hPS);
+    smb_pitchShift_destroy(&hPS_fast);
+
+    /* Throughput per channel count */
+    rand_m1_1(inputData, 64*nSamples);
+    for(nCH=1; nCH<=64; nCH*=4){
+        for(fast=0; fast<2; fast++){
+            if(fast)
+                smb_pitchShift_createFast(&hPS, nCH, FFTsize, osfactor, (float)sampleRate);
+            else
+                smb_pitchShift_create(&hPS, nCH, FFTsize, osfactor, (float)sampleRate);
+            start = timer_current();
+            for(frame=0; frame<nFramesBench; frame++)
+                smb_pitchShift_apply(hPS, 0.7f, frameSize, &inputData[(frame%4)*nCH*frameSize], outputData);
+            elapsed[fast] = (double)timer_elapsed(start);
+            smb_pitchShift_destroy(&hPS);
+        }
+        printf("    smb_pitchShift %2d channels, FFT %d: %lfms (fast: %lfms) per %d sample frame\n",
+               nCH, FFTsize, 1e3*elapsed[0]/(double)nFramesBench, 1e3*elapsed[1]/(double)nFramesBench, frameSize);
+    }
+
+    /* clean-up */
+    saf_rfft_destroy(&hFFT);
+    free(inputData);
+    free(outputData);
+    free(outputData_fast);
+    free(out_fft);
+}
+
 void test__sortf(void){
     float* values;
     int* sortedIdx;
@@ -694,17 +1812,21 @@ void test__unique_i(void){
 }
 
 void test__latticeDecorrelator(void){
-    int c, band, nBands, idx, hopIdx, i;
-    void* hDecor, *hSTFT;
+    int c, band, nBands, idx, hopIdx, i, t;
+    void* hDecor, *hDecor2, *hSTFT;
     float icc, tmp, tmp2;
     float* freqVector;
     float** inputTimeDomainData, **outputTimeDomainData, **tempHop;
-    float_complex*** inTFframe, ***outTFframe;
+    float_complex*** inTFframe, ***outTFframe, ***blockTFframe, ***refTFframe;
+    tick_t start;
+    double elapsed;
 
     /* config */
     const float acceptedICC = 0.05f;
     const int nCH = 24;
     const int nTestHops = 800;
+    const int nSlots = 16;
+    const int nTestBlocks = 50;
     const int hopSize = 128;
     const int procDelay = hopSize*12 + 12;
     const int lSig = nTestHops*hopSize+procDelay;
@@ -785,8 +1907,49 @@ void test__latticeDecorrelator(void){
     }
 #endif
 
+    /* The filters are run side by side over bands and channels, so also check
+     * that processing a block of time slots in-place gives the same result as
+     * processing one time slot at a time (the static delays are randomised, so
+     * re-seed to give both instances the same delays) */
+    latticeDecorrelator_destroy(&hDecor);
+    srand(1);
+    latticeDecorrelator_create(&hDecor, fs, hopSize, freqVector, nBands, nCH, orders, freqCutoffs, 4, maxDelay, 0, 0.75f);
+    srand(1);
+    latticeDecorrelator_create(&hDecor2, fs, hopSize, freqVector, nBands, nCH, orders, freqCutoffs, 4, maxDelay, 0, 0.75f);
+    blockTFframe = (float_complex***)malloc3d(nBands, nCH, nSlots, sizeof(float_complex));
+    refTFframe = (float_complex***)malloc3d(nBands, nCH, nSlots, sizeof(float_complex));
+    elapsed = 0.0;
+    for(hopIdx=0; hopIdx<nTestBlocks; hopIdx++){
+        rand_m1_1((float*)FLATTEN3D(blockTFframe), nBands*nCH*nSlots*2);
+        for(t=0; t<nSlots; t++){
+            for(band=0; band<nBands; band++)
+                for(c=0; c<nCH; c++)
+                    inTFframe[band][c][0] = blockTFframe[band][c][t];
+            latticeDecorrelator_apply(hDecor, inTFframe, 1, inTFframe);
+            for(band=0; band<nBands; band++)
+                for(c=0; c<nCH; c++)
+                    refTFframe[band][c][t] = inTFframe[band][c][0];
+        }
+        start = timer_current();
+        latticeDecorrelator_apply(hDecor2, blockTFframe, nSlots, blockTFframe);
+        elapsed += (double)timer_elapsed(start);
+        for(band=0; band<nBands; band++){
+            for(c=0; c<nCH; c++){
+                for(t=0; t<nSlots; t++){
+                    TEST_ASSERT_FLOAT_WITHIN(1e-6f, crealf(refTFframe[band][c][t]), crealf(blockTFframe[band][c][t]));
+                    TEST_ASSERT_FLOAT_WITHIN(1e-6f, cimagf(refTFframe[band][c][t]), cimagf(blockTFframe[band][c][t]));
+                }
+            }
+        }
+    }
+    printf("    latticeDecorrelator_apply (%d bands x %d channels x %d time slots): %.3f ms per block\n",
+           nBands, nCH, nSlots, 1e3*elapsed/(double)nTestBlocks);
+
     /* Clean-up */
     latticeDecorrelator_destroy(&hDecor);
+    latticeDecorrelator_destroy(&hDecor2);
+    free(blockTFframe);
+    free(refTFframe);
     free(inTFframe);
     free(outTFframe);
     free(tempHop);
@@ -983,6 +2146,151 @@ void test__faf_IIRFilterbank(void){
     free(outsig_fft);
 }
 
+void test__faf_IIRFilterbank_multiChannel(void){
+    void* hFaF_mc;
+    void** hFaF;
+    int i, o, ch, band, frame, nCH;
+    float* zeros;
+    float** inSig, ***outBands, ***outBands_ref, **inFrame, ***outFrames, **skippedFrame;
+    double elapsed_ref, elapsed_mc, elapsed_ch;
+    tick_t start;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int orders[2] = {1, 3};
+    const int nChannels = 7;
+    const int silentChannel = 3;  /* (NULL input) */
+    const int skippedChannel = 5; /* (NULL output) */
+    const int signalLength = 1500;
+    const int frameSize = 300; /* (not a multiple of the internal block size) */
+    const int nBenchFrames = 20;
+    const int benchFrameSize = 512;
+    const int maxBenchChannels = 128;
+    const float fs = 48e3f;
+    const float fc[4] = {353.553390593274f, 707.106781186547f, 1414.21356237309f, 2828.42712474619f};
+    const int nBands = 5;
+
+    /* Allocate memory */
+    inSig = (float**)malloc2d(maxBenchChannels, signalLength, sizeof(float));
+    outBands = (float***)malloc3d(nChannels, nBands, signalLength, sizeof(float));
+    outBands_ref = (float***)malloc3d(maxBenchChannels, nBands, signalLength, sizeof(float));
+    inFrame = malloc1d(maxBenchChannels*sizeof(float*));
+    outFrames = (float***)malloc2d(maxBenchChannels, nBands, sizeof(float*));
+    hFaF = malloc1d(maxBenchChannels*sizeof(void*));
+    zeros = calloc1d(frameSize, sizeof(float));
+    rand_m1_1(FLATTEN2D(inSig), maxBenchChannels*signalLength);
+
+    for(o=0; o<2; o++){
+        /* Reference: one single-channel filterbank per channel */
+        for(ch=0; ch<nChannels; ch++){
+            faf_IIRFilterbank_create(&hFaF[ch], orders[o], (float*)fc, nBands-1, fs, frameSize);
+            for(frame=0; frame<signalLength/frameSize; frame++){
+                for(band=0; band<nBands; band++)
+                    outFrames[ch][band] = &outBands_ref[ch][band][frame*frameSize];
+                faf_IIRFilterbank_apply(hFaF[ch], ch==silentChannel ? zeros : &inSig[ch][frame*frameSize], outFrames[ch], frameSize);
+            }
+            faf_IIRFilterbank_destroy(&hFaF[ch]);
+        }
+
+        /* The multi-channel filterbank should give the same output, for all channels at once */
+        faf_IIRFilterbank_createMultiChannel(&hFaF_mc, orders[o], (float*)fc, nBands-1, fs, frameSize, nChannels);
+        for(frame=0; frame<signalLength/frameSize; frame++){
+            for(ch=0; ch<nChannels; ch++){
+                inFrame[ch] = ch==silentChannel ? NULL : &inSig[ch][frame*frameSize];
+                for(band=0; band<nBands; band++)
+                    outFrames[ch][band] = &outBands[ch][band][frame*frameSize];
+            }
+            skippedFrame = outFrames[skippedChannel];
+            outFrames[skippedChannel] = NULL;
+            faf_IIRFilterbank_applyMultiChannel(hFaF_mc, inFrame, outFrames, nChannels, frameSize);
+            outFrames[skippedChannel] = skippedFrame;
+        }
+        for(ch=0; ch<nChannels; ch++)
+            if(ch!=skippedChannel)
+                for(band=0; band<nBands; band++)
+                    for(i=0; i<signalLength; i++)
+                        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outBands_ref[ch][band][i], outBands[ch][band][i]);
+
+        /* Flushing one channel should be the same as starting that channel afresh */
+        faf_IIRFilterbank_flushChannel(hFaF_mc, 0);
+        faf_IIRFilterbank_create(&hFaF[0], orders[o], (float*)fc, nBands-1, fs, frameSize);
+        for(band=0; band<nBands; band++)
+            outFrames[0][band] = outBands_ref[0][band];
+        faf_IIRFilterbank_apply(hFaF[0], inSig[0], outFrames[0], frameSize);
+        for(ch=0; ch<nChannels; ch++){
+            inFrame[ch] = inSig[ch];
+            for(band=0; band<nBands; band++)
+                outFrames[ch][band] = outBands[ch][band];
+        }
+        faf_IIRFilterbank_applyMultiChannel(hFaF_mc, inFrame, outFrames, nChannels, frameSize);
+        for(band=0; band<nBands; band++)
+            for(i=0; i<frameSize; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outBands_ref[0][band][i], outBands[0][band][i]);
+        faf_IIRFilterbank_destroy(&hFaF[0]);
+        faf_IIRFilterbank_destroy(&hFaF_mc);
+
+        /* Filtering one channel at a time should also give the same output, including when alternating with the above */
+        faf_IIRFilterbank_createMultiChannel(&hFaF_mc, orders[o], (float*)fc, nBands-1, fs, frameSize, nChannels);
+        for(frame=0; frame<signalLength/frameSize; frame++){
+            for(ch=0; ch<nChannels; ch++){
+                inFrame[ch] = ch==silentChannel ? zeros : &inSig[ch][frame*frameSize];
+                for(band=0; band<nBands; band++)
+                    outFrames[ch][band] = &outBands[ch][band][frame*frameSize];
+            }
+            if(frame%2==0)
+                for(ch=0; ch<nChannels; ch++)
+                    faf_IIRFilterbank_applyChannel(hFaF_mc, ch, inFrame[ch], outFrames[ch], frameSize);
+            else
+                faf_IIRFilterbank_applyMultiChannel(hFaF_mc, inFrame, outFrames, nChannels, frameSize);
+        }
+        for(ch=0; ch<nChannels; ch++)
+            if(ch!=skippedChannel)
+                for(band=0; band<nBands; band++)
+                    for(i=0; i<signalLength; i++)
+                        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, outBands_ref[ch][band][i], outBands[ch][band][i]);
+        faf_IIRFilterbank_destroy(&hFaF_mc);
+    }
+
+    /* Timing, against one single-channel filterbank per channel (e.g. per source of a room simulator) */
+    for(nCH=1; nCH<=maxBenchChannels; nCH*=2){
+        for(ch=0; ch<nCH; ch++){
+            faf_IIRFilterbank_create(&hFaF[ch], 3, (float*)fc, nBands-1, fs, benchFrameSize);
+            inFrame[ch] = inSig[ch];
+            for(band=0; band<nBands; band++)
+                outFrames[ch][band] = outBands_ref[ch][band];
+        }
+        faf_IIRFilterbank_createMultiChannel(&hFaF_mc, 3, (float*)fc, nBands-1, fs, benchFrameSize, nCH);
+        start = timer_current();
+        for(frame=0; frame<nBenchFrames; frame++)
+            for(ch=0; ch<nCH; ch++)
+                faf_IIRFilterbank_apply(hFaF[ch], inFrame[ch], outFrames[ch], benchFrameSize);
+        elapsed_ref = (double)timer_elapsed(start);
+        start = timer_current();
+        for(frame=0; frame<nBenchFrames; frame++)
+            faf_IIRFilterbank_applyMultiChannel(hFaF_mc, inFrame, outFrames, nCH, benchFrameSize);
+        elapsed_mc = (double)timer_elapsed(start);
+        start = timer_current();
+        for(frame=0; frame<nBenchFrames; frame++)
+            for(ch=0; ch<nCH; ch++)
+                faf_IIRFilterbank_applyChannel(hFaF_mc, ch, inFrame[ch], outFrames[ch], benchFrameSize);
+        elapsed_ch = (double)timer_elapsed(start);
+        printf("    faf_IIRFilterbank %d bands, %3d channels: per channel %lfms, multi-channel %lfms, one channel at a time %lfms (per %d sample frame)\n",
+               nBands, nCH, 1e3*elapsed_ref/(double)nBenchFrames, 1e3*elapsed_mc/(double)nBenchFrames, 1e3*elapsed_ch/(double)nBenchFrames, benchFrameSize);
+        for(ch=0; ch<nCH; ch++)
+            faf_IIRFilterbank_destroy(&hFaF[ch]);
+        faf_IIRFilterbank_destroy(&hFaF_mc);
+    }
+
+    /* clean-up */
+    free(inSig);
+    free(outBands);
+    free(outBands_ref);
+    free(inFrame);
+    free(outFrames);
+    free(hFaF);
+    free(zeros);
+}
+
 void test__gexpm(void){
     int i, j;
     float outM[6][6];